@@ -14,6 +14,7 @@
 #include "libstoch/core/grids/FullGeneralGridIterator.h"
 #include "libstoch/core/grids/LinearInterpolator.h"
 #include "libstoch/core/grids/LinearInterpolatorSpectral.h"
+#include "libstoch/core/grids/LinearInterpolatorMultiSpectral.h"
 
 /** \file GeneralSpaceGrid.h
  *  \brief Defines a \f$n\f$ dimensional grid with irregular space step
@@ -268,6 +269,14 @@ public :
         return std::make_shared<LinearInterpolatorSpectral>(this, p_values) ;
     }
 
+    /// \brief Get back a spectral operator associated to a set of functions
+    /// \param p_values   Functions values at the grids points (nb functions, nb points)
+    /// \return  the whole interpolated  value functions
+    std::shared_ptr<InterpolatorMultiSpectral> createInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_values) const
+    {
+        return std::make_shared<LinearInterpolatorMultiSpectral>(this, p_values) ;
+    }
+
     /// \brief check comptability of the mesh with the number of points in each direction
     /// \param  p_nbPoints   number of points
     bool  checkMeshAndPointCompatibility(const int &p_nbPoints) const
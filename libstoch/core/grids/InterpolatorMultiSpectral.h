@@ -0,0 +1,64 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef INTERPOLATORMULTISPECTRAL_H
+#define INTERPOLATORMULTISPECTRAL_H
+#include <Eigen/Dense>
+
+/** \file InterpolatorMultiSpectral.h
+ *  \brief Defines a global interpolator for a set of functions defined on the same grid (for example one function per node of a tree).
+ *         The representations of all the functions are stored in a single matrix : the location of a point on the grid
+ *         and the interpolation weights are calculated once for all the functions.
+ *         Here it is an abstract class
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// forward declaration
+class SpaceGrid ;
+class Interpolator ;
+
+/// \class InterpolatorMultiSpectral InterpolatorMultiSpectral.h
+/// Abstract class for spectral operator of a set of functions
+class InterpolatorMultiSpectral
+{
+
+public :
+    virtual ~InterpolatorMultiSpectral() {}
+
+    /**  \brief  interpolate all the functions
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \return interpolated values (size the number of functions)
+     */
+    virtual Eigen::ArrayXd apply(const Eigen::ArrayXd &p_point) const = 0;
+
+    /**  \brief  interpolate one function
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \param  p_ifunc  function number
+     *  \return interpolated value
+     */
+    virtual double applyOne(const Eigen::ArrayXd &p_point, const int &p_ifunc) const = 0;
+
+    /**  \brief  interpolate one function with an interpolator created by the grid at the point (see SpaceGrid::createInterpolator) :
+     *           the caller can keep the interpolator to interpolate several functions at the same point
+     *  \param  p_interpolator  interpolator created by the grid at the point
+     *  \param  p_ifunc         function number
+     *  \return interpolated value
+     */
+    virtual double applyOne(const Interpolator &p_interpolator, const int &p_ifunc) const = 0;
+
+    /// \brief Get back the number of functions interpolated
+    virtual int getNbFunctions() const = 0;
+
+    /** \brief Affect the grid
+     * \param p_grid  the grid to affect
+     */
+    virtual void setGrid(const libstoch::SpaceGrid *p_grid)  = 0 ;
+
+    /** \brief Get back grid associated to operator
+     */
+    virtual  const libstoch::SpaceGrid *getGrid() = 0;
+};
+}
+#endif
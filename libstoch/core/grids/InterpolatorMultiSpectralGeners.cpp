@@ -0,0 +1,13 @@
+#include "libstoch/core/grids/InterpolatorMultiSpectralGeners.h"
+// add include for all derived classes
+#include "libstoch/core/grids/LinearInterpolatorMultiSpectralGeners.h"
+#include "libstoch/core/grids/LegendreInterpolatorMultiSpectralGeners.h"
+#include "libstoch/core/grids/SparseInterpolatorMultiSpectralGeners.h"
+
+// Register all wrappers
+SerializationFactoryForInterpolatorMultiSpectral::SerializationFactoryForInterpolatorMultiSpectral()
+{
+    this->registerWrapper<LinearInterpolatorMultiSpectralGeners>();
+    this->registerWrapper<LegendreInterpolatorMultiSpectralGeners>();
+    this->registerWrapper<SparseInterpolatorMultiSpectralGeners>();
+}
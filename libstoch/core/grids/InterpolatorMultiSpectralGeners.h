@@ -0,0 +1,31 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef INTERPOLATORMULTISPECTRALGENERS_H
+#define INTERPOLATORMULTISPECTRALGENERS_H
+#include "libstoch/core/grids/InterpolatorMultiSpectral.h"
+#include <geners/AbsReaderWriter.hh>
+#include <geners/associate_serialization_factory.hh>
+
+/** \file InterpolatorMultiSpectralGeners.h
+ * \brief Base class mapping with geners to archive Spectral Interpolator of a set of functions
+ * \author Xavier Warin
+ */
+
+///  I/O factory for classes derived from InterpolatorMultiSpectral.
+// Note publication of the base class and absence of public constructors.
+class SerializationFactoryForInterpolatorMultiSpectral : public gs::DefaultReaderWriter<libstoch::InterpolatorMultiSpectral>
+{
+    typedef DefaultReaderWriter<libstoch::InterpolatorMultiSpectral> Base;
+    friend class gs::StaticReaderWriter<SerializationFactoryForInterpolatorMultiSpectral>;
+    SerializationFactoryForInterpolatorMultiSpectral();
+};
+
+// SerializationFactoryForInterpolatorMultiSpectral wrapped into a singleton
+typedef gs::StaticReaderWriter<SerializationFactoryForInterpolatorMultiSpectral> StaticSerializationFactoryForInterpolatorMultiSpectral;
+
+gs_specialize_class_id(libstoch::InterpolatorMultiSpectral, 1)
+gs_declare_type_external(libstoch::InterpolatorMultiSpectral)
+gs_associate_serialization_factory(libstoch::InterpolatorMultiSpectral, StaticSerializationFactoryForInterpolatorMultiSpectral)
+
+#endif
@@ -0,0 +1,69 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include <vector>
+#include <memory>
+#include <Eigen/Dense>
+#include "libstoch/core/utils/constant.h"
+#include "libstoch/core/grids/LegendreInterpolatorMultiSpectral.h"
+
+using namespace libstoch;
+using namespace Eigen;
+using namespace std;
+
+LegendreInterpolatorMultiSpectral::LegendreInterpolatorMultiSpectral(const RegularLegendreGrid *p_grid, const ArrayXXd &p_values) :  m_grid(p_grid),
+    m_min(ArrayXXd::Constant(p_values.rows(), p_grid->getNbMeshes(), infty)),
+    m_max(ArrayXXd::Constant(p_values.rows(), p_grid->getNbMeshes(), -infty))
+{
+    // basis and weights of the tensorized interpolation : they don't depend on the mesh
+    ArrayXXd weights;
+    ArrayXi shiftPoint;
+    p_grid->getSpectralBasis(m_funcBaseExp, weights, shiftPoint);
+    int nbBasis = m_funcBaseExp.cols();
+    // resize and calculate spectral representation
+    m_spectral.resize(p_values.rows(), nbBasis * p_grid->getNbMeshes());
+    m_spectral.setConstant(0.);
+    int imesh;
+#ifdef _OPENMP
+    #pragma omp parallel for  private(imesh)
+#endif
+    for (imesh = 0 ; imesh < p_grid->getNbMeshes(); ++imesh)
+    {
+        int ipointMesh = p_grid->getMeshFirstPoint(imesh);
+        // nest on collocation  point (same order of summation as LegendreInterpolatorSpectral for each function)
+        for (int ibb = 0 ; ibb < nbBasis; ++ibb)
+        {
+            int ipoint = ipointMesh + shiftPoint(ibb);
+            for (int ib = 0 ; ib < nbBasis; ++ib)
+                m_spectral.col(imesh * nbBasis + ib) += p_values.col(ipoint) * weights(ib, ibb);
+            m_min.col(imesh) = m_min.col(imesh).min(p_values.col(ipoint));
+            m_max.col(imesh) = m_max.col(imesh).max(p_values.col(ipoint));
+        }
+    }
+}
+
+int LegendreInterpolatorMultiSpectral::basisAtPoint(const ArrayXd &p_point, VectorXd &p_funcVal) const
+{
+    // legendre functions
+    shared_ptr< array< function< double(const double &) >, 11 > >  legendre = m_grid->getLegendre();
+    ArrayXd xCoord(p_point.size());
+    // mesh number
+    int imeshLoc = 0;
+    int idec = 1;
+    for (int id = 0; id < p_point.size(); ++id)
+    {
+        int icoordMin = 0 ;
+        m_grid->rescalepoint(p_point(id), id, xCoord(id), icoordMin);
+        int  coordmesh = icoordMin / m_grid->getPoly(id);
+        imeshLoc += idec * coordmesh;
+        idec *= m_grid->getNbStep(id);
+    }
+    for (int ib = 0 ; ib < m_funcBaseExp.cols(); ++ib)
+    {
+        double funcVal = 1. ;
+        for (int id = 0 ; id < m_funcBaseExp.rows()  ; ++id)
+            funcVal *= (*legendre)[m_funcBaseExp(id, ib)](xCoord(id));
+        p_funcVal(ib) = funcVal;
+    }
+    return imeshLoc;
+}
@@ -0,0 +1,143 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef LEGENDREINTERPOLATORMULTISPECTRAL_H
+#define LEGENDREINTERPOLATORMULTISPECTRAL_H
+#include <cstdlib>
+#include <iostream>
+#include <Eigen/Dense>
+#include <libstoch/core/grids/RegularLegendreGrid.h>
+#include <libstoch/core/grids/InterpolatorMultiSpectral.h>
+
+/** \file LegendreInterpolatorMultiSpectral.h
+ *  \brief Defines a legendre interpolator for a set of functions on a full grid
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class LegendreInterpolatorMultiSpectral LegendreInterpolatorMultiSpectral.h
+/// As in LegendreInterpolatorSpectral class, a spectral representation is stored, here for a set of functions.
+/// The spectral coefficients of all functions are stored in a single matrix, the coefficients of a mesh being contiguous :
+/// at a given point the Legendre basis is evaluated once and all the functions are obtained by a matrix vector product.
+class LegendreInterpolatorMultiSpectral : public InterpolatorMultiSpectral
+{
+
+private :
+
+    const RegularLegendreGrid *m_grid ;  ///< grid used
+    Eigen::ArrayXXd m_spectral ; ///< spectral representation of the functions (nb of functions, nb of basis function * number of mesh)
+    Eigen::ArrayXXi  m_funcBaseExp ; ///< helper to get the degree of a polynomial : for each multidimensional function basis gives in all dimensions the degree of the polynomial 1D basis
+    Eigen::ArrayXXd m_min ; ///<  for each function, on each mesh minimal of the values on the mesh (nb of functions, number of mesh)
+    Eigen::ArrayXXd m_max ; ///<  for each function, on each mesh maximal of the values on the mesh (nb of functions, number of mesh)
+
+    /// \brief Evaluate the basis functions at a point
+    /// \param  p_point     coordinates of the point
+    /// \param  p_funcVal   values of the basis functions at the point (size the number of basis functions)
+    /// \return mesh number of the point
+    int basisAtPoint(const Eigen::ArrayXd &p_point, Eigen::VectorXd &p_funcVal) const;
+
+public :
+
+    /** \brief Constructor taking in values on the grid
+     *  \param p_grid   is the grid used to interpolate
+     *  \param p_values   Functions values at the grids points (nb of functions, nb of points)
+     */
+    LegendreInterpolatorMultiSpectral(const RegularLegendreGrid   *p_grid, const Eigen::ArrayXXd &p_values) ;
+
+
+    /** \brief Constructor taking the values of the grids , but without affecting the grid
+     *  Convinient for serialization : affectation of the pointer should be done after
+     * \param p_spectral    spectral values associated to the interpolator
+     * \param p_funcBaseExp  helper
+     * \param p_min        for each function on each mesh minimal of the values on the mesh
+     * \param p_max        for each function on each mesh maximal of the values on the mesh
+     */
+    LegendreInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_spectral, const Eigen::ArrayXXi &p_funcBaseExp,
+                                      const Eigen::ArrayXXd &p_min, const Eigen::ArrayXXd &p_max) : m_spectral(p_spectral), m_funcBaseExp(p_funcBaseExp), m_min(p_min), m_max(p_max) {};
+
+    /** \brief Affect the grid : use for deserialization
+     * \param p_grid  the grid to affect
+     */
+    void setGrid(const SpaceGrid *p_grid)
+    {
+        m_grid = static_cast< const RegularLegendreGrid *>(p_grid);
+    }
+
+    /** \brief Get back grid associated to operator
+     */
+    const libstoch::SpaceGrid *getGrid()
+    {
+        return static_cast< const SpaceGrid *>(m_grid);
+    }
+
+    /**  \brief  interpolate all the functions
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \return interpolated values
+     */
+    inline Eigen::ArrayXd apply(const Eigen::ArrayXd &p_point) const
+    {
+        int nbBasis = m_funcBaseExp.cols();
+        Eigen::VectorXd funcVal(nbBasis);
+        int imeshLoc = basisAtPoint(p_point, funcVal);
+        Eigen::ArrayXd vFunction = (m_spectral.middleCols(imeshLoc * nbBasis, nbBasis).matrix() * funcVal).array();
+        // to avoid oscillations
+        return vFunction.max(m_min.col(imeshLoc)).min(m_max.col(imeshLoc));
+    }
+
+    /**  \brief  interpolate one function
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \param  p_ifunc  function number
+     *  \return interpolated value
+     */
+    inline double applyOne(const Eigen::ArrayXd &p_point, const int &p_ifunc) const
+    {
+        int nbBasis = m_funcBaseExp.cols();
+        Eigen::VectorXd funcVal(nbBasis);
+        int imeshLoc = basisAtPoint(p_point, funcVal);
+        double vFunction = m_spectral.row(p_ifunc).segment(imeshLoc * nbBasis, nbBasis).matrix().dot(funcVal.transpose());
+        // to avoid oscillations
+        return std::min(std::max(vFunction, m_min(p_ifunc, imeshLoc)), m_max(p_ifunc, imeshLoc));
+    }
+
+    /**  \brief  interpolate one function with an interpolator of the grid : not available here as the grid interpolator
+     *           uses the values at the grid points and not the spectral representation (use applyOne with the point)
+     */
+    inline double applyOne(const Interpolator &, const int &) const
+    {
+        std::cout << "LegendreInterpolatorMultiSpectral : interpolation with a grid interpolator not available, use the point" << std::endl;
+        abort();
+    }
+
+    /// \brief Get back the number of functions interpolated
+    inline int getNbFunctions() const
+    {
+        return m_spectral.rows();
+    }
+
+    /** \brief Get back the spectral values */
+    const Eigen::ArrayXXd &getSpectral() const
+    {
+        return m_spectral ;
+    }
+
+    /** \brief Get back helper */
+    const Eigen::ArrayXXi &getFuncBaseExp() const
+    {
+        return m_funcBaseExp ;
+    }
+
+    /** \brief Get back m_min */
+    const Eigen::ArrayXXd &getMin() const
+    {
+        return m_min ;
+    }
+
+    /** \brief Get back m_max */
+    const Eigen::ArrayXXd &getMax() const
+    {
+        return m_max ;
+    }
+};
+}
+#endif
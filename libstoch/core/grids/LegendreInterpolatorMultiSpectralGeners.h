@@ -0,0 +1,37 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef LEGENDREINTERPOLATORMULTISPECTRALGENERS_H
+#define LEGENDREINTERPOLATORMULTISPECTRALGENERS_H
+#include <geners/AbsReaderWriter.hh>
+#include "libstoch/core/grids/LegendreInterpolatorMultiSpectral.h"
+#include "libstoch/core/grids/InterpolatorMultiSpectralGeners.h"
+
+
+/** \file LegendreInterpolatorMultiSpectralGeners.h
+ * \brief Define non intrusive  serialization with random acces
+*  \author Xavier Warin
+ */
+
+// Concrete reader/writer for class LegendreInterpolatorMultiSpectral
+// Note publication of LegendreInterpolatorMultiSpectral as "wrapped_type".
+struct LegendreInterpolatorMultiSpectralGeners: public gs::AbsReaderWriter<libstoch::InterpolatorMultiSpectral>
+{
+    typedef libstoch::InterpolatorMultiSpectral wrapped_base;
+    typedef libstoch::LegendreInterpolatorMultiSpectral wrapped_type;
+
+    // Methods that have to be overridden from the base
+    bool write(std::ostream &, const wrapped_base &, bool p_dumpId) const override;
+    wrapped_type *read(const gs::ClassId &p_id, std::istream &p_in) const override;
+
+    // The class id for LegendreInterpolatorMultiSpectral  will be needed both in the "read" and "write"
+    // methods. Because of this, we will just return it from one static
+    // function.
+    static const gs::ClassId &wrappedClassId();
+};
+
+gs_specialize_class_id(libstoch::LegendreInterpolatorMultiSpectral, 1)
+gs_declare_type_external(libstoch::LegendreInterpolatorMultiSpectral)
+gs_associate_serialization_factory(libstoch::LegendreInterpolatorMultiSpectral, StaticSerializationFactoryForInterpolatorMultiSpectral)
+
+#endif
@@ -32,6 +32,7 @@ private :
 public :
 
     /** \brief Constructor taking in values on the grid
+     *  The tensorized interpolation weights are calculated once and the meshes are treated in parallel
      *  \param p_grid   is the grid used to interpolate
      *  \param p_values   Function value at the grids points
      */
@@ -0,0 +1,100 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef LINEARINTERPOLATORMULTISPECTRAL_H
+#define LINEARINTERPOLATORMULTISPECTRAL_H
+#include <Eigen/Dense>
+#include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/core/grids/Interpolator.h"
+#include "libstoch/core/grids/InterpolatorMultiSpectral.h"
+
+/** \file LinearInterpolatorMultiSpectral.h
+ *  \brief Defines an interpolator for a set of functions on a linear grid : the values of all the functions are stored
+ *         and interpolated together with a single interpolator per point.
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class LinearInterpolatorMultiSpectral LinearInterpolatorMultiSpectral.h
+/// Linear interpolation object for a set of functions
+class LinearInterpolatorMultiSpectral : public InterpolatorMultiSpectral
+{
+
+    const FullGrid   *m_grid ; //< grid used
+    Eigen::ArrayXXd m_values ; //< Functions values on the  grid  (nb functions, nb points)
+    Eigen::ArrayXXd m_valuesTrans ; //< Functions values on the grid (nb points, nb functions) : the values of a function are contiguous
+
+public :
+
+    /** \brief Constructor taking in values on the grid
+     *  \param p_grid      is the linear  grid used to interpolate
+     *  \param p_values    Functions values on the  grid (nb functions, nb points)
+     */
+    LinearInterpolatorMultiSpectral(const FullGrid *p_grid, const Eigen::ArrayXXd &p_values) : m_grid(p_grid), m_values(p_values), m_valuesTrans(p_values.transpose())
+    {}
+
+    /** \brief Constructor taking the values of the grids , but without affecting the grid
+    *  Convenient for serialization : affectation of the pointer should be done after
+    * \param p_values values associated to the interpolator
+    */
+    LinearInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_values): m_grid(nullptr), m_values(p_values), m_valuesTrans(p_values.transpose()) {}  ;
+
+    /** \brief Affect the grid : use for deserialization
+     * \param p_grid  the grid to affect
+     */
+    void setGrid(const SpaceGrid *p_grid)
+    {
+        m_grid = static_cast< const FullGrid *>(p_grid);
+    }
+
+    /** \brief Get back grid associated to operator
+     */
+    const libstoch::SpaceGrid *getGrid()
+    {
+        return static_cast< const SpaceGrid *>(m_grid);
+    }
+
+    /**  \brief  interpolate all the functions
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \return interpolated values
+     */
+    inline Eigen::ArrayXd apply(const Eigen::ArrayXd &p_point) const
+    {
+        return m_grid->createInterpolator(p_point)->applyVec(m_values);
+    }
+
+    /**  \brief  interpolate one function
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \param  p_ifunc  function number
+     *  \return interpolated value
+     */
+    inline double applyOne(const Eigen::ArrayXd &p_point, const int &p_ifunc) const
+    {
+        return m_grid->createInterpolator(p_point)->apply(m_valuesTrans.col(p_ifunc));
+    }
+
+    /**  \brief  interpolate one function with an interpolator of the grid already created at the point
+     *  \param  p_interpolator  interpolator created by the grid at the point
+     *  \param  p_ifunc         function number
+     *  \return interpolated value
+     */
+    inline double applyOne(const Interpolator &p_interpolator, const int &p_ifunc) const
+    {
+        return p_interpolator.apply(m_valuesTrans.col(p_ifunc));
+    }
+
+    /// \brief Get back the number of functions interpolated
+    inline int getNbFunctions() const
+    {
+        return m_values.rows();
+    }
+
+    /// \brief get back functions values
+    const Eigen::ArrayXXd &getValues() const
+    {
+        return m_values;
+    }
+};
+}
+#endif /* LINEARINTERPOLATORMULTISPECTRAL_H */
@@ -14,6 +14,7 @@
 #include "libstoch/core/grids/FullLegendreGridIterator.h"
 #include "libstoch/core/grids/LegendreInterpolator.h"
 #include "libstoch/core/grids/LegendreInterpolatorSpectral.h"
+#include "libstoch/core/grids/LegendreInterpolatorMultiSpectral.h"
 #include "libstoch/core/grids/RegularLegendreGrid.h"
 #include "libstoch/core/utils/AnalyticLegendre.h"
 
@@ -190,6 +191,60 @@ shared_ptr<InterpolatorSpectral> RegularLegendreGrid::createInterpolatorSpectral
     return  make_shared<LegendreInterpolatorSpectral>(this, p_values);
 }
 
+shared_ptr<InterpolatorMultiSpectral> RegularLegendreGrid::createInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_values) const
+{
+    return  make_shared<LegendreInterpolatorMultiSpectral>(this, p_values);
+}
+
+void RegularLegendreGrid::getSpectralBasis(ArrayXXi &p_funcBaseExp, ArrayXXd &p_weights, ArrayXi &p_shiftPoint) const
+{
+    p_funcBaseExp.resize(m_poly.size(), (1 + m_poly).prod());
+    // utilization
+    ArrayXi  imult(m_poly.size()) ;
+    imult(0) = 1;
+    for (int id = 1; id < m_poly.size(); ++id)
+        imult(id) =  imult(id - 1) * (m_poly(id - 1) + 1);
+    for (int i = 0 ; i < p_funcBaseExp.cols() ; ++i)
+    {
+        int irest = i ;
+        for (int id = m_poly.size() - 1 ; id >= 0; --id)
+        {
+            p_funcBaseExp(id, i) = irest / imult(id);
+            irest = irest % imult(id);
+        }
+    }
+    // weights of the tensorized interpolation
+    int nbBasis = p_funcBaseExp.cols();
+    p_weights.resize(nbBasis, nbBasis);
+    for (int ibb = 0 ; ibb < nbBasis; ++ibb)
+        for (int ib = 0 ; ib < nbBasis; ++ib)
+        {
+            double dfunc = 1 ;
+            for (int id = 0 ; id < m_poly.size() ; ++id)
+                dfunc *= (*m_fInterpol)[id](p_funcBaseExp(id, ib), p_funcBaseExp(id, ibb));
+            p_weights(ib, ibb) = dfunc;
+        }
+    p_shiftPoint.resize(nbBasis);
+    for (int ibb = 0 ; ibb < nbBasis; ++ibb)
+        p_shiftPoint(ibb) = intCoordPerDimToGlobal(p_funcBaseExp.col(ibb));
+}
+
+int RegularLegendreGrid::getMeshFirstPoint(const int &p_imesh) const
+{
+    // utilitarian for coordinates
+    ArrayXi coordMesh(m_poly.size());
+    int imeshLoc = p_imesh;
+    for (int id = 0; id < m_poly.size(); ++id)
+    {
+        int idec = m_nbStep(id);
+        coordMesh(id) = imeshLoc % idec;
+        imeshLoc /= idec;
+    }
+    // translate to point coordinates
+    coordMesh *= m_poly;
+    return intCoordPerDimToGlobal(coordMesh);
+}
+
 void RegularLegendreGrid::rescalepoint(const double  &p_point, const int &p_idim,  double &p_coordLoc, int &p_iCoord)const
 {
     p_iCoord = max(min(roundIntAbove((p_point - m_lowValues(p_idim)) / m_step(p_idim)), m_nbStep(p_idim) - 1), 0) * m_poly(p_idim);
@@ -144,6 +144,11 @@ public :
     /// \return  the whole interpolated  value function
     std::shared_ptr<InterpolatorSpectral> createInterpolatorSpectral(const Eigen::ArrayXd &p_values) const ;
 
+    /// \brief Get back a spectral operator associated to a set of functions
+    /// \param p_values   Functions values at the grids points (nb functions, nb points)
+    /// \return  the whole interpolated  value functions
+    std::shared_ptr<InterpolatorMultiSpectral> createInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_values) const ;
+
 
     /// \brief Get back the number of points on the meshing
     inline size_t getNbPoints() const
@@ -175,6 +180,17 @@ public :
         return m_fInterpol ;
     }
 
+    /// \brief Tensorized basis used by the spectral interpolators : on a mesh the spectral representation of a function f is
+    ///        \f$ c_{ib} = \sum_{ibb} f(x_{ibb}) w_{ib,ibb} \f$ where the \f$ x_{ibb} \f$ are the collocation points of the mesh
+    /// \param p_funcBaseExp  for each multidimensional basis function, degree of the 1D polynomial in each dimension (dimension, nb basis functions)
+    /// \param p_weights      weights \f$ w \f$ (nb basis functions, nb basis functions) : they don't depend on the mesh
+    /// \param p_shiftPoint   shift of the global number of each collocation point of a mesh compared to the first point of the mesh
+    void getSpectralBasis(Eigen::ArrayXXi &p_funcBaseExp, Eigen::ArrayXXd &p_weights, Eigen::ArrayXi &p_shiftPoint) const;
+
+    /// \brief Get back the global number of the first collocation point of a mesh
+    /// \param p_imesh  mesh number
+    int getMeshFirstPoint(const int &p_imesh) const;
+
     /// \brief get back Legendre polynomials
     inline  std::shared_ptr< std::array< std::function< double(const double &) >, 11 > >  getLegendre() const
     {
@@ -11,6 +11,7 @@
 #include "libstoch/core/grids/FullRegularGridIterator.h"
 #include "libstoch/core/grids/LinearInterpolator.h"
 #include "libstoch/core/grids/LinearInterpolatorSpectral.h"
+#include "libstoch/core/grids/LinearInterpolatorMultiSpectral.h"
 
 
 /** \file RegularSpaceGrid.h
@@ -149,6 +150,14 @@ public :
         return std::make_shared<LinearInterpolatorSpectral>(this, p_values) ;
     }
 
+    /// \brief Get back a spectral operator associated to a set of functions
+    /// \param p_values   Functions values at the grids points (nb functions, nb points)
+    /// \return  the whole interpolated  value functions
+    std::shared_ptr<InterpolatorMultiSpectral> createInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_values) const
+    {
+        return std::make_shared<LinearInterpolatorMultiSpectral>(this, p_values) ;
+    }
+
     /// \brief Get back the number of points on the meshing
     inline size_t getNbPoints() const
     {
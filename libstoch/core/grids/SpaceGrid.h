@@ -9,6 +9,7 @@
 #include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/core/grids/Interpolator.h"
 #include "libstoch/core/grids/InterpolatorSpectral.h"
+#include "libstoch/core/grids/InterpolatorMultiSpectral.h"
 
 /** \file SpaceGrid.h
  *  \brief Defines a  base class for all the grids
@@ -47,6 +48,11 @@ public :
     /// \return  the whole interpolated  value function
     virtual std::shared_ptr<InterpolatorSpectral> createInterpolatorSpectral(const Eigen::ArrayXd &p_values) const = 0;
 
+    /// \brief Get back a spectral operator associated to a set of functions
+    /// \param p_values   Functions values at the grids points (nb functions, nb points)
+    /// \return  the whole interpolated  value functions
+    virtual std::shared_ptr<InterpolatorMultiSpectral> createInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_values) const = 0;
+
     /// \brief Dimension of the grid
     virtual  int getDimension() const = 0 ;
 
@@ -0,0 +1,104 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SPARSEINTERPOLATORMULTISPECTRAL_H
+#define SPARSEINTERPOLATORMULTISPECTRAL_H
+#include <Eigen/Dense>
+#include "libstoch/core/grids/Interpolator.h"
+#include "libstoch/core/grids/SparseSpaceGrid.h"
+#include "libstoch/core/grids/InterpolatorMultiSpectral.h"
+
+/** \file SparseInterpolatorMultiSpectral.h
+ *  \brief Defines an interpolator for a set of functions on a sparse grid : the hierarchized values of all the functions
+ *         are stored and interpolated together with a single interpolator per point.
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class SparseInterpolatorMultiSpectral SparseInterpolatorMultiSpectral.h
+/// Sparse interpolation object for a set of functions
+class SparseInterpolatorMultiSpectral : public InterpolatorMultiSpectral
+{
+
+    const SparseSpaceGrid *m_grid ;  //< grid used
+    Eigen::ArrayXXd m_hierar ; //< Hierarchized values of the functions  to interpolate (nb functions, nb points)
+    Eigen::ArrayXXd m_hierarTrans ; //< Hierarchized values (nb points, nb functions) : the values of a function are contiguous
+
+public :
+
+    /** \brief Constructor taking in values on the grid
+     *  \param p_grid      is the sparse  grid used to interpolate
+     *  \param p_values    Functions values on the sparse grid (nb functions, nb points)
+     */
+    SparseInterpolatorMultiSpectral(const SparseSpaceGrid *p_grid, const Eigen::ArrayXXd &p_values) : m_grid(p_grid), m_hierar(p_values)
+    {
+        // store hierarchized values
+        p_grid->toHierarchizeVec(m_hierar);
+        m_hierarTrans = m_hierar.transpose();
+    }
+
+    /** \brief Constructor convenient for deserialization
+     * \param p_hierar  Hierarchical values
+     */
+    SparseInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_hierar): m_hierar(p_hierar), m_hierarTrans(p_hierar.transpose()) {}
+
+    /** \brief Affect the grid : use for deserialization
+     * \param p_grid  the grid to affect
+     */
+    void setGrid(const SpaceGrid *p_grid)
+    {
+        m_grid = static_cast< const SparseSpaceGrid *>(p_grid);
+    }
+
+    /** \brief Get back grid associated to operator
+     */
+    const libstoch::SpaceGrid *getGrid()
+    {
+        return static_cast< const SpaceGrid *>(m_grid);
+    }
+
+    /**  \brief  interpolate all the functions
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \return interpolated values
+     */
+    inline Eigen::ArrayXd apply(const Eigen::ArrayXd &p_point) const
+    {
+        return m_grid->createInterpolator(p_point)->applyVec(m_hierar);
+    }
+
+    /**  \brief  interpolate one function
+     *  \param  p_point  coordinates of the point for interpolation
+     *  \param  p_ifunc  function number
+     *  \return interpolated value
+     */
+    inline double applyOne(const Eigen::ArrayXd &p_point, const int &p_ifunc) const
+    {
+        return m_grid->createInterpolator(p_point)->apply(m_hierarTrans.col(p_ifunc));
+    }
+
+    /**  \brief  interpolate one function with an interpolator of the grid already created at the point
+     *  \param  p_interpolator  interpolator created by the grid at the point
+     *  \param  p_ifunc         function number
+     *  \return interpolated value
+     */
+    inline double applyOne(const Interpolator &p_interpolator, const int &p_ifunc) const
+    {
+        return p_interpolator.apply(m_hierarTrans.col(p_ifunc));
+    }
+
+    /// \brief Get back the number of functions interpolated
+    inline int getNbFunctions() const
+    {
+        return m_hierar.rows();
+    }
+
+    /**  \brief Get back hierarchical values
+     */
+    const Eigen::ArrayXXd   &getHierar() const
+    {
+        return m_hierar;
+    }
+};
+}
+#endif /* SPARSEINTERPOLATORMULTISPECTRAL_H */
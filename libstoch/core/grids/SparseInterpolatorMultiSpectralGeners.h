@@ -0,0 +1,37 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SPARSEINTERPOLATORMULTISPECTRALGENERS_H
+#define SPARSEINTERPOLATORMULTISPECTRALGENERS_H
+#include <geners/AbsReaderWriter.hh>
+#include "libstoch/core/grids/SparseInterpolatorMultiSpectral.h"
+#include "libstoch/core/grids/InterpolatorMultiSpectralGeners.h"
+
+
+/** \file SparseInterpolatorMultiSpectralGeners.h
+ * \brief Define non intrusive  serialization with random acces
+*  \author Xavier Warin
+ */
+
+// Concrete reader/writer for class SparseInterpolatorMultiSpectral
+// Note publication of SparseInterpolatorMultiSpectral as "wrapped_type".
+struct SparseInterpolatorMultiSpectralGeners: public gs::AbsReaderWriter<libstoch::InterpolatorMultiSpectral>
+{
+    typedef libstoch::InterpolatorMultiSpectral wrapped_base;
+    typedef libstoch::SparseInterpolatorMultiSpectral wrapped_type;
+
+    // Methods that have to be overridden from the base
+    bool write(std::ostream &, const wrapped_base &, bool p_dumpId) const override;
+    wrapped_type *read(const gs::ClassId &p_id, std::istream &p_in) const override;
+
+    // The class id for SparseInterpolatorMultiSpectral  will be needed both in the "read" and "write"
+    // methods. Because of this, we will just return it from one static
+    // function.
+    static const gs::ClassId &wrappedClassId();
+};
+
+gs_specialize_class_id(libstoch::SparseInterpolatorMultiSpectral, 1)
+gs_declare_type_external(libstoch::SparseInterpolatorMultiSpectral)
+gs_associate_serialization_factory(libstoch::SparseInterpolatorMultiSpectral, StaticSerializationFactoryForInterpolatorMultiSpectral)
+
+#endif
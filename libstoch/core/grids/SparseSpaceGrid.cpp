@@ -2,9 +2,15 @@
 // All Rights Reserved
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
 #include <memory>
+#include <algorithm>
+#ifdef _OPENMP
+#include <omp.h>
+#include "libstoch/core/utils/OpenmpException.h"
+#endif
 #include "libstoch/core/utils/constant.h"
 #include "libstoch/core/grids/SparseSpaceGrid.h"
 #include "libstoch/core/grids/SparseInterpolatorSpectral.h"
+#include "libstoch/core/grids/SparseInterpolatorMultiSpectral.h"
 
 using namespace libstoch;
 using namespace Eigen;
@@ -68,12 +74,53 @@ shared_ptr<InterpolatorSpectral> SparseSpaceGrid::createInterpolatorSpectral(con
     return make_shared<SparseInterpolatorSpectral>(this, p_values);
 }
 
+shared_ptr<InterpolatorMultiSpectral> SparseSpaceGrid::createInterpolatorMultiSpectral(const ArrayXXd &p_values) const
+{
+    return make_shared<SparseInterpolatorMultiSpectral>(this, p_values);
+}
+
 void SparseSpaceGrid::truncatePoint(ArrayXd &p_point) const
 {
     for (int id = 0 ; id < p_point.size(); ++id)
         p_point(id) = max(m_lowValues(id), min(m_lowValues(id) + m_sizeDomain(id), p_point(id)));
 }
 
+void SparseSpaceGrid::toHierarchizeVecByBlock(ArrayXXd &p_toHierachize) const
+{
+    int nbFunction = p_toHierachize.rows();
+#ifdef _OPENMP
+    int nbThreads = omp_get_max_threads();
+#else
+    int nbThreads = 1;
+#endif
+    int nbFuncPerBlock = max(min((nbFunction + nbThreads - 1) / nbThreads, 64), 1);
+    int nbBlock = (nbFunction + nbFuncPerBlock - 1) / nbFuncPerBlock;
+    int iBlock;
+#ifdef _OPENMP
+    OpenmpException excep; // deal with exception in openmp
+    #pragma omp parallel for schedule(dynamic) private(iBlock)
+#endif
+    for (iBlock = 0; iBlock < nbBlock; ++iBlock)
+    {
+#ifdef _OPENMP
+        excep.run([&]
+        {
+#endif
+            int iFirstFunc = iBlock * nbFuncPerBlock;
+            int nbFuncBlock = min(nbFuncPerBlock, nbFunction - iFirstFunc);
+            // rows of the block are contiguous for each point
+            ArrayXXd tile = p_toHierachize.middleRows(iFirstFunc, nbFuncBlock);
+            toHierarchizeVec(tile);
+            p_toHierachize.middleRows(iFirstFunc, nbFuncBlock) = tile;
+#ifdef _OPENMP
+        });
+#endif
+    }
+#ifdef _OPENMP
+    excep.rethrow();
+#endif
+}
+
 void  SparseSpaceGrid::dimensionAdaptiveInit()
 {
     // clear
@@ -105,12 +152,56 @@ void  SparseSpaceGrid::dimensionAdaptiveInit()
     }
 }
 
+vector<double> SparseSpaceGrid::levelErrors(const vector<SparseSet::const_iterator> &p_levels, const ArrayXd &p_hierarValues,
+                                             const function< double(const SparseSet::const_iterator &, const ArrayXd &)> &p_phi,
+                                             const bool &p_bParallel) const
+{
+    vector<double> errors(p_levels.size());
+    if (p_bParallel)
+    {
+        int il ;
+#ifdef _OPENMP
+        OpenmpException excep; // deal with exception in openmp
+        #pragma omp parallel for schedule(dynamic) private(il)
+#endif
+        for (il = 0; il < static_cast<int>(p_levels.size()); ++il)
+        {
+#ifdef _OPENMP
+            excep.run([&]
+            {
+#endif
+                errors[il] = p_phi(p_levels[il], p_hierarValues);
+#ifdef _OPENMP
+            });
+#endif
+        }
+#ifdef _OPENMP
+        excep.rethrow();
+#endif
+    }
+    else
+    {
+        for (size_t il = 0; il < p_levels.size(); ++il)
+            errors[il] = p_phi(p_levels[il], p_hierarValues);
+    }
+    return errors;
+}
+
 pair< vector<SparseSet::const_iterator>, double>   SparseSpaceGrid::dimensionRefineStep(const ArrayXd &p_hierarValues,
         const function< double(const SparseSet::const_iterator &, const ArrayXd &)> &p_phi,
         const function< double(const vector< double> &)> &p_phiMult,
         const double &p_precision,
-        std::map<  SparseSet::const_iterator, double, OrderLevel > &p_error)
+        std::map<  SparseSet::const_iterator, double, OrderLevel > &p_error,
+        const bool &p_bParallel)
 {
+    // errors on the active levels not yet calculated
+    vector<SparseSet::const_iterator> levelNoError;
+    for (const auto &level : m_activeLevel)
+        if (p_error.find(level) == p_error.end())
+            levelNoError.push_back(level);
+    vector<double> errorNew = levelErrors(levelNoError, p_hierarValues, p_phi, p_bParallel);
+    for (size_t il = 0; il < levelNoError.size(); ++il)
+        p_error[levelNoError[il]] = errorNew[il];
     // find the active level with the highest error
     SparseSet::const_iterator iterErrorMax ;
     double errorLocMax = 0. ;
@@ -118,17 +209,7 @@ pair< vector<SparseSet::const_iterator>, double>   SparseSpaceGrid::dimensionRef
     vecError.reserve(m_activeLevel.size());
     for (const auto &level : m_activeLevel)
     {
-        auto  iterError = p_error.find(level);
-        double errLoc = 0 ;
-        if (iterError == p_error.end())
-        {
-            errLoc = p_phi(level, p_hierarValues);
-            p_error[level] = errLoc;
-        }
-        else
-        {
-            errLoc = iterError->second;
-        }
+        double errLoc = p_error[level];
         vecError.push_back(errLoc);
         if (errLoc > errorLocMax)
         {
@@ -192,16 +273,20 @@ void SparseSpaceGrid::refine(const double &p_precision, const function<double(co
                              const function< double(const SparseSet::const_iterator &, const ArrayXd &)> &p_phi,
                              const function< double(const vector< double> &) > &p_phiMult,
                              ArrayXd &p_valuesFunction,
-                             ArrayXd &p_hierarValues)
+                             ArrayXd &p_hierarValues,
+                             const bool &p_bParallel)
 {
 
     dimensionAdaptiveInit();
     // to store the local error on each level
     std::map<  SparseSet::const_iterator, double, OrderLevel >  errorLevel;
+    // levels added
+    vector<SparseSet::const_iterator> newLevels;
     double error = infty;
     while (error > p_precision)
     {
-        auto  levelAndPrec = dimensionRefineStep(p_hierarValues, p_phi, p_phiMult, p_precision, errorLevel) ;
+        auto  levelAndPrec = dimensionRefineStep(p_hierarValues, p_phi, p_phiMult, p_precision, errorLevel, p_bParallel) ;
+        newLevels.insert(newLevels.end(), levelAndPrec.first.begin(), levelAndPrec.first.end());
         // update erro
         error = get<1>(levelAndPrec);
         // resize
@@ -211,22 +296,62 @@ void SparseSpaceGrid::refine(const double &p_precision, const function<double(co
             p_hierarValues.conservativeResize(nbPt);
             p_valuesFunction.conservativeResize(nbPt);
             // add nodal values
-            for (size_t i = 0; i < levelAndPrec.first.size(); ++i)
+            if (p_bParallel)
             {
-                shared_ptr<SparseGridIterator> iterGridLevel = getLevelGridIterator(levelAndPrec.first[i]);
-                while (iterGridLevel->isValid())
+#ifdef _OPENMP
+                int nbThreads = omp_get_max_threads();
+#else
+                int nbThreads = 1;
+#endif
+                int iThread = 0 ;
+#ifdef _OPENMP
+                OpenmpException excep; // deal with exception in openmp
+                #pragma omp parallel for  private(iThread)
+#endif
+                for (iThread = 0; iThread < nbThreads; ++iThread)
                 {
-                    ArrayXd pointCoord = iterGridLevel->getCoordinate();
-                    p_valuesFunction(iterGridLevel->getCount()) = p_fInterpol(pointCoord);
-                    iterGridLevel->next();
+#ifdef _OPENMP
+                    excep.run([&]
+                    {
+#endif
+                        for (size_t i = 0; i < levelAndPrec.first.size(); ++i)
+                        {
+                            shared_ptr<SparseGridIterator> iterGridLevel = getLevelGridIteratorInc(levelAndPrec.first[i], iThread);
+                            while (iterGridLevel->isValid())
+                            {
+                                ArrayXd pointCoord = iterGridLevel->getCoordinate();
+                                p_valuesFunction(iterGridLevel->getCount()) = p_fInterpol(pointCoord);
+                                iterGridLevel->nextInc(nbThreads);
+                            }
+                        }
+#ifdef _OPENMP
+                    });
+#endif
                 }
-                // hierarchize the level
-                toHierarchizePByPLevel(p_valuesFunction, levelAndPrec.first[i], p_hierarValues);
+#ifdef _OPENMP
+                excep.rethrow();
+#endif
             }
+            else
+            {
+                for (size_t i = 0; i < levelAndPrec.first.size(); ++i)
+                {
+                    shared_ptr<SparseGridIterator> iterGridLevel = getLevelGridIterator(levelAndPrec.first[i]);
+                    while (iterGridLevel->isValid())
+                    {
+                        ArrayXd pointCoord = iterGridLevel->getCoordinate();
+                        p_valuesFunction(iterGridLevel->getCount()) = p_fInterpol(pointCoord);
+                        iterGridLevel->next();
+                    }
+                }
+            }
+            // hierarchize the levels : hierarchical values of a level only depend on nodal values of its ancestors
+            for (size_t i = 0; i < levelAndPrec.first.size(); ++i)
+                toHierarchizePByPLevel(p_valuesFunction, levelAndPrec.first[i], p_hierarValues);
         }
     }
-    // now recalculate son to be able to use added points in interpolation
-    recalculateSon();
+    // now update son to be able to use added points in interpolation : only the added levels and their fathers are concerned
+    updateSon(newLevels);
 
 }
 
@@ -297,17 +422,19 @@ SparseSet::const_iterator  SparseSpaceGrid::dimensionCoarsenStep(map< SparseSet:
 void SparseSpaceGrid::coarsen(const double &p_precision,
                               const function< double(const SparseSet::const_iterator &, const ArrayXd &)> &p_phi,
                               ArrayXd &p_valuesFunction,
-                              ArrayXd   &p_hierarValues)
+                              ArrayXd   &p_hierarValues,
+                              const bool &p_bParallel)
 {
     dimensionAdaptiveInit();
     // select index potentially to remove
     map< SparseSet::const_iterator, double, OrderLevel > levelPotenRm;
-    for (const auto &level : m_activeLevel)
+    vector<SparseSet::const_iterator> levelActive(m_activeLevel.begin(), m_activeLevel.end());
+    vector<double> errorActive = levelErrors(levelActive, p_hierarValues, p_phi, p_bParallel);
+    for (size_t il = 0; il < levelActive.size(); ++il)
     {
-        double errLoc  = p_phi(level, p_hierarValues);
-        if (errLoc < p_precision)
+        if (errorActive[il] < p_precision)
         {
-            levelPotenRm[level] = errLoc;
+            levelPotenRm[levelActive[il]] = errorActive[il];
         }
     }
 
@@ -329,6 +456,7 @@ void SparseSpaceGrid::coarsen(const double &p_precision,
         m_nbPoints = modifyHierarAndDataSetAfterCoarsen(p_hierarValues, p_valuesFunction);
 
         // now recalculate son to be able to use added points in interpolation
+        // (all the points are renumbered after coarsening : the sons are calculated again for all levels in parallel)
         recalculateSon();
     }
 
@@ -36,13 +36,25 @@ private :
     /// \param p_phiMult         from an error defined on different levels, send back a global error on the different levels
     /// \param p_precision      precision target
     /// \param  p_error      permits to store the errors on each active level during refinement
+    /// \param p_bParallel     if true the errors of the active levels are calculated in parallel
     /// \return  The multi levels added to refine (as  iterators),  the error reached
     std::pair< std::vector<SparseSet::const_iterator>,  double>  dimensionRefineStep(const Eigen::ArrayXd &p_hierarValues,
             const std::function< double(const SparseSet::const_iterator &,
                                         const Eigen::ArrayXd &)> &p_phi,
             const std::function< double(const std::vector< double> &) > &p_phiMult,
             const double &p_precision,
-            std::map<  SparseSet::const_iterator, double, OrderLevel > &p_error) ;
+            std::map<  SparseSet::const_iterator, double, OrderLevel > &p_error,
+            const bool &p_bParallel) ;
+
+    /// \brief Error calculated on some levels
+    /// \param p_levels        levels where the error is calculated
+    /// \param p_hierarValues  hierarchical values calculated on the current dataSet
+    /// \param p_phi           function for the error on a given level in the m_dataSet structure
+    /// \param p_bParallel     if true the errors are calculated in parallel
+    /// \return error on each level
+    std::vector<double> levelErrors(const std::vector<SparseSet::const_iterator> &p_levels, const Eigen::ArrayXd &p_hierarValues,
+                                    const std::function< double(const SparseSet::const_iterator &, const Eigen::ArrayXd &)> &p_phi,
+                                    const bool &p_bParallel) const;
 
 
     /// \brief Realize one step of coarsening the grid (data structure modified, active levels , old levels modified)
@@ -154,11 +166,14 @@ public :
     /// \param p_phiMult         from an error defined on different levels, send back a global error on the different levels
     /// \param p_valuesFunction  an array storing the nodal values
     /// \param  p_hierarValues  an array storing hierarchized values (updated)
+    /// \param p_bParallel      if true, the function is evaluated on the new points in parallel and the errors on the active levels
+    ///                         are calculated in parallel (p_fInterpol and p_phi should be thread safe)
     void refine(const double &p_precision, const std::function<double(const Eigen::ArrayXd &p_x)> &p_fInterpol,
                 const std::function< double(const SparseSet::const_iterator &, const Eigen::ArrayXd &)> &p_phi,
                 const std::function< double(const std::vector< double> &) > &p_phiMult,
                 Eigen::ArrayXd &p_valuesFunction,
-                Eigen::ArrayXd &p_hierarValues);
+                Eigen::ArrayXd &p_hierarValues,
+                const bool &p_bParallel = false);
 
 
     /// \brief Dimension adaptation coarsening : modify data struture by trying to remove all levels with local error
@@ -167,9 +182,11 @@ public :
     /// \param p_phi            function for the error on a given level in the m_dataSet structure
     /// \param p_valuesFunction  an array storing the nodal values (modified on the new struture)
     /// \param p_hierarValues   Hierarchical values on a data structure (modified on the new structure)
+    /// \param p_bParallel      if true the errors on the active levels are calculated in parallel (p_phi should be thread safe)
     void coarsen(const double &p_precision,  const std::function< double(const SparseSet::const_iterator &, const Eigen::ArrayXd &)> &p_phi,
                  Eigen::ArrayXd &p_valuesFunction,
-                 Eigen::ArrayXd   &p_hierarValues);
+                 Eigen::ArrayXd   &p_hierarValues,
+                 const bool &p_bParallel = false);
 
     /// \brief Accessor
     ///@{
@@ -234,6 +251,10 @@ public :
     virtual void toHierarchize(Eigen::ArrayXd &p_toHierachize) const = 0 ;
     /// \param p_toHierachize  array of values at nodal points : the values (each row of _toHierachize corresponds to a function value) are hierarchized.
     virtual void toHierarchizeVec(Eigen::ArrayXXd &p_toHierachize) const = 0 ;
+    /// \brief Hierarchize a set of functions by blocks of rows treated in parallel by threads :
+    ///        blocks are small enough to give work to all threads and large enough to use the vectorized hierarchization
+    /// \param p_toHierachize  array of values at nodal points : the values (each row of _toHierachize corresponds to a function value) are hierarchized.
+    void toHierarchizeVecByBlock(Eigen::ArrayXXd &p_toHierachize) const ;
     /// \brief Hierarchize some points defined on the sparse grids
     ///        Hierarchization is performed point by point
     /// \param p_nodalValues         function to hierarchize
@@ -264,6 +285,11 @@ public :
     /// \return interpolator at the point coordinates  on the grid
     std::shared_ptr<InterpolatorSpectral> createInterpolatorSpectral(const Eigen::ArrayXd &p_coord) const ;
 
+    /// \brief Get back a spectral operator associated to a set of functions
+    /// \param p_values   Functions values at the grids points (nb functions, nb points)
+    /// \return  the whole interpolated  value functions
+    std::shared_ptr<InterpolatorMultiSpectral> createInterpolatorMultiSpectral(const Eigen::ArrayXXd &p_values) const ;
+
 
     /// \brief Get back a grid iterator on a given level of the grid
     /// \param p_iterLevel  iterator on a multi level in the sparse grid
@@ -281,6 +307,10 @@ public :
     /// \brief Recalculate son
     virtual void recalculateSon() = 0;
 
+    /// \brief Update son after refinement : only the sons of the new levels and of their fathers are calculated
+    /// \param p_newLevels  levels added since the last son calculation
+    virtual void updateSon(const std::vector<SparseSet::const_iterator> &p_newLevels) = 0;
+
 };
 }
 
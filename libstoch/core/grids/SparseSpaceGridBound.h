@@ -104,6 +104,13 @@ public :
         m_iBase = sonEvaluationBound(*m_dataSet,  m_weight.size(), m_nbPoints, *m_son, *m_neighbourBound);
     }
 
+    /// \brief Update son after refinement
+    /// \param p_newLevels  levels added since the last son calculation
+    void updateSon(const std::vector<SparseSet::const_iterator> &p_newLevels)
+    {
+        m_iBase = sonUpdateBound(*m_dataSet,  m_weight.size(), m_nbPoints, p_newLevels, *m_son, *m_neighbourBound);
+    }
+
     /// \brief get back iterator associated to the grid (multi thread)
     /// \param   p_iThread  Thread number  (for multi thread purpose)
     std::shared_ptr< GridIterator> getGridIteratorInc(const int &p_iThread) const
@@ -222,7 +229,7 @@ public :
             {
 
 #ifdef _OPENMP
-                cnt = +1;
+                cnt += 1;
                 if ((cnt - 1) % nthreads != ithread) continue;
 #endif
                 p_hierarchized(position.second) = SparseGridHierarOnePointLinBound<double, Eigen::ArrayXd>()(p_iterLevel->first, position.first, *m_dataSet, p_nodalValues);
@@ -89,6 +89,13 @@ public :
         m_iBase = sonEvaluationNoBound(*m_dataSet,  m_weight.size(), m_nbPoints, *m_son);
     }
 
+    /// \brief Update son after refinement
+    /// \param p_newLevels  levels added since the last son calculation
+    void updateSon(const std::vector<SparseSet::const_iterator> &p_newLevels)
+    {
+        m_iBase = sonUpdateNoBound(*m_dataSet,  m_weight.size(), m_nbPoints, p_newLevels, *m_son);
+    }
+
     /// \brief get back iterator associated to the grid (multi thread)
     /// \param   p_iThread  Thread number  (for multi thread purpose)
     std::shared_ptr< GridIterator> getGridIteratorInc(const int &p_iThread) const
@@ -207,7 +214,7 @@ public :
             for (const auto &position : p_iterLevel->second)
             {
 #ifdef _OPENMP
-                cnt = +1;
+                cnt += 1;
                 if ((cnt - 1) % nthreads != ithread) continue;
 #endif
                 p_hierarchized(position.second) = SparseGridHierarOnePointLinNoBound<double, Eigen::ArrayXd>()(p_iterLevel->first, position.first, *m_dataSet, p_nodalValues);
@@ -228,7 +235,7 @@ public :
             for (const auto &position : p_iterLevel->second)
             {
 #ifdef _OPENMP
-                cnt = +1;
+                cnt += 1;
                 if ((cnt - 1) % nthreads != ithread) continue;
 #endif
                 p_hierarchized(position.second) = SparseGridHierarOnePointQuadNoBound<double, Eigen::ArrayXd>()(p_iterLevel->first, position.first, *m_dataSet, p_nodalValues);
@@ -251,7 +258,7 @@ public :
             for (const auto &position : p_iterLevel->second)
             {
 #ifdef _OPENMP
-                cnt = +1;
+                cnt += 1;
                 if ((cnt - 1) % nthreads != ithread) continue;
 #endif
                 p_hierarchized(position.second) = SparseGridHierarOnePointCubicNoBound<double, Eigen::ArrayXd>()(p_iterLevel->first, position.first, *m_dataSet, p_nodalValues);
@@ -359,7 +366,7 @@ public :
             for (const auto &position : p_iterLevel->second)
             {
 #ifdef _OPENMP
-                cnt = +1;
+                cnt += 1;
                 if ((cnt - 1) % nthreads != ithread) continue;
 #endif
 
@@ -380,7 +387,7 @@ public :
             for (const auto &position : p_iterLevel->second)
             {
 #ifdef _OPENMP
-                cnt = +1;
+                cnt += 1;
                 if ((cnt - 1) % nthreads != ithread) continue;
 #endif
 
@@ -402,7 +409,7 @@ public :
             for (const auto &position : p_iterLevel->second)
             {
 #ifdef _OPENMP
-                cnt = +1;
+                cnt += 1;
                 if ((cnt - 1) % nthreads != ithread) continue;
 #endif
                 p_hierarchized.col(position.second) = SparseGridHierarOnePointCubicNoBound< Eigen::ArrayXd, Eigen::ArrayXXd>()(p_iterLevel->first, position.first, *m_dataSet, p_nodalValues);
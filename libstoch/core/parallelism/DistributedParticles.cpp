@@ -0,0 +1,284 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifdef USE_MPI
+#include <memory>
+#include <boost/mpi.hpp>
+#include "libstoch/core/utils/constant.h"
+#include "libstoch/core/utils/primeNumber.h"
+#include "libstoch/core/utils/NodeParticleSplitting.h"
+#include "libstoch/core/utils/Instrumentation.h"
+#include "libstoch/core/parallelism/allGatherv.h"
+#include "libstoch/core/parallelism/DistributedParticles.h"
+
+using namespace std;
+using namespace Eigen;
+
+namespace libstoch
+{
+
+DistributedParticles::DistributedParticles(const ArrayXXd &p_statevector, const ArrayXi &p_iReg, const ArrayXXd &p_phi,
+        const boost::mpi::communicator &p_world, const double &p_maxImbalance): m_nbSimul(p_statevector.cols()),
+    m_region(p_statevector.rows(), p_world.size()), m_world(p_world), m_maxImbalance(p_maxImbalance), m_nbMigrated(0), m_nbSplit(0),
+    m_bDegenerate(false)
+{
+    split(p_statevector, p_iReg, p_phi);
+}
+
+void DistributedParticles::split(const ArrayXXd &p_statevector, const ArrayXi &p_iReg, const ArrayXXd &p_phi)
+{
+    m_nbSplit += 1;
+    int nDim = p_statevector.rows();
+    // same splitting as in SimulateStepSemilagrangDist
+    unique_ptr<ArrayXXd >  particles(new ArrayXXd(p_statevector.transpose()));
+    // only the dimensions where the states are spread are split
+    vector<int> dimSpread;
+    for (int id = 0; id < nDim; ++id)
+        if ((m_nbSimul > 0) && (p_statevector.row(id).minCoeff() < p_statevector.row(id).maxCoeff()))
+            dimSpread.push_back(id);
+    if (dimSpread.size() == 0)
+        dimSpread.push_back(0);
+    ArrayXi splittingRatio = ArrayXi::Constant(nDim, 1);
+    vector<int> prime = primeNumber(m_world.size());
+    int idim = 0; // roll the dimensions
+    for (size_t i = 0; i < prime.size(); ++i)
+    {
+        splittingRatio(dimSpread[idim % dimSpread.size()]) *= prime[i];
+        idim += 1;
+    }
+    NodeParticleSplitting splitparticle(particles, splittingRatio);
+    ArrayXi nCell(m_nbSimul);
+    splitparticle.simToCell(nCell, m_region);
+    // outer bounds are pushed to infinity so that the regions cover the whole space
+    m_bDegenerate = false;
+    for (int id = 0; id < nDim; ++id)
+    {
+        double xMin = infty;
+        double xMax = -infty;
+        for (int iproc = 0; iproc < m_world.size(); ++iproc)
+        {
+            xMin = min(xMin, m_region(id, iproc)[0]);
+            xMax = max(xMax, m_region(id, iproc)[1]);
+        }
+        for (int iproc = 0; iproc < m_world.size(); ++iproc)
+        {
+            if (m_region(id, iproc)[0] <= xMin)
+                m_region(id, iproc)[0] = -infty;
+            if (m_region(id, iproc)[1] >= xMax)
+                m_region(id, iproc)[1] = infty;
+        }
+        // all the states are the same : each region covers the whole space
+        if ((splittingRatio(id) > 1) && (xMin >= xMax))
+            m_bDegenerate = true;
+    }
+    // keep simulations of the processor
+    int nbLoc = (nCell == m_world.rank()).count();
+    m_simNumber.resize(nbLoc);
+    m_states.resize(nDim, nbLoc);
+    m_iReg.resize(nbLoc);
+    m_phi.resize(p_phi.rows(), nbLoc);
+    int iloc = 0;
+    for (int is = 0; is < m_nbSimul; ++is)
+        if (nCell(is) == m_world.rank())
+        {
+            m_simNumber(iloc) = is;
+            m_states.col(iloc) = p_statevector.col(is);
+            m_iReg(iloc) = p_iReg(is);
+            m_phi.col(iloc) = p_phi.col(is);
+            iloc += 1;
+        }
+}
+
+bool DistributedParticles::isInRegion(const Ref< const ArrayXd > &p_state, const int &p_iproc) const
+{
+    for (int id = 0; id < p_state.size(); ++id)
+        if ((p_state(id) < m_region(id, p_iproc)[0]) || (p_state(id) > m_region(id, p_iproc)[1]))
+            return false;
+    return true;
+}
+
+int DistributedParticles::owner(const Ref< const ArrayXd > &p_state) const
+{
+    for (int iproc = 0; iproc < m_world.size(); ++iproc)
+        if (isInRegion(p_state, iproc))
+            return iproc;
+    // regions cover the whole space
+    return m_world.rank();
+}
+
+void DistributedParticles::migrate()
+{
+    if (m_bDegenerate)
+    {
+        // regions recalculated once the states reached are spread : bounds of the states of all the processors
+        int nDim = m_states.rows();
+        ArrayXd boundLoc(2 * nDim);
+        for (int id = 0; id < nDim; ++id)
+        {
+            boundLoc(id) = ((m_states.cols() > 0) ? m_states.row(id).minCoeff() : infty);
+            boundLoc(nDim + id) = ((m_states.cols() > 0) ? -m_states.row(id).maxCoeff() : infty);
+        }
+        ArrayXd bound(2 * nDim);
+        boost::mpi::all_reduce(m_world, boundLoc.data(), 2 * nDim, bound.data(), boost::mpi::minimum<double>());
+        if ((bound.head(nDim) < -bound.tail(nDim)).any())
+            resplit();
+        else
+            // states still the same : each processor keeps its simulations
+            m_nbMigrated = 0;
+        return;
+    }
+    InstrumentationTimer timerCommunication(instCommunication);
+    int nbProc = m_world.size();
+    int rank = m_world.rank();
+    // simulations kept and sent
+    vector<int> keep;
+    keep.reserve(m_simNumber.size());
+    vector< vector<int> > toSend(nbProc);
+    for (int is = 0; is < m_simNumber.size(); ++is)
+    {
+        int iproc = (isInRegion(m_states.col(is), rank) ? rank : owner(m_states.col(is)));
+        if (iproc == rank)
+            keep.push_back(is);
+        else
+            toSend[iproc].push_back(is);
+    }
+    vector<int> nbSend(nbProc), nbRecv(nbProc);
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+        nbSend[iproc] = toSend[iproc].size();
+    boost::mpi::all_to_all(m_world, nbSend, nbRecv);
+    // a simulation is sent as its number, its regime, its state and its functions
+    int nDim = m_states.rows();
+    int nbFunc = m_phi.rows();
+    int sizeSim = 2 + nDim + nbFunc;
+    vector< ArrayXXd > bufferRecv(nbProc), bufferSend(nbProc);
+    vector< boost::mpi::request > requests;
+    long nbBytes = 0;
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+        if (nbRecv[iproc] > 0)
+        {
+            bufferRecv[iproc].resize(sizeSim, nbRecv[iproc]);
+            requests.push_back(m_world.irecv(iproc, 0, bufferRecv[iproc].data(), bufferRecv[iproc].size()));
+            nbBytes += static_cast<long>(bufferRecv[iproc].size()) * sizeof(double);
+        }
+    m_nbMigrated = 0;
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+        if (nbSend[iproc] > 0)
+        {
+            bufferSend[iproc].resize(sizeSim, nbSend[iproc]);
+            for (int ip = 0; ip < nbSend[iproc]; ++ip)
+            {
+                int is = toSend[iproc][ip];
+                bufferSend[iproc](0, ip) = m_simNumber(is);
+                bufferSend[iproc](1, ip) = m_iReg(is);
+                bufferSend[iproc].col(ip).segment(2, nDim) = m_states.col(is);
+                bufferSend[iproc].col(ip).segment(2 + nDim, nbFunc) = m_phi.col(is);
+            }
+            requests.push_back(m_world.isend(iproc, 0, bufferSend[iproc].data(), bufferSend[iproc].size()));
+            m_nbMigrated += nbSend[iproc];
+        }
+    boost::mpi::wait_all(requests.begin(), requests.end());
+    instrumentBytes(nbBytes);
+    // new simulations owned
+    int nbLoc = keep.size();
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+        nbLoc += nbRecv[iproc];
+    ArrayXi simNumber(nbLoc);
+    ArrayXXd states(nDim, nbLoc);
+    ArrayXi iReg(nbLoc);
+    ArrayXXd phi(nbFunc, nbLoc);
+    int iloc = 0;
+    for (int is : keep)
+    {
+        simNumber(iloc) = m_simNumber(is);
+        states.col(iloc) = m_states.col(is);
+        iReg(iloc) = m_iReg(is);
+        phi.col(iloc) = m_phi.col(is);
+        iloc += 1;
+    }
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+        for (int ip = 0; ip < nbRecv[iproc]; ++ip)
+        {
+            simNumber(iloc) = static_cast<int>(bufferRecv[iproc](0, ip));
+            iReg(iloc) = static_cast<int>(bufferRecv[iproc](1, ip));
+            states.col(iloc) = bufferRecv[iproc].col(ip).segment(2, nDim);
+            phi.col(iloc) = bufferRecv[iproc].col(ip).segment(2 + nDim, nbFunc);
+            iloc += 1;
+        }
+    m_simNumber = simNumber;
+    m_states = states;
+    m_iReg = iReg;
+    m_phi = phi;
+    timerCommunication.stop();
+    // recalculate the regions if unbalanced
+    int nbMaxLoc = boost::mpi::all_reduce(m_world, static_cast<int>(m_simNumber.size()), boost::mpi::maximum<int>());
+    if ((nbProc > 1) && (nbMaxLoc > m_maxImbalance * m_nbSimul / nbProc))
+    {
+        int nbMigrated = m_nbMigrated;
+        resplit();
+        m_nbMigrated += nbMigrated;
+    }
+}
+
+void DistributedParticles::resplit()
+{
+    ArrayXXd statesAll;
+    ArrayXi iRegAll;
+    ArrayXXd phiAll;
+    gather(statesAll, iRegAll, phiAll);
+    ArrayXi simNumberPrev = m_simNumber;
+    split(statesAll, iRegAll, phiAll);
+    // simulations previously owned now owned by another processor
+    vector<bool> bOwned(m_nbSimul, false);
+    for (int is = 0; is < m_simNumber.size(); ++is)
+        bOwned[m_simNumber(is)] = true;
+    m_nbMigrated = 0;
+    for (int is = 0; is < simNumberPrev.size(); ++is)
+        if (!bOwned[simNumberPrev(is)])
+            m_nbMigrated += 1;
+}
+
+void DistributedParticles::gather(ArrayXXd &p_statevector, ArrayXi &p_iReg, ArrayXXd &p_phi) const
+{
+    vector<int> simAllProc;
+    allGatherv<int>(m_world, m_simNumber.data(), m_simNumber.size(), simAllProc);
+    vector<double> stateAllSim;
+    allGatherv<double>(m_world, m_states.data(), m_states.size(), stateAllSim);
+    vector<int> regAllSim;
+    allGatherv<int>(m_world, m_iReg.data(), m_iReg.size(), regAllSim);
+    vector<double> phiAllSim;
+    allGatherv<double>(m_world, m_phi.data(), m_phi.size(), phiAllSim);
+    int nDim = m_states.rows();
+    int nbFunc = m_phi.rows();
+    p_statevector.resize(nDim, m_nbSimul);
+    p_iReg.resize(m_nbSimul);
+    p_phi.resize(nbFunc, m_nbSimul);
+    for (size_t is = 0; is < simAllProc.size(); ++is)
+    {
+        p_statevector.col(simAllProc[is]) = Map<const ArrayXd>(&stateAllSim[is * nDim], nDim);
+        p_iReg(simAllProc[is]) = regAllSim[is];
+        p_phi.col(simAllProc[is]) = Map<const ArrayXd>(&phiAllSim[is * nbFunc], nbFunc);
+    }
+}
+
+vector< array< double, 2> > DistributedParticles::getBoundingBox() const
+{
+    int nDim = m_states.rows();
+    vector< array< double, 2> > box(nDim);
+    for (int id = 0; id < nDim; ++id)
+    {
+        if (m_states.cols() > 0)
+        {
+            box[id][0] = m_states.row(id).minCoeff();
+            box[id][1] = m_states.row(id).maxCoeff();
+        }
+        else
+        {
+            double xLow = max(m_region(id, m_world.rank())[0], min(m_region(id, m_world.rank())[1], 0.));
+            box[id][0] = xLow;
+            box[id][1] = xLow;
+        }
+    }
+    return box;
+}
+}
+#endif
@@ -0,0 +1,120 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef DISTRIBUTEDPARTICLES_H
+#define DISTRIBUTEDPARTICLES_H
+#include <array>
+#include <vector>
+#include <boost/mpi.hpp>
+#include <Eigen/Dense>
+
+/** \file DistributedParticles.h
+ *  \brief Simulations spread on processors with a persistent ownership.
+ *         The state space is split once in as many regions as processors, each region containing the same number of particles
+ *         at the creation. Then each processor only keeps the simulations it owns : after each time step, only the simulations
+ *         whose state left the region of the processor are sent to the owner of their new region (point to point exchanges).
+ *         The simulations are gathered on all processors only when needed (output dates).
+ *         If the migrations unbalance the processors too much, the regions are recalculated from the current states.
+ *         Only the dimensions where the states are spread are split. When the states can't be split at all (for example
+ *         when all simulations start from the same state), the regions cover the whole space : they are recalculated
+ *         by the first migration where the states reached are spread.
+ *  \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class DistributedParticles DistributedParticles.h
+/// Simulations owned by the processor
+class DistributedParticles
+{
+private :
+
+    int m_nbSimul ; ///< total number of simulations
+    Eigen::ArrayXi m_simNumber ; ///< global number of the simulations owned by the processor
+    Eigen::ArrayXXd m_states ; ///< states of the simulations owned (size of the state, number of simulations owned)
+    Eigen::ArrayXi m_iReg ; ///< regime of the simulations owned
+    Eigen::ArrayXXd m_phi ; ///< functions followed by the simulations owned (number of functions, number of simulations owned)
+    Eigen::Array< std::array<double, 2 >, Eigen::Dynamic, Eigen::Dynamic > m_region ; ///< region of each processor (dimension, number of processors) : outer bounds are infinite
+    boost::mpi::communicator m_world ; ///< MPI communicator
+    double m_maxImbalance ; ///< the regions are recalculated if a processor owns more than m_maxImbalance times the mean number of simulations
+    int m_nbMigrated ; ///< number of simulations sent to other processors by the last migration
+    int m_nbSplit ; ///< number of times the regions have been calculated
+    bool m_bDegenerate ; ///< true if the states could not be split (all the same) : the regions are recalculated when the states are spread
+
+    /// \brief calculate the regions and keep the simulations of the processor
+    /// \param p_statevector    states of all the simulations (size of the state, number of simulations)
+    /// \param p_iReg           regime of all the simulations
+    /// \param p_phi            functions followed by all the simulations (number of functions, number of simulations)
+    void split(const Eigen::ArrayXXd &p_statevector, const Eigen::ArrayXi &p_iReg, const Eigen::ArrayXXd &p_phi);
+
+    /// \brief gather the simulations and recalculate the regions from their states
+    void resplit();
+
+    /// \brief test if a state belongs to the region of a processor
+    bool isInRegion(const Eigen::Ref< const Eigen::ArrayXd > &p_state, const int &p_iproc) const;
+
+    /// \brief processor owning the region of a state
+    int owner(const Eigen::Ref< const Eigen::ArrayXd > &p_state) const;
+
+public :
+
+    /// \brief Constructor : split the simulations between processors
+    /// \param p_statevector    states of all the simulations (size of the state, number of simulations)
+    /// \param p_iReg           regime of all the simulations
+    /// \param p_phi            functions followed by all the simulations (number of functions, number of simulations)
+    /// \param p_world          MPI communicator
+    /// \param p_maxImbalance   the regions are recalculated after a migration if a processor owns more than p_maxImbalance times the mean number of simulations
+    DistributedParticles(const Eigen::ArrayXXd &p_statevector, const Eigen::ArrayXi &p_iReg, const Eigen::ArrayXXd &p_phi,
+                         const boost::mpi::communicator &p_world, const double &p_maxImbalance = 2.);
+
+    /// \brief send the simulations which left the region of the processor to their new owner
+    ///        (the regions are recalculated if the processors are unbalanced or if the regions are degenerate and the states spread)
+    void migrate();
+
+    /// \brief gather all the simulations on all processors
+    /// \param p_statevector    states of all the simulations (size of the state, number of simulations)
+    /// \param p_iReg           regime of all the simulations
+    /// \param p_phi            functions followed by all the simulations (number of functions, number of simulations)
+    void gather(Eigen::ArrayXXd &p_statevector, Eigen::ArrayXi &p_iReg, Eigen::ArrayXXd &p_phi) const;
+
+    /// \brief bounding box of the states of the simulations owned (degenerate box inside the region if no simulation is owned)
+    std::vector< std::array< double, 2> > getBoundingBox() const;
+
+    /// \brief get back the global number of the simulations owned
+    inline const Eigen::ArrayXi &getSimNumbers() const
+    {
+        return m_simNumber;
+    }
+    /// \brief get back the states of the simulations owned
+    inline Eigen::ArrayXXd &getStates()
+    {
+        return m_states;
+    }
+    /// \brief get back the regimes of the simulations owned
+    inline Eigen::ArrayXi &getRegimes()
+    {
+        return m_iReg;
+    }
+    /// \brief get back the functions followed by the simulations owned
+    inline Eigen::ArrayXXd &getPhi()
+    {
+        return m_phi;
+    }
+    /// \brief number of simulations sent to other processors by the last migration (including the recalculation of the regions)
+    inline int getNbMigrated() const
+    {
+        return m_nbMigrated;
+    }
+    /// \brief true if the regions are degenerate (all the states are the same)
+    inline bool isDegenerate() const
+    {
+        return m_bDegenerate;
+    }
+    /// \brief number of times the regions have been calculated (1 if they have never been recalculated)
+    inline int getNbSplit() const
+    {
+        return m_nbSplit;
+    }
+};
+}
+#endif /* DISTRIBUTEDPARTICLES_H */
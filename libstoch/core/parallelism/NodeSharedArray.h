@@ -0,0 +1,200 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef NODESHAREDARRAY_H
+#define NODESHAREDARRAY_H
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/mpi.hpp>
+#include <boost/mpi/exception.hpp>
+#include <boost/mpi/datatype.hpp>
+
+/** \file NodeSharedArray.h
+ *  \brief Read only array shared by all the processors of a compute node (MPI-3 shared memory window).
+ *         Only the first processor of the node allocates the memory, the other processors of the node map it :
+ *         the array is stored once per node instead of once per processor.
+ *         The array is filled by the first processor of the node (fill) or by all the processors of the world,
+ *         each processor giving a part (allGatherv). Then all the processors of the node can read it.
+ *         Used by TransitionStepRegressionDP to store the values of all the grid points gathered at each time step.
+ *  \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class NodeSharedArray NodeSharedArray.h
+/// Array of T shared by the processors of a node
+template< typename T >
+class NodeSharedArray
+{
+private :
+
+    boost::mpi::communicator m_world ; ///< communicator of all processors
+    MPI_Comm m_nodeComm ; ///< communicator of the processors sharing the memory
+    MPI_Comm m_leaderComm ; ///< communicator of the first processors of each node (MPI_COMM_NULL for other processors)
+    MPI_Win m_win ; ///< shared memory window
+    T *m_data ; ///< shared memory
+    size_t m_size ; ///< number of elements
+    bool m_bFiller ; ///< true for the first processor of the node
+    std::vector<int> m_nodeOfRank ; ///< for each processor of m_world, the number of its node
+
+public :
+
+    /// \brief Constructor (collective on p_world)
+    /// \param p_world           communicator of all the processors
+    /// \param p_size            number of elements of the array
+    /// \param p_nbRankPerGroup  if positive, the processors of a node are split in groups of p_nbRankPerGroup processors each sharing an array
+    NodeSharedArray(const boost::mpi::communicator &p_world, const size_t &p_size, const int &p_nbRankPerGroup = 0):
+        m_world(p_world), m_leaderComm(MPI_COMM_NULL), m_data(nullptr), m_size(p_size)
+    {
+        BOOST_MPI_CHECK_RESULT(MPI_Comm_split_type, (p_world, MPI_COMM_TYPE_SHARED, p_world.rank(), MPI_INFO_NULL, &m_nodeComm));
+        int nodeRank = 0;
+        MPI_Comm_rank(m_nodeComm, &nodeRank);
+        if (p_nbRankPerGroup > 0)
+        {
+            MPI_Comm groupComm;
+            BOOST_MPI_CHECK_RESULT(MPI_Comm_split, (m_nodeComm, nodeRank / p_nbRankPerGroup, nodeRank, &groupComm));
+            MPI_Comm_free(&m_nodeComm);
+            m_nodeComm = groupComm;
+            MPI_Comm_rank(m_nodeComm, &nodeRank);
+        }
+        m_bFiller = (nodeRank == 0);
+        // memory allocated by the first processor only
+        MPI_Aint sizeLoc = (m_bFiller ? p_size * sizeof(T) : 0);
+        T *baseLoc = nullptr;
+        BOOST_MPI_CHECK_RESULT(MPI_Win_allocate_shared, (sizeLoc, sizeof(T), MPI_INFO_NULL, m_nodeComm, &baseLoc, &m_win));
+        MPI_Aint sizeFiller = 0;
+        int dispUnit = 0;
+        BOOST_MPI_CHECK_RESULT(MPI_Win_shared_query, (m_win, 0, &sizeFiller, &dispUnit, &m_data));
+        // passive epoch for the whole life of the window : synchronizations with MPI_Win_sync
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win);
+        // communicator between nodes
+        BOOST_MPI_CHECK_RESULT(MPI_Comm_split, (p_world, (m_bFiller ? 0 : MPI_UNDEFINED), p_world.rank(), &m_leaderComm));
+        int leaderRank = p_world.rank();
+        MPI_Bcast(&leaderRank, 1, MPI_INT, 0, m_nodeComm);
+        std::vector<int> leaderOfRank;
+        boost::mpi::all_gather(p_world, leaderRank, leaderOfRank);
+        // leaders are numbered in the world order in m_leaderComm
+        std::vector<int> leaders(leaderOfRank);
+        std::sort(leaders.begin(), leaders.end());
+        leaders.erase(std::unique(leaders.begin(), leaders.end()), leaders.end());
+        m_nodeOfRank.resize(leaderOfRank.size());
+        for (size_t ir = 0; ir < leaderOfRank.size(); ++ir)
+            m_nodeOfRank[ir] = std::lower_bound(leaders.begin(), leaders.end(), leaderOfRank[ir]) - leaders.begin();
+    }
+
+    NodeSharedArray(const NodeSharedArray &) = delete;
+    NodeSharedArray &operator=(const NodeSharedArray &) = delete;
+
+    /// \brief Destructor (collective)
+    ~NodeSharedArray()
+    {
+        MPI_Win_unlock_all(m_win);
+        MPI_Win_free(&m_win);
+        if (m_leaderComm != MPI_COMM_NULL)
+            MPI_Comm_free(&m_leaderComm);
+        MPI_Comm_free(&m_nodeComm);
+    }
+
+    /// \brief wait for all the processors of the node : writings of the processors of the node are then seen by all of them
+    void synchronize()
+    {
+        MPI_Win_sync(m_win);
+        MPI_Barrier(m_nodeComm);
+        MPI_Win_sync(m_win);
+    }
+
+    /// \brief fill the array by the first processor of each node (collective on the node)
+    /// \param p_fill  function called with the array and its size on the first processor of the node
+    template< class Fill >
+    void fill(const Fill &p_fill)
+    {
+        synchronize();
+        if (m_bFiller)
+            p_fill(m_data, m_size);
+        synchronize();
+    }
+
+    /// \brief gather the values of all the processors of the world in the array (collective on p_world)
+    ///        The values of the processors are stored one after the other following their rank.
+    ///        Each processor writes its part, then the first processors of the nodes exchange the parts of their node
+    ///        (without copy using a datatype describing the parts of the node).
+    ///        The array must be large enough for the values of all the processors.
+    /// \param p_local      values of the processor
+    /// \param p_localSize  number of values of the processor
+    void allGatherv(const T *p_local, const int &p_localSize)
+    {
+        std::vector<int> sizes;
+        boost::mpi::all_gather(m_world, p_localSize, sizes);
+        // positions in elements (the array may have more elements than an int can count)
+        std::vector<MPI_Aint> displs(sizes.size(), 0);
+        for (size_t ir = 1; ir < sizes.size(); ++ir)
+            displs[ir] = displs[ir - 1] + sizes[ir - 1];
+        if (static_cast<size_t>(displs.back() + sizes.back()) > m_size)
+            throw std::length_error("NodeSharedArray::allGatherv : array too small for the values gathered");
+        // previous values read by all processors of the node
+        synchronize();
+        std::copy(p_local, p_local + p_localSize, m_data + displs[m_world.rank()]);
+        synchronize();
+        if (m_bFiller)
+        {
+            int nbNode = 0;
+            MPI_Comm_size(m_leaderComm, &nbNode);
+            MPI_Datatype type = boost::mpi::get_mpi_datatype<T>(*p_local);
+            for (int inode = 0; inode < nbNode; ++inode)
+            {
+                std::vector<int> sizeNode;
+                std::vector<MPI_Aint> displNode;
+                for (size_t ir = 0; ir < sizes.size(); ++ir)
+                    if ((m_nodeOfRank[ir] == inode) && (sizes[ir] > 0))
+                    {
+                        sizeNode.push_back(sizes[ir]);
+                        // displacements in bytes
+                        displNode.push_back(displs[ir] * static_cast<MPI_Aint>(sizeof(T)));
+                    }
+                if (sizeNode.size() == 0)
+                    continue;
+                MPI_Datatype typeNode;
+                BOOST_MPI_CHECK_RESULT(MPI_Type_create_hindexed, (static_cast<int>(sizeNode.size()), sizeNode.data(), displNode.data(), type, &typeNode));
+                BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&typeNode));
+                BOOST_MPI_CHECK_RESULT(MPI_Bcast, (m_data, 1, typeNode, inode, m_leaderComm));
+                MPI_Type_free(&typeNode);
+            }
+        }
+        synchronize();
+    }
+
+    /// \brief shared values
+    inline const T *data() const
+    {
+        return m_data;
+    }
+
+    /// \brief shared values (to be modified only in fill)
+    inline T *data()
+    {
+        return m_data;
+    }
+
+    /// \brief number of elements
+    inline size_t size() const
+    {
+        return m_size;
+    }
+
+    /// \brief true for the processor filling the array on the node
+    inline bool isFiller() const
+    {
+        return m_bFiller;
+    }
+
+    /// \brief number of processors sharing the array
+    inline int getNbRankSharing() const
+    {
+        int nbRank = 0;
+        MPI_Comm_size(m_nodeComm, &nbRank);
+        return nbRank;
+    }
+};
+}
+#endif /* NODESHAREDARRAY_H */
@@ -5,6 +5,7 @@
 #include <memory>
 #include <array>
 #include <functional>
+#include <algorithm>
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
 #include <boost/archive/text_oarchive.hpp>
@@ -47,9 +48,7 @@ Array< std::array<int, 2 >, Dynamic, 1 >   paraSplitComputationGridsProc(const A
 {
     size_t nDim = p_grid.size();
     // check ratio and processor
-    int dim_mult = 1;
-    for (size_t id = 0 ; id < nDim; ++id)
-        dim_mult *= p_splittingRatio(id);
+    int dim_mult = p_splittingRatio.prod();
     //assert(dim_mult <= p_world.size());
     if (p_iProc >= dim_mult)
     {
@@ -57,17 +56,42 @@ Array< std::array<int, 2 >, Dynamic, 1 >   paraSplitComputationGridsProc(const A
     }
     else
     {
-        int iProcLoc =  p_iProc;
+        // coordinates of the processor in the split
+        ArrayXi ratio(nDim);
+        ArrayXi coordinate(nDim);
+        if (p_splittingRatio.size() == static_cast<int>(2 * nDim))
+        {
+            // two levels : node then processor in the node
+            int nbRankPerNode = p_splittingRatio.tail(nDim).prod();
+            int iNode = p_iProc / nbRankPerNode;
+            int iRank = p_iProc % nbRankPerNode;
+            for (size_t id = 0 ; id < nDim; ++id)
+            {
+                ratio(id) = p_splittingRatio(id) * p_splittingRatio(nDim + id);
+                coordinate(id) = (iNode % p_splittingRatio(id)) * p_splittingRatio(nDim + id) + iRank % p_splittingRatio(nDim + id);
+                iNode /= p_splittingRatio(id);
+                iRank /= p_splittingRatio(nDim + id);
+            }
+        }
+        else
+        {
+            int iProcLoc =  p_iProc;
+            for (size_t id = 0 ; id < nDim; ++id)
+            {
+                ratio(id) = p_splittingRatio(id);
+                coordinate(id) = iProcLoc % p_splittingRatio(id);
+                iProcLoc /= p_splittingRatio(id);
+            }
+        }
         Array< std::array<int, 2 >, Dynamic, 1 > dim_ret(nDim) ;
         for (size_t id = 0 ; id < nDim; ++id)
         {
-            int processor_coordinate = iProcLoc % p_splittingRatio(id);
-            iProcLoc /= p_splittingRatio(id);
-            int nb_m_meshPerProc = p_grid(id) / p_splittingRatio(id);
-            int nrest = p_grid(id) % p_splittingRatio(id);
+            int processor_coordinate = coordinate(id);
+            int nb_m_meshPerProc = p_grid(id) / ratio(id);
+            int nrest = p_grid(id) % ratio(id);
             int igridMin = processor_coordinate * nb_m_meshPerProc + ((processor_coordinate < nrest) ? processor_coordinate : nrest);
             int nb_m_meshPerProc_cor = nb_m_meshPerProc + ((processor_coordinate < nrest) ? 1 : 0);
-            int igridMax = ((processor_coordinate == p_splittingRatio(id) - 1) ? p_grid(id) : igridMin + nb_m_meshPerProc_cor);
+            int igridMax = ((processor_coordinate == ratio(id) - 1) ? p_grid(id) : igridMin + nb_m_meshPerProc_cor);
             dim_ret(id)[0] =   igridMin;
             dim_ret(id)[1] =   igridMax;
         }
@@ -75,6 +99,183 @@ Array< std::array<int, 2 >, Dynamic, 1 >   paraSplitComputationGridsProc(const A
     }
 }
 
+/// \brief number of points in the intersection of two grids
+static long nbPointsInIntersection(const Array< std::array<int, 2 >, Dynamic, 1 > &p_hCube1, const Array< std::array<int, 2 >, Dynamic, 1 > &p_hCube2)
+{
+    long nbPoints = 1;
+    for (int id = 0; id < p_hCube1.size(); ++id)
+        nbPoints *= std::max(std::min(p_hCube1(id)[1], p_hCube2(id)[1]) - std::max(p_hCube1(id)[0], p_hCube2(id)[0]), 0);
+    return nbPoints;
+}
+
+/// \brief grid of a node for a two levels splitting : from the grid of its first processor to the grid of its last processor
+static Array< std::array<int, 2 >, Dynamic, 1 > nodeGrid(const ArrayXi &p_grid, const ArrayXi &p_splittingRatio, const int &p_iNode)
+{
+    int nbRankPerNode = p_splittingRatio.tail(p_grid.size()).prod();
+    Array< std::array<int, 2 >, Dynamic, 1 > gridFirst = paraSplitComputationGridsProc(p_grid, p_splittingRatio, p_iNode * nbRankPerNode);
+    Array< std::array<int, 2 >, Dynamic, 1 > gridLast = paraSplitComputationGridsProc(p_grid, p_splittingRatio, (p_iNode + 1) * nbRankPerNode - 1);
+    for (int id = 0; id < p_grid.size(); ++id)
+        gridFirst(id)[1] = gridLast(id)[1];
+    return gridFirst;
+}
+
+/// \brief all the decompositions of p_n as a product of ratios in each dimension
+/// \param p_n          number to decompose
+/// \param p_id         current dimension
+/// \param p_maxRatio   maximal ratio in each dimension
+/// \param p_ratio      ratios of the dimensions already treated
+/// \param p_ratios     decompositions found
+static void factorizations(const int &p_n, const int &p_id, const ArrayXi &p_maxRatio, ArrayXi &p_ratio, std::vector<ArrayXi> &p_ratios)
+{
+    if (p_id == p_maxRatio.size())
+    {
+        if (p_n == 1)
+            p_ratios.push_back(p_ratio);
+        return;
+    }
+    for (int ratio = 1; ratio <= std::min(p_n, p_maxRatio(p_id)); ++ratio)
+        if (p_n % ratio == 0)
+        {
+            p_ratio(p_id) = ratio;
+            factorizations(p_n / ratio, p_id + 1, p_maxRatio, p_ratio, p_ratios);
+        }
+}
+
+std::array<long, 2> paraSplittingCommunicationVolume(const ArrayXi &p_initDimension, const ArrayXi &p_initDimensionPrev,
+        const std::function<  Array<  std::array<int, 2 >, Dynamic, 1 >(const Array<  std::array<int, 2 >, Dynamic, 1 > &) > &p_gridCalcExt,
+        const ArrayXi &p_splittingRatio, const int &p_nbRankPerNode)
+{
+    std::array<long, 2> volume = {{0, 0}};
+    int nbProc = p_splittingRatio.prod();
+    bool bTwoLevels = (p_splittingRatio.size() == 2 * p_initDimension.size()) && (p_splittingRatio.tail(p_initDimension.size()).prod() == p_nbRankPerNode);
+    std::vector< Array< std::array<int, 2 >, Dynamic, 1 > > gridPrev(nbProc);
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+        gridPrev[iproc] = paraSplitComputationGridsProc(p_initDimensionPrev, p_splittingRatio, iproc);
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+    {
+        Array< std::array<int, 2 >, Dynamic, 1 > gridExt = p_gridCalcExt(paraSplitComputationGridsProc(p_initDimension, p_splittingRatio, iproc));
+        int iNode = iproc / p_nbRankPerNode;
+        long nbPointsNode = 0;
+        long nbPointsOther = 0;
+        if (bTwoLevels)
+        {
+            // the grids of the processors of the node pave the grid of the node
+            long nbPointsExt = nbPointsInIntersection(gridExt, gridExt);
+            nbPointsNode = nbPointsInIntersection(gridExt, nodeGrid(p_initDimensionPrev, p_splittingRatio, iNode));
+            nbPointsOther = nbPointsExt - nbPointsNode;
+        }
+        else
+        {
+            for (int jproc = 0; jproc < nbProc; ++jproc)
+            {
+                long nbPoints = nbPointsInIntersection(gridExt, gridPrev[jproc]);
+                if (jproc / p_nbRankPerNode == iNode)
+                    nbPointsNode += nbPoints;
+                else
+                    nbPointsOther += nbPoints;
+            }
+        }
+        volume[0] += nbPointsOther;
+        volume[1] += nbPointsNode - nbPointsInIntersection(gridExt, gridPrev[iproc]);
+    }
+    return volume;
+}
+
+ArrayXi paraTwoLevelSplitting(const ArrayXi &p_initDimension, const ArrayXi &p_initDimensionPrev,
+                              const Array< bool, Dynamic, 1> &p_bdimToSplit,
+                              const std::function<  Array<  std::array<int, 2 >, Dynamic, 1 >(const Array<  std::array<int, 2 >, Dynamic, 1 > &) > &p_gridCalcExt,
+                              const int &p_nbNode, const int &p_nbRankPerNode)
+{
+    int nDim = p_initDimension.size();
+    // so that each processor gets at least two points in each dimension split
+    ArrayXi maxRatio(nDim);
+    for (int id = 0; id < nDim; ++id)
+        maxRatio(id) = (p_bdimToSplit(id) ? std::max(std::min(p_initDimension(id), p_initDimensionPrev(id)) / 2, 1) : 1);
+    // split between nodes : volume of the extended grid of each node outside the node
+    ArrayXi ratio(nDim);
+    std::vector<ArrayXi> nodeRatios;
+    factorizations(p_nbNode, 0, maxRatio, ratio, nodeRatios);
+    std::vector< std::pair<long, int> > nodeVolume(nodeRatios.size());
+    for (size_t ir = 0; ir < nodeRatios.size(); ++ir)
+    {
+        long volume = 0;
+        for (int inode = 0; inode < p_nbNode; ++inode)
+        {
+            Array< std::array<int, 2 >, Dynamic, 1 > gridExt = p_gridCalcExt(paraSplitComputationGridsProc(p_initDimension, nodeRatios[ir], inode));
+            volume += nbPointsInIntersection(gridExt, gridExt) - nbPointsInIntersection(gridExt, paraSplitComputationGridsProc(p_initDimensionPrev, nodeRatios[ir], inode));
+        }
+        nodeVolume[ir] = std::make_pair(volume, ir);
+    }
+    std::sort(nodeVolume.begin(), nodeVolume.end());
+    // split of the node between its processors for the best node split possible
+    for (const auto &node : nodeVolume)
+    {
+        const ArrayXi &nodeRatio = nodeRatios[node.second];
+        std::vector<ArrayXi> rankRatios;
+        factorizations(p_nbRankPerNode, 0, maxRatio / nodeRatio, ratio, rankRatios);
+        ArrayXi bestRatio;
+        std::array<long, 2> bestVolume = {{0, 0}};
+        for (const auto &rankRatio : rankRatios)
+        {
+            ArrayXi splittingRatio(2 * nDim);
+            splittingRatio << nodeRatio, rankRatio;
+            std::array<long, 2> volume = paraSplittingCommunicationVolume(p_initDimension, p_initDimensionPrev, p_gridCalcExt, splittingRatio, p_nbRankPerNode);
+            if ((bestRatio.size() == 0) || (volume < bestVolume))
+            {
+                bestRatio = splittingRatio;
+                bestVolume = volume;
+            }
+        }
+        if (bestRatio.size() > 0)
+            return bestRatio;
+    }
+    return ArrayXi();
+}
+
+ArrayXi paraTopologySplitting(const ArrayXi &p_initDimension, const ArrayXi &p_initDimensionPrev,
+                              const Array< bool, Dynamic, 1> &p_bdimToSplit,
+                              const std::function<  Array<  std::array<int, 2 >, Dynamic, 1 >(const Array<  std::array<int, 2 >, Dynamic, 1 > &) > &p_gridCalcExt,
+                              const boost::mpi::communicator &p_world)
+{
+    // processors sharing the memory
+    MPI_Comm nodeComm;
+    BOOST_MPI_CHECK_RESULT(MPI_Comm_split_type, (p_world, MPI_COMM_TYPE_SHARED, p_world.rank(), MPI_INFO_NULL, &nodeComm));
+    int nodeRank = 0;
+    MPI_Comm_rank(nodeComm, &nodeRank);
+    int nbRankPerNode = 0;
+    MPI_Comm_size(nodeComm, &nbRankPerNode);
+    MPI_Comm_free(&nodeComm);
+    // check that the nodes have the same number of processors with consecutive numbers
+    int bConsecutive = ((p_world.size() % nbRankPerNode == 0) && (p_world.rank() % nbRankPerNode == nodeRank)) ? 1 : 0;
+    int nbConsecutive = boost::mpi::all_reduce(p_world, bConsecutive, std::plus<int>());
+    int nbRankMin = boost::mpi::all_reduce(p_world, nbRankPerNode, boost::mpi::minimum<int>());
+    int nbRankMax = boost::mpi::all_reduce(p_world, nbRankPerNode, boost::mpi::maximum<int>());
+    if ((nbConsecutive == p_world.size()) && (nbRankMin == nbRankMax))
+    {
+        ArrayXi splittingRatio = paraTwoLevelSplitting(p_initDimension, p_initDimensionPrev, p_bdimToSplit, p_gridCalcExt, p_world.size() / nbRankPerNode, nbRankPerNode);
+        if (splittingRatio.size() > 0)
+            return splittingRatio;
+    }
+    return paraOptimalSplitting(p_initDimension, p_bdimToSplit, p_world);
+}
+
+ArrayXi TopologySplitting::operator()(const ArrayXi &p_initDimension, const Array< bool, Dynamic, 1> &p_bdimToSplit, const boost::mpi::communicator &p_world) const
+{
+    ArrayXi meshExtension = m_meshExtension;
+    ArrayXi initDimension = p_initDimension;
+    // grid of a processor extended on the same grid
+    std::function<  Array<  std::array<int, 2 >, Dynamic, 1 >(const Array<  std::array<int, 2 >, Dynamic, 1 > &) > gridCalcExt = [meshExtension, initDimension](const Array<  std::array<int, 2 >, Dynamic, 1 > &p_grid)
+    {
+        Array<  std::array<int, 2 >, Dynamic, 1 > gridExt(p_grid.size());
+        for (int id = 0; id < p_grid.size(); ++id)
+        {
+            gridExt(id)[0] = std::max(p_grid(id)[0] - meshExtension(id), 0);
+            gridExt(id)[1] = std::min(p_grid(id)[1] + meshExtension(id), initDimension(id));
+        }
+        return gridExt;
+    };
+    return paraTopologySplitting(p_initDimension, p_initDimension, p_bdimToSplit, gridCalcExt, p_world);
+}
 
 
 Array< std::array<int, 2 >, Dynamic, 1 >  ParallelComputeGridSplitting::paraInterHCube(const Ref<const Array< std::array<int, 2 >, Dynamic, 1 > >   &p_hCube1,
@@ -116,6 +317,37 @@ Array< std::array<int, 2 >, Dynamic, 1 >  ParallelComputeGridSplitting::paraInte
 
 
 
+std::vector< Array< std::array<int, 2 >, Dynamic, 1 > > ParallelComputeGridSplitting::paraMessageSlices(const Ref<const Array< std::array<int, 2 >, Dynamic, 1 > > &p_hCube,
+        const size_t &p_bytesPerPoint) const
+{
+    // bytes of an hyperplane orthogonal to the last dimension
+    size_t bytesPerPlane = p_bytesPerPoint;
+    for (size_t id = 0; id + 1 < m_nDim; ++id)
+        bytesPerPlane *= p_hCube(id)[1] - p_hCube(id)[0];
+    int nbPlanePerSlice = std::max(static_cast<int>(m_messageSize / std::max(bytesPerPlane, static_cast<size_t>(1))), 1);
+    std::vector< Array< std::array<int, 2 >, Dynamic, 1 > > slices;
+    for (int iplane = p_hCube(m_nDim - 1)[0]; iplane < p_hCube(m_nDim - 1)[1]; iplane += nbPlanePerSlice)
+    {
+        slices.push_back(p_hCube);
+        slices.back()(m_nDim - 1)[0] = iplane;
+        slices.back()(m_nDim - 1)[1] = std::min(iplane + nbPlanePerSlice, p_hCube(m_nDim - 1)[1]);
+    }
+    return slices;
+}
+
+bool ParallelComputeGridSplitting::paraIsContiguous(const Ref<const Array< std::array<int, 2 >, Dynamic, 1 > > &p_hCube,
+        const Ref<const Array< std::array<int, 2 >, Dynamic, 1 > > &p_hCubeGlob) const
+{
+    // first dimensions complete, then one dimension partial, then dimensions with one point
+    size_t id = 0;
+    while ((id < m_nDim) && (p_hCube(id)[0] == p_hCubeGlob(id)[0]) && (p_hCube(id)[1] == p_hCubeGlob(id)[1]))
+        id += 1;
+    for (size_t idNext = id + 1; idNext < m_nDim; ++idNext)
+        if (p_hCube(idNext)[1] - p_hCube(idNext)[0] > 1)
+            return false;
+    return true;
+}
+
 void ParallelComputeGridSplitting::paraRoutingSchedule(const Array<  std::array<int, 2 >, Dynamic, Dynamic >   &p_gridNeededPerProc,
         const int &p_colNeededPerProc,
         std::vector<bool>    &p_bIntersecHCubeRecLoc,
@@ -174,7 +406,8 @@ void ParallelComputeGridSplitting::paraRoutingSchedule(const Array<  std::array<
 ParallelComputeGridSplitting::ParallelComputeGridSplitting(const ArrayXi  &p_initialDimension,
         const std::function<  Array<  std::array<int, 2 >, Dynamic, 1 >(const Array<  std::array<int, 2 >, Dynamic, 1 > &) > &p_gridCalcExt,
         const ArrayXi  &p_splittingRatio, const boost::mpi::communicator &p_world):
-    m_nDim(p_initialDimension.size()), m_nbProcessorUsed(0), m_meshPerProc(), m_meshPerProcOldGrid(), m_world(p_world)
+    m_nDim(p_initialDimension.size()), m_nbProcessorUsed(0), m_meshPerProc(), m_meshPerProcOldGrid(), m_world(p_world),
+    m_messageSize(1 << 20), m_sendBuffer(p_world.size())
 {
     m_nbProcessorUsed = p_splittingRatio.prod();
     m_nbProcessorUsedPrev = m_nbProcessorUsed;
@@ -214,7 +447,8 @@ ParallelComputeGridSplitting::ParallelComputeGridSplitting(const ArrayXi  &p_ini
 ParallelComputeGridSplitting::ParallelComputeGridSplitting(const ArrayXi  &p_initialDimension, const  ArrayXi  &p_initialDimensionPrev,
         const std::function<  Array<  std::array<int, 2 >, Dynamic, 1 >(const Array<  std::array<int, 2 >, Dynamic, 1 > &) > &p_gridCalcExt,
         const ArrayXi   &p_splittingRatio, const ArrayXi    &p_splittingRatioPrev, const boost::mpi::communicator &p_world):
-    m_nDim(p_initialDimension.size()), m_nbProcessorUsed(0), m_meshPerProc(), m_meshPerProcOldGrid(), m_world(p_world)
+    m_nDim(p_initialDimension.size()), m_nbProcessorUsed(0), m_meshPerProc(), m_meshPerProcOldGrid(), m_world(p_world),
+    m_messageSize(1 << 20), m_sendBuffer(p_world.size())
 {
     m_nbProcessorUsed = p_splittingRatio.prod();
     m_nbProcessorUsedPrev = p_splittingRatioPrev.prod();
@@ -262,7 +496,8 @@ ParallelComputeGridSplitting::ParallelComputeGridSplitting(const ArrayXi  &p_ini
 
 ParallelComputeGridSplitting::ParallelComputeGridSplitting(const ArrayXi  &p_initialDimension,
         const ArrayXi  &p_splittingRatio, const boost::mpi::communicator &p_world):
-    m_nDim(p_initialDimension.size()), m_nbProcessorUsed(0), m_meshPerProc(), m_world(p_world)
+    m_nDim(p_initialDimension.size()), m_nbProcessorUsed(0), m_meshPerProc(), m_world(p_world),
+    m_messageSize(1 << 20), m_sendBuffer(p_world.size())
 {
     m_nbProcessorUsed = p_splittingRatio.prod();
     m_nbProcessorUsedPrev = m_nbProcessorUsed ;
@@ -13,6 +13,7 @@
 #include <Eigen/Dense>
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/utils/eigenSerialization.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/core/parallelism/ParallelHiter.h"
 
 
@@ -53,12 +54,91 @@ Eigen::ArrayXi paraOptimalSplitting(const Eigen::ArrayXi &p_initDimension, const
 
 ///  \brief Split the grid  and give the grid for a given processor
 /// \param p_grid             Give the current grid
-/// \param p_splittingRatio   For each dimension give the splitting ratio
+/// \param p_splittingRatio   For each dimension give the splitting ratio.
+///                           If its size is twice the dimension, the split is done on two levels : the first half gives the split
+///                           between nodes, the second half the split of the part of a node between its processors
+///                           (processors of a node have consecutive numbers).
 /// \param p_iProc            Processor number
 /// \return grid owned by the processor
 Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 >   paraSplitComputationGridsProc(const Eigen::ArrayXi   &p_grid,
         const  Eigen::ArrayXi   &p_splittingRatio, const int &p_iProc);
 
+/// \brief Predicted communication volume of a split of the grids with an extension (cone) of the grid of each processor
+///        Data owned by processor on the previous grid are sent to the processors needing them on their extended grid
+///        (as in ParallelComputeGridSplitting constructed with the same splitting for the current and previous grids)
+/// \param p_initDimension       number of meshes in each direction of the current grid
+/// \param p_initDimensionPrev   number of meshes in each direction of the previous grid
+/// \param p_gridCalcExt         extended grid (on the previous grid) of a grid of the current grid (given by getCone)
+/// \param p_splittingRatio      splitting (one level or two levels as in paraSplitComputationGridsProc)
+/// \param p_nbRankPerNode       number of processors on each node
+/// \return number of grid points received from processors of other nodes, number of grid points received from other processors of the same node
+std::array<long, 2> paraSplittingCommunicationVolume(const Eigen::ArrayXi &p_initDimension, const Eigen::ArrayXi &p_initDimensionPrev,
+        const std::function<  Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, 1 >(const Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, 1 > &) > &p_gridCalcExt,
+        const Eigen::ArrayXi &p_splittingRatio, const int &p_nbRankPerNode);
+
+/// \brief Two levels split of the grid minimizing the communications between nodes
+///        The grid is first split between nodes minimizing the volume of the extended grids of the nodes outside the node,
+///        then the part of each node is split between its processors minimizing the volume received from other nodes
+///        (then from other processors of the node).
+/// \param p_initDimension       number of meshes in each direction of the current grid
+/// \param p_initDimensionPrev   number of meshes in each direction of the previous grid
+/// \param p_bdimToSplit         for each dimension,  true if the dimension should be split
+/// \param p_gridCalcExt         extended grid (on the previous grid) of a grid of the current grid (given by getCone)
+/// \param p_nbNode              number of nodes
+/// \param p_nbRankPerNode       number of processors on each node
+/// \return two levels splitting (size twice the dimension), empty if the grid is too small to use all processors
+Eigen::ArrayXi paraTwoLevelSplitting(const Eigen::ArrayXi &p_initDimension, const Eigen::ArrayXi &p_initDimensionPrev,
+                                     const Eigen::Array< bool, Eigen::Dynamic, 1> &p_bdimToSplit,
+                                     const std::function<  Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, 1 >(const Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, 1 > &) > &p_gridCalcExt,
+                                     const int &p_nbNode, const int &p_nbRankPerNode);
+
+/// \brief Split of the grid taking into account the nodes of the processors of the communicator
+///        A two levels split (paraTwoLevelSplitting) is used when the nodes have the same number of processors
+///        with consecutive numbers, otherwise paraOptimalSplitting is used.
+///        With threads, each processor of the communicator is an MPI process running its threads.
+/// \param p_initDimension       number of meshes in each direction of the current grid
+/// \param p_initDimensionPrev   number of meshes in each direction of the previous grid
+/// \param p_bdimToSplit         for each dimension,  true if the dimension should be split
+/// \param p_gridCalcExt         extended grid (on the previous grid) of a grid of the current grid (given by getCone)
+/// \param p_world               MPI communicator
+/// \return splitting of the grid (one level or two levels)
+Eigen::ArrayXi paraTopologySplitting(const Eigen::ArrayXi &p_initDimension, const Eigen::ArrayXi &p_initDimensionPrev,
+                                     const Eigen::Array< bool, Eigen::Dynamic, 1> &p_bdimToSplit,
+                                     const std::function<  Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, 1 >(const Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, 1 > &) > &p_gridCalcExt,
+                                     const boost::mpi::communicator &p_world);
+
+/// \brief Function giving the splitting of a grid between the processors (as paraOptimalSplitting)
+///        Arguments are the number of meshes in each direction, the dimensions to split and the MPI communicator.
+///        The same function must be used for all the steps of a resolution (final step, transitions, reconstruction),
+///        so that the data of a grid are owned by the same processors at each step.
+///        The simulation steps reading values dumped by each processor take the splitting used in optimization.
+typedef std::function< Eigen::ArrayXi(const Eigen::ArrayXi &, const Eigen::Array< bool, Eigen::Dynamic, 1> &, const boost::mpi::communicator &) > SplittingFunction;
+
+/// \class TopologySplitting ParallelComputeGridSplitting.h
+///        Splitting function using paraTopologySplitting : the grid of a processor is extended by a given number of meshes
+///        on each side to get the grid needed by the processor.
+///        The split only depends on the grid dimensions so it can be used as a SplittingFunction for all the steps.
+class TopologySplitting
+{
+private :
+
+    Eigen::ArrayXi m_meshExtension ; ///< number of meshes added on each side of the grid of a processor in each dimension
+
+public :
+
+    /// \brief Constructor
+    /// \param p_meshExtension  number of meshes added on each side of the grid of a processor in each dimension
+    ///                         (approximation of the cone of the optimizer)
+    explicit TopologySplitting(const Eigen::ArrayXi &p_meshExtension): m_meshExtension(p_meshExtension) {}
+
+    /// \brief Splitting of a grid
+    /// \param p_initDimension   number of meshes in each direction
+    /// \param p_bdimToSplit     for each dimension,  true if the dimension should be split
+    /// \param p_world           MPI communicator
+    /// \return splitting of the grid (one level or two levels)
+    Eigen::ArrayXi operator()(const Eigen::ArrayXi &p_initDimension, const Eigen::Array< bool, Eigen::Dynamic, 1> &p_bdimToSplit, const boost::mpi::communicator &p_world) const;
+};
+
 /// \class  ParallelComputeGridSplitting ParallelComputeGridSplitting.h
 ///         Split the grids of point to split work between processors
 class ParallelComputeGridSplitting
@@ -87,6 +167,10 @@ private :
     Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic >  m_gridToSendToProcessor;
     // store if sending data to other processor
     std::vector< bool>   m_bIntersecHCubeSend;
+    // maximal size in bytes of a message : exchanges are split in messages of this size
+    size_t m_messageSize;
+    // buffers to pack the data sent to each processor, kept from one exchange to the other
+    std::vector< std::vector<char> > m_sendBuffer;
 
     /// \brief Compute the intersection of Hypercubes (grids)  p_hCube1, p_hCube2
     /// \param p_hCube1             Hypercube 1
@@ -144,14 +228,59 @@ private :
                              Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic >   &p_gridComingFromProcessorLoc,
                              Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic >   &p_gridToSendToProcessorLoc);
 
+    /// \brief Split an hypercube in slices along its last dimension, each slice giving a message of at most m_messageSize bytes (at least one hyperplane)
+    /// \param p_hCube         hypercube to split
+    /// \param p_bytesPerPoint size in bytes of the data of a point
+    /// \return slices
+    std::vector< Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > paraMessageSlices(const Eigen::Ref<const Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > &p_hCube,
+            const size_t &p_bytesPerPoint) const;
+
+    /// \brief True if the data of an hypercube are contiguous in the array of the data of a grid containing it
+    /// \param p_hCube      hypercube
+    /// \param p_hCubeGlob  grid containing the hypercube
+    bool paraIsContiguous(const Eigen::Ref<const Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > &p_hCube,
+                          const Eigen::Ref<const Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > &p_hCubeGlob) const;
+
+    /// \brief MPI datatype describing the data of an hypercube inside the array of the data of a grid containing it (to be freed)
+    /// \param p_hCube         hypercube
+    /// \param p_hCubeGlob     grid containing the hypercube
+    /// \param p_firstDimData  size of the first dimension of the array (positive)
+    template< typename T>
+    MPI_Datatype paraHCubeDatatype(const Eigen::Ref<const Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > &p_hCube,
+                                   const Eigen::Ref<const Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > &p_hCubeGlob,
+                                   const int &p_firstDimData) const
+    {
+        std::vector<int> sizes(m_nDim + 1), subSizes(m_nDim + 1), starts(m_nDim + 1);
+        sizes[0] = p_firstDimData;
+        subSizes[0] = p_firstDimData;
+        starts[0] = 0;
+        for (size_t id = 0; id < m_nDim; ++id)
+        {
+            sizes[id + 1] = p_hCubeGlob(id)[1] - p_hCubeGlob(id)[0];
+            subSizes[id + 1] = p_hCube(id)[1] - p_hCube(id)[0];
+            starts[id + 1] = p_hCube(id)[0] - p_hCubeGlob(id)[0];
+        }
+        MPI_Datatype datatype;
+        BOOST_MPI_CHECK_RESULT(MPI_Type_create_subarray, (static_cast<int>(m_nDim + 1), sizes.data(), subSizes.data(), starts.data(), MPI_ORDER_FORTRAN, boost::mpi::get_mpi_datatype<T>(), &datatype));
+        BOOST_MPI_CHECK_RESULT(MPI_Type_commit, (&datatype));
+        return datatype;
+    }
+
     /// \brief Execute the previously calculated routing
+    ///        The hypercube exchanged between two processors is split in slices (messages of at most m_messageSize bytes).
+    ///        Slices are received directly in the target array (with a datatype describing their place in the array).
+    ///        Slices contiguous in the array owned by the processor are sent without copy, others are packed
+    ///        in a buffer kept by the object and sent as soon as packed, so that packing the next slices overlaps the communications.
+    ///        Slices are sent to the processors in turn so that exchanges with a processor don't wait for the ones with other processors.
+    ///        Nothing is exchanged when the first dimension of the data is 0 (same value on the processors exchanging).
     /// \param p_bIntersecHCubeRecLoc                   True if current processor  receives data from current processor
     /// \param p_bIntersecHCubeSendLoc                  True if current processor sends to processor p
     /// \param p_gridComingFromProcessorLoc              vector of grids coming from other processors
     /// \param p_gridToSendToProcessorLoc                vector grid of points to send to other processor
     /// \param p_tabOwnedByProcessor                     Array owned by the processor
     /// \param p_firstDimData                            Size of the first dimension of  p_tabOwnedByProcessor if allocated
-    /// \param p_tabReceiveFromOther                     Array  coming from other processor
+    /// \param p_gridTarget                              Target grid to fill
+    /// \param p_tabOwnedByProcessExtended               Array on the target grid filled with the data coming from other processors
     ///  T can be short int, int, double , float
     template< typename T>
     void paraRoutingExec(const  std::vector<bool>    &p_bIntersecHCubeRecLoc,
@@ -160,69 +289,99 @@ private :
                          const Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic >    &p_gridToSendToProcessorLoc,
                          const Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic >   &p_tabOwnedByProcessor,
                          const int &p_firstDimData,
-                         std::vector< std::shared_ptr< Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic > > >    &p_tabReceiveFromOther)
+                         const Eigen::Ref<const Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > &p_gridTarget,
+                         Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic >   &p_tabOwnedByProcessExtended)
     {
-        // Size of communicator
-        int iRecSize = 0 ;
-        for (int iproc = 0 ; iproc < m_world.size() ; ++iproc)
-            if (iproc < static_cast<int>(p_bIntersecHCubeRecLoc.size()))
-                if ((p_bIntersecHCubeRecLoc[iproc]) && (iproc != m_world.rank())) iRecSize++;
-        std::vector<  boost::mpi::request > reqRec(iRecSize);
-        int iRec = 0 ;
-        // only one message right now (communication are not spread)
+        // no data : no exchange (an empty subarray datatype can't be created)
+        if (p_firstDimData == 0)
+            return;
+        InstrumentationTimer timerCommunication(instCommunication);
+        long nbBytes = 0;
+        size_t bytesPerPoint = static_cast<size_t>(p_firstDimData) * sizeof(T);
+        MPI_Datatype datatypeT = boost::mpi::get_mpi_datatype<T>();
+        // same tag for all the slices (the number of slices is not bounded by MPI_TAG_UB) : messages between two processors
+        // are non overtaking, so slices are received in the order they are sent
+        const int tagSlice = 0;
+        // receive : all the slices are posted first
+        std::vector< MPI_Request > reqRec;
+        std::vector< MPI_Datatype > datatypeRec;
         for (int iproc = 0 ; iproc < static_cast<int>(p_bIntersecHCubeRecLoc.size()) ; ++iproc)
         {
-            // receive
             if ((p_bIntersecHCubeRecLoc[iproc]) && (iproc != m_world.rank()))
             {
-                // Number of mesh point associated
-                int nbPointRec = 1;
-                for (int idim = 0 ; idim < p_gridComingFromProcessorLoc.rows() ; ++idim)
+                std::vector< Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > slices = paraMessageSlices(p_gridComingFromProcessorLoc.col(iproc), bytesPerPoint);
+                ParallelHiter hiter(p_gridComingFromProcessorLoc.col(iproc), p_gridTarget);
+                nbBytes += static_cast<long>(p_firstDimData) * hiter.hCubeSize() * sizeof(T);
+                for (size_t is = 0; is < slices.size(); ++is)
                 {
-                    nbPointRec *= p_gridComingFromProcessorLoc(idim, iproc)[1] - p_gridComingFromProcessorLoc(idim, iproc)[0];
+                    datatypeRec.push_back(paraHCubeDatatype<T>(slices[is], p_gridTarget, p_firstDimData));
+                    reqRec.push_back(MPI_Request());
+                    BOOST_MPI_CHECK_RESULT(MPI_Irecv, (p_tabOwnedByProcessExtended.data(), 1, datatypeRec.back(), iproc, tagSlice, m_world, &reqRec.back()));
                 }
-                p_tabReceiveFromOther[iproc] = std::make_shared< Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic > >(p_firstDimData, nbPointRec);
-                // communication
-                int imesg_iproc = 0;
-                //   receive the data from  other processors
-                reqRec[iRec++] = m_world.irecv(iproc, imesg_iproc++, *p_tabReceiveFromOther[iproc]);
             }
         }
-        // send
-        // Array for sending to other processors
-        std::vector< std::shared_ptr< Eigen::Array< T,  Eigen::Dynamic, Eigen::Dynamic >  >  > tabSend(m_world.size());
-        int iSendSize = 0 ;
-        for (int iproc = 0 ; iproc < m_world.size() ; ++iproc)
-            if (iproc < static_cast<int>(p_bIntersecHCubeSendLoc.size()))
-                if ((p_bIntersecHCubeSendLoc[iproc]) && (iproc != m_world.rank())) iSendSize++ ;
-        std::vector<   boost::mpi::request > reqSend(iSendSize);
-        int iSend = 0 ;
+        // slices to send to each processor
+        std::vector< int > procSend;
+        std::vector< std::vector< Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > > > slicesSend;
+        size_t nbSliceMax = 0;
         for (int iproc = 0 ; iproc < static_cast<int>(p_bIntersecHCubeSendLoc.size()) ; ++iproc)
         {
             if ((p_bIntersecHCubeSendLoc[iproc]) && (iproc != m_world.rank()))
             {
+                procSend.push_back(iproc);
+                slicesSend.push_back(paraMessageSlices(p_gridToSendToProcessorLoc.col(iproc), bytesPerPoint));
+                nbSliceMax = std::max(nbSliceMax, slicesSend.back().size());
+                // buffer to pack the whole hypercube
                 ParallelHiter hiter(p_gridToSendToProcessorLoc.col(iproc), m_meshPerProcOldGrid.col(m_world.rank()));
-                // - compute the number of data to send
+                size_t sizeBuffer = hiter.hCubeSize() * p_firstDimData * sizeof(T);
+                nbBytes += sizeBuffer;
+                if (m_sendBuffer[iproc].size() < sizeBuffer)
+                    m_sendBuffer[iproc].resize(sizeBuffer);
+            }
+        }
+        // send slices in turn to each processor
+        std::vector< MPI_Request > reqSend;
+        std::vector< int > iposBuffer(procSend.size(), 0);
+        for (size_t is = 0; is < nbSliceMax; ++is)
+        {
+            for (size_t ip = 0; ip < procSend.size(); ++ip)
+            {
+                if (is >= slicesSend[ip].size())
+                    continue;
+                int iproc = procSend[ip];
+                ParallelHiter hiter(slicesSend[ip][is], m_meshPerProcOldGrid.col(m_world.rank()));
                 int nbPointSend = hiter.hCubeSize();
-                tabSend[iproc] =  std::make_shared<Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic > >(p_firstDimData, nbPointSend);
-                // copy HyperCube Data MPI operation
-                int segment = hiter.segmentSize();
-                int iposStock = 0;
-                while (hiter.isValid())
+                reqSend.push_back(MPI_Request());
+                if (paraIsContiguous(slicesSend[ip][is], m_meshPerProcOldGrid.col(m_world.rank())))
                 {
-                    int iposIter = hiter.get();
-                    tabSend[iproc]->block(0, iposStock, p_firstDimData, segment) = p_tabOwnedByProcessor.block(0, iposIter,  p_firstDimData, segment);
-                    iposStock += segment;
-                    hiter.next();
+                    // no copy
+                    BOOST_MPI_CHECK_RESULT(MPI_Isend, (const_cast<T *>(p_tabOwnedByProcessor.data()) + static_cast<long>(p_firstDimData) * hiter.get(), p_firstDimData * nbPointSend,
+                                                       datatypeT, iproc, tagSlice, m_world, &reqSend.back()));
                 }
-                // send
-                int imesg_iproc = 0;
-                // Communications
-                reqSend[iSend++] =  m_world.isend(iproc, imesg_iproc++, * tabSend[iproc]);
+                else
+                {
+                    Eigen::Map< Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic > > tabSend(reinterpret_cast<T *>(m_sendBuffer[iproc].data()) + static_cast<long>(p_firstDimData) * iposBuffer[ip],
+                            p_firstDimData, nbPointSend);
+                    int segment = hiter.segmentSize();
+                    int iposStock = 0;
+                    while (hiter.isValid())
+                    {
+                        int iposIter = hiter.get();
+                        tabSend.block(0, iposStock, p_firstDimData, segment) = p_tabOwnedByProcessor.block(0, iposIter,  p_firstDimData, segment);
+                        iposStock += segment;
+                        hiter.next();
+                    }
+                    BOOST_MPI_CHECK_RESULT(MPI_Isend, (tabSend.data(), p_firstDimData * nbPointSend, datatypeT, iproc, tagSlice, m_world, &reqSend.back()));
+                }
+                iposBuffer[ip] += nbPointSend;
             }
         }
-        boost::mpi::wait_all(reqRec.begin(), reqRec.end());
-        boost::mpi::wait_all(reqSend.begin(), reqSend.end());
+        BOOST_MPI_CHECK_RESULT(MPI_Waitall, (static_cast<int>(reqRec.size()), reqRec.data(), MPI_STATUSES_IGNORE));
+        BOOST_MPI_CHECK_RESULT(MPI_Waitall, (static_cast<int>(reqSend.size()), reqSend.data(), MPI_STATUSES_IGNORE));
+        for (auto &datatype : datatypeRec)
+            MPI_Type_free(&datatype);
+        // bytes sent and received
+        instrumentBytes(nbBytes);
     }
 
 
@@ -252,40 +411,6 @@ private :
         }
     }
 
-    /// \brief Unpack data previously sent from other processor and fill the Array value
-    /// \param p_tabReceiveFromOther                         All array portions  coming from other processors to unpack
-    /// \param p_firstDimData                                 Size of the first dimension of  p_tabReceiveFromOther if allocated
-    /// \param p_bIntersecHCubeRecLoc                        True if current processor  receive data from current processor
-    /// \param p_gridComingFromProcessorLoc                  vector of grids coming from other processors
-    /// \param p_gridTarget                                  Target grid to fill
-    /// \param p_tabOwnedByProcessExtended                   Extended array of data owned by processor
-    template< typename T>
-    void  paraUnpackData(const std::vector< std::shared_ptr< Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic > > > &p_tabReceiveFromOther,
-                         const int &p_firstDimData,
-                         const  std::vector<bool>     &p_bIntersecHCubeRecLoc,
-                         const  Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic >            &p_gridComingFromProcessorLoc,
-                         const  Eigen::Ref<const Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, 1 > >        &p_gridTarget,
-                         Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic >   &p_tabOwnedByProcessExtended)
-    {
-        for (int iproc = 0 ; iproc <  static_cast<int>(p_bIntersecHCubeRecLoc.size()) ; ++iproc)
-        {
-            if ((iproc != m_world.rank()) && (p_bIntersecHCubeRecLoc[iproc]))
-            {
-                ParallelHiter hiter(p_gridComingFromProcessorLoc.col(iproc), p_gridTarget);
-                int segment = hiter.segmentSize();
-                int iposStock = 0;
-                while (hiter.isValid())
-                {
-                    int iposIter = hiter.get();
-                    p_tabOwnedByProcessExtended.block(0, iposIter, p_firstDimData, segment) = p_tabReceiveFromOther[iproc]->block(0, iposStock, p_firstDimData, segment);
-                    iposStock += segment;
-                    hiter.next();
-                }
-            }
-        }
-    }
-
-
 public :
 
     /// \brief default : case with GRID1 and GRID2
@@ -335,6 +460,12 @@ public :
     /// \brief Get extended grid used by current processor
     Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, 1 >  getExtendedGridProcOldGrid() const ;
 
+    /// \brief Set the maximal size in bytes of the messages exchanged (default 1 MB, same value on all processors)
+    inline void setMessageSize(const size_t &p_messageSize)
+    {
+        m_messageSize = p_messageSize;
+    }
+
     /// \brief Calculate an array value extended on a grid extended
     /// \param  p_tabOwnedByProcess                  Array of data owned by processor
     /// \return Extended array of data needed by processor
@@ -347,10 +478,9 @@ public :
         boost::mpi::broadcast(m_world, firstDimSize, 0);
         // allocate  new array
         Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic>  tabOwnedByProcessExtended(firstDimSize, m_iSizeExtendedArray);
-        // Array to receive from other processors
-        std::vector< std::shared_ptr< Eigen::Array< T, Eigen::Dynamic, Eigen::Dynamic>  > > tabReceiveFromOther(m_world.size());
-        // routing achieved :
-        paraRoutingExec<T>(m_bIntersecHCubeRec, m_bIntersecHCubeSend, m_gridComingFromProcessor, m_gridToSendToProcessor, p_tabOwnedByProcess, firstDimSize, tabReceiveFromOther);
+        // routing achieved : data from other processors received in the extended array
+        paraRoutingExec<T>(m_bIntersecHCubeRec, m_bIntersecHCubeSend, m_gridComingFromProcessor, m_gridToSendToProcessor, p_tabOwnedByProcess, firstDimSize,
+                           m_extendGridProcOldGrid.col(m_world.rank()), tabOwnedByProcessExtended);
         // use local mesh : if it has data to retrieve from its own data
         if (m_world.rank() < static_cast<int>(m_bIntersecHCubeRec.size()))
             if (m_bIntersecHCubeRec[m_world.rank()])
@@ -372,8 +502,6 @@ public :
                 }
                 paraIntersecWithItself<T>(m_gridToSendToProcessor.col(m_world.rank()), data, firstDimSize, m_extendGridProcOldGrid.col(m_world.rank()), tabOwnedByProcessExtended);
             }
-        // get back to cash flow object all the data that where stored in tabReceiveFromOther
-        paraUnpackData<T>(tabReceiveFromOther, firstDimSize,  m_bIntersecHCubeRec,  m_gridComingFromProcessor, m_extendGridProcOldGrid.col(m_world.rank()), tabOwnedByProcessExtended);
         return tabOwnedByProcessExtended;
     }
 
@@ -400,6 +528,9 @@ public :
             int p_iReconsProc = 0)
     {
         Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic > reconstructedArray;
+        // first dimension of data (can be 0 for some processor)
+        int firstDimSize = 0;
+        boost::mpi::all_reduce(m_world, static_cast<int>(p_tabOwnedByProcess.rows()), firstDimSize, boost::mpi::maximum<int>());
         if (m_world.rank() == p_iReconsProc)
         {
             int isizeRecons = 1 ;
@@ -408,10 +539,8 @@ public :
                 isizeRecons *= p_gridOnProc0(id)[1] - p_gridOnProc0(id)[0];
             }
             // allocate  new array
-            reconstructedArray.resize(p_tabOwnedByProcess.rows(), isizeRecons);
+            reconstructedArray.resize(firstDimSize, isizeRecons);
         }
-        // Array to receive from other processors
-        std::vector< std::shared_ptr< Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic > > > tabReceiveFromOther(m_world.size());
         // local array for intersection, receive,send localization
         std::vector<bool>  bIntersecHCubeRecLoc;
         std::vector<bool>   bIntersecHCubeSendLoc;
@@ -419,10 +548,9 @@ public :
         Eigen::Array<  std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic >    gridToSendToProcessorLoc;
         // Routing
         paraRoutingSchedule(p_gridOnProc0, 1, bIntersecHCubeRecLoc, bIntersecHCubeSendLoc, gridComingFromProcessorLoc, gridToSendToProcessorLoc);
-        // first dimension of data
-        int firstDimSize = p_tabOwnedByProcess.rows();
-        // routing achieved :
-        paraRoutingExec<T>(bIntersecHCubeRecLoc, bIntersecHCubeSendLoc, gridComingFromProcessorLoc, gridToSendToProcessorLoc, p_tabOwnedByProcess, firstDimSize, tabReceiveFromOther);
+        // routing achieved : data from other processors received in the reconstructed array
+        paraRoutingExec<T>(bIntersecHCubeRecLoc, bIntersecHCubeSendLoc, gridComingFromProcessorLoc, gridToSendToProcessorLoc, p_tabOwnedByProcess, firstDimSize,
+                           p_gridOnProc0, reconstructedArray);
         // only for processor p_ReconsProc
         if (m_world.rank() == p_iReconsProc)
         {
@@ -435,8 +563,6 @@ public :
                 // then
                 paraIntersecWithItself<T>(gridIntersected, tabOwnedByProcessIntersec0, firstDimSize, p_gridOnProc0, reconstructedArray);
             }
-            // get back to cash flow object all the data that where stored in tabReceiveFromOther
-            paraUnpackData<T>(tabReceiveFromOther, firstDimSize, bIntersecHCubeRecLoc,  gridComingFromProcessorLoc, p_gridOnProc0, reconstructedArray);
         }
         return reconstructedArray;
     }
@@ -511,11 +637,9 @@ public :
         // routing plan to be effected
         paraRoutingSchedule(extendedGridProcLoc, m_world.size(), bIntersecHCubeRecLoc, bIntersecHCubeSendLoc,
                             gridComingFromProcessorLoc, gridToSendToProcessorLoc);
-        // Array to receive from other processors
-        std::vector< std::shared_ptr< Eigen::Array<T, Eigen::Dynamic, Eigen::Dynamic > > > tabReceiveFromOther(m_world.size());
-        // routing achieved :
+        // routing achieved : data from other processors received in the reconstructed array
         paraRoutingExec<T>(bIntersecHCubeRecLoc, bIntersecHCubeSendLoc, gridComingFromProcessorLoc, gridToSendToProcessorLoc,
-                           p_tabOwnedByProcess, nSizeFirstDim, tabReceiveFromOther);
+                           p_tabOwnedByProcess, nSizeFirstDim, extendedGridProcLoc.col(m_world.rank()), reconstructedArray);
         // use local mesh : if it has data to retrieve from its own data
         if (m_world.rank() < static_cast<int>(bIntersecHCubeRecLoc.size()))
             if (bIntersecHCubeRecLoc[m_world.rank()])
@@ -526,8 +650,6 @@ public :
                 paraIntersecDataHyperCube<T>(p_tabOwnedByProcess,  m_meshPerProc.col(m_world.rank()), p_gridOnProc, tabOwnedByProcessIntersec, nSizeFirstDim, gridIntersected);
                 paraIntersecWithItself<T>(gridIntersected, tabOwnedByProcessIntersec, nSizeFirstDim, p_gridOnProc, reconstructedArray);
             }
-        // get back to cash flow objet all the data that where stored in tabReceiveFromOther
-        paraUnpackData<T>(tabReceiveFromOther, nSizeFirstDim, bIntersecHCubeRecLoc,  gridComingFromProcessorLoc, extendedGridProcLoc.col(m_world.rank()), reconstructedArray);
 
         return reconstructedArray;
     }
@@ -0,0 +1,83 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SHAREDTASKQUEUE_H
+#define SHAREDTASKQUEUE_H
+#include <boost/mpi.hpp>
+#include <boost/mpi/exception.hpp>
+
+/** \file SharedTaskQueue.h
+ *  \brief Queue of tasks numbered from 0 shared by all the processors of a communicator.
+ *         The next task is given by an atomic increment of a counter stored by the first processor
+ *         (MPI-3 one sided communication) : a processor asks for a new task as soon as it has finished the previous one,
+ *         without waiting for the other processors.
+ *         Used by backwardSDDPAsync to deal the LP of a wave of dates.
+ *  \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class SharedTaskQueue SharedTaskQueue.h
+/// Deal tasks 0, 1, ..., nbTask - 1 to the processors asking for them
+class SharedTaskQueue
+{
+private :
+
+    boost::mpi::communicator m_world ; ///< communicator of all processors
+    MPI_Win m_win ; ///< window on the counter of the first processor
+    int *m_counter ; ///< counter of tasks given (only allocated by the first processor)
+    int m_nbTask ; ///< number of tasks in the queue
+
+public :
+
+    /// \brief Constructor (collective on p_world) : the queue is empty
+    /// \param p_world   communicator of all the processors
+    explicit SharedTaskQueue(const boost::mpi::communicator &p_world): m_world(p_world), m_counter(nullptr), m_nbTask(0)
+    {
+        MPI_Aint sizeLoc = ((p_world.rank() == 0) ? sizeof(int) : 0);
+        BOOST_MPI_CHECK_RESULT(MPI_Win_allocate, (sizeLoc, sizeof(int), MPI_INFO_NULL, p_world, &m_counter, &m_win));
+        // passive epoch for the whole life of the window
+        MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win);
+        reset(0);
+    }
+
+    SharedTaskQueue(const SharedTaskQueue &) = delete;
+    SharedTaskQueue &operator=(const SharedTaskQueue &) = delete;
+
+    /// \brief Destructor (collective)
+    ~SharedTaskQueue()
+    {
+        MPI_Win_unlock_all(m_win);
+        MPI_Win_free(&m_win);
+    }
+
+    /// \brief Fill the queue with new tasks (collective) : all the tasks given before are finished
+    /// \param p_nbTask  number of tasks
+    void reset(const int &p_nbTask)
+    {
+        m_nbTask = p_nbTask;
+        // no processor is still asking for a task of the previous queue
+        m_world.barrier();
+        if (m_world.rank() == 0)
+        {
+            int zero = 0;
+            int previous = 0;
+            BOOST_MPI_CHECK_RESULT(MPI_Fetch_and_op, (&zero, &previous, MPI_INT, 0, 0, MPI_REPLACE, m_win));
+            MPI_Win_flush(0, m_win);
+        }
+        m_world.barrier();
+    }
+
+    /// \brief Get a new task (not collective)
+    /// \return task number, -1 if the queue is empty
+    int getTask()
+    {
+        int one = 1;
+        int itask = 0;
+        BOOST_MPI_CHECK_RESULT(MPI_Fetch_and_op, (&one, &itask, MPI_INT, 0, 0, MPI_SUM, m_win));
+        MPI_Win_flush(0, m_win);
+        return ((itask < m_nbTask) ? itask : -1);
+    }
+};
+}
+#endif /* SHAREDTASKQUEUE_H */
@@ -0,0 +1,80 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef ALLGATHERV_H
+#define ALLGATHERV_H
+#include <vector>
+#include <boost/mpi/exception.hpp>
+#include <boost/mpi/datatype.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/collectives.hpp>
+#include "libstoch/core/utils/Instrumentation.h"
+
+/** \file allGatherv.h
+ * \brief All gather of arrays with a different size on each processor.
+ *        Same as boost::mpi::all_gatherv (all_gatherv.hpp) but the time spent and the bytes received
+ *        are recorded by the instrumentation.
+ * \author Xavier Warin
+ */
+
+namespace libstoch
+{
+
+/// \brief Calculate the position of the values of each processor in the gathered array
+/// \param p_comm    communicator
+/// \param p_inSize  number of values sent by the current processor
+/// \param p_sizes   number of values sent by each processor
+/// \param p_displs  position of the values of each processor in the gathered array
+/// \return total number of values gathered
+inline int allGathervDispl(const boost::mpi::communicator &p_comm, int p_inSize, std::vector<int> &p_sizes, std::vector<int> &p_displs)
+{
+    boost::mpi::all_gather(p_comm, p_inSize, p_sizes);
+    p_displs.resize(p_comm.size());
+    int aux = 0 ;
+    for (int rank = 0; rank < p_comm.size(); ++rank)
+    {
+        p_displs[rank] = aux;
+        aux += p_sizes[rank];
+    }
+    return aux;
+}
+
+/// \brief Gather values of all processors in a pre-allocated array
+/// \param p_comm       communicator
+/// \param p_inValues   values sent by the current processor
+/// \param p_inSize     number of values sent
+/// \param p_outValues  values of all processors (must be large enough)
+template<typename T>
+void allGatherv(const boost::mpi::communicator &p_comm, const T *p_inValues, int p_inSize, T *p_outValues)
+{
+    InstrumentationTimer timerCommunication(instCommunication);
+    std::vector<int> sizes;
+    std::vector<int> displs;
+    int nbValues = allGathervDispl(p_comm, p_inSize, sizes, displs);
+    // bytes received
+    instrumentBytes(static_cast<long>(nbValues) * sizeof(T));
+    MPI_Datatype type = boost::mpi::get_mpi_datatype<T>(*p_inValues);
+    BOOST_MPI_CHECK_RESULT(MPI_Allgatherv, (const_cast<T *>(p_inValues), p_inSize, type, p_outValues, sizes.data(), displs.data(), type, p_comm));
+}
+
+/// \brief Gather values of all processors in a container resized if needed
+/// \param p_comm       communicator
+/// \param p_inValues   values sent by the current processor
+/// \param p_inSize     number of values sent
+/// \param p_outValues  values of all processors
+template<typename T, class V >
+void allGatherv(const boost::mpi::communicator &p_comm, const T *p_inValues, int p_inSize, V &p_outValues)
+{
+    InstrumentationTimer timerCommunication(instCommunication);
+    std::vector<int> sizes;
+    std::vector<int> displs;
+    int nbValues = allGathervDispl(p_comm, p_inSize, sizes, displs);
+    // bytes received
+    instrumentBytes(static_cast<long>(nbValues) * sizeof(T));
+    if (static_cast<int>(p_outValues.size()) != nbValues)
+        p_outValues.resize(nbValues);
+    MPI_Datatype type = boost::mpi::get_mpi_datatype<T>(*p_inValues);
+    BOOST_MPI_CHECK_RESULT(MPI_Allgatherv, (const_cast<T *>(p_inValues), p_inSize, type, p_outValues.data(), sizes.data(), displs.data(), type, p_comm));
+}
+}
+#endif /* ALLGATHERV_H */
@@ -13,12 +13,13 @@ using namespace std;
 
 namespace libstoch
 {
-ArrayXd reconstructProc0Mpi(const ArrayXd &p_point, const shared_ptr< FullGrid> &p_grid,  const shared_ptr< ArrayXXd >    &p_values, const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,  const boost::mpi::communicator   &p_world)
+ArrayXd reconstructProc0Mpi(const ArrayXd &p_point, const shared_ptr< FullGrid> &p_grid,  const shared_ptr< ArrayXXd >    &p_values, const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,  const boost::mpi::communicator   &p_world,
+                            const SplittingFunction &p_splitting)
 {
     int nDim = p_grid->getDimension();
     ArrayXi initialDimension   = p_grid->getDimensions();
     // organize the hypercube splitting for parallel
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, p_bdimToSplit, p_world);
+    ArrayXi splittingRatio = p_splitting(initialDimension, p_bdimToSplit, p_world);
     // for parallelization
     ParallelComputeGridSplitting parall(initialDimension, splittingRatio, p_world);
     // create the subgrid
@@ -6,6 +6,7 @@
 #include <memory>
 #include <Eigen/Dense>
 #include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
 
 /** reconstructProc0Mpi.h
  *  Permit to reconstruct  the grid on processor 0 of all the points needed for interpolation at a given point
@@ -19,7 +20,10 @@ namespace libstoch
 /// \param p_grid   global grid of the problem
 /// \param p_values local values associated to the processor
 /// \param p_bdimToSplit    Dimensions to split for parallelism
+/// \param p_world          MPI communicator
+/// \param p_splitting      splitting of the grid between processors used to distribute p_values
 Eigen::ArrayXd  reconstructProc0Mpi(const Eigen::ArrayXd &p_point, const std::shared_ptr< FullGrid> &p_grid, const std::shared_ptr< Eigen::ArrayXXd >    &p_values,
-                                    const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit, const boost::mpi::communicator &p_world);
+                                    const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit, const boost::mpi::communicator &p_world,
+                                    const SplittingFunction &p_splitting = paraOptimalSplitting);
 }
 #endif /* RECONSTRUCTPROC0MPI_H */
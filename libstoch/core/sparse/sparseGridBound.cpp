@@ -2,6 +2,7 @@
 // All Rights Reserved
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
 #include <vector>
+#include <array>
 #include <iostream>
 #include <Eigen/Dense>
 #include "libstoch/core/utils/comparisonUtils.h"
@@ -161,119 +162,109 @@ void initialFullConstructionBound(const unsigned int &p_levelMax,
 
 
 
-int sonEvaluationBound(const SparseSet   &p_dataSet, const int &p_idim,
-                       const int   &p_nbPoint,
-                       Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son,
-                       Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_neighbourBound)
+/// \brief Calculate the sons and the neighbours of all the points of a level in all dimensions
+/// \param p_iterLevel        iterator on the level
+/// \param p_dataSet          Data structure
+/// \param p_idim             Dimension of the problem
+/// \param p_son              Son array (updated for the points of the level)
+/// \param p_neighbourBound   Neighbour for  boundary points (updated for the points of the level)
+static void sonOneLevelBound(const SparseSet::const_iterator &p_iterLevel, const SparseSet   &p_dataSet, const int &p_idim,
+                             Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son,
+                             Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_neighbourBound)
 {
-    p_son.resize(p_nbPoint, p_idim);
-    p_neighbourBound.resize(p_nbPoint, p_idim);
-
-#ifdef _OPENMP
-    #pragma omp parallel
-#endif
+    Eigen::ArrayXc level = p_iterLevel->first;
+    Eigen::ArrayXui position(p_idim);
+    for (int id = 0; id < p_idim; ++id)
     {
-#ifdef _OPENMP
-        size_t ithread = omp_get_thread_num();
-        size_t nthreads = omp_get_num_threads();
-        size_t cnt = 0;
-#endif
-        for (const auto &fatherLevel : p_dataSet)
+        level(id) += 1;
+        SparseSet::const_iterator iterSon = p_dataSet.find(level);
+        if (iterSon != p_dataSet.end())
         {
-#ifdef _OPENMP
-            cnt = +1;
-            if ((cnt - 1) % nthreads != ithread) continue;
-#endif
-            Eigen::ArrayXc level = fatherLevel.first;
-            Eigen::ArrayXui position(p_idim);
-            for (int id = 0; id < p_idim; ++id)
+            if (level(id) > 2)
             {
-                level(id) += 1;
-                SparseSet::const_iterator iterSon = p_dataSet.find(level);
-                if (iterSon != p_dataSet.end())
+                for (const auto &iPosition : p_iterLevel->second)
                 {
-                    if (level(id) > 2)
+                    position = iPosition.first;
+                    int iposPoint = iPosition.second;
+                    // left son
+                    position(id) *= 2;
+                    p_son(iposPoint, id)[0] = iterSon->second.find(position)->second;
+                    // right son
+                    position(id) += 1;
+                    p_son(iposPoint, id)[1] = iterSon->second.find(position)->second;
+                }
+            }
+            else
+            {
+                for (const auto &iPosition : p_iterLevel->second)
+                {
+                    position = iPosition.first;
+                    int iposPoint = iPosition.second;
+                    if (position(id) == 1)
                     {
-                        for (const auto &iPosition : fatherLevel.second)
-                        {
-                            position = iPosition.first;
-                            int iposPoint = iPosition.second;
-                            // left son
-                            position(id) *= 2;
-                            p_son(iposPoint, id)[0] = iterSon->second.find(position)->second;
-                            // right son
-                            position(id) += 1;
-                            p_son(iposPoint, id)[1] = iterSon->second.find(position)->second;
-                        }
+                        // left son
+                        position(id) = 0;
+                        p_son(iposPoint, id)[0] = iterSon->second.find(position)->second;
+                        // right son
+                        position(id) = 1;
+                        p_son(iposPoint, id)[1] = iterSon->second.find(position)->second;
                     }
                     else
                     {
-                        for (const auto &iPosition : fatherLevel.second)
-                        {
-                            position = iPosition.first;
-                            int iposPoint = iPosition.second;
-                            if (position(id) == 1)
-                            {
-                                // left son
-                                position(id) = 0;
-                                p_son(iposPoint, id)[0] = iterSon->second.find(position)->second;
-                                // right son
-                                position(id) = 1;
-                                p_son(iposPoint, id)[1] = iterSon->second.find(position)->second;
-                            }
-                            else
-                            {
-                                p_son(iposPoint, id)[0] = -1;
-                                p_son(iposPoint, id)[1] = -1;
-                            }
-                        }
-                    }
-                }
-                else
-                {
-                    for (const auto &iPosition : fatherLevel.second)
-                    {
-                        int iposPoint = iPosition.second;
                         p_son(iposPoint, id)[0] = -1;
                         p_son(iposPoint, id)[1] = -1;
                     }
                 }
-                level(id) -= 1;
             }
         }
-
-        // for neighbours
-
-#ifdef _OPENMP
-        cnt = 0;
-#endif
-        for (const auto &iLevel :  p_dataSet)
+        else
         {
-#ifdef _OPENMP
-            cnt += 1;
-            if ((cnt - 1) % nthreads != ithread) continue;
-#endif
-            Eigen::ArrayXc level = iLevel.first;
-            Eigen::ArrayXui position(p_idim);
-            for (int id = 0; id < p_idim; ++id)
-                if (level(id) == 1)
+            for (const auto &iPosition : p_iterLevel->second)
+            {
+                int iposPoint = iPosition.second;
+                p_son(iposPoint, id)[0] = -1;
+                p_son(iposPoint, id)[1] = -1;
+            }
+        }
+        level(id) -= 1;
+    }
+    // for neighbours
+    for (int id = 0; id < p_idim; ++id)
+        if (level(id) == 1)
+        {
+            for (const auto &iPosition : p_iterLevel->second)
+                if (iPosition.first(id) == 1)
                 {
-                    for (const auto &iPosition : iLevel.second)
-                        if (iPosition.first(id) == 1)
-                        {
-                            int iposPoint = iPosition.second;
-                            // central point
-                            position = iPosition.first;
-                            // left
-                            position(id) = 0;
-                            p_neighbourBound(iposPoint, id)[0] = iLevel.second.find(position)->second;
-                            // right
-                            position(id) = 2;
-                            p_neighbourBound(iposPoint, id)[1] = iLevel.second.find(position)->second;
-                        }
+                    int iposPoint = iPosition.second;
+                    // central point
+                    position = iPosition.first;
+                    // left
+                    position(id) = 0;
+                    p_neighbourBound(iposPoint, id)[0] = p_iterLevel->second.find(position)->second;
+                    // right
+                    position(id) = 2;
+                    p_neighbourBound(iposPoint, id)[1] = p_iterLevel->second.find(position)->second;
                 }
         }
-    }
+}
+
+/// \brief Calculate the sons and the neighbours of the points of some levels (one level per thread)
+/// \param p_levels           levels to treat
+/// \param p_dataSet          Data structure
+/// \param p_idim             Dimension of the problem
+/// \param p_son              Son array (updated for the points of the levels)
+/// \param p_neighbourBound   Neighbour for  boundary points (updated for the points of the levels)
+/// \return Base point value
+static int sonLevelsBound(const std::vector< SparseSet::const_iterator > &p_levels, const SparseSet   &p_dataSet, const int &p_idim,
+                          Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son,
+                          Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_neighbourBound)
+{
+    int il ;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) private(il)
+#endif
+    for (il = 0; il < static_cast<int>(p_levels.size()); ++il)
+        sonOneLevelBound(p_levels[il], p_dataSet, p_idim, p_son, p_neighbourBound);
     // root
     Eigen::ArrayXc levelRoot =  Eigen::ArrayXc::Constant(p_idim, 1);
     Eigen::ArrayXui  positionRoot = Eigen::ArrayXui::Constant(p_idim, 1);
@@ -282,4 +273,29 @@ int sonEvaluationBound(const SparseSet   &p_dataSet, const int &p_idim,
     return   iterPosition->second ;
 }
 
+int sonEvaluationBound(const SparseSet   &p_dataSet, const int &p_idim,
+                       const int   &p_nbPoint,
+                       Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son,
+                       Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_neighbourBound)
+{
+    p_son.resize(p_nbPoint, p_idim);
+    p_neighbourBound.resize(p_nbPoint, p_idim);
+    std::vector< SparseSet::const_iterator > levels;
+    levels.reserve(p_dataSet.size());
+    for (SparseSet::const_iterator iterLevel = p_dataSet.begin(); iterLevel != p_dataSet.end(); ++iterLevel)
+        levels.push_back(iterLevel);
+    return sonLevelsBound(levels, p_dataSet, p_idim, p_son, p_neighbourBound);
+}
+
+int sonUpdateBound(const SparseSet   &p_dataSet, const int &p_idim,
+                   const int   &p_nbPoint,
+                   const std::vector< SparseSet::const_iterator > &p_newLevels,
+                   Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son,
+                   Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_neighbourBound)
+{
+    p_son.conservativeResize(p_nbPoint, p_idim);
+    p_neighbourBound.conservativeResize(p_nbPoint, p_idim);
+    return sonLevelsBound(levelsForSonUpdate(p_dataSet, p_newLevels), p_dataSet, p_idim, p_son, p_neighbourBound);
+}
+
 }
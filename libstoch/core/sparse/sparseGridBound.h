@@ -5,6 +5,7 @@
 #define SPARSEGRIDBOUND_H
 #include <Eigen/Dense>
 #include <iostream>
+#include <vector>
 #include "libstoch/core/utils/comparisonUtils.h"
 #include "libstoch/core/sparse/sparseGridTypes.h"
 #include "libstoch/core/sparse/sparseGridUtils.h"
@@ -294,6 +295,21 @@ int sonEvaluationBound(const SparseSet   &p_dataSet, const int &p_idim,
                        const int   &p_nbPoint,
                        Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son,
                        Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_neighbourBound);
+
+///  \brief Update the sons and neighbours after some levels have been added to the data structure :
+///         only the sons of the points of the new levels and of their fathers are calculated
+///  \param p_dataSet         Data structure (with the new levels)
+///  \param p_idim            Dimension of the problem
+///  \param p_nbPoint         Number of points in data structure
+///  \param p_newLevels       levels added since the last son calculation
+///  \param p_son             Son array (nb points,NDIM,Left/Right) : updated
+///  \param p_neighbourBound  Neighbour for  boundary points : updated
+///  \return Base point value
+int sonUpdateBound(const SparseSet   &p_dataSet, const int &p_idim,
+                   const int   &p_nbPoint,
+                   const std::vector< SparseSet::const_iterator > &p_newLevels,
+                   Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son,
+                   Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_neighbourBound);
 ///@}
 
 
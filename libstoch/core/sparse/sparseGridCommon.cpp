@@ -1,6 +1,8 @@
 // Copyright (C) 2016 EDF
 // All Rights Reserved
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include <set>
+#include <vector>
 #include  <Eigen/Dense>
 #include "libstoch/core/sparse/sparseGridTypes.h"
 #include "libstoch/core/utils/comparisonUtils.h"
@@ -104,4 +106,24 @@ void sparse1DConstruction(Eigen::ArrayXc &p_levelCurrent,
     p_levelCurrent(0) = oldLevel;
 }
 
+std::vector< SparseSet::const_iterator > levelsForSonUpdate(const SparseSet &p_dataSet, const std::vector< SparseSet::const_iterator > &p_newLevels)
+{
+    std::set< SparseSet::const_iterator, OrderLevel > levels(p_newLevels.begin(), p_newLevels.end());
+    for (const auto &iterLevel : p_newLevels)
+    {
+        Eigen::ArrayXc level = iterLevel->first;
+        for (int id = 0; id < level.size(); ++id)
+        {
+            if (level(id) > 1)
+            {
+                level(id) -= 1;
+                SparseSet::const_iterator iterFather = p_dataSet.find(level);
+                if (iterFather != p_dataSet.end())
+                    levels.insert(iterFather);
+                level(id) += 1;
+            }
+        }
+    }
+    return std::vector< SparseSet::const_iterator >(levels.begin(), levels.end());
+}
 }
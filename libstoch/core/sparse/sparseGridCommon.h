@@ -3,6 +3,7 @@
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
 #ifndef  SPARSEGRIDCOMMON_H
 #define  SPARSEGRIDCOMMON_H
+#include <vector>
 #include  <Eigen/Dense>
 #include "libstoch/core/sparse/sparseGridTypes.h"
 #include "libstoch/core/sparse/sparseGridUtils.h"
@@ -62,6 +63,13 @@ void sparse1DConstruction(Eigen::ArrayXc &p_levelCurrent,
                           SparseSet &p_dataSet,
                           size_t &p_ipoint);
 
+/// \brief Levels whose sons change when some levels are added to the data structure :
+///        the new levels and their fathers in each dimension
+/// \param p_dataSet    data structure (with the new levels)
+/// \param p_newLevels  levels added to the data structure
+/// \return iterators on the levels (each level appearing once)
+std::vector< SparseSet::const_iterator > levelsForSonUpdate(const SparseSet &p_dataSet, const std::vector< SparseSet::const_iterator > &p_newLevels);
+
 /// \brief  Create a a new data structure from a first one  with  holes in levels
 ///         and modify hierarchized values accordingly
 /// \param p_dataSet          first data set with "holes "in levels
@@ -3,6 +3,7 @@
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
 #include <iostream>
 #include <vector>
+#include <array>
 #include <functional>
 #include <Eigen/Dense>
 #include "libstoch/core/sparse/sparseGridTypes.h"
@@ -180,59 +181,62 @@ void createBasisFunctionNoBound(const int &p_levelMax, const Eigen::ArrayXd &p_w
     }
 }
 
-int  sonEvaluationNoBound(const SparseSet   &p_dataSet, const int &p_idim,
-                          const int   &p_nbPoint,
-                          Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son)
+/// \brief Calculate the sons of all the points of a level in all dimensions
+/// \param p_iterLevel  iterator on the level
+/// \param p_dataSet    Data structure
+/// \param p_idim       Dimension of the problem
+/// \param p_son        Son array (updated for the points of the level)
+static void sonOneLevelNoBound(const SparseSet::const_iterator &p_iterLevel, const SparseSet   &p_dataSet, const int &p_idim,
+                               Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son)
 {
-    p_son.resize(p_nbPoint, p_idim);
-#ifdef _OPENMP
-    #pragma omp parallel
-#endif
+    Eigen::ArrayXc level = p_iterLevel->first;
+    Eigen::ArrayXui position(p_idim);
+    for (int id = 0; id < p_idim; ++id)
     {
-#ifdef _OPENMP
-        size_t ithread = omp_get_thread_num();
-        size_t nthreads = omp_get_num_threads();
-        size_t cnt = 0;
-#endif
-        for (const auto &fatherLevel : p_dataSet)
+        level(id) += 1;
+        SparseSet::const_iterator iterSon = p_dataSet.find(level);
+        if (iterSon != p_dataSet.end())
         {
-#ifdef _OPENMP
-            cnt = +1;
-            if ((cnt - 1) % nthreads != ithread) continue;
-#endif
-            Eigen::ArrayXc level = fatherLevel.first;
-            Eigen::ArrayXui position(p_idim);
-            for (int id = 0; id < p_idim; ++id)
+            for (const auto &iPosition : p_iterLevel->second)
             {
-                level(id) += 1;
-                SparseSet::const_iterator iterSon = p_dataSet.find(level);
-                if (iterSon != p_dataSet.end())
-                {
-                    for (const auto &iPosition : fatherLevel.second)
-                    {
-                        position = iPosition.first;
-                        int iposPoint = iPosition.second;
-                        // left son
-                        position(id) *= 2;
-                        p_son(iposPoint, id)[0] = iterSon->second.find(position)->second;
-                        // right son
-                        position(id) += 1;
-                        p_son(iposPoint, id)[1] = iterSon->second.find(position)->second;
-                    }
-                }
-                else
-                {
-                    for (const auto &iPosition : fatherLevel.second)
-                    {
-                        int iposPoint = iPosition.second;
-                        p_son(iposPoint, id)[0] = -1;
-                        p_son(iposPoint, id)[1] = -1;
-                    }
-                }
-                level(id) -= 1;
+                position = iPosition.first;
+                int iposPoint = iPosition.second;
+                // left son
+                position(id) *= 2;
+                p_son(iposPoint, id)[0] = iterSon->second.find(position)->second;
+                // right son
+                position(id) += 1;
+                p_son(iposPoint, id)[1] = iterSon->second.find(position)->second;
+            }
+        }
+        else
+        {
+            for (const auto &iPosition : p_iterLevel->second)
+            {
+                int iposPoint = iPosition.second;
+                p_son(iposPoint, id)[0] = -1;
+                p_son(iposPoint, id)[1] = -1;
             }
         }
+        level(id) -= 1;
     }
+}
+
+/// \brief Calculate the sons of the points of some levels (one level per thread)
+/// \param p_levels     levels to treat
+/// \param p_dataSet    Data structure
+/// \param p_idim       Dimension of the problem
+/// \param p_son        Son array (updated for the points of the levels)
+/// \return Base point value
+static int sonLevelsNoBound(const std::vector< SparseSet::const_iterator > &p_levels, const SparseSet   &p_dataSet, const int &p_idim,
+                            Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son)
+{
+    int il ;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic) private(il)
+#endif
+    for (il = 0; il < static_cast<int>(p_levels.size()); ++il)
+        sonOneLevelNoBound(p_levels[il], p_dataSet, p_idim, p_son);
     // root
     Eigen::ArrayXc levelRoot =  Eigen::ArrayXc::Constant(p_idim, 1);
     Eigen::ArrayXui  positionRoot = Eigen::ArrayXui::Constant(p_idim, 0);
@@ -240,4 +244,25 @@ int  sonEvaluationNoBound(const SparseSet   &p_dataSet, const int &p_idim,
     SparseLevel::const_iterator iterPosition = iterLevel->second.find(positionRoot);
     return  iterPosition->second ;
 }
+
+int  sonEvaluationNoBound(const SparseSet   &p_dataSet, const int &p_idim,
+                          const int   &p_nbPoint,
+                          Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son)
+{
+    p_son.resize(p_nbPoint, p_idim);
+    std::vector< SparseSet::const_iterator > levels;
+    levels.reserve(p_dataSet.size());
+    for (SparseSet::const_iterator iterLevel = p_dataSet.begin(); iterLevel != p_dataSet.end(); ++iterLevel)
+        levels.push_back(iterLevel);
+    return sonLevelsNoBound(levels, p_dataSet, p_idim, p_son);
+}
+
+int  sonUpdateNoBound(const SparseSet   &p_dataSet, const int &p_idim,
+                      const int   &p_nbPoint,
+                      const std::vector< SparseSet::const_iterator > &p_newLevels,
+                      Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son)
+{
+    p_son.conservativeResize(p_nbPoint, p_idim);
+    return sonLevelsNoBound(levelsForSonUpdate(p_dataSet, p_newLevels), p_dataSet, p_idim, p_son);
+}
 }
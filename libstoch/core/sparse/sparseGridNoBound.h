@@ -5,6 +5,7 @@
 #define SPARSEGRIDNOBOUND_H
 #include <iostream>
 #include <functional>
+#include <vector>
 #include <Eigen/Dense>
 #include "libstoch/core/sparse/sparseGridTypes.h"
 #include "libstoch/core/sparse/sparseGridUtils.h"
@@ -255,6 +256,19 @@ int  sonEvaluationNoBound(const SparseSet   &p_dataSet, const int &p_idim,
                           const int   &p_nbPoint,
                           Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son);
 
+///  \brief Update the sons after some levels have been added to the data structure :
+///         only the sons of the points of the new levels and of their fathers are calculated
+///  \param p_dataSet         Data structure (with the new levels)
+///  \param p_idim            Dimension of the problem
+///  \param p_nbPoint         Number of points in data structure
+///  \param p_newLevels       levels added since the last son calculation
+///  \param p_son             Son array (nb points,NDIM,Left/Right) : updated
+///  \return Base point value
+int  sonUpdateNoBound(const SparseSet   &p_dataSet, const int &p_idim,
+                      const int   &p_nbPoint,
+                      const std::vector< SparseSet::const_iterator > &p_newLevels,
+                      Eigen::Array< std::array<int, 2 >, Eigen::Dynamic, Eigen::Dynamic > &p_son);
+
 ///@}
 }
 #endif /* SPARSEGRIDNOBOUND.H */
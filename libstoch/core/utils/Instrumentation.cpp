@@ -0,0 +1,150 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include "libstoch/core/utils/Instrumentation.h"
+
+using namespace std;
+
+namespace libstoch
+{
+
+bool Instrumentation::isEnabled()
+{
+#ifdef USE_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}
+
+Instrumentation &Instrumentation::instance()
+{
+    static Instrumentation inst;
+    return inst;
+}
+
+InstrumentationRecord &Instrumentation::current()
+{
+    if (m_active.size() > 0)
+        return m_records[m_active.back()];
+    if (m_records.size() == 0)
+    {
+        InstrumentationRecord global;
+        global.m_name = "global";
+        m_nbStepPerName["global"] = 1;
+        m_records.push_back(global);
+    }
+    return m_records.back();
+}
+
+bool Instrumentation::startStep(const string &p_name)
+{
+#ifdef _OPENMP
+    // the stack of active steps is shared : threads of a parallel region can't push on it
+    if (omp_in_parallel())
+        return false;
+#endif
+    #pragma omp critical (instrumentation)
+    {
+        InstrumentationRecord record;
+        record.m_name = p_name;
+        record.m_step = m_nbStepPerName[p_name]++;
+        // time measured before the step
+        record.m_categoryTime = m_pendingTime;
+        m_pendingTime.fill(0.);
+        m_records.push_back(record);
+        m_active.push_back(m_records.size() - 1);
+    }
+    return true;
+}
+
+void Instrumentation::endStep(const double &p_wallTime)
+{
+    #pragma omp critical (instrumentation)
+    {
+        if (m_active.size() > 0)
+        {
+            m_records[m_active.back()].m_wallTime += p_wallTime;
+            m_active.pop_back();
+        }
+    }
+}
+
+void Instrumentation::addTime(const InstrumentationCategory &p_category, const double &p_time, const bool &p_bNextStep)
+{
+    #pragma omp critical (instrumentation)
+    {
+        if (p_bNextStep && (m_active.size() == 0))
+            m_pendingTime[p_category] += p_time;
+        else
+            current().m_categoryTime[p_category] += p_time;
+    }
+}
+
+void Instrumentation::addOptimizeCalls(const long &p_nbCalls)
+{
+    #pragma omp critical (instrumentation)
+    current().m_nbOptimize += p_nbCalls;
+}
+
+void Instrumentation::addBytes(const long &p_nbBytes)
+{
+    #pragma omp critical (instrumentation)
+    current().m_nbBytes += p_nbBytes;
+}
+
+void Instrumentation::addThreadBusy(const int &p_thread, const double &p_time)
+{
+    #pragma omp critical (instrumentation)
+    {
+        InstrumentationRecord &record = current();
+        if (static_cast<int>(record.m_threadBusy.size()) <= p_thread)
+            record.m_threadBusy.resize(p_thread + 1, 0.);
+        record.m_threadBusy[p_thread] += p_time;
+    }
+}
+
+vector< InstrumentationRecord > Instrumentation::getRecords() const
+{
+    vector< InstrumentationRecord > records;
+    #pragma omp critical (instrumentation)
+    records = m_records;
+    return records;
+}
+
+void Instrumentation::clear()
+{
+    #pragma omp critical (instrumentation)
+    {
+        // active steps are kept
+        vector< InstrumentationRecord > activeRecords;
+        for (size_t i = 0; i < m_active.size(); ++i)
+        {
+            activeRecords.push_back(m_records[m_active[i]]);
+            m_active[i] = i;
+        }
+        m_records = activeRecords;
+        m_nbStepPerName.clear();
+        m_pendingTime.fill(0.);
+    }
+}
+
+void Instrumentation::dumpJSON(ostream &p_out) const
+{
+    vector< InstrumentationRecord > records = getRecords();
+    const char *categoryName[instNbCategory] = {"optimize", "regression", "communication", "io"};
+    p_out << "{\n  \"enabled\": " << (isEnabled() ? "true" : "false") << ",\n  \"steps\": [";
+    for (size_t ir = 0; ir < records.size(); ++ir)
+    {
+        const InstrumentationRecord &rec = records[ir];
+        p_out << (ir == 0 ? "" : ",") << "\n    {\"name\": \"" << rec.m_name << "\", \"step\": " << rec.m_step << ", \"wallTime\": " << rec.m_wallTime;
+        for (int ic = 0; ic < instNbCategory; ++ic)
+            p_out << ", \"" << categoryName[ic] << "\": " << rec.m_categoryTime[ic];
+        p_out << ", \"nbOptimize\": " << rec.m_nbOptimize << ", \"nbBytes\": " << rec.m_nbBytes << ", \"threadBusy\": [";
+        for (size_t it = 0; it < rec.m_threadBusy.size(); ++it)
+            p_out << (it == 0 ? "" : ", ") << rec.m_threadBusy[it];
+        p_out << "]}";
+    }
+    p_out << "\n  ]\n}\n";
+}
+}
@@ -0,0 +1,233 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <string>
+#include <vector>
+#include <array>
+#include <map>
+#include <ostream>
+#include <chrono>
+
+/** \file Instrumentation.h
+ * \brief Instrumentation of the transition steps, simulation steps and SDDP sweeps.
+ *        For each step the wall time is recorded and split in  optimization, regression, communication and IO.
+ *        The number of calls to stepOptimize (or to the LP resolution in SDDP), the number of bytes moved by MPI
+ *        and the busy time of each thread are also recorded.
+ *        Communications are measured in allGatherv and ParallelComputeGridSplitting (and in the SDDP cut routing) :
+ *        a communication done inside an IO or regression section (reconstruction before a dump) is counted in both categories.
+ *        Records are only collected if the library is compiled with USE_INSTRUMENTATION :
+ *        otherwise the helpers InstrumentationStep, InstrumentationTimer, InstrumentationThread and instrumentBytes
+ *        only test the flag returned by Instrumentation::isEnabled().
+ *        The flag is set in Instrumentation.cpp : the helpers defined in this header are the same whatever the options
+ *        of the translation units including it.
+ * \author Xavier Warin
+ */
+
+namespace libstoch
+{
+
+/// \brief categories for the split of the wall time of a step
+enum InstrumentationCategory
+{
+    instOptimize = 0, ///< optimization (stepOptimize, LP resolutions)
+    instRegression = 1, ///< conditional expectation calculation
+    instCommunication = 2, ///< MPI communications
+    instIO = 3, ///< archive reading or writing
+    instNbCategory = 4
+};
+
+/// \brief Data recorded for a step
+struct InstrumentationRecord
+{
+    std::string m_name ; ///< name of the object instrumented (TransitionStepRegressionDP, backwardSDDP ...)
+    int m_step ; ///< number of the step for this name (in calling order)
+    double m_wallTime ; ///< total wall time of the step (s)
+    std::array<double, instNbCategory> m_categoryTime ; ///< wall time spent in each category (s)
+    long m_nbOptimize ; ///< number of calls to stepOptimize (or LP resolutions)
+    long m_nbBytes ; ///< number of bytes sent or received by MPI collectives and grid splitting
+    std::vector<double> m_threadBusy ; ///< for each thread, time spent in parallel loops (s)
+
+    InstrumentationRecord(): m_step(0), m_wallTime(0.), m_nbOptimize(0), m_nbBytes(0)
+    {
+        m_categoryTime.fill(0.);
+    }
+};
+
+/// \class Instrumentation Instrumentation.h
+/// Store the records of all the steps instrumented.
+/// Steps can be nested : data are attributed to the last step started and not ended.
+/// Data recorded outside any step (for example when continuation values are dumped after a transition step)
+/// are attributed to the last step recorded (or to a record named "global" if none exists).
+/// Steps are only started outside OpenMP parallel regions : a step started inside a parallel region is ignored
+/// and the data recorded by all threads go to the step enclosing the region.
+/// All methods are thread safe.
+class Instrumentation
+{
+private :
+
+    std::vector< InstrumentationRecord > m_records ; ///< all records
+    std::vector< int > m_active ; ///< stack of active records
+    std::map< std::string, int > m_nbStepPerName ; ///< number of step already started for each name
+    std::array<double, instNbCategory> m_pendingTime ; ///< time recorded before a step starts (archive reading in constructors)
+
+    Instrumentation()
+    {
+        m_pendingTime.fill(0.);
+    }
+
+    /// \brief record receiving the data (create the global one if needed)
+    InstrumentationRecord &current();
+
+public :
+
+    /// \brief unique instance
+    static Instrumentation &instance();
+
+    /// \brief true if the library is compiled with the instrumentation
+    static bool isEnabled();
+
+    /// \brief start a new step
+    /// \param p_name name of the object instrumented
+    /// \return false if called inside a parallel region (no step started)
+    bool startStep(const std::string &p_name);
+
+    /// \brief end the last step started
+    /// \param p_wallTime  wall time of the step
+    void endStep(const double &p_wallTime);
+
+    /// \brief add time in a category for the current step
+    /// \param p_category  category of the time
+    /// \param p_time      time to add
+    /// \param p_bNextStep if true and no step is active, the time is attributed to the next step started
+    void addTime(const InstrumentationCategory &p_category, const double &p_time, const bool &p_bNextStep = false);
+
+    /// \brief add calls to the optimizer for the current step
+    void addOptimizeCalls(const long &p_nbCalls);
+
+    /// \brief add bytes moved for the current step
+    void addBytes(const long &p_nbBytes);
+
+    /// \brief add busy time of a thread  for the current step
+    void addThreadBusy(const int &p_thread, const double &p_time);
+
+    /// \brief get back a copy of all records
+    std::vector< InstrumentationRecord > getRecords() const;
+
+    /// \brief remove all records
+    void clear();
+
+    /// \brief dump the records in JSON format
+    void dumpJSON(std::ostream &p_out) const;
+};
+
+/// \brief current wall clock (s)
+inline double instrumentationClock()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// \class InstrumentationStep Instrumentation.h
+/// Scoped step : started in constructor, ended in destructor
+class InstrumentationStep
+{
+    bool m_bStarted ; ///< false if created inside a parallel region or without instrumentation
+    double m_start ; ///< starting time
+public :
+    explicit InstrumentationStep(const std::string &p_name): m_bStarted(Instrumentation::isEnabled() && Instrumentation::instance().startStep(p_name)),
+        m_start(m_bStarted ? instrumentationClock() : 0.)
+    {}
+    ~InstrumentationStep()
+    {
+        if (m_bStarted)
+            Instrumentation::instance().endStep(instrumentationClock() - m_start);
+    }
+};
+
+/// \class InstrumentationTimer Instrumentation.h
+/// Scoped timer attributing its time to a category. The timer can be stopped before its destruction.
+class InstrumentationTimer
+{
+    InstrumentationCategory m_category ; ///< category of the time
+    bool m_bNextStep ; ///< if true, time measured outside a step is given to the next step
+    double m_start ; ///< starting time
+    bool m_bRunning ; ///< true if not stopped (false without instrumentation)
+public :
+    /// \param p_category   category of the time
+    /// \param p_bNextStep  true if the time measured outside a step is given to the next step started
+    ///                     (for example the continuation values read in the constructor of a simulation step)
+    explicit InstrumentationTimer(const InstrumentationCategory &p_category, const bool &p_bNextStep = false)
+        : m_category(p_category), m_bNextStep(p_bNextStep), m_start(0.), m_bRunning(Instrumentation::isEnabled())
+    {
+        if (m_bRunning)
+            m_start = instrumentationClock();
+    }
+
+    /// \brief stop the timer and record the time
+    void stop()
+    {
+        if (m_bRunning)
+        {
+            Instrumentation::instance().addTime(m_category, instrumentationClock() - m_start, m_bNextStep);
+            m_bRunning = false;
+        }
+    }
+
+    ~InstrumentationTimer()
+    {
+        stop();
+    }
+};
+
+/// \class InstrumentationThread Instrumentation.h
+/// Created by each thread at the beginning of its work in a parallel loop :
+/// count the calls to the optimizer and record the busy time of the thread at destruction
+class InstrumentationThread
+{
+    bool m_bEnabled ; ///< true if the library is compiled with the instrumentation
+    double m_start ; ///< starting time
+    long m_nbOptimize ; ///< calls to the optimizer by the thread
+public :
+    InstrumentationThread(): m_bEnabled(Instrumentation::isEnabled()), m_start(m_bEnabled ? instrumentationClock() : 0.), m_nbOptimize(0)
+    {}
+
+    /// \brief count one call to the optimizer
+    inline void countOptimize()
+    {
+        m_nbOptimize += 1;
+    }
+
+    ~InstrumentationThread()
+    {
+        if (m_bEnabled)
+        {
+#ifdef _OPENMP
+            int iThread = omp_get_thread_num();
+#else
+            int iThread = 0;
+#endif
+            Instrumentation::instance().addThreadBusy(iThread, instrumentationClock() - m_start);
+            Instrumentation::instance().addOptimizeCalls(m_nbOptimize);
+        }
+    }
+};
+
+/// \brief record calls to the optimizer outside a thread block (simulation loops)
+inline void instrumentOptimizeCalls(const long &p_nbCalls)
+{
+    if (Instrumentation::isEnabled())
+        Instrumentation::instance().addOptimizeCalls(p_nbCalls);
+}
+
+/// \brief record bytes moved by communications
+inline void instrumentBytes(const long &p_nbBytes)
+{
+    if (Instrumentation::isEnabled())
+        Instrumentation::instance().addBytes(p_nbBytes);
+}
+}
+#endif /* INSTRUMENTATION_H */
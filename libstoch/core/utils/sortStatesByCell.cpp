@@ -0,0 +1,77 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include <algorithm>
+#include <numeric>
+#include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/core/utils/sortStatesByCell.h"
+
+using namespace std;
+using namespace Eigen;
+
+namespace libstoch
+{
+
+/// \brief lexicographic comparison of two arrays
+static int compareLexico(const ArrayXd &p_a, const ArrayXd &p_b)
+{
+    for (int id = 0; id < p_a.size(); ++id)
+    {
+        if (p_a(id) < p_b(id))
+            return -1;
+        if (p_a(id) > p_b(id))
+            return 1;
+    }
+    return 0;
+}
+
+void sortStatesByCell(const vector<StateWithStocks> &p_states, const shared_ptr<SpaceGrid> &p_grid, vector<int> &p_sim)
+{
+    if (p_sim.size() < 2)
+        return;
+    // mesh number for each simulation
+    vector<long> cell(p_sim.size(), 0);
+    shared_ptr<FullGrid> fullGrid = dynamic_pointer_cast<FullGrid>(p_grid);
+    if (fullGrid)
+    {
+        const ArrayXi &dimensions = fullGrid->getDimensions();
+        for (size_t is = 0; is < p_sim.size(); ++is)
+        {
+            ArrayXd ptStock = p_states[p_sim[is]].getPtStock();
+            fullGrid->truncatePoint(ptStock);
+            ArrayXi iCoord = fullGrid->lowerPositionCoord(ptStock);
+            long iMult = 1;
+            for (int id = 0; id < iCoord.size(); ++id)
+            {
+                cell[is] += iCoord(id) * iMult;
+                iMult *= dimensions(id);
+            }
+        }
+    }
+    vector<int> order(p_sim.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&](const int &p_i, const int &p_j)
+    {
+        if (cell[p_i] != cell[p_j])
+            return cell[p_i] < cell[p_j];
+        const StateWithStocks &stateI = p_states[p_sim[p_i]];
+        const StateWithStocks &stateJ = p_states[p_sim[p_j]];
+        int iComp = compareLexico(stateI.getPtStock(), stateJ.getPtStock());
+        if (fullGrid || (iComp == 0))
+            return compareLexico(stateI.getStochasticRealization(), stateJ.getStochasticRealization()) < 0;
+        return iComp < 0;
+    });
+    vector<int> sim(p_sim);
+    for (size_t is = 0; is < order.size(); ++is)
+        p_sim[is] = sim[order[is]];
+}
+
+vector<int> simulationOrder(const vector<StateWithStocks> &p_states, const shared_ptr<SpaceGrid> &p_grid, const int &p_iFirst, const int &p_iLast, const bool &p_bSort)
+{
+    vector<int> sim(max(p_iLast - p_iFirst, 0));
+    iota(sim.begin(), sim.end(), p_iFirst);
+    if (p_bSort)
+        sortStatesByCell(p_states, p_grid, sim);
+    return sim;
+}
+}
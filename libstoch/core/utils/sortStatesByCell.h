@@ -0,0 +1,34 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SORTSTATESBYCELL_H
+#define SORTSTATESBYCELL_H
+#include <vector>
+#include <memory>
+#include "libstoch/core/utils/StateWithStocks.h"
+#include "libstoch/core/grids/SpaceGrid.h"
+/** \file sortStatesByCell.h
+ *  \brief Sort simulations by the mesh of the grid containing their stock and then by their uncertainty,
+ *         so that successive simulations interpolate in the same mesh of the grid and of the regressor
+ *  \author Xavier Warin
+ */
+namespace libstoch
+{
+
+///\fn void sortStatesByCell(const std::vector<StateWithStocks> &p_states, const std::shared_ptr<SpaceGrid> &p_grid, std::vector<int> &p_sim)
+/// \param p_states  states of all simulations
+/// \param p_grid    grid used to define the meshes (for grids other than full grids, stocks are sorted lexicographically)
+/// \param p_sim     list of simulation numbers to sort (modified)
+void sortStatesByCell(const std::vector<StateWithStocks> &p_states, const std::shared_ptr<SpaceGrid> &p_grid, std::vector<int> &p_sim);
+
+///\fn std::vector<int> simulationOrder(const std::vector<StateWithStocks> &p_states, const std::shared_ptr<SpaceGrid> &p_grid, const int &p_iFirst, const int &p_iLast, const bool &p_bSort)
+/// \param p_states  states of all simulations
+/// \param p_grid    grid used to define the meshes
+/// \param p_iFirst  first simulation
+/// \param p_iLast   last simulation (excluded)
+/// \param p_bSort   if false simulations are kept in their natural order
+/// \return  simulation numbers between p_iFirst and p_iLast in the order they should be treated
+std::vector<int> simulationOrder(const std::vector<StateWithStocks> &p_states, const std::shared_ptr<SpaceGrid> &p_grid, const int &p_iFirst, const int &p_iLast, const bool &p_bSort);
+
+}
+#endif /* SORTSTATESBYCELL_H */
@@ -0,0 +1,196 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+#include "geners/BinaryFileArchive.hh"
+#include "geners/Record.hh"
+#include "geners/Reference.hh"
+#include "libstoch/core/utils/eigenGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
+#include "libstoch/dp/CheckpointDP.h"
+
+using namespace std;
+using namespace Eigen;
+
+namespace libstoch
+{
+
+#ifdef USE_MPI
+CheckpointDP::CheckpointDP(const string &p_fileName, const int &p_frequency, const boost::mpi::communicator &p_world, const bool &p_bDistributed):
+    m_fileName(p_fileName), m_frequency(p_frequency), m_bWrite(p_bDistributed || (p_world.rank() == 0)), m_world(p_world), m_bDistributed(p_bDistributed)
+{
+    if (m_bDistributed)
+        m_fileName += "_" + boost::lexical_cast<string>(p_world.rank());
+}
+#else
+CheckpointDP::CheckpointDP(const string &p_fileName, const int &p_frequency): m_fileName(p_fileName), m_frequency(p_frequency), m_bWrite(true)
+{}
+#endif
+
+CheckpointDP::~CheckpointDP()
+{
+    if (m_writing.valid())
+        m_writing.wait();
+}
+
+string CheckpointDP::archiveName(const string &p_fileName, const int &p_iSlot)
+{
+    return p_fileName + "." + boost::lexical_cast<string>(p_iSlot);
+}
+
+array<int, 4> CheckpointDP::readManifest(const string &p_fileName)
+{
+    array<int, 4> manifest = {{ -1, -1, -1, -1}};
+    ifstream file((p_fileName + ".manifest").c_str());
+    array<int, 4> manifestRead;
+    if (file >> manifestRead[0] >> manifestRead[1] >> manifestRead[2] >> manifestRead[3])
+        manifest = manifestRead;
+    return manifest;
+}
+
+int CheckpointDP::readStep(const string &p_archiveName)
+{
+    // geners catalog and data files
+    if (!ifstream((p_archiveName + ".gsbmf").c_str()).good() || !ifstream((p_archiveName + ".0.gsbd").c_str()).good())
+        return -1;
+    gs::BinaryFileArchive ar(p_archiveName.c_str(), "r");
+    if (!ar.isOpen())
+        return -1;
+    // step written last : no step means an incomplete checkpoint
+    gs::Reference< int > refStep(ar, "step", "checkpoint");
+    if (refStep.size() == 0)
+        return -1;
+    int iStep = -1;
+    refStep.restore(0, &iStep);
+    return iStep;
+}
+
+void CheckpointDP::writeFile(const string &p_fileName, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_values,
+                             const bool &p_bZeroDate, const ArrayXXd &p_particles)
+{
+    array<int, 4> manifest = readManifest(p_fileName);
+    // archive referenced neither by the last checkpoint nor by the previous one
+    int iSlot = 0;
+    while ((iSlot == manifest[1]) || (iSlot == manifest[3]))
+        iSlot += 1;
+    {
+        gs::BinaryFileArchive ar(archiveName(p_fileName, iSlot).c_str(), "w");
+        int nbRegime = p_values.size();
+        ar << gs::Record(nbRegime, "nbRegime", "checkpoint");
+        for (int iReg = 0; iReg < nbRegime; ++iReg)
+        {
+            if (p_values[iReg])
+                ar << gs::Record(*p_values[iReg], "values", boost::lexical_cast<string>(iReg).c_str());
+            else
+                ar << gs::Record(ArrayXXd(), "values", boost::lexical_cast<string>(iReg).c_str());
+        }
+        ar << gs::Record(p_bZeroDate, "bZeroDate", "checkpoint");
+        ar << gs::Record(p_particles, "particles", "checkpoint");
+        // step written last : a checkpoint with a step is complete
+        ar << gs::Record(p_iStep, "step", "checkpoint");
+        ar.flush();
+    }
+    // manifest written last and renamed when complete : the last checkpoint becomes the previous one
+    string fileManifest = p_fileName + ".manifest";
+    string fileManifestTemp = fileManifest + ".tmp";
+    {
+        ofstream file(fileManifestTemp.c_str(), ios::trunc);
+        file << p_iStep << " " << iSlot << " " << manifest[0] << " " << manifest[1] << endl;
+        file.close();
+        if (!file)
+            throw runtime_error("CheckpointDP : cannot write " + fileManifestTemp);
+    }
+    if (rename(fileManifestTemp.c_str(), fileManifest.c_str()) != 0)
+        throw runtime_error("CheckpointDP : cannot rename " + fileManifestTemp + " to " + fileManifest);
+}
+
+void CheckpointDP::write(const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_values, const shared_ptr< BaseRegression > &p_regressor,
+                         const bool &p_bForce)
+{
+    if (!p_bForce && (((p_iStep + 1) % m_frequency) != 0))
+        return;
+    // exceptions of the previous writing
+    if (m_writing.valid())
+        m_writing.get();
+    if (!m_bWrite)
+        return;
+    // state of the regressor copied : it is updated by the next step
+    bool bZeroDate = p_regressor->getBZeroDate();
+    ArrayXXd particles = p_regressor->getParticles();
+    string fileName = m_fileName;
+    int iStep = p_iStep;
+    m_writing = async(launch::async, [fileName, iStep, p_values, bZeroDate, particles]()
+    {
+        InstrumentationTimer timerIO(instIO);
+        writeFile(fileName, iStep, p_values, bZeroDate, particles);
+    });
+}
+
+void CheckpointDP::wait()
+{
+    if (m_writing.valid())
+        m_writing.get();
+}
+
+void CheckpointDP::removeFiles(const string &p_fileName)
+{
+    remove((p_fileName + ".manifest").c_str());
+    remove((p_fileName + ".manifest.tmp").c_str());
+    for (int iSlot = 0; iSlot < 3; ++iSlot)
+    {
+        remove((archiveName(p_fileName, iSlot) + ".gsbmf").c_str());
+        remove((archiveName(p_fileName, iSlot) + ".0.gsbd").c_str());
+    }
+}
+
+int CheckpointDP::restore(vector< shared_ptr< ArrayXXd > > &p_values, const shared_ptr< BaseRegression > &p_regressor)
+{
+    wait();
+    InstrumentationTimer timerIO(instIO);
+    // checkpoints referenced by the manifest are checked : the archive must be complete and store the step of the manifest
+    array<int, 4> manifest = readManifest(m_fileName);
+    int iStepLast = ((manifest[0] >= 0) && (readStep(archiveName(m_fileName, manifest[1])) == manifest[0])) ? manifest[0] : -1;
+    int iStepPrev = ((manifest[2] >= 0) && (readStep(archiveName(m_fileName, manifest[3])) == manifest[2])) ? manifest[2] : -1;
+    int iStep = max(iStepLast, iStepPrev);
+#ifdef USE_MPI
+    // last step checkpointed seen by all processors : with distributed values a processor may have written one more checkpoint than the others,
+    // with a single checkpoint the processors may not see the same files
+    iStep = boost::mpi::all_reduce(m_world, iStep, boost::mpi::minimum<int>());
+#endif
+    int iSlot = -1;
+    if (iStep >= 0)
+    {
+        if (iStep == iStepLast)
+            iSlot = manifest[1];
+        else if (iStep == iStepPrev)
+            iSlot = manifest[3];
+    }
+    if (iSlot < 0)
+        iStep = -1;
+#ifdef USE_MPI
+    // the step agreed must be available on all processors
+    iStep = boost::mpi::all_reduce(m_world, iStep, boost::mpi::minimum<int>());
+#endif
+    if (iStep < 0)
+        return -1;
+    gs::BinaryFileArchive ar(archiveName(m_fileName, iSlot).c_str(), "r");
+    int nbRegime = 0;
+    gs::Reference< int >(ar, "nbRegime", "checkpoint").restore(0, &nbRegime);
+    p_values.resize(nbRegime);
+    for (int iReg = 0; iReg < nbRegime; ++iReg)
+    {
+        p_values[iReg] = make_shared<ArrayXXd>();
+        gs::Reference< ArrayXXd >(ar, "values", boost::lexical_cast<string>(iReg).c_str()).restore(0, p_values[iReg].get());
+    }
+    bool bZeroDate = false;
+    gs::Reference< bool >(ar, "bZeroDate", "checkpoint").restore(0, &bZeroDate);
+    ArrayXXd particles;
+    gs::Reference< ArrayXXd >(ar, "particles", "checkpoint").restore(0, &particles);
+    p_regressor->updateSimulations(bZeroDate, particles);
+    return iStep;
+}
+}
@@ -0,0 +1,112 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef CHECKPOINTDP_H
+#define CHECKPOINTDP_H
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+#include <future>
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#include <Eigen/Dense>
+#include "libstoch/regression/BaseRegression.h"
+
+/** \file CheckpointDP.h
+ * \brief Checkpoints of a backward dynamic programming resolution permitting to restart it from the last completed step.
+ *        A checkpoint stores the step number, the values of each regime after the step (as given to the next transition step)
+ *        and the state of the regressor of the step (particles and zero date flag).
+ *        Checkpoints are written on a background thread in archives used in turn (suffix ".0", ".1", ".2").
+ *        A manifest (suffix ".manifest") gives the steps and archives of the last checkpoint and of the previous one :
+ *        it is written last, in a temporary file renamed when complete. The renaming being atomic, a resolution
+ *        stopped at any time leaves a manifest referencing complete archives only, never an archive being written.
+ *        On restore, the step stored in each archive is checked against the manifest.
+ *        A failure of the writing (renaming of the manifest ...) raises an exception thrown by the next write or wait.
+ *        The values given to the checkpoint must not be modified in place before the writing ends
+ *        (transition steps always return new arrays).
+ *        With MPI :
+ *          - if values are the same on all processors (TransitionStepRegressionDP ...) processor 0 writes the checkpoint
+ *            and all processors read it,
+ *          - if values are distributed (TransitionStepRegressionDPDist ...) each processor writes its own file (suffix "_rank"),
+ *          - in both cases the processors agree on the last step checkpointed available on all of them.
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class CheckpointDP CheckpointDP.h
+/// Write and read checkpoints of a backward resolution
+class CheckpointDP
+{
+private :
+
+    std::string m_fileName ; ///< file name of the checkpoint of the processor
+    int m_frequency ; ///< a checkpoint is written every m_frequency steps
+    bool m_bWrite ; ///< true if the processor writes the checkpoint
+#ifdef USE_MPI
+    boost::mpi::communicator m_world ; ///< MPI communicator
+    bool m_bDistributed ; ///< true if values are distributed on processors
+#endif
+    std::future<void> m_writing ; ///< checkpoint being written
+
+    /// \brief name of the archive of a checkpoint
+    /// \param p_fileName  name of the checkpoint file
+    /// \param p_iSlot     archive number
+    static std::string archiveName(const std::string &p_fileName, const int &p_iSlot);
+
+    /// \brief read the manifest of a checkpoint file
+    /// \return step and archive number of the last checkpoint, step and archive number of the previous one (-1 if none)
+    static std::array<int, 4> readManifest(const std::string &p_fileName);
+
+    /// \brief read the step number stored in a checkpoint archive (-1 if the archive doesn't exist or is incomplete)
+    static int readStep(const std::string &p_archiveName);
+
+    /// \brief write a checkpoint (on the background thread)
+    static void writeFile(const std::string &p_fileName, const int &p_iStep, const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_values,
+                          const bool &p_bZeroDate, const Eigen::ArrayXXd &p_particles);
+
+public :
+
+    /// \brief Constructor
+    /// \param p_fileName       name of the checkpoint file
+    /// \param p_frequency      a checkpoint is written every p_frequency steps
+#ifdef USE_MPI
+    /// \param p_world          MPI communicator
+    /// \param p_bDistributed   true if the values are distributed on processors
+    CheckpointDP(const std::string &p_fileName, const int &p_frequency, const boost::mpi::communicator &p_world, const bool &p_bDistributed);
+#else
+    CheckpointDP(const std::string &p_fileName, const int &p_frequency);
+#endif
+
+    CheckpointDP(const CheckpointDP &) = delete;
+    CheckpointDP &operator=(const CheckpointDP &) = delete;
+
+    /// \brief wait for the checkpoint being written
+    ~CheckpointDP();
+
+    /// \brief Launch the writing of a checkpoint on a background thread if the step is a multiple of the frequency
+    ///        The writing of the previous checkpoint must be completed : exceptions raised by the previous writing are thrown here
+    /// \param p_iStep      step completed (in resolution order, starting from 0)
+    /// \param p_values     for each regime values after the step (nb simulations, nb points)
+    /// \param p_regressor  regressor used at the step
+    /// \param p_bForce     if true the checkpoint is written whatever the step
+    void write(const int &p_iStep, const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_values, const std::shared_ptr< BaseRegression > &p_regressor,
+               const bool &p_bForce = false);
+
+    /// \brief wait for the end of the writing of the last checkpoint
+    void wait();
+
+    /// \brief Remove the files of a checkpoint (manifest and archives)
+    /// \param p_fileName  name of the checkpoint file of the processor (with suffix "_rank" if values are distributed)
+    static void removeFiles(const std::string &p_fileName);
+
+    /// \brief Restore the last checkpoint
+    /// \param p_values     for each regime values after the last completed step
+    /// \param p_regressor  regressor set in the state of the last completed step
+    /// \return last step completed (-1 if no checkpoint is available : nothing is restored)
+    int restore(std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_values, const std::shared_ptr< BaseRegression > &p_regressor);
+};
+}
+#endif /* CHECKPOINTDP_H */
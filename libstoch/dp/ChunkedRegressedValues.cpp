@@ -0,0 +1,233 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include <algorithm>
+#include <boost/lexical_cast.hpp>
+#include "geners/vectorIO.hh"
+#include "geners/Record.hh"
+#include "libstoch/core/utils/eigenGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
+#include "libstoch/regression/GridAndRegressedValueGeners.h"
+#include "libstoch/dp/ChunkedRegressedValues.h"
+
+using namespace std;
+using namespace Eigen;
+
+namespace libstoch
+{
+
+/// \brief number of blocks in each dimension
+/// \param p_dimensions  number of points in each dimension
+/// \param p_chunkSize   number of meshes of a block in each dimension
+static ArrayXi nbChunkPerDimension(const ArrayXi &p_dimensions, const ArrayXi &p_chunkSize)
+{
+    ArrayXi nbChunk(p_dimensions.size());
+    for (int id = 0; id < p_dimensions.size(); ++id)
+        nbChunk(id) = max(1, (p_dimensions(id) - 2 + p_chunkSize(id)) / p_chunkSize(id));
+    return nbChunk;
+}
+
+/// \brief points of a block : first point and first point excluded in each dimension
+/// \param p_iChunk      global number of the block
+/// \param p_dimensions  number of points in each dimension
+/// \param p_chunkSize   number of meshes of a block in each dimension
+/// \param p_nbChunk     number of blocks in each dimension
+static SubMeshIntCoord chunkMesh(int p_iChunk, const ArrayXi &p_dimensions, const ArrayXi &p_chunkSize, const ArrayXi &p_nbChunk)
+{
+    SubMeshIntCoord mesh(p_dimensions.size());
+    for (int id = 0; id < p_dimensions.size(); ++id)
+    {
+        int ic = p_iChunk % p_nbChunk(id);
+        p_iChunk /= p_nbChunk(id);
+        mesh(id)[0] = ic * p_chunkSize(id);
+        mesh(id)[1] = min(mesh(id)[0] + p_chunkSize(id) + 1, p_dimensions(id));
+    }
+    return mesh;
+}
+
+/// \brief number of points of a sub mesh
+static int nbPointsInMesh(const SubMeshIntCoord &p_mesh)
+{
+    int nbPoints = 1;
+    for (int id = 0; id < p_mesh.size(); ++id)
+        nbPoints *= p_mesh(id)[1] - p_mesh(id)[0];
+    return nbPoints;
+}
+
+ChunkedRegressedValues::ChunkedRegressedValues(gs::BinaryFileArchive &p_ar, const string &p_name, const int &p_iStep, const int &p_nbChunkMax): m_ar(&p_ar), m_name(p_name + "Chunk"),
+    m_step(boost::lexical_cast<string>(p_iStep)), m_nbChunkMax(max(p_nbChunkMax, 1)), m_nbChunkRead(0)
+{
+    vector<int> layout;
+    gs::Reference< vector<int> >(p_ar, (m_name + "Layout").c_str(), m_step.c_str()).restore(0, &layout);
+    int nDim = layout.size() / 2;
+    m_dimensions = Map<const ArrayXi>(layout.data(), nDim);
+    m_chunkSize = Map<const ArrayXi>(layout.data() + nDim, nDim);
+    m_nbChunk = nbChunkPerDimension(m_dimensions, m_chunkSize);
+    m_bChunkRead.assign(m_nbChunk.prod(), false);
+    m_regressor = gs::Reference< BaseRegression >(p_ar, "regressor", m_step.c_str()).get(0);
+}
+
+const vector< ArrayXXd > &ChunkedRegressedValues::getChunk(const int &p_iChunk)
+{
+    auto iter = m_chunks.find(p_iChunk);
+    if (iter != m_chunks.end())
+    {
+        // move the block at the front of the list
+        m_chunkUsed.splice(m_chunkUsed.begin(), m_chunkUsed, m_chunkPosition[p_iChunk]);
+        return iter->second;
+    }
+    // remove the least recently used block
+    if (static_cast<int>(m_chunks.size()) >= m_nbChunkMax)
+    {
+        m_chunks.erase(m_chunkUsed.back());
+        m_chunkPosition.erase(m_chunkUsed.back());
+        m_chunkUsed.pop_back();
+    }
+    vector< ArrayXXd > &chunk = m_chunks[p_iChunk];
+    gs::Reference< vector< ArrayXXd > >(*m_ar, (m_name + "Values").c_str(), m_step.c_str()).restore(p_iChunk, &chunk);
+    m_chunkUsed.push_front(p_iChunk);
+    m_chunkPosition[p_iChunk] = m_chunkUsed.begin();
+    if (!m_bChunkRead[p_iChunk])
+    {
+        m_bChunkRead[p_iChunk] = true;
+        m_nbChunkRead += 1;
+    }
+    return chunk;
+}
+
+void ChunkedRegressedValues::dump(gs::BinaryFileArchive &p_ar, const string &p_name, const int &p_iStep, const shared_ptr<FullGrid> &p_grid,
+                                  const vector< ArrayXXd > &p_values, const ArrayXi &p_chunkSize)
+{
+    string stepString = boost::lexical_cast<string>(p_iStep);
+    string name = p_name + "Chunk";
+    const ArrayXi &dimensions = p_grid->getDimensions();
+    vector<int> layout(dimensions.data(), dimensions.data() + dimensions.size());
+    layout.insert(layout.end(), p_chunkSize.data(), p_chunkSize.data() + p_chunkSize.size());
+    p_ar << gs::Record(layout, (name + "Layout").c_str(), stepString.c_str());
+    ArrayXi nbChunk = nbChunkPerDimension(dimensions, p_chunkSize);
+    int nDim = dimensions.size();
+    for (int iChunk = 0; iChunk < nbChunk.prod(); ++iChunk)
+    {
+        SubMeshIntCoord mesh = chunkMesh(iChunk, dimensions, p_chunkSize, nbChunk);
+        int nbPoints = nbPointsInMesh(mesh);
+        // global number of each point of the block
+        ArrayXi globPoint(nbPoints);
+        for (int ip = 0; ip < nbPoints; ++ip)
+        {
+            int ipLoc = ip;
+            int iGlob = 0;
+            int iMult = 1;
+            for (int id = 0; id < nDim; ++id)
+            {
+                int nLoc = mesh(id)[1] - mesh(id)[0];
+                iGlob += (mesh(id)[0] + ipLoc % nLoc) * iMult;
+                ipLoc /= nLoc;
+                iMult *= dimensions(id);
+            }
+            globPoint(ip) = iGlob;
+        }
+        vector< ArrayXXd > chunk(p_values.size());
+        for (size_t iReg = 0; iReg < p_values.size(); ++iReg)
+        {
+            chunk[iReg].resize(p_values[iReg].rows(), nbPoints);
+            for (int ip = 0; ip < nbPoints; ++ip)
+                chunk[iReg].col(ip) = p_values[iReg].col(globPoint(ip));
+        }
+        p_ar << gs::Record(chunk, (name + "Values").c_str(), stepString.c_str());
+    }
+}
+
+SubMeshIntCoord ChunkedRegressedValues::getMeshCovering(const shared_ptr<FullGrid> &p_grid, const vector< array< double, 2> > &p_region)
+{
+    int nDim = p_grid->getDimension();
+    vector <array< double, 2>  > extremVal =  p_grid->getExtremeValues();
+    ArrayXd xCapMin(nDim), xCapMax(nDim);
+    for (int id = 0; id < nDim; ++id)
+    {
+        xCapMin(id) = min(max(p_region[id][0], extremVal[id][0]), extremVal[id][1]);
+        xCapMax(id) = max(min(p_region[id][1], extremVal[id][1]), extremVal[id][0]);
+    }
+    ArrayXi  iCapMin =  p_grid->lowerPositionCoord(xCapMin);
+    ArrayXi  iCapMax =  p_grid->upperPositionCoord(xCapMax) + 1; // last is excluded
+    SubMeshIntCoord retGrid(nDim);
+    for (int id = 0; id < nDim; ++id)
+    {
+        retGrid(id)[0] = iCapMin(id);
+        retGrid(id)[1] = iCapMax(id);
+    }
+    return retGrid;
+}
+
+vector< array< double, 2> > ChunkedRegressedValues::getStockRegion(const vector< StateWithStocks > &p_states, const int &p_iFirst, const int &p_iLast)
+{
+    int nDim = p_states[p_iFirst].getStockSize();
+    vector< array< double, 2> > region(nDim);
+    for (int id = 0; id < nDim; ++id)
+    {
+        region[id][0] = p_states[p_iFirst].getPtStock()(id);
+        region[id][1] = region[id][0];
+    }
+    for (int is = p_iFirst + 1; is < p_iLast; ++is)
+        for (int id = 0; id < nDim; ++id)
+        {
+            region[id][0] = min(region[id][0], p_states[is].getPtStock()(id));
+            region[id][1] = max(region[id][1], p_states[is].getPtStock()(id));
+        }
+    return region;
+}
+
+vector< GridAndRegressedValue > ChunkedRegressedValues::getContinuation(const shared_ptr<FullGrid> &p_grid, const SubMeshIntCoord &p_subMesh)
+{
+    InstrumentationTimer timerIO(instIO);
+    int nDim = m_dimensions.size();
+    int nbPoints = nbPointsInMesh(p_subMesh);
+    // for each block, points of the sub grid owned by the block and their position in the block
+    map< int, vector< array<int, 2> > > pointsByChunk;
+    for (int ip = 0; ip < nbPoints; ++ip)
+    {
+        // block owning the point and position in the block
+        int ipLoc = ip;
+        int iChunk = 0;
+        int iChunkMult = 1;
+        int iInChunk = 0;
+        int iInChunkMult = 1;
+        for (int id = 0; id < nDim; ++id)
+        {
+            int nLoc = p_subMesh(id)[1] - p_subMesh(id)[0];
+            int iPoint = p_subMesh(id)[0] + ipLoc % nLoc;
+            ipLoc /= nLoc;
+            int ic = min(iPoint / m_chunkSize(id), m_nbChunk(id) - 1);
+            int iFirstInChunk = ic * m_chunkSize(id);
+            iChunk += ic * iChunkMult;
+            iChunkMult *= m_nbChunk(id);
+            iInChunk += (iPoint - iFirstInChunk) * iInChunkMult;
+            iInChunkMult *= min(iFirstInChunk + m_chunkSize(id) + 1, m_dimensions(id)) - iFirstInChunk;
+        }
+        pointsByChunk[iChunk].push_back({{ip, iInChunk}});
+    }
+    // each block is read once
+    vector< ArrayXXd > values;
+    for (const auto &chunkPoints : pointsByChunk)
+    {
+        const vector< ArrayXXd > &chunk = getChunk(chunkPoints.first);
+        if (values.size() == 0)
+        {
+            values.resize(chunk.size());
+            for (size_t iReg = 0; iReg < chunk.size(); ++iReg)
+                values[iReg].resize(chunk[iReg].rows(), nbPoints);
+        }
+        for (size_t iReg = 0; iReg < chunk.size(); ++iReg)
+            for (const auto &point : chunkPoints.second)
+                values[iReg].col(point[0]) = chunk[iReg].col(point[1]);
+    }
+    timerIO.stop();
+    shared_ptr<FullGrid> subGrid = p_grid->getSubGrid(p_subMesh);
+    vector< GridAndRegressedValue > continuation(values.size());
+    for (size_t iReg = 0; iReg < values.size(); ++iReg)
+    {
+        continuation[iReg] = GridAndRegressedValue(subGrid, m_regressor);
+        continuation[iReg].setRegressedValues(values[iReg]);
+    }
+    return continuation;
+}
+}
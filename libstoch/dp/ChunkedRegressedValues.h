@@ -0,0 +1,115 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef CHUNKEDREGRESSEDVALUES_H
+#define CHUNKEDREGRESSEDVALUES_H
+#include <memory>
+#include <map>
+#include <list>
+#include <unordered_map>
+#include <vector>
+#include <array>
+#include <string>
+#include <Eigen/Dense>
+#include "geners/BinaryFileArchive.hh"
+#include "geners/Reference.hh"
+#include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/core/utils/StateWithStocks.h"
+#include "libstoch/core/utils/types.h"
+#include "libstoch/regression/BaseRegression.h"
+#include "libstoch/regression/GridAndRegressedValue.h"
+
+/** \file ChunkedRegressedValues.h
+ * \brief Store regressed values (continuation values or controls) on a full grid by blocks of grid points.
+ *        Each block (chunk) is a separate record of the archive, so that the simulation only reads the blocks
+ *        around the current stock states.
+ *        Blocks are boxes of grid points sharing one point in each dimension with their neighbours :
+ *        each mesh of the grid is entirely contained in one block.
+ *        Records are compressed if the archive is opened with a compression mode
+ *        (for example "w:z=z" for zlib or "w:z=b" for bzip2).
+ *        At most a given number of blocks are kept in memory : the least recently used block is removed first.
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class ChunkedRegressedValues ChunkedRegressedValues.h
+/// Lazy reader of the regressed values dumped by blocks of grid points
+class ChunkedRegressedValues
+{
+private :
+
+    gs::BinaryFileArchive *m_ar ; ///< archive where values are stored (must live as long as the object)
+    std::string m_name ; ///< name of the record for the blocks
+    std::string m_step ; ///< category of the records (step)
+    Eigen::ArrayXi m_dimensions ; ///< number of points of the grid in each dimension
+    Eigen::ArrayXi m_chunkSize ; ///< number of meshes of a block in each dimension
+    Eigen::ArrayXi m_nbChunk ; ///< number of blocks in each dimension
+    std::shared_ptr< BaseRegression > m_regressor ; ///< regressor used for all blocks
+    int m_nbChunkMax ; ///< maximal number of blocks kept in memory
+    std::map< int, std::vector< Eigen::ArrayXXd > > m_chunks ; ///< blocks in memory (regressed values for each regime)
+    std::list< int > m_chunkUsed ; ///< blocks in memory from the most recently used to the least recently used
+    std::unordered_map< int, std::list< int >::iterator > m_chunkPosition ; ///< for each block in memory, its position in m_chunkUsed
+    std::vector< bool > m_bChunkRead ; ///< for each block, true if already read
+    int m_nbChunkRead ; ///< number of different blocks read
+
+    /// \brief get back a block (read it if necessary). The reference is valid until the next call.
+    /// \param p_iChunk  global number of the block
+    const std::vector< Eigen::ArrayXXd > &getChunk(const int &p_iChunk);
+
+public :
+
+    /// \brief Constructor : only the description of the blocks and the regressor are read
+    /// \param p_ar       archive where values are stored
+    /// \param p_name     name used to dump the values
+    /// \param p_iStep    step number
+    /// \param p_nbChunkMax maximal number of blocks kept in memory
+    ChunkedRegressedValues(gs::BinaryFileArchive &p_ar, const std::string &p_name, const int &p_iStep, const int &p_nbChunkMax = 64);
+
+    /// \brief Dump regressed values by blocks
+    /// \param p_ar          archive to dump in
+    /// \param p_name        name used for the values
+    /// \param p_iStep       step number
+    /// \param p_grid        grid where values are defined
+    /// \param p_values      for each regime regressed values (nb basis functions, nb points of the grid)
+    /// \param p_chunkSize   number of meshes of a block in each dimension
+    static void dump(gs::BinaryFileArchive &p_ar, const std::string &p_name, const int &p_iStep, const std::shared_ptr<FullGrid> &p_grid,
+                     const std::vector< Eigen::ArrayXXd > &p_values, const Eigen::ArrayXi &p_chunkSize);
+
+    /// \brief Get back the smallest sub grid of a grid containing a region (capped by the grid extreme values)
+    /// \param p_grid    full grid
+    /// \param p_region  min and max in each dimension
+    /// \return  first point and first point excluded in each dimension
+    static SubMeshIntCoord getMeshCovering(const std::shared_ptr<FullGrid> &p_grid, const std::vector< std::array< double, 2> > &p_region);
+
+    /// \brief Get back the min and max of stocks for some simulations
+    /// \param p_states   states
+    /// \param p_iFirst   first simulation
+    /// \param p_iLast    last simulation (excluded)
+    static std::vector< std::array< double, 2> > getStockRegion(const std::vector< StateWithStocks > &p_states, const int &p_iFirst, const int &p_iLast);
+
+    /// \brief Get back continuation objects for each regime on a sub grid : only blocks intersecting the sub grid are read
+    /// \param p_grid      full grid used to dump values
+    /// \param p_subMesh   sub grid (first point and first point excluded in each dimension)
+    std::vector< GridAndRegressedValue > getContinuation(const std::shared_ptr<FullGrid> &p_grid, const SubMeshIntCoord &p_subMesh);
+
+    /// \brief number of different blocks read
+    inline int getNbChunkRead() const
+    {
+        return m_nbChunkRead;
+    }
+
+    /// \brief number of blocks kept in memory
+    inline int getNbChunkInMemory() const
+    {
+        return m_chunks.size();
+    }
+
+    /// \brief total number of blocks
+    inline int getNbChunk() const
+    {
+        return m_nbChunk.prod();
+    }
+};
+}
+#endif /* CHUNKEDREGRESSEDVALUES_H */
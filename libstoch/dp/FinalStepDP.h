@@ -41,6 +41,14 @@ public :
     std::vector<std::shared_ptr< Eigen::ArrayXXd > >  operator()(const std::function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>      &p_funcValue,
             const Eigen::ArrayXXd &p_particles) const;
 
+    ///\brief Fill in array with values : the final value is calculated for all particles at once
+    /// \param p_funcValue    function giving the final value for each regime and all particles (arguments are the regime number, point coordinates, simulations corresponding to stochastic non controlled state)
+    ///                       and returning the final values for all particles
+    /// \param p_particles    simulations at final date (First dimension  : size of the stochastic non controlled state,  second dimension : the  number of particles)
+    /// \return values on the grid : for each regime number of simulations by number of stock points
+    std::vector<std::shared_ptr< Eigen::ArrayXXd > >  applyVec(const std::function<Eigen::ArrayXd(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXXd &)>      &p_funcValue,
+            const Eigen::ArrayXXd &p_particles) const;
+
 };
 }
 #endif /*  FINALSTEPDP_H */
@@ -2,9 +2,9 @@
 #include <functional>
 #include <memory>
 #include <Eigen/Dense>
-#include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/core/grids/SpaceGrid.h"
 #include "libstoch/dp/FinalStepDPCut.h"
+#include "libstoch/dp/FinalStepGridLoop.h"
 
 
 using namespace libstoch;
@@ -24,43 +24,41 @@ vector<shared_ptr< ArrayXXd > >  FinalStepDPCut::operator()(const function< Arra
     {
         for (int iReg = 0; iReg < m_nbRegime; ++iReg)
             finalValues[iReg] = make_shared<ArrayXXd>(p_particles.cols() * ndimCut, m_pGridCurrent->getNbPoints());
-        // number of thread
-#ifdef _OPENMP
-        int nbThreads = omp_get_max_threads();
-#else
-        int nbThreads = 1;
-#endif
-        // create iterator on current grid treated for processor
-        vector< shared_ptr< GridIterator  > > iterGridPoint(nbThreads);
-        for (int iThread = 0; iThread < nbThreads; ++iThread)
-            iterGridPoint[iThread] = m_pGridCurrent->getGridIteratorInc(iThread);
         // iterates on points of the grid
-        int iIter;
-#ifdef _OPENMP
-        #pragma omp parallel for  private(iIter)
-#endif
-        for (iIter = 0; iIter < static_cast<int>(m_pGridCurrent->getNbPoints()); ++iIter)
+        finalStepGridLoop(m_pGridCurrent, [&](const ArrayXd & p_pointCoord, const int &p_ipoint)
         {
-#ifdef _OPENMP
-            int iThread = omp_get_thread_num() ;
-#else
-            int iThread = 0;
-#endif
-            if (iterGridPoint[iThread]->isValid())
+            for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+                for (int is = 0; is < p_particles.cols(); ++is)
+                {
+                    ArrayXd cuts = p_funcValue(iReg, p_pointCoord, p_particles.col(is));
+                    for (int ic = 0; ic < cuts.size(); ++ic)
+                        (*finalValues[iReg])(is + ic * p_particles.cols(), p_ipoint) = cuts(ic);
+                }
+        });
+    }
+    return finalValues;
+}
+
+vector<shared_ptr< ArrayXXd > >  FinalStepDPCut::applyVec(const function< ArrayXXd(const int &, const ArrayXd &, const ArrayXXd &)>     &p_funcValue,
+        const ArrayXXd &p_particles) const
+{
+    vector<shared_ptr< ArrayXXd > > finalValues(m_nbRegime);
+    int ndimCut = m_pGridCurrent->getDimension() + 1;
+    if (m_pGridCurrent->getNbPoints() > 0)
+    {
+        for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+            finalValues[iReg] = make_shared<ArrayXXd>(p_particles.cols() * ndimCut, m_pGridCurrent->getNbPoints());
+        // iterates on points of the grid
+        finalStepGridLoop(m_pGridCurrent, [&](const ArrayXd & p_pointCoord, const int &p_ipoint)
+        {
+            for (int iReg = 0; iReg < m_nbRegime; ++iReg)
             {
-                ArrayXd pointCoord = iterGridPoint[iThread]->getCoordinate();
-                int ipoint = iterGridPoint[iThread]->getCount();
-                for (int iReg = 0; iReg < m_nbRegime; ++iReg)
-                    for (int is = 0; is < p_particles.cols(); ++is)
-                    {
-                        ArrayXd cuts = p_funcValue(iReg, pointCoord, p_particles.col(is));
-                        for (int ic = 0; ic < cuts.size(); ++ic)
-                            (*finalValues[iReg])(is + ic * p_particles.cols(), ipoint) = cuts(ic);
-                    }
-                iterGridPoint[iThread]->nextInc(nbThreads);
+                // cut values stored  particle first
+                ArrayXXd cuts = p_funcValue(iReg, p_pointCoord, p_particles);
+                assert((cuts.rows() == p_particles.cols()) && (cuts.cols() == ndimCut));
+                finalValues[iReg]->col(p_ipoint) = Map<const ArrayXd>(cuts.data(), cuts.size());
             }
-        }
+        });
     }
     return finalValues;
 }
-
@@ -39,6 +39,14 @@ public :
     std::vector<std::shared_ptr< Eigen::ArrayXXd > >  operator()(const std::function< Eigen::ArrayXd(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>      &p_funcValue,
             const Eigen::ArrayXXd &p_particles) const;
 
+    ///\brief Fill in array with values : the final cuts are calculated for all particles at once
+    /// \param p_funcValue    function giving the final cut values for each regime and all particles (arguments are the regime number, point coordinates, simulations corresponding to stochastic non controlled state)
+    ///                       and returning the cuts values (number of particles, nb cuts)
+    /// \param p_particles    simulations at final date (First dimension  : size of the stochastic non controlled state,  second dimension : the  number of particles)
+    /// \return cuts values on the grid : for each regime (number of simulations * nb cuts) by number of stock points
+    std::vector<std::shared_ptr< Eigen::ArrayXXd > >  applyVec(const std::function< Eigen::ArrayXXd(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXXd &)>      &p_funcValue,
+            const Eigen::ArrayXXd &p_particles) const;
+
 };
 }
 #endif /*  FINALSTEPDPCUT_H */
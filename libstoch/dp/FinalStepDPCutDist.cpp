@@ -7,8 +7,8 @@
 #include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/grids/FullGrid.h"
-#include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/dp/FinalStepDPCutDist.h"
+#include "libstoch/dp/FinalStepGridLoop.h"
 
 
 using namespace libstoch;
@@ -18,14 +18,14 @@ using namespace std;
 
 FinalStepDPCutDist::FinalStepDPCutDist(const  shared_ptr<FullGrid> &p_pGridCurrent, const int &p_nbRegime,
                                        const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,
-                                       const boost::mpi::communicator &p_world): m_pGridCurrent(p_pGridCurrent),
+                                       const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting): m_pGridCurrent(p_pGridCurrent),
     m_nDim(p_pGridCurrent->getDimension()),
     m_nbRegime(p_nbRegime)
 {
     // initial dimension
     ArrayXi initialDimension   = p_pGridCurrent->getDimensions();
     // organize the hypercube splitting for parallel
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, p_bdimToSplit, p_world);
+    ArrayXi splittingRatio = p_splitting(initialDimension, p_bdimToSplit, p_world);
     // grid treated by current processor
     m_gridCurrentProc = m_pGridCurrent->getSubGrid(paraSplitComputationGridsProc(initialDimension, splittingRatio, p_world.rank()));
 }
@@ -39,21 +39,17 @@ vector<shared_ptr< ArrayXXd > >  FinalStepDPCutDist::operator()(const function<
         int ndimCut = m_gridCurrentProc->getDimension() + 1;
         for (int iReg = 0; iReg < m_nbRegime; ++iReg)
             finalValues[iReg] = make_shared<ArrayXXd>(p_particles.cols() * ndimCut, m_gridCurrentProc->getNbPoints());
-        shared_ptr<GridIterator>  iterGrid =  m_gridCurrentProc->getGridIterator();
-        while (iterGrid->isValid())
+        finalStepGridLoop(m_gridCurrentProc, [&](const ArrayXd & p_pointCoord, const int &p_ipoint)
         {
-            ArrayXd pointCoord = iterGrid->getCoordinate();
-            int ipoint = iterGrid->getCount();
             for (int iReg = 0; iReg < m_nbRegime; ++iReg)
                 for (int is = 0; is < p_particles.cols(); ++is)
                 {
-                    ArrayXd cuts = p_funcValue(iReg, pointCoord, p_particles.col(is));
+                    ArrayXd cuts = p_funcValue(iReg, p_pointCoord, p_particles.col(is));
                     for (int ic = 0; ic < ndimCut; ++ic)
-                        (*finalValues[iReg])(is + ic * p_particles.cols(), ipoint) = cuts(ic);
+                        (*finalValues[iReg])(is + ic * p_particles.cols(), p_ipoint) = cuts(ic);
 
                 }
-            iterGrid->next();
-        }
+        });
     }
     else
     {
@@ -62,5 +58,32 @@ vector<shared_ptr< ArrayXXd > >  FinalStepDPCutDist::operator()(const function<
     }
     return finalValues;
 }
-#endif
 
+vector<shared_ptr< ArrayXXd > >  FinalStepDPCutDist::applyVec(const function< ArrayXXd(const int &, const ArrayXd &, const ArrayXXd &)>     &p_funcValue,
+        const ArrayXXd &p_particles) const
+{
+    vector<shared_ptr< ArrayXXd > > finalValues(m_nbRegime);
+    if (m_gridCurrentProc->getNbPoints() > 0)
+    {
+        int ndimCut = m_gridCurrentProc->getDimension() + 1;
+        for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+            finalValues[iReg] = make_shared<ArrayXXd>(p_particles.cols() * ndimCut, m_gridCurrentProc->getNbPoints());
+        finalStepGridLoop(m_gridCurrentProc, [&](const ArrayXd & p_pointCoord, const int &p_ipoint)
+        {
+            for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+            {
+                // cut values stored  particle first
+                ArrayXXd cuts = p_funcValue(iReg, p_pointCoord, p_particles);
+                assert((cuts.rows() == p_particles.cols()) && (cuts.cols() == ndimCut));
+                finalValues[iReg]->col(p_ipoint) = Map<const ArrayXd>(cuts.data(), cuts.size());
+            }
+        });
+    }
+    else
+    {
+        for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+            finalValues[iReg] = make_shared<ArrayXXd>();
+    }
+    return finalValues;
+}
+#endif
@@ -6,6 +6,7 @@
 #include <boost/mpi.hpp>
 #include <Eigen/Dense>
 #include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
 
 /** \file FinalStepDPCutDist.h
  *  \brief permits to affect a final value to a  problem
@@ -33,8 +34,9 @@ public :
     /// \param p_nbRegime       numbers of regime treated
     /// \param p_bdimToSplit    Dimensions to split for parallelism
     /// \param p_world          MPI communicator
+    /// \param p_splitting      splitting of the grid between processors (the same as the one of the transition steps)
     FinalStepDPCutDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent, const int &p_nbRegime, const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,
-                       const boost::mpi::communicator &p_world);
+                       const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     ///\brief Fill in array with values
     /// \param p_funcValue    function giving the final cut values  (arguments are  the state :  regime, point coordinates ,  array of simulations corresponding to stochastic non controlled state)
@@ -43,6 +45,14 @@ public :
     std::vector<std::shared_ptr< Eigen::ArrayXXd > >  operator()(const std::function< Eigen::ArrayXd(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>     &p_funcValue,
             const Eigen::ArrayXXd &p_particles) const;
 
+    ///\brief Fill in array with values : the final cuts are calculated for all particles at once
+    /// \param p_funcValue    function giving the final cut values for all particles (arguments are the regime, point coordinates, simulations corresponding to stochastic non controlled state)
+    ///                       and returning the cuts values (number of particles, nb cuts)
+    /// \param p_particles    simulations at final date (First dimension  : size of the stochastic non controlled state,  second dimension : the  number of particles)
+    /// \return cuts values on the grid : for each regime (number of simulations * nb cuts) by number of stock points
+    std::vector<std::shared_ptr< Eigen::ArrayXXd > >  applyVec(const std::function< Eigen::ArrayXXd(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXXd &)>     &p_funcValue,
+            const Eigen::ArrayXXd &p_particles) const;
+
     /// \brief get back local grid associated to current step
     inline std::shared_ptr<FullGrid>   getGridCurrentProc()const
     {
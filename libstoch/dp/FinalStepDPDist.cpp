@@ -9,8 +9,8 @@
 #include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/grids/FullGrid.h"
-#include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/dp/FinalStepDPDist.h"
+#include "libstoch/dp/FinalStepGridLoop.h"
 
 
 using namespace libstoch;
@@ -20,14 +20,14 @@ using namespace std;
 
 FinalStepDPDist::FinalStepDPDist(const  shared_ptr<FullGrid> &p_pGridCurrent, const int &p_nbRegime,
                                  const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,
-                                 const boost::mpi::communicator &p_world): m_pGridCurrent(p_pGridCurrent),
+                                 const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting): m_pGridCurrent(p_pGridCurrent),
     m_nDim(p_pGridCurrent->getDimension()),
     m_nbRegime(p_nbRegime)
 {
     // initial dimension
     ArrayXi initialDimension   = p_pGridCurrent->getDimensions();
     // organize the hypercube splitting for parallel
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, p_bdimToSplit, p_world);
+    ArrayXi splittingRatio = p_splitting(initialDimension, p_bdimToSplit, p_world);
     // grid treated by current processor
     m_gridCurrentProc = m_pGridCurrent->getSubGrid(paraSplitComputationGridsProc(initialDimension, splittingRatio, p_world.rank()));
 }
@@ -40,18 +40,34 @@ vector<shared_ptr< ArrayXXd > >  FinalStepDPDist::operator()(const function<doub
     {
         for (int iReg = 0; iReg < m_nbRegime; ++iReg)
             finalValues[iReg] = make_shared<ArrayXXd>(p_particles.cols(), m_gridCurrentProc->getNbPoints());
-        shared_ptr<GridIterator>  iterGrid =  m_gridCurrentProc->getGridIterator();
-        while (iterGrid->isValid())
+        finalStepGridLoop(m_gridCurrentProc, [&](const ArrayXd & p_pointCoord, const int &p_ipoint)
         {
-            ArrayXd pointCoord = iterGrid->getCoordinate();
             for (int iReg = 0; iReg < m_nbRegime; ++iReg)
                 for (int is = 0; is < p_particles.cols(); ++is)
-                {
-                    (*finalValues[iReg])(is, iterGrid->getCount()) = p_funcValue(iReg, pointCoord, p_particles.col(is));
+                    (*finalValues[iReg])(is, p_ipoint) = p_funcValue(iReg, p_pointCoord, p_particles.col(is));
+        });
+    }
+    else
+    {
+        for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+            finalValues[iReg] = make_shared<ArrayXXd>();
+    }
+    return finalValues;
+}
 
-                }
-            iterGrid->next();
-        }
+vector<shared_ptr< ArrayXXd > >  FinalStepDPDist::applyVec(const function<ArrayXd(const int &, const ArrayXd &, const ArrayXXd &)>     &p_funcValue,
+        const ArrayXXd &p_particles) const
+{
+    vector<shared_ptr< ArrayXXd > > finalValues(m_nbRegime);
+    if (m_gridCurrentProc->getNbPoints() > 0)
+    {
+        for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+            finalValues[iReg] = make_shared<ArrayXXd>(p_particles.cols(), m_gridCurrentProc->getNbPoints());
+        finalStepGridLoop(m_gridCurrentProc, [&](const ArrayXd & p_pointCoord, const int &p_ipoint)
+        {
+            for (int iReg = 0; iReg < m_nbRegime; ++iReg)
+                finalValues[iReg]->col(p_ipoint) = p_funcValue(iReg, p_pointCoord, p_particles);
+        });
     }
     else
     {
@@ -61,4 +77,3 @@ vector<shared_ptr< ArrayXXd > >  FinalStepDPDist::operator()(const function<doub
     return finalValues;
 }
 #endif
-
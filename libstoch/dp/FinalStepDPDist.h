@@ -8,6 +8,7 @@
 #include <boost/mpi.hpp>
 #include <Eigen/Dense>
 #include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
 
 /** \file FinalStepDPDist.h
  *  \brief permits to affect a final value to a  problem
@@ -35,8 +36,9 @@ public :
     /// \param p_nbRegime       numbers of regime treated
     /// \param p_bdimToSplit    Dimensions to split for parallelism
     /// \param p_world          MPI communicator
+    /// \param p_splitting      splitting of the grid between processors (the same as the one of the transition steps)
     FinalStepDPDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent, const int &p_nbRegime, const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,
-                    const boost::mpi::communicator &p_world);
+                    const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     ///\brief Fill in array with values
     /// \param p_funcValue    function giving the final value  (arguments are  the state :  regime, point coordinates ,  array of simulations corresponding to stochastic non controlled state)
@@ -45,6 +47,14 @@ public :
     std::vector<std::shared_ptr< Eigen::ArrayXXd > >  operator()(const std::function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>     &p_funcValue,
             const Eigen::ArrayXXd &p_particles) const;
 
+    ///\brief Fill in array with values : the final value is calculated for all particles at once
+    /// \param p_funcValue    function giving the final value for all particles (arguments are the regime, point coordinates, simulations corresponding to stochastic non controlled state)
+    ///                       and returning the final values for all particles
+    /// \param p_particles    simulations at final date (First dimension  : size of the stochastic non controlled state,  second dimension : the  number of particles)
+    /// \return values on the grid
+    std::vector<std::shared_ptr< Eigen::ArrayXXd > >  applyVec(const std::function<Eigen::ArrayXd(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXXd &)>     &p_funcValue,
+            const Eigen::ArrayXXd &p_particles) const;
+
     /// \brief get back local grid associated to current step
     inline std::shared_ptr<FullGrid>   getGridCurrentProc()const
     {
@@ -0,0 +1,63 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef FINALSTEPGRIDLOOP_H
+#define FINALSTEPGRIDLOOP_H
+#ifdef _OPENMP
+#include <omp.h>
+#include "libstoch/core/utils/OpenmpException.h"
+#endif
+#include <functional>
+#include <memory>
+#include <Eigen/Dense>
+#include "libstoch/core/grids/SpaceGrid.h"
+#include "libstoch/core/grids/GridIterator.h"
+
+/** \file FinalStepGridLoop.h
+ *  \brief Loop on the points of a grid used to set final values
+ * \author Xavier Warin
+ */
+
+namespace libstoch
+{
+/// \brief Apply a function on all the points of a grid with threads.
+///        The points are split in as many contiguous blocks as threads : block i is treated by the i th iteration
+///        of a loop with a static schedule, so each thread only iterates on its own block.
+/// \param p_grid     grid
+/// \param p_fPoint   function applied with the coordinates of the point and its number in the grid
+inline void finalStepGridLoop(const std::shared_ptr<SpaceGrid> &p_grid, const std::function<void(const Eigen::ArrayXd &, const int &)> &p_fPoint)
+{
+    // number of blocks
+#ifdef _OPENMP
+    int nbBlock = omp_get_max_threads();
+#else
+    int nbBlock = 1;
+#endif
+    int iBlock;
+#ifdef _OPENMP
+    OpenmpException excep; // deal with exception in openmp
+    #pragma omp parallel for schedule(static) private(iBlock)
+#endif
+    for (iBlock = 0; iBlock < nbBlock; ++iBlock)
+    {
+#ifdef _OPENMP
+        excep.run([&]
+        {
+#endif
+            std::shared_ptr< GridIterator > iterGridPoint = p_grid->getGridIterator();
+            iterGridPoint->jumpToAndInc(iBlock, nbBlock, 0);
+            while (iterGridPoint->isValid())
+            {
+                p_fPoint(iterGridPoint->getCoordinate(), iterGridPoint->getCount());
+                iterGridPoint->next();
+            }
+#ifdef _OPENMP
+        });
+#endif
+    }
+#ifdef _OPENMP
+    excep.rethrow();
+#endif
+}
+}
+#endif /*  FINALSTEPGRIDLOOP_H */
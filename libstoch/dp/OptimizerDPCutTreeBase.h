@@ -1,6 +1,7 @@
 
 #ifndef OPTIMIZERDPCUTTREEBASE_H
 #define OPTIMIZERDPCUTTREEBASE_H
+#include <memory>
 #include <Eigen/Dense>
 #include "libstoch/core/utils/StateWithStocks.h"
 #include "libstoch/core/grids/SpaceGrid.h"
@@ -18,12 +19,15 @@
 
 namespace libstoch
 {
+class LPWorkspace;
 
 /// \class OptimizerDPCutTreeBase OptimizerDPCutTreeBase.h
 ///  Base class for optimizer for Dynamic Programming  with tree methods and cuts, so using LP to solve transitional problems
 class OptimizerDPCutTreeBase : public OptimizerBase
 {
+protected :
 
+    std::shared_ptr< LPWorkspace > m_lpWorkspace ; ///< if defined, LP models are kept and warm started between LP resolutions
 
 public :
 
@@ -31,6 +35,19 @@ public :
 
     virtual ~OptimizerDPCutTreeBase() {}
 
+    /// \brief Opt in LP model reuse : the optimizer keeps one LP per thread, updates its bounds and cuts and warm starts it
+    /// \param p_lpWorkspace  workspace (LPWorkspace.h, needs COIN CLP) : a null pointer goes back to a new LP for each resolution
+    inline void setLPWorkspace(const std::shared_ptr< LPWorkspace > &p_lpWorkspace)
+    {
+        m_lpWorkspace = p_lpWorkspace;
+    }
+
+    /// \brief get back the LP workspace (null if LP are rebuilt at each resolution)
+    inline std::shared_ptr< LPWorkspace > getLPWorkspace() const
+    {
+        return m_lpWorkspace;
+    }
+
     /// \brief defines the diffusion cone for parallelism
     /// \param  p_regionByProcessor         region (min max) treated by the processor for the different regimes treated
     /// \return returns in each dimension the min max values in the stock that can be reached from the grid p_gridByProcessor for each regime
@@ -1,11 +1,12 @@
 // Copyright (C) 2023 EDF
 // All Rights Reserved
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepMultiStageRegression.h"
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 
 using namespace std;
@@ -27,6 +28,7 @@ SimulateStepMultiStageRegression::SimulateStepMultiStageRegression(std::shared_p
 
 void SimulateStepMultiStageRegression::oneStep(vector<StateWithStocks > &p_statevector, std::vector<ArrayXXd>  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepMultiStageRegression");
     shared_ptr< SimulatorMultiStageDPBase > simulator = m_pOptimize->getSimulator();
     int  nbPeriodsOfCurrentStep = simulator->getNbPeriodsInTransition();
     for (int iPeriod = 0; iPeriod < nbPeriodsOfCurrentStep ; iPeriod++)
@@ -37,6 +39,7 @@ void SimulateStepMultiStageRegression::oneStep(vector<StateWithStocks > &p_state
         // to store the next grid
         vector< GridAndRegressedValue > contVal;
         shared_ptr< SpaceGrid> gridFollLoc;
+        InstrumentationTimer timerIO(instIO);
         if (iPeriod == (nbPeriodsOfCurrentStep - 1))
         {
             gs::Reference< vector< GridAndRegressedValue > >(*m_ar, (m_nameCont + "Values").c_str(), boost::lexical_cast<string>(m_iStep).c_str()).restore(0, &contVal);
@@ -47,6 +50,7 @@ void SimulateStepMultiStageRegression::oneStep(vector<StateWithStocks > &p_state
             gs::Reference< vector< GridAndRegressedValue > > (*m_ar, m_nameDetCont.c_str(), boost::lexical_cast<string>(iPeriod).c_str()).restore(0, &contVal);
             gridFollLoc = contVal[0].getGrid();
         }
+        timerIO.stop();
 
 #ifdef USE_MPI
         int rank = m_world.rank();
@@ -59,6 +63,7 @@ void SimulateStepMultiStageRegression::oneStep(vector<StateWithStocks > &p_state
         ArrayXXd valueFunctionPerSim(p_phiInOut[0].rows(), iLastSim - iFirstSim);
         // spread calculations on processors
         int  is = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         #pragma omp parallel for  private(is)
 #endif
@@ -70,15 +75,18 @@ void SimulateStepMultiStageRegression::oneStep(vector<StateWithStocks > &p_state
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut[iPeriod].col(is);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(iLastSim - iFirstSim);
         // broadcast
         ArrayXXd stockAllSim(p_statevector[0].getStockSize(), p_statevector.size());
-        boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
-        boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut[iPeriod].data());
+        allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
+        allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut[iPeriod].data());
         // update results
         for (size_t iis = 0; iis < p_statevector.size(); ++iis)
             p_statevector[iis].setPtStock(stockAllSim.col(iis));
 #else
         int  is = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         #pragma omp parallel for  private(is)
 #endif
@@ -86,6 +94,8 @@ void SimulateStepMultiStageRegression::oneStep(vector<StateWithStocks > &p_state
         {
             m_pOptimize->stepSimulate(gridFollLoc, contVal, p_statevector[is], p_phiInOut[iPeriod].col(is));
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(p_statevector.size());
 #endif
         //prepare next period
         if (iPeriod < nbPeriodsOfCurrentStep - 1)
@@ -4,12 +4,13 @@
 #ifdef USE_MPI
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepMultiStageRegressionDist.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/utils/NodeParticleSplitting.h"
 #include "libstoch/core/utils/types.h"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 
 using namespace std;
 using namespace libstoch;
@@ -23,17 +24,18 @@ SimulateStepMultiStageRegressionDist::SimulateStepMultiStageRegressionDist(const
         const  shared_ptr<FullGrid> &p_pGridFollowing,
         const  shared_ptr<OptimizerMultiStageDPBase > &p_pOptimize,
         const bool &p_bOneFile,
-        const boost::mpi::communicator &p_world):
+        const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting):
     m_pGridCurrent(p_pGridCurrent),
     m_pGridFollowing(p_pGridFollowing),
     m_pOptimize(p_pOptimize),
     m_ar(p_ar), m_iStep(p_iStep), m_nameCont(p_nameCont), m_nameDetCont(p_nameDetCont),
-    m_bOneFile(p_bOneFile), m_world(p_world)
+    m_bOneFile(p_bOneFile), m_world(p_world), m_splitting(p_splitting)
 {
 }
 
 vector< GridAndRegressedValue> SimulateStepMultiStageRegressionDist::readContinuationInArchive(const string &p_name, const string &p_stepString)
 {
+    InstrumentationTimer timerIO(instIO);
     vector< GridAndRegressedValue>  continuationObj;
     gs::Reference< vector< GridAndRegressedValue> >(*m_ar, (p_name + "Values").c_str(), p_stepString.c_str()).restore(0, &continuationObj);
     return continuationObj;
@@ -41,10 +43,11 @@ vector< GridAndRegressedValue> SimulateStepMultiStageRegressionDist::readContinu
 
 pair< shared_ptr<BaseRegression>, vector< ArrayXXd > >  SimulateStepMultiStageRegressionDist::readRegressedValues(const string &p_name, const string &p_stepString)
 {
+    InstrumentationTimer timerIO(instIO);
     vector<int> initialVecDimensionFollow;
     gs::Reference< 	vector<int> >(*m_ar, "initialSizeOfMeshPrev", p_stepString.c_str()).restore(0, &initialVecDimensionFollow);
     Map<const ArrayXi > initialDimensionFollow(initialVecDimensionFollow.data(), initialVecDimensionFollow.size());
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimensionFollow, m_pOptimize->getDimensionToSplit(), m_world);
+    ArrayXi splittingRatio = m_splitting(initialDimensionFollow, m_pOptimize->getDimensionToSplit(), m_world);
     m_parall =  make_shared<ParallelComputeGridSplitting>(initialDimensionFollow, splittingRatio, m_world);
     vector< ArrayXXd > contValue;
     gs::Reference< vector< ArrayXXd > >(*m_ar, (p_name + "Values").c_str(), p_stepString.c_str()).restore(0, &contValue);
@@ -108,6 +111,7 @@ SubMeshIntCoord  SimulateStepMultiStageRegressionDist::calculateSubMeshExtended(
 
 void SimulateStepMultiStageRegressionDist::oneStep(vector<StateWithStocks > &p_statevector, vector<ArrayXXd>  &p_phiInOut)
 {
+    InstrumentationStep instStep("SimulateStepMultiStageRegressionDist");
 
     shared_ptr< SimulatorMultiStageDPBase > simulator = m_pOptimize->getSimulator();
     int  nbPeriodsOfCurrentStep = simulator->getNbPeriodsInTransition();
@@ -143,6 +147,7 @@ void SimulateStepMultiStageRegressionDist::oneStep(vector<StateWithStocks > &p_s
                 gridFollLoc = m_pGridCurrent;
             }
             // spread calculations on processors
+            InstrumentationTimer timerOptimize(instOptimize);
             for (size_t is = 0; is <  nbSimCurProc; ++is)
             {
                 int simuNumber = simToProcAndRegion.first[is];
@@ -153,9 +158,11 @@ void SimulateStepMultiStageRegressionDist::oneStep(vector<StateWithStocks > &p_s
                 if (valueFunctionPerSim.size() > 0)
                     valueFunctionPerSim.col(is) = p_phiInOut[iPeriod].col(simuNumber);
             }
+            timerOptimize.stop();
+            instrumentOptimizeCalls(nbSimCurProc);
             vector<double> valueFunctionAllSim;
-            boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
-            boost::mpi::all_gatherv<int>(m_world, simToProcAndRegion.first.data(), nbSimCurProc, simAllProc);
+            allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
+            allGatherv<int>(m_world, simToProcAndRegion.first.data(), nbSimCurProc, simAllProc);
             int iis = 0;
             for (size_t is = 0; is < simAllProc.size(); ++is)
             {
@@ -170,9 +177,9 @@ void SimulateStepMultiStageRegressionDist::oneStep(vector<StateWithStocks > &p_s
         }
         // broadcast
         vector<double> stockAllSim;
-        boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
+        allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
         vector<int> regimeAllSim;
-        boost::mpi::all_gatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
+        allGatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
         // update results
         for (size_t is = 0; is < simAllProc.size(); ++is)
         {
@@ -227,6 +234,7 @@ void SimulateStepMultiStageRegressionDist::oneStep(vector<StateWithStocks > &p_s
                 continuationExtended[iReg].setRegressedValues(valuesExtended);
             }
             // spread calculations on processors
+            InstrumentationTimer timerOptimize(instOptimize);
             for (size_t is = 0; is <  nbSimCurProc; ++is)
             {
                 int simuNumber = simToProcAndRegion.first[is];;
@@ -237,15 +245,17 @@ void SimulateStepMultiStageRegressionDist::oneStep(vector<StateWithStocks > &p_s
                 if (valueFunctionPerSim.size() > 0)
                     valueFunctionPerSim.col(is) = p_phiInOut[iPeriod].col(simuNumber);
             }
+            timerOptimize.stop();
+            instrumentOptimizeCalls(nbSimCurProc);
             // broadcast
             vector<double> stockAllSim;
-            boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
+            allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
             vector<int> regimeAllSim;
-            boost::mpi::all_gatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
+            allGatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
             vector<double> valueFunctionAllSim;
-            boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
+            allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
             vector<int> simAllProc;
-            boost::mpi::all_gatherv<int>(m_world, simToProcAndRegion.first.data(), nbSimCurProc, simAllProc);
+            allGatherv<int>(m_world, simToProcAndRegion.first.data(), nbSimCurProc, simAllProc);
             // update results
             int iis = 0;
             for (size_t is = 0; is < simAllProc.size(); ++is)
@@ -41,6 +41,7 @@ private :
     std::shared_ptr<ParallelComputeGridSplitting>  m_parall  ; ///< parallel object for splitting and reconstruction
     std::shared_ptr<ParallelComputeGridSplitting>  m_parallDet  ; ///< parallel object for splitting and reconstruction for deterministic optimization
     boost::mpi::communicator  m_world; ///< Mpi communicator
+    SplittingFunction m_splitting ; ///< splitting of the grid between processors used in optimization
 
     /// \brief function to read continuation values in archive
     /// \param p_name         key in archive
@@ -79,13 +80,15 @@ public :
     /// \param p_pOptimize        Optimize object defining the transition step
     /// \param p_bOneFile         do we store continuation values  in only one file
     /// \param p_world            MPI communicator
+    /// \param p_splitting        splitting of the grid between processors (the same as the one used in optimization)
     SimulateStepMultiStageRegressionDist(const std::shared_ptr<gs::BinaryFileArchive> &p_ar,
                                          const int &p_iStep,  const std::string &p_nameCont,
                                          const std::string &p_nameDetCont,
                                          const  std::shared_ptr<FullGrid> &p_pGridCurrent,
                                          const  std::shared_ptr<FullGrid> &p_pGridFollowing,
                                          const  std::shared_ptr<OptimizerMultiStageDPBase > &p_pOptimize,
-                                         const bool &p_bOneFile, const boost::mpi::communicator &p_world);
+                                         const bool &p_bOneFile, const boost::mpi::communicator &p_world,
+                                         const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief Define one step arbitraging between possible commands
     /// \param p_statevector    Vector of states (regime, stock descriptor, uncertainty)
@@ -0,0 +1,139 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SIMULATESTEPPIPELINE_H
+#define SIMULATESTEPPIPELINE_H
+#include <memory>
+#include <functional>
+#include <future>
+#ifdef USE_MPI
+#include <array>
+#include <boost/mpi.hpp>
+#endif
+
+/** \file SimulateStepPipeline.h
+ * \brief Pipeline for forward simulations : the object for the next time step (SimulateStepRegression, SimulateStepTree,
+ *        SimulateStepRegressionCut ...) is created on a background thread while the current step is simulated.
+ *        As the constructors of the simulation steps read the archive, the reading of step k+1 is overlapped
+ *        with the oneStep of step k.
+ *        Double buffering : if the step returned by next() is released before the following call to next(),
+ *        at most two steps (the current one and the one being read) are in memory.
+ *        The archive used by the factory must not be read by the current step during oneStep
+ *        (steps created with ChunkedRegressedValues read the archive lazily : use a second archive on the same file).
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class SimulateStepPipeline SimulateStepPipeline.h
+/// Create the simulation steps  one step ahead on a background thread
+/// Usage :
+/// \code
+///  SimulateStepPipeline< SimulateStepRegression > pipeline([&](const int &p_i)
+///  {
+///      return std::make_shared<SimulateStepRegression>(ar, nbStep - 1 - p_i, nameAr, grid, optimizer);
+///  }, nbStep);
+///  for (int istep = 0; istep < nbStep; ++istep)
+///      pipeline.next()->oneStep(states, costFunction);
+/// \endcode
+template< class SimulateStep >
+class SimulateStepPipeline
+{
+public :
+
+#ifdef USE_MPI
+    /// \brief create the step number p_iStep (in simulation order) with the given communicator
+    typedef std::function< std::shared_ptr< SimulateStep >(const int &, const boost::mpi::communicator &) > Factory;
+#else
+    /// \brief create the step number p_iStep (in simulation order)
+    typedef std::function< std::shared_ptr< SimulateStep >(const int &) > Factory;
+#endif
+
+private :
+
+    Factory m_factory ; ///< create a step
+    int m_nbStep ; ///< number of steps
+    int m_iStep ; ///< next step returned
+    bool m_bAsync ; ///< true if the steps are created on a background thread
+    std::future< std::shared_ptr< SimulateStep > > m_next ; ///< next step (being created)
+#ifdef USE_MPI
+    std::array< boost::mpi::communicator, 2 > m_world ; ///< communicators used alternatively by the steps : collectives of a step creation never interfere with the collectives of the current step
+#endif
+
+    /// \brief launch the creation of the step m_iStep
+    void launch()
+    {
+        if (m_iStep >= m_nbStep)
+            return;
+        int iStep = m_iStep;
+        std::launch policy = (m_bAsync ? std::launch::async : std::launch::deferred);
+#ifdef USE_MPI
+        boost::mpi::communicator world = m_world[iStep % 2];
+        m_next = std::async(policy, [this, iStep, world]()
+        {
+            return m_factory(iStep, world);
+        });
+#else
+        m_next = std::async(policy, [this, iStep]()
+        {
+            return m_factory(iStep);
+        });
+#endif
+    }
+
+public :
+
+    /// \brief Constructor : the creation of the first step is launched
+    /// \param p_factory   create the step number i (in simulation order)
+    /// \param p_nbStep    number of steps
+    /// \param p_world     MPI communicator (duplicated twice). Creation on a background thread needs MPI_THREAD_MULTIPLE, otherwise steps are created synchronously
+    /// \param p_bAsync    if false steps are created when next() is called (no overlapping)
+    SimulateStepPipeline(const Factory &p_factory, const int &p_nbStep
+#ifdef USE_MPI
+                         , const boost::mpi::communicator &p_world
+#endif
+                         , const bool &p_bAsync = true): m_factory(p_factory), m_nbStep(p_nbStep), m_iStep(0), m_bAsync(p_bAsync)
+    {
+#ifdef USE_MPI
+        m_world[0] = boost::mpi::communicator(p_world, boost::mpi::comm_duplicate);
+        m_world[1] = boost::mpi::communicator(p_world, boost::mpi::comm_duplicate);
+        if ((p_world.size() > 1) && (boost::mpi::environment::thread_level() != boost::mpi::threading::multiple))
+            m_bAsync = false;
+#endif
+        launch();
+    }
+
+    SimulateStepPipeline(const SimulateStepPipeline &) = delete;
+    SimulateStepPipeline &operator=(const SimulateStepPipeline &) = delete;
+
+    /// \brief wait for the step being created (a step not launched is not created)
+    ~SimulateStepPipeline()
+    {
+        if (m_bAsync && m_next.valid())
+            m_next.wait();
+    }
+
+    /// \brief get back the next step and launch the creation of the following one
+    ///        Exceptions raised by the creation of the step are thrown here
+    std::shared_ptr< SimulateStep > next()
+    {
+        std::shared_ptr< SimulateStep > step = m_next.get();
+        m_iStep += 1;
+        launch();
+        return step;
+    }
+
+    /// \brief true if some steps have not been returned yet
+    inline bool hasNext() const
+    {
+        return m_iStep < m_nbStep;
+    }
+
+    /// \brief true if steps are created on a background thread
+    inline bool isAsync() const
+    {
+        return m_bAsync;
+    }
+};
+}
+#endif /* SIMULATESTEPPIPELINE_H */
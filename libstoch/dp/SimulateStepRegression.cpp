@@ -1,11 +1,13 @@
 // Copyright (C) 2016 EDF
 // All Rights Reserved
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include "libstoch/core/utils/Instrumentation.h"
+#include "libstoch/core/utils/sortStatesByCell.h"
 #include "libstoch/dp/SimulateStepRegression.h"
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 
 using namespace std;
@@ -19,16 +21,46 @@ SimulateStepRegression::SimulateStepRegression(gs::BinaryFileArchive &p_ar,  con
         , const boost::mpi::communicator &p_world
 #endif
                                               ): m_pGridFollowing(p_pGridFollowing),
-    m_pOptimize(p_pOptimize)
+    m_pOptimize(p_pOptimize), m_bSortStates(false)
 #ifdef USE_MPI
     , m_world(p_world)
 #endif
 {
+    InstrumentationTimer timerIO(instIO, true);
     gs::Reference< vector< GridAndRegressedValue > > (p_ar, (p_nameCont + "Values").c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_continuationObj);
 }
 
+SimulateStepRegression::SimulateStepRegression(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const string &p_nameCont,
+        const   shared_ptr<FullGrid> &p_pGridFollowing, const  shared_ptr<libstoch::OptimizerDPBase > &p_pOptimize, const bool &p_bChunked
+#ifdef USE_MPI
+        , const boost::mpi::communicator &p_world
+#endif
+                                              ): m_pGridFollowing(p_pGridFollowing),
+    m_pOptimize(p_pOptimize), m_pFullGridFollowing(p_pGridFollowing), m_bSortStates(false)
+#ifdef USE_MPI
+    , m_world(p_world)
+#endif
+{
+    InstrumentationTimer timerIO(instIO, true);
+    if (p_bChunked)
+        m_chunked = make_shared<ChunkedRegressedValues>(p_ar, p_nameCont + "Values", p_iStep);
+    else
+        gs::Reference< vector< GridAndRegressedValue > > (p_ar, (p_nameCont + "Values").c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_continuationObj);
+}
+
+vector< GridAndRegressedValue > SimulateStepRegression::getChunkedContinuation(const vector<StateWithStocks > &p_statevector, const int &p_iFirst, const int &p_iLast) const
+{
+    if (p_iLast <= p_iFirst)
+        return vector< GridAndRegressedValue >();
+    vector< array< double, 2> > region = ChunkedRegressedValues::getStockRegion(p_statevector, p_iFirst, p_iLast);
+    // stocks reachable from the stocks simulated
+    region = m_pOptimize->getCone(region);
+    return m_chunked->getContinuation(m_pFullGridFollowing, ChunkedRegressedValues::getMeshCovering(m_pFullGridFollowing, region));
+}
+
 void SimulateStepRegression::oneStep(vector<StateWithStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepRegression");
 
 
 #ifdef USE_MPI
@@ -40,35 +72,57 @@ void SimulateStepRegression::oneStep(vector<StateWithStocks > &p_statevector, Ar
     int iLastSim  = iFirstSim + nsimPProc + (rank < nRestSim ? 1 : 0);
     ArrayXXd stockPerSim(p_statevector[0].getStockSize(), iLastSim - iFirstSim);
     ArrayXXd valueFunctionPerSim(p_phiInOut.rows(), iLastSim - iFirstSim);
+    // continuation values read by blocks
+    vector< GridAndRegressedValue > continuationObjChunked;
+    if (m_chunked)
+        continuationObjChunked = getChunkedContinuation(p_statevector, iFirstSim, iLastSim);
+    const vector< GridAndRegressedValue > &continuationObj = (m_chunked ? continuationObjChunked : m_continuationObj);
+    // simulations treated by mesh if required
+    vector<int> simOrder = simulationOrder(p_statevector, m_pGridFollowing, iFirstSim, iLastSim, m_bSortStates);
     // spread calculations on processors
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
-    for (is = iFirstSim; is <  iLastSim; ++is)
+    for (is = 0; is <  static_cast<int>(simOrder.size()); ++is)
     {
-        m_pOptimize->stepSimulate(m_pGridFollowing, m_continuationObj, p_statevector[is], p_phiInOut.col(is));
+        int isim = simOrder[is];
+        m_pOptimize->stepSimulate(m_pGridFollowing, continuationObj, p_statevector[isim], p_phiInOut.col(isim));
         // store for broadcast
-        stockPerSim.col(is - iFirstSim) = p_statevector[is].getPtStock();
+        stockPerSim.col(isim - iFirstSim) = p_statevector[isim].getPtStock();
         if (valueFunctionPerSim.size() > 0)
-            valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut.col(is);
+            valueFunctionPerSim.col(isim - iFirstSim) = p_phiInOut.col(isim);
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(iLastSim - iFirstSim);
     // broadcast
     ArrayXXd stockAllSim(p_statevector[0].getStockSize(), p_statevector.size());
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
     // update results
     for (size_t iis = 0; iis < p_statevector.size(); ++iis)
         p_statevector[iis].setPtStock(stockAllSim.col(iis));
 #else
+    // continuation values read by blocks
+    vector< GridAndRegressedValue > continuationObjChunked;
+    if (m_chunked)
+        continuationObjChunked = getChunkedContinuation(p_statevector, 0, static_cast<int>(p_statevector.size()));
+    const vector< GridAndRegressedValue > &continuationObj = (m_chunked ? continuationObjChunked : m_continuationObj);
+    // simulations treated by mesh if required
+    vector<int> simOrder = simulationOrder(p_statevector, m_pGridFollowing, 0, static_cast<int>(p_statevector.size()), m_bSortStates);
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
-    for (is = 0; is <  static_cast<int>(p_statevector.size()); ++is)
+    for (is = 0; is <  static_cast<int>(simOrder.size()); ++is)
     {
-        m_pOptimize->stepSimulate(m_pGridFollowing, m_continuationObj, p_statevector[is], p_phiInOut.col(is));
+        int isim = simOrder[is];
+        m_pOptimize->stepSimulate(m_pGridFollowing, continuationObj, p_statevector[isim], p_phiInOut.col(isim));
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(p_statevector.size());
 
 #endif
 }
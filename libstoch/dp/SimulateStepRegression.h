@@ -15,6 +15,8 @@
 #include "libstoch/dp/SimulateStepBase.h"
 #include "libstoch/core/utils/StateWithStocks.h"
 #include "libstoch/core/grids/SpaceGrid.h"
+#include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/dp/ChunkedRegressedValues.h"
 #include "libstoch/dp/OptimizerDPBase.h"
 #include "libstoch/regression/GridAndRegressedValueGeners.h"
 
@@ -35,10 +37,19 @@ private :
     std::shared_ptr<SpaceGrid>  m_pGridFollowing ; ///< global grid at following time step
     std::shared_ptr<libstoch::OptimizerDPBase >          m_pOptimize ; ///< optimizer solving the problem for one point and one step
     std::vector< GridAndRegressedValue >  m_continuationObj ; ///< to store continuation value per regime  on the grid at following step
+    std::shared_ptr<FullGrid>  m_pFullGridFollowing ; ///< grid at following time step if values are read by blocks
+    std::shared_ptr<ChunkedRegressedValues> m_chunked ; ///< lazy reader of the blocks (if values are dumped by blocks)
+    bool m_bSortStates ; ///< if true simulations are treated by mesh of the grid and of the regressor
 #ifdef USE_MPI
     boost::mpi::communicator  m_world; ///< Mpi communicator
 #endif
 
+    /// \brief get back the continuation values on the sub grid used by some simulations  : only the blocks reached are read
+    /// \param p_statevector  Vector of states
+    /// \param p_iFirst       first simulation
+    /// \param p_iLast        last simulation (excluded)
+    std::vector< GridAndRegressedValue > getChunkedContinuation(const std::vector<StateWithStocks > &p_statevector, const int &p_iFirst, const int &p_iLast) const;
+
 public :
 
     /// \brief default
@@ -59,6 +70,36 @@ public :
 #endif
                           );
 
+    /// \brief Constructor used when values are dumped by blocks of grid points (dumpChunkedContinuationValues) :
+    ///        only the blocks around the stocks simulated are read in oneStep, so the archive must be kept open until oneStep is called
+    /// \param p_ar               Archive where continuation values are stored
+    /// \param p_iStep            Step number indentifier
+    /// \param p_nameCont         Name use to store conuation valuation
+    /// \param p_pGridFollowing   grid at following time step
+    /// \param p_pOptimize        Optimize object defining the transition step
+    /// \param p_bChunked         if true values are read by blocks, otherwise the whole record is read as in the previous constructor
+    /// \param p_world            MPI communicator
+    SimulateStepRegression(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const std::string &p_nameCont,
+                           const   std::shared_ptr<FullGrid> &p_pGridFollowing, const  std::shared_ptr<libstoch::OptimizerDPBase > &p_pOptimize,
+                           const bool &p_bChunked
+#ifdef USE_MPI
+                           , const boost::mpi::communicator &p_world
+#endif
+                          );
+
+    /// \brief Treat the simulations sorted by the mesh containing their stock and by their uncertainty (see sortStatesByCell)
+    ///        to improve the locality of the interpolations. Results are stored at the original positions of the simulations.
+    inline void setSortStates(const bool &p_bSortStates)
+    {
+        m_bSortStates = p_bSortStates;
+    }
+
+    /// \brief lazy reader of the blocks (empty if values are not read by blocks)
+    inline std::shared_ptr<ChunkedRegressedValues> getChunked() const
+    {
+        return m_chunked;
+    }
+
     /// \brief Define one step arbitraging between possibhle commands
     /// \param p_statevector    Vector of states (regime, stock descritor, uncertainty)
     /// \param p_phiInOut       actual contract values modified at current time step by applying an optimal command (number of function by numver of simulations)
@@ -4,8 +4,10 @@
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
+#include "libstoch/core/utils/Instrumentation.h"
+#include "libstoch/core/utils/sortStatesByCell.h"
 #include "libstoch/dp/SimulateStepRegressionControl.h"
 
 using namespace std;
@@ -20,16 +22,46 @@ SimulateStepRegressionControl::SimulateStepRegressionControl(gs::BinaryFileArchi
 #endif
                                                             ):
     m_pGridFollowing(p_pGridFollowing),
-    m_pOptimize(p_pOptimize)
+    m_pOptimize(p_pOptimize), m_bSortStates(false)
 #ifdef USE_MPI
     , m_world(p_world)
 #endif
 {
+    InstrumentationTimer timerIO(instIO, true);
     gs::Reference< vector<GridAndRegressedValue> > (p_ar, (p_nameCont + "Control").c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_control);
 }
 
+SimulateStepRegressionControl::SimulateStepRegressionControl(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const string &p_nameCont,
+        const   shared_ptr<FullGrid> &p_pGridFollowing,
+        const  shared_ptr<libstoch::OptimizerBaseInterp > &p_pOptimize, const bool &p_bChunked
+#ifdef USE_MPI
+        ,  const boost::mpi::communicator &p_world
+#endif
+                                                            ):
+    m_pGridFollowing(p_pGridFollowing),
+    m_pOptimize(p_pOptimize), m_pFullGridFollowing(p_pGridFollowing), m_bSortStates(false)
+#ifdef USE_MPI
+    , m_world(p_world)
+#endif
+{
+    InstrumentationTimer timerIO(instIO, true);
+    if (p_bChunked)
+        m_chunked = make_shared<ChunkedRegressedValues>(p_ar, p_nameCont + "Control", p_iStep);
+    else
+        gs::Reference< vector<GridAndRegressedValue> > (p_ar, (p_nameCont + "Control").c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_control);
+}
+
+vector< GridAndRegressedValue > SimulateStepRegressionControl::getChunkedControl(const vector<StateWithStocks > &p_statevector, const int &p_iFirst, const int &p_iLast) const
+{
+    if (p_iLast <= p_iFirst)
+        return vector< GridAndRegressedValue >();
+    vector< array< double, 2> > region = ChunkedRegressedValues::getStockRegion(p_statevector, p_iFirst, p_iLast);
+    return m_chunked->getContinuation(m_pFullGridFollowing, ChunkedRegressedValues::getMeshCovering(m_pFullGridFollowing, region));
+}
+
 void SimulateStepRegressionControl::oneStep(vector<StateWithStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepRegressionControl");
 #ifdef USE_MPI
     int rank = m_world.rank();
     int nbProc = m_world.size();    // parallelism
@@ -41,26 +73,37 @@ void SimulateStepRegressionControl::oneStep(vector<StateWithStocks > &p_statevec
     // nows store regimes
     ArrayXi regimePerSim(iLastSim - iFirstSim);
     ArrayXXd valueFunctionPerSim(p_phiInOut.rows(), iLastSim - iFirstSim);
+    // controls read by blocks
+    vector< GridAndRegressedValue > controlChunked;
+    if (m_chunked)
+        controlChunked = getChunkedControl(p_statevector, iFirstSim, iLastSim);
+    const vector< GridAndRegressedValue > &control = (m_chunked ? controlChunked : m_control);
+    // simulations treated by mesh if required
+    vector<int> simOrder = simulationOrder(p_statevector, m_pGridFollowing, iFirstSim, iLastSim, m_bSortStates);
     // spread calculations on processors
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
-    for (is = iFirstSim; is <  iLastSim; ++is)
+    for (is = 0; is <  static_cast<int>(simOrder.size()); ++is)
     {
-        m_pOptimize->stepSimulateControl(m_pGridFollowing, m_control, p_statevector[is], p_phiInOut.col(is));
+        int isim = simOrder[is];
+        m_pOptimize->stepSimulateControl(m_pGridFollowing, control, p_statevector[isim], p_phiInOut.col(isim));
         // store for broadcast
-        stockPerSim.col(is - iFirstSim) = p_statevector[is].getPtStock();
-        regimePerSim(is - iFirstSim) = p_statevector[is].getRegime();
+        stockPerSim.col(isim - iFirstSim) = p_statevector[isim].getPtStock();
+        regimePerSim(isim - iFirstSim) = p_statevector[isim].getRegime();
         if (valueFunctionPerSim.size() > 0)
-            valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut.col(is);
+            valueFunctionPerSim.col(isim - iFirstSim) = p_phiInOut.col(isim);
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(iLastSim - iFirstSim);
     // broadcast
     ArrayXXd stockAllSim(m_pGridFollowing->getDimension(), p_statevector.size());
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
     ArrayXi regimeAllSim(p_statevector.size());
-    boost::mpi::all_gatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
+    allGatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
     // update results
     for (size_t iis = 0; iis < p_statevector.size(); ++iis)
     {
@@ -68,14 +111,25 @@ void SimulateStepRegressionControl::oneStep(vector<StateWithStocks > &p_statevec
         p_statevector[iis].setRegime(regimeAllSim(iis));
     }
 #else
+    // controls read by blocks
+    vector< GridAndRegressedValue > controlChunked;
+    if (m_chunked)
+        controlChunked = getChunkedControl(p_statevector, 0, static_cast<int>(p_statevector.size()));
+    const vector< GridAndRegressedValue > &control = (m_chunked ? controlChunked : m_control);
+    // simulations treated by mesh if required
+    vector<int> simOrder = simulationOrder(p_statevector, m_pGridFollowing, 0, static_cast<int>(p_statevector.size()), m_bSortStates);
     int is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
-    for (is = 0; is <  static_cast<int>(p_statevector.size()); ++is)
+    for (is = 0; is <  static_cast<int>(simOrder.size()); ++is)
     {
-        m_pOptimize->stepSimulateControl(m_pGridFollowing, m_control, p_statevector[is], p_phiInOut.col(is));
+        int isim = simOrder[is];
+        m_pOptimize->stepSimulateControl(m_pGridFollowing, control, p_statevector[isim], p_phiInOut.col(isim));
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(p_statevector.size());
 
 #endif
 
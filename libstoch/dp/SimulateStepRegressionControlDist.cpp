@@ -4,16 +4,18 @@
 #ifdef USE_MPI
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepRegressionControlDist.h"
 #include "libstoch/regression/GridAndRegressedValue.h"
 #include "libstoch/regression/GridAndRegressedValueGeners.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/utils/NodeParticleSplitting.h"
+#include "libstoch/core/utils/sortStatesByCell.h"
 #include "libstoch/core/utils/types.h"
 #include "libstoch/core/utils/constant.h"
 #include "libstoch/core/utils/comparisonUtils.h"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 
 using namespace std;
 using namespace libstoch;
@@ -22,9 +24,10 @@ using namespace Eigen;
 
 SimulateStepRegressionControlDist::SimulateStepRegressionControlDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const string &p_nameCont,
         const   shared_ptr<FullGrid> &p_pGridCurrent,  const   shared_ptr<FullGrid> &p_pGridFollowing, const  shared_ptr<OptimizerBaseInterp > &p_pOptimize,
-        const bool &p_bOneFile, const boost::mpi::communicator &p_world): m_pGridCurrent(p_pGridCurrent), m_pGridFollowing(p_pGridFollowing),
-    m_pOptimize(p_pOptimize), m_bOneFile(p_bOneFile)	, m_world(p_world)
+        const bool &p_bOneFile, const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting): m_pGridCurrent(p_pGridCurrent), m_pGridFollowing(p_pGridFollowing),
+    m_pOptimize(p_pOptimize), m_bOneFile(p_bOneFile), m_bSortStates(false), m_world(p_world)
 {
+    InstrumentationTimer timerIO(instIO, true);
     string stepString = boost::lexical_cast<string>(p_iStep);
     if (m_bOneFile)
     {
@@ -35,7 +38,7 @@ SimulateStepRegressionControlDist::SimulateStepRegressionControlDist(gs::BinaryF
         vector<int> initialVecDimension;
         gs::Reference< 	vector<int> >(p_ar, "initialSizeOfMesh", stepString.c_str()).restore(0, &initialVecDimension);
         Map<const ArrayXi > initialDimension(initialVecDimension.data(), initialVecDimension.size());
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), p_world);
+        ArrayXi splittingRatio = p_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), p_world);
         m_parall =  make_shared<ParallelComputeGridSplitting>(initialDimension, splittingRatio, p_world);
         gs::Reference< vector< ArrayXXd > >(p_ar, (p_nameCont + "Control").c_str(), stepString.c_str()).restore(0, & m_contValue);
         m_regressor = gs::Reference< BaseRegression >(p_ar, "regressor", stepString.c_str()).get(0);
@@ -45,6 +48,7 @@ SimulateStepRegressionControlDist::SimulateStepRegressionControlDist(gs::BinaryF
 
 void SimulateStepRegressionControlDist::oneStep(vector<StateWithStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepRegressionControlDist");
     unique_ptr<ArrayXXd >  particles(new ArrayXXd(p_statevector.size(), m_pGridCurrent->getDimension()));
     for (size_t is = 0; is < p_statevector.size(); ++is)
         for (int isto = 0; isto < m_pGridCurrent->getDimension(); ++isto)
@@ -70,6 +74,9 @@ void SimulateStepRegressionControlDist::oneStep(vector<StateWithStocks > &p_stat
     for (size_t is = 0; is <  p_statevector.size(); ++is)
         if (nCell(is) == m_world.rank())
             simCurrentProc.push_back(is);
+    // simulations treated by mesh if required
+    if (m_bSortStates)
+        sortStatesByCell(p_statevector, m_pGridCurrent, simCurrentProc);
     // nows store stocks
     ArrayXd stockPerSim(m_pGridCurrent->getDimension()*simCurrentProc.size());
     // store value functions
@@ -77,6 +84,7 @@ void SimulateStepRegressionControlDist::oneStep(vector<StateWithStocks > &p_stat
     if (m_bOneFile)
     {
         // spread calculations on processors
+        InstrumentationTimer timerOptimize(instOptimize);
         for (size_t is = 0; is <  simCurrentProc.size(); ++is)
         {
             int simuNumber = simCurrentProc[is];
@@ -86,6 +94,8 @@ void SimulateStepRegressionControlDist::oneStep(vector<StateWithStocks > &p_stat
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     else
     {
@@ -116,6 +126,7 @@ void SimulateStepRegressionControlDist::oneStep(vector<StateWithStocks > &p_stat
             controlExtended[iCont].setRegressedValues(valuesExtended);
         }
         // spread calculations on processors
+        InstrumentationTimer timerOptimize(instOptimize);
         for (size_t is = 0; is <  simCurrentProc.size(); ++is)
         {
             int simuNumber = simCurrentProc[is];
@@ -125,14 +136,16 @@ void SimulateStepRegressionControlDist::oneStep(vector<StateWithStocks > &p_stat
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     // broadcast
     vector<double> stockAllSim;
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
     vector<double> valueFunctionAllSim;
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
     vector<int> simAllProc;
-    boost::mpi::all_gatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
+    allGatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
     // update results
     int iis = 0;
     for (size_t is = 0; is < simAllProc.size(); ++is)
@@ -34,6 +34,7 @@ private :
     std::vector< Eigen::ArrayXXd > m_contValue ; ///< to store control values split on current processor
     bool m_bOneFile ; /// do we use one file for continuation values
     std::shared_ptr<ParallelComputeGridSplitting>  m_parall  ; ///< parallel object for splitting and reconstruction
+    bool m_bSortStates ; ///< if true simulations are treated by mesh of the grid and of the regressor
     boost::mpi::communicator  m_world; ///< Mpi communicator
 
 public :
@@ -51,11 +52,20 @@ public :
     /// \param p_pOptimize        Optimize object defining the transition step
     /// \param p_bOneFile              do we store continuation values  in only one file
     /// \param p_world            MPI communicator
+    /// \param p_splitting        splitting of the grid between processors (the same as the one used in optimization)
     SimulateStepRegressionControlDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const std::string &p_nameCont,
                                       const   std::shared_ptr<FullGrid> &p_pGridCurrent,
                                       const   std::shared_ptr<FullGrid> &p_pGridFollowing,
                                       const  std::shared_ptr<OptimizerBaseInterp > &p_pOptimize,
-                                      const bool &p_bOneFile, const boost::mpi::communicator &p_world);
+                                      const bool &p_bOneFile, const boost::mpi::communicator &p_world,
+                                      const SplittingFunction &p_splitting = paraOptimalSplitting);
+
+    /// \brief Treat the simulations of the processor sorted by the mesh containing their stock and by their uncertainty (see sortStatesByCell)
+    ///        to improve the locality of the interpolations. Results are stored at the original positions of the simulations.
+    inline void setSortStates(const bool &p_bSortStates)
+    {
+        m_bSortStates = p_bSortStates;
+    }
 
     /// \brief Define one step arbitraging between possible commands
     /// \param p_statevector    Vector of states (regime, stock descriptor, uncertainty)
@@ -4,12 +4,14 @@
 #ifdef USE_MPI
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepRegressionDist.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/utils/NodeParticleSplitting.h"
+#include "libstoch/core/utils/sortStatesByCell.h"
 #include "libstoch/core/utils/types.h"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 
 using namespace std;
 using namespace libstoch;
@@ -18,9 +20,10 @@ using namespace Eigen;
 
 SimulateStepRegressionDist::SimulateStepRegressionDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const string &p_nameCont,
         const   shared_ptr<FullGrid> &p_pGridFollowing, const  shared_ptr<OptimizerDPBase > &p_pOptimize,
-        const bool &p_bOneFile, const boost::mpi::communicator &p_world): m_pGridFollowing(p_pGridFollowing),
-    m_pOptimize(p_pOptimize), m_contValue(p_pOptimize->getNbRegime()), m_bOneFile(p_bOneFile)	, m_world(p_world)
+        const bool &p_bOneFile, const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting): m_pGridFollowing(p_pGridFollowing),
+    m_pOptimize(p_pOptimize), m_contValue(p_pOptimize->getNbRegime()), m_bOneFile(p_bOneFile), m_bSortStates(false), m_world(p_world)
 {
+    InstrumentationTimer timerIO(instIO, true);
     string stepString = boost::lexical_cast<string>(p_iStep);
     if (m_bOneFile)
     {
@@ -31,7 +34,7 @@ SimulateStepRegressionDist::SimulateStepRegressionDist(gs::BinaryFileArchive &p_
         vector<int> initialVecDimensionFollow;
         gs::Reference< 	vector<int> >(p_ar, "initialSizeOfMeshPrev", stepString.c_str()).restore(0, &initialVecDimensionFollow);
         Map<const ArrayXi > initialDimensionFollow(initialVecDimensionFollow.data(), initialVecDimensionFollow.size());
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimensionFollow, m_pOptimize->getDimensionToSplit(), p_world);
+        ArrayXi splittingRatio = p_splitting(initialDimensionFollow, m_pOptimize->getDimensionToSplit(), p_world);
         m_parall =  make_shared<ParallelComputeGridSplitting>(initialDimensionFollow, splittingRatio, p_world);
         gs::Reference< vector< ArrayXXd > >(p_ar, (p_nameCont + "Values").c_str(), stepString.c_str()).restore(0, & m_contValue);
         m_regressor = gs::Reference< BaseRegression >(p_ar, "regressor", stepString.c_str()).get(0);
@@ -41,6 +44,7 @@ SimulateStepRegressionDist::SimulateStepRegressionDist(gs::BinaryFileArchive &p_
 
 void SimulateStepRegressionDist::oneStep(vector<StateWithStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepRegressionDist");
     unique_ptr<ArrayXXd >  particles(new ArrayXXd(p_statevector.size(), m_pGridFollowing->getDimension()));
     for (size_t is = 0; is < p_statevector.size(); ++is)
         for (int isto = 0; isto < m_pGridFollowing->getDimension(); ++isto)
@@ -65,6 +69,9 @@ void SimulateStepRegressionDist::oneStep(vector<StateWithStocks > &p_statevector
     for (size_t is = 0; is <  p_statevector.size(); ++is)
         if (nCell(is) == m_world.rank())
             simCurrentProc.push_back(is);
+    // simulations treated by mesh if required
+    if (m_bSortStates)
+        sortStatesByCell(p_statevector, m_pGridFollowing, simCurrentProc);
     // nows store stocks
     ArrayXd stockPerSim(m_pGridFollowing->getDimension()*simCurrentProc.size());
     // nows store regimes
@@ -75,6 +82,7 @@ void SimulateStepRegressionDist::oneStep(vector<StateWithStocks > &p_statevector
     {
         // spread calculations on processors
         int  is = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         #pragma omp parallel for  private(is)
 #endif
@@ -88,6 +96,8 @@ void SimulateStepRegressionDist::oneStep(vector<StateWithStocks > &p_statevector
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     else
     {
@@ -124,6 +134,7 @@ void SimulateStepRegressionDist::oneStep(vector<StateWithStocks > &p_statevector
         }
         // spread calculations on processors
         int  is = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         #pragma omp parallel for  private(is)
 #endif
@@ -137,16 +148,18 @@ void SimulateStepRegressionDist::oneStep(vector<StateWithStocks > &p_statevector
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     // broadcast
     vector<double> stockAllSim;
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
     vector<int> regimeAllSim;
-    boost::mpi::all_gatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
+    allGatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
     vector<double> valueFunctionAllSim;
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
     vector<int> simAllProc;
-    boost::mpi::all_gatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
+    allGatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
     // update results
     int iis = 0;
     for (size_t is = 0; is < simAllProc.size(); ++is)
@@ -4,13 +4,14 @@
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/utils/types.h"
 #include "libstoch/regression/BaseRegressionGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepSwitch.h"
 
 using namespace std;
@@ -32,6 +33,7 @@ SimulateStepSwitch::SimulateStepSwitch(gs::BinaryFileArchive &p_ar,  const int &
     , m_world(p_world)
 #endif
 {
+    InstrumentationTimer timerIO(instIO, true);
     string stepString = boost::lexical_cast<string>(p_iStep);
     m_regressor = gs::Reference< BaseRegression >(p_ar, "regressor", stepString.c_str()).get(0);
     for (size_t iReg = 0; iReg <  p_pGridFollowing.size(); ++iReg)
@@ -42,6 +44,7 @@ SimulateStepSwitch::SimulateStepSwitch(gs::BinaryFileArchive &p_ar,  const int &
 
 void SimulateStepSwitch::oneStep(vector<StateWithIntState > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepSwitch");
 #ifdef USE_MPI
     int rank = m_world.rank();
     int nbProc = m_world.size();    // parallelism
@@ -61,6 +64,7 @@ void SimulateStepSwitch::oneStep(vector<StateWithIntState > &p_statevector, Arra
     ArrayXXd valueFunctionPerSim(p_phiInOut.rows(), iLastSim - iFirstSim);
     // spread calculations on processors
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -74,15 +78,18 @@ void SimulateStepSwitch::oneStep(vector<StateWithIntState > &p_statevector, Arra
         if (valueFunctionPerSim.size() > 0)
             valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut.col(is);
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(iLastSim - iFirstSim);
     // broadcast
     ArrayXXi stateAllSim(dimMax, p_statevector.size());
-    boost::mpi::all_gatherv<int>(m_world, statePerSim.data(), statePerSim.size(), stateAllSim.data());
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
+    allGatherv<int>(m_world, statePerSim.data(), statePerSim.size(), stateAllSim.data());
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
     // update results
     for (size_t iis = 0; iis < p_statevector.size(); ++iis)
         p_statevector[iis].setPtState(stateAllSim.col(iis).head(dimSizePerReg(p_statevector[iis].getRegime())));
 #else
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -90,6 +97,8 @@ void SimulateStepSwitch::oneStep(vector<StateWithIntState > &p_statevector, Arra
     {
         m_pOptimize->stepSimulate(m_pGridFollowing, m_regressor, m_basisFunc, p_statevector[is], p_phiInOut.col(is));
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(p_statevector.size());
 
 #endif
 
@@ -2,8 +2,9 @@
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepTreeControl.h"
 
 using namespace std;
@@ -23,11 +24,13 @@ SimulateStepTreeControl::SimulateStepTreeControl(gs::BinaryFileArchive &p_ar,  c
     , m_world(p_world)
 #endif
 {
+    InstrumentationTimer timerIO(instIO, true);
     gs::Reference< vector<GridTreeValue> > (p_ar, (p_nameCont + "Control").c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_control);
 }
 
 void SimulateStepTreeControl::oneStep(vector<StateTreeStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepTreeControl");
 #ifdef USE_MPI
     int rank = m_world.rank();
     int nbProc = m_world.size();    // parallelism
@@ -41,6 +44,7 @@ void SimulateStepTreeControl::oneStep(vector<StateTreeStocks > &p_statevector, A
     ArrayXXd valueFunctionPerSim(p_phiInOut.rows(), iLastSim - iFirstSim);
     // spread calculations on processors
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -53,12 +57,14 @@ void SimulateStepTreeControl::oneStep(vector<StateTreeStocks > &p_statevector, A
         if (valueFunctionPerSim.size() > 0)
             valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut.col(is);
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(iLastSim - iFirstSim);
     // broadcast
     ArrayXXd stockAllSim(m_pGridFollowing->getDimension(), p_statevector.size());
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
     ArrayXi regimeAllSim(p_statevector.size());
-    boost::mpi::all_gatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
+    allGatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
     // update results
     for (size_t iis = 0; iis < p_statevector.size(); ++iis)
     {
@@ -67,6 +73,7 @@ void SimulateStepTreeControl::oneStep(vector<StateTreeStocks > &p_statevector, A
     }
 #else
     int is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -74,6 +81,8 @@ void SimulateStepTreeControl::oneStep(vector<StateTreeStocks > &p_statevector, A
     {
         m_pOptimize->stepSimulateControl(m_pGridFollowing, m_control, p_statevector[is], p_phiInOut.col(is));
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(p_statevector.size());
 
 #endif
 
@@ -2,6 +2,7 @@
 #ifdef USE_MPI
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepTreeControlDist.h"
 #include "libstoch/tree/GridTreeValue.h"
 #include "libstoch/tree/GridTreeValueGeners.h"
@@ -11,7 +12,7 @@
 #include "libstoch/core/utils/types.h"
 #include "libstoch/core/utils/constant.h"
 #include "libstoch/core/utils/comparisonUtils.h"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 
 using namespace std;
 using namespace libstoch;
@@ -20,9 +21,10 @@ using namespace Eigen;
 
 SimulateStepTreeControlDist::SimulateStepTreeControlDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const string &p_nameCont,
         const   shared_ptr<FullGrid> &p_pGridCurrent,  const   shared_ptr<FullGrid> &p_pGridFollowing, const  shared_ptr<OptimizerDPTreeBase > &p_pOptimize,
-        const bool &p_bOneFile, const boost::mpi::communicator &p_world): m_pGridCurrent(p_pGridCurrent), m_pGridFollowing(p_pGridFollowing),
+        const bool &p_bOneFile, const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting): m_pGridCurrent(p_pGridCurrent), m_pGridFollowing(p_pGridFollowing),
     m_pOptimize(p_pOptimize), m_bOneFile(p_bOneFile), m_world(p_world)
 {
+    InstrumentationTimer timerIO(instIO, true);
     string stepString = boost::lexical_cast<string>(p_iStep);
     if (m_bOneFile)
     {
@@ -33,7 +35,7 @@ SimulateStepTreeControlDist::SimulateStepTreeControlDist(gs::BinaryFileArchive &
         vector<int> initialVecDimension;
         gs::Reference< 	vector<int> >(p_ar, "initialSizeOfMesh", stepString.c_str()).restore(0, &initialVecDimension);
         Map<const ArrayXi > initialDimension(initialVecDimension.data(), initialVecDimension.size());
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), p_world);
+        ArrayXi splittingRatio = p_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), p_world);
         m_parall =  make_shared<ParallelComputeGridSplitting>(initialDimension, splittingRatio, p_world);
         gs::Reference< vector< std::shared_ptr<ArrayXXd >  > >(p_ar, (p_nameCont + "Control").c_str(), stepString.c_str()).restore(0, & m_contValue);
     }
@@ -41,6 +43,7 @@ SimulateStepTreeControlDist::SimulateStepTreeControlDist(gs::BinaryFileArchive &
 
 void SimulateStepTreeControlDist::oneStep(vector<StateTreeStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepTreeControlDist");
     unique_ptr<ArrayXXd >  particles(new ArrayXXd(p_statevector.size(), m_pGridCurrent->getDimension()));
     for (size_t is = 0; is < p_statevector.size(); ++is)
         for (int isto = 0; isto < m_pGridCurrent->getDimension(); ++isto)
@@ -73,6 +76,7 @@ void SimulateStepTreeControlDist::oneStep(vector<StateTreeStocks > &p_statevecto
     if (m_bOneFile)
     {
         // spread calculations on processors
+        InstrumentationTimer timerOptimize(instOptimize);
         for (size_t is = 0; is <  simCurrentProc.size(); ++is)
         {
             int simuNumber = simCurrentProc[is];
@@ -82,6 +86,8 @@ void SimulateStepTreeControlDist::oneStep(vector<StateTreeStocks > &p_statevecto
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     else
     {
@@ -110,6 +116,7 @@ void SimulateStepTreeControlDist::oneStep(vector<StateTreeStocks > &p_statevecto
             controlExtended[iCont] = GridTreeValue(gridExtended, valuesExtended);
         }
         // spread calculations on processors
+        InstrumentationTimer timerOptimize(instOptimize);
         for (size_t is = 0; is <  simCurrentProc.size(); ++is)
         {
             int simuNumber = simCurrentProc[is];
@@ -119,14 +126,16 @@ void SimulateStepTreeControlDist::oneStep(vector<StateTreeStocks > &p_statevecto
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     // broadcast
     vector<double> stockAllSim;
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
     vector<double> valueFunctionAllSim;
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
     vector<int> simAllProc;
-    boost::mpi::all_gatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
+    allGatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
     // update results
     int iis = 0;
     for (size_t is = 0; is < simAllProc.size(); ++is)
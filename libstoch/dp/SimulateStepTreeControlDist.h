@@ -49,11 +49,13 @@ public :
     /// \param p_pOptimize        Optimize object defining the transition step
     /// \param p_bOneFile              do we stoxre continuation values  in only one file
     /// \param p_world            MPI communicator
+    /// \param p_splitting        splitting of the grid between processors (the same as the one used in optimization)
     SimulateStepTreeControlDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const std::string &p_nameCont,
                                 const   std::shared_ptr<FullGrid> &p_pGridCurrent,
                                 const   std::shared_ptr<FullGrid> &p_pGridFollowing,
                                 const  std::shared_ptr<OptimizerDPTreeBase > &p_pOptimize,
-                                const bool &p_bOneFile, const boost::mpi::communicator &p_world);
+                                const bool &p_bOneFile, const boost::mpi::communicator &p_world,
+                                const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief Define one step arbitraging between possible commands
     /// \param p_statevector    Vector of states (regime, stock descriptor, uncertainty)
@@ -1,9 +1,10 @@
 
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepTreeCut.h"
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #include "libstoch/tree/ContinuationCutsTreeGeners.h"
 
@@ -23,11 +24,13 @@ SimulateStepTreeCut::SimulateStepTreeCut(gs::BinaryFileArchive &p_ar,  const int
     , m_world(p_world)
 #endif
 {
+    InstrumentationTimer timerIO(instIO, true);
     gs::Reference< vector< ContinuationCutsTree > > (p_ar, (p_nameCont + "Values").c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_continuationObj);
 }
 
 void SimulateStepTreeCut::oneStep(vector<StateTreeStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepTreeCut");
 
 
 #ifdef USE_MPI
@@ -41,6 +44,7 @@ void SimulateStepTreeCut::oneStep(vector<StateTreeStocks > &p_statevector, Array
     ArrayXXd valueFunctionPerSim(p_phiInOut.rows(), iLastSim - iFirstSim);
     // spread calculations on processors
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -52,15 +56,18 @@ void SimulateStepTreeCut::oneStep(vector<StateTreeStocks > &p_statevector, Array
         if (valueFunctionPerSim.size() > 0)
             valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut.col(is);
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(iLastSim - iFirstSim);
     // broadcast
     ArrayXXd stockAllSim(m_pGridFollowing->getDimension(), p_statevector.size());
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim.data());
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
     // update results
     for (size_t iis = 0; iis < p_statevector.size(); ++iis)
         p_statevector[iis].setPtStock(stockAllSim.col(iis));
 #else
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -68,6 +75,8 @@ void SimulateStepTreeCut::oneStep(vector<StateTreeStocks > &p_statevector, Array
     {
         m_pOptimize->stepSimulate(m_pGridFollowing, m_continuationObj, p_statevector[is], p_phiInOut.col(is));
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(p_statevector.size());
 
 #endif
 }
@@ -2,12 +2,13 @@
 #ifdef USE_MPI
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/SimulateStepTreeDist.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/utils/NodeParticleSplitting.h"
 #include "libstoch/core/utils/types.h"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 
 using namespace std;
 using namespace libstoch;
@@ -16,9 +17,10 @@ using namespace Eigen;
 
 SimulateStepTreeDist::SimulateStepTreeDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const string &p_nameCont,
         const   shared_ptr<FullGrid> &p_pGridFollowing, const  shared_ptr<OptimizerDPTreeBase > &p_pOptimize,
-        const bool &p_bOneFile, const boost::mpi::communicator &p_world): m_pGridFollowing(p_pGridFollowing),
+        const bool &p_bOneFile, const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting): m_pGridFollowing(p_pGridFollowing),
     m_pOptimize(p_pOptimize), m_contValue(p_pOptimize->getNbRegime()), m_bOneFile(p_bOneFile)	, m_world(p_world)
 {
+    InstrumentationTimer timerIO(instIO, true);
     string stepString = boost::lexical_cast<string>(p_iStep);
     if (m_bOneFile)
     {
@@ -29,7 +31,7 @@ SimulateStepTreeDist::SimulateStepTreeDist(gs::BinaryFileArchive &p_ar,  const i
         vector<int> initialVecDimensionFollow;
         gs::Reference< 	vector<int> >(p_ar, "initialSizeOfMeshPrev", stepString.c_str()).restore(0, &initialVecDimensionFollow);
         Map<const ArrayXi > initialDimensionFollow(initialVecDimensionFollow.data(), initialVecDimensionFollow.size());
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimensionFollow, m_pOptimize->getDimensionToSplit(), p_world);
+        ArrayXi splittingRatio = p_splitting(initialDimensionFollow, m_pOptimize->getDimensionToSplit(), p_world);
         m_parall =  make_shared<ParallelComputeGridSplitting>(initialDimensionFollow, splittingRatio, p_world);
         gs::Reference< vector<ArrayXXd  > >(p_ar, (p_nameCont + "Values").c_str(), stepString.c_str()).restore(0, & m_contValue);
     }
@@ -37,6 +39,7 @@ SimulateStepTreeDist::SimulateStepTreeDist(gs::BinaryFileArchive &p_ar,  const i
 
 void SimulateStepTreeDist::oneStep(vector<StateTreeStocks > &p_statevector, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepTreeDist");
     unique_ptr<ArrayXXd >  particles(new ArrayXXd(p_statevector.size(), m_pGridFollowing->getDimension()));
     for (size_t is = 0; is < p_statevector.size(); ++is)
         for (int isto = 0; isto < m_pGridFollowing->getDimension(); ++isto)
@@ -70,6 +73,7 @@ void SimulateStepTreeDist::oneStep(vector<StateTreeStocks > &p_statevector, Arra
     if (m_bOneFile)
     {
         // spread calculations on processors
+        InstrumentationTimer timerOptimize(instOptimize);
         for (size_t is = 0; is <  simCurrentProc.size(); ++is)
         {
             int simuNumber = simCurrentProc[is];
@@ -80,6 +84,8 @@ void SimulateStepTreeDist::oneStep(vector<StateTreeStocks > &p_statevector, Arra
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     else
     {
@@ -113,6 +119,7 @@ void SimulateStepTreeDist::oneStep(vector<StateTreeStocks > &p_statevector, Arra
             continuationExtended[iReg] = GridTreeValue(gridExtended, valuesExtended);
         }
         // spread calculations on processors
+        InstrumentationTimer timerOptimize(instOptimize);
         for (size_t is = 0; is <  simCurrentProc.size(); ++is)
         {
             int simuNumber = simCurrentProc[is];
@@ -123,16 +130,18 @@ void SimulateStepTreeDist::oneStep(vector<StateTreeStocks > &p_statevector, Arra
             if (valueFunctionPerSim.size() > 0)
                 valueFunctionPerSim.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     // broadcast
     vector<double> stockAllSim;
-    boost::mpi::all_gatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
+    allGatherv<double>(m_world, stockPerSim.data(), stockPerSim.size(), stockAllSim);
     vector<int> regimeAllSim;
-    boost::mpi::all_gatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
+    allGatherv<int>(m_world, regimePerSim.data(), regimePerSim.size(), regimeAllSim);
     vector<double> valueFunctionAllSim;
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), valueFunctionAllSim);
     vector<int> simAllProc;
-    boost::mpi::all_gatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
+    allGatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
     // update results
     int iis = 0;
     for (size_t is = 0; is < simAllProc.size(); ++is)
@@ -22,15 +22,16 @@ using namespace  std;
 TransitionStepBaseDist::TransitionStepBaseDist(const  shared_ptr<FullGrid> &p_pGridCurrent,
         const  shared_ptr<FullGrid> &p_pGridPrevious,
         const  shared_ptr<OptimizerBase > &p_pOptimize,
-        const boost::mpi::communicator &p_world):
-    m_pGridCurrent(p_pGridCurrent), m_pGridPrevious(p_pGridPrevious), m_pOptimize(p_pOptimize), m_world(p_world)
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting):
+    m_pGridCurrent(p_pGridCurrent), m_pGridPrevious(p_pGridPrevious), m_pOptimize(p_pOptimize), m_world(p_world), m_splitting(p_splitting)
 {
     // initial and previous dimensions
     ArrayXi initialDimension   = p_pGridCurrent->getDimensions();
     ArrayXi initialDimensionPrev  = p_pGridPrevious->getDimensions();
     // organize the hypercube splitting for parallel
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), p_world);
-    ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), p_world);
+    ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), p_world);
+    ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), p_world);
     // cone value
     function < SubMeshIntCoord(const SubMeshIntCoord &) > fMesh = GridReach<OptimizerBase>(p_pGridCurrent, p_pGridPrevious, p_pOptimize);
     // ParallelComputeGridsSplitting objects
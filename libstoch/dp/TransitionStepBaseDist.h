@@ -35,6 +35,7 @@ protected :
     std::shared_ptr<FullGrid>   m_gridCurrentProc ; ///< local grid  treated by the processor
     std::shared_ptr<FullGrid>   m_gridExtendPreviousStep; ///< give extended grid at previous step
     boost::mpi::communicator  m_world; ///< Mpi communicator
+    SplittingFunction m_splitting ; ///< splitting of the grids between processors
 
 public :
 
@@ -47,10 +48,12 @@ public :
     /// \param p_pridPrevious  grid (stock points) at the previusly treated time step
     /// \param p_pOptimize           optimizer object to optimizer the problem on one time step
     /// \param p_world               MPI communicator
+    /// \param p_splitting           splitting of the grids between processors (for example TopologySplitting)
     TransitionStepBaseDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent,
                            const  std::shared_ptr<FullGrid> &p_pridPrevious,
                            const  std::shared_ptr<OptimizerBase> &p_pOptimize,
-                           const boost::mpi::communicator &p_world);
+                           const boost::mpi::communicator &p_world,
+                           const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief get back local grid (to processor) associated to current step
     inline std::shared_ptr<FullGrid >   getGridCurrentProc()const
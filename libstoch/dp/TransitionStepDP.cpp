@@ -5,13 +5,14 @@
 #include "geners/Record.hh"
 #ifdef USE_MPI
 #include "boost/mpi.hpp"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
 #include "libstoch/core/utils/OpenmpException.h"
 #endif
 #include "libstoch/core/grids/GridIterator.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepDP.h"
 #include "libstoch/regression/GridAndRegressedValue.h"
 #include "libstoch/regression/GridAndRegressedValueGeners.h"
@@ -41,6 +42,7 @@ TransitionStepDP::TransitionStepDP(const  shared_ptr<FullGrid> &p_pGridCurrent,
 
 std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen::ArrayXXd > >  > TransitionStepDP::oneStep(const vector<  Eigen::ArrayXXd > &p_phiIn) const
 {
+    InstrumentationStep instStep("TransitionStepDP");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     shared_ptr< vector< ArrayXXd > >  phiOut = make_shared<vector< ArrayXXd > > (nbRegimes);
@@ -50,12 +52,14 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
     if (m_pGridCurrent->getNbPoints() > 0)
     {
         // Create Regressor using the values p_phin
+        InstrumentationTimer timerRegression(instRegression);
         std::vector<GridAndRegressedValue> valGridReg(nbRegimes);
         for (int ireg = 0; ireg < nbRegimes; ++ireg)
         {
             valGridReg[ireg] = GridAndRegressedValue(m_pGridPrevious, m_regressorPrevious);
             valGridReg[ireg].setRegressedValues(p_phiIn[ireg]);
         }
+        timerRegression.stop();
 #ifdef USE_MPI
         int  rank = m_world.rank();
         int nbProc = m_world.size();
@@ -87,6 +91,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
 #endif
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -97,6 +102,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator >  iterGridPoint = m_pGridCurrent->getGridIterator();
                 // account for mpi and threads
 #ifdef USE_MPI
@@ -110,6 +116,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
                     ArrayXd pointCoord = iterGridPoint->getCoordinate();
                     // optimize the current point and the set of regimes
                     std::pair< ArrayXXd, ArrayXXd>  solutionAndControl = m_pOptimize->stepOptimize(pointCoord, valGridReg, m_regressorCurrent);
+                    instThread.countOptimize();
 #ifdef USE_MPI
                     // copie solution
                     int iposArray = iterGridPoint->getRelativePosition();
@@ -136,20 +143,21 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
 
 #ifdef USE_MPI
         ArrayXi ilocToGLobalGlob(nbPointsCur);
-        boost::mpi::all_gatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+        allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
         ArrayXXd storeGlob(m_regressorCurrent->getNumberOfFunction(), nbPointsCur);
         for (int iReg = 0; iReg < nbRegimes; ++iReg)
         {
-            boost::mpi::all_gatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
+            allGatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
             for (int ipos = 0; ipos < ilocToGLobalGlob.size(); ++ipos)
                 (*phiOut)[iReg].col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
         for (int iCont = 0 ; iCont < nbControl; ++iCont)
         {
-            boost::mpi::all_gatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
+            allGatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
             for (int ipos = 0; ipos <  ilocToGLobalGlob.size(); ++ipos)
                 (*controlOut)[iCont].col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
@@ -161,6 +169,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
 void TransitionStepDP::dumpValues(std::shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep,
                                   const vector< ArrayXXd   > &p_control) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -19,6 +19,7 @@
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/regression/GridAndRegressedValue.h"
 #include "libstoch/regression/GridAndRegressedValueGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepDPDist.h"
 #include "libstoch/core/parallelism/GridReach.h"
 
@@ -34,12 +35,14 @@ TransitionStepDPDist::TransitionStepDPDist(const  shared_ptr<FullGrid> &p_pGridC
         const  std::shared_ptr<BaseRegression> &p_regressorCurrent,
         const  std::shared_ptr<BaseRegression> &p_regressorPrevious,
         const  shared_ptr<OptimizerNoRegressionDPBase > &p_pOptimize,
-        const boost::mpi::communicator &p_world):
-    TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world), m_regressorPrevious(p_regressorPrevious), m_regressorCurrent(p_regressorCurrent)
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting):
+    TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world, p_splitting), m_regressorPrevious(p_regressorPrevious), m_regressorCurrent(p_regressorCurrent)
 {}
 
 std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen::ArrayXXd > >  > TransitionStepDPDist::oneStep(const vector<  Eigen::ArrayXXd > &p_phiIn) const
 {
+    InstrumentationStep instStep("TransitionStepDPDist");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     shared_ptr< vector< ArrayXXd > >  phiOut = make_shared< vector< ArrayXXd > >(nbRegimes);
@@ -66,12 +69,14 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
             (*controlOut)[iCont] = ArrayXXd(m_regressorCurrent->getNumberOfFunction(), m_gridCurrentProc->getNbPoints());
 
         //  create continuation values on extended grid
+        InstrumentationTimer timerRegression(instRegression);
         vector< GridAndRegressedValue > valGridReg(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
         {
             valGridReg[iReg] = GridAndRegressedValue(m_gridExtendPreviousStep, m_regressorPrevious);
             valGridReg[iReg].setRegressedValues(phiInExtended[iReg]);
         }
+        timerRegression.stop();
 
 
         // number of thread
@@ -83,6 +88,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -93,6 +99,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_gridCurrentProc->getGridIterator();
 
                 // account fo threads
@@ -105,6 +112,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
 
                     // optimize the current point and the set of regimes
                     std::pair< ArrayXXd, ArrayXXd>  solutionAndControl = static_pointer_cast<OptimizerNoRegressionDPBase>(m_pOptimize)->stepOptimize(pointCoord, valGridReg, m_regressorCurrent);
+                    instThread.countOptimize();
                     // copie solution
                     for (int iReg = 0; iReg < nbRegimes; ++iReg)
                         (*phiOut)[iReg].col(iterGridPoint->getCount()) = m_regressorCurrent->getCoordBasisFunction(solutionAndControl.first.col(iReg));
@@ -119,6 +127,7 @@ std::pair< shared_ptr< vector<  Eigen::ArrayXXd > >, shared_ptr< vector<  Eigen:
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
     }
     return make_pair(phiOut, controlOut);
 }
@@ -127,6 +136,7 @@ void TransitionStepDPDist::dumpValues(std::shared_ptr<gs::BinaryFileArchive> p_a
                                       const vector< ArrayXXd   > &p_control,
                                       const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimensionPrev  = m_pGridPrevious->getDimensions();
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
@@ -156,7 +166,7 @@ void TransitionStepDPDist::dumpValues(std::shared_ptr<gs::BinaryFileArchive> p_a
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< GridAndRegressedValue > control(p_control.size());
         for (size_t iCont = 0; iCont < p_control.size(); ++iCont)
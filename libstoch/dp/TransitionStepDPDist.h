@@ -46,7 +46,8 @@ public :
                          const  std::shared_ptr<BaseRegression> &p_regressorCurrent,
                          const  std::shared_ptr<BaseRegression> &p_regressorPrevious,
                          const  std::shared_ptr<OptimizerNoRegressionDPBase> &p_pOptimize,
-                         const boost::mpi::communicator &p_world);
+                         const boost::mpi::communicator &p_world,
+                         const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief One step for optimization
     /// \param p_phiIn      for each regime the function value at the next time step : store as (regressed function by number of  grid points)
@@ -6,14 +6,18 @@
 #include "geners/vectorIO.hh"
 #include "geners/Record.hh"
 #ifdef USE_MPI
+#include <array>
 #include <boost/mpi.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
+#include "libstoch/core/parallelism/GridReach.h"
+#include "libstoch/core/utils/types.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
 #include "libstoch/core/utils/OpenmpException.h"
 #endif
 #include "libstoch/core/grids/GridIterator.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepMultiStageRegressionDP.h"
 #include "libstoch/dp/OptimizerMultiStageDPBase.h"
 #include "libstoch/regression/ContinuationValue.h"
@@ -27,6 +31,237 @@ using namespace libstoch;
 using namespace std;
 
 
+#ifdef USE_MPI
+/// \brief first point of the grid treated by a processor (contiguous ranges as in GridIterator::jumpToAndInc)
+/// \param p_rank      processor number (p_nbProc gives the end of the last range)
+/// \param p_nbProc    number of processors
+/// \param p_nbPoints  number of points of the grid
+static int firstPointOfProc(const int &p_rank, const int &p_nbProc, const int &p_nbPoints)
+{
+    int npointPProc = p_nbPoints / p_nbProc;
+    int nRestPoint = p_nbPoints % p_nbProc;
+    return p_rank * npointPProc + (p_rank < nRestPoint ? p_rank : nRestPoint);
+}
+
+/// \brief processor treating a point of the grid
+static int procOfPoint(const int &p_iPoint, const int &p_nbProc, const int &p_nbPoints)
+{
+    int npointPProc = p_nbPoints / p_nbProc;
+    int nRestPoint = p_nbPoints % p_nbProc;
+    if (p_iPoint < nRestPoint * (npointPProc + 1))
+        return p_iPoint / (npointPProc + 1);
+    return nRestPoint + (p_iPoint - nRestPoint * (npointPProc + 1)) / npointPProc;
+}
+
+/// \brief number of points of a sub mesh
+static int nbPointsInMesh(const SubMeshIntCoord &p_mesh)
+{
+    int nbPoints = 1;
+    for (int id = 0; id < p_mesh.size(); ++id)
+        nbPoints *= p_mesh(id)[1] - p_mesh(id)[0];
+    return nbPoints;
+}
+
+/// \brief global number of a point of a sub mesh
+/// \param p_iPoint      number of the point in the sub mesh
+/// \param p_mesh        sub mesh
+/// \param p_dimensions  number of points of the grid in each dimension
+static int globalPointOfMesh(int p_iPoint, const SubMeshIntCoord &p_mesh, const ArrayXi &p_dimensions)
+{
+    int iGlob = 0;
+    int iMult = 1;
+    for (int id = 0; id < p_dimensions.size(); ++id)
+    {
+        int nLoc = p_mesh(id)[1] - p_mesh(id)[0];
+        iGlob += (p_mesh(id)[0] + p_iPoint % nLoc) * iMult;
+        p_iPoint /= nLoc;
+        iMult *= p_dimensions(id);
+    }
+    return iGlob;
+}
+
+/// \brief Points exchanged between processors before each deterministic stage of a step
+struct StageExchange
+{
+    SubMeshIntCoord m_subMesh ; ///< sub grid reached from the points of the processor
+    vector< vector<int> > m_send ; ///< for each processor, local position of the points sent
+    vector< vector<int> > m_recv ; ///< for each processor, position in the sub grid of the points received
+    vector< array<int, 2> > m_own ; ///< position in the sub grid and local position of the points of the sub grid owned by the processor
+};
+
+/// \brief calculate the points exchanged : each processor needs the points reached from its own points during a stage
+/// \param p_grid      grid used for all deterministic stages
+/// \param p_optimize  optimizer giving the cone
+/// \param p_world     MPI communicator
+static StageExchange buildStageExchange(const shared_ptr<FullGrid> &p_grid, const shared_ptr<OptimizerMultiStageDPBase> &p_optimize,
+                                        const boost::mpi::communicator &p_world)
+{
+    int rank = p_world.rank();
+    int nbProc = p_world.size();
+    int nbPoints = p_grid->getNbPoints();
+    const ArrayXi &dimensions = p_grid->getDimensions();
+    int nDim = dimensions.size();
+    int iFirstPoint = firstPointOfProc(rank, nbProc, nbPoints);
+    int iLastPoint = firstPointOfProc(rank + 1, nbProc, nbPoints);
+    StageExchange exchange;
+    // empty sub mesh if no point treated
+    exchange.m_subMesh = SubMeshIntCoord::Constant(nDim, array<int, 2> {{0, 0}});
+    if (iLastPoint > iFirstPoint)
+    {
+        // smallest box containing the points of the processor
+        SubMeshIntCoord ownMesh(nDim);
+        for (int id = 0; id < nDim; ++id)
+        {
+            ownMesh(id)[0] = dimensions(id);
+            ownMesh(id)[1] = 0;
+        }
+        for (int ipoint = iFirstPoint; ipoint < iLastPoint; ++ipoint)
+        {
+            int idec = ipoint;
+            for (int id = 0; id < nDim; ++id)
+            {
+                int icoord = idec % dimensions(id);
+                idec /= dimensions(id);
+                ownMesh(id)[0] = min(ownMesh(id)[0], icoord);
+                ownMesh(id)[1] = max(ownMesh(id)[1], icoord + 1);
+            }
+        }
+        exchange.m_subMesh = GridReach<OptimizerBase>(p_grid, p_grid, p_optimize)(ownMesh);
+    }
+    // sub meshes of all processors
+    vector<int> meshLoc(2 * nDim);
+    for (int id = 0; id < nDim; ++id)
+    {
+        meshLoc[2 * id] = exchange.m_subMesh(id)[0];
+        meshLoc[2 * id + 1] = exchange.m_subMesh(id)[1];
+    }
+    vector<int> meshAll(nbProc * 2 * nDim);
+    {
+        InstrumentationTimer timerCommunication(instCommunication);
+        boost::mpi::all_gather(p_world, meshLoc.data(), 2 * nDim, meshAll.data());
+        instrumentBytes(static_cast<long>(nbProc) * 2 * nDim * sizeof(int));
+    }
+    // points sent and received : sub mesh points are treated in the same order by senders and receivers
+    exchange.m_send.resize(nbProc);
+    exchange.m_recv.resize(nbProc);
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+    {
+        SubMeshIntCoord mesh(nDim);
+        for (int id = 0; id < nDim; ++id)
+        {
+            mesh(id)[0] = meshAll[2 * (iproc * nDim + id)];
+            mesh(id)[1] = meshAll[2 * (iproc * nDim + id) + 1];
+        }
+        int nbPointsMesh = nbPointsInMesh(mesh);
+        for (int ip = 0; ip < nbPointsMesh; ++ip)
+        {
+            int iGlob = globalPointOfMesh(ip, mesh, dimensions);
+            int iOwner = procOfPoint(iGlob, nbProc, nbPoints);
+            if (iproc == rank)
+            {
+                if (iOwner == rank)
+                    exchange.m_own.push_back(array<int, 2> {{ip, iGlob - iFirstPoint}});
+                else
+                    exchange.m_recv[iOwner].push_back(ip);
+            }
+            else if (iOwner == rank)
+                exchange.m_send[iproc].push_back(iGlob - iFirstPoint);
+        }
+    }
+    return exchange;
+}
+
+/// \brief exchange with neighbours the values calculated by the processor at the end of a stage
+/// \param p_exchange    points exchanged
+/// \param p_phiOutLoc   for each regime, values calculated by the processor (nb simulations, nb points of the processor)
+/// \param p_world       MPI communicator
+/// \param p_nbBytes     bytes received
+/// \return for each regime the values on the sub grid reached by the processor
+static vector< shared_ptr< ArrayXXd > > exchangeStage(const StageExchange &p_exchange, const vector< ArrayXXd > &p_phiOutLoc,
+        const boost::mpi::communicator &p_world, long &p_nbBytes)
+{
+    InstrumentationTimer timerCommunication(instCommunication);
+    int nbProc = p_world.size();
+    int nbRegimes = p_phiOutLoc.size();
+    int nbSimul = p_phiOutLoc[0].rows();
+    int nbPointsSub = nbPointsInMesh(p_exchange.m_subMesh);
+    vector< shared_ptr< ArrayXXd > > phiSub(nbRegimes);
+    for (int iReg = 0; iReg < nbRegimes; ++iReg)
+    {
+        phiSub[iReg] = make_shared< ArrayXXd >(nbSimul, nbPointsSub);
+        for (const auto &own : p_exchange.m_own)
+            phiSub[iReg]->col(own[0]) = p_phiOutLoc[iReg].col(own[1]);
+    }
+    // all regimes sent in one message
+    vector< ArrayXXd > bufferRecv(nbProc), bufferSend(nbProc);
+    vector< boost::mpi::request > requests;
+    p_nbBytes = 0;
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+    {
+        int nbRecv = p_exchange.m_recv[iproc].size();
+        if (nbRecv > 0)
+        {
+            bufferRecv[iproc].resize(nbSimul, nbRegimes * nbRecv);
+            requests.push_back(p_world.irecv(iproc, 0, bufferRecv[iproc].data(), bufferRecv[iproc].size()));
+            p_nbBytes += static_cast<long>(bufferRecv[iproc].size()) * sizeof(double);
+        }
+    }
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+    {
+        int nbSend = p_exchange.m_send[iproc].size();
+        if (nbSend > 0)
+        {
+            bufferSend[iproc].resize(nbSimul, nbRegimes * nbSend);
+            for (int iReg = 0; iReg < nbRegimes; ++iReg)
+                for (int ip = 0; ip < nbSend; ++ip)
+                    bufferSend[iproc].col(iReg * nbSend + ip) = p_phiOutLoc[iReg].col(p_exchange.m_send[iproc][ip]);
+            requests.push_back(p_world.isend(iproc, 0, bufferSend[iproc].data(), bufferSend[iproc].size()));
+        }
+    }
+    boost::mpi::wait_all(requests.begin(), requests.end());
+    instrumentBytes(p_nbBytes);
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+    {
+        int nbRecv = p_exchange.m_recv[iproc].size();
+        for (int iReg = 0; iReg < nbRegimes; ++iReg)
+            for (int ip = 0; ip < nbRecv; ++ip)
+                phiSub[iReg]->col(p_exchange.m_recv[iproc][ip]) = bufferRecv[iproc].col(iReg * nbRecv + ip);
+    }
+    return phiSub;
+}
+
+/// \brief gather the values of a stage on the root processor only
+/// \param p_phiOutLoc        for each regime, values calculated by the processor
+/// \param p_ilocToGLobalGlob global position of the points gathered
+/// \param p_storeGlob        utility
+/// \param p_phiOut           for each regime, values on the whole grid (filled on root)
+/// \param p_world            MPI communicator
+/// \return bytes received
+static long gatherStageOnRoot(const vector< ArrayXXd > &p_phiOutLoc, const ArrayXi &p_ilocToGLobalGlob, ArrayXXd &p_storeGlob,
+                              vector< shared_ptr< ArrayXXd > > &p_phiOut, const boost::mpi::communicator &p_world)
+{
+    InstrumentationTimer timerCommunication(instCommunication);
+    int nbProc = p_world.size();
+    int nbPoints = p_ilocToGLobalGlob.size();
+    vector<int> sizes(nbProc);
+    for (int iproc = 0; iproc < nbProc; ++iproc)
+        sizes[iproc] = p_storeGlob.rows() * (firstPointOfProc(iproc + 1, nbProc, nbPoints) - firstPointOfProc(iproc, nbProc, nbPoints));
+    long nbBytes = 0;
+    for (size_t iReg = 0; iReg < p_phiOutLoc.size(); ++iReg)
+    {
+        boost::mpi::gatherv<double>(p_world, p_phiOutLoc[iReg].data(), p_phiOutLoc[iReg].size(), p_storeGlob.data(), sizes, 0);
+        if (p_world.rank() == 0)
+        {
+            for (int ipos = 0; ipos < nbPoints; ++ipos)
+                p_phiOut[iReg]->col(p_ilocToGLobalGlob(ipos)) = p_storeGlob.col(ipos);
+            nbBytes += static_cast<long>(p_storeGlob.size()) * sizeof(double);
+        }
+    }
+    instrumentBytes(nbBytes);
+    return nbBytes;
+}
+#endif
+
 TransitionStepMultiStageRegressionDP::TransitionStepMultiStageRegressionDP(const  shared_ptr<FullGrid> &p_pGridCurrent,
         const  shared_ptr<FullGrid> &p_pGridPrevious,
         const  shared_ptr<OptimizerMultiStageDPBase > &p_pOptimize
@@ -34,7 +269,7 @@ TransitionStepMultiStageRegressionDP::TransitionStepMultiStageRegressionDP(const
         , const boost::mpi::communicator &p_world
 #endif
                                                                           ):
-    m_pGridCurrent(p_pGridCurrent), m_pGridPrevious(p_pGridPrevious), m_pOptimize(p_pOptimize)
+    m_pGridCurrent(p_pGridCurrent), m_pGridPrevious(p_pGridPrevious), m_pOptimize(p_pOptimize), m_bDistributedStages(false)
 #ifdef USE_MPI
     , m_world(p_world)
 #endif
@@ -49,7 +284,8 @@ TransitionStepMultiStageRegressionDP::TransitionStepMultiStageRegressionDP(const
         , const boost::mpi::communicator &p_world
 #endif
                                                                           ):
-    m_pGridCurrent(p_pGridCurrent), m_pGridPrevious(p_pGridPrevious), m_pOptimize(p_pOptimize), m_arGen(p_arGen), m_nameDump(p_nameDump)
+    m_pGridCurrent(p_pGridCurrent), m_pGridPrevious(p_pGridPrevious), m_pOptimize(p_pOptimize), m_arGen(p_arGen), m_nameDump(p_nameDump),
+    m_bDistributedStages(false)
 #ifdef USE_MPI
     , m_world(p_world)
 #endif
@@ -62,12 +298,11 @@ void TransitionStepMultiStageRegressionDP::oneStageInStep(const vector< shared_p
         vector<shared_ptr<ContinuationValue> > &p_contVal,
         const shared_ptr<FullGrid> &p_pGridCurTrans,
         const shared_ptr<FullGrid> &p_pGridPrevTrans
-#
 #ifdef USE_MPI
         , vector< ArrayXXd >   &p_phiOutLoc,
-        ArrayXi &p_ilocToGLobal,
-        ArrayXi &p_ilocToGLobalGlob,
-        ArrayXXd   &p_storeGlob
+        const ArrayXi &p_ilocToGLobalGlob,
+        ArrayXXd   &p_storeGlob,
+        const bool &p_bGather
 #endif
                                                          ) const
 {
@@ -86,6 +321,7 @@ void TransitionStepMultiStageRegressionDP::oneStageInStep(const vector< shared_p
 #endif
     // create iterator on current grid treated for processor
     int iThread = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     OpenmpException excep; // deal with exception in openmp
     #pragma omp parallel for  private(iThread)
@@ -96,6 +332,7 @@ void TransitionStepMultiStageRegressionDP::oneStageInStep(const vector< shared_p
         excep.run([&]
         {
 #endif
+            InstrumentationThread instThread;
             shared_ptr< GridIterator >  iterGridPoint = p_pGridCurTrans->getGridIterator();
             // account for mpi and threads
 #ifdef USE_MPI
@@ -109,10 +346,10 @@ void TransitionStepMultiStageRegressionDP::oneStageInStep(const vector< shared_p
                 ArrayXd pointCoord = iterGridPoint->getCoordinate();
                 // optimize the current point and the set of regimes
                 ArrayXXd  solution = m_pOptimize->stepOptimize(p_pGridPrevTrans, pointCoord, p_contVal, p_phiIn);
+                instThread.countOptimize();
 #ifdef USE_MPI
                 // copie solution
                 int iposArray = iterGridPoint->getRelativePosition();
-                p_ilocToGLobal(iposArray) = iterGridPoint->getCount();
                 // copie solution
                 for (int iReg = 0; iReg < nbDetRegimes; ++iReg)
                     p_phiOutLoc[iReg].col(iposArray) = solution.col(iReg);
@@ -131,14 +368,17 @@ void TransitionStepMultiStageRegressionDP::oneStageInStep(const vector< shared_p
 #ifdef _OPENMP
     excep.rethrow();
 #endif
+    timerOptimize.stop();
 
 #ifdef USE_MPI
-    boost::mpi::all_gatherv<int>(m_world, p_ilocToGLobal.data(), p_ilocToGLobal.size(), p_ilocToGLobalGlob.data());
-    for (int iReg = 0; iReg < nbDetRegimes; ++iReg)
+    if (p_bGather)
     {
-        boost::mpi::all_gatherv<double>(m_world, p_phiOutLoc[iReg].data(), p_phiOutLoc[iReg].size(), p_storeGlob.data());
-        for (int ipos = 0; ipos < p_ilocToGLobalGlob.size(); ++ipos)
-            (*p_phiOut[iReg]).col(p_ilocToGLobalGlob(ipos)) = p_storeGlob.col(ipos);
+        for (int iReg = 0; iReg < nbDetRegimes; ++iReg)
+        {
+            allGatherv<double>(m_world, p_phiOutLoc[iReg].data(), p_phiOutLoc[iReg].size(), p_storeGlob.data());
+            for (int ipos = 0; ipos < p_ilocToGLobalGlob.size(); ++ipos)
+                (*p_phiOut[iReg]).col(p_ilocToGLobalGlob(ipos)) = p_storeGlob.col(ipos);
+        }
     }
 #endif
 
@@ -148,6 +388,14 @@ void TransitionStepMultiStageRegressionDP::oneStageInStep(const vector< shared_p
 vector< shared_ptr< ArrayXXd > >  TransitionStepMultiStageRegressionDP::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< BaseRegression>     &p_condExp) const
 {
+    long nbBytesSaved = 0;
+    return oneStep(p_phiIn, p_condExp, nbBytesSaved);
+}
+
+vector< shared_ptr< ArrayXXd > >  TransitionStepMultiStageRegressionDP::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
+        const shared_ptr< BaseRegression>     &p_condExp, long &p_nbBytesSaved) const
+{
+    InstrumentationStep instStep("TransitionStepMultiStageRegressionDP");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     // number of deterministic regimes
@@ -156,36 +404,53 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepMultiStageRegressionDP::oneStep(
     assert(nbDetRegimes >= nbRegimes);
     vector< shared_ptr< ArrayXXd > >  phiOut(nbDetRegimes);
 
+    shared_ptr< SimulatorMultiStageDPBase > simulator = m_pOptimize->getSimulator();
+
+    int  nbPeriodsOfCurrentStep = simulator->getNbPeriodsInTransition();
+
+    p_nbBytesSaved = 0;
 #ifdef USE_MPI
-    int  rank = m_world.rank();
     int nbProc = m_world.size();
     //  allocate for solution
     int nbPointsCur = m_pGridCurrent->getNbPoints();
-    int npointPProcCur = (int)(nbPointsCur / nbProc);
-    int nRestPointCur = nbPointsCur % nbProc;
-    int iFirstPointCur = rank * npointPProcCur + (rank < nRestPointCur ? rank : nRestPointCur);
-    int iLastPointCur  = iFirstPointCur + npointPProcCur + (rank < nRestPointCur ? 1 : 0);
+    int iFirstPointCur = firstPointOfProc(m_world.rank(), nbProc, nbPointsCur);
+    int iLastPointCur  = firstPointOfProc(m_world.rank() + 1, nbProc, nbPointsCur);
     vector< ArrayXXd> phiOutLoc(nbDetRegimes);
-    ArrayXi ilocToGLobal(iLastPointCur - iFirstPointCur);
     for (int iReg = 0; iReg < nbDetRegimes; ++iReg)
         phiOutLoc[iReg].resize(p_condExp->getNbSimul(), iLastPointCur - iFirstPointCur);
+    // the grid is the same for all stages : global position of the points are gathered once
+    ArrayXi ilocToGLobal(iLastPointCur - iFirstPointCur);
+    for (int ipos = 0; ipos < ilocToGLobal.size(); ++ipos)
+        ilocToGLobal(ipos) = iFirstPointCur + ipos;
     ArrayXi ilocToGLobalGlob(nbPointsCur);
+    allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+    p_nbBytesSaved += static_cast<long>(nbPeriodsOfCurrentStep - 1) * nbPointsCur * sizeof(int);
     ArrayXXd storeGlob(p_condExp->getNbSimul(), nbPointsCur);
+    // bytes received by an all_gatherv of the values of one stage
+    long nbBytesGatherStage = static_cast<long>(nbDetRegimes) * storeGlob.size() * sizeof(double);
 
+    // values kept distributed between stages
+    bool bDistributed = m_bDistributedStages && (nbProc > 1) && (nbPeriodsOfCurrentStep > 1);
+    StageExchange exchange;
+    shared_ptr<FullGrid> gridReached;
+    if (bDistributed)
+    {
+        exchange = buildStageExchange(m_pGridCurrent, m_pOptimize, m_world);
+        if (iLastPointCur > iFirstPointCur)
+            gridReached = m_pGridCurrent->getSubGrid(exchange.m_subMesh);
+    }
 #endif
 
     //  allocate for solution
     for (int  iReg = 0; iReg < nbDetRegimes; ++iReg)
         phiOut[iReg] = make_shared< ArrayXXd >(p_condExp->getNbSimul(), m_pGridCurrent->getNbPoints());
 
-    shared_ptr< SimulatorMultiStageDPBase > simulator = m_pOptimize->getSimulator();
-
-    int  nbPeriodsOfCurrentStep = simulator->getNbPeriodsInTransition();
-
     //  create continuation for last period in stochastic
+    InstrumentationTimer timerRegression(instRegression);
     vector< shared_ptr<ContinuationValue> > contVal(p_phiIn.size());
     for (size_t iReg = 0; iReg < static_cast<size_t>(nbRegimes); ++iReg)
         contVal[iReg] = make_shared<ContinuationValue>(m_pGridPrevious, p_condExp, *p_phiIn[iReg]);
+    timerRegression.stop();
 
     // set period number in simulator
     simulator->setPeriodInTransition(nbPeriodsOfCurrentStep - 1);
@@ -193,47 +458,58 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepMultiStageRegressionDP::oneStep(
     // optimize for current step
     oneStageInStep(p_phiIn, phiOut, contVal, m_pGridCurrent, m_pGridPrevious
 #ifdef USE_MPI
-
-                   , phiOutLoc, ilocToGLobal, ilocToGLobalGlob, storeGlob
+                   , phiOutLoc, ilocToGLobalGlob, storeGlob, !bDistributed
 #endif
                   );
 
     // now iterate on deterministic period
     for (int iPeriod = nbPeriodsOfCurrentStep - 2; iPeriod >= 0; iPeriod--)
     {
-        vector< shared_ptr<ContinuationValue> > contValDet(nbDetRegimes);
-        for (size_t iReg = 0; iReg < static_cast<size_t>(nbDetRegimes); ++iReg)
-            contValDet[iReg] = make_shared<ContinuationValue>(m_pGridCurrent, p_condExp, *phiOut[iReg]);
-
-        // dump if necessary
-        if (m_arGen)
-        {
+        // local
+        vector< shared_ptr< ArrayXXd > >  phiInLoc(nbDetRegimes);
+        // grid where values of the previous stage are known
+        shared_ptr<FullGrid> gridPrevTrans = m_pGridCurrent;
 #ifdef USE_MPI
-            if (rank == 0)
+        if (bDistributed)
+        {
+            long nbBytesStage = 0;
+            // dump : values are only gathered on root
+            if (m_arGen)
             {
-#endif
-                // store as an interpolator (interpolate on trajectories values)
-                vector< GridAndRegressedValue > bellInterpolator(nbDetRegimes);
-                for (size_t iReg = 0; iReg < static_cast<size_t>(nbDetRegimes); ++iReg)
-                    bellInterpolator[iReg] = GridAndRegressedValue(m_pGridCurrent, p_condExp, *phiOut[iReg]);
-                *m_arGen << gs::Record(bellInterpolator, m_nameDump.c_str(), boost::lexical_cast<string>(iPeriod).c_str());
-#ifdef USE_MPI
+                nbBytesStage += gatherStageOnRoot(phiOutLoc, ilocToGLobalGlob, storeGlob, phiOut, m_world);
+                dumpContinuationDetValues(phiOut, p_condExp, iPeriod);
             }
+            long nbBytesExchange = 0;
+            phiInLoc = exchangeStage(exchange, phiOutLoc, m_world, nbBytesExchange);
+            nbBytesStage += nbBytesExchange;
+            p_nbBytesSaved += nbBytesGatherStage - nbBytesStage;
+            gridPrevTrans = gridReached;
+        }
+        else
 #endif
+        {
+            // dump if necessary
+            if (m_arGen)
+                dumpContinuationDetValues(phiOut, p_condExp, iPeriod);
+            for (int iReg = 0; iReg < nbDetRegimes; ++iReg)
+                phiInLoc[iReg] = make_shared< ArrayXXd >(*phiOut[iReg]);
         }
-        // local
-        vector< shared_ptr< ArrayXXd > >  phiInLoc(nbDetRegimes);
-        for (int iReg = 0; iReg < nbDetRegimes; ++iReg)
-            phiInLoc[iReg] = make_shared< ArrayXXd >(*phiOut[iReg]);
+
+        InstrumentationTimer timerRegressionDet(instRegression);
+        vector< shared_ptr<ContinuationValue> > contValDet(nbDetRegimes);
+        // no continuation if no point treated by the processor
+        if (gridPrevTrans)
+            for (size_t iReg = 0; iReg < static_cast<size_t>(nbDetRegimes); ++iReg)
+                contValDet[iReg] = make_shared<ContinuationValue>(gridPrevTrans, p_condExp, *phiInLoc[iReg]);
+        timerRegressionDet.stop();
 
         // set period number in simulator
         simulator->setPeriodInTransition(iPeriod);
 
         // optimize for current step
-        oneStageInStep(phiInLoc, phiOut, contValDet, m_pGridCurrent, m_pGridCurrent
+        oneStageInStep(phiInLoc, phiOut, contValDet, m_pGridCurrent, gridPrevTrans
 #ifdef USE_MPI
-
-                       , phiOutLoc, ilocToGLobal, ilocToGLobalGlob, storeGlob
+                       , phiOutLoc, ilocToGLobalGlob, storeGlob, !bDistributed || (iPeriod == 0)
 #endif
                       );
     }
@@ -251,8 +527,27 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepMultiStageRegressionDP::oneStep(
     }
 }
 
+void TransitionStepMultiStageRegressionDP::dumpContinuationDetValues(const vector< shared_ptr< ArrayXXd > > &p_phiOut,
+        const shared_ptr< BaseRegression>  &p_condExp, const int &p_iPeriod) const
+{
+#ifdef USE_MPI
+    if (m_world.rank() == 0)
+    {
+#endif
+        // store as an interpolator (interpolate on trajectories values)
+        InstrumentationTimer timerIO(instIO);
+        vector< GridAndRegressedValue > bellInterpolator(p_phiOut.size());
+        for (size_t iReg = 0; iReg < p_phiOut.size(); ++iReg)
+            bellInterpolator[iReg] = GridAndRegressedValue(m_pGridCurrent, p_condExp, *p_phiOut[iReg]);
+        *m_arGen << gs::Record(bellInterpolator, m_nameDump.c_str(), boost::lexical_cast<string>(p_iPeriod).c_str());
+#ifdef USE_MPI
+    }
+#endif
+}
+
 void TransitionStepMultiStageRegressionDP::dumpContinuationValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn, const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -271,6 +566,7 @@ void TransitionStepMultiStageRegressionDP::dumpContinuationValues(shared_ptr<gs:
 void TransitionStepMultiStageRegressionDP::dumpBellmanValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -20,6 +20,10 @@
 /** \file TransitionStepMultiStageRegressionDP.h
  * \brief Solve the dynamic programming  problem on one time step by regression with multi thread and mpi without distribution of the data
  *        In this version, on each time time a multistage deterministic problem is solved using DP
+ *        With MPI, each processor treats a contiguous range of points of the grid. By default all the values are gathered
+ *        on all processors at the end of each stage. With setDistributedStages(true), values stay distributed between the stages
+ *        of a step : before a deterministic stage, a processor only receives from its neighbours the points
+ *        reached (in the sense of the optimizer cone) from its own points. Values are gathered on all processors at the end of the step only.
  * \author Benoit Clair , Xavier Warin
   */
 
@@ -38,6 +42,7 @@ private :
     std::shared_ptr<OptimizerMultiStageDPBase  >  m_pOptimize ; ///< optimizer solving the problem for one point and one step
     std::shared_ptr<gs::BinaryFileArchive> m_arGen ; ///< geners archive
     std::string  m_nameDump ; ///< name to dump deterministic values
+    bool m_bDistributedStages ; ///< if true, values are not gathered between the stages of a step (only with MPI)
 
 #ifdef USE_MPI
     boost::mpi::communicator  m_world; ///< Mpi communicator
@@ -50,10 +55,10 @@ private :
     /// \param p_contVal           continuation object
     /// \param p_pGridCurTrans     current grid in transition
     /// \param p_pGridPrevTrans    previous grid in transition
-    /// \param p_phiOutLoc        utility for MPI calculations
-    /// \param p_ilocToGLobal     utility for MPI calculations
-    /// \param p_ilocToGLobalGlob utility for MPI calculations
+    /// \param p_phiOutLoc        utility for MPI calculations : cash calculated by the processor
+    /// \param p_ilocToGLobalGlob utility for MPI calculations : global position of the points gathered (gathered once per step)
     /// \param p_storeGlob        utility for MPI calculations
+    /// \param p_bGather          if true the values calculated by all processors are gathered in p_phiOut
     void oneStageInStep(const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_phiIn,
                         std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_phiOut,
                         std::vector<std::shared_ptr<ContinuationValue> > &p_contVal,
@@ -61,17 +66,24 @@ private :
                         const std::shared_ptr<FullGrid> &p_pGridPrevTrans
 #ifdef USE_MPI
                         , std::vector< Eigen::ArrayXXd >   &p_phiOutLoc,
-                        Eigen::ArrayXi &p_ilocToGLobal,
-                        Eigen::ArrayXi &p_ilocToGLobalGlob,
-                        Eigen::ArrayXXd   &p_storeGlob
+                        const Eigen::ArrayXi &p_ilocToGLobalGlob,
+                        Eigen::ArrayXXd   &p_storeGlob,
+                        const bool &p_bGather
 #endif
                        ) const;
 
+    /// \brief dump deterministic Bellman values of a stage (on root processor)
+    /// \param p_phiOut   for each deterministic regime the values on the current grid
+    /// \param p_condExp  conditional expectation operator
+    /// \param p_iPeriod  period in the transition
+    void dumpContinuationDetValues(const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_phiOut,
+                                   const std::shared_ptr< BaseRegression>  &p_condExp, const int &p_iPeriod) const;
+
 
 public :
 
     /// \brief default
-    TransitionStepMultiStageRegressionDP() {}
+    TransitionStepMultiStageRegressionDP(): m_bDistributedStages(false) {}
     virtual ~TransitionStepMultiStageRegressionDP() {}
 
     /// \brief Constructor without arxive dump
@@ -100,6 +112,23 @@ public :
     std::vector< std::shared_ptr< Eigen::ArrayXXd > >  oneStep(const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_phiIn,
             const std::shared_ptr< BaseRegression>     &p_condExp) const ;
 
+    /// \brief One step for dynamic programming in optimization
+    /// \param p_phiIn             for each regime the function value ( nb simulation, nb stocks )
+    /// \param p_condExp           Conditional expectation object
+    /// \param p_nbBytesSaved      bytes not received by the processor during the step compared to a gathering
+    ///                            of all the indices and values at the end of every stage (0 without MPI)
+    std::vector< std::shared_ptr< Eigen::ArrayXXd > >  oneStep(const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_phiIn,
+            const std::shared_ptr< BaseRegression>     &p_condExp,
+            long &p_nbBytesSaved) const ;
+
+
+    /// \brief Keep the values distributed between the stages of a step (no effect without MPI)
+    ///        Between two stages only the points in the cone of the points of the processor are exchanged with neighbours
+    /// \param p_bDistributedStages  true to activate
+    void setDistributedStages(const bool &p_bDistributedStages)
+    {
+        m_bDistributedStages = p_bDistributedStages;
+    }
 
     /// \brief Permits to dump stochastic continuation values on archive during time step optimization
     /// \param p_ar                   archive to dump in
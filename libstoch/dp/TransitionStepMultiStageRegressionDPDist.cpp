@@ -20,6 +20,7 @@
 #include "libstoch/regression/ContinuationValueGeners.h"
 #include "libstoch/regression/GridAndRegressedValue.h"
 #include "libstoch/regression/GridAndRegressedValueGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepMultiStageRegressionDPDist.h"
 #include "libstoch/core/parallelism/GridReach.h"
 
@@ -33,8 +34,9 @@ using namespace  std;
 TransitionStepMultiStageRegressionDPDist::TransitionStepMultiStageRegressionDPDist(const  shared_ptr<FullGrid> &p_pGridCurrent,
         const  shared_ptr<FullGrid> &p_pGridPrevious,
         const  shared_ptr<OptimizerMultiStageDPBase > &p_pOptimize,
-        const boost::mpi::communicator &p_world):
-    TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world), m_bDump(false)
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting):
+    TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world, p_splitting), m_bDump(false)
 {
     calParalDet();
 }
@@ -45,8 +47,9 @@ TransitionStepMultiStageRegressionDPDist::TransitionStepMultiStageRegressionDPDi
         const  std::shared_ptr<gs::BinaryFileArchive>   &p_arGen,
         const  std::string &p_nameDump,
         const  bool   &p_bOneFileDet,
-        const boost::mpi::communicator &p_world):
-    TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world),
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting):
+    TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world, p_splitting),
     m_arGen(p_arGen), m_nameDump(p_nameDump), m_bOneFileDet(p_bOneFileDet), m_bDump(true)
 {
     calParalDet();
@@ -58,7 +61,7 @@ void TransitionStepMultiStageRegressionDPDist::calParalDet()
     // initial and previous dimensions
     ArrayXi initialDimension   = m_pGridCurrent->getDimensions();
     // organize the hypercube splitting for parallel
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+    ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
     // cone value
     function < SubMeshIntCoord(const SubMeshIntCoord &) > fMesh = GridReach<OptimizerBase>(m_pGridCurrent, m_pGridCurrent, m_pOptimize);
     // ParallelComputeGridsSplitting objects
@@ -98,10 +101,12 @@ void TransitionStepMultiStageRegressionDPDist::oneStageInStep(const vector< shar
     if (m_gridCurrentProc->getNbPoints() > 0)
     {
         //  create continuation values on extended grid
+        InstrumentationTimer timerRegression(instRegression);
         vector<shared_ptr<ContinuationValue> > contVal(p_phiIn.size());
         // stochastic
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
             contVal[iReg] = make_shared<ContinuationValue>(p_pGridPrevTransExtended, p_condExp, *phiInExtended[iReg]);
+        timerRegression.stop();
 
 
         // number of thread
@@ -113,6 +118,7 @@ void TransitionStepMultiStageRegressionDPDist::oneStageInStep(const vector< shar
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -123,6 +129,7 @@ void TransitionStepMultiStageRegressionDPDist::oneStageInStep(const vector< shar
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_gridCurrentProc->getGridIterator();
 
                 // account fo threads
@@ -135,6 +142,7 @@ void TransitionStepMultiStageRegressionDPDist::oneStageInStep(const vector< shar
 
                     // optimize the current point and the set of regimes
                     ArrayXXd solution = std::static_pointer_cast<OptimizerMultiStageDPBase>(m_pOptimize)->stepOptimize(p_pGridPrevTransExtended, pointCoord, contVal, phiInExtended);
+                    instThread.countOptimize();
                     // copie solution
                     for (int iReg = 0; iReg < nbDetRegimes; ++iReg)
                         (*p_phiOut[iReg]).col(iterGridPoint->getCount()) = solution.col(iReg);
@@ -147,6 +155,7 @@ void TransitionStepMultiStageRegressionDPDist::oneStageInStep(const vector< shar
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
     }
 
 }
@@ -154,6 +163,7 @@ void TransitionStepMultiStageRegressionDPDist::oneStageInStep(const vector< shar
 vector< shared_ptr< ArrayXXd > > TransitionStepMultiStageRegressionDPDist::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< BaseRegression>  &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepMultiStageRegressionDPDist");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     // number of deterministic regimes
@@ -223,6 +233,7 @@ void TransitionStepMultiStageRegressionDPDist::dumpContinuationValues(shared_ptr
         const  shared_ptr<BaseRegression>    &p_condExp,
         const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimensionPrev  = m_pGridPrevious->getDimensions();
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
@@ -261,7 +272,7 @@ void TransitionStepMultiStageRegressionDPDist::dumpContinuationValues(shared_ptr
             gridOnProc0Prev(id)[0] = 0 ;
             gridOnProc0Prev(id)[1] = initialDimensionPrev(id) ;
         }
-        ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObjectPrev(initialDimensionPrev, splittingRatioPrev, m_world);
         vector< GridAndRegressedValue> contVal(p_phiInPrev.size());
         for (size_t iReg = 0; iReg < p_phiInPrev.size(); ++iReg)
@@ -286,6 +297,7 @@ void TransitionStepMultiStageRegressionDPDist::dumpContinuationDetValues(const v
         const  shared_ptr<BaseRegression>    &p_condExp,
         const int &p_iPeriod) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iPeriod);
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
     if (!m_bOneFileDet)
@@ -319,7 +331,7 @@ void TransitionStepMultiStageRegressionDPDist::dumpContinuationDetValues(const v
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< GridAndRegressedValue> contVal(p_phiInPrev.size());
         for (size_t iReg = 0; iReg < p_phiInPrev.size(); ++iReg)
@@ -346,6 +358,7 @@ void TransitionStepMultiStageRegressionDPDist::dumpBellmanValues(shared_ptr<gs::
         const  shared_ptr<BaseRegression>    &p_condExp,
         const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
     if (!p_bOneFile)
@@ -379,7 +392,7 @@ void TransitionStepMultiStageRegressionDPDist::dumpBellmanValues(shared_ptr<gs::
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< GridAndRegressedValue> bellVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
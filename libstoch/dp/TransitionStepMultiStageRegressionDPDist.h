@@ -69,7 +69,8 @@ public :
     TransitionStepMultiStageRegressionDPDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent,
             const  std::shared_ptr<FullGrid> &p_pGridPrevious,
             const  std::shared_ptr<OptimizerMultiStageDPBase > &p_pOptimize,
-            const boost::mpi::communicator &p_world);
+            const boost::mpi::communicator &p_world,
+            const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief Constructor with archive dump
     TransitionStepMultiStageRegressionDPDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent,
@@ -78,7 +79,8 @@ public :
             const  std::shared_ptr<gs::BinaryFileArchive>   &p_arGen,
             const  std::string &p_nameDump,
             const  bool   &p_bOneFileDet,
-            const  boost::mpi::communicator &p_world);
+            const  boost::mpi::communicator &p_world,
+            const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief One step for optimization
     /// \param p_phiIn      for each regime the function value  ( nb simulation, nb stocks )
@@ -6,14 +6,17 @@
 #include "geners/Record.hh"
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
+#include "libstoch/core/parallelism/NodeSharedArray.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
 #include "libstoch/core/utils/OpenmpException.h"
 #endif
 #include "libstoch/core/grids/GridIterator.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepRegressionDP.h"
+#include "libstoch/dp/ChunkedRegressedValues.h"
 #include "libstoch/regression/ContinuationValue.h"
 #include "libstoch/regression/ContinuationValueGeners.h"
 #include "libstoch/regression/GridAndRegressedValue.h"
@@ -42,6 +45,7 @@ TransitionStepRegressionDP::TransitionStepRegressionDP(const  shared_ptr<FullGri
 pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > TransitionStepRegressionDP::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< BaseRegression>     &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepRegressionDP");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -81,11 +85,14 @@ pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > Tran
         int nbThreads = 1;
 #endif
         //  create continuation values
+        InstrumentationTimer timerRegression(instRegression);
         vector< ContinuationValue > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
             contVal[iReg] = ContinuationValue(m_pGridPrevious, p_condExp, *p_phiIn[iReg]);
+        timerRegression.stop();
 
         // create iterator on current grid treated for processor
+        InstrumentationTimer timerOptimize(instOptimize);
         int iThread = 0 ;
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
@@ -97,6 +104,7 @@ pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > Tran
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator >  iterGridPoint = m_pGridCurrent->getGridIterator();
                 // account for mpi and threads
 #ifdef USE_MPI
@@ -110,6 +118,7 @@ pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > Tran
                     ArrayXd pointCoord = iterGridPoint->getCoordinate();
                     // optimize the current point and the set of regimes
                     pair< ArrayXXd, ArrayXXd>  solutionAndControl = m_pOptimize->stepOptimize(m_pGridPrevious, pointCoord, contVal, p_phiIn);
+                    instThread.countOptimize();
 #ifdef USE_MPI
                     // copie solution
                     int iposArray = iterGridPoint->getRelativePosition();
@@ -135,20 +144,26 @@ pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > Tran
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
 
 #ifdef USE_MPI
         ArrayXi ilocToGLobalGlob(nbPointsCur);
-        boost::mpi::all_gatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
-        ArrayXXd storeGlob(p_condExp->getNbSimul(), nbPointsCur);
+        allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+        // gathering buffer shared by the processors of a node : only exchanged between nodes
+        // the window is collectively allocated, so it is reused between steps and only reallocated when too small
+        size_t sizeGather = static_cast<size_t>(p_condExp->getNbSimul()) * nbPointsCur;
+        if (!m_storeShared || (m_storeShared->size() < sizeGather))
+            m_storeShared = make_shared< NodeSharedArray<double> >(m_world, sizeGather);
+        Map< const ArrayXXd > storeGlob(m_storeShared->data(), p_condExp->getNbSimul(), nbPointsCur);
         for (int iReg = 0; iReg < nbRegimes; ++iReg)
         {
-            boost::mpi::all_gatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
+            m_storeShared->allGatherv(phiOutLoc[iReg].data(), phiOutLoc[iReg].size());
             for (int ipos = 0; ipos < ilocToGLobalGlob.size(); ++ipos)
                 (*phiOut[iReg]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
         for (int iCont = 0 ; iCont < nbControl; ++iCont)
         {
-            boost::mpi::all_gatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
+            m_storeShared->allGatherv(controlOutLoc[iCont].data(), controlOutLoc[iCont].size());
             for (int ipos = 0; ipos <  ilocToGLobalGlob.size(); ++ipos)
                 (*controlOut[iCont]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
@@ -161,6 +176,7 @@ pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > Tran
 void TransitionStepRegressionDP::dumpContinuationValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const vector< shared_ptr< ArrayXXd > > &p_control, const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -180,9 +196,42 @@ void TransitionStepRegressionDP::dumpContinuationValues(shared_ptr<gs::BinaryFil
 #endif
 }
 
+void TransitionStepRegressionDP::dumpChunkedContinuationValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn,
+        const vector< shared_ptr< ArrayXXd > > &p_control, const  shared_ptr<BaseRegression>    &p_condExp,
+        const ArrayXi &p_chunkSize) const
+{
+    InstrumentationTimer timerIO(instIO);
+#ifdef USE_MPI
+    if (m_world.rank() == 0)
+    {
+#endif
+        string stepString = boost::lexical_cast<string>(p_iStep) ;
+        // store regressor
+        *p_ar <<  gs::Record(dynamic_cast<const BaseRegression &>(*p_condExp), "regressor", stepString.c_str()) ;
+        vector<ArrayXXd> regressedValues(p_phiIn.size());
+        for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
+        {
+            ArrayXXd transposeCont = p_phiIn[iReg]->transpose();
+            regressedValues[iReg] = p_condExp->getCoordBasisFunctionMultiple(transposeCont).transpose();
+        }
+        ChunkedRegressedValues::dump(*p_ar, p_name + "Values", p_iStep, m_pGridPrevious, regressedValues, p_chunkSize);
+        vector<ArrayXXd> contValues(p_control.size());
+        for (size_t iCont = 0; iCont < p_control.size(); ++iCont)
+        {
+            ArrayXXd transposeCont = p_control[iCont]->transpose();
+            contValues[iCont] = p_condExp->getCoordBasisFunctionMultiple(transposeCont).transpose();
+        }
+        ChunkedRegressedValues::dump(*p_ar, p_name + "Control", p_iStep, m_pGridCurrent, contValues, p_chunkSize);
+        p_ar->flush() ; // necessary for python mapping
+#ifdef USE_MPI
+    }
+#endif
+}
+
 void TransitionStepRegressionDP::dumpBellmanValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
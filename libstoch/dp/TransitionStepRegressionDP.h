@@ -9,6 +9,7 @@
 #include <memory>
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
+#include "libstoch/core/parallelism/NodeSharedArray.h"
 #endif
 #include <Eigen/Dense>
 #include "geners/BinaryFileArchive.hh"
@@ -38,6 +39,7 @@ private :
     std::shared_ptr<OptimizerDPBase  >  m_pOptimize ; ///< optimizer solving the problem for one point and one step
 #ifdef USE_MPI
     boost::mpi::communicator  m_world; ///< Mpi communicator
+    mutable std::shared_ptr< NodeSharedArray<double> > m_storeShared ; ///< gathering buffer shared by the processors of a node (allocated at first use, enlarged if needed)
 #endif
 
 public :
@@ -47,6 +49,10 @@ public :
     virtual ~TransitionStepRegressionDP() {}
 
     /// \brief Constructor
+    /// \param p_pGridCurrent   grid at current time step
+    /// \param p_pGridPrevious  grid at previous time step
+    /// \param p_pOptimize      optimizer object
+    /// \param p_world          MPI communicator
     TransitionStepRegressionDP(const  std::shared_ptr<FullGrid> &p_pGridCurrent,
                                const  std::shared_ptr<FullGrid> &p_pGridPrevious,
                                const  std::shared_ptr<OptimizerDPBase > &p_pOptimize
@@ -55,6 +61,23 @@ public :
 #endif
                               );
 
+#ifdef USE_MPI
+    /// \brief Use a gathering buffer shared by the processors of a node kept from a previous time step (see getStoreShared).
+    ///        If not set, it is allocated at the first step.
+    /// \param p_storeShared  gathering buffer
+    inline void setStoreShared(const std::shared_ptr< NodeSharedArray<double> > &p_storeShared)
+    {
+        m_storeShared = p_storeShared;
+    }
+
+    /// \brief Gathering buffer used by the last step : give it to the transition object of the next time step
+    ///        to avoid the allocation of a new shared window at each step
+    inline std::shared_ptr< NodeSharedArray<double> > getStoreShared() const
+    {
+        return m_storeShared;
+    }
+#endif
+
 
     /// \brief One step for dynamic programming in optimization
     /// \param p_phiIn      for each regime the function value ( nb simulation, nb stocks )
@@ -75,6 +98,20 @@ public :
                                 const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_control, const  std::shared_ptr<BaseRegression>    &p_condExp) const;
 
 
+    /// \brief Permits to dump continuation values and controls on archive by blocks of grid points
+    ///        (see ChunkedRegressedValues). Simulation can then read only the blocks around the simulated stocks.
+    ///        Records are compressed if the archive is opened with a compression mode (for example "w:z=z")
+    /// \param p_ar                   archive to dump in
+    /// \param p_name                 name used for object
+    /// \param p_iStep                Step number or identifier for time step
+    /// \param p_phiIn                for each regime the function value ( nb simulation ,nb stocks)
+    /// \param p_control              Optimal control ( nb simulation ,nb stocks) for each control
+    /// \param p_condExp              conditional expectation operator
+    /// \param p_chunkSize            number of meshes of a block in each dimension
+    void dumpChunkedContinuationValues(std::shared_ptr<gs::BinaryFileArchive> p_ar, const std::string &p_name, const int &p_iStep, const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_phiIn,
+                                       const std::vector< std::shared_ptr< Eigen::ArrayXXd > > &p_control, const  std::shared_ptr<BaseRegression>    &p_condExp,
+                                       const Eigen::ArrayXi &p_chunkSize) const;
+
     /// \brief Permits to dump Bellman values on archive
     /// \param p_ar                   archive to dump in
     /// \param p_name                 name used for object
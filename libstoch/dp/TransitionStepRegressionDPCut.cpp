@@ -4,12 +4,13 @@
 #include "geners/Record.hh"
 #ifdef USE_MPI
 #include "boost/mpi.hpp"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
 #include "libstoch/core/utils/OpenmpException.h"
 #endif
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepRegressionDPCut.h"
 #include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/regression/ContinuationCuts.h"
@@ -40,6 +41,7 @@ TransitionStepRegressionDPCut::TransitionStepRegressionDPCut(const  shared_ptr<F
 vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCut::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< BaseRegression>     &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepRegressionDPCut");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >   phiOut(nbRegimes);
@@ -74,12 +76,15 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCut::oneStep(const v
         int nbThreads = 1;
 #endif
         //  create continuation values
+        InstrumentationTimer timerRegression(instRegression);
         vector< ContinuationCuts > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
             contVal[iReg] = ContinuationCuts(m_pGridPrevious, p_condExp, *p_phiIn[iReg]);
+        timerRegression.stop();
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -90,6 +95,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCut::oneStep(const v
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator >  iterGridPoint = m_pGridCurrent->getGridIterator();
                 // account for mpi and threads
 #ifdef USE_MPI
@@ -103,6 +109,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCut::oneStep(const v
                     ArrayXd pointCoord = iterGridPoint->getCoordinate();
                     // optimize the current point and the set of regimes -> get back cuts per simulation and stock point
                     ArrayXXd   solution = m_pOptimize->stepOptimize(m_pGridPrevious, pointCoord, contVal);
+                    instThread.countOptimize();
 #ifdef USE_MPI
                     // copie solution
                     int iposArray = iterGridPoint->getRelativePosition();
@@ -125,14 +132,15 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCut::oneStep(const v
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
 
 #ifdef USE_MPI
         ArrayXi ilocToGLobalGlob(nbPointsCur);
-        boost::mpi::all_gatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+        allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
         ArrayXXd storeGlob(p_condExp->getNbSimul() * (m_pGridCurrent->getDimension() + 1), nbPointsCur);
         for (int iReg = 0; iReg < nbRegimes; ++iReg)
         {
-            boost::mpi::all_gatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
+            allGatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
             for (int ipos = 0; ipos < ilocToGLobalGlob.size(); ++ipos)
                 (*phiOut[iReg]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
@@ -144,6 +152,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCut::oneStep(const v
 
 void TransitionStepRegressionDPCut::dumpContinuationCutsValues(std::shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn, const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -162,6 +171,7 @@ void TransitionStepRegressionDPCut::dumpContinuationCutsValues(std::shared_ptr<g
 
 void TransitionStepRegressionDPCut::dumpBellmanCutsValues(std::shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn, const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -16,6 +16,7 @@
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/regression/ContinuationCuts.h"
 #include "libstoch/regression/ContinuationCutsGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepRegressionDPCutDist.h"
 #include "libstoch/core/parallelism/GridReach.h"
 
@@ -29,12 +30,14 @@ using namespace  std;
 TransitionStepRegressionDPCutDist::TransitionStepRegressionDPCutDist(const  shared_ptr<FullGrid> &p_pGridCurrent,
         const  shared_ptr<FullGrid> &p_pGridPrevious,
         const  shared_ptr<OptimizerDPCutBase > &p_pOptimize,
-        const boost::mpi::communicator &p_world): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world) {}
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world, p_splitting) {}
 
 
 vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCutDist::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< BaseRegression>  &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepRegressionDPCutDist");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -59,9 +62,11 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCutDist::oneStep(con
             phiOut[iReg] = make_shared< ArrayXXd >(p_condExp->getNbSimul() * (m_pGridCurrent->getDimension() + 1), m_gridCurrentProc->getNbPoints());
 
         //  create continuation values on extended grid
+        InstrumentationTimer timerRegression(instRegression);
         vector< ContinuationCuts > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
             contVal[iReg] = ContinuationCuts(m_gridExtendPreviousStep, p_condExp, *phiInExtended[iReg]);
+        timerRegression.stop();
 
 
         // number of thread
@@ -73,6 +78,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCutDist::oneStep(con
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -83,6 +89,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCutDist::oneStep(con
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_gridCurrentProc->getGridIterator();
 
                 // account fo threads
@@ -95,6 +102,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCutDist::oneStep(con
 
                     // optimize the current point and the set of regimes -> get back cuts per simulation and stock point
                     ArrayXXd  solution = static_pointer_cast<OptimizerDPCutBase>(m_pOptimize)->stepOptimize(m_gridExtendPreviousStep, pointCoord, contVal);
+                    instThread.countOptimize();
                     // copie solution
                     for (int iReg = 0; iReg < nbRegimes; ++iReg)
                         (*phiOut[iReg]).col(iterGridPoint->getCount()) = solution.col(iReg);
@@ -107,6 +115,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionDPCutDist::oneStep(con
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
     }
     return phiOut;
 }
@@ -116,6 +125,7 @@ void TransitionStepRegressionDPCutDist::dumpContinuationCutsValues(shared_ptr<gs
         const  shared_ptr<BaseRegression>    &p_condExp,
         const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimensionPrev  = m_pGridPrevious->getDimensions();
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
@@ -174,7 +184,7 @@ void TransitionStepRegressionDPCutDist::dumpContinuationCutsValues(shared_ptr<gs
             gridOnProc0Prev(id)[0] = 0 ;
             gridOnProc0Prev(id)[1] = initialDimensionPrev(id) ;
         }
-        ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObjectPrev(initialDimensionPrev, splittingRatioPrev, m_world);
         vector< ContinuationCuts> contVal(p_phiInPrev.size());
         for (size_t iReg = 0; iReg < p_phiInPrev.size(); ++iReg)
@@ -200,6 +210,7 @@ void TransitionStepRegressionDPCutDist::dumpBellmanCutsValues(shared_ptr<gs::Bin
         const  shared_ptr<BaseRegression>    &p_condExp,
         const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
     if (!p_bOneFile)
@@ -253,7 +264,7 @@ void TransitionStepRegressionDPCutDist::dumpBellmanCutsValues(shared_ptr<gs::Bin
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< ContinuationCuts> contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
@@ -31,7 +31,8 @@ public :
     TransitionStepRegressionDPCutDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent,
                                       const  std::shared_ptr<FullGrid> &p_pGridPrevious,
                                       const  std::shared_ptr<OptimizerDPCutBase > &p_pOptimize,
-                                      const boost::mpi::communicator &p_world);
+                                      const boost::mpi::communicator &p_world,
+                                      const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief One step for dynamic programming in optimization
     /// \param p_phiIn      for each regime the function cut value ( (nb simulation * nb cuts), nb stocks ) coming from next step
@@ -20,6 +20,7 @@
 #include "libstoch/regression/ContinuationValueGeners.h"
 #include "libstoch/regression/GridAndRegressedValue.h"
 #include "libstoch/regression/GridAndRegressedValueGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepRegressionDPDist.h"
 #include "libstoch/core/parallelism/GridReach.h"
 
@@ -33,12 +34,14 @@ using namespace  std;
 TransitionStepRegressionDPDist::TransitionStepRegressionDPDist(const  shared_ptr<FullGrid> &p_pGridCurrent,
         const  shared_ptr<FullGrid> &p_pGridPrevious,
         const  shared_ptr<OptimizerDPBase > &p_pOptimize,
-        const boost::mpi::communicator &p_world): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world) {}
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world, p_splitting) {}
 
 
 pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > > TransitionStepRegressionDPDist::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
                                    const shared_ptr< BaseRegression>  &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepRegressionDPDist");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -67,9 +70,11 @@ pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > > Trans
             controlOut[iCont] = make_shared< ArrayXXd >(p_condExp->getNbSimul(), m_gridCurrentProc->getNbPoints());
 
         //  create continuation values on extended grid
+        InstrumentationTimer timerRegression(instRegression);
         vector< ContinuationValue > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
             contVal[iReg] = ContinuationValue(m_gridExtendPreviousStep, p_condExp, *phiInExtended[iReg]);
+        timerRegression.stop();
         // number of thread
 #ifdef _OPENMP
         int nbThreads = omp_get_max_threads();
@@ -79,6 +84,7 @@ pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > > Trans
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -89,6 +95,7 @@ pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > > Trans
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_gridCurrentProc->getGridIterator();
 
                 // account fo threads
@@ -101,6 +108,7 @@ pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > > Trans
 
                     // optimize the current point and the set of regimes
                     pair< ArrayXXd, ArrayXXd>  solutionAndControl = static_pointer_cast<OptimizerDPBase>(m_pOptimize)->stepOptimize(m_gridExtendPreviousStep, pointCoord, contVal, phiInExtended);
+                    instThread.countOptimize();
                     // copie solution
                     for (int iReg = 0; iReg < nbRegimes; ++iReg)
                         (*phiOut[iReg]).col(iterGridPoint->getCount()) = solutionAndControl.first.col(iReg);
@@ -115,6 +123,7 @@ pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > > Trans
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
     }
     return make_pair(phiOut, controlOut);
 }
@@ -124,6 +133,7 @@ void TransitionStepRegressionDPDist::dumpContinuationValues(shared_ptr<gs::Binar
         const  shared_ptr<BaseRegression>    &p_condExp,
         const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimensionPrev  = m_pGridPrevious->getDimensions();
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
@@ -172,7 +182,7 @@ void TransitionStepRegressionDPDist::dumpContinuationValues(shared_ptr<gs::Binar
             gridOnProc0Prev(id)[0] = 0 ;
             gridOnProc0Prev(id)[1] = initialDimensionPrev(id) ;
         }
-        ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObjectPrev(initialDimensionPrev, splittingRatioPrev, m_world);
         vector< GridAndRegressedValue> contVal(p_phiInPrev.size());
         for (size_t iReg = 0; iReg < p_phiInPrev.size(); ++iReg)
@@ -194,7 +204,7 @@ void TransitionStepRegressionDPDist::dumpContinuationValues(shared_ptr<gs::Binar
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< GridAndRegressedValue > control(p_control.size());
         for (size_t iCont = 0; iCont < p_control.size(); ++iCont)
@@ -219,6 +229,7 @@ void TransitionStepRegressionDPDist::dumpBellmanValues(shared_ptr<gs::BinaryFile
         const  shared_ptr<BaseRegression>    &p_condExp,
         const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
     if (!p_bOneFile)
@@ -252,7 +263,7 @@ void TransitionStepRegressionDPDist::dumpBellmanValues(shared_ptr<gs::BinaryFile
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< GridAndRegressedValue> bellVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
@@ -38,7 +38,8 @@ public :
     TransitionStepRegressionDPDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent,
                                    const  std::shared_ptr<FullGrid> &p_pGridPrevious,
                                    const  std::shared_ptr<OptimizerDPBase > &p_pOptimize,
-                                   const boost::mpi::communicator &p_world);
+                                   const boost::mpi::communicator &p_world,
+                                   const SplittingFunction &p_splitting = paraOptimalSplitting);
 
 
     /// \brief One step for optimization
@@ -4,7 +4,7 @@
 #include <memory>
 #ifdef USE_MPI
 #include "boost/mpi.hpp"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
@@ -12,6 +12,7 @@
 #endif
 #include "geners/Record.hh"
 #include "libstoch/core/grids/SparseGridIterator.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepRegressionDPSparse.h"
 #include "libstoch/regression/ContinuationValue.h"
 #include "libstoch/regression/ContinuationValueGeners.h"
@@ -41,6 +42,7 @@ TransitionStepRegressionDPSparse::TransitionStepRegressionDPSparse(const  shared
 std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > TransitionStepRegressionDPSparse::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< BaseRegression>     &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepRegressionDPSparse");
     int rank = 0 ;
     int nbProc = 1;
     int nbSimul =  p_condExp->getNbSimul();
@@ -58,29 +60,26 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
     int nRestSim = nbSimul % nbProc;
     int iFirstSim = rank * nsimPProc + (rank < nRestSim ? rank : nRestSim);
     int iLastSim  = iFirstSim + nsimPProc + (rank < nRestSim ? 1 : 0);
+    InstrumentationTimer timerRegression(instRegression);
     for (int iReg = 0; iReg <  nbRegimes; ++iReg)
     {
         cashHierar[iReg] = make_shared<ArrayXXd>(p_phiIn[iReg]->rows(), p_phiIn[iReg]->cols());
-        ArrayXXd valHierar(p_phiIn[iReg]->cols(), iLastSim - iFirstSim);
-        ArrayXd valHierarCol(p_phiIn[iReg]->cols());
-        for (int is = iFirstSim; is < iLastSim; ++is)
-        {
-            // Hierarchize
-            valHierarCol = p_phiIn[iReg]->row(is).transpose();
-            m_pGridPrevious->toHierarchize(valHierarCol);
-            valHierar.col(is - iFirstSim)  = valHierarCol;
-        }
+        // Hierarchize by blocks of simulations
+        ArrayXXd simHierar = p_phiIn[iReg]->middleRows(iFirstSim, iLastSim - iFirstSim);
+        m_pGridPrevious->toHierarchizeVecByBlock(simHierar);
+        ArrayXXd valHierar = simHierar.transpose();
 #ifdef USE_MPI
         if (m_world.size() > 1)
         {
             ArrayXXd valHierarShared(p_phiIn[iReg]->cols(), nbSimul);
-            boost::mpi::all_gatherv<double>(m_world, valHierar.data(), valHierar.size(), valHierarShared.data());
+            allGatherv<double>(m_world, valHierar.data(), valHierar.size(), valHierarShared.data());
             *cashHierar[iReg] = valHierarShared.transpose();
         }
         else
 #endif
             *cashHierar[iReg] = valHierar.transpose();
     }
+    timerRegression.stop();
     int nbControl =  m_pOptimize->getNbControl();
     vector< shared_ptr< ArrayXXd > >  controlOut(nbControl);
     // only if the processor is working
@@ -94,6 +93,7 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
         int nbThreads = 1;
 #endif
         //  create continuation values on Hierarchical values
+        InstrumentationTimer timerRegressionCont(instRegression);
         vector< ContinuationValue > contVal(p_phiIn.size());
         int nbPointsPrev = m_pGridPrevious->getNbPoints();
         int npointPProcPrev = (int)(nbPointsPrev / nbProc);
@@ -108,20 +108,17 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
             {
                 ArrayXXd regressedShared(regressed.cols(), nbPointsPrev);
                 ArrayXXd regrTranspose = regressed.transpose();
-                boost::mpi::all_gatherv<double>(m_world, regrTranspose.data(), regrTranspose.size(), regressedShared.data());
+                allGatherv<double>(m_world, regrTranspose.data(), regrTranspose.size(), regressedShared.data());
                 regressed = regressedShared.transpose();
             }
 #endif
-            // don't parallelize because hierarchize the regression coefficients and not the simulations
-            ArrayXd vHierarLoc(regressed.cols());
-            for (int iFonc = 0 ; iFonc < regressed.cols(); ++iFonc)
-            {
-                vHierarLoc = regressed.col(iFonc);
-                m_pGridPrevious->toHierarchize(vHierarLoc);
-                regressed.col(iFonc) = vHierarLoc;
-            }
-            contVal[iReg].loadForSimulation(m_pGridPrevious, p_condExp, regressed.transpose());
+            // hierarchize the regression coefficients : each basis function is a function on the grid.
+            // The basis functions are far less numerous than the simulations, but the blocks are sized to still give work to each thread
+            ArrayXXd regressedHierar = regressed.transpose();
+            m_pGridPrevious->toHierarchizeVecByBlock(regressedHierar);
+            contVal[iReg].loadForSimulation(m_pGridPrevious, p_condExp, regressedHierar);
         }
+        timerRegressionCont.stop();
 
         //  allocate for solution
 #ifdef USE_MPI
@@ -144,6 +141,7 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -154,6 +152,7 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_pGridCurrent->getGridIterator();
                 // account for mpi and threads
 #ifdef USE_MPI
@@ -167,6 +166,7 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
                     ArrayXd pointCoord = iterGridPoint->getCoordinate();
                     // optimize the current point and the set of regimes
                     std::pair< ArrayXXd, ArrayXXd>  solutionAndControl = m_pOptimize->stepOptimize(m_pGridPrevious, pointCoord, contVal, cashHierar);
+                    instThread.countOptimize();
                     // copie solution
 #ifdef USE_MPI
                     int iposArray = iterGridPoint->getRelativePosition();
@@ -190,20 +190,21 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
 
 #ifdef USE_MPI
         ArrayXi ilocToGLobalGlob(nbPointsCur);
-        boost::mpi::all_gatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+        allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
         ArrayXXd storeGlob(p_condExp->getNbSimul(), nbPointsCur);
         for (int iReg = 0; iReg < nbRegimes; ++iReg)
         {
-            boost::mpi::all_gatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
+            allGatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
             for (int ipos = 0; ipos < ilocToGLobalGlob.size(); ++ipos)
                 (*phiOut[iReg]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
         for (int iCont = 0 ; iCont < nbControl; ++iCont)
         {
-            boost::mpi::all_gatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
+            allGatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
             for (int ipos = 0; ipos <  ilocToGLobalGlob.size(); ++ipos)
                 (*controlOut[iCont]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
@@ -215,6 +216,7 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
 void TransitionStepRegressionDPSparse::dumpContinuationValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const vector< shared_ptr< ArrayXXd > > &p_control, const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
     int nbProc = 1;
     int rank = 0 ;
 #ifdef USE_MPI
@@ -238,7 +240,7 @@ void TransitionStepRegressionDPSparse::dumpContinuationValues(shared_ptr<gs::Bin
         {
             ArrayXXd regressedShared(regressed.cols(), nbPoints);
             ArrayXXd regrTranspose = regressed.transpose();
-            boost::mpi::all_gatherv<double>(m_world, regrTranspose.data(), regrTranspose.size(), regressedShared.data());
+            allGatherv<double>(m_world, regrTranspose.data(), regrTranspose.size(), regressedShared.data());
             regressed = regressedShared.transpose();
         }
 #endif
@@ -269,7 +271,7 @@ void TransitionStepRegressionDPSparse::dumpContinuationValues(shared_ptr<gs::Bin
         {
             ArrayXXd regressedShared(contRegressed.cols(), nbPoints);
             ArrayXXd regrTranspose = contRegressed.transpose();
-            boost::mpi::all_gatherv<double>(m_world, regrTranspose.data(), regrTranspose.size(), regressedShared.data());
+            allGatherv<double>(m_world, regrTranspose.data(), regrTranspose.size(), regressedShared.data());
             contRegressed = regressedShared.transpose();
         }
 #endif
@@ -3,7 +3,7 @@
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
 #ifndef TRANSITIONSTEPREGRESSIONDPSPARSE_H
 #define TRANSITIONSTEPREGRESSIONDPSPARSE_H
-#ifdef OMP
+#ifdef _OPENMP
 #include <omp.h>
 #endif
 #ifdef USE_MPI
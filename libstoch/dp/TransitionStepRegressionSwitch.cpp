@@ -6,7 +6,7 @@
 #include "geners/Record.hh"
 #ifdef USE_MPI
 #include "boost/mpi.hpp"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
@@ -15,6 +15,7 @@
 #include "libstoch/core/grids/FullRegularIntGridIterator.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/regression/BaseRegressionGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepRegressionSwitch.h"
 #include "libstoch/dp/OptimizerSwitchBase.h"
 
@@ -42,6 +43,7 @@ TransitionStepRegressionSwitch::TransitionStepRegressionSwitch(const  vector< sh
 vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionSwitch::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< BaseRegression>     &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepRegressionSwitch");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -76,6 +78,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionSwitch::oneStep(const
 #endif
             // create iterator on current grid treated for processor
             int iThread = 0 ;
+            InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
             OpenmpException excep; // deal with exception in openmp
             #pragma omp parallel for  private(iThread)
@@ -86,6 +89,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionSwitch::oneStep(const
                 excep.run([&]
                 {
 #endif
+                    InstrumentationThread instThread;
                     FullRegularIntGridIterator  iterGridPoint = m_pGridCurrent[iReg]->getGridIterator();
                     // account for mpi and threads
 #ifdef USE_MPI
@@ -99,6 +103,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionSwitch::oneStep(const
                         ArrayXi pointCoord = iterGridPoint.getIntCoordinate();
                         // optimize the current point and the set of regimes
                         ArrayXd  solution = m_pOptimize->stepOptimize(m_pGridPrevious, iReg, pointCoord, p_condExp, p_phiIn);
+                        instThread.countOptimize();
 #ifdef USE_MPI
                         // copie solution
                         int iposArray = iterGridPoint.getRelativePosition();
@@ -118,12 +123,13 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionSwitch::oneStep(const
 #ifdef _OPENMP
             excep.rethrow();
 #endif
+            timerOptimize.stop();
 
 #ifdef USE_MPI
             ArrayXi ilocToGLobalGlob(nbPointsCur);
-            boost::mpi::all_gatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+            allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
             ArrayXXd storeGlob(p_condExp->getNbSimul(), nbPointsCur);
-            boost::mpi::all_gatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
+            allGatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
             for (int ipos = 0; ipos < ilocToGLobalGlob.size(); ++ipos)
                 (*phiOut[iReg]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
 #endif
@@ -135,6 +141,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepRegressionSwitch::oneStep(const
 
 void TransitionStepRegressionSwitch::dumpContinuationValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXXd > > &p_phiIn, const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -20,6 +20,7 @@
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/regression/BaseRegressionGeners.h"
 #include "libstoch/dp/OptimizerSwitchBase.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepRegressionSwitchDist.h"
 
 
@@ -94,6 +95,7 @@ TransitionStepRegressionSwitchDist::TransitionStepRegressionSwitchDist(const  ve
 vector< shared_ptr< ArrayXXd >>  TransitionStepRegressionSwitchDist::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
                              const shared_ptr< BaseRegression>  &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepRegressionSwitchDist");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -132,6 +134,7 @@ vector< shared_ptr< ArrayXXd >>  TransitionStepRegressionSwitchDist::oneStep(con
 
             // create iterator on current grid treated for processor
             int iThread = 0 ;
+            InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
             OpenmpException excep; // deal with exception in openmp
             #pragma omp parallel for  private(iThread)
@@ -142,6 +145,7 @@ vector< shared_ptr< ArrayXXd >>  TransitionStepRegressionSwitchDist::oneStep(con
                 excep.run([&]
                 {
 #endif
+                    InstrumentationThread instThread;
                     FullRegularIntGridIterator  iterGridPoint = m_gridCurrentProc[iReg]->getGridIterator();
 
                     // account fo threads
@@ -154,6 +158,7 @@ vector< shared_ptr< ArrayXXd >>  TransitionStepRegressionSwitchDist::oneStep(con
 
                         // optimize the current point and the set of regimes
                         ArrayXd  solution = m_pOptimize->stepOptimize(m_gridExtendPreviousStep, iReg, pointCoord, p_condExp, phiInExtended);
+                        instThread.countOptimize();
                         // copie solution
                         (*phiOut[iReg]).col(iterGridPoint.getCount()) = solution;
                         iterGridPoint.nextInc(nbThreads);
@@ -165,6 +170,7 @@ vector< shared_ptr< ArrayXXd >>  TransitionStepRegressionSwitchDist::oneStep(con
 #ifdef _OPENMP
             excep.rethrow();
 #endif
+            timerOptimize.stop();
         }
     }
     return phiOut;
@@ -174,6 +180,7 @@ void TransitionStepRegressionSwitchDist::dumpContinuationValues(shared_ptr<gs::B
         const vector< shared_ptr< ArrayXXd > > &p_phiInPrev,
         const  shared_ptr<BaseRegression>    &p_condExp) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     vector< Array< bool, Dynamic, 1> > dimToSplit = m_pOptimize->getDimensionToSplit();
 
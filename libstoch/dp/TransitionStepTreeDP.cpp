@@ -5,13 +5,14 @@
 #include "geners/Record.hh"
 #ifdef USE_MPI
 #include "boost/mpi.hpp"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
 #include "libstoch/core/utils/OpenmpException.h"
 #endif
 #include "libstoch/core/grids/GridIterator.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepTreeDP.h"
 #include "libstoch/tree/ContinuationValueTree.h"
 #include "libstoch/tree/ContinuationValueTreeGeners.h"
@@ -41,6 +42,7 @@ TransitionStepTreeDP::TransitionStepTreeDP(const  shared_ptr<FullGrid> &p_pGridC
 std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > > TransitionStepTreeDP::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< Tree>     &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepTreeDP");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -80,14 +82,17 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
         int nbThreads = 1;
 #endif
         //  create continuation values
+        InstrumentationTimer timerRegression(instRegression);
         vector< ContinuationValueTree > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
         {
             contVal[iReg] = ContinuationValueTree(m_pGridPrevious, p_condExp, *p_phiIn[iReg]);
         }
+        timerRegression.stop();
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -98,6 +103,7 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator >  iterGridPoint = m_pGridCurrent->getGridIterator();
                 // account for mpi and threads
 #ifdef USE_MPI
@@ -111,6 +117,7 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
                     ArrayXd pointCoord = iterGridPoint->getCoordinate();
                     // optimize the current point and the set of regimes
                     std::pair< ArrayXXd, ArrayXXd>  solutionAndControl = m_pOptimize->stepOptimize(m_pGridPrevious, pointCoord, contVal);
+                    instThread.countOptimize();
 #ifdef USE_MPI
                     // copie solution
                     int iposArray = iterGridPoint->getRelativePosition();
@@ -136,20 +143,21 @@ std::pair< vector< shared_ptr< ArrayXXd > >, vector<  shared_ptr< ArrayXXd > > >
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
 
 #ifdef USE_MPI
         ArrayXi ilocToGLobalGlob(nbPointsCur);
-        boost::mpi::all_gatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+        allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
         ArrayXXd storeGlob(p_condExp->getNbNodes(), nbPointsCur);
         for (int iReg = 0; iReg < nbRegimes; ++iReg)
         {
-            boost::mpi::all_gatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
+            allGatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
             for (int ipos = 0; ipos < ilocToGLobalGlob.size(); ++ipos)
                 (*phiOut[iReg]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
         for (int iCont = 0 ; iCont < nbControl; ++iCont)
         {
-            boost::mpi::all_gatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
+            allGatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
             for (int ipos = 0; ipos <  ilocToGLobalGlob.size(); ++ipos)
                 (*controlOut[iCont]).col(ilocToGLobalGlob(ipos)) = storeGlob.col(ipos);
         }
@@ -164,6 +172,7 @@ void TransitionStepTreeDP::dumpContinuationValues(std::shared_ptr<gs::BinaryFile
         const vector< shared_ptr< ArrayXXd > > &p_control,
         const std::shared_ptr< Tree>     &p_tree) const
 {
+    InstrumentationTimer timerIO(instIO);
 #ifdef USE_MPI
     if (m_world.rank() == 0)
     {
@@ -171,7 +180,8 @@ void TransitionStepTreeDP::dumpContinuationValues(std::shared_ptr<gs::BinaryFile
         vector< GridTreeValue > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
         {
-            ArrayXXd  valExp = p_tree->expCondMultiple(p_phiIn[iReg]->transpose()).transpose();
+            ArrayXXd  valExp(p_tree->getNbNodes(), p_phiIn[iReg]->cols());
+            p_tree->expCondMultipleNodesInRows(*p_phiIn[iReg], valExp);
             contVal[iReg] = GridTreeValue(m_pGridPrevious, valExp);
         }
         string stepString = boost::lexical_cast<string>(p_iStep) ;
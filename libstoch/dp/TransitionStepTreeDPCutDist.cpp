@@ -16,6 +16,7 @@
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/tree/ContinuationCutsTree.h"
 #include "libstoch/tree/ContinuationCutsTreeGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepTreeDPCutDist.h"
 #include "libstoch/core/parallelism/GridReach.h"
 
@@ -29,12 +30,14 @@ using namespace  std;
 TransitionStepTreeDPCutDist::TransitionStepTreeDPCutDist(const  shared_ptr<FullGrid> &p_pGridCurrent,
         const  shared_ptr<FullGrid> &p_pGridPrevious,
         const  shared_ptr<OptimizerDPCutTreeBase > &p_pOptimize,
-        const boost::mpi::communicator &p_world): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world) {}
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world, p_splitting) {}
 
 
 vector< shared_ptr< ArrayXXd > >  TransitionStepTreeDPCutDist::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
         const shared_ptr< Tree>  &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepTreeDPCutDist");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -59,9 +62,11 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepTreeDPCutDist::oneStep(const vec
             phiOut[iReg] = make_shared< ArrayXXd >(p_condExp->getNbNodes() * (m_pGridCurrent->getDimension() + 1), m_gridCurrentProc->getNbPoints());
 
         //  create continuation values on extended grid
+        InstrumentationTimer timerRegression(instRegression);
         vector< ContinuationCutsTree > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
             contVal[iReg] = ContinuationCutsTree(m_gridExtendPreviousStep, p_condExp, *phiInExtended[iReg]);
+        timerRegression.stop();
 
 
         // number of thread
@@ -73,6 +78,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepTreeDPCutDist::oneStep(const vec
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -83,6 +89,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepTreeDPCutDist::oneStep(const vec
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_gridCurrentProc->getGridIterator();
 
                 // account fo threads
@@ -95,6 +102,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepTreeDPCutDist::oneStep(const vec
 
                     // optimize the current point and the set of regimes -> get back cuts per simulation and stock point
                     ArrayXXd  solution = static_pointer_cast<OptimizerDPCutTreeBase>(m_pOptimize)->stepOptimize(m_gridExtendPreviousStep, pointCoord, contVal);
+                    instThread.countOptimize();
                     // copie solution
                     for (int iReg = 0; iReg < nbRegimes; ++iReg)
                         (*phiOut[iReg]).col(iterGridPoint->getCount()) = solution.col(iReg);
@@ -107,6 +115,7 @@ vector< shared_ptr< ArrayXXd > >  TransitionStepTreeDPCutDist::oneStep(const vec
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
     }
     return phiOut;
 }
@@ -116,6 +125,7 @@ void TransitionStepTreeDPCutDist::dumpContinuationCutsValues(shared_ptr<gs::Bina
         const shared_ptr< Tree>     &p_condExp,
         const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimensionPrev  = m_pGridPrevious->getDimensions();
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
@@ -143,9 +153,9 @@ void TransitionStepTreeDPCutDist::dumpContinuationCutsValues(shared_ptr<gs::Bina
             {
                 for (int ic  = 0;  ic < nbCuts; ++ic)
                 {
-                    // size ( nbStock, (nb simul * nbCuts)
-                    ArrayXXd transposeCont = p_phiInPrev[iReg]->block(ic * nbNodes, 0, nbNodes, p_phiInPrev[iReg]->cols()). transpose();
-                    expValues[ic + nbCuts * iReg] = p_condExp->expCondMultiple(transposeCont).transpose();
+                    // values of the cut for all nodes (nb nodes, nb stocks)
+                    expValues[ic + nbCuts * iReg].resize(p_condExp->getNbNodes(), p_phiInPrev[iReg]->cols());
+                    p_condExp->expCondMultipleNodesInRows(p_phiInPrev[iReg]->block(ic * nbNodes, 0, nbNodes, p_phiInPrev[iReg]->cols()), expValues[ic + nbCuts * iReg]);
                 }
             }
             // for cut zero add stock components
@@ -175,7 +185,7 @@ void TransitionStepTreeDPCutDist::dumpContinuationCutsValues(shared_ptr<gs::Bina
             gridOnProc0Prev(id)[0] = 0 ;
             gridOnProc0Prev(id)[1] = initialDimensionPrev(id) ;
         }
-        ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObjectPrev(initialDimensionPrev, splittingRatioPrev, m_world);
         vector< ContinuationCutsTree> contVal(p_phiInPrev.size());
         for (size_t iReg = 0; iReg < p_phiInPrev.size(); ++iReg)
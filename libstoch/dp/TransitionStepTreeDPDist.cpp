@@ -18,6 +18,7 @@
 #include "libstoch/tree/ContinuationValueTreeGeners.h"
 #include "libstoch/tree/GridTreeValue.h"
 #include "libstoch/tree/GridTreeValueGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/dp/TransitionStepTreeDPDist.h"
 #include "libstoch/core/parallelism/GridReach.h"
 
@@ -31,12 +32,14 @@ using namespace  std;
 TransitionStepTreeDPDist::TransitionStepTreeDPDist(const  shared_ptr<FullGrid> &p_pGridCurrent,
         const  shared_ptr<FullGrid> &p_pGridPrevious,
         const  shared_ptr<OptimizerDPTreeBase > &p_pOptimize,
-        const boost::mpi::communicator &p_world): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize,  p_world) {}
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting): TransitionStepBaseDist(p_pGridCurrent, p_pGridPrevious, p_pOptimize, p_world, p_splitting) {}
 
 
 std::pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > > TransitionStepTreeDPDist::oneStep(const vector< shared_ptr< ArrayXXd > > &p_phiIn,
                                         const shared_ptr< Tree>  &p_condExp) const
 {
+    InstrumentationStep instStep("TransitionStepTreeDPDist");
     // number of regimes at current time
     int nbRegimes = m_pOptimize->getNbRegime();
     vector< shared_ptr< ArrayXXd > >  phiOut(nbRegimes);
@@ -65,9 +68,11 @@ std::pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > >
             controlOut[iCont] = make_shared< ArrayXXd >(p_condExp->getNbNodes(), m_gridCurrentProc->getNbPoints());
 
         //  create continuation values on extended grid
+        InstrumentationTimer timerRegression(instRegression);
         vector< ContinuationValueTree > contVal(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
             contVal[iReg] = ContinuationValueTree(m_gridExtendPreviousStep, p_condExp, *phiInExtended[iReg]);
+        timerRegression.stop();
 
 
         // number of thread
@@ -79,6 +84,7 @@ std::pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > >
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -89,6 +95,7 @@ std::pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > >
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_gridCurrentProc->getGridIterator();
 
                 // account fo threads
@@ -101,6 +108,7 @@ std::pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > >
 
                     // optimize the current point and the set of regimes
                     std::pair< ArrayXXd, ArrayXXd>  solutionAndControl = static_pointer_cast<OptimizerDPTreeBase>(m_pOptimize)->stepOptimize(m_gridExtendPreviousStep, pointCoord, contVal);
+                    instThread.countOptimize();
                     // copie solution
                     for (int iReg = 0; iReg < nbRegimes; ++iReg)
                         (*phiOut[iReg]).col(iterGridPoint->getCount()) = solutionAndControl.first.col(iReg);
@@ -115,6 +123,7 @@ std::pair< vector< shared_ptr< ArrayXXd >>, vector<  shared_ptr< ArrayXXd > > >
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
     }
     return make_pair(phiOut, controlOut);
 }
@@ -123,6 +132,7 @@ void TransitionStepTreeDPDist::dumpContinuationValues(shared_ptr<gs::BinaryFileA
         const vector< shared_ptr< ArrayXXd > > &p_phiInPrev,  const vector< shared_ptr< ArrayXXd > > &p_control,
         const std::shared_ptr< Tree>      &p_tree, const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimensionPrev  = m_pGridPrevious->getDimensions();
     ArrayXi initialDimension  =   m_pGridCurrent->getDimensions();
@@ -141,7 +151,8 @@ void TransitionStepTreeDPDist::dumpContinuationValues(shared_ptr<gs::BinaryFileA
         vector<ArrayXXd  > valExp(p_phiInPrev.size());
         for (size_t it = 0; it < p_phiInPrev.size(); ++it)
         {
-            valExp[it] = p_tree->expCondMultiple(p_phiInPrev[it]->transpose()).transpose();
+            valExp[it].resize(p_tree->getNbNodes(), p_phiInPrev[it]->cols());
+            p_tree->expCondMultipleNodesInRows(*p_phiInPrev[it], valExp[it]);
         }
         *p_ar <<  gs::Record(valExp, (p_name + "Values").c_str(), stepString.c_str()) ;
         *p_ar <<  gs::Record(p_control, (p_name + "Control").c_str(), stepString.c_str()) ;
@@ -155,7 +166,7 @@ void TransitionStepTreeDPDist::dumpContinuationValues(shared_ptr<gs::BinaryFileA
             gridOnProc0Prev(id)[0] = 0 ;
             gridOnProc0Prev(id)[1] = initialDimensionPrev(id) ;
         }
-        ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObjectPrev(initialDimensionPrev, splittingRatioPrev, m_world);
         vector< GridTreeValue> contVal(p_phiInPrev.size());
         for (size_t iReg = 0; iReg < p_phiInPrev.size(); ++iReg)
@@ -165,7 +176,8 @@ void TransitionStepTreeDPDist::dumpContinuationValues(shared_ptr<gs::BinaryFileA
                 reconstructedArray = paralObjectPrev.reconstruct(*p_phiInPrev[iReg], gridOnProc0Prev);
             if (m_world.rank() == 0)
             {
-                ArrayXXd reconstructedArrayExp = p_tree->expCondMultiple(reconstructedArray.transpose()).transpose();
+                ArrayXXd reconstructedArrayExp(p_tree->getNbNodes(), reconstructedArray.cols());
+                p_tree->expCondMultipleNodesInRows(reconstructedArray, reconstructedArrayExp);
                 contVal[iReg] = GridTreeValue(m_pGridPrevious, reconstructedArrayExp);
             }
         }
@@ -178,7 +190,7 @@ void TransitionStepTreeDPDist::dumpContinuationValues(shared_ptr<gs::BinaryFileA
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_pOptimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< GridTreeValue > control(p_control.size());
         for (size_t iCont = 0; iCont < p_control.size(); ++iCont)
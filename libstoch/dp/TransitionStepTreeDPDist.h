@@ -39,7 +39,8 @@ public :
     TransitionStepTreeDPDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent,
                              const  std::shared_ptr<FullGrid> &p_pridPrevious,
                              const  std::shared_ptr<OptimizerDPTreeBase > &p_pOptimize,
-                             const boost::mpi::communicator &p_world);
+                             const boost::mpi::communicator &p_world,
+                             const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief One step for dynamic programming in optimization
     /// \param p_phiIn      for each regime the function value ( nb node in tree at next date, nb stocks )
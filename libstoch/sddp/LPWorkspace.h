@@ -0,0 +1,305 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef LPWORKSPACE_H
+#define LPWORKSPACE_H
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <memory>
+#include <vector>
+#include <deque>
+#include <array>
+#include <iostream>
+#include <Eigen/Dense>
+#include "ClpSimplex.hpp"
+#include "CoinPackedMatrix.hpp"
+#include "libstoch/core/utils/constant.h"
+
+/** \file LPWorkspace.h
+ *  \brief Keep one LP model per thread so that successive LP with the same structure are not rebuilt.
+ *         Between two resolutions only the bounds, the objective and the Bellman cuts are modified
+ *         and the LP is solved by the dual simplex starting from the previous optimal basis (warm start).
+ *         Used by the optimizers deriving from OptimizerSDDPBase, OptimizerDPCutBase or OptimizerDPCutTreeBase (test/c++/tools)
+ *         This file is header only so that the library does not depend on COIN CLP.
+ *  \author Xavier Warin
+ */
+
+namespace libstoch
+{
+
+/// \class LPWorkspace LPWorkspace.h
+/// Store a ClpSimplex model for each thread.
+/// The LP is split in :
+///   - a structural part (constraints independent of the Bellman cuts)  loaded once with loadStructure,
+///   - a set of cut rows   \f$ \theta_g - \sum_i a_i x_{c_i}  \ge a_0 \f$ (or \f$ \le a_0 \f$ for maximization)
+///     added after the structural rows by setCuts. In the multi cut formulation, the cuts of group \f$ g \f$
+///     (a sample for example) bound the Bellman variable \f$ \theta_g \f$ of column  p_iBellman + g.
+///   .
+/// Modifying the bounds or the cuts keeps the previous basis dual feasible, but a modification of the objective
+/// generally does not : the dual simplex of Clp then starts from a basis that is neither primal nor dual feasible,
+/// which is still most of the time faster than a resolution from scratch. If the warm started resolution fails,
+/// the LP is solved from scratch.
+class LPWorkspace
+{
+private :
+
+    /// \brief LP data attached to a thread
+    struct LPThread
+    {
+        std::shared_ptr<ClpSimplex> m_model ; ///< LP model
+        int m_nbStructRows ; ///< number of structural rows (first rows of the model)
+        std::vector< Eigen::ArrayXXd > m_cuts ; ///< cuts currently in the model for each group : (1 + number of state) by  number of cuts
+        std::vector< std::array<int, 2> > m_rowCut ; ///< for each cut row of the model, its group and its number in the group
+        bool m_bWarm ; ///< true if a basis is available from a previous resolution
+        int m_nbWarmSolve ; ///< number of resolutions with warm start
+        int m_nbColdSolve ; ///< number of resolutions from scratch
+
+        LPThread(): m_nbStructRows(0), m_bWarm(false), m_nbWarmSolve(0), m_nbColdSolve(0) {}
+    };
+
+    mutable std::deque< LPThread > m_lp ; ///< one LP per thread (a deque so that adding LPs for new threads keeps the others in place)
+    int m_iBellman ; ///< column of the Bellman  variable \f$ \theta \f$
+    Eigen::ArrayXi m_stateColumns ; ///< columns of the state variables in the cuts
+    bool m_bLowerCut ; ///< if true, cuts are lower bounds for the Bellman variable (minimization), otherwise upper bound (maximization)
+    double m_optimizationDirection ; ///< 1 for minimization, -1 for maximization
+
+    /// \brief LP of the current thread : LPs are added if the number of threads increased since the creation
+    LPThread &lpThread() const
+    {
+#ifdef _OPENMP
+        size_t ithread = omp_get_thread_num();
+        LPThread *lp = nullptr;
+        #pragma omp critical (LPWorkspace)
+        {
+            if (ithread >= m_lp.size())
+                m_lp.resize(ithread + 1);
+            lp = &m_lp[ithread];
+        }
+        return *lp;
+#else
+        return m_lp[0];
+#endif
+    }
+
+    /// \brief Add cuts rows to a model
+    /// \param p_lp       LP of current thread
+    /// \param p_cuts     cuts
+    /// \param p_iGroup   group of the cuts (the Bellman variable is in column m_iBellman + p_iGroup)
+    /// \param p_iFirst   first cut to add
+    void addCutRows(LPThread &p_lp, const Eigen::ArrayXXd &p_cuts, const int &p_iGroup, const int &p_iFirst) const
+    {
+        int nbCutsToAdd = p_cuts.cols() - p_iFirst;
+        if (nbCutsToAdd <= 0)
+            return;
+        int nbState = m_stateColumns.size();
+        std::vector<CoinBigIndex> rowStarts(nbCutsToAdd + 1);
+        std::vector<int> columns(nbCutsToAdd * (nbState + 1));
+        std::vector<double> elements(nbCutsToAdd * (nbState + 1));
+        std::vector<double> rowLower(nbCutsToAdd);
+        std::vector<double> rowUpper(nbCutsToAdd);
+        for (int icut = 0; icut < nbCutsToAdd; ++icut)
+        {
+            int ipos = icut * (nbState + 1);
+            rowStarts[icut] = ipos;
+            columns[ipos] = m_iBellman + p_iGroup;
+            elements[ipos] = 1.;
+            for (int ist = 0; ist < nbState; ++ist)
+            {
+                columns[ipos + 1 + ist] = m_stateColumns(ist);
+                elements[ipos + 1 + ist] = - p_cuts(1 + ist, p_iFirst + icut);
+            }
+            if (m_bLowerCut)
+            {
+                rowLower[icut] = p_cuts(0, p_iFirst + icut);
+                rowUpper[icut] = libstoch::infty;
+            }
+            else
+            {
+                rowLower[icut] = -libstoch::infty;
+                rowUpper[icut] = p_cuts(0, p_iFirst + icut);
+            }
+            p_lp.m_rowCut.push_back({{p_iGroup, p_iFirst + icut}});
+        }
+        rowStarts[nbCutsToAdd] = nbCutsToAdd * (nbState + 1);
+        p_lp.m_model->addRows(nbCutsToAdd, rowLower.data(), rowUpper.data(), rowStarts.data(), columns.data(), elements.data());
+    }
+
+public :
+
+    /// \brief Constructor
+    /// \param p_iBellman       column of the Bellman variable in the LP
+    /// \param p_stateColumns   columns of the state variables associated to the cuts derivatives
+    /// \param p_bLowerCut      true if cuts give lower bounds on the Bellman variable (minimization)
+    /// \param p_bMinimize      true if the LP is a minimization
+    LPWorkspace(const int &p_iBellman, const Eigen::ArrayXi &p_stateColumns, const bool &p_bLowerCut = true,
+                const bool &p_bMinimize = true):
+#ifdef _OPENMP
+        m_lp(omp_get_max_threads()),
+#else
+        m_lp(1),
+#endif
+        m_iBellman(p_iBellman), m_stateColumns(p_stateColumns), m_bLowerCut(p_bLowerCut),
+        m_optimizationDirection(p_bMinimize ? 1. : -1.)
+    {}
+
+    /// \brief Check if the structure of the LP has already been loaded for current thread
+    inline bool isInitialized() const
+    {
+        return static_cast<bool>(lpThread().m_model);
+    }
+
+    /// \brief Load the structural part of the LP for current thread (no cuts)
+    /// \param p_rows            rows for matrix constraints
+    /// \param p_columns         columns for matrix constraints
+    /// \param p_elements        A matrix elements
+    /// \param p_lowBound        lower bound on variables
+    /// \param p_upperBound      upper bound on variables
+    /// \param p_objFunc         objective function
+    /// \param p_lowBoundConst   lower constraint \f$ lc\f$  on matrix \f$ lc \le A x \f$
+    /// \param p_upperBoundConst upper constraint \f$ uc\f$  on matrix \f$ A x \le uc \f$
+    void loadStructure(const Eigen::ArrayXi &p_rows, const Eigen::ArrayXi &p_columns, const Eigen::ArrayXd &p_elements,
+                       const Eigen::ArrayXd &p_lowBound, const Eigen::ArrayXd &p_upperBound, const Eigen::ArrayXd &p_objFunc,
+                       const Eigen::ArrayXd &p_lowBoundConst, const Eigen::ArrayXd &p_upperBoundConst)
+    {
+        LPThread &lp = lpThread();
+        lp.m_model = std::make_shared<ClpSimplex>();
+#ifdef NDEBUG
+        lp.m_model->setLogLevel(0);
+#endif
+        // column ordered matrix keeps the size of the row bounds even for empty rows
+        CoinPackedMatrix matrix(false, p_rows.data(), p_columns.data(), p_elements.data(), p_elements.size());
+        matrix.setDimensions(p_lowBoundConst.size(), p_lowBound.size());
+        lp.m_model->loadProblem(matrix, p_lowBound.data(), p_upperBound.data(), p_objFunc.data(), p_lowBoundConst.data(), p_upperBoundConst.data());
+        lp.m_model->setOptimizationDirection(m_optimizationDirection);
+        lp.m_nbStructRows = p_lowBoundConst.size();
+        lp.m_cuts.clear();
+        lp.m_rowCut.clear();
+        lp.m_bWarm = false;
+    }
+
+    /// \brief Update the data of the structural part of the LP for current thread : matrix is unchanged
+    /// \param p_lowBound        lower bound on variables
+    /// \param p_upperBound      upper bound on variables
+    /// \param p_objFunc         objective function
+    /// \param p_lowBoundConst   lower constraint for structural rows
+    /// \param p_upperBoundConst upper constraint for structural rows
+    void updateStructure(const Eigen::ArrayXd &p_lowBound, const Eigen::ArrayXd &p_upperBound, const Eigen::ArrayXd &p_objFunc,
+                         const Eigen::ArrayXd &p_lowBoundConst, const Eigen::ArrayXd &p_upperBoundConst)
+    {
+        LPThread &lp = lpThread();
+        for (int icol = 0; icol < p_lowBound.size(); ++icol)
+        {
+            lp.m_model->setColumnBounds(icol, p_lowBound(icol), p_upperBound(icol));
+            lp.m_model->setObjectiveCoefficient(icol, p_objFunc(icol));
+        }
+        for (int irow = 0; irow < lp.m_nbStructRows; ++irow)
+            lp.m_model->setRowBounds(irow, p_lowBoundConst(irow), p_upperBoundConst(irow));
+    }
+
+    /// \brief Set the cuts for the Bellman variable for current thread
+    ///        Cuts already in the model and identical to the first cuts of p_cuts are kept, other are replaced.
+    ///        As cuts are only added between SDDP iterations, most of the time only new cuts are added to the LP.
+    /// \param p_cuts   cuts  (1 + state size) by  number of cuts : \f$ (a_0, a_1, \ldots, a_d) \f$
+    void setCuts(const Eigen::ArrayXXd &p_cuts)
+    {
+        setMultiCuts(std::vector< Eigen::ArrayXXd >(1, p_cuts));
+    }
+
+    /// \brief Set the cuts for the Bellman variables of the multi cut formulation for current thread
+    ///        For each group, cuts already in the model and identical to the first cuts of the group are kept, other are replaced.
+    /// \param p_multiCuts   for each group (Bellman variable in column p_iBellman + group), cuts  (1 + state size) by  number of cuts
+    void setMultiCuts(const std::vector< Eigen::ArrayXXd > &p_multiCuts)
+    {
+        LPThread &lp = lpThread();
+        // number of cuts kept in each group
+        std::vector<int> nbCommon(p_multiCuts.size(), 0);
+        for (size_t ig = 0; ig < std::min(p_multiCuts.size(), lp.m_cuts.size()); ++ig)
+        {
+            const Eigen::ArrayXXd &cutsInModel = lp.m_cuts[ig];
+            int nbCutsMin = std::min(static_cast<int>(cutsInModel.cols()), static_cast<int>(p_multiCuts[ig].cols()));
+            if (cutsInModel.rows() == p_multiCuts[ig].rows())
+                while ((nbCommon[ig] < nbCutsMin) && (cutsInModel.col(nbCommon[ig]) == p_multiCuts[ig].col(nbCommon[ig])).all())
+                    nbCommon[ig] += 1;
+        }
+        std::vector<int> rowsToDelete;
+        std::vector< std::array<int, 2> > rowCutKept;
+        rowCutKept.reserve(lp.m_rowCut.size());
+        for (size_t irow = 0; irow < lp.m_rowCut.size(); ++irow)
+        {
+            const std::array<int, 2> &groupAndCut = lp.m_rowCut[irow];
+            if ((groupAndCut[0] < static_cast<int>(nbCommon.size())) && (groupAndCut[1] < nbCommon[groupAndCut[0]]))
+                rowCutKept.push_back(groupAndCut);
+            else
+                rowsToDelete.push_back(lp.m_nbStructRows + irow);
+        }
+        if (rowsToDelete.size() > 0)
+            lp.m_model->deleteRows(rowsToDelete.size(), rowsToDelete.data());
+        lp.m_rowCut = rowCutKept;
+        for (size_t ig = 0; ig < p_multiCuts.size(); ++ig)
+            addCutRows(lp, p_multiCuts[ig], ig, nbCommon[ig]);
+        lp.m_cuts = p_multiCuts;
+    }
+
+    /// \brief Solve the LP of current thread. The previous basis is used as a starting point if available
+    /// \return true if an optimal solution is found
+    bool solve()
+    {
+        LPThread &lp = lpThread();
+        if (lp.m_bWarm)
+        {
+            // dual simplex from previous basis : dual feasible if only bounds or cuts are modified, not always after a change of the objective
+            lp.m_model->dual();
+            lp.m_nbWarmSolve += 1;
+        }
+        if (!lp.m_bWarm || !lp.m_model->isProvenOptimal())
+        {
+            ClpSolve solvectl;
+            solvectl.setSolveType(ClpSolve::useDual);
+            solvectl.setPresolveType(ClpSolve::presolveOn);
+            lp.m_model->initialSolve(solvectl);
+            lp.m_nbColdSolve += 1;
+        }
+        lp.m_bWarm = lp.m_model->isProvenOptimal();
+        return lp.m_bWarm;
+    }
+
+    /// \brief get back the model of current thread (to get solution)
+    inline const ClpSimplex &getModel() const
+    {
+        return *lpThread().m_model;
+    }
+
+    /// \brief Invalidate all models (for example at a new date when the structure of the LP changes)
+    ///        Statistics are kept. Not to be called in a parallel region.
+    void reset()
+    {
+        for (size_t i = 0; i < m_lp.size(); ++i)
+        {
+            LPThread lp;
+            lp.m_nbWarmSolve = m_lp[i].m_nbWarmSolve;
+            lp.m_nbColdSolve = m_lp[i].m_nbColdSolve;
+            m_lp[i] = lp;
+        }
+    }
+
+    /// \brief get back statistics summed on all threads (not to be called in a parallel region)
+    ///@{
+    inline int getNbWarmSolve() const
+    {
+        int nbSolve = 0;
+        for (const auto &lp : m_lp)
+            nbSolve += lp.m_nbWarmSolve;
+        return nbSolve;
+    }
+    inline int getNbColdSolve() const
+    {
+        int nbSolve = 0;
+        for (const auto &lp : m_lp)
+            nbSolve += lp.m_nbColdSolve;
+        return nbSolve;
+    }
+    ///@}
+};
+}
+#endif /* LPWORKSPACE_H */
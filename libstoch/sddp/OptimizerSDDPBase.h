@@ -3,6 +3,7 @@
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
 #ifndef OPTIMIZERSDDPBASE_H
 #define OPTIMIZERSDDPBASE_H
+#include <memory>
 #include <Eigen/Dense>
 #include "libstoch/sddp/SDDPCutOptBase.h"
 #include "libstoch/core/grids/OneDimRegularSpaceGrid.h"
@@ -18,12 +19,15 @@
 
 namespace libstoch
 {
+class LPWorkspace;
 
 /// \class OptimizerSDDPBase OptimizerSDDPBase.h
 ///  Base class for optimizer for Dynamic Programming
 class OptimizerSDDPBase
 {
+protected :
 
+    std::shared_ptr< LPWorkspace > m_lpWorkspace ; ///< if defined, LP models are kept and warm started between LP resolutions
 
 public :
 
@@ -31,6 +35,19 @@ public :
 
     virtual ~OptimizerSDDPBase() {}
 
+    /// \brief Opt in LP model reuse : the optimizer keeps one LP per thread, updates its bounds and cuts and warm starts it
+    /// \param p_lpWorkspace  workspace (LPWorkspace.h, needs COIN CLP) : a null pointer goes back to a new LP for each resolution
+    inline void setLPWorkspace(const std::shared_ptr< LPWorkspace > &p_lpWorkspace)
+    {
+        m_lpWorkspace = p_lpWorkspace;
+    }
+
+    /// \brief get back the LP workspace (null if LP are rebuilt at each resolution)
+    inline std::shared_ptr< LPWorkspace > getLPWorkspace() const
+    {
+        return m_lpWorkspace;
+    }
+
 
     /// \brief Optimize the LP during backward resolution
     /// \param p_linCut	cuts used for the PL (Benders for the Bellman value at the end of the time step)
@@ -0,0 +1,37 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#include <cmath>
+#include <algorithm>
+#include "libstoch/core/utils/constant.h"
+#include "libstoch/sddp/SDDPAdaptiveSchedule.h"
+
+using namespace std;
+
+namespace libstoch
+{
+
+SDDPAdaptiveSchedule::SDDPAdaptiveSchedule(const int &p_nbSimulMin, const int &p_nbSimulMax, const double &p_growth, const double &p_quantile):
+    m_nbSimulMin(max(p_nbSimulMin, 2)), m_nbSimulMax(max(p_nbSimulMax, m_nbSimulMin)), m_growth(max(p_growth, 1.)), m_quantile(p_quantile),
+    m_nbSimul(m_nbSimulMin), m_mean(0.), m_halfWidth(infty)
+{}
+
+void SDDPAdaptiveSchedule::update(const double &p_mean, const double &p_variance, const double &p_accuracy)
+{
+    m_mean = p_mean;
+    m_halfWidth = m_quantile * sqrt(p_variance / m_nbSimul);
+    // number of simulations giving the half width asked
+    double target = p_accuracy * fabs(p_mean);
+    double nbSimulTarget = (target > 0.) ? p_variance * pow(m_quantile / target, 2.) : static_cast<double>(m_nbSimulMax);
+    // growth limited by the factor (the number of simulations never decreases)
+    double nbSimulNext = min(max(nbSimulTarget, static_cast<double>(m_nbSimul)), m_growth * m_nbSimul);
+    m_nbSimul = static_cast<int>(min(ceil(nbSimulNext), static_cast<double>(m_nbSimulMax)));
+}
+
+double SDDPAdaptiveSchedule::getAccuracy(const double &p_backwardValue) const
+{
+    if (m_mean == 0.)
+        return max(fabs(p_backwardValue), m_halfWidth);
+    return max(fabs(p_backwardValue - m_mean), m_halfWidth) / fabs(m_mean);
+}
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SDDPADAPTIVESCHEDULE_H
+#define SDDPADAPTIVESCHEDULE_H
+#include <array>
+
+/** \file SDDPAdaptiveSchedule.h
+ *  \brief Adaptive number of forward simulations and statistical stopping test for SDDP iterations.
+ *         At each iteration the forward sweep gives an estimation of the value of the current policy with a variance.
+ *         The number of forward simulations of the next iteration is the number needed to get a confidence
+ *         interval of relative half width equal to the accuracy asked, growing at most by a given factor per iteration.
+ *         The iterations stop as soon as the confidence interval of the forward value is narrow enough
+ *         (relative half width below the accuracy) and the relative gap between backward and forward values is below the accuracy :
+ *         the accuracy estimated is the maximum of the relative gap and of the relative half width.
+ *  \author Xavier Warin
+ */
+
+namespace libstoch
+{
+/// \class SDDPAdaptiveSchedule SDDPAdaptiveSchedule.h
+/// Schedule of the number of forward simulations and gap test
+class SDDPAdaptiveSchedule
+{
+private :
+
+    int m_nbSimulMin ; ///< number of forward simulations at the first iteration
+    int m_nbSimulMax ; ///< maximal number of forward simulations
+    double m_growth ; ///< maximal growth factor of the number of simulations between two iterations
+    double m_quantile ; ///< quantile of the normal law defining the confidence interval (1.96 for 95%)
+    int m_nbSimul ; ///< current number of forward simulations
+    double m_mean ; ///< last forward value
+    double m_halfWidth ; ///< half width of the last confidence interval
+
+public :
+
+    /// \brief Constructor
+    /// \param p_nbSimulMin   number of forward simulations at the first iteration
+    /// \param p_nbSimulMax   maximal number of forward simulations
+    /// \param p_growth       maximal growth factor of the number of simulations between two iterations
+    /// \param p_quantile     quantile of the normal law defining the confidence interval
+    SDDPAdaptiveSchedule(const int &p_nbSimulMin, const int &p_nbSimulMax, const double &p_growth = 2., const double &p_quantile = 1.96);
+
+    /// \brief Update the confidence interval with the forward value obtained and calculate the number of simulations of the next iteration
+    /// \param p_mean      forward value
+    /// \param p_variance  variance of the value of one simulation
+    /// \param p_accuracy  relative half width of the confidence interval asked
+    void update(const double &p_mean, const double &p_variance, const double &p_accuracy);
+
+    /// \brief Accuracy estimated for the gap test : maximum of the relative gap between backward and forward values
+    ///        and of the relative half width of the last confidence interval
+    /// \param p_backwardValue  backward value
+    double getAccuracy(const double &p_backwardValue) const;
+
+    /// \brief number of forward simulations to use
+    inline int getNbSimul() const
+    {
+        return m_nbSimul;
+    }
+
+    /// \brief last confidence interval of the forward value
+    inline std::array<double, 2> getConfidenceInterval() const
+    {
+        return {{m_mean - m_halfWidth, m_mean + m_halfWidth}};
+    }
+};
+}
+#endif /* SDDPADAPTIVESCHEDULE_H */
@@ -2,12 +2,13 @@
 #include "libstoch/sddp/SDDPCutCommon.h"
 #include "boost/lexical_cast.hpp"
 #ifdef USE_MPI
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #include "geners/BinaryFileArchive.hh"
 #include "geners/Record.hh"
 #include "geners/Reference.hh"
 #include "libstoch/sddp/SDDPACutGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 
 
 using namespace Eigen ;
@@ -126,8 +127,11 @@ void SDDPCutCommon::mpiExec(const ArrayXXd   &p_cutPerSim,
                             ArrayXXd    &p_cutPerSimProc,
                             const boost::mpi::communicator &p_world) const
 {
+    InstrumentationTimer timerCommunication(instCommunication);
     // number of rosws
     int nbRows = p_cutPerSim.rows();
+    // bytes exchanged with other processors
+    long nbBytes = 0;
     // communication receive part
     vector<  boost::mpi::request > reqRec(p_world.size());
     int nbRec = 0 ;
@@ -143,6 +147,7 @@ void SDDPCutCommon::mpiExec(const ArrayXXd   &p_cutPerSim,
                 // communication
                 int imesg_iproc = 0;
                 reqRec[nbRec++] = p_world.irecv(iproc, imesg_iproc++, p_cutPerSimProc.col(p_tabRecFromProcessor[iproc][0]).data(), sizeRec);
+                nbBytes += static_cast<long>(sizeRec) * sizeof(double);
             }
         }
         else
@@ -170,49 +175,57 @@ void SDDPCutCommon::mpiExec(const ArrayXXd   &p_cutPerSim,
         {
             int imesg_iproc = 0;
             reqSend[nbSend++] =  p_world.isend(iproc, imesg_iproc++, p_cutPerSim.col(p_tabSendToProcessor[iproc][0]).data(), sizeSend);
+            nbBytes += static_cast<long>(sizeSend) * sizeof(double);
         }
     }
     boost::mpi::wait_all(reqRec.begin(), reqRec.begin() + nbRec);
     boost::mpi::wait_all(reqSend.begin(), reqSend.begin() + nbSend);
+    instrumentBytes(nbBytes);
 }
 
 
 void SDDPCutCommon::mpiExecCutRoutage(vector< shared_ptr<SDDPACut> > &p_localCut, vector< int > &p_meshCut,
                                       const boost::mpi::communicator &p_world)
 {
-    int isizeCut  = 0;
-    int iRowCut   = 0;
-    int iColCut   = 0 ;
-    if (p_world.rank() == 0)
+    // number of columns may differ between cuts (multi cuts on tree)
+    int iRowCutLoc = ((p_localCut.size() > 0) ? p_localCut[0]->getCut()->rows() : 0);
+    int iRowCut = 0;
+    all_reduce(p_world, iRowCutLoc, iRowCut, boost::mpi::maximum<int>());
+    vector<int> colCut(p_localCut.size());
+    int isizeLoc = 0;
+    for (size_t iCut = 0; iCut < p_localCut.size(); ++iCut)
     {
-        isizeCut =  p_localCut[0]->getCut()->size();
-        iRowCut =   p_localCut[0]->getCut()->rows();
-        iColCut  =  p_localCut[0]->getCut()->cols();
+        colCut[iCut] = p_localCut[iCut]->getCut()->cols();
+        isizeLoc += p_localCut[iCut]->getCut()->size();
     }
-    broadcast(p_world, isizeCut, 0);
-    broadcast(p_world, iRowCut, 0);
-    broadcast(p_world, iColCut, 0);
-    ArrayXd arrayToGather(p_localCut.size()*isizeCut);
+    ArrayXd arrayToGather(isizeLoc);
+    int ipos = 0;
     for (size_t iCut = 0; iCut < p_localCut.size(); ++iCut)
     {
+        int isizeCut = p_localCut[iCut]->getCut()->size();
         Map< const ArrayXd > tab(p_localCut[iCut]->getCut()->data(), isizeCut);
-        arrayToGather.segment(iCut * isizeCut, isizeCut) = tab;
+        arrayToGather.segment(ipos, isizeCut) = tab;
+        ipos += isizeCut;
     }
     // global vector
     ArrayXd  allCuts ;
-    all_gatherv(p_world, arrayToGather.data(), arrayToGather.size(), allCuts);
+    allGatherv(p_world, arrayToGather.data(), arrayToGather.size(), allCuts);
     vector<int> allMesh;
-    all_gatherv(p_world, p_meshCut.data(), p_meshCut.size(), allMesh);
+    allGatherv(p_world, p_meshCut.data(), p_meshCut.size(), allMesh);
+    vector<int> allColCut;
+    allGatherv(p_world, colCut.data(), colCut.size(), allColCut);
     // create the cuts
     p_meshCut = allMesh;
-    int nbTotCuts = allCuts.size() / isizeCut;
+    int nbTotCuts = allColCut.size();
     p_localCut.resize(nbTotCuts);
+    ipos = 0;
     for (int i = 0; i < nbTotCuts; ++i)
     {
-        shared_ptr<ArrayXXd > ptCut = make_shared< ArrayXXd>(iRowCut, iColCut);
-        Map<ArrayXXd> mapCut(allCuts.data() + i * isizeCut, iRowCut, iColCut);
+        shared_ptr<ArrayXXd > ptCut = make_shared< ArrayXXd>(iRowCut, allColCut[i]);
+        Map<ArrayXXd> mapCut(allCuts.data() + ipos, iRowCut, allColCut[i]);
         *ptCut = mapCut;
         p_localCut[i] = make_shared< SDDPACut>(ptCut);
+        ipos += iRowCut * allColCut[i];
     }
 }
 #endif
@@ -244,6 +257,7 @@ void SDDPCutCommon::loadCutsByName(const shared_ptr< BinaryFileArchive>   &p_ar,
 #ifdef USE_MPI
     }
     // use mpi to spread cuts
+    InstrumentationTimer timerCommunication(instCommunication);
 #if BOOST_VERSION <  105600
     boost::mpi::broadcast(p_world, p_cuts, 0);
 #else
@@ -297,7 +311,17 @@ void SDDPCutCommon::gatherAndStoreCuts(vector< shared_ptr<SDDPACut> > &p_localCu
 
 #ifdef USE_MPI
     mpiExecCutRoutage(p_localCut, p_nodeCut, p_world);
+    int itask = p_world.rank();
+#else
+    int itask = 0;
 #endif
+    // only first task stores in archive
+    storeCuts(p_localCut, p_nodeCut, p_name, p_cuts, ((itask == 0) ? p_ar : shared_ptr<BinaryFileArchive>()), p_nbNodes, p_date);
+}
+
+void SDDPCutCommon::storeCuts(const vector< shared_ptr<SDDPACut> > &p_localCut, const vector<int> &p_nodeCut, const string &p_name, vector< vector<  shared_ptr<SDDPACut> > > &p_cuts,
+                              const shared_ptr<BinaryFileArchive> &p_ar, const int &p_nbNodes, const int   &p_date)
+{
     vector<int> nbCutPerNode(p_nbNodes, 0);
     for (size_t i = 0; i < p_nodeCut.size(); ++i)
         nbCutPerNode[p_nodeCut[i]] += 1;
@@ -310,13 +334,7 @@ void SDDPCutCommon::gatherAndStoreCuts(vector< shared_ptr<SDDPACut> > &p_localCu
         additionalCuts[p_nodeCut[i]].push_back(p_localCut[i]);
     }
     // now store additional cuts
-#ifdef USE_MPI
-    int itask = p_world.rank();
-
-#else
-    int itask = 0;
-#endif
-    if (itask == 0)
+    if (p_ar)
     {
         string stringStep = boost::lexical_cast<string>(p_date);
         for (size_t i = 0; i < additionalCuts.size(); ++i)
@@ -89,6 +89,18 @@ protected :
                        );
 
 
+    /// \brief Add some cuts to the cuts already stored and write them in an archive
+    ///  \param p_localCut   all new cuts to store
+    ///  \param p_nodeCut    for each cut, the node or mesh involved
+    ///  \param p_name       name of the cuts in binary archive
+    ///  \param p_cuts       cuts updated
+    ///  \param p_ar         binary archive used to store cuts (no storage if null)
+    ///  \param p_nbNodes    number of nodes or meshes
+    ///  \param p_date       date index
+    void storeCuts(const std::vector< std::shared_ptr<SDDPACut> > &p_localCut, const std::vector<int> &p_nodeCut, const std::string &p_name,
+                   std::vector< std::vector<  std::shared_ptr<SDDPACut> > > &p_cuts, const std::shared_ptr<gs::BinaryFileArchive> &p_ar,
+                   const int  &p_nbNodes, const int   &p_date);
+
     /// \brief During  cut creation :
     ///        Gather all cuts  and store them
     ///  \param p_localCut   all new cuts to store
@@ -0,0 +1,137 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SDDPCUTNODEBATCH_H
+#define SDDPCUTNODEBATCH_H
+#include <vector>
+#include <tuple>
+#include <memory>
+#include <algorithm>
+#include <Eigen/Dense>
+#include "libstoch/sddp/SDDPCutOptBase.h"
+
+/** \file SDDPCutNodeBatch.h
+ * \brief Scheduling of the LPs of a backward sweep with trees by batches of LPs sharing the same arrival node.
+ *        All the LPs of a batch use the cuts of the same node at the next date : the cut matrix of the node is
+ *        built once for the batch (by the thread treating it) instead of being built for each LP.
+ *        Batches are dispatched dynamically between threads, the largest first.
+ * \author Xavier Warin
+ */
+
+namespace libstoch
+{
+
+/// \class SDDPCutNodeCache SDDPCutNodeBatch.h
+/// Cuts of a given node built once and reused by all the LPs of a batch.
+/// Cuts of other nodes are asked to the cut object.
+/// An object is used by a single thread.
+class SDDPCutNodeCache : public SDDPCutOptBase
+{
+private :
+
+    const SDDPCutOptBase &m_cuts ; ///< cuts at the next date
+    int m_node ; ///< node cached
+    mutable bool m_bCuts ; ///< true if m_cutsNode is built
+    mutable Eigen::ArrayXXd m_cutsNode ; ///< aggregated cuts of the node
+    mutable bool m_bMultiCuts ; ///< true if m_multiCutsNode is built
+    mutable std::vector< Eigen::ArrayXXd > m_multiCutsNode ; ///< cuts of the node for each arrival node
+
+public :
+
+    /// \brief Constructor
+    /// \param p_cuts  cuts at the next date
+    /// \param p_node  node shared by the LPs of the batch
+    SDDPCutNodeCache(const SDDPCutOptBase &p_cuts, const int &p_node): m_cuts(p_cuts), m_node(p_node), m_bCuts(false), m_bMultiCuts(false) {}
+
+    /// \brief aggregated cuts of the node, built on first use
+    const Eigen::ArrayXXd &getCutsOfTheNode() const
+    {
+        if (!m_bCuts)
+        {
+            m_cutsNode = m_cuts.getCutsAssociatedToTheParticle(m_node);
+            m_bCuts = true;
+        }
+        return m_cutsNode;
+    }
+
+    Eigen::ArrayXXd  getCutsAssociatedToTheParticle(int p_isim) const
+    {
+        if (p_isim != m_node)
+            return m_cuts.getCutsAssociatedToTheParticle(p_isim);
+        return getCutsOfTheNode();
+    }
+
+    /// \brief cuts of the node cached are returned by reference, without copy
+    const Eigen::ArrayXXd &getCutsAssociatedToTheParticleRef(int p_isim, Eigen::ArrayXXd &p_buffer) const
+    {
+        if (p_isim != m_node)
+            return m_cuts.getCutsAssociatedToTheParticleRef(p_isim, p_buffer);
+        return getCutsOfTheNode();
+    }
+
+    Eigen::ArrayXXd  getCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const
+    {
+        return m_cuts.getCutsAssociatedToAParticle(p_aParticle);
+    }
+
+    std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToTheParticle(int p_isim) const
+    {
+        if (p_isim != m_node)
+            return m_cuts.getMultiCutsAssociatedToTheParticle(p_isim);
+        if (!m_bMultiCuts)
+        {
+            m_multiCutsNode = m_cuts.getMultiCutsAssociatedToTheParticle(m_node);
+            m_bMultiCuts = true;
+        }
+        return m_multiCutsNode;
+    }
+
+    std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const
+    {
+        return m_cuts.getMultiCutsAssociatedToAParticle(p_aParticle);
+    }
+};
+
+/// \brief Group the LPs treated by a processor by arrival node
+/// \param p_vecState   for each state : the state, the arrival node, the starting node
+/// \param p_nbSample   number of LPs (samples) for each state
+/// \param p_iLPFirst   first LP treated by the processor
+/// \param p_iLPLast    last LP (excluded) treated by the processor
+/// \param p_nbThreads  number of threads : nodes with many LPs are split so that each thread gets several batches
+/// \return for each batch, the node and the LP numbers (relative to p_iLPFirst), largest batches first
+inline std::vector< std::pair< int, std::vector<int> > > createNodeBatches(const std::vector< std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  > &p_vecState,
+        const int &p_nbSample, const int &p_iLPFirst, const int &p_iLPLast, const int &p_nbThreads)
+{
+    // LPs by arrival node
+    int nbNode = 0;
+    for (const auto &aState : p_vecState)
+        nbNode = std::max(nbNode, std::get<1>(aState) + 1);
+    std::vector< std::vector<int> > lpPerNode(nbNode);
+    for (int ilp = p_iLPFirst; ilp < p_iLPLast; ++ilp)
+        lpPerNode[std::get<1>(p_vecState[ilp / p_nbSample])].push_back(ilp - p_iLPFirst);
+    // maximal size of a batch
+    int nbLP = p_iLPLast - p_iLPFirst;
+    int batchMax = std::max(1, nbLP / (4 * std::max(p_nbThreads, 1)));
+    std::vector< std::pair< int, std::vector<int> > > batches;
+    for (int inode = 0; inode < nbNode; ++inode)
+    {
+        int nbLPNode = lpPerNode[inode].size();
+        if (nbLPNode == 0)
+            continue;
+        // batches of nearly equal size
+        int nbBatch = (nbLPNode + batchMax - 1) / batchMax;
+        for (int ib = 0; ib < nbBatch; ++ib)
+        {
+            int iFirst = (ib * nbLPNode) / nbBatch;
+            int iLast = ((ib + 1) * nbLPNode) / nbBatch;
+            batches.push_back(std::make_pair(inode, std::vector<int>(lpPerNode[inode].begin() + iFirst, lpPerNode[inode].begin() + iLast)));
+        }
+    }
+    std::stable_sort(batches.begin(), batches.end(), [](const std::pair< int, std::vector<int> > &p_b1, const std::pair< int, std::vector<int> > &p_b2)
+    {
+        return p_b1.second.size() > p_b2.second.size();
+    });
+    return batches;
+}
+}
+#endif /* SDDPCUTNODEBATCH_H */
@@ -1,6 +1,7 @@
 
 #ifndef SDDPCUTOPTBASE_H
 #define SDDPCUTOPTBASE_H
+#include <vector>
 #include <Eigen/Dense>
 
 /**  \file SDDPCutOptBase.h
@@ -25,6 +26,35 @@ public :
     /// \brief Get back all the cuts to a given particle  (state size by the number of cuts)
     /// \param p_aParticle  a particle in regression or the coordinates of a node in the tree
     virtual Eigen::ArrayXXd  getCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const = 0;
+
+    /// \brief Get back all the cuts associated to a particle number without copy if the object already stores them
+    /// \param p_isim    particle number  (or node number)
+    /// \param p_buffer  array used to store the cuts if they are calculated
+    /// \return the cuts (state size +1  by the number of cuts) : p_buffer or cuts stored by the object
+    virtual const Eigen::ArrayXXd &getCutsAssociatedToTheParticleRef(int p_isim, Eigen::ArrayXXd &p_buffer) const
+    {
+        p_buffer = getCutsAssociatedToTheParticle(p_isim);
+        return p_buffer;
+    }
+
+    /// \brief Get back the cuts associated to a particle number for each sample (multi cut formulation)
+    ///        The Bellman value is the sum of the Bellman values associated to each sample.
+    ///        By default  only one aggregated cut is available.
+    /// \param p_isim  particle number  (or node number)
+    /// \return for each sample, the cuts (state size +1  by the number of cuts)
+    virtual std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToTheParticle(int p_isim) const
+    {
+        return std::vector< Eigen::ArrayXXd >(1, getCutsAssociatedToTheParticle(p_isim));
+    }
+
+    /// \brief Get back the cuts associated to a given particle for each sample (multi cut formulation)
+    ///        The Bellman value is the sum of the Bellman values associated to each sample.
+    /// \param p_aParticle  a particle in regression or the coordinates of a node in the tree
+    /// \return for each sample, the cuts (state size +1  by the number of cuts)
+    virtual std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const
+    {
+        return std::vector< Eigen::ArrayXXd >(1, getCutsAssociatedToAParticle(p_aParticle));
+    }
 };
 }
 #endif /* SDDPCutOptBase.h */
@@ -0,0 +1,89 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#include <array>
+#include "libstoch/core/utils/Instrumentation.h"
+#include "libstoch/sddp/SDDPCutStore.h"
+
+using namespace Eigen ;
+using namespace std;
+
+namespace libstoch
+{
+
+SDDPCutStore::SDDPCutStore(const vector< shared_ptr<SDDPLocalCut> > &p_cuts): m_cuts(p_cuts), m_nbCutsPublished(p_cuts.size())
+{
+    for (size_t idate = 0; idate < m_cuts.size(); ++idate)
+        setPublished(idate);
+}
+
+void SDDPCutStore::setPublished(const int &p_date)
+{
+    const vector< vector<  shared_ptr<SDDPACut> > > &cuts = m_cuts[p_date]->getCuts();
+    m_nbCutsPublished[p_date].resize(cuts.size());
+    for (size_t imesh = 0; imesh < cuts.size(); ++imesh)
+        m_nbCutsPublished[p_date][imesh] = cuts[imesh].size();
+}
+
+#ifdef USE_MPI
+void SDDPCutStore::publish(const int &p_date, const int &p_root, const bool &p_bOwner, const shared_ptr<gs::BinaryFileArchive> &p_ar,
+                           const boost::mpi::communicator &p_world)
+{
+    // number of new cuts , rows, columns of a cut
+    array<int, 3> sizeCut = {{0, 0, 0}};
+    vector<int> meshCut;
+    ArrayXd allCuts;
+    if (p_world.rank() == p_root)
+    {
+        const vector< vector<  shared_ptr<SDDPACut> > > &cuts = m_cuts[p_date]->getCuts();
+        for (size_t imesh = 0; imesh < cuts.size(); ++imesh)
+            for (size_t icut = m_nbCutsPublished[p_date][imesh]; icut < cuts[imesh].size(); ++icut)
+            {
+                if (sizeCut[0] == 0)
+                {
+                    sizeCut[1] = cuts[imesh][icut]->getCut()->rows();
+                    sizeCut[2] = cuts[imesh][icut]->getCut()->cols();
+                }
+                sizeCut[0] += 1;
+                meshCut.push_back(imesh);
+            }
+        int isizeCut = sizeCut[1] * sizeCut[2];
+        allCuts.resize(sizeCut[0] * isizeCut);
+        int iCutNew = 0;
+        for (size_t imesh = 0; imesh < cuts.size(); ++imesh)
+            for (size_t icut = m_nbCutsPublished[p_date][imesh]; icut < cuts[imesh].size(); ++icut)
+                allCuts.segment((iCutNew++) * isizeCut, isizeCut) = Map< const ArrayXd >(cuts[imesh][icut]->getCut()->data(), isizeCut);
+    }
+    InstrumentationTimer timerCommunication(instCommunication);
+    boost::mpi::broadcast(p_world, sizeCut.data(), 3, p_root);
+    if (p_world.rank() != p_root)
+    {
+        meshCut.resize(sizeCut[0]);
+        allCuts.resize(sizeCut[0] * sizeCut[1] * sizeCut[2]);
+    }
+    if (sizeCut[0] > 0)
+    {
+        boost::mpi::broadcast(p_world, meshCut.data(), sizeCut[0], p_root);
+        boost::mpi::broadcast(p_world, allCuts.data(), allCuts.size(), p_root);
+    }
+    timerCommunication.stop();
+    instrumentBytes(3 * sizeof(int) + meshCut.size() * sizeof(int) + allCuts.size() * sizeof(double));
+    if (!p_bOwner)
+    {
+        int isizeCut = sizeCut[1] * sizeCut[2];
+        vector< shared_ptr<SDDPACut> > localCut(sizeCut[0]);
+        for (int icut = 0; icut < sizeCut[0]; ++icut)
+        {
+            shared_ptr<ArrayXXd > ptCut = make_shared< ArrayXXd>(Map<ArrayXXd>(allCuts.data() + icut * isizeCut, sizeCut[1], sizeCut[2]));
+            localCut[icut] = make_shared< SDDPACut>(ptCut);
+        }
+        // only processor 0 has an archive
+        m_cuts[p_date]->addCuts(localCut, meshCut, p_ar);
+    }
+    setPublished(p_date);
+}
+#endif
+}
@@ -0,0 +1,69 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SDDPCUTSTORE_H
+#define SDDPCUTSTORE_H
+#include <memory>
+#include <vector>
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#include "geners/BinaryFileArchive.hh"
+#include "libstoch/sddp/SDDPLocalCut.h"
+
+/** \file SDDPCutStore.h
+ *  \brief Keep in memory the cuts of all dates during SDDP iterations
+ *         Cuts generated for a date are published to all processors as soon as the date is treated
+ *  \author Xavier Warin
+ */
+
+namespace libstoch
+{
+/// \class SDDPCutStore SDDPCutStore.h
+/// Store the  SDDPLocalCut objects of all  dates (except the last one using final cuts).
+/// Cuts are not reloaded from the archive at each date : the archive is only written.
+class SDDPCutStore
+{
+private :
+
+    std::vector< std::shared_ptr<SDDPLocalCut> > m_cuts ; ///< cuts for each date
+    std::vector< std::vector<int> > m_nbCutsPublished ; ///< for each date and each mesh, number of cuts known by all processors
+
+public :
+
+    /// \brief Default constructor
+    SDDPCutStore() {}
+
+    /// \brief Constructor
+    /// \param p_cuts   cuts for each date (already loaded)
+    SDDPCutStore(const std::vector< std::shared_ptr<SDDPLocalCut> > &p_cuts);
+
+    /// \brief get back the cuts of a date
+    inline std::shared_ptr<SDDPLocalCut> getCuts(const int &p_date) const
+    {
+        return m_cuts[p_date];
+    }
+
+    /// \brief number of dates stored
+    inline int getNbDates() const
+    {
+        return m_cuts.size();
+    }
+
+    /// \brief Indicate that the cuts of a date are known by all processors (new publication)
+    /// \param p_date  date index
+    void setPublished(const int &p_date);
+
+#ifdef USE_MPI
+    /// \brief Send to all processors the cuts generated for a date  by a group of processors  and not yet published
+    /// \param p_date    date index
+    /// \param p_root    rank in p_world of the first processor of the group  having generated the cuts
+    /// \param p_bOwner  true if current processor belongs to the group having generated the cuts
+    /// \param p_ar      archive storing cuts (only defined on processor 0 of p_world)
+    /// \param p_world   MPI communicator
+    void publish(const int &p_date, const int &p_root, const bool &p_bOwner, const std::shared_ptr<gs::BinaryFileArchive> &p_ar,
+                 const boost::mpi::communicator &p_world);
+#endif
+};
+}
+#endif /* SDDPCUTSTORE_H */
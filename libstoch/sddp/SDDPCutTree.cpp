@@ -2,7 +2,7 @@
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/version.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #include <vector>
 #include <tuple>
@@ -21,11 +21,12 @@ using namespace gs;
 namespace libstoch
 {
 
-SDDPCutTree::SDDPCutTree() {}
+SDDPCutTree::SDDPCutTree(): m_bMultiCut(false) {}
 
-SDDPCutTree::SDDPCutTree(const int &p_date, const int &p_sample,  const std::vector<double>  &p_proba, const std::vector< std::vector< std::array<int, 2> > > &p_connected, const ArrayXXd &p_nodes): m_date(p_date), m_cuts(p_nodes.cols()), m_tree(p_proba, p_connected), m_nodes(p_nodes), m_sample(p_sample) {}
+SDDPCutTree::SDDPCutTree(const int &p_date, const int &p_sample,  const std::vector<double>  &p_proba, const std::vector< std::vector< std::array<int, 2> > > &p_connected, const ArrayXXd &p_nodes,
+                         const bool &p_bMultiCut): m_date(p_date), m_cuts(p_nodes.cols()), m_tree(p_proba, p_connected), m_nodes(p_nodes), m_sample(p_sample), m_bMultiCut(p_bMultiCut) {}
 
-SDDPCutTree::SDDPCutTree(const int &p_date, const Eigen::ArrayXXd &p_nodes): m_date(p_date), m_nodes(p_nodes), m_sample(1) {}
+SDDPCutTree::SDDPCutTree(const int &p_date, const Eigen::ArrayXXd &p_nodes): m_date(p_date), m_nodes(p_nodes), m_sample(1), m_bMultiCut(false) {}
 
 vector< tuple< shared_ptr<ArrayXd>, int, int >  > SDDPCutTree::createVectorStatesParticle(const SDDPVisitedStatesTree &p_states) const
 {
@@ -84,7 +85,8 @@ void SDDPCutTree::createAndStoreCuts(const ArrayXXd &p_cutPerSim, const SDDPVisi
     for (int isto = iFirstState; isto < iLastState; ++isto)
     {
         int inode = p_states.getMeshAssociatedToState(isto); // node use for expectation
-        shared_ptr<ArrayXXd> cutArray = make_shared<ArrayXXd>(ArrayXXd::Zero(p_cutPerSim.rows(), 1));
+        // multi cut : one column per arrival node
+        shared_ptr<ArrayXXd> cutArray = make_shared<ArrayXXd>(ArrayXXd::Zero(p_cutPerSim.rows(), (m_bMultiCut ? m_tree.getNbConnected(inode) : 1)));
         ArrayXd cutExpectancy(p_cutPerSim.rows());
         for (int is = 0; is < m_tree.getNbConnected(inode); ++is)
         {
@@ -95,7 +97,7 @@ void SDDPCutTree::createAndStoreCuts(const ArrayXXd &p_cutPerSim, const SDDPVisi
                 cutExpectancy += cutPerSimProc.col(iposCut++);
             }
             cutExpectancy /= m_sample;
-            cutArray->col(0)  += m_tree.getProba(inode, is) * cutExpectancy;
+            cutArray->col(m_bMultiCut ? is : 0)  += m_tree.getProba(inode, is) * cutExpectancy;
         }
         shared_ptr<SDDPACut> cutToAdd = make_shared<SDDPACut>(cutArray);
         localCut.push_back(cutToAdd);
@@ -117,13 +119,13 @@ ArrayXXd    SDDPCutTree::getCutsAssociatedToTheParticle(int p_node) const
     ArrayXXd retCut(iStateSize + 1, m_cuts[p_node].size());
     for (size_t icut = 0; icut < m_cuts[p_node].size(); ++icut)
     {
-        retCut.col(icut) =  m_cuts[p_node][icut]->getCut()->col(0);
+        // aggregate arrival nodes for multi cuts
+        retCut.col(icut) =  m_cuts[p_node][icut]->getCut()->rowwise().sum();
     }
     return retCut;
 }
 
-
-ArrayXXd  SDDPCutTree::getCutsAssociatedToAParticle(const ArrayXd &p_aParticle) const
+int SDDPCutTree::nodeAssociatedToAParticle(const ArrayXd &p_aParticle) const
 {
     int inode = 0;
     if (m_date > 0)
@@ -146,12 +148,37 @@ ArrayXXd  SDDPCutTree::getCutsAssociatedToAParticle(const ArrayXd &p_aParticle)
             }
         }
     }
+    return inode;
+}
+
+ArrayXXd  SDDPCutTree::getCutsAssociatedToAParticle(const ArrayXd &p_aParticle) const
+{
+    int inode = nodeAssociatedToAParticle(p_aParticle);
     int iStateSize = m_cuts[inode][0]->getStateSize();
     ArrayXXd retCut(iStateSize + 1, m_cuts[inode].size());
     for (size_t icut = 0; icut < m_cuts[inode].size(); ++icut)
     {
-        retCut.col(icut) = m_cuts[inode][icut]->getCut()->col(0);
+        retCut.col(icut) = m_cuts[inode][icut]->getCut()->rowwise().sum();
     }
     return retCut;
 }
+
+vector< ArrayXXd >  SDDPCutTree::getMultiCutsAssociatedToTheParticle(int p_node) const
+{
+    if (m_cuts[p_node].size() == 0)
+        return vector< ArrayXXd >(1);
+    // number of arrival nodes given by the cut shape
+    int nbArrival = m_cuts[p_node][0]->getCut()->cols();
+    int iStateSize = m_cuts[p_node][0]->getStateSize();
+    vector< ArrayXXd > retCut(nbArrival, ArrayXXd(iStateSize + 1, m_cuts[p_node].size()));
+    for (size_t icut = 0; icut < m_cuts[p_node].size(); ++icut)
+        for (int ia = 0; ia < nbArrival; ++ia)
+            retCut[ia].col(icut) = m_cuts[p_node][icut]->getCut()->col(ia);
+    return retCut;
+}
+
+vector< ArrayXXd >  SDDPCutTree::getMultiCutsAssociatedToAParticle(const ArrayXd &p_aParticle) const
+{
+    return getMultiCutsAssociatedToTheParticle(nodeAssociatedToAParticle(p_aParticle));
+}
 }
@@ -37,6 +37,7 @@ private :
     Tree m_tree ; // to calculate conditional expectation
     Eigen::ArrayXXd   m_nodes ; ///< nodes coordinates in tree
     int m_sample ; ///< number of samples used for each particle for Monte Carlo
+    bool m_bMultiCut ; ///< if true one cut  per arrival node is kept (multi cut), otherwise one cut per node
 
 public :
 
@@ -49,7 +50,10 @@ public :
     /// \param p_proba      probability between nodes on two dates
     /// \param p_connected  connection between nodes
     /// \param p_nodes      nodes coordinates in tree
-    SDDPCutTree(const int   &p_date, const int &p_sample, const std::vector<double>  &p_proba, const std::vector< std::vector< std::array<int, 2> > > &p_connected, const Eigen::ArrayXXd &p_nodes);
+    /// \param p_bMultiCut  if true, a cut is generated for each arrival node (multi cut formulation): each column of the cut
+    ///                     corresponds to an arrival node and is weighted by its probability. Otherwise one cut is generated.
+    SDDPCutTree(const int   &p_date, const int &p_sample, const std::vector<double>  &p_proba, const std::vector< std::vector< std::array<int, 2> > > &p_connected, const Eigen::ArrayXXd &p_nodes,
+                const bool &p_bMultiCut = false);
 
     /// \brief Constructor (used in forward part)
     /// \param p_date date identifier
@@ -118,6 +122,20 @@ public :
     /// \brief get back all the cuts associated to a point (node in the tree)
     /// \param p_aParticle  a particle cooresponding to a node coordinates in the tree
     Eigen::ArrayXXd  getCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const;
+
+    /// \brief get back the cuts associated to a node number for each  arrival node (multi cut)
+    /// \param p_node  node  number
+    std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToTheParticle(int p_node) const;
+
+    /// \brief get back the cuts associated to a point (node in the tree) for each arrival node (multi cut)
+    /// \param p_aParticle  a particle cooresponding to a node coordinates in the tree
+    std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const;
+
+private :
+
+    /// \brief node number associated to a point in the tree
+    /// \param p_aParticle  a particle cooresponding to a node coordinates in the tree
+    int nodeAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const;
 };
 }
 #endif
@@ -22,13 +22,13 @@ using namespace gs;
 namespace libstoch
 {
 
-SDDPLocalCut::SDDPLocalCut() {}
+SDDPLocalCut::SDDPLocalCut(): m_bMultiCut(false) {}
 
-SDDPLocalCut::SDDPLocalCut(const int &p_date, const int &p_sample, shared_ptr< LocalRegression >  p_regressor): m_date(p_date), m_regressor(p_regressor),
-    m_cuts(p_regressor->getNbMeshTotal()), m_sample(p_sample) {}
+SDDPLocalCut::SDDPLocalCut(const int &p_date, const int &p_sample, shared_ptr< LocalRegression >  p_regressor, const bool &p_bMultiCut): m_date(p_date), m_regressor(p_regressor),
+    m_cuts(p_regressor->getNbMeshTotal()), m_sample(p_sample), m_bMultiCut(p_bMultiCut) {}
 
-SDDPLocalCut::SDDPLocalCut(const int &p_date, shared_ptr< LocalRegression >  p_regressor): m_date(p_date), m_regressor(p_regressor),
-    m_cuts(p_regressor->getNbMeshTotal()), m_sample(1) {}
+SDDPLocalCut::SDDPLocalCut(const int &p_date, shared_ptr< LocalRegression >  p_regressor, const int &p_sample, const bool &p_bMultiCut): m_date(p_date), m_regressor(p_regressor),
+    m_cuts(p_regressor->getNbMeshTotal()), m_sample(p_sample), m_bMultiCut(p_bMultiCut) {}
 
 
 vector< tuple< shared_ptr<ArrayXd>, int, int >  > SDDPLocalCut::createVectorStatesParticle(const SDDPVisitedStates &p_states) const
@@ -98,19 +98,39 @@ void SDDPLocalCut::createAndStoreCuts(const ArrayXXd &p_cutPerSim, const SDDPVis
     for (int isto = iFirstState; isto < iLastState; ++isto)
     {
         int imesh = p_states.getMeshAssociatedToState(isto); // mesh used for conditional expectation
-        ArrayXXd cutExpectancy = ArrayXXd::Zero(p_cutPerSim.rows(), m_regressor->getSimulBelongingToCell()[imesh]->size());
-        for (size_t is = 0; is < m_regressor->getSimulBelongingToCell()[imesh]->size(); ++is)
+        int nbPart = m_regressor->getSimulBelongingToCell()[imesh]->size();
+        shared_ptr<ArrayXXd> cutArray;
+        if (m_bMultiCut)
         {
-            // conditional expectation with respect to state
+            // one cut per sample : conditional expectation with respect to external for each sample
+            ArrayXXd cutSample(p_cutPerSim.rows(), nbPart);
             for (int isample = 0; isample < m_sample; ++isample)
             {
-                cutExpectancy.col(is) += cutPerSimProc.col(iposCut++);
+                for (int is = 0; is < nbPart; ++is)
+                    cutSample.col(is) = cutPerSimProc.col(iposCut + is * m_sample + isample) / m_sample;
+                ArrayXXd coeffSample = m_regressor->getCoordBasisFunctionMultipleOneCell(imesh, cutSample);
+                if (isample == 0)
+                    cutArray = make_shared<ArrayXXd>(coeffSample.rows(), coeffSample.cols() * m_sample);
+                cutArray->block(0, isample * coeffSample.cols(), coeffSample.rows(), coeffSample.cols()) = coeffSample;
+            }
+            iposCut += nbPart * m_sample;
+        }
+        else
+        {
+            ArrayXXd cutExpectancy = ArrayXXd::Zero(p_cutPerSim.rows(), nbPart);
+            for (int is = 0; is < nbPart; ++is)
+            {
+                // conditional expectation with respect to state
+                for (int isample = 0; isample < m_sample; ++isample)
+                {
+                    cutExpectancy.col(is) += cutPerSimProc.col(iposCut++);
 
+                }
+                cutExpectancy.col(is) /= m_sample;
             }
-            cutExpectancy.col(is) /= m_sample;
+            // now conditional expectation with respect to external  : create the cut
+            cutArray = make_shared<ArrayXXd>(m_regressor->getCoordBasisFunctionMultipleOneCell(imesh, cutExpectancy));
         }
-        // now conditional expectation with respect to external  : create the cut
-        shared_ptr<ArrayXXd> cutArray = make_shared<ArrayXXd>(m_regressor->getCoordBasisFunctionMultipleOneCell(imesh, cutExpectancy));
         shared_ptr<SDDPACut> cutToAdd = make_shared<SDDPACut>(cutArray);
         localCut.push_back(cutToAdd);
         meshCut.push_back(imesh);
@@ -123,6 +143,15 @@ void SDDPLocalCut::createAndStoreCuts(const ArrayXXd &p_cutPerSim, const SDDPVis
 }
 
 
+ArrayXXd SDDPLocalCut::aggregateSamples(const ArrayXXd &p_cut) const
+{
+    int nbCoeff = p_cut.cols() / m_sample;
+    ArrayXXd cut = p_cut.block(0, 0, p_cut.rows(), nbCoeff);
+    for (int isample = 1; isample < m_sample; ++isample)
+        cut += p_cut.block(0, isample * nbCoeff, p_cut.rows(), nbCoeff);
+    return cut;
+}
+
 ArrayXXd    SDDPLocalCut::getCutsAssociatedToTheParticle(int p_isim) const
 {
     // cell associated
@@ -134,7 +163,10 @@ ArrayXXd    SDDPLocalCut::getCutsAssociatedToTheParticle(int p_isim) const
     ArrayXXd retCut(iStateSize + 1, m_cuts[ncell].size());
     for (size_t icut = 0; icut < m_cuts[ncell].size(); ++icut)
     {
-        retCut.col(icut) = m_regressor->getValuesOneCell(aParticule, ncell, *m_cuts[ncell][icut]->getCut());
+        if (m_bMultiCut)
+            retCut.col(icut) = m_regressor->getValuesOneCell(aParticule, ncell, aggregateSamples(*m_cuts[ncell][icut]->getCut()));
+        else
+            retCut.col(icut) = m_regressor->getValuesOneCell(aParticule, ncell, *m_cuts[ncell][icut]->getCut());
     }
     return retCut;
 }
@@ -149,10 +181,46 @@ ArrayXXd    SDDPLocalCut::getCutsAssociatedToAParticle(const ArrayXd &p_aParticl
     ArrayXXd retCut(iStateSize + 1, m_cuts[ncell].size());
     for (size_t icut = 0; icut < m_cuts[ncell].size(); ++icut)
     {
-        retCut.col(icut) = m_regressor->getValuesOneCell(p_aParticle, ncell, *m_cuts[ncell][icut]->getCut());
+        if (m_bMultiCut)
+            retCut.col(icut) = m_regressor->getValuesOneCell(p_aParticle, ncell, aggregateSamples(*m_cuts[ncell][icut]->getCut()));
+        else
+            retCut.col(icut) = m_regressor->getValuesOneCell(p_aParticle, ncell, *m_cuts[ncell][icut]->getCut());
+    }
+    return retCut;
+}
+
+vector< ArrayXXd > SDDPLocalCut::getMultiCutsOneCell(const ArrayXd &p_aParticle, const int &p_cell) const
+{
+    vector< ArrayXXd > retCut(m_sample);
+    if (m_cuts[p_cell].size() == 0)
+        return retCut;
+    int iStateSize = m_cuts[p_cell][0]->getStateSize();
+    for (int isample = 0; isample < m_sample; ++isample)
+        retCut[isample].resize(iStateSize + 1, m_cuts[p_cell].size());
+    for (size_t icut = 0; icut < m_cuts[p_cell].size(); ++icut)
+    {
+        const ArrayXXd &cut = *m_cuts[p_cell][icut]->getCut();
+        int nbCoeff = cut.cols() / m_sample;
+        for (int isample = 0; isample < m_sample; ++isample)
+            retCut[isample].col(icut) = m_regressor->getValuesOneCell(p_aParticle, p_cell, cut.block(0, isample * nbCoeff, cut.rows(), nbCoeff));
     }
     return retCut;
 }
 
+vector< ArrayXXd > SDDPLocalCut::getMultiCutsAssociatedToTheParticle(int p_isim) const
+{
+    if (!m_bMultiCut)
+        return vector< ArrayXXd >(1, getCutsAssociatedToTheParticle(p_isim));
+    ArrayXd aParticule = ((m_regressor->getNbSimul() > 0) ? m_regressor->getParticle(p_isim) : ArrayXd());
+    return getMultiCutsOneCell(aParticule, m_regressor->getCellAssociatedToSim(p_isim));
+}
+
+vector< ArrayXXd > SDDPLocalCut::getMultiCutsAssociatedToAParticle(const ArrayXd &p_aParticle) const
+{
+    if (!m_bMultiCut)
+        return vector< ArrayXXd >(1, getCutsAssociatedToAParticle(p_aParticle));
+    return getMultiCutsOneCell(p_aParticle, m_regressor->getMeshNumberAssociatedTo(p_aParticle));
+}
+
 
 }
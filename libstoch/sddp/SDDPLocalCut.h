@@ -40,7 +40,16 @@ private :
     std::shared_ptr<LocalRegression> m_regressor ; ///< regressor object
     std::vector< std::vector<  std::shared_ptr<SDDPACut> > > m_cuts; ///< For each mesh of conditional expectation , give a list of all cuts
     int m_sample ; ///< number of samples used for each particle
+    bool m_bMultiCut ; ///< if true, one cut per sample is kept (multi cut), otherwise  samples are averaged in one cut
 
+    /// \brief Aggregate the cuts of all samples in one cut (sum of the sample coefficients)
+    /// \param p_cut   cut coefficients stored
+    Eigen::ArrayXXd aggregateSamples(const Eigen::ArrayXXd &p_cut) const;
+
+    /// \brief Cuts of each sample in a cell (multi cut)
+    /// \param p_aParticle   particle
+    /// \param p_cell        cell associated to the particle
+    std::vector< Eigen::ArrayXXd > getMultiCutsOneCell(const Eigen::ArrayXd &p_aParticle, const int &p_cell) const;
 
 
 public :
@@ -52,12 +61,17 @@ public :
     /// \param p_date date identifier
     /// \param p_sample  number of sample for expectation
     /// \param p_regressor regressor
-    SDDPLocalCut(const int   &p_date, const int &p_sample, std::shared_ptr<LocalRegression> p_regressor);
+    /// \param p_bMultiCut  if true, a cut is generated for each sample  (multi cut formulation): coefficients of the cut of each sample
+    ///                     (weighted by the sample probability) are stored one after the other.
+    ///                     Otherwise samples are averaged in one single cut.
+    SDDPLocalCut(const int   &p_date, const int &p_sample, std::shared_ptr<LocalRegression> p_regressor, const bool &p_bMultiCut = false);
 
     /// \brief Constructor (used in forward part)
     /// \param p_date date identifier
     /// \param p_regressor regressor
-    SDDPLocalCut(const int   &p_date, std::shared_ptr<LocalRegression> p_regressor);
+    /// \param p_sample    number of sample used to generate the cuts (only used by multi cuts)
+    /// \param p_bMultiCut true if cuts have been generated with the multi cut formulation
+    SDDPLocalCut(const int   &p_date, std::shared_ptr<LocalRegression> p_regressor, const int &p_sample = 1, const bool &p_bMultiCut = false);
 
 
     /// \brief create a vector of (stocks, particle) for LP to solve
@@ -97,6 +111,16 @@ public :
 #endif
     }
 
+    /// \brief Add cuts already calculated (for example by another group of processors)
+    /// \param p_localCut   cuts to add
+    /// \param p_meshCut    for each cut, the mesh  associated
+    /// \param p_ar         binary archive used to store cuts (no storage if null)
+    inline void addCuts(const std::vector< std::shared_ptr<SDDPACut> > &p_localCut, const std::vector<int> &p_meshCut,
+                        const std::shared_ptr<gs::BinaryFileArchive>   &p_ar)
+    {
+        storeCuts(p_localCut, p_meshCut, "CutMesh", m_cuts, p_ar, m_regressor->getNbMeshTotal(), m_date);
+    }
+
     /// \brief get back all cuts associated to a mesh
     inline const std::vector< std::shared_ptr< SDDPACut > >   &getCutsForAMesh(const int &p_mesh) const
     {
@@ -121,6 +145,10 @@ public :
     {
         return m_regressor-> getDimension();
     }
+    inline bool isMultiCut() const
+    {
+        return m_bMultiCut;
+    }
     ///@}
 
     /// \brief get back all the cuts associated to a particle number (state size by the number of cuts)
@@ -130,6 +158,13 @@ public :
     /// \param p_aParticle  a particle
     Eigen::ArrayXXd  getCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const;
 
+    /// \brief get back the cuts associated to a particle number for each sample (only one sample if cuts are aggregated)
+    /// \param p_isim  particle number
+    std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToTheParticle(int p_isim) const;
+    /// \brief get back the cuts associated to a particle for each sample (only one sample if cuts are aggregated)
+    /// \param p_aParticle  a particle
+    std::vector< Eigen::ArrayXXd > getMultiCutsAssociatedToAParticle(const Eigen::ArrayXd &p_aParticle) const;
+
 };
 }
 #endif
@@ -0,0 +1,137 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SDDPREGRESSORSTORE_H
+#define SDDPREGRESSORSTORE_H
+#include <cstdio>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include "geners/BinaryFileArchive.hh"
+#include "geners/GenericIO.hh"
+#include "geners/Reference.hh"
+
+/** \file SDDPRegressorStore.h
+ * \brief Regressors of all dates used by the SDDP sweeps.
+ *        Regressors are created once by createRegressorsAndInitialStates and never change : they are read once
+ *        from the regressor archive at the initialization instead of being read at each date of each iteration.
+ *        For very long horizons regressors can be kept serialized in a flat backing file (one block per date
+ *        read with a single positioned read) : only the last regressors used are kept in memory.
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \class SDDPRegressorStore SDDPRegressorStore.h
+/// Regressors of all dates (except the last one) shared by the backward and forward sweeps
+template< class LocalRegressionForSDDP >
+class SDDPRegressorStore
+{
+private :
+
+    int m_nbDate ; ///< number of dates with a regressor
+    std::vector< std::shared_ptr< LocalRegressionForSDDP > > m_regressors ; ///< regressors for each date (resident store)
+    std::string m_nameBacking ; ///< backing file name (empty if the store is resident)
+    std::vector< std::streamoff > m_offset ; ///< for each date position of the serialized regressor in the backing file (last is the file size)
+    int m_nbResident ; ///< number of regressors kept in memory with a backing file
+    mutable std::list< std::pair< int, std::shared_ptr< LocalRegressionForSDDP > > > m_cache ; ///< regressors recently used (most recent first)
+    mutable std::mutex m_mutex ; ///< protect the cache
+
+    /// \brief read a regressor in the backing file
+    std::shared_ptr< LocalRegressionForSDDP > readBacking(const int &p_idate) const
+    {
+        std::ifstream file(m_nameBacking.c_str(), std::ios::binary);
+        std::string buffer(m_offset[p_idate + 1] - m_offset[p_idate], ' ');
+        file.seekg(m_offset[p_idate]);
+        file.read(&buffer[0], buffer.size());
+        if (!file)
+            throw std::runtime_error("SDDPRegressorStore : failed to read regressor in " + m_nameBacking);
+        std::istringstream stream(buffer);
+        return std::shared_ptr< LocalRegressionForSDDP >(gs::read_item< LocalRegressionForSDDP >(stream));
+    }
+
+public :
+
+    /// \brief Constructor : all the regressors are read in the archive
+    /// \param p_archiveRegressor  archive with regressor objects (as written by createRegressorsAndInitialStates : last date first)
+    /// \param p_nbDate            number of dates with a regressor (number of dates minus one)
+    /// \param p_nameBacking       if not empty, regressors are stored serialized in this file instead of being kept in memory
+    /// \param p_nbResident        number of regressors kept in memory with a backing file
+    SDDPRegressorStore(gs::BinaryFileArchive &p_archiveRegressor, const int &p_nbDate, const std::string &p_nameBacking = "",
+                       const int &p_nbResident = 2): m_nbDate(p_nbDate), m_nameBacking(p_nameBacking), m_nbResident(std::max(p_nbResident, 1))
+    {
+        gs::Reference< LocalRegressionForSDDP > refRegressor(p_archiveRegressor, "Regressor", "Top");
+        if (m_nameBacking.empty())
+        {
+            m_regressors.resize(m_nbDate);
+            for (int idate = 0; idate < m_nbDate; ++idate)
+                m_regressors[idate] = std::shared_ptr< LocalRegressionForSDDP >(refRegressor.get(m_nbDate - 1 - idate));
+        }
+        else
+        {
+            std::ofstream file(m_nameBacking.c_str(), std::ios::binary | std::ios::trunc);
+            m_offset.resize(m_nbDate + 1);
+            m_offset[0] = 0;
+            for (int idate = 0; idate < m_nbDate; ++idate)
+            {
+                std::shared_ptr< LocalRegressionForSDDP > regressor(refRegressor.get(m_nbDate - 1 - idate));
+                std::ostringstream stream;
+                gs::write_item(stream, *regressor);
+                std::string buffer = stream.str();
+                file.write(buffer.data(), buffer.size());
+                m_offset[idate + 1] = m_offset[idate] + buffer.size();
+            }
+            if (!file)
+                throw std::runtime_error("SDDPRegressorStore : failed to write backing file " + m_nameBacking);
+        }
+    }
+
+    SDDPRegressorStore(const SDDPRegressorStore &) = delete;
+    SDDPRegressorStore &operator=(const SDDPRegressorStore &) = delete;
+
+    /// \brief remove the backing file
+    ~SDDPRegressorStore()
+    {
+        if (!m_nameBacking.empty())
+            std::remove(m_nameBacking.c_str());
+    }
+
+    /// \brief get back the regressor of a date
+    /// \param p_idate  date index (0 for the first date)
+    std::shared_ptr< LocalRegressionForSDDP > getRegressor(const int &p_idate) const
+    {
+        if (m_nameBacking.empty())
+            return m_regressors[p_idate];
+        std::lock_guard< std::mutex > lock(m_mutex);
+        for (auto iter = m_cache.begin(); iter != m_cache.end(); ++iter)
+            if (iter->first == p_idate)
+            {
+                m_cache.splice(m_cache.begin(), m_cache, iter);
+                return m_cache.front().second;
+            }
+        m_cache.emplace_front(p_idate, readBacking(p_idate));
+        if (static_cast<int>(m_cache.size()) > m_nbResident)
+            m_cache.pop_back();
+        return m_cache.front().second;
+    }
+
+    /// \brief number of dates with a regressor
+    inline int getNbDate() const
+    {
+        return m_nbDate;
+    }
+
+    /// \brief true if all regressors are kept in memory
+    inline bool isResident() const
+    {
+        return m_nameBacking.empty();
+    }
+};
+}
+#endif /* SDDPREGRESSORSTORE_H */
@@ -39,6 +39,17 @@ void SDDPVisitedStates::addVisitedState(const shared_ptr< ArrayXd > &p_state, co
     }
 }
 
+void SDDPVisitedStates::addVisitedStateLocal(const shared_ptr< ArrayXd > &p_state, const ArrayXd &p_particle, const LocalRegression &p_regressor)
+{
+    int ncell = p_regressor.getMeshNumberAssociatedTo(p_particle);
+    if (isStateNotAlreadyVisited(p_state, ncell))
+    {
+        m_meshToState[ncell].push_back(m_stateVisited.size());
+        m_stateVisited.push_back(p_state);
+        m_associatedMesh.push_back(ncell);
+    }
+}
+
 void SDDPVisitedStates::addVisitedStateForAll(const shared_ptr< ArrayXd > &p_state, const LocalRegression &p_regressor)
 {
     int nbCell = p_regressor.getNbMeshTotal();
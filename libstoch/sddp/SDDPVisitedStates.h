@@ -38,6 +38,13 @@ public :
     /// \param  p_regressor     regressor used
     void addVisitedState(const std::shared_ptr< Eigen::ArrayXd > &p_state, const Eigen::ArrayXd &p_particle, const LocalRegression   &p_regressor);
 
+    /// \brief add a state without any synchronization between threads
+    ///        Used to fill a buffer local to a thread : buffers are then merged with mergeBuffers
+    /// \param  p_state state to add
+    /// \param  p_particle particle  used for conditional cut
+    /// \param  p_regressor     regressor used
+    void addVisitedStateLocal(const std::shared_ptr< Eigen::ArrayXd > &p_state, const Eigen::ArrayXd &p_particle, const LocalRegression   &p_regressor);
+
     /// \brief add a state for particles
     /// \param  p_state state to add
     /// \param  p_regressor     regressor used
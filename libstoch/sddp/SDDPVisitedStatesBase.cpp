@@ -12,6 +12,7 @@
 #include <iostream>
 #include <Eigen/Dense>
 #include "libstoch/core/utils/constant.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/sddp/SDDPVisitedStatesBase.h"
 
 using namespace Eigen;
@@ -52,6 +53,37 @@ void  SDDPVisitedStatesBase::recalculateVisitedState()
 {
     std::vector< std::shared_ptr< Eigen::ArrayXd > > stateVisited  = m_stateVisited ;
     std::vector<int> associatedMesh = m_associatedMesh;
+    // candidates states for each mesh (in storage order)
+    vector< vector<int> > candidates(m_meshToState.size());
+    for (size_t i = 0; i < associatedMesh.size(); ++i)
+        candidates[associatedMesh[i]].push_back(i);
+    // meshes are independent : eliminate doubles in parallel
+    vector<int> bKeep(associatedMesh.size(), 0);
+    int imesh;
+    #pragma omp parallel for schedule(dynamic) private(imesh)
+    for (imesh = 0; imesh < static_cast<int>(candidates.size()); ++imesh)
+    {
+        vector<int> kept;
+        kept.reserve(candidates[imesh].size());
+        for (size_t ic = 0; ic < candidates[imesh].size(); ++ic)
+        {
+            const ArrayXd &state = *stateVisited[candidates[imesh][ic]];
+            bool bNew = true;
+            for (size_t ik = 0; ik < kept.size(); ++ik)
+                // as in isStateNotAlreadyVisited, an empty state is never considered as already visited
+                if ((state.size() > 0) && (((*stateVisited[kept[ik]]) - state).abs().maxCoeff() <= tiny))
+                {
+                    bNew = false;
+                    break;
+                }
+            if (bNew)
+            {
+                kept.push_back(candidates[imesh][ic]);
+                bKeep[candidates[imesh][ic]] = 1;
+            }
+        }
+    }
+    // renumbering keeping storage order
     m_stateVisited.clear();
     m_associatedMesh.clear();
     for (size_t i = 0; i < m_meshToState.size(); ++i)
@@ -59,7 +91,7 @@ void  SDDPVisitedStatesBase::recalculateVisitedState()
         m_meshToState[i].clear();
     }
     for (size_t i = 0; i < associatedMesh.size(); ++i)
-        if (isStateNotAlreadyVisited(stateVisited[i], associatedMesh[i]))
+        if (bKeep[i])
         {
             m_meshToState[associatedMesh[i] ].push_back(m_stateVisited.size());
             m_stateVisited.push_back(stateVisited[i]);
@@ -67,6 +99,21 @@ void  SDDPVisitedStatesBase::recalculateVisitedState()
         }
 }
 
+void SDDPVisitedStatesBase::mergeBuffers(const vector< shared_ptr< SDDPVisitedStatesBase > > &p_buffers)
+{
+    size_t nbStates = m_stateVisited.size();
+    for (size_t ib = 0; ib < p_buffers.size(); ++ib)
+        nbStates += p_buffers[ib]->getStateSize();
+    m_stateVisited.reserve(nbStates);
+    m_associatedMesh.reserve(nbStates);
+    for (size_t ib = 0; ib < p_buffers.size(); ++ib)
+    {
+        m_stateVisited.insert(m_stateVisited.end(), p_buffers[ib]->getStateVisited().begin(), p_buffers[ib]->getStateVisited().end());
+        m_associatedMesh.insert(m_associatedMesh.end(), p_buffers[ib]->getAssociatedMesh().begin(), p_buffers[ib]->getAssociatedMesh().end());
+    }
+    recalculateVisitedState();
+}
+
 void SDDPVisitedStatesBase::print() const
 {
     cout << "States visited " << endl ;
@@ -77,6 +124,7 @@ void SDDPVisitedStatesBase::print() const
 #ifdef USE_MPI
 void SDDPVisitedStatesBase::sendToRoot(const boost::mpi::communicator &p_world)
 {
+    InstrumentationTimer timerCommunication(instCommunication);
     vector<int>  meshVisited(m_associatedMesh);
     gatherv(p_world, meshVisited.data(), meshVisited.size(), m_associatedMesh, 0);
     ArrayXd  state;
@@ -86,6 +134,8 @@ void SDDPVisitedStatesBase::sendToRoot(const boost::mpi::communicator &p_world)
         state.segment(i * isizeState, isizeState) = *(m_stateVisited[i]);
     ArrayXd stateGather;
     gatherv(p_world, state.data(), state.size(), stateGather, 0);
+    timerCommunication.stop();
+    instrumentBytes(meshVisited.size() * sizeof(int) + state.size() * sizeof(double));
     if (p_world.rank() == 0)
     {
         int isizeState = m_stateVisited[0]->size();
@@ -101,6 +151,7 @@ void SDDPVisitedStatesBase::sendToRoot(const boost::mpi::communicator &p_world)
 
 void SDDPVisitedStatesBase::sendFromRoot(const boost::mpi::communicator &p_world)
 {
+    InstrumentationTimer timerCommunication(instCommunication);
     // Add this because Bug on mac (nullify existing  vectors)
     if (p_world.rank() != 0)
     {
@@ -140,6 +191,13 @@ void SDDPVisitedStatesBase::sendFromRoot(const boost::mpi::communicator &p_world
 #endif
     for (size_t i = 0; i < m_meshToState.size(); ++i)
         boost::mpi:: broadcast(p_world,  m_meshToState[i], 0);
+    // bytes received (or sent by root)
+    long nbBytes = m_associatedMesh.size() * sizeof(int);
+    for (size_t i = 0; i < m_stateVisited.size(); ++i)
+        nbBytes += m_stateVisited[i]->size() * sizeof(double);
+    for (size_t i = 0; i < m_meshToState.size(); ++i)
+        nbBytes += m_meshToState[i].size() * sizeof(int);
+    instrumentBytes(nbBytes);
 }
 #endif
 }
@@ -2,6 +2,8 @@
 #ifndef SDDPVISITEDSTATESBASE_H
 #define SDDPVISITEDSTATESBASE_H
 #include <vector>
+#include <memory>
+#include <Eigen/Dense>
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #endif
@@ -28,6 +30,7 @@ protected :
     bool isStateNotAlreadyVisited(const std::shared_ptr< Eigen::ArrayXd > &p_state,  const int  &p_point) const ;
 
     /// \brief  Eliminate doubling states
+    ///         Meshes are treated in parallel, the order of the remaining states is kept
     void recalculateVisitedState();
 
 
@@ -71,6 +74,11 @@ public:
     }
     //@}
 
+    /// \brief Merge some sets of visited states (for example filled by different threads) with current one
+    ///        and eliminate doubling states
+    /// \param p_buffers  sets of states to add (same number of meshes as current object)
+    void mergeBuffers(const std::vector< std::shared_ptr< SDDPVisitedStatesBase > > &p_buffers);
+
     ///\brief print function for debug
     void print() const;
 
@@ -7,12 +7,15 @@
 #include <boost/mpi.hpp>
 #endif
 #include <map>
+#include <array>
 #include <memory>
 #include <boost/timer/timer.hpp>
 #include <Eigen/Dense>
 #include "geners/Record.hh"
 #include "libstoch/sddp/SDDPFinalCut.h"
 #include "libstoch/sddp/OptimizerSDDPBase.h"
+#include "libstoch/sddp/SDDPRegressorStore.h"
+#include "libstoch/sddp/SDDPAdaptiveSchedule.h"
 #include "libstoch/sddp/backwardSDDP.h"
 #include "libstoch/sddp/forwardSDDP.h"
 #include "libstoch/sddp/SDDPFinalCut.h"
@@ -26,6 +29,56 @@ namespace libstoch
 {
 
 
+/// \brief Create the regressors for all dates and a first set of admissible states (only  one processor should call it)
+/// \param  p_optimizer           defines the optimiser necessary to optimize a step for one simulation solving a LP
+/// \param  p_initialState        initial state at the beginning of simulation
+/// \param  p_dates               vector of exercised dates, last date corresponds to the final cut object
+/// \param  p_meshForReg          number of mesh for regression in each direction
+/// \param  p_nameRegressor       name of the archive to store regressors
+/// \param  p_nameVisitedStates   name of the archive to store visited states
+template<  class LocalRegressionForSDDP>
+void createRegressorsAndInitialStates(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
+                                      const Eigen::ArrayXd &p_initialState,
+                                      const Eigen::ArrayXd &p_dates,
+                                      const Eigen::ArrayXi &p_meshForReg,
+                                      const std::string &p_nameRegressor,
+                                      const std::string &p_nameVisitedStates)
+{
+    std::shared_ptr<SimulatorSDDPBase> simulatorForOptim = p_optimizer->getSimulatorBackward();
+    // create archive for regressors
+    gs::BinaryFileArchive archiveForRegressor(p_nameRegressor.c_str(), "w");
+    // create a first set of admissible states
+    gs::BinaryFileArchive archiveForInitialState(p_nameVisitedStates.c_str(), "w");
+    // vector of states
+    std::vector< std::unique_ptr< SDDPVisitedStates > > vecSetOfStates(p_dates.size() - 1);
+    // create regressor : each date except the last
+    for (int idate = p_dates.size() - 2; idate >  0; --idate)
+    {
+        simulatorForOptim->updateDateIndex(idate);
+        // initial regressor
+        Eigen::ArrayXXd particlesCurrent = simulatorForOptim->getParticles();
+        LocalRegressionForSDDP regCurrent(false, particlesCurrent, p_meshForReg);
+        archiveForRegressor << gs::Record(regCurrent, "Regressor", "Top");
+        std::unique_ptr< SDDPVisitedStates> setOfStates = std::make_unique<SDDPVisitedStates>(regCurrent.getNbMeshTotal());
+        // offset  in admissible dates
+        std::shared_ptr< Eigen::ArrayXd > anAdmissibleState = std::make_shared<Eigen::ArrayXd>(p_optimizer->oneAdmissibleState(p_dates(idate)));
+        setOfStates->addVisitedStateForAll(anAdmissibleState, regCurrent);
+        vecSetOfStates[idate] = move(setOfStates);
+    }
+    simulatorForOptim->updateDateIndex(0);
+    Eigen::ArrayXXd particlesInit = simulatorForOptim->getParticles();
+    LocalRegressionForSDDP regInit(true, particlesInit, p_meshForReg);
+    archiveForRegressor << gs::Record(regInit, "Regressor", "Top");
+    std::unique_ptr< SDDPVisitedStates> setOfStates = std::make_unique<SDDPVisitedStates>(1);
+    std::shared_ptr< Eigen::ArrayXd > anAdmissibleState =  std::make_shared< Eigen::ArrayXd >(p_initialState);
+    setOfStates->addVisitedStateForAll(anAdmissibleState, regInit);
+    vecSetOfStates[0] = move(setOfStates);
+
+    // archive initial admissible states (forward order)
+    for (size_t idate = 0; idate <= vecSetOfStates.size() - 1; ++idate)
+        archiveForInitialState << gs::Record(*vecSetOfStates[idate], "States", "Top");
+}
+
 /// \brief Achieve forward and backward sweep by SDDP
 /// \param  p_optimizer           defines the optimiser necessary to optimize a step for one simulation solving a LP
 /// \param  p_nbSimulCheckForSimu defines the number of simulations to check convergence
@@ -42,6 +95,11 @@ namespace libstoch
 /// \param  p_outputStream        dump all print messages
 /// \param  p_world               MPI communicator
 /// \param  p_bPrintTime          if true print time at each backward and forward step
+/// \param  p_bLocalStateBuffer   if true, visited states are stored in buffers local to threads during the forward sweep
+/// \param  p_bMultiCut           if true, one cut per sample is kept in the backward sweep (multi cut), otherwise samples are averaged (single cut)
+/// \param  p_nameRegressorBacking if not empty, regressors are kept serialized in this file (suffixed by the processor number) instead of in memory
+/// \param  p_schedule            if defined, the number of forward simulations is adapted at each iteration and the convergence is checked
+///                               at each iteration with the forward sweep generating the visited states (p_nbSimulCheckForSimu and p_nStepConv are not used)
 /// \return backward and forward valorization
 template<  class LocalRegressionForSDDP>
 std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
@@ -60,7 +118,11 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
 #ifdef USE_MPI
         const boost::mpi::communicator &p_world,
 #endif
-        bool  p_bPrintTime = false)
+        bool  p_bPrintTime = false,
+        bool  p_bLocalStateBuffer = false,
+        bool  p_bMultiCut = false,
+        const std::string &p_nameRegressorBacking = "",
+        const std::shared_ptr<SDDPAdaptiveSchedule> &p_schedule = std::shared_ptr<SDDPAdaptiveSchedule>())
 {
     // get back simulators
     std::shared_ptr<SimulatorSDDPBase> simulatorForOptim = p_optimizer->getSimulatorBackward();
@@ -76,40 +138,7 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
     boost::timer::cpu_timer globalTimer;
 
     if (iTask == 0)
-    {
-        // create archive for regressors
-        gs::BinaryFileArchive archiveForRegressor(p_nameRegressor.c_str(), "w");
-        // create a first set of admissible states
-        gs::BinaryFileArchive archiveForInitialState(p_nameVisitedStates.c_str(), "w");
-        // vector of states
-        std::vector< std::unique_ptr< SDDPVisitedStates > > vecSetOfStates(p_dates.size() - 1);
-        // create regressor : each date except the last
-        for (int idate = p_dates.size() - 2; idate >  0; --idate)
-        {
-            simulatorForOptim->updateDateIndex(idate);
-            // initial regressor
-            Eigen::ArrayXXd particlesCurrent = simulatorForOptim->getParticles();
-            LocalRegressionForSDDP regCurrent(false, particlesCurrent, p_meshForReg);
-            archiveForRegressor << gs::Record(regCurrent, "Regressor", "Top");
-            std::unique_ptr< SDDPVisitedStates> setOfStates = std::make_unique<SDDPVisitedStates>(regCurrent.getNbMeshTotal());
-            // offset  in admissible dates
-            std::shared_ptr< Eigen::ArrayXd > anAdmissibleState = std::make_shared<Eigen::ArrayXd>(p_optimizer->oneAdmissibleState(p_dates(idate)));
-            setOfStates->addVisitedStateForAll(anAdmissibleState, regCurrent);
-            vecSetOfStates[idate] = move(setOfStates);
-        }
-        simulatorForOptim->updateDateIndex(0);
-        Eigen::ArrayXXd particlesInit = simulatorForOptim->getParticles();
-        LocalRegressionForSDDP regInit(true, particlesInit, p_meshForReg);
-        archiveForRegressor << gs::Record(regInit, "Regressor", "Top");
-        std::unique_ptr< SDDPVisitedStates> setOfStates = std::make_unique<SDDPVisitedStates>(1);
-        std::shared_ptr< Eigen::ArrayXd > anAdmissibleState =  std::make_shared< Eigen::ArrayXd >(p_initialState);
-        setOfStates->addVisitedStateForAll(anAdmissibleState, regInit);
-        vecSetOfStates[0] = move(setOfStates);
-
-        // archive initial admissible states (forward order)
-        for (size_t idate = 0; idate <= vecSetOfStates.size() - 1; ++idate)
-            archiveForInitialState << gs::Record(*vecSetOfStates[idate], "States", "Top");
-    }
+        createRegressorsAndInitialStates<LocalRegressionForSDDP>(p_optimizer, p_initialState, p_dates, p_meshForReg, p_nameRegressor, p_nameVisitedStates);
 
 #ifdef USE_MPI
     p_world.barrier();
@@ -118,8 +147,13 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
     p_iter = 0;
     double accuracy = p_accuracy;
     p_accuracy = 1e10;
-    // archive to read regressor : currently all processor reads the regression
-    std::shared_ptr<gs::BinaryFileArchive> archiveReadRegressor = std::make_shared<gs::BinaryFileArchive>(p_nameRegressor.c_str(), "r");
+    // regressors read once for all iterations : currently all processor reads the regression
+    std::string nameRegressorBacking = (p_nameRegressorBacking.empty() ? p_nameRegressorBacking : p_nameRegressorBacking + "_" + std::to_string(iTask));
+    std::shared_ptr< SDDPRegressorStore<LocalRegressionForSDDP> > regressors;
+    {
+        gs::BinaryFileArchive archiveReadRegressor(p_nameRegressor.c_str(), "r");
+        regressors = std::make_shared< SDDPRegressorStore<LocalRegressionForSDDP> >(archiveReadRegressor, p_dates.size() - 1, nameRegressorBacking);
+    }
     // archive for cuts read write
     std::shared_ptr<gs::BinaryFileArchive> archiveForCuts;
 
@@ -134,6 +168,8 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
     int istep = 0;
     // store evolution of convergence
     double backwardMinusForwardPrev = 0;
+    // number of forward simulations modified by the adaptive schedule
+    int nbSimulForwardInit = simulatorForSim->getNbSimul();
     while ((accuracy < p_accuracy) && (p_iter < iterMax))
     {
         // increase step
@@ -148,12 +184,12 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
 #endif
         // backward sweep
         backwardValue = backwardSDDP<LocalRegressionForSDDP>(p_optimizer, simulatorForOptim, p_dates,
-                        p_initialState, p_finalCut, archiveReadRegressor,
+                        p_initialState, p_finalCut, *regressors,
                         p_nameVisitedStates, archiveForCuts,
 #ifdef USE_MPI
                         p_world,
 #endif
-                        false);
+                        false, p_bMultiCut);
         localTimer.stop();
         if (p_bPrintTime && (iTask == 0))
         {
@@ -170,12 +206,14 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
 
         localTimer.start();
 
-        forwardSDDP<LocalRegressionForSDDP>(p_optimizer, simulatorForSim, p_dates, p_initialState, p_finalCut, bIncreaseCut, archiveReadRegressor,
-                                            archiveForCuts, p_nameVisitedStates
+        if (p_schedule)
+            simulatorForSim->updateSimulationNumberAndResetTime(p_schedule->getNbSimul());
+        std::pair<double, double> forwardMeanAndVariance = forwardSDDPMeanAndVariance<LocalRegressionForSDDP>(p_optimizer, simulatorForSim, p_dates, p_initialState, p_finalCut, bIncreaseCut, *regressors,
+                archiveForCuts, p_nameVisitedStates
 #ifdef USE_MPI
-                                            , p_world
+                , p_world
 #endif
-                                           );
+                , p_bLocalStateBuffer, std::shared_ptr<SDDPCutStore>(), p_bMultiCut);
 
         localTimer.stop();
         if (p_bPrintTime && (iTask == 0))
@@ -186,19 +224,33 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
 #ifdef USE_MPI
         p_world.barrier();
 #endif
-        if ((istep == p_nStepConv) || (p_iter == 0))
+        if (p_schedule)
+        {
+            // statistical gap test with the forward sweep of the iteration
+            int nbSimulForward = simulatorForSim->getNbSimul();
+            forwardValueForConv = forwardMeanAndVariance.first;
+            p_schedule->update(forwardMeanAndVariance.first, forwardMeanAndVariance.second, accuracy);
+            p_accuracy = p_schedule->getAccuracy(backwardValue);
+            std::array<double, 2> interval = p_schedule->getConfidenceInterval();
+            if (iTask == 0)
+            {
+                p_outputStream << " ACCURACY " << p_accuracy  << " Backward " << backwardValue << " Forward " << forwardValueForConv << " confidence interval [" << interval[0] << "," << interval[1] << "]";
+                p_outputStream << " nb simulations " << nbSimulForward << " p_iter "  << p_iter << " GlobalTimer " << globalTimer.format() << std::endl ;
+            }
+        }
+        else if ((istep == p_nStepConv) || (p_iter == 0))
         {
             istep = 0;
             int oldParticleNb = simulatorForSim->getNbSimul();
             simulatorForSim->updateSimulationNumberAndResetTime(p_nbSimulCheckForSimu);
             bIncreaseCut = false;
             forwardValueForConv =  forwardSDDP<LocalRegressionForSDDP>(p_optimizer, simulatorForSim, p_dates,
-                                   p_initialState, p_finalCut, bIncreaseCut, archiveReadRegressor,
+                                   p_initialState, p_finalCut, bIncreaseCut, *regressors,
                                    archiveForCuts, p_nameVisitedStates
 #ifdef USE_MPI
                                    , p_world
 #endif
-                                                                      );
+                                   , false, std::shared_ptr<SDDPCutStore>(), p_bMultiCut);
             if (forwardValueForConv != 0.0)
                 p_accuracy = fabs((backwardValue - forwardValueForConv) / forwardValueForConv);
             else
@@ -239,6 +291,8 @@ std::pair<double, double> backwardForwardSDDP(const std::shared_ptr<OptimizerSDD
         }
         p_iter += 1;
     }
+    if (p_schedule)
+        simulatorForSim->updateSimulationNumberAndResetTime(nbSimulForwardInit);
 
 #ifdef USE_MPI
     p_world.barrier();
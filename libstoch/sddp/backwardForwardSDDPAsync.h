@@ -0,0 +1,246 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef BACKWARDFORWARDSDDPASYNC_H
+#define BACKWARDFORWARDSDDPASYNC_H
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#include <memory>
+#include <vector>
+#include <boost/timer/timer.hpp>
+#include <Eigen/Dense>
+#include "geners/Reference.hh"
+#include "libstoch/sddp/SDDPFinalCut.h"
+#include "libstoch/sddp/SDDPLocalCut.h"
+#include "libstoch/sddp/SDDPCutStore.h"
+#include "libstoch/sddp/OptimizerSDDPBase.h"
+#include "libstoch/sddp/SDDPRegressorStore.h"
+#include "libstoch/sddp/backwardSDDPAsync.h"
+#include "libstoch/sddp/forwardSDDP.h"
+#include "libstoch/sddp/backwardForwardSDDP.h"
+
+/** \file backwardForwardSDDPAsync.h
+ * \brief alternates forward and backward resolution, the backward resolution using possibly stale cuts.
+ *        Cuts are kept in memory by all processors and only written in the archive.
+ *        Compared to backwardForwardSDDP, the synchronization at each date of the backward and forward sweeps
+ *        (cuts loading and conditional expectation) is replaced by one synchronization by wave of dates.
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+
+/// \brief Achieve forward and backward sweep by SDDP with stale cuts in the backward part
+/// \param  p_optimizer           defines the optimiser necessary to optimize a step for one simulation solving a LP
+/// \param  p_nbSimulCheckForSimu defines the number of simulations to check convergence
+/// \param  p_initialState        initial state at the beginning of simulation
+/// \param  p_finalCut            object of final cuts
+/// \param  p_dates               vector of exercised dates, last date corresponds to the final cut object
+/// \param  p_meshForReg          number of mesh for regression in each direction
+/// \param  p_nameRegressor       name of the archive to store regressors
+/// \param  p_nameCut             name of the archive to store cuts
+/// \param  p_nameVisitedStates   name of the archive to store visited states
+/// \param  p_iter                maximum iteration of SDDP, on return the number of iterations achieved
+/// \param  p_accuracy            accuracy asked , on return estimation of accuracy achieved (expressed in %)
+/// \param  p_nStepConv           every p_nStepConv convergence is checked
+/// \param  p_staleness           maximal number of dates treated together in the backward part with cuts at the following date
+///                               generated at the previous iteration (0 gives the same algorithm as backwardForwardSDDP)
+/// \param  p_outputStream        dump all print messages
+/// \param  p_world               MPI communicator
+/// \param  p_bPrintTime          if true print time at each backward and forward step
+/// \param  p_bLocalStateBuffer   if true, visited states are stored in buffers local to threads during the forward sweep
+/// \param  p_bMultiCut           if true, one cut per sample is kept in the backward sweep (multi cut), otherwise samples are averaged (single cut)
+/// \param  p_nameRegressorBacking if not empty, regressors are kept serialized in this file (suffixed by the processor number) instead of in memory
+/// \return backward and forward valorization
+template<  class LocalRegressionForSDDP>
+std::pair<double, double> backwardForwardSDDPAsync(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
+        const int   &p_nbSimulCheckForSimu,
+        const Eigen::ArrayXd &p_initialState,
+        const SDDPFinalCut &p_finalCut,
+        const Eigen::ArrayXd &p_dates,
+        const Eigen::ArrayXi &p_meshForReg,
+        const std::string &p_nameRegressor,
+        const std::string &p_nameCut,
+        const std::string &p_nameVisitedStates,
+        int &p_iter,
+        double &p_accuracy,
+        const int &p_nStepConv,
+        const int &p_staleness,
+        std::ostream &p_outputStream,
+#ifdef USE_MPI
+        const boost::mpi::communicator &p_world,
+#endif
+        bool  p_bPrintTime = false,
+        bool  p_bLocalStateBuffer = false,
+        bool  p_bMultiCut = false,
+        const std::string &p_nameRegressorBacking = "")
+{
+    // get back simulators
+    std::shared_ptr<SimulatorSDDPBase> simulatorForOptim = p_optimizer->getSimulatorBackward();
+    std::shared_ptr<SimulatorSDDPBase> simulatorForSim = p_optimizer->getSimulatorForward();
+
+#ifdef USE_MPI
+    int iTask = p_world.rank();
+#else
+    int iTask = 0;
+#endif
+    assert(almostEqual<double>(p_dates(0), 0., 10));
+    // cpu timers
+    boost::timer::cpu_timer globalTimer;
+
+    if (iTask == 0)
+        createRegressorsAndInitialStates<LocalRegressionForSDDP>(p_optimizer, p_initialState, p_dates, p_meshForReg, p_nameRegressor, p_nameVisitedStates);
+
+#ifdef USE_MPI
+    p_world.barrier();
+#endif
+    int iterMax = p_iter;
+    p_iter = 0;
+    double accuracy = p_accuracy;
+    p_accuracy = 1e10;
+    // regressors read once for all iterations : currently all processor reads the regression
+    std::string nameRegressorBacking = (p_nameRegressorBacking.empty() ? p_nameRegressorBacking : p_nameRegressorBacking + "_" + std::to_string(iTask));
+    std::shared_ptr< SDDPRegressorStore<LocalRegressionForSDDP> > regressors;
+    {
+        gs::BinaryFileArchive archiveReadRegressor(p_nameRegressor.c_str(), "r");
+        regressors = std::make_shared< SDDPRegressorStore<LocalRegressionForSDDP> >(archiveReadRegressor, p_dates.size() - 1, nameRegressorBacking);
+    }
+    // archive for cuts : only written
+    std::shared_ptr<gs::BinaryFileArchive> archiveForCuts;
+
+    // only create for first task
+    if (iTask == 0)
+        archiveForCuts = std::make_shared<gs::BinaryFileArchive>(p_nameCut.c_str(), "w+");
+
+    // store of cuts for all dates except the last one
+    std::vector< std::shared_ptr<SDDPLocalCut> > vecCuts(std::max(static_cast<int>(p_dates.size()) - 2, 0));
+    for (size_t idate = 0; idate < vecCuts.size(); ++idate)
+    {
+        std::shared_ptr<LocalRegressionForSDDP> regressor = regressors->getRegressor(idate);
+        vecCuts[idate] = std::make_shared<SDDPLocalCut>(idate, simulatorForOptim->getNbSample(), regressor, p_bMultiCut);
+        vecCuts[idate]->loadCuts(archiveForCuts
+#ifdef USE_MPI
+                                 , p_world
+#endif
+                                );
+    }
+    std::shared_ptr<SDDPCutStore> cutStore = std::make_shared<SDDPCutStore>(vecCuts);
+
+    // to store the backward value
+    double backwardValue = 0.;
+    // forward value
+    double forwardValueForConv = 0.;
+    int istep = 0;
+    // store evolution of convergence
+    double backwardMinusForwardPrev = 0;
+    while ((accuracy < p_accuracy) && (p_iter < iterMax))
+    {
+        // increase step
+        istep += 1;
+        // local timer
+        boost::timer::cpu_timer localTimer;
+        //  actualize time for simulators
+        simulatorForOptim->resetTime();
+        simulatorForSim->resetTime();
+        // backward sweep
+        backwardValue = backwardSDDPAsync<LocalRegressionForSDDP>(p_optimizer, simulatorForOptim, p_dates,
+                        p_initialState, p_finalCut, *regressors,
+                        p_nameVisitedStates, archiveForCuts, *cutStore, p_staleness,
+#ifdef USE_MPI
+                        p_world,
+#endif
+                        false);
+        localTimer.stop();
+        if (p_bPrintTime && (iTask == 0))
+        {
+            p_outputStream << " SDDP backward  iteration " << p_iter <<  " value " << backwardValue << " time " <<  localTimer.format() <<  std::endl ;
+            std::cout << " SDDP backward  iteration " << p_iter <<   " value " << backwardValue << " time " <<  localTimer.format();
+            std::cout.flush();
+        }
+
+        // forward sweep : cuts are read in the store
+        bool   bIncreaseCut  = true;
+
+        localTimer.start();
+
+        forwardSDDP<LocalRegressionForSDDP>(p_optimizer, simulatorForSim, p_dates, p_initialState, p_finalCut, bIncreaseCut, *regressors,
+                                            archiveForCuts, p_nameVisitedStates
+#ifdef USE_MPI
+                                            , p_world
+#endif
+                                            , p_bLocalStateBuffer, cutStore);
+
+        localTimer.stop();
+        if (p_bPrintTime && (iTask == 0))
+        {
+            p_outputStream << " SDDP forward iteration " << p_iter << " time " <<  localTimer.format() << std::endl ;
+        }
+
+#ifdef USE_MPI
+        // visited states archive written by processor 0 is read by all processors in the next backward sweep
+        p_world.barrier();
+#endif
+        if ((istep == p_nStepConv) || (p_iter == 0))
+        {
+            istep = 0;
+            int oldParticleNb = simulatorForSim->getNbSimul();
+            simulatorForSim->updateSimulationNumberAndResetTime(p_nbSimulCheckForSimu);
+            bIncreaseCut = false;
+            forwardValueForConv =  forwardSDDP<LocalRegressionForSDDP>(p_optimizer, simulatorForSim, p_dates,
+                                   p_initialState, p_finalCut, bIncreaseCut, *regressors,
+                                   archiveForCuts, p_nameVisitedStates
+#ifdef USE_MPI
+                                   , p_world
+#endif
+                                   , false, cutStore);
+            if (forwardValueForConv != 0.0)
+                p_accuracy = fabs((backwardValue - forwardValueForConv) / forwardValueForConv);
+            else
+                p_accuracy = fabs(backwardValue);
+            simulatorForSim->updateSimulationNumberAndResetTime(oldParticleNb);
+            globalTimer.stop();
+            if (iTask == 0)
+            {
+                p_outputStream << " ACCURACY " << p_accuracy  << " Backward " << backwardValue << " Forward " << forwardValueForConv << " p_iter "  << p_iter << " accuracy " <<  p_accuracy;
+                p_outputStream <<  " GlobalTimer " << globalTimer.format() << std::endl ;
+                std::cout <<  " ACCURACY " << p_accuracy  << " Backward " << backwardValue << " Forward " << forwardValueForConv << " p_iter "  << p_iter << " accuracy " <<  p_accuracy << " GlobalTimer " <<  globalTimer.format() << std::endl ;
+            }
+            globalTimer.resume();
+            double backwardMinusForward = backwardValue - forwardValueForConv;
+            if (p_iter > 0)
+            {
+                if (backwardMinusForward * backwardMinusForwardPrev < 0)
+                {
+                    if (iTask == 0)
+                        p_outputStream << " Curve are crossing : increase sample and simulations to get more accurate solution, decrease step for checking convergence" << " GlobalTimer " <<  globalTimer.format() << std::endl ;
+                    // exit
+                    p_accuracy = 0.;
+                }
+            }
+            backwardMinusForwardPrev = backwardMinusForward;
+        }
+        else if (p_iter > 0)
+        {
+            // add a check on curve
+            double backwardMinusForward = backwardValue - forwardValueForConv;
+            if (backwardMinusForward * backwardMinusForwardPrev < 0)
+            {
+                if (iTask == 0)
+                    p_outputStream << " Curve are crossing : increase sample and simulations to get more accurate solution, decrease step for checking convergence" << std::endl ;
+                // exit
+                p_accuracy = 0.;
+            }
+        }
+        p_iter += 1;
+    }
+
+#ifdef USE_MPI
+    p_world.barrier();
+#endif
+    return std::make_pair(backwardValue, forwardValueForConv);
+
+}
+
+}
+
+#endif /* BACKWARDFORWARDSDDPASYNC_H */
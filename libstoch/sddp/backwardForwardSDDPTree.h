@@ -38,6 +38,7 @@ namespace libstoch
 /// \param  p_stringStream        dump all print messages
 /// \param  p_world            MPI communicator
 /// \param  p_bPrintTime          if true print time at each backward and forward step
+/// \param  p_bMultiCut           if true, one cut per arrival node is kept in the backward sweep (multi cut), otherwise a single cut is kept
 /// \return backward and forward valorization
 std::pair<double, double> backwardForwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>    &p_optimizer,
         const int   &p_nbSimulCheckForSimu,
@@ -53,7 +54,8 @@ std::pair<double, double> backwardForwardSDDPTree(std::shared_ptr<OptimizerSDDPB
 #ifdef USE_MPI
         const boost::mpi::communicator &p_world,
 #endif
-        bool  p_bPrintTime = false)
+        bool  p_bPrintTime = false,
+        bool  p_bMultiCut = false)
 {
     // get back simulators
     std::shared_ptr<SimulatorSDDPBaseTree> simulatorForOptim =  std::static_pointer_cast<SimulatorSDDPBaseTree>(p_optimizer->getSimulatorBackward());
@@ -131,7 +133,7 @@ std::pair<double, double> backwardForwardSDDPTree(std::shared_ptr<OptimizerSDDPB
         // backward sweep
         backwardValues[p_iter] = backwardSDDPTree(p_optimizer, simulatorForOptim, p_dates,
                                  p_initialState, p_finalCut,
-                                 p_nameVisitedStates, archiveForCuts, p_world, false);
+                                 p_nameVisitedStates, archiveForCuts, p_world, false, p_bMultiCut);
         localTimer.stop();
         if (p_bPrintTime && (iTask == 0))
         {
@@ -19,6 +19,8 @@
 #include "libstoch/sddp/SDDPLocalCut.h"
 #include "libstoch/sddp/SDDPVisitedStates.h"
 #include "libstoch/sddp/SDDPVisitedStatesGeners.h"
+#include "libstoch/sddp/SDDPRegressorStore.h"
+#include "libstoch/core/utils/Instrumentation.h"
 
 
 /** \file backwardSDDP.h
@@ -33,11 +35,12 @@ namespace libstoch
 /// \param p_dates             vector of exercised dates, last dates correspond to the final cut object
 /// \param p_initialState      initial state at the beginning of simulation
 /// \param p_finalCut          object of final cuts
-/// \param p_archiveRegresssor archive with regressor objects
+/// \param p_regressors       regressors of all dates
 /// \param p_nameVisitedStates name of the archive used to store visited states
 /// \param p_archiveCut        archive storing cuts generated
 /// \param  p_world            MPI communicator
 /// \param  p_bPrintTime       if true print time at each backward and forward step
+/// \param  p_bMultiCut        if true, one cut per sample is generated (multi cut), otherwise samples are averaged in a single cut
 /// \return value obtained by backward resolution
 template<  class LocalRegressionForSDDP>
 double 	backwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
@@ -45,13 +48,14 @@ double 	backwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
                      const Eigen::ArrayXd   &p_dates,
                      const Eigen::ArrayXd &p_initialState,
                      const SDDPFinalCut &p_finalCut,
-                     const std::shared_ptr<gs::BinaryFileArchive> &p_archiveRegresssor,
+                     const SDDPRegressorStore<LocalRegressionForSDDP> &p_regressors,
                      const std::string &p_nameVisitedStates,
                      const std::shared_ptr<gs::BinaryFileArchive> &p_archiveCut,
 #ifdef USE_MPI
                      const boost::mpi::communicator &p_world,
 #endif
-                     bool  p_bPrintTime = false)
+                     bool  p_bPrintTime = false,
+                     bool  p_bMultiCut = false)
 {
     // to red cuts
     gs::BinaryFileArchive archiveVisitedStates(p_nameVisitedStates.c_str(), "r");
@@ -63,30 +67,33 @@ double 	backwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
     // final cut
     std::unique_ptr< SDDPCutBase > linCutNext = std::make_unique< SDDPFinalCut>(p_finalCut);
     // regressor at previous time step
-    std::shared_ptr<LocalRegressionForSDDP> regressorNext(gs::Reference< LocalRegressionForSDDP >(*p_archiveRegresssor, "Regressor", "Top").get(0));
+    std::shared_ptr<LocalRegressionForSDDP> regressorNext = p_regressors.getRegressor(p_dates.size() - 2);
     // iterate over step
     for (int idate = p_dates.size() - 2; idate > 0 ; --idate)
     {
         // local timer
         boost::timer::cpu_timer localTimer;
+        InstrumentationStep instStep("backwardSDDP");
 
         // update new date for optimizer and simulator
         p_optimizer->updateDates(p_dates(idate - 1), p_dates(idate));
         p_simulator->updateDateIndex(idate);
 
         // get back states at current step
+        InstrumentationTimer timerIO(instIO);
         std::unique_ptr<SDDPVisitedStates> VisitedStates = gs::Reference< SDDPVisitedStates >(archiveVisitedStates, "States", "Top").get(idate - 1);
         // get back regressor at previous time step
-        std::shared_ptr<LocalRegressionForSDDP> regressorPrev(gs::Reference< LocalRegressionForSDDP >(*p_archiveRegresssor, "Regressor", "Top").get(p_dates.size() - 1 - idate));
+        std::shared_ptr<LocalRegressionForSDDP> regressorPrev = p_regressors.getRegressor(idate - 1);
 
         // create SDDP cut object at the previous date with regressor at previous date
-        std::unique_ptr<SDDPCutBase> linCutPrev = std::make_unique<SDDPLocalCut>(idate - 1, nbSample, regressorPrev);
+        std::unique_ptr<SDDPCutBase> linCutPrev = std::make_unique<SDDPLocalCut>(idate - 1, nbSample, regressorPrev, p_bMultiCut);
         /// load existing cuts to prepare next time step
         linCutPrev->loadCuts(p_archiveCut
 #ifdef USE_MPI
                              , p_world
 #endif
                             );
+        timerIO.stop();
 
         // create vector of LP (one for each sample)
         std::vector< std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  >  vecState = linCutPrev->createVectorStatesParticle(*VisitedStates);
@@ -105,6 +112,7 @@ double 	backwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
         int iLPLast  = iLPFirst + nsimPProc + (iTask < nRest ? 1 : 0);
         // to store cuts ::dimension of the problem  plus one by number of simulations
         Eigen::ArrayXXd cutPerSimPerProc(p_optimizer->getStateSize() + 1, iLPLast - iLPFirst);
+        InstrumentationTimer timerOptimize(instOptimize);
         int ism;
         #pragma omp parallel  for schedule(dynamic)  private(ism)
         for (ism = 0; ism < iLPLast - iLPFirst; ++ism)
@@ -122,12 +130,16 @@ double 	backwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
             for (int ist = 0; ist < stateAlone->size(); ++ist)
                 cutPerSimPerProc(0, ism) -= cutPerSimPerProc(ist + 1, ism) * (*stateAlone)(ist);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(iLPLast - iLPFirst);
         // conditional expectation of the cuts at previous time step
+        InstrumentationTimer timerRegression(instRegression);
         linCutPrev->createAndStoreCuts(cutPerSimPerProc, *VisitedStates, vecState, p_archiveCut
 #ifdef USE_MPI
                                        , p_world
 #endif
                                       );
+        timerRegression.stop();
         // swap pointer
         regressorNext	= move(regressorPrev);
         linCutNext = move(linCutPrev);
@@ -0,0 +1,322 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef BACKWARDSDDPASYNC_H
+#define BACKWARDSDDPASYNC_H
+#include <memory>
+#include <algorithm>
+#include <array>
+#include <vector>
+#ifdef USE_MPI
+#include <boost/mpi/collectives.hpp>
+#include <boost/mpi/communicator.hpp>
+#include <boost/mpi/nonblocking.hpp>
+#include <boost/serialization/vector.hpp>
+#endif
+#include <boost/timer/timer.hpp>
+#include <Eigen/Dense>
+#include "geners/BinaryFileArchive.hh"
+#include "geners/Record.hh"
+#include "geners/Reference.hh"
+#include "libstoch/sddp/SimulatorSDDPBase.h"
+#include "libstoch/sddp/OptimizerSDDPBase.h"
+#include "libstoch/sddp/SDDPFinalCut.h"
+#include "libstoch/sddp/SDDPLocalCut.h"
+#include "libstoch/sddp/SDDPCutStore.h"
+#include "libstoch/sddp/SDDPVisitedStates.h"
+#include "libstoch/sddp/SDDPVisitedStatesGeners.h"
+#include "libstoch/sddp/SDDPRegressorStore.h"
+#include "libstoch/core/utils/Instrumentation.h"
+#ifdef USE_MPI
+#include "libstoch/core/parallelism/SharedTaskQueue.h"
+#endif
+
+
+/** \file backwardSDDPAsync.h
+ * \brief One  backward resolution by SDDP with regressor where dates are treated by waves.
+ *        All the LP of the dates of a wave are solved with the cuts available at the beginning of the wave
+ *        (so possibly generated at the previous iteration). The LP are split in blocks dealt by a queue shared by all processors :
+ *        a processor takes a new block as soon as it has solved the previous one.
+ *        The cuts of a date are then created by a group of processors and published to all processors at the end of the wave.
+ * \author Xavier Warin
+ */
+namespace libstoch
+{
+/// \brief Realize a backward sweep for SDDP with stale cuts
+/// \param p_optimizer        object defining a transition step for SDDP
+/// \param p_simulator         simulates uncertainties for regressions, inflows etc.... In this part, simulations are the same between iterations
+/// \param p_dates             vector of exercised dates, last dates correspond to the final cut object
+/// \param p_initialState      initial state at the beginning of simulation
+/// \param p_finalCut          object of final cuts
+/// \param p_regressors       regressors of all dates
+/// \param p_nameVisitedStates name of the archive used to store visited states
+/// \param p_archiveCut        archive storing cuts generated
+/// \param p_cutStore          cuts of all dates kept in memory
+/// \param p_staleness         maximal number of dates in a wave using cuts at the following date generated at the previous iteration
+///                            (0 corresponds to the classical backward sweep)
+/// \param  p_world            MPI communicator
+/// \param  p_bPrintTime       if true print time for each wave
+/// \return value obtained by backward resolution
+template<  class LocalRegressionForSDDP>
+double 	backwardSDDPAsync(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
+                          const std::shared_ptr<SimulatorSDDPBase> &p_simulator,
+                          const Eigen::ArrayXd   &p_dates,
+                          const Eigen::ArrayXd &p_initialState,
+                          const SDDPFinalCut &p_finalCut,
+                          const SDDPRegressorStore<LocalRegressionForSDDP> &p_regressors,
+                          const std::string &p_nameVisitedStates,
+                          const std::shared_ptr<gs::BinaryFileArchive> &p_archiveCut,
+                          SDDPCutStore &p_cutStore,
+                          const int &p_staleness,
+#ifdef USE_MPI
+                          const boost::mpi::communicator &p_world,
+#endif
+                          bool  p_bPrintTime = false)
+{
+    // to red cuts
+    gs::BinaryFileArchive archiveVisitedStates(p_nameVisitedStates.c_str(), "r");
+
+    // get number of sample used in optimization part
+    int nbSample = p_simulator->getNbSample();
+    // get number of simulations used for regressions
+    int nbSimul =  p_simulator->getNbSimul();
+    // last date where cuts are generated
+    int idateCut = p_dates.size() - 3;
+    // first and last (excluded) element of part p_ipart when p_nb elements are split in p_nbPart parts
+    auto partRange = [](const int &p_nb, const int &p_nbPart, const int &p_ipart)
+    {
+        int nbPerPart = p_nb / p_nbPart;
+        int nRest = p_nb % p_nbPart;
+        int iFirst = p_ipart * nbPerPart + (p_ipart < nRest ? p_ipart : nRest);
+        return std::array<int, 2> {{iFirst, iFirst + nbPerPart + (p_ipart < nRest ? 1 : 0)}};
+    };
+#ifdef USE_MPI
+    // groups of processors creating the cuts of a date : only the last wave can have less dates, so the split is done at most twice
+    int nbGroup = 0;
+    int iGroup = 0;
+    boost::mpi::communicator groupWorld;
+    // queue of the blocks of LP of a wave : several blocks per processor and per date to balance the load
+    SharedTaskQueue taskQueue(p_world);
+    int nbBlockPerDate = 4 * p_world.size();
+#endif
+    while (idateCut >= 0)
+    {
+        // local timer
+        boost::timer::cpu_timer localTimer;
+        InstrumentationStep instStep("backwardSDDPAsync");
+        // dates in the wave
+        int nbDateInWave = std::min(p_staleness + 1, idateCut + 1);
+#ifdef USE_MPI
+        if (std::min(nbDateInWave, p_world.size()) != nbGroup)
+        {
+            nbGroup = std::min(nbDateInWave, p_world.size());
+            iGroup = p_world.rank() % nbGroup;
+            groupWorld = p_world.split(iGroup);
+        }
+        int nbTask = groupWorld.size();
+        int iTask = groupWorld.rank();
+#else
+        int nbGroup = 1;
+        int iGroup = 0;
+        int nbTask = 1;
+        int iTask = 0;
+#endif
+        // visited states and LP of the dates of the wave, loaded by a processor when needed
+        std::vector< std::unique_ptr<SDDPVisitedStates> > visitedStates(nbDateInWave);
+        std::vector< std::vector< std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  > > vecStates(nbDateInWave);
+        auto loadDate = [&](const int &p_ipos)
+        {
+            if (!visitedStates[p_ipos])
+            {
+                InstrumentationTimer timerIO(instIO);
+                visitedStates[p_ipos] = gs::Reference< SDDPVisitedStates >(archiveVisitedStates, "States", "Top").get(idateCut - p_ipos);
+                timerIO.stop();
+                vecStates[p_ipos] = p_cutStore.getCuts(idateCut - p_ipos)->createVectorStatesParticle(*visitedStates[p_ipos]);
+            }
+        };
+        // simulator and optimizer follow the dates of the wave in the order of the backward sweep :
+        // all processors go through all dates so that the samples drawn by the simulators are the same on all processors
+        int iposCurrent = -1;
+        std::shared_ptr<LocalRegressionForSDDP> regressorNext;
+        std::shared_ptr< SDDPCutBase > linCutNext;
+        auto moveToDate = [&](const int &p_ipos)
+        {
+            while (iposCurrent < p_ipos)
+            {
+                iposCurrent += 1;
+                int idate = idateCut - iposCurrent;
+                p_optimizer->updateDates(p_dates(idate), p_dates(idate + 1));
+                p_simulator->updateDateIndex(idate + 1);
+            }
+            int idate = idateCut - p_ipos;
+            InstrumentationTimer timerIO(instIO);
+            regressorNext = p_regressors.getRegressor(idate + 1);
+            timerIO.stop();
+            // cuts at next date as available at the beginning of the wave
+            if (idate + 1 < p_cutStore.getNbDates())
+                linCutNext = p_cutStore.getCuts(idate + 1);
+            else
+                linCutNext = std::make_shared< SDDPFinalCut>(p_finalCut);
+        };
+        // solve LP p_iLPFirst to p_iLPLast (excluded) of a date and store the cuts in p_cuts
+        auto solveLP = [&](const int &p_ipos, const int &p_iLPFirst, const int &p_iLPLast, Eigen::ArrayXXd &p_cuts)
+        {
+            const std::vector< std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  > &vecState = vecStates[p_ipos];
+            int nbSampleLinCut = p_cutStore.getCuts(idateCut - p_ipos)->getSample();
+            // to store cuts ::dimension of the problem  plus one by number of simulations
+            p_cuts.resize(p_optimizer->getStateSize() + 1, p_iLPLast - p_iLPFirst);
+            InstrumentationTimer timerOptimize(instOptimize);
+            int ism;
+            #pragma omp parallel  for schedule(dynamic)  private(ism)
+            for (ism = 0; ism < p_iLPLast - p_iLPFirst; ++ism)
+            {
+                // current state and particle associated
+                std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  aState = vecState[(ism + p_iLPFirst) / nbSampleLinCut];
+                // sample number
+                int isample = (ism + p_iLPFirst) % (nbSample * nbSimul);
+                //  call to main optimizer
+                p_cuts.col(ism) =  p_optimizer->oneStepBackward(*static_cast<SDDPCutOptBase *>(linCutNext.get()), aState, regressorNext->getParticle(std::get<1>(aState)), isample);
+                /// now using function value  and sensibility, create the cut (derivatives already calculated)
+                std::shared_ptr<Eigen::ArrayXd> stateAlone = std::get<0>(aState);
+                for (int ist = 0; ist < stateAlone->size(); ++ist)
+                    p_cuts(0, ism) -= p_cuts(ist + 1, ism) * (*stateAlone)(ist);
+            }
+            timerOptimize.stop();
+            instrumentOptimizeCalls(p_iLPLast - p_iLPFirst);
+        };
+        // cuts of the LP of the dates created by the group of the processor : LP split between the processors of the group
+        std::vector< Eigen::ArrayXXd > cutPerSimPerProc(nbDateInWave);
+        int nbLPGroup = 0;
+        for (int ipos = iGroup; ipos < nbDateInWave; ipos += nbGroup)
+        {
+            loadDate(ipos);
+            int nbLPTotal = vecStates[ipos].size() * nbSample;
+            std::array<int, 2> iLP = partRange(nbLPTotal, nbTask, iTask);
+            cutPerSimPerProc[ipos].resize(p_optimizer->getStateSize() + 1, iLP[1] - iLP[0]);
+            nbLPGroup += nbLPTotal;
+        }
+#ifdef USE_MPI
+        // blocks of LP taken in the queue : dates in the order of the backward sweep
+        std::vector<int> blockDone;
+        std::vector< Eigen::ArrayXXd > cutPerBlock;
+        taskQueue.reset(nbDateInWave * nbBlockPerDate);
+        int iblockTask;
+        while ((iblockTask = taskQueue.getTask()) >= 0)
+        {
+            int ipos = iblockTask / nbBlockPerDate;
+            loadDate(ipos);
+            if (ipos != iposCurrent)
+                moveToDate(ipos);
+            std::array<int, 2> iLP = partRange(vecStates[ipos].size() * nbSample, nbBlockPerDate, iblockTask % nbBlockPerDate);
+            blockDone.push_back(iblockTask);
+            cutPerBlock.push_back(Eigen::ArrayXXd());
+            solveLP(ipos, iLP[0], iLP[1], cutPerBlock.back());
+        }
+        moveToDate(nbDateInWave - 1);
+        // send the cuts of each block to the processors of the group creating the cuts of the date.
+        // Messages between two processors are sent and received in the order of the blocks so a single tag is used
+        InstrumentationTimer timerCommunication(instCommunication);
+        std::vector< std::vector<int> > blockDoneByProc;
+        boost::mpi::all_gather(p_world, blockDone, blockDoneByProc);
+        std::vector<int> procOfBlock(nbDateInWave * nbBlockPerDate);
+        for (size_t iproc = 0; iproc < blockDoneByProc.size(); ++iproc)
+            for (int iblock : blockDoneByProc[iproc])
+                procOfBlock[iblock] = iproc;
+        std::vector< boost::mpi::request > requests;
+        int stateSizeP1 = p_optimizer->getStateSize() + 1;
+        for (int ipos = iGroup; ipos < nbDateInWave; ipos += nbGroup)
+        {
+            int nbLPTotal = vecStates[ipos].size() * nbSample;
+            std::array<int, 2> iLP = partRange(nbLPTotal, nbTask, iTask);
+            for (int iblock = 0; iblock < nbBlockPerDate; ++iblock)
+            {
+                int iblockTask = ipos * nbBlockPerDate + iblock;
+                std::array<int, 2> iLPBlock = partRange(nbLPTotal, nbBlockPerDate, iblock);
+                int iFirst = std::max(iLP[0], iLPBlock[0]);
+                int iLast = std::min(iLP[1], iLPBlock[1]);
+                if ((iFirst < iLast) && (procOfBlock[iblockTask] != p_world.rank()))
+                    requests.push_back(p_world.irecv(procOfBlock[iblockTask], 0, cutPerSimPerProc[ipos].data() + (iFirst - iLP[0]) * stateSizeP1, (iLast - iFirst) * stateSizeP1));
+            }
+        }
+        for (size_t ib = 0; ib < blockDone.size(); ++ib)
+        {
+            int ipos = blockDone[ib] / nbBlockPerDate;
+            int nbLPTotal = vecStates[ipos].size() * nbSample;
+            std::array<int, 2> iLPBlock = partRange(nbLPTotal, nbBlockPerDate, blockDone[ib] % nbBlockPerDate);
+            // processors of the group creating the cuts of the date
+            int iGroupDate = ipos % nbGroup;
+            int nbTaskDate = (p_world.size() - iGroupDate + nbGroup - 1) / nbGroup;
+            for (int iTaskDate = 0; iTaskDate < nbTaskDate; ++iTaskDate)
+            {
+                std::array<int, 2> iLP = partRange(nbLPTotal, nbTaskDate, iTaskDate);
+                int iFirst = std::max(iLP[0], iLPBlock[0]);
+                int iLast = std::min(iLP[1], iLPBlock[1]);
+                if (iFirst >= iLast)
+                    continue;
+                int iproc = iGroupDate + iTaskDate * nbGroup;
+                if (iproc == p_world.rank())
+                    cutPerSimPerProc[ipos].middleCols(iFirst - iLP[0], iLast - iFirst) = cutPerBlock[ib].middleCols(iFirst - iLPBlock[0], iLast - iFirst);
+                else
+                    requests.push_back(p_world.isend(iproc, 0, cutPerBlock[ib].data() + (iFirst - iLPBlock[0]) * stateSizeP1, (iLast - iFirst) * stateSizeP1));
+            }
+        }
+        boost::mpi::wait_all(requests.begin(), requests.end());
+        timerCommunication.stop();
+        int nbLPProc = 0;
+        for (const auto &cuts : cutPerBlock)
+            nbLPProc += cuts.cols();
+#else
+        int nbLPProc = nbLPGroup;
+#endif
+        for (int ipos = iGroup; ipos < nbDateInWave; ipos += nbGroup)
+        {
+#ifndef USE_MPI
+            moveToDate(ipos);
+            solveLP(ipos, 0, cutPerSimPerProc[ipos].cols(), cutPerSimPerProc[ipos]);
+#endif
+            // conditional expectation of the cuts : only processors of the group are involved
+            InstrumentationTimer timerRegression(instRegression);
+            p_cutStore.getCuts(idateCut - ipos)->createAndStoreCuts(cutPerSimPerProc[ipos], *visitedStates[ipos], vecStates[ipos], p_archiveCut
+#ifdef USE_MPI
+                    , groupWorld
+#endif
+                                                                   );
+            timerRegression.stop();
+        }
+        // publish new cuts of the wave
+        for (int ipos = 0; ipos < nbDateInWave; ++ipos)
+        {
+#ifdef USE_MPI
+            // first processor of the group owning the date
+            int iRoot = ipos % nbGroup;
+            p_cutStore.publish(idateCut - ipos, iRoot, (iRoot == iGroup), p_archiveCut, p_world);
+#else
+            p_cutStore.setPublished(idateCut - ipos);
+#endif
+        }
+        if (p_bPrintTime && (iTask == 0))
+        {
+            std::cout << "backward  : wave of dates " << idateCut << " to " << idateCut - nbDateInWave + 1 << " group " << iGroup << " nb LP group " << nbLPGroup  << " nb LP solved " << nbLPProc <<  " time " <<  localTimer.format() <<  std::endl ;
+            std::cout.flush();
+        }
+        idateCut -= nbDateInWave;
+    }
+    // update first  for optimizer and simulator : -1 indicate non previous date
+    p_optimizer->updateDates(-1, p_dates(0));
+    p_simulator->updateDateIndex(0);
+    // regressor and cuts at first date
+    std::shared_ptr<LocalRegressionForSDDP> regressorFirst = p_regressors.getRegressor(0);
+    std::shared_ptr< SDDPCutBase > linCutFirst;
+    if (p_cutStore.getNbDates() > 0)
+        linCutFirst = p_cutStore.getCuts(0);
+    else
+        linCutFirst = std::make_shared< SDDPFinalCut>(p_finalCut);
+    // now just only one particle for first time step adn one LP
+    std::shared_ptr<Eigen::ArrayXd> ptState = std::make_shared< Eigen::ArrayXd>(p_initialState);
+    std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  aState = make_tuple(ptState, 0, 0);
+    double valueEstimation = p_optimizer->oneStepBackward(*static_cast<SDDPCutOptBase *>(linCutFirst.get()), aState, regressorFirst->getParticle(std::get<1>(aState)), 0)(0);
+    return valueEstimation;
+}
+
+}
+#endif
@@ -6,6 +6,9 @@
 #include <boost/mpi/collectives.hpp>
 #include <boost/mpi/communicator.hpp>
 #endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include <boost/timer/timer.hpp>
 #include <Eigen/Dense>
 #include "geners/BinaryFileArchive.hh"
@@ -15,8 +18,10 @@
 #include "libstoch/sddp/OptimizerSDDPBase.h"
 #include "libstoch/sddp/SDDPFinalCutTree.h"
 #include "libstoch/sddp/SDDPCutTree.h"
+#include "libstoch/sddp/SDDPCutNodeBatch.h"
 #include "libstoch/sddp/SDDPVisitedStatesTree.h"
 #include "libstoch/sddp/SDDPVisitedStatesTreeGeners.h"
+#include "libstoch/core/utils/Instrumentation.h"
 
 
 /** \file backwardSDDPTree.h
@@ -35,6 +40,7 @@ namespace libstoch
 /// \param p_archiveCut        archive storing cuts generated
 /// \param  p_world            MPI communicator
 /// \param p_bPrintTime        if true print time at each backward and forward step
+/// \param p_bMultiCut         if true, a cut per arrival node is generated (multi cut), otherwise a single cut aggregates all arrival nodes
 /// \return value obtained by backward resolution
 double 	backwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>   &p_optimizer,
                          std::shared_ptr<SimulatorSDDPBaseTree> &p_simulator,
@@ -46,7 +52,8 @@ double 	backwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>   &p_optimizer,
 #ifdef USE_MPI
                          const boost::mpi::communicator &p_world,
 #endif
-                         bool  p_bPrintTime = false)
+                         bool  p_bPrintTime = false,
+                         bool  p_bMultiCut = false)
 {
     // to red cuts
     gs::BinaryFileArchive archiveVisitedStates(p_nameVisitedStates.c_str(), "r");
@@ -60,6 +67,7 @@ double 	backwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>   &p_optimizer,
     {
         // local timer
         boost::timer::cpu_timer localTimer;
+        InstrumentationStep instStep("backwardSDDPTree");
         // update new date for optimizer and simulator
         p_optimizer->updateDates(p_dates(idate - 1), p_dates(idate));
         // first update simulator to calculate conditional expections with tree
@@ -75,15 +83,17 @@ double 	backwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>   &p_optimizer,
         // nodes at p_dates(idate)
         Eigen::ArrayXXd  nodesNext = p_simulator->getNodesNext();
         // get back states at current step
+        InstrumentationTimer timerIO(instIO);
         std::unique_ptr<SDDPVisitedStatesTree> VisitedStates = gs::Reference< SDDPVisitedStatesTree >(archiveVisitedStates, "States", "Top").get(idate - 1);
         // create SDDP cut object at the previous date with regressor at previous date
-        std::unique_ptr<SDDPCutBaseTree> linCutPrev = std::make_unique<SDDPCutTree>(idate - 1, nbSample, probabilies, connectionMatrix, nodes);
+        std::unique_ptr<SDDPCutBaseTree> linCutPrev = std::make_unique<SDDPCutTree>(idate - 1, nbSample, probabilies, connectionMatrix, nodes, p_bMultiCut);
         /// load existing cuts to prepare next time step
         linCutPrev->loadCuts(p_archiveCut
 #ifdef USE_MPI
                              , p_world
 #endif
                             );
+        timerIO.stop();
         // create vector of LP (one for each sample)
         std::vector< std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  >  vecState = linCutPrev->createVectorStatesParticle(*VisitedStates);
         // spread between processors
@@ -104,32 +114,48 @@ double 	backwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>   &p_optimizer,
         int iLPLast  = iLPFirst + nsimPProc + (iTask < nRest ? 1 : 0);
         // to store cuts ::dimension of the problem  plus one by number of simulations
         Eigen::ArrayXXd cutPerSimPerProc(p_optimizer->getStateSize() + 1, iLPLast - iLPFirst);
-        int ism;
-        #pragma omp parallel  for schedule(dynamic)  private(ism)
-        for (ism = 0; ism < iLPLast - iLPFirst; ++ism)
+        InstrumentationTimer timerOptimize(instOptimize);
+        // LPs grouped by arrival node : the cuts of the node are built once per batch
+#ifdef _OPENMP
+        int nbThreads = omp_get_max_threads();
+#else
+        int nbThreads = 1;
+#endif
+        std::vector< std::pair< int, std::vector<int> > > batches = createNodeBatches(vecState, linCutPrev->getSample(), iLPFirst, iLPLast, nbThreads);
+        int ib;
+        #pragma omp parallel  for schedule(dynamic)  private(ib)
+        for (ib = 0; ib < static_cast<int>(batches.size()); ++ib)
         {
-            // current state and particle associated
-            std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  aState = vecState[(ism + iLPFirst) / linCutPrev->getSample()];
-            // sample number
-            int isample = (ism + iLPFirst) % (nbSample * nbNodesNext);
-            //  call to main optimizer
-            // simulator is given, cuts at the next time step, the state vector use, the node in tree  associated to this optimization
-            cutPerSimPerProc.col(ism) =  p_optimizer->oneStepBackward(*static_cast<SDDPCutOptBase *>(linCutNext.get()), aState, nodesNext.col(std::get<1>(aState)), isample);
-            /// now using function value  and sensibility, create the cut (derivatives already calculated)
-            std::shared_ptr<Eigen::ArrayXd> stateAlone = std::get<0>(aState);
-            for (int ist = 0; ist < stateAlone->size(); ++ist)
-                cutPerSimPerProc(0, ism) -= cutPerSimPerProc(ist + 1, ism) * (*stateAlone)(ist);
+            SDDPCutNodeCache cutsNode(*static_cast<SDDPCutOptBase *>(linCutNext.get()), batches[ib].first);
+            for (int ism : batches[ib].second)
+            {
+                // current state and particle associated
+                std::tuple< std::shared_ptr<Eigen::ArrayXd>, int, int >  aState = vecState[(ism + iLPFirst) / linCutPrev->getSample()];
+                // sample number
+                int isample = (ism + iLPFirst) % (nbSample * nbNodesNext);
+                //  call to main optimizer
+                // simulator is given, cuts at the next time step, the state vector use, the node in tree  associated to this optimization
+                cutPerSimPerProc.col(ism) =  p_optimizer->oneStepBackward(cutsNode, aState, nodesNext.col(std::get<1>(aState)), isample);
+                /// now using function value  and sensibility, create the cut (derivatives already calculated)
+                std::shared_ptr<Eigen::ArrayXd> stateAlone = std::get<0>(aState);
+                for (int ist = 0; ist < stateAlone->size(); ++ist)
+                    cutPerSimPerProc(0, ism) -= cutPerSimPerProc(ist + 1, ism) * (*stateAlone)(ist);
+            }
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(iLPLast - iLPFirst);
         // conditional expectation of the cuts at previous time step
+        InstrumentationTimer timerRegression(instRegression);
         linCutPrev->createAndStoreCuts(cutPerSimPerProc, *VisitedStates, vecState, p_archiveCut
 #ifdef USE_MPI
                                        , p_world
 #endif
                                       );
+        timerRegression.stop();
         linCutNext = move(linCutPrev);
         if (p_bPrintTime && (iTask == 0))
         {
-            std::cout << "backward  : idate " << idate << " nb LP processor 0 " << iLPLast - iLPFirst <<  " time " <<  localTimer.format() <<  std::endl ;
+            std::cout << "backward  : idate " << idate << " nb LP processor 0 " << iLPLast - iLPFirst << " nb batches " << batches.size() <<  " time " <<  localTimer.format() <<  std::endl ;
             std::cout.flush();
         }
     }
@@ -3,7 +3,13 @@
 // This code is published under the GNU Lesser General Public License (GNU LGPL)
 #ifndef FORWARDSDDDP_H
 #define FORWARDSDDDP_H
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <algorithm>
 #include <memory>
+#include <vector>
+#include <utility>
 #include "geners/BinaryFileArchive.hh"
 #include "geners/Record.hh"
 #include "geners/Reference.hh"
@@ -13,6 +19,9 @@
 #include "libstoch/sddp/SDDPVisitedStatesGeners.h"
 #include "libstoch/sddp/SimulatorSDDPBase.h"
 #include "libstoch/sddp/SDDPLocalCut.h"
+#include "libstoch/sddp/SDDPCutStore.h"
+#include "libstoch/sddp/SDDPRegressorStore.h"
+#include "libstoch/core/utils/Instrumentation.h"
 
 /** \file forwardSDDP.h
  * \brief On sequence of forward resolution by SDDP with regressor
@@ -21,32 +30,39 @@
 
 namespace libstoch
 {
-/// \brief Achieve  a forward sweep for SDDP
+/// \brief Achieve  a forward sweep for SDDP and estimate the variance of the value of a simulation
 /// \param p_optimizer              object defining a transition step for SDDP
 /// \param p_simulator              simulates uncertainties for regressions, inflows etc....
 /// \param p_dates                  vector of exercised dates
 /// \param p_initialState           initial state at the beginning of simulation
 /// \param p_finalCut               storing final cuts
-/// \param p_archiveRegresssor      archive with regressor objects
+/// \param p_regressors            regressors of all dates
 /// \param p_archiveCutToRead       archive storing cuts visited
 /// \param p_nameVisitedStates      name of the archive used to store   visited states
 /// \param p_bIncreaseCut           true if this simulation part create visited state for cut
 /// \param  p_world               MPI communicator
-/// \return value obtained with this simulations
+/// \param p_bLocalStateBuffer     if true, each thread stores its visited states in its own buffer without synchronization,
+///                                buffers are merged (doubling states eliminated) at the end of each date
+/// \param p_cutStore              if defined, cuts are taken from this store instead of being read in p_archiveCutToRead
+/// \param p_bMultiCut             true if cuts have been generated with the multi cut formulation (one cut per sample)
+/// \return value obtained with this simulations and (unbiased) variance of the value of one simulation
 template<  class LocalRegressionForSDDP>
-double	forwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
-                    const std::shared_ptr<SimulatorSDDPBase> &p_simulator,
-                    const Eigen::ArrayXd &p_dates,
-                    const Eigen::ArrayXd &p_initialState,
-                    const SDDPFinalCut &p_finalCut,
-                    const bool   &p_bIncreaseCut,
-                    const std::shared_ptr<gs::BinaryFileArchive > &p_archiveRegresssor,
-                    const std::shared_ptr<gs::BinaryFileArchive> &p_archiveCutToRead,
-                    const std::string &p_nameVisitedStates
+std::pair<double, double> forwardSDDPMeanAndVariance(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
+        const std::shared_ptr<SimulatorSDDPBase> &p_simulator,
+        const Eigen::ArrayXd &p_dates,
+        const Eigen::ArrayXd &p_initialState,
+        const SDDPFinalCut &p_finalCut,
+        const bool   &p_bIncreaseCut,
+        const SDDPRegressorStore<LocalRegressionForSDDP> &p_regressors,
+        const std::shared_ptr<gs::BinaryFileArchive> &p_archiveCutToRead,
+        const std::string &p_nameVisitedStates
 #ifdef USE_MPI
-                    , const boost::mpi::communicator &p_world
+        , const boost::mpi::communicator &p_world
 #endif
-                  )
+        , const bool &p_bLocalStateBuffer = false
+        , const std::shared_ptr<SDDPCutStore> &p_cutStore = std::shared_ptr<SDDPCutStore>()
+        , const bool &p_bMultiCut = false
+                                                    )
 {
 
     // to store cuts
@@ -69,36 +85,60 @@ double	forwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
     Eigen::ArrayXXd statePrev(p_initialState.size(), iLPLast - iLPFirst);
     for (int is = 0; is < iLPLast - iLPFirst; ++is)
         statePrev.col(is) = p_initialState ;
-    // to store gain
-    double gainAccumulator = 0;
+    // to store gain of each simulation
+    Eigen::ArrayXd gainPerSimul = Eigen::ArrayXd::Zero(iLPLast - iLPFirst);
+    // number of thread
+#ifdef _OPENMP
+    int nbThreads = omp_get_max_threads();
+#else
+    int nbThreads = 1;
+#endif
     for (int idate = 0; idate < p_dates.size() - 1; ++idate)
     {
+        InstrumentationStep instStep("forwardSDDP");
         // update new date
         p_optimizer->updateDates(p_dates(idate), p_dates(idate + 1));
         p_simulator->updateDateIndex(idate);
 
-        // read condition expectation operator
-        std::shared_ptr<LocalRegressionForSDDP> regressor(gs::Reference< LocalRegressionForSDDP >(*p_archiveRegresssor, "Regressor", "Top").get(p_dates.size() - 2 - idate));
+        // condition expectation operator
+        InstrumentationTimer timerIO(instIO);
+        std::shared_ptr<LocalRegressionForSDDP> regressor = p_regressors.getRegressor(idate);
 
         // create SDPPCut object
-        std::unique_ptr< SDDPCutBase > linCut;
+        std::shared_ptr< SDDPCutBase > linCut;
         if (idate <  p_dates.size() - 2)
-            linCut  = std::make_unique< SDDPLocalCut>(idate,  regressor);
+        {
+            if (p_cutStore)
+                linCut = p_cutStore->getCuts(idate);
+            else
+                linCut  = std::make_shared< SDDPLocalCut>(idate,  regressor, p_optimizer->getSimulatorBackward()->getNbSample(), p_bMultiCut);
+        }
         else
-            linCut  = std::make_unique< SDDPFinalCut>(p_finalCut);
+            linCut  = std::make_shared< SDDPFinalCut>(p_finalCut);
 
         // load cuts
-        linCut->loadCuts(p_archiveCutToRead
+        if (!p_cutStore)
+            linCut->loadCuts(p_archiveCutToRead
 #ifdef USE_MPI
-                         , p_world
+                             , p_world
 #endif
 
-                        );
+                            );
+        timerIO.stop();
 
         // to store visited states
         SDDPVisitedStates setOfStates(regressor->getNbMeshTotal());
+        // buffers local to threads
+        std::vector< std::shared_ptr< SDDPVisitedStates > > localStates;
+        if (p_bIncreaseCut && p_bLocalStateBuffer)
+        {
+            localStates.resize(nbThreads);
+            for (int iThread = 0; iThread < nbThreads; ++iThread)
+                localStates[iThread] = std::make_shared<SDDPVisitedStates>(regressor->getNbMeshTotal());
+        }
+        InstrumentationTimer timerOptimize(instOptimize);
         int isim;
-        #pragma omp parallel  for schedule(dynamic)  private(isim) reduction(+:gainAccumulator)
+        #pragma omp parallel  for schedule(dynamic)  private(isim)
         for (isim = 0; isim < iLPLast - iLPFirst; ++isim)
         {
             // simulation number according to simulator
@@ -110,14 +150,31 @@ double	forwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
             std::shared_ptr<Eigen::ArrayXd > newStateToStore = std::make_shared< Eigen::ArrayXd>(statePrev.col(isim)) ;
             double gainOrCost = p_optimizer->oneStepForward(aParticle, *newState, *newStateToStore, *static_cast<SDDPCutOptBase *>(linCut.get()), isimul);
             // accumulate gain
-            gainAccumulator += gainOrCost;
+            gainPerSimul(isim) += gainOrCost;
 
             // add state and associated mesh
             if (p_bIncreaseCut)
-                setOfStates.addVisitedState(newStateToStore, aParticle, *regressor);
+            {
+                if (p_bLocalStateBuffer)
+                {
+#ifdef _OPENMP
+                    int iThread = omp_get_thread_num() ;
+#else
+                    int iThread = 0;
+#endif
+                    localStates[iThread]->addVisitedStateLocal(newStateToStore, aParticle, *regressor);
+                }
+                else
+                    setOfStates.addVisitedState(newStateToStore, aParticle, *regressor);
+            }
             // update state
             statePrev.col(isim) = *newState;
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(iLPLast - iLPFirst);
+        // merge thread buffers
+        if (localStates.size() > 0)
+            setOfStates.mergeBuffers(std::vector< std::shared_ptr< SDDPVisitedStatesBase > >(localStates.begin(), localStates.end()));
         // store if root
 #ifdef USE_MPI
         if (idate <  p_dates.size() - 2)
@@ -127,12 +184,65 @@ double	forwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
         if (iTask == 0)
 #endif
             if (p_bIncreaseCut)
+            {
+                InstrumentationTimer timerStore(instIO);
                 *arVisitedStates << gs::Record(setOfStates, "States", "Top");
+            }
     }
+    double gainAccumulator = gainPerSimul.sum();
 #ifdef USE_MPI
     gainAccumulator = boost::mpi::all_reduce(p_world, gainAccumulator, std::plus<double>());
 #endif
-    return gainAccumulator / p_simulator->getNbSimul() ;
+    int nbSimul = p_simulator->getNbSimul();
+    double mean = gainAccumulator / nbSimul;
+    // deviations to the mean : the sum of the squared gains minus the squared mean cancels when the spread is small compared to the value
+    double deviationAccumulator = (gainPerSimul - mean).square().sum();
+#ifdef USE_MPI
+    deviationAccumulator = boost::mpi::all_reduce(p_world, deviationAccumulator, std::plus<double>());
+#endif
+    double variance = (nbSimul > 1) ? deviationAccumulator / (nbSimul - 1) : 0.;
+    return std::make_pair(mean, variance);
+}
+
+/// \brief Achieve  a forward sweep for SDDP
+/// \param p_optimizer              object defining a transition step for SDDP
+/// \param p_simulator              simulates uncertainties for regressions, inflows etc....
+/// \param p_dates                  vector of exercised dates
+/// \param p_initialState           initial state at the beginning of simulation
+/// \param p_finalCut               storing final cuts
+/// \param p_regressors            regressors of all dates
+/// \param p_archiveCutToRead       archive storing cuts visited
+/// \param p_nameVisitedStates      name of the archive used to store   visited states
+/// \param p_bIncreaseCut           true if this simulation part create visited state for cut
+/// \param  p_world               MPI communicator
+/// \param p_bLocalStateBuffer     if true, each thread stores its visited states in its own buffer
+/// \param p_cutStore              if defined, cuts are taken from this store instead of being read in p_archiveCutToRead
+/// \param p_bMultiCut             true if cuts have been generated with the multi cut formulation (one cut per sample)
+/// \return value obtained with this simulations
+template<  class LocalRegressionForSDDP>
+double	forwardSDDP(const std::shared_ptr<OptimizerSDDPBase> &p_optimizer,
+                    const std::shared_ptr<SimulatorSDDPBase> &p_simulator,
+                    const Eigen::ArrayXd &p_dates,
+                    const Eigen::ArrayXd &p_initialState,
+                    const SDDPFinalCut &p_finalCut,
+                    const bool   &p_bIncreaseCut,
+                    const SDDPRegressorStore<LocalRegressionForSDDP> &p_regressors,
+                    const std::shared_ptr<gs::BinaryFileArchive> &p_archiveCutToRead,
+                    const std::string &p_nameVisitedStates
+#ifdef USE_MPI
+                    , const boost::mpi::communicator &p_world
+#endif
+                    , const bool &p_bLocalStateBuffer = false
+                    , const std::shared_ptr<SDDPCutStore> &p_cutStore = std::shared_ptr<SDDPCutStore>()
+                    , const bool &p_bMultiCut = false
+                  )
+{
+    return forwardSDDPMeanAndVariance<LocalRegressionForSDDP>(p_optimizer, p_simulator, p_dates, p_initialState, p_finalCut, p_bIncreaseCut,
+            p_regressors, p_archiveCutToRead, p_nameVisitedStates
+#ifdef USE_MPI
+            , p_world
+#endif
+            , p_bLocalStateBuffer, p_cutStore, p_bMultiCut).first;
 }
 }
 #endif
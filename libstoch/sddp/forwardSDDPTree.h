@@ -10,6 +10,7 @@
 #include "libstoch/sddp/SDDPVisitedStatesTreeGeners.h"
 #include "libstoch/sddp/SimulatorSDDPBaseTree.h"
 #include "libstoch/sddp/SDDPCutTree.h"
+#include "libstoch/core/utils/Instrumentation.h"
 
 /** \file forwardSDDPTree.h
  * \brief On sequence of forward resolution by SDDP specialized with tree
@@ -67,6 +68,7 @@ double	forwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>    &p_optimizer,
     double gainAccumulator = 0;
     for (int idate = 0; idate < p_dates.size() - 1; ++idate)
     {
+        InstrumentationStep instStep("forwardSDDPTree");
         // update new date
         p_optimizer->updateDates(p_dates(idate), p_dates(idate + 1));
 
@@ -83,15 +85,18 @@ double	forwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>    &p_optimizer,
             linCut  = std::make_unique< SDDPFinalCutTree>(p_finalCut);
 
         // load cuts
+        InstrumentationTimer timerIO(instIO);
         linCut->loadCuts(p_archiveCutToRead
 #ifdef USE_MPI
                          , p_world
 #endif
                         );
+        timerIO.stop();
 
         // to store visited states
         SDDPVisitedStatesTree setOfStates(p_simulator->getNbNodes());
 
+        InstrumentationTimer timerOptimize(instOptimize);
         int isim;
         #pragma omp parallel  for schedule(dynamic)  private(isim) reduction(+:gainAccumulator)
         for (isim = 0; isim < iLPLast - iLPFirst; ++isim)
@@ -116,6 +121,8 @@ double	forwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>    &p_optimizer,
             // update state
             statePrev.col(isim) = *newState;
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(iLPLast - iLPFirst);
         // step forward  for simulator : update positions  in tree
         p_simulator->stepForward();
 
@@ -128,7 +135,10 @@ double	forwardSDDPTree(std::shared_ptr<OptimizerSDDPBase>    &p_optimizer,
         if (iTask == 0)
 #endif
             if (p_bIncreaseCut)
+            {
+                InstrumentationTimer timerStore(instIO);
                 *arVisitedStates << gs::Record(setOfStates, "States", "Top");
+            }
     }
 #ifdef USE_MPI
     gainAccumulator = boost::mpi::all_reduce(p_world, gainAccumulator, std::plus<double>());
@@ -16,12 +16,12 @@ using namespace std;
 
 InitialValueDist::InitialValueDist(const  shared_ptr<FullGrid> &p_pGridCurrent, const int &p_nbRegime,
                                    const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,
-                                   const boost::mpi::communicator &p_world): m_pGridCurrent(p_pGridCurrent), m_nDim(p_pGridCurrent->getDimension()), m_nbRegime(p_nbRegime)
+                                   const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting): m_pGridCurrent(p_pGridCurrent), m_nDim(p_pGridCurrent->getDimension()), m_nbRegime(p_nbRegime)
 {
     // initial dimension
     ArrayXi initialDimension   = p_pGridCurrent->getDimensions();
     // organize the hypercube splitting for parallel
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, p_bdimToSplit, p_world);
+    ArrayXi splittingRatio = p_splitting(initialDimension, p_bdimToSplit, p_world);
     // grid treated by current processor
     m_gridCurrentProc = m_pGridCurrent->getSubGrid(paraSplitComputationGridsProc(initialDimension, splittingRatio, p_world.rank()));
 }
@@ -8,6 +8,7 @@
 #include <boost/mpi.hpp>
 #include <Eigen/Dense>
 #include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
 
 /** \file InitialValueDist.h
  *  \brief permits to affect a final value to a regression problem
@@ -36,8 +37,9 @@ public :
     /// \param p_nbRegime       numbers of regime treated
     /// \param p_bdimToSplit    Dimensions to split for parallelism
     /// \param p_world          MPI communicator
+    /// \param p_splitting      splitting of the grid between processors (the same as the one of the transition steps)
     InitialValueDist(const  std::shared_ptr<FullGrid> &p_pGridCurrent, const int &p_nbRegime, const Eigen::Array< bool, Eigen::Dynamic, 1>   &p_bdimToSplit,
-                     const boost::mpi::communicator &p_world);
+                     const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     ///\brief Fill in array with values
     /// \param p_funcValue    function giving the final value  (arguments are  the state :  regime, point coordinates )
@@ -4,8 +4,9 @@
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/semilagrangien/SimulateStepSemilagrang.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/grids/FullGridGeners.h"
@@ -29,6 +30,7 @@ SimulateStepSemilagrang::SimulateStepSemilagrang(gs::BinaryFileArchive &p_ar,  c
     , m_world(p_world)
 #endif
 {
+    InstrumentationTimer timerIO(instIO, true);
     vector< shared_ptr<ArrayXd>  > vecFunctionNext;
     string valDump = p_name + "Val";
     gs::Reference<decltype(vecFunctionNext)>(p_ar, valDump.c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &vecFunctionNext);
@@ -43,6 +45,7 @@ SimulateStepSemilagrang::SimulateStepSemilagrang(gs::BinaryFileArchive &p_ar,  c
 
 void SimulateStepSemilagrang::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd &p_statevector, ArrayXi &p_iReg, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepSemilagrang");
 #ifdef USE_MPI
     int rank = m_world.rank();
     int nbProc = m_world.size();    // parallelism
@@ -54,6 +57,7 @@ void SimulateStepSemilagrang::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd &p_
     ArrayXXd valueFunctionPerSim(p_phiInOut.rows(), iLastSim - iFirstSim);
     // spread calculations on processors
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -66,10 +70,13 @@ void SimulateStepSemilagrang::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd &p_
         statePerSim.col(is - iFirstSim) = p_statevector.col(is);
         valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut.col(is);
     }
-    boost::mpi::all_gatherv<double>(m_world, statePerSim.data(), statePerSim.size(), p_statevector.data());
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
+    timerOptimize.stop();
+    instrumentOptimizeCalls(iLastSim - iFirstSim);
+    allGatherv<double>(m_world, statePerSim.data(), statePerSim.size(), p_statevector.data());
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
 #else
     int is ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -80,5 +87,7 @@ void SimulateStepSemilagrang::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd &p_
             phiInPt[iReg] = m_specInterp[iReg]->apply(p_statevector.col(is));
         m_pOptimize->stepSimulate(*m_gridNext, m_semiLag, p_statevector.col(is), p_iReg(is), p_gaussian.col(is), phiInPt, p_phiInOut.col(is));
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(p_statevector.cols());
 #endif
 }
@@ -4,8 +4,9 @@
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #include <boost/mpi/collectives.hpp>
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/semilagrangien/SimulateStepSemilagrangControl.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/grids/FullGridGeners.h"
@@ -30,6 +31,7 @@ SimulateStepSemilagrangControl::SimulateStepSemilagrangControl(gs::BinaryFileArc
     , m_world(p_world)
 #endif
 {
+    InstrumentationTimer timerIO(instIO, true);
     string valDump = p_name + "Control";
     vector< shared_ptr<ArrayXd > > control;
     gs::Reference<decltype(control)>(p_ar, valDump.c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &control);
@@ -40,6 +42,7 @@ SimulateStepSemilagrangControl::SimulateStepSemilagrangControl(gs::BinaryFileArc
 
 void SimulateStepSemilagrangControl::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd &p_statevector, ArrayXi &p_iReg, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepSemilagrangControl");
 #ifdef USE_MPI
     int rank = m_world.rank();
     int nbProc = m_world.size();    // parallelism
@@ -51,6 +54,7 @@ void SimulateStepSemilagrangControl::oneStep(const ArrayXXd   &p_gaussian, Array
     ArrayXXd valueFunctionPerSim(p_phiInOut.rows(), iLastSim - iFirstSim);
     // spread calculations on processors
     int  is = 0 ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -60,10 +64,13 @@ void SimulateStepSemilagrangControl::oneStep(const ArrayXXd   &p_gaussian, Array
         statePerSim.col(is - iFirstSim) = p_statevector.col(is);
         valueFunctionPerSim.col(is - iFirstSim) = p_phiInOut.col(is);
     }
-    boost::mpi::all_gatherv<double>(m_world, statePerSim.data(), statePerSim.size(), p_statevector.data());
-    boost::mpi::all_gatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
+    timerOptimize.stop();
+    instrumentOptimizeCalls(iLastSim - iFirstSim);
+    allGatherv<double>(m_world, statePerSim.data(), statePerSim.size(), p_statevector.data());
+    allGatherv<double>(m_world, valueFunctionPerSim.data(), valueFunctionPerSim.size(), p_phiInOut.data());
 #else
     int is ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
     #pragma omp parallel for  private(is)
 #endif
@@ -71,5 +78,7 @@ void SimulateStepSemilagrangControl::oneStep(const ArrayXXd   &p_gaussian, Array
     {
         m_pOptimize->stepSimulateControl(*m_gridNext, m_controlInterp, p_statevector.col(is), p_iReg(is), p_gaussian.col(is), p_phiInOut.col(is));
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(p_statevector.cols());
 #endif
 }
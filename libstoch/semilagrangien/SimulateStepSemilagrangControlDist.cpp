@@ -6,6 +6,7 @@
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
 #include "libstoch/semilagrangien/SemiLagrangEspCond.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/semilagrangien/SimulateStepSemilagrangControlDist.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/utils/types.h"
@@ -17,7 +18,7 @@
 #include "libstoch/core/grids/InterpolatorSpectral.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/utils/NodeParticleSplitting.h"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 
 using namespace std;
 using namespace libstoch;
@@ -29,10 +30,11 @@ SimulateStepSemilagrangControlDist::SimulateStepSemilagrangControlDist(gs::Binar
         const shared_ptr<FullGrid> &p_gridNext,
         const shared_ptr<libstoch::OptimizerSLBase > &p_pOptimize,
         const bool &p_bOneFile,
-        const boost::mpi::communicator &p_world):
+        const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting):
     m_gridCur(p_gridCur), m_gridNext(p_gridNext), m_pOptimize(p_pOptimize),
     m_bOneFile(p_bOneFile), m_world(p_world)
 {
+    InstrumentationTimer timerIO(instIO, true);
     string valDump = p_name + "Control";
     gs::Reference<decltype(m_control)>(p_ar, valDump.c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_control);
     if (!m_bOneFile)
@@ -40,13 +42,14 @@ SimulateStepSemilagrangControlDist::SimulateStepSemilagrangControlDist(gs::Binar
         vector<int> initialVecDimension;
         gs::Reference< 	vector<int> >(p_ar, "initialSizeOfMesh", boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &initialVecDimension);
         Map<const ArrayXi > initialDimension(initialVecDimension.data(), initialVecDimension.size());
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, p_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = p_splitting(initialDimension, p_pOptimize->getDimensionToSplit(), m_world);
         m_parall =  make_shared<ParallelComputeGridSplitting>(initialDimension, splittingRatio, m_world);
     }
 }
 
 void SimulateStepSemilagrangControlDist::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd &p_statevector, ArrayXi &p_iReg, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepSemilagrangControlDist");
     // spread simulations on processors
     unique_ptr<ArrayXXd >  particles(new ArrayXXd(p_statevector.transpose()));
     ArrayXi splittingRatio = ArrayXi::Constant(m_gridNext->getDimension(), 1);
@@ -83,6 +86,7 @@ void SimulateStepSemilagrangControlDist::oneStep(const ArrayXXd   &p_gaussian, A
 
         // store value function
         int  is ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         #pragma omp parallel for  private(is)
 #endif
@@ -95,6 +99,8 @@ void SimulateStepSemilagrangControlDist::oneStep(const ArrayXXd   &p_gaussian, A
             regPerProc(is) = p_iReg(simuNumber);
             phiPerProc.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     else
     {
@@ -127,6 +133,7 @@ void SimulateStepSemilagrangControlDist::oneStep(const ArrayXXd   &p_gaussian, A
 
         // store value function
         int is ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         #pragma omp parallel for  private(is)
 #endif
@@ -139,16 +146,18 @@ void SimulateStepSemilagrangControlDist::oneStep(const ArrayXXd   &p_gaussian, A
             regPerProc(is) = p_iReg(simuNumber);
             phiPerProc.col(is) = p_phiInOut.col(simuNumber);
         }
+        timerOptimize.stop();
+        instrumentOptimizeCalls(simCurrentProc.size());
     }
     // broadcast
     vector<double> stateAllSim;
-    boost::mpi::all_gatherv<double>(m_world, statePerProc.data(), statePerProc.size(), stateAllSim);
+    allGatherv<double>(m_world, statePerProc.data(), statePerProc.size(), stateAllSim);
     vector<int> regAllSim;
-    boost::mpi::all_gatherv<int>(m_world, regPerProc.data(), regPerProc.size(), regAllSim);
+    allGatherv<int>(m_world, regPerProc.data(), regPerProc.size(), regAllSim);
     vector<double> phiAllSim;
-    boost::mpi::all_gatherv<double>(m_world, phiPerProc.data(), phiPerProc.size(), phiAllSim);
+    allGatherv<double>(m_world, phiPerProc.data(), phiPerProc.size(), phiAllSim);
     vector<int> simAllProc;
-    boost::mpi::all_gatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
+    allGatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
 
     // update results
     int iis = 0;
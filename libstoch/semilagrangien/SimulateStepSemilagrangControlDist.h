@@ -47,12 +47,14 @@ public :
     /// \param p_pOptimize        Optimize object defining the transition step
     /// \param p_bOneFile              do we store continuation values  in only one file
     /// \param p_world            MPI communicator
+    /// \param p_splitting        splitting of the grid between processors (the same as the one used in optimization)
     SimulateStepSemilagrangControlDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const std::string &p_name,
                                        const std::shared_ptr<FullGrid>   &p_gridCur,
                                        const std::shared_ptr<FullGrid> &p_gridNext,
                                        const std::shared_ptr<OptimizerSLBase > &p_pOptimize,
                                        const bool &p_bOneFile,
-                                       const boost::mpi::communicator &p_world);
+                                       const boost::mpi::communicator &p_world,
+                                       const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief Define one step arbitraging between possible commands
     /// \param p_gaussian       2 dimensional Gaussian array (size : number of Brownians motion by number of simulations)
@@ -6,6 +6,7 @@
 #include "geners/Reference.hh"
 #include "geners/vectorIO.hh"
 #include "libstoch/semilagrangien/SemiLagrangEspCond.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/semilagrangien/SimulateStepSemilagrangDist.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/utils/types.h"
@@ -17,7 +18,8 @@
 #include "libstoch/core/grids/InterpolatorSpectral.h"
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/utils/NodeParticleSplitting.h"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
+#include "libstoch/core/parallelism/DistributedParticles.h"
 
 using namespace std;
 using namespace libstoch;
@@ -28,10 +30,11 @@ SimulateStepSemilagrangDist::SimulateStepSemilagrangDist(gs::BinaryFileArchive &
         const shared_ptr<FullGrid> &p_gridNext,
         const  shared_ptr<libstoch::OptimizerSLBase > &p_pOptimize,
         const bool &p_bOneFile,
-        const boost::mpi::communicator &p_world):
+        const boost::mpi::communicator &p_world, const SplittingFunction &p_splitting):
     m_gridNext(p_gridNext), m_pOptimize(p_pOptimize),
     m_bOneFile(p_bOneFile), m_world(p_world)
 {
+    InstrumentationTimer timerIO(instIO, true);
     string valDump = p_name + "Val";
     gs::Reference<decltype(m_vecFunctionNext)>(p_ar, valDump.c_str(), boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &m_vecFunctionNext);
     if (!m_bOneFile)
@@ -39,13 +42,64 @@ SimulateStepSemilagrangDist::SimulateStepSemilagrangDist(gs::BinaryFileArchive &
         vector<int> initialVecDimensionNext;
         gs::Reference< 	vector<int> >(p_ar, "initialSizeOfMeshPrev", boost::lexical_cast<string>(p_iStep).c_str()).restore(0, &initialVecDimensionNext);
         Map<const ArrayXi > initialDimensionNext(initialVecDimensionNext.data(), initialVecDimensionNext.size());
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimensionNext, m_pOptimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = p_splitting(initialDimensionNext, m_pOptimize->getDimensionToSplit(), m_world);
         m_parall =  make_shared<ParallelComputeGridSplitting>(initialDimensionNext, splittingRatio, m_world);
     }
 }
 
+shared_ptr<FullGrid> SimulateStepSemilagrangDist::createSemiLagrang(const vector< array< double, 2> > &p_region,
+        vector< shared_ptr<InterpolatorSpectral> > &p_specInterp,
+        vector< shared_ptr<SemiLagrangEspCond> > &p_semiLag) const
+{
+    p_specInterp.resize(m_vecFunctionNext.size());
+    p_semiLag.resize(m_vecFunctionNext.size());
+    if (m_bOneFile)
+    {
+        // create interpolator and semi lagrangian
+        for (size_t ireg = 0; ireg <  m_vecFunctionNext.size(); ++ireg)
+        {
+            p_specInterp[ireg] = m_gridNext->createInterpolatorSpectral(*m_vecFunctionNext[ireg]);
+            p_semiLag[ireg] = make_shared<SemiLagrangEspCond>(p_specInterp[ireg], m_gridNext->getExtremeValues(), m_pOptimize->getBModifVol());
+        }
+        return m_gridNext;
+    }
+    // calculate extended grids
+    std::vector<  std::array< double, 2>  > cone = m_pOptimize->getCone(p_region);
+    // now get subgrid correspond to the cone
+    SubMeshIntCoord retGrid(m_gridNext->getDimension());
+    std::vector <std::array< double, 2>  > extremVal =  m_gridNext->getExtremeValues();
+    ArrayXd xCapMin(m_gridNext->getDimension()), xCapMax(m_gridNext->getDimension());
+    for (int id = 0; id <  m_gridNext->getDimension(); ++id)
+    {
+        xCapMin(id)   = std::max(cone[id][0], extremVal[id][0]);
+        xCapMax(id)  = std::min(cone[id][1], extremVal[id][1]);
+    }
+    ArrayXi  iCapMin =  m_gridNext->lowerPositionCoord(xCapMin);
+    ArrayXi  iCapMax =  m_gridNext->upperPositionCoord(xCapMax) + 1; // last is excluded
+    for (int id = 0; id <  m_gridNext->getDimension(); ++id)
+    {
+        retGrid(id)[0] = iCapMin(id);
+        retGrid(id)[1] = iCapMax(id);
+    }
+    // extend continuation values
+    shared_ptr<FullGrid> gridExtended = m_gridNext->getSubGrid(retGrid);
+    std::vector< shared_ptr<Eigen::ArrayXd>  > vecFuncNextExtended(m_vecFunctionNext.size());
+    for (size_t iReg = 0; iReg < m_vecFunctionNext.size(); ++iReg)
+    {
+        vecFuncNextExtended[iReg] = make_shared<Eigen::ArrayXd>(m_parall->reconstructAll<double>(*m_vecFunctionNext[iReg], retGrid));
+    }
+    // create interpolator and semi lagrangian
+    for (size_t ireg = 0; ireg <   m_vecFunctionNext.size(); ++ireg)
+    {
+        p_specInterp[ireg] = gridExtended->createInterpolatorSpectral(*vecFuncNextExtended[ireg]);
+        p_semiLag[ireg] = make_shared<SemiLagrangEspCond>(p_specInterp[ireg], gridExtended->getExtremeValues(), m_pOptimize->getBModifVol());
+    }
+    return gridExtended;
+}
+
 void SimulateStepSemilagrangDist::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd &p_statevector, ArrayXi &p_iReg, ArrayXXd  &p_phiInOut) const
 {
+    InstrumentationStep instStep("SimulateStepSemilagrangDist");
     // spread simulations on processors
     unique_ptr<ArrayXXd >  particles(new ArrayXXd(p_statevector.transpose()));
     ArrayXi splittingRatio = ArrayXi::Constant(m_gridNext->getDimension(), 1);
@@ -73,99 +127,43 @@ void SimulateStepSemilagrangDist::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd
     // to store regime and value per proc...
     ArrayXi regPerProc(simCurrentProc.size());
     ArrayXXd phiPerProc(m_pOptimize->getSimuFuncSize(), simCurrentProc.size());
-    if (m_bOneFile)
-    {
-        // create interpolator and semi lagrangian
-        vector<std::shared_ptr<InterpolatorSpectral> > specInterp(m_vecFunctionNext.size());
-        vector<shared_ptr<SemiLagrangEspCond> > semiLag(m_vecFunctionNext.size()) ;
-        for (size_t ireg = 0; ireg <  m_vecFunctionNext.size(); ++ireg)
-        {
-            specInterp[ireg] = m_gridNext->createInterpolatorSpectral(*m_vecFunctionNext[ireg]);
-            semiLag[ireg] = make_shared<SemiLagrangEspCond>(specInterp[ireg], m_gridNext->getExtremeValues(), m_pOptimize->getBModifVol());
-        }
-        // store value function
-        int is ;
+    // region treated by the processor
+    std::vector<  std::array< double, 2>  >  regionByProcessor(splittingRatio.size());
+    for (int id = 0; id < splittingRatio.size() ; ++id)
+        regionByProcessor[id] = meshToCoord(id, m_world.rank());
+    // create interpolator and semi lagrangian
+    vector<std::shared_ptr<InterpolatorSpectral> > specInterp;
+    vector<shared_ptr<SemiLagrangEspCond> > semiLag;
+    shared_ptr<FullGrid> gridInterp = createSemiLagrang(regionByProcessor, specInterp, semiLag);
+    // store value function
+    int is ;
+    InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
-        #pragma omp parallel for  private(is)
+    #pragma omp parallel for  private(is)
 #endif
-        for (is = 0; is <  static_cast<int>(simCurrentProc.size()); ++is)
-        {
-            int simuNumber = simCurrentProc[is];
-            ArrayXd phiInPt(semiLag.size());
-            for (size_t iReg = 0; iReg < semiLag.size(); ++iReg)
-                phiInPt[iReg] = specInterp[iReg]->apply(p_statevector.col(simuNumber));
-            m_pOptimize->stepSimulate(*m_gridNext, semiLag, p_statevector.col(simuNumber), p_iReg(simuNumber), p_gaussian.col(simuNumber), phiInPt, p_phiInOut.col(simuNumber));
-            // copy result per proc for broadcast
-            statePerProc.segment(is * m_gridNext->getDimension(), m_gridNext->getDimension()) = p_statevector.col(simuNumber);
-            regPerProc(is) = p_iReg(simuNumber);
-            phiPerProc.col(is) = p_phiInOut.col(simuNumber);
-        }
-    }
-    else
+    for (is = 0; is <  static_cast<int>(simCurrentProc.size()); ++is)
     {
-        // calculate extended grids
-        std::vector<  std::array< double, 2>  >  regionByProcessor(splittingRatio.size());
-        for (int id = 0; id < splittingRatio.size() ; ++id)
-            regionByProcessor[id] = meshToCoord(id, m_world.rank());
-        std::vector<  std::array< double, 2>  > cone = m_pOptimize->getCone(regionByProcessor);
-        // now get subgrid correspond to the cone
-        SubMeshIntCoord retGrid(m_gridNext->getDimension());
-        std::vector <std::array< double, 2>  > extremVal =  m_gridNext->getExtremeValues();
-        ArrayXd xCapMin(m_gridNext->getDimension()), xCapMax(m_gridNext->getDimension());
-        for (int id = 0; id <  m_gridNext->getDimension(); ++id)
-        {
-            xCapMin(id)   = std::max(cone[id][0], extremVal[id][0]);
-            xCapMax(id)  = std::min(cone[id][1], extremVal[id][1]);
-        }
-        ArrayXi  iCapMin =  m_gridNext->lowerPositionCoord(xCapMin);
-        ArrayXi  iCapMax =  m_gridNext->upperPositionCoord(xCapMax) + 1; // last is excluded
-        for (int id = 0; id <  m_gridNext->getDimension(); ++id)
-        {
-            retGrid(id)[0] = iCapMin(id);
-            retGrid(id)[1] = iCapMax(id);
-        }
-        // extend continuation values
-        shared_ptr<FullGrid> gridExtended = m_gridNext->getSubGrid(retGrid);
-        std::vector< shared_ptr<Eigen::ArrayXd>  > vecFuncNextExtended(m_vecFunctionNext.size());
-        for (size_t iReg = 0; iReg < m_vecFunctionNext.size(); ++iReg)
-        {
-            vecFuncNextExtended[iReg] = make_shared<Eigen::ArrayXd>(m_parall->reconstructAll<double>(*m_vecFunctionNext[iReg], retGrid));
-        }
-        // create interpolator and semi lagrangian
-        vector<std::shared_ptr<InterpolatorSpectral> > specInterp(m_vecFunctionNext.size());
-        vector<shared_ptr<SemiLagrangEspCond> > semiLag(m_vecFunctionNext.size()) ;
-        for (size_t ireg = 0; ireg <   m_vecFunctionNext.size(); ++ireg)
-        {
-            specInterp[ireg] = gridExtended->createInterpolatorSpectral(*vecFuncNextExtended[ireg]);
-            semiLag[ireg] = make_shared<SemiLagrangEspCond>(specInterp[ireg], gridExtended->getExtremeValues(), m_pOptimize->getBModifVol());
-        }
-        // store value function
-        int  is ;
-#ifdef _OPENMP
-        #pragma omp parallel for  private(is)
-#endif
-        for (is = 0; is <  static_cast<int>(simCurrentProc.size()); ++is)
-        {
-            int simuNumber = simCurrentProc[is];
-            ArrayXd phiInPt(semiLag.size());
-            for (size_t iReg = 0; iReg < semiLag.size(); ++iReg)
-                phiInPt[iReg] = specInterp[iReg]->apply(p_statevector.col(simuNumber));
-            m_pOptimize->stepSimulate(*m_gridNext, semiLag, p_statevector.col(simuNumber), p_iReg(simuNumber), p_gaussian.col(simuNumber), phiInPt, p_phiInOut.col(simuNumber));
-            // copy result per proc for broadcast
-            statePerProc.segment(is * m_gridNext->getDimension(), m_gridNext->getDimension()) = p_statevector.col(simuNumber);
-            regPerProc(is) = p_iReg(simuNumber);
-            phiPerProc.col(is) = p_phiInOut.col(simuNumber);
-        }
+        int simuNumber = simCurrentProc[is];
+        ArrayXd phiInPt(semiLag.size());
+        for (size_t iReg = 0; iReg < semiLag.size(); ++iReg)
+            phiInPt[iReg] = specInterp[iReg]->apply(p_statevector.col(simuNumber));
+        m_pOptimize->stepSimulate(*m_gridNext, semiLag, p_statevector.col(simuNumber), p_iReg(simuNumber), p_gaussian.col(simuNumber), phiInPt, p_phiInOut.col(simuNumber));
+        // copy result per proc for broadcast
+        statePerProc.segment(is * m_gridNext->getDimension(), m_gridNext->getDimension()) = p_statevector.col(simuNumber);
+        regPerProc(is) = p_iReg(simuNumber);
+        phiPerProc.col(is) = p_phiInOut.col(simuNumber);
     }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(simCurrentProc.size());
     // broadcast
     vector<double> stateAllSim;
-    boost::mpi::all_gatherv<double>(m_world, statePerProc.data(), statePerProc.size(), stateAllSim);
+    allGatherv<double>(m_world, statePerProc.data(), statePerProc.size(), stateAllSim);
     vector<int> regAllSim;
-    boost::mpi::all_gatherv<int>(m_world, regPerProc.data(), regPerProc.size(), regAllSim);
+    allGatherv<int>(m_world, regPerProc.data(), regPerProc.size(), regAllSim);
     vector<double> phiAllSim;
-    boost::mpi::all_gatherv<double>(m_world, phiPerProc.data(), phiPerProc.size(), phiAllSim);
+    allGatherv<double>(m_world, phiPerProc.data(), phiPerProc.size(), phiAllSim);
     vector<int> simAllProc;
-    boost::mpi::all_gatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
+    allGatherv<int>(m_world, simCurrentProc.data(), simCurrentProc.size(), simAllProc);
 
     // update results
     int iis = 0;
@@ -178,4 +176,33 @@ void SimulateStepSemilagrangDist::oneStep(const ArrayXXd   &p_gaussian, ArrayXXd
         p_statevector.col(simAllProc[is]) = ptState ;
     }
 }
+
+void SimulateStepSemilagrangDist::oneStep(const ArrayXXd   &p_gaussian, DistributedParticles &p_particles) const
+{
+    InstrumentationStep instStep("SimulateStepSemilagrangDist");
+    ArrayXXd &states = p_particles.getStates();
+    ArrayXi &iReg = p_particles.getRegimes();
+    ArrayXXd &phiInOut = p_particles.getPhi();
+    const ArrayXi &simNumber = p_particles.getSimNumbers();
+    // create interpolator and semi lagrangian for the region of the simulations owned
+    vector<std::shared_ptr<InterpolatorSpectral> > specInterp;
+    vector<shared_ptr<SemiLagrangEspCond> > semiLag;
+    shared_ptr<FullGrid> gridInterp = createSemiLagrang(p_particles.getBoundingBox(), specInterp, semiLag);
+    int is ;
+    InstrumentationTimer timerOptimize(instOptimize);
+#ifdef _OPENMP
+    #pragma omp parallel for  private(is)
+#endif
+    for (is = 0; is <  static_cast<int>(simNumber.size()); ++is)
+    {
+        ArrayXd phiInPt(semiLag.size());
+        for (size_t ireg = 0; ireg < semiLag.size(); ++ireg)
+            phiInPt[ireg] = specInterp[ireg]->apply(states.col(is));
+        m_pOptimize->stepSimulate(*m_gridNext, semiLag, states.col(is), iReg(is), p_gaussian.col(simNumber(is)), phiInPt, phiInOut.col(is));
+    }
+    timerOptimize.stop();
+    instrumentOptimizeCalls(simNumber.size());
+    // simulations leaving the region of the processor
+    p_particles.migrate();
+}
 #endif
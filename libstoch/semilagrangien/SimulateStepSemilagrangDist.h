@@ -12,6 +12,8 @@
 #include "libstoch/semilagrangien/OptimizerSLBase.h"
 #include "libstoch/core/grids/FullGrid.h"
 #include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
+#include "libstoch/core/parallelism/DistributedParticles.h"
+#include "libstoch/semilagrangien/SemiLagrangEspCond.h"
 
 /** \file SimulateStepSemilagrangDist.h
  *  \brief  In simulation part, permits to  use  the PDE function  value to
@@ -34,6 +36,15 @@ private :
     std::shared_ptr<ParallelComputeGridSplitting>  m_parall  ; ///< parallel object for splitting and reconstruction
     boost::mpi::communicator  m_world ; ///< MPI communicator
 
+    /// \brief create the interpolators and semi Lagrangian objects for the simulations of a region
+    /// \param p_region      region of the simulations treated by the processor (not used with one file)
+    /// \param p_specInterp  for each regime, interpolator of the continuation values
+    /// \param p_semiLag     for each regime, semi Lagrangian object
+    /// \return grid of the interpolators (to keep alive while they are used)
+    std::shared_ptr<FullGrid> createSemiLagrang(const std::vector< std::array< double, 2> > &p_region,
+            std::vector< std::shared_ptr<InterpolatorSpectral> > &p_specInterp,
+            std::vector< std::shared_ptr<SemiLagrangEspCond> > &p_semiLag) const;
+
 public :
 
     /// \brief Constructor
@@ -44,10 +55,12 @@ public :
     /// \param p_pOptimize        Optimize object defining the transition step
     /// \param p_bOneFile              do we store continuation values  in only one file
     /// \param p_world            MPI communicator
+    /// \param p_splitting        splitting of the grid between processors (the same as the one used in optimization)
     SimulateStepSemilagrangDist(gs::BinaryFileArchive &p_ar,  const int &p_iStep,  const std::string &p_name,
                                 const std::shared_ptr<FullGrid> &p_gridNext, const  std::shared_ptr<OptimizerSLBase > &p_pOptimize,
                                 const bool &p_bOneFile,
-                                const boost::mpi::communicator &p_world);
+                                const boost::mpi::communicator &p_world,
+                                const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief Define one step arbitraging between possible commands
     /// \param p_gaussian       2 dimensional Gaussian array (size : number of Brownians motion by number of simulations)
@@ -56,6 +69,12 @@ public :
     /// \param p_phiInOut       actual contract values modified at current time step by applying an optimal command
     void oneStep(const Eigen::ArrayXXd   &p_gaussian, Eigen::ArrayXXd &p_statevector, Eigen::ArrayXi   &p_iReg, Eigen::ArrayXXd  &p_phiInOut) const;
 
+    /// \brief Same as above but with a persistent ownership of the simulations : only the simulations owned by the processor are
+    ///        treated, then the simulations leaving the region of the processor are migrated. No global communication of the simulations.
+    /// \param p_gaussian       2 dimensional Gaussian array (size : number of Brownians motion by  the total number of simulations)
+    /// \param p_particles      simulations owned by the processor (modified)
+    void oneStep(const Eigen::ArrayXXd   &p_gaussian, DistributedParticles &p_particles) const;
+
 };
 }
 #endif /* SIMULATESTEPSEMILAGRANGDIST_H */
@@ -7,7 +7,7 @@
 #include "geners/Record.hh"
 #ifdef USE_MPI
 #include "boost/mpi.hpp"
-#include "libstoch/core/parallelism/all_gatherv.hpp"
+#include "libstoch/core/parallelism/allGatherv.h"
 #endif
 #ifdef _OPENMP
 #include <omp.h>
@@ -15,6 +15,7 @@
 #endif
 #include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/semilagrangien/SemiLagrangEspCond.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/semilagrangien/TransitionStepSemilagrang.h"
 #include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/core/grids/SpaceGridGeners.h"
@@ -46,6 +47,7 @@ TransitionStepSemilagrang::TransitionStepSemilagrang(const  shared_ptr<SpaceGrid
 
 pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  TransitionStepSemilagrang::oneStep(const vector< shared_ptr< ArrayXd > > &p_phiIn, const double &p_time,  const function<double(const int &, const Eigen::ArrayXd &)> &p_boundaryFunc) const
 {
+    InstrumentationStep instStep("TransitionStepSemilagrang");
     // number of regimes at current time
     int nbRegimes = m_optimize->getNbRegime();
     vector< shared_ptr< ArrayXd > >  phiOut(nbRegimes);
@@ -96,6 +98,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
         int nbThreads = 1;
 #endif
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -106,6 +109,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator >  iterGridPoint = m_gridCurrent->getGridIterator();
 #ifdef USE_MPI
                 // account for mpi and threads
@@ -125,6 +129,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
                             phiPointIn(iReg) = vecInterpolator[iReg]->apply(pointCoord);
                         // optimize the current point and the set of regimes
                         pair< ArrayXd, ArrayXd>  solutionAndControl = m_optimize->stepOptimize(pointCoord, semilag, p_time, phiPointIn);
+                        instThread.countOptimize();
 #ifdef USE_MPI
                         // copie solution
                         int iposArray = iterGridPoint->getRelativePosition();
@@ -169,19 +174,20 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
 #ifdef USE_MPI
         ArrayXi ilocToGLobalGlob(nbPointsCur);
-        boost::mpi::all_gatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
+        allGatherv<int>(m_world, ilocToGLobal.data(), ilocToGLobal.size(), ilocToGLobalGlob.data());
         ArrayXd storeGlob(nbPointsCur);
         for (int iReg = 0; iReg < nbRegimes; ++iReg)
         {
-            boost::mpi::all_gatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
+            allGatherv<double>(m_world, phiOutLoc[iReg].data(), phiOutLoc[iReg].size(), storeGlob.data());
             for (int ipos = 0; ipos < ilocToGLobalGlob.size(); ++ipos)
                 (*phiOut[iReg])(ilocToGLobalGlob(ipos)) = storeGlob(ipos);
         }
         for (int iCont = 0 ; iCont < nbControl; ++iCont)
         {
-            boost::mpi::all_gatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
+            allGatherv<double>(m_world, controlOutLoc[iCont].data(), controlOutLoc[iCont].size(), storeGlob.data());
             for (int ipos = 0; ipos <  ilocToGLobalGlob.size(); ++ipos)
                 (*controlOut[iCont])(ilocToGLobalGlob(ipos)) = storeGlob(ipos);
         }
@@ -198,6 +204,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
 void TransitionStepSemilagrang::dumpValues(std::shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep, const vector< shared_ptr< ArrayXd > > &p_phiIn,
         const vector< shared_ptr< ArrayXd > > &p_control) const
 {
+    InstrumentationTimer timerIO(instIO);
     int rank = 0 ;
 #ifdef USE_MPI
     rank = m_world.rank();
@@ -17,6 +17,7 @@
 #include "libstoch/core/utils/primeNumber.h"
 #include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/semilagrangien/OptimizerSLBase.h"
+#include "libstoch/core/utils/Instrumentation.h"
 #include "libstoch/semilagrangien/TransitionStepSemilagrangDist.h"
 #include "libstoch/core/parallelism/GridReach.h"
 #include "libstoch/core/utils/eigenGeners.h"
@@ -35,15 +36,16 @@ using namespace  std;
 TransitionStepSemilagrangDist::TransitionStepSemilagrangDist(const  shared_ptr<FullGrid> &p_gridCurrent,
         const  shared_ptr<FullGrid> &p_gridPrevious,
         const  shared_ptr<OptimizerSLBase > &p_optimize,
-        const boost::mpi::communicator &p_world):
-    m_gridCurrent(p_gridCurrent), m_gridPrevious(p_gridPrevious), m_optimize(p_optimize), m_world(p_world)
+        const boost::mpi::communicator &p_world,
+        const SplittingFunction &p_splitting):
+    m_gridCurrent(p_gridCurrent), m_gridPrevious(p_gridPrevious), m_optimize(p_optimize), m_world(p_world), m_splitting(p_splitting)
 {
     // initial and previous dimensions
     ArrayXi initialDimension   = p_gridCurrent->getDimensions();
     ArrayXi initialDimensionPrev  = p_gridPrevious->getDimensions();
     // organize the hypercube splitting for parallel
-    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, p_optimize->getDimensionToSplit(), m_world);
-    ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, p_optimize->getDimensionToSplit(), m_world);
+    ArrayXi splittingRatio = m_splitting(initialDimension, p_optimize->getDimensionToSplit(), m_world);
+    ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, p_optimize->getDimensionToSplit(), m_world);
     // cone value
     function < SubMeshIntCoord(const SubMeshIntCoord &) > fMesh = GridReach<OptimizerSLBase>(p_gridCurrent, p_gridPrevious, p_optimize);
     // ParallelComputeGridsSplitting objects
@@ -63,6 +65,7 @@ TransitionStepSemilagrangDist::TransitionStepSemilagrangDist(const  shared_ptr<F
 
 pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  TransitionStepSemilagrangDist::oneStep(const vector< shared_ptr< ArrayXd > > &p_phiIn,  const double &p_time,   const function<double(const int &, const Eigen::ArrayXd &)> &p_boundaryFunc) const
 {
+    InstrumentationStep instStep("TransitionStepSemilagrangDist");
     // number of regimes at current time
     int nbRegimes = m_optimize->getNbRegime();
     vector< shared_ptr< ArrayXd > >  phiOut(nbRegimes);
@@ -111,6 +114,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
 
         // create iterator on current grid treated for processor
         int iThread = 0 ;
+        InstrumentationTimer timerOptimize(instOptimize);
 #ifdef _OPENMP
         OpenmpException excep; // deal with exception in openmp
         #pragma omp parallel for  private(iThread)
@@ -121,6 +125,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
             excep.run([&]
             {
 #endif
+                InstrumentationThread instThread;
                 shared_ptr< GridIterator > iterGridPoint = m_gridCurrentProc->getGridIterator();
 
                 // account fo threads
@@ -138,6 +143,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
                             phiPointIn(iReg) = vecInterpolator[iReg]->apply(pointCoord);
                         // optimize the current point and the set of regimes
                         std::pair< ArrayXd, ArrayXd>  solutionAndControl = m_optimize->stepOptimize(pointCoord, semilag, p_time, phiPointIn);
+                        instThread.countOptimize();
                         // copie solution
                         for (int  iReg = 0; iReg < nbRegimes; ++iReg)
                             (*phiOut[iReg])(iterGridPoint->getCount()) = solutionAndControl.first(iReg);
@@ -163,6 +169,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
 #ifdef _OPENMP
         excep.rethrow();
 #endif
+        timerOptimize.stop();
     }
     return make_pair(phiOut, controlOut);
 }
@@ -170,6 +177,7 @@ pair< vector< shared_ptr< ArrayXd > >, vector<  shared_ptr< ArrayXd > > >  Trans
 void TransitionStepSemilagrangDist::dumpValues(shared_ptr<gs::BinaryFileArchive> p_ar, const string &p_name, const int &p_iStep,
         const vector< shared_ptr< ArrayXd > > &p_phiIn, const vector< shared_ptr< ArrayXd > > &p_control, const bool &p_bOneFile) const
 {
+    InstrumentationTimer timerIO(instIO);
     string stepString = boost::lexical_cast<string>(p_iStep) ;
     ArrayXi initialDimensionPrev  = m_gridPrevious->getDimensions();
     ArrayXi initialDimension  = m_gridCurrent->getDimensions();
@@ -195,7 +203,7 @@ void TransitionStepSemilagrangDist::dumpValues(shared_ptr<gs::BinaryFileArchive>
             gridOnProc0Prev(id)[0] = 0 ;
             gridOnProc0Prev(id)[1] = initialDimensionPrev(id) ;
         }
-        ArrayXi splittingRatioPrev = paraOptimalSplitting(initialDimensionPrev, m_optimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatioPrev = m_splitting(initialDimensionPrev, m_optimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObjectPrev(initialDimensionPrev, splittingRatioPrev, m_world);
         vector< shared_ptr< ArrayXd > > vecArrayPrev(p_phiIn.size());
         for (size_t iReg = 0; iReg < p_phiIn.size(); ++iReg)
@@ -214,7 +222,7 @@ void TransitionStepSemilagrangDist::dumpValues(shared_ptr<gs::BinaryFileArchive>
             gridOnProc0(id)[0] = 0 ;
             gridOnProc0(id)[1] = initialDimension(id) ;
         }
-        ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, m_optimize->getDimensionToSplit(), m_world);
+        ArrayXi splittingRatio = m_splitting(initialDimension, m_optimize->getDimensionToSplit(), m_world);
         ParallelComputeGridSplitting  paralObject(initialDimension, splittingRatio, m_world);
         vector< shared_ptr< ArrayXd > > vecArray(p_control.size());
         for (size_t iCont = 0; iCont < p_control.size(); ++iCont)
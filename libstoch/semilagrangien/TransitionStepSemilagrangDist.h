@@ -39,14 +39,21 @@ private :
     std::shared_ptr<FullGrid>   m_gridCurrentProc ; ///< local grid  treated by the processor
     std::shared_ptr<FullGrid>   m_gridExtendPreviousStep; ///< give extended grid at previous step
     boost::mpi::communicator m_world ; ///< MPI communicator
+    SplittingFunction m_splitting ; ///< splitting of the grids between processors
 
 public :
 
     /// \brief Constructor
+    /// \param p_gridCurrent   grid at the current time step
+    /// \param p_gridPrevious  grid at the previously treated time step
+    /// \param p_optimize      optimizer object to optimize the problem on one time step
+    /// \param p_world         MPI communicator
+    /// \param p_splitting     splitting of the grids between processors (for example TopologySplitting)
     TransitionStepSemilagrangDist(const  std::shared_ptr<FullGrid> &p_gridCurrent,
                                   const  std::shared_ptr<FullGrid> &p_gridPrevious,
                                   const  std::shared_ptr<OptimizerSLBase > &p_optimize,
-                                  const boost::mpi::communicator &p_world);
+                                  const boost::mpi::communicator &p_world,
+                                  const SplittingFunction &p_splitting = paraOptimalSplitting);
 
     /// \brief One step for
     /// \param p_phiIn         for each regime the function value ( on the grid)
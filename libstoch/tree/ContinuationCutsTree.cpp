@@ -1,4 +1,6 @@
 
+#include <array>
+#include <algorithm>
 #include "libstoch/tree/ContinuationCutsTree.h"
 #include "libstoch/core/utils/comparisonUtils.h"
 
@@ -10,14 +12,14 @@ namespace libstoch
 {
 ContinuationCutsTree::ContinuationCutsTree(const  std::shared_ptr< SpaceGrid >   &p_grid,
         const std::shared_ptr< Tree >   &p_condExp,
-        const ArrayXXd &p_values) : m_grid(p_grid),  m_cutCoeff(p_grid->getDimension() + 1)
+        const ArrayXXd &p_values) : m_grid(p_grid),  m_cutCoeff(p_grid->getDimension() + 1), m_cacheSize(0), m_cacheSizeMax(1 << 25)
 
 {
     // nest on cuts
     for (int ic = 0; ic < p_grid->getDimension() + 1; ++ic)
     {
-        ArrayXXd  valLoc = p_values.block(ic * p_condExp->getNbNodesNextDate(), 0, p_condExp->getNbNodesNextDate(), p_values.cols());
-        m_cutCoeff[ic] = p_condExp->expCondMultiple(valLoc.transpose()).transpose();
+        m_cutCoeff[ic].resize(p_condExp->getNbNodes(), p_values.cols());
+        p_condExp->expCondMultipleNodesInRows(p_values.block(ic * p_condExp->getNbNodesNextDate(), 0, p_condExp->getNbNodesNextDate(), p_values.cols()), m_cutCoeff[ic]);
     }
     // for first coefficient cuts calculate  \f$ \bar a_0  = a_0 - \sum_{i=1}^d a_i \bar x_i \f$
     // iterator
@@ -36,51 +38,108 @@ ContinuationCutsTree::ContinuationCutsTree(const  std::shared_ptr< SpaceGrid >
 }
 
 
-ArrayXXd ContinuationCutsTree::getCutsANode(const ArrayXXd &p_hypStock, const int &p_node) const
+bool ContinuationCutsTree::subGridInHypercube(const FullGrid &p_grid, const ArrayXXd &p_hypStock, ArrayXi &p_iMin, ArrayXi &p_iMax) const
 {
-    int nbCutsCoeff = m_grid->getDimension() + 1;
-    // for return
-    ArrayXXd  cuts(nbCutsCoeff, m_grid->getNbPoints());
-    int iPointCut = 0;
-    // nest on grid points
-    shared_ptr<GridIterator> iterRegGrid = m_grid->getGridIterator();
-    while (iterRegGrid->isValid())
+    int nDim = p_grid.getDimension();
+    vector <array< double, 2>  > extremes = p_grid.getExtremeValues();
+    // hypercube truncated to the grid domain
+    ArrayXd xMin(nDim), xMax(nDim);
+    for (int id = 0 ; id < nDim; ++id)
     {
-        // coordinates
-        Eigen::ArrayXd pointCoordReg = iterRegGrid->getCoordinate();
-        // test if inside the hypercube
-        bool bInside = true;
-        for (int id = 0 ; id < pointCoordReg.size(); ++id)
-            if (isStrictlyLesser(pointCoordReg(id), p_hypStock(id, 0)) || (isStrictlyMore(pointCoordReg(id), p_hypStock(id, 1))))
+        if (isStrictlyMore(p_hypStock(id, 0), extremes[id][1]) || isStrictlyLesser(p_hypStock(id, 1), extremes[id][0]))
+            return false;
+        xMin(id) = max(p_hypStock(id, 0), extremes[id][0]);
+        xMax(id) = min(p_hypStock(id, 1), extremes[id][1]);
+    }
+    p_iMin = p_grid.lowerPositionCoord(xMin);
+    p_iMax = p_grid.upperPositionCoord(xMax);
+    const ArrayXi &nbPtDim = p_grid.getDimensions();
+    // adjust bounds in each dimension with the same tolerance as a point by point test
+    ArrayXi iCoord = p_iMin;
+    for (int id = 0 ; id < nDim; ++id)
+    {
+        // lower bound
+        while (iCoord(id) > 0)
+        {
+            iCoord(id) -= 1;
+            if (isStrictlyLesser(p_grid.getCoordinateFromIntCoord(iCoord)(id), p_hypStock(id, 0)))
             {
-                bInside = false;
+                iCoord(id) += 1;
                 break;
             }
-        if (bInside)
+        }
+        while ((iCoord(id) < nbPtDim(id)) && isStrictlyLesser(p_grid.getCoordinateFromIntCoord(iCoord)(id), p_hypStock(id, 0)))
+            iCoord(id) += 1;
+        if (iCoord(id) == nbPtDim(id))
+            return false;
+        p_iMin(id) = iCoord(id);
+        // upper bound
+        iCoord(id) = min(p_iMax(id), nbPtDim(id) - 1);
+        while (iCoord(id) < nbPtDim(id) - 1)
         {
-            // point number
-            int ipoint =  iterRegGrid->getCount();
+            iCoord(id) += 1;
+            if (isStrictlyMore(p_grid.getCoordinateFromIntCoord(iCoord)(id), p_hypStock(id, 1)))
+            {
+                iCoord(id) -= 1;
+                break;
+            }
+        }
+        while ((iCoord(id) >= p_iMin(id)) && isStrictlyMore(p_grid.getCoordinateFromIntCoord(iCoord)(id), p_hypStock(id, 1)))
+            iCoord(id) -= 1;
+        if (iCoord(id) < p_iMin(id))
+            return false;
+        p_iMax(id) = iCoord(id);
+        iCoord(id) = p_iMin(id);
+    }
+    return true;
+}
 
+ArrayXXd ContinuationCutsTree::extractCutsInSubGrid(const FullGrid &p_grid, const ArrayXi &p_iMin, const ArrayXi &p_iMax, const int &p_node) const
+{
+    int nbCutsCoeff = m_cutCoeff.size();
+    int nbNodes =  m_cutCoeff[0].rows();
+    ArrayXi nbPtSub = p_iMax - p_iMin + 1;
+    int nbFirstDim = nbPtSub(0);
+    int nbSlab = nbPtSub.prod() / nbFirstDim;
+    ArrayXXd cuts((p_node < 0 ? nbCutsCoeff * nbNodes : nbCutsCoeff), nbPtSub.prod());
+    ArrayXi iCoord = p_iMin;
+    int iPointCut = 0;
+    for (int islab = 0; islab < nbSlab; ++islab)
+    {
+        // points in the first dimension are contiguous
+        int ipoint = p_grid.intCoordPerDimToGlobal(iCoord);
+        if (p_node < 0)
+        {
             for (int jc = 0; jc < nbCutsCoeff; ++jc)
+                cuts.block(jc * nbNodes, iPointCut, nbNodes, nbFirstDim) = m_cutCoeff[jc].block(0, ipoint, nbNodes, nbFirstDim);
+        }
+        else
+        {
+            for (int jc = 0; jc < nbCutsCoeff; ++jc)
+                cuts.row(jc).segment(iPointCut, nbFirstDim) = m_cutCoeff[jc].row(p_node).segment(ipoint, nbFirstDim);
+        }
+        iPointCut += nbFirstDim;
+        // next slab
+        for (int id = 1; id < iCoord.size(); ++id)
+        {
+            if (iCoord(id) < p_iMax(id))
             {
-                // reconstruct the value for all simulations
-                cuts(jc, iPointCut) =  m_cutCoeff[jc](p_node, ipoint);
+                iCoord(id) += 1;
+                break;
             }
-            iPointCut += 1;
+            iCoord(id) = p_iMin(id);
         }
-        iterRegGrid->next();
     }
-    cuts.conservativeResize(nbCutsCoeff, iPointCut);
     return cuts;
 }
 
-
-ArrayXXd  ContinuationCutsTree::getCutsAllNodes(const ArrayXXd &p_hypStock) const
+ArrayXXd ContinuationCutsTree::extractCutsByIterator(const ArrayXXd &p_hypStock, const int &p_node) const
 {
     int nbCutsCoeff = m_grid->getDimension() + 1;
     int nbNodes =  m_cutCoeff[0].rows();
+    int nbRows = (p_node < 0 ? nbCutsCoeff * nbNodes : nbCutsCoeff);
     // for return
-    ArrayXXd  cuts(nbCutsCoeff * nbNodes, m_grid->getNbPoints());
+    ArrayXXd  cuts(nbRows, m_grid->getNbPoints());
     int iPointCut = 0;
     // nest on grid points
     shared_ptr<GridIterator> iterRegGrid = m_grid->getGridIterator();
@@ -100,17 +159,73 @@ ArrayXXd  ContinuationCutsTree::getCutsAllNodes(const ArrayXXd &p_hypStock) cons
         {
             // point number
             int ipoint =  iterRegGrid->getCount();
-
-            for (int jc = 0; jc < nbCutsCoeff; ++jc)
+            if (p_node < 0)
             {
-                // reconstruct the value for all simulations
-                cuts.col(iPointCut).segment(jc * nbNodes, nbNodes) = m_cutCoeff[jc].col(ipoint);
+                for (int jc = 0; jc < nbCutsCoeff; ++jc)
+                    cuts.col(iPointCut).segment(jc * nbNodes, nbNodes) = m_cutCoeff[jc].col(ipoint);
+            }
+            else
+            {
+                for (int jc = 0; jc < nbCutsCoeff; ++jc)
+                    cuts(jc, iPointCut) =  m_cutCoeff[jc](p_node, ipoint);
             }
             iPointCut += 1;
         }
         iterRegGrid->next();
     }
-    cuts.conservativeResize(nbCutsCoeff * nbNodes, iPointCut);
+    cuts.conservativeResize(nbRows, iPointCut);
+    return cuts;
+}
+
+shared_ptr<const ArrayXXd> ContinuationCutsTree::getCuts(const ArrayXXd &p_hypStock, const int &p_node) const
+{
+    shared_ptr<FullGrid> fullGrid = dynamic_pointer_cast<FullGrid>(m_grid);
+    if (!fullGrid)
+        return make_shared<ArrayXXd>(extractCutsByIterator(p_hypStock, p_node));
+    ArrayXi iMin, iMax;
+    if (!subGridInHypercube(*fullGrid, p_hypStock, iMin, iMax))
+        return make_shared<ArrayXXd>((p_node < 0 ? m_cutCoeff.size() * m_cutCoeff[0].rows() : m_cutCoeff.size()), 0);
+    // key for cache
+    vector<int> key;
+    key.reserve(1 + 2 * iMin.size());
+    key.push_back(p_node);
+    for (int id = 0; id < iMin.size(); ++id)
+        key.push_back(iMin(id));
+    for (int id = 0; id < iMax.size(); ++id)
+        key.push_back(iMax(id));
+    shared_ptr<const ArrayXXd> cuts;
+    #pragma omp critical (cacheCutsTree)
+    {
+        map< vector<int>, shared_ptr<const ArrayXXd> >::const_iterator iterCache = m_cacheCuts.find(key);
+        if (iterCache != m_cacheCuts.end())
+            cuts = iterCache->second;
+    }
+    if (cuts)
+        return cuts;
+    cuts = make_shared<ArrayXXd>(extractCutsInSubGrid(*fullGrid, iMin, iMax, p_node));
+    #pragma omp critical (cacheCutsTree)
+    {
+        map< vector<int>, shared_ptr<const ArrayXXd> >::const_iterator iterCache = m_cacheCuts.find(key);
+        if (iterCache != m_cacheCuts.end())
+            // extracted by another thread in between
+            cuts = iterCache->second;
+        else if (m_cacheSize + cuts->size() <= m_cacheSizeMax)
+        {
+            m_cacheCuts[key] = cuts;
+            m_cacheSize += cuts->size();
+        }
+    }
     return cuts;
 }
+
+shared_ptr<const ArrayXXd> ContinuationCutsTree::getCutsANode(const ArrayXXd &p_hypStock, const int &p_node) const
+{
+    return getCuts(p_hypStock, p_node);
+}
+
+
+shared_ptr<const ArrayXXd> ContinuationCutsTree::getCutsAllNodes(const ArrayXXd &p_hypStock) const
+{
+    return getCuts(p_hypStock, -1);
+}
 }
@@ -3,9 +3,12 @@
 #define CONTINUATIONCUTSTREE_H
 #include <iostream>
 #include <vector>
+#include <map>
+#include <memory>
 #include <Eigen/Dense>
 #include "libstoch/tree/Tree.h"
 #include "libstoch/core/grids/SpaceGrid.h"
+#include "libstoch/core/grids/FullGrid.h"
 
 /** \file ContinuationCutsTree.h
  *  \brief In DP, when transition problem are solved using LP some final cuts are given to the LP solver as ending conditions
@@ -25,10 +28,40 @@ class ContinuationCutsTree
 private :
     std::shared_ptr< SpaceGrid >    m_grid ; ///< grid used to define stock points
     std::vector< Eigen::ArrayXXd > m_cutCoeff ; ///< for each  cut  \f$ \bar a_0 + \sum_i^d a_i x_i  \f$ store the  coefficients coefficient. Size of m_cutCoeff : (d+1). For each component of the cut, store its value for a given node and a given stock point  (size (nb node , nb stock points)). Notice that  \f$ \bar a_0 =  a_0 - \sum_i^d a_i \bar x_i \f$
+    mutable std::map< std::vector<int>, std::shared_ptr< const Eigen::ArrayXXd > > m_cacheCuts ; ///< cuts already extracted : key is (node number (-1 for all nodes), integer coordinates of the lower and upper corner of the sub grid)
+    mutable size_t m_cacheSize ; ///< number of values stored in m_cacheCuts
+    size_t m_cacheSizeMax ; ///< maximal number of values stored in m_cacheCuts
+
+    /// \brief Get the integer coordinates of the grid points inside an hypercube (full grids only)
+    /// \param p_grid      full grid
+    /// \param p_hypStock  hypercube
+    /// \param p_iMin      first integer coordinate inside the hypercube in each dimension
+    /// \param p_iMax      last integer coordinate inside the hypercube in each dimension
+    /// \return false if no point of the grid lies in the hypercube
+    bool subGridInHypercube(const FullGrid &p_grid, const Eigen::ArrayXXd &p_hypStock, Eigen::ArrayXi &p_iMin, Eigen::ArrayXi &p_iMax) const;
+
+    /// \brief Extract cuts by contiguous slabs in the first dimension
+    /// \param p_grid   full grid
+    /// \param p_iMin   first integer coordinate  in each dimension of the sub grid
+    /// \param p_iMax   last integer coordinate  in each dimension of the sub grid
+    /// \param p_node   node number (-1 : all nodes are extracted)
+    /// \return cuts  (nb cut coeff (times nb nodes if p_node < 0), nb stock points in sub grid)
+    Eigen::ArrayXXd extractCutsInSubGrid(const FullGrid &p_grid, const Eigen::ArrayXi &p_iMin, const Eigen::ArrayXi &p_iMax, const int &p_node) const;
+
+    /// \brief Extract cuts with a grid iterator testing all points (used for non full grids)
+    /// \param p_hypStock  hypercube
+    /// \param p_node   node number (-1 : all nodes are extracted)
+    Eigen::ArrayXXd extractCutsByIterator(const Eigen::ArrayXXd &p_hypStock, const int &p_node) const;
+
+    /// \brief Get back cuts in an hypercube for a node (or all nodes) using cache
+    /// \param p_hypStock  hypercube
+    /// \param p_node   node number (-1 : all nodes are extracted)
+    /// \return cuts shared with the cache, or extracted for the call if not cached
+    std::shared_ptr<const Eigen::ArrayXXd> getCuts(const Eigen::ArrayXXd &p_hypStock, const int &p_node) const;
 
 public :
     /// \brief Default constructor
-    ContinuationCutsTree() {}
+    ContinuationCutsTree(): m_cacheSize(0), m_cacheSizeMax(1 << 25) {}
 
     /// \brief Constructor
     /// \param p_grid   grid for stocks
@@ -50,6 +83,21 @@ public :
     {
         m_grid = p_grid;
         m_cutCoeff = p_values ;
+        clearCache();
+    }
+
+    /// \brief Clear the cuts extracted and cached by getCutsAllNodes and getCutsANode
+    ///        (not to be called while other threads extract cuts)
+    void clearCache()
+    {
+        m_cacheCuts.clear();
+        m_cacheSize = 0;
+    }
+
+    /// \brief Set the maximal number of values kept in the cache (default 2^25) : when reached, new cuts extracted are not cached
+    void setCacheSize(const size_t &p_cacheSizeMax)
+    {
+        m_cacheSizeMax = p_cacheSizeMax;
     }
 
     /// \brief Get a list of all cuts for all nodes \f$ (\bar a_0, a_1, ...a_d) \f$
@@ -61,14 +109,19 @@ public :
     /// Return an array of cuts for all points in the hypercube  and nodes used
     /// shape  :  first dimension :   (nb nodes by number of cuts)
     ///           second dimension : nb of points  in the  hypercube
-    Eigen::ArrayXXd  getCutsAllNodes(const Eigen::ArrayXXd &p_hypStock) const;
+    /// On full grids, the cuts are extracted by slabs from the integer sub grid defining the hypercube
+    /// and are cached  by sub grid so that each extraction is achieved only once for the object
+    /// (until the cache is cleared by loadForSimulation, clearCache, or is full).
+    /// The cuts returned are shared with the cache and stay valid when the cache is cleared.
+    std::shared_ptr<const Eigen::ArrayXXd> getCutsAllNodes(const Eigen::ArrayXXd &p_hypStock) const;
 
 
     /// \brief get list of cuts associated to an hypercube
     /// \param  p_hypStock      list of points  defining an hypercube
     /// \param  p_node           node number
     /// \return  list of cuts (nb cut coeff, nb stock points)
-    Eigen::ArrayXXd getCutsANode(const Eigen::ArrayXXd &p_hypStock, const int &p_node) const;
+    /// As for getCutsAllNodes, cuts are cached by (node, sub grid)
+    std::shared_ptr<const Eigen::ArrayXXd> getCutsANode(const Eigen::ArrayXXd &p_hypStock, const int &p_node) const;
 
 
     /// \brief get Regressed values stored
@@ -36,8 +36,9 @@ public :
     ContinuationValueTree(const  std::shared_ptr< SpaceGrid >   &p_grid,
                           const std::shared_ptr< Tree >   &p_condExp,
                           const Eigen::ArrayXXd &p_valuesNextDate) :
-        m_grid(p_grid),  m_values(p_condExp->expCondMultiple(p_valuesNextDate.transpose()).transpose())
+        m_grid(p_grid),  m_values(p_condExp->getNbNodes(), p_valuesNextDate.cols())
     {
+        p_condExp->expCondMultipleNodesInRows(p_valuesNextDate, m_values);
     }
 
     /// \brief Load another Continuation value object
@@ -1,6 +1,14 @@
 
 #ifndef GRIDTREEVALUE_H
 #define GRIDTREEVALUE_H
+#include <memory>
+#include <vector>
+#include <Eigen/Dense>
+#include "libstoch/core/grids/SpaceGrid.h"
+#include "libstoch/core/grids/GridIterator.h"
+#include "libstoch/core/grids/Interpolator.h"
+#include "libstoch/core/grids/InterpolatorSpectral.h"
+#include "libstoch/core/grids/InterpolatorMultiSpectral.h"
 
 
 /** \file GridTreeValue.h
@@ -17,7 +25,7 @@ class GridTreeValue
 
 private :
     std::shared_ptr< SpaceGrid >    m_grid ; ///< grid used to define stock points
-    std::vector< std::shared_ptr<InterpolatorSpectral> > m_interpFuncBasis; /// vector of spectral operator associated to the grid used for each point
+    std::shared_ptr<InterpolatorMultiSpectral> m_interpFuncBasis; ///< spectral operator associated to the grid storing the functions of all the nodes
 
 public :
 
@@ -28,10 +36,8 @@ public :
     /// \param p_grid     grid for stocks
     /// \param p_values   functions to store  (number of node in the tree  by nb of stocks)
     GridTreeValue(const  std::shared_ptr< SpaceGrid >   &p_grid,
-                  const Eigen::ArrayXXd &p_values) : m_grid(p_grid), m_interpFuncBasis(p_values.rows())
+                  const Eigen::ArrayXXd &p_values) : m_grid(p_grid), m_interpFuncBasis(p_grid->createInterpolatorMultiSpectral(p_values))
     {
-        for (int i = 0; i < p_values.rows(); ++i)
-            m_interpFuncBasis[i] = p_grid->createInterpolatorSpectral(p_values.row(i).transpose());
     }
 
     /// \brief Constructor used to store the grid and the regressor
@@ -41,9 +47,28 @@ public :
 
     /// \brief Constructor used for deserialization
     /// \param  p_grid                grid for stocks
-    /// \param  p_interpFuncBasis     spectral interpolator associated to each regression function basis
+    /// \param  p_interpFuncBasis     spectral interpolator of the functions of all the nodes
     GridTreeValue(const  std::shared_ptr< SpaceGrid >   &p_grid,
-                  const std::vector< std::shared_ptr<InterpolatorSpectral> > &p_interpFuncBasis):  m_grid(p_grid),  m_interpFuncBasis(p_interpFuncBasis) {}
+                  const std::shared_ptr<InterpolatorMultiSpectral> &p_interpFuncBasis):  m_grid(p_grid),  m_interpFuncBasis(p_interpFuncBasis) {}
+
+    /// \brief Constructor used for deserialization of archives with one spectral interpolator per node (version 1) :
+    ///        the functions are evaluated at the grid points to build the interpolator of all the nodes
+    /// \param  p_grid                grid for stocks
+    /// \param  p_interpFuncBasis     spectral interpolator associated to each node
+    GridTreeValue(const  std::shared_ptr< SpaceGrid >   &p_grid,
+                  const std::vector< std::shared_ptr<InterpolatorSpectral> > &p_interpFuncBasis):  m_grid(p_grid)
+    {
+        Eigen::ArrayXXd values(p_interpFuncBasis.size(), p_grid->getNbPoints());
+        std::shared_ptr<GridIterator> iterGrid = p_grid->getGridIterator();
+        while (iterGrid->isValid())
+        {
+            Eigen::ArrayXd pointCoord = iterGrid->getCoordinate();
+            for (size_t inode = 0; inode < p_interpFuncBasis.size(); ++inode)
+                values(inode, iterGrid->getCount()) = p_interpFuncBasis[inode]->apply(pointCoord);
+            iterGrid->next();
+        }
+        m_interpFuncBasis = p_grid->createInterpolatorMultiSpectral(values);
+    }
 
 
 
@@ -52,17 +77,23 @@ public :
     /// \param  p_node          node number
     inline double getValue(const Eigen::ArrayXd &p_ptOfStock, const int   &p_node) const
     {
-        return  m_interpFuncBasis[p_node]->apply(p_ptOfStock);
+        return  m_interpFuncBasis->applyOne(p_ptOfStock, p_node);
+    }
+
+    /// \brief Get value function for one stock and one node in tree with an interpolator created by the grid at the stock point
+    ///        (linear and sparse grids) : the caller keeps the interpolator to get the value of several nodes at the same stock
+    /// \param  p_interpolator  interpolator created by the grid (getGrid()->createInterpolator) at the stock point
+    /// \param  p_node          node number
+    inline double getValue(const Interpolator &p_interpolator, const int   &p_node) const
+    {
+        return  m_interpFuncBasis->applyOne(p_interpolator, p_node);
     }
 
-    /// \brief Get value function for one stock and all nodes
+    /// \brief Get value function for one stock and all nodes : the stock point is located once for all the nodes
     /// \param  p_ptOfStock     stock points
     inline Eigen::ArrayXd  getValues(const Eigen::ArrayXd &p_ptOfStock) const
     {
-        Eigen::ArrayXd ret(m_interpFuncBasis.size());
-        for (size_t inode = 0; inode < m_interpFuncBasis.size(); ++inode)
-            ret(inode) = m_interpFuncBasis[inode]->apply(p_ptOfStock);
-        return ret;
+        return m_interpFuncBasis->apply(p_ptOfStock);
     }
 
     /// \brief Get the grid
@@ -71,8 +102,8 @@ public :
         return m_grid ;
     }
 
-    /// \brief Get back the interpolators
-    const std::vector< std::shared_ptr<InterpolatorSpectral> >   &getInterpolators() const
+    /// \brief Get back the interpolator
+    const std::shared_ptr<InterpolatorMultiSpectral>   &getInterpolator() const
     {
         return m_interpFuncBasis;
     }
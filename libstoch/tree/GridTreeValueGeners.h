@@ -13,6 +13,10 @@
 #include "libstoch/core/grids/InterpolatorSpectralGeners.h"
 #include "libstoch/core/grids/LinearInterpolatorSpectralGeners.h"
 #include "libstoch/core/grids/LegendreInterpolatorSpectralGeners.h"
+#include "libstoch/core/grids/InterpolatorMultiSpectralGeners.h"
+#include "libstoch/core/grids/LinearInterpolatorMultiSpectralGeners.h"
+#include "libstoch/core/grids/LegendreInterpolatorMultiSpectralGeners.h"
+#include "libstoch/core/grids/SparseInterpolatorMultiSpectralGeners.h"
 
 
 /** \file GridTreeValueGeners.h
@@ -22,9 +26,10 @@
 
 /// specialize the ClassIdSpecialization template
 /// so that a ClassId object can be associated with the class we want to
-/// serialize.  The second argument is the version number.
+/// serialize.  The second argument is the version number : version 1 stored one spectral interpolator per node
+/// and is still read.
 ///@{
-gs_specialize_class_id(libstoch::GridTreeValue, 1)
+gs_specialize_class_id(libstoch::GridTreeValue, 2)
 /// an external class
 gs_declare_type_external(libstoch::GridTreeValue)
 ///@}
@@ -54,7 +59,10 @@ struct GenericWriter < Stream, State, libstoch::GridTreeValue,
             if (bSharedPtr)
             {
                 write_item(p_os, ptrGrid);
-                write_item(p_os, p_state.getInterpolators());
+                bool bInterp = (p_state.getInterpolator() ? true : false);
+                write_pod(p_os, bInterp);
+                if (bInterp)
+                    write_item(p_os, *p_state.getInterpolator());
             }
         }
         // Return "true" on success, "false" on failure
@@ -68,29 +76,45 @@ template <class Stream, class State  >
 struct GenericReader < Stream, State, libstoch::GridTreeValue, Int2Type<IOTraits<int>::ISEXTERNAL> >
 {
     inline static bool readIntoPtr(libstoch::GridTreeValue  *&ptr, Stream &p_is,
-                                   State *, const bool p_processClassId)
+                                   State *p_st, const bool p_processClassId)
     {
-
-        if (p_processClassId)
-        {
-            static const ClassId current(ClassId::makeId<libstoch::GridTreeValue>());
-            ClassId id(p_is, 1);
-            current.ensureSameName(id);
-        }
+        static const ClassId current(ClassId::makeId<libstoch::GridTreeValue>());
+        const ClassId &stored = p_processClassId ? ClassId(p_is, 1) : p_st->back();
+        current.ensureSameName(stored);
+        stored.ensureVersionInRange(1, current.version());
 
         // Deserialize object data.
         bool bSharedPtr ;
         read_pod(p_is, &bSharedPtr);
         std::shared_ptr<libstoch::SpaceGrid > pgridShared;
-        CPP11_auto_ptr<std::vector< std::shared_ptr<libstoch::InterpolatorSpectral> > > pinterp;
+        std::shared_ptr<libstoch::InterpolatorMultiSpectral> pinterp;
         if (bSharedPtr)
         {
             CPP11_auto_ptr<libstoch::SpaceGrid> pgrid = read_item<libstoch::SpaceGrid>(p_is);
             pgridShared = std::move(pgrid);
-            pinterp = read_item< std::vector< std::shared_ptr<libstoch::InterpolatorSpectral> > >(p_is);
-            /// now affect grids to interpolator
-            for (size_t i = 0 ; i < pinterp->size(); ++i)
-                (*pinterp)[i]->setGrid(& *pgridShared);
+            if (stored.version() == 1)
+            {
+                // one interpolator per node converted to the interpolator of all the nodes
+                CPP11_auto_ptr<std::vector< std::shared_ptr<libstoch::InterpolatorSpectral> > > pinterpNode = read_item< std::vector< std::shared_ptr<libstoch::InterpolatorSpectral> > >(p_is);
+                if (p_is.fail())
+                    return false;
+                for (size_t i = 0 ; i < pinterpNode->size(); ++i)
+                    (*pinterpNode)[i]->setGrid(& *pgridShared);
+                if (pinterpNode->size() > 0)
+                    pinterp = libstoch::GridTreeValue(pgridShared, *pinterpNode).getInterpolator();
+            }
+            else
+            {
+                bool bInterp ;
+                read_pod(p_is, &bInterp);
+                if (bInterp)
+                {
+                    CPP11_auto_ptr<libstoch::InterpolatorMultiSpectral> pinterpRead = read_item<libstoch::InterpolatorMultiSpectral>(p_is);
+                    pinterp = std::move(pinterpRead);
+                    /// now affect grid to interpolator
+                    pinterp->setGrid(& *pgridShared);
+                }
+            }
         }
 
         if (p_is.fail())
@@ -100,14 +124,14 @@ struct GenericReader < Stream, State, libstoch::GridTreeValue, Int2Type<IOTraits
         if (ptr)
         {
             if (bSharedPtr)
-                *ptr = libstoch::GridTreeValue(pgridShared,  *pinterp);
+                *ptr = libstoch::GridTreeValue(pgridShared,  pinterp);
             else
                 *ptr = libstoch::GridTreeValue();
         }
         else
         {
             if (bSharedPtr)
-                ptr = new  libstoch::GridTreeValue(pgridShared,  *pinterp);
+                ptr = new  libstoch::GridTreeValue(pgridShared,  pinterp);
             else
                 ptr = new  libstoch::GridTreeValue();
         }
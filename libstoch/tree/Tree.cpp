@@ -54,14 +54,35 @@ ArrayXd  Tree::expCond(const ArrayXd &p_values) const
 
 ArrayXXd  Tree::expCondMultiple(const ArrayXXd &p_values) const
 {
-    ArrayXXd ret =  ArrayXXd::Zero(p_values.rows(), m_connected.size());
+    ArrayXXd ret(p_values.rows(), m_connected.size());
+    expCondMultiple(p_values, ret);
+    return ret;
+}
+
+void Tree::expCondMultiple(const Ref< const ArrayXXd, 0, OuterStride<> > &p_values, Ref< ArrayXXd, 0, OuterStride<> > p_ret) const
+{
+    p_ret.setZero();
     for (size_t i = 0 ; i < m_connected.size(); ++i)
     {
         for (size_t j = 0; j < m_connected[i].size(); ++j)
         {
-            ret.col(i) += m_proba[m_connected[i][j][1]] * p_values.col(m_connected[i][j][0]);
+            p_ret.col(i) += m_proba[m_connected[i][j][1]] * p_values.col(m_connected[i][j][0]);
+        }
+    }
+}
+
+void Tree::expCondMultipleNodesInRows(const Ref< const ArrayXXd, 0, OuterStride<> > &p_values, Ref< ArrayXXd, 0, OuterStride<> > p_ret) const
+{
+    // a column (function) at a time : contiguous access in both arrays
+    for (int ifunc = 0; ifunc < p_values.cols(); ++ifunc)
+    {
+        for (size_t i = 0 ; i < m_connected.size(); ++i)
+        {
+            double expValue = 0.;
+            for (size_t j = 0; j < m_connected[i].size(); ++j)
+                expValue += m_proba[m_connected[i][j][1]] * p_values(m_connected[i][j][0], ifunc);
+            p_ret(i, ifunc) = expValue;
         }
     }
-    return ret;
 }
 }
@@ -66,6 +66,20 @@ public :
     /// \param p_values at the tree node at the next date (size :  number of function to regress  \times number of nodes)
     Eigen::ArrayXXd  expCondMultiple(const Eigen::ArrayXXd &p_values) const ;
 
+    /// \brief Calculated conditional expectation in a given array
+    /// \param p_values at the tree node at the next date (size :  number of function to regress  \times number of nodes at next date)
+    /// \param p_ret    conditional expectation at the nodes of the current date (size :  number of function to regress  \times number of nodes)
+    ///                 Both arrays can be blocks of larger arrays.
+    void expCondMultiple(const Eigen::Ref< const Eigen::ArrayXXd, 0, Eigen::OuterStride<> > &p_values,
+                         Eigen::Ref< Eigen::ArrayXXd, 0, Eigen::OuterStride<> > p_ret) const ;
+
+    /// \brief Calculated conditional expectation of functions stored with one node per row (layout of the values on grids : no transposition needed)
+    /// \param p_values at the tree node at the next date (size :  number of nodes at next date \times number of function to regress)
+    /// \param p_ret    conditional expectation at the nodes of the current date (size :  number of nodes \times number of function to regress)
+    ///                 Both arrays can be blocks of larger arrays.
+    void expCondMultipleNodesInRows(const Eigen::Ref< const Eigen::ArrayXXd, 0, Eigen::OuterStride<> > &p_values,
+                                    Eigen::Ref< Eigen::ArrayXXd, 0, Eigen::OuterStride<> > p_ret) const ;
+
     /// \brief Number of nodes at current date
     inline int getNbNodes() const
     {
@@ -0,0 +1,172 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef BENCHREPORT_H
+#define BENCHREPORT_H
+#include <string>
+#include <vector>
+#include <map>
+#include <ostream>
+#include <algorithm>
+#include <numeric>
+#include <cstdio>
+#include <boost/timer/timer.hpp>
+
+/** \file BenchReport.h
+ * \brief Store the results of the benchmark kernels and dump them in JSON or CSV format
+ * \author Xavier Warin
+ */
+
+/// \class BenchReport BenchReport.h
+/// Each result is a kernel name, its parameters and the wall times (in seconds) of each repetition
+class BenchReport
+{
+public :
+
+    /// \brief one benchmark result
+    struct Result
+    {
+        std::string m_kernel ; ///< kernel name
+        std::map< std::string, double > m_param ; ///< kernel parameters (size, dimension, threads ...)
+        std::vector<double> m_time ; ///< wall time of each repetition (s)
+
+        double getMin() const
+        {
+            return *std::min_element(m_time.begin(), m_time.end());
+        }
+        double getMean() const
+        {
+            return std::accumulate(m_time.begin(), m_time.end(), 0.) / m_time.size();
+        }
+    };
+
+private :
+
+    std::vector< Result > m_results ; ///< all results
+    std::map< std::string, std::string > m_context ; ///< context of the run (version, commit ...)
+
+    /// \brief sorted union of all parameter names
+    std::vector< std::string > getParamNames() const
+    {
+        std::vector< std::string > names;
+        for (const auto &res : m_results)
+            for (const auto &param : res.m_param)
+                if (std::find(names.begin(), names.end(), param.first) == names.end())
+                    names.push_back(param.first);
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    /// \brief string as a JSON string (quoted, with special characters escaped)
+    static std::string quoteJSON(const std::string &p_str)
+    {
+        std::string quoted = "\"";
+        for (char c : p_str)
+        {
+            switch (c)
+            {
+            case '"' :
+                quoted += "\\\"";
+                break;
+            case '\\' :
+                quoted += "\\\\";
+                break;
+            case '\n' :
+                quoted += "\\n";
+                break;
+            case '\t' :
+                quoted += "\\t";
+                break;
+            case '\r' :
+                quoted += "\\r";
+                break;
+            default :
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    char code[7];
+                    std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(c));
+                    quoted += code;
+                }
+                else
+                    quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+
+public :
+
+    /// \brief add a context information (dumped in JSON only)
+    void setContext(const std::string &p_key, const std::string &p_value)
+    {
+        m_context[p_key] = p_value;
+    }
+
+    /// \brief add a result
+    /// \param p_kernel  kernel name
+    /// \param p_param   parameters
+    /// \param p_time    wall time of each repetition
+    void add(const std::string &p_kernel, const std::map< std::string, double > &p_param, const std::vector<double> &p_time)
+    {
+        Result res;
+        res.m_kernel = p_kernel;
+        res.m_param = p_param;
+        res.m_time = p_time;
+        m_results.push_back(res);
+    }
+
+    inline const std::vector< Result > &getResults() const
+    {
+        return m_results;
+    }
+
+    /// \brief dump as JSON
+    void dumpJSON(std::ostream &p_out) const
+    {
+        p_out << "{\n  \"context\": {";
+        for (auto iter = m_context.begin(); iter != m_context.end(); ++iter)
+            p_out << (iter == m_context.begin() ? "" : ",") << "\n    " << quoteJSON(iter->first) << ": " << quoteJSON(iter->second);
+        p_out << "\n  },\n  \"results\": [";
+        for (size_t ir = 0; ir < m_results.size(); ++ir)
+        {
+            const Result &res = m_results[ir];
+            p_out << (ir == 0 ? "" : ",") << "\n    {\"kernel\": " << quoteJSON(res.m_kernel);
+            for (const auto &param : res.m_param)
+                p_out << ", " << quoteJSON(param.first) << ": " << param.second;
+            p_out << ", \"min\": " << res.getMin() << ", \"mean\": " << res.getMean() << ", \"times\": [";
+            for (size_t it = 0; it < res.m_time.size(); ++it)
+                p_out << (it == 0 ? "" : ", ") << res.m_time[it];
+            p_out << "]}";
+        }
+        p_out << "\n  ]\n}\n";
+    }
+
+    /// \brief dump as CSV : one line per result, missing parameters are left empty
+    void dumpCSV(std::ostream &p_out) const
+    {
+        std::vector< std::string > names = getParamNames();
+        p_out << "kernel";
+        for (const auto &name : names)
+            p_out << "," << name;
+        p_out << ",repeat,min,mean\n";
+        for (const auto &res : m_results)
+        {
+            p_out << res.m_kernel;
+            for (const auto &name : names)
+            {
+                p_out << ",";
+                auto iter = res.m_param.find(name);
+                if (iter != res.m_param.end())
+                    p_out << iter->second;
+            }
+            p_out << "," << res.m_time.size() << "," << res.getMin() << "," << res.getMean() << "\n";
+        }
+    }
+};
+
+/// \brief wall time in seconds from a boost timer
+inline double wallTime(const boost::timer::cpu_timer &p_timer)
+{
+    return p_timer.elapsed().wall * 1e-9;
+}
+#endif /* BENCHREPORT_H */
@@ -0,0 +1,590 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <boost/timer/timer.hpp>
+#include <boost/random.hpp>
+#include <boost/lexical_cast.hpp>
+#include <Eigen/Dense>
+#include "libstoch/core/grids/RegularSpaceGrid.h"
+#include "libstoch/core/grids/RegularLegendreGrid.h"
+#include "libstoch/core/grids/LinearInterpolator.h"
+#include "libstoch/core/grids/LegendreInterpolatorSpectral.h"
+#include "libstoch/core/grids/SparseSpaceGridBound.h"
+#include "libstoch/core/grids/OneDimRegularSpaceGrid.h"
+#include "libstoch/core/grids/OneDimData.h"
+#include "libstoch/core/utils/KDTree.h"
+#include "libstoch/core/utils/NodeParticleSplitting.h"
+#include "libstoch/cdf/fastCDF.h"
+#include "libstoch/tree/Tree.h"
+#include "libstoch/regression/LocalLinearRegression.h"
+#include "libstoch/dp/FinalStepDP.h"
+#include "libstoch/dp/TransitionStepRegressionDP.h"
+#include "test/c++/tools/simulators/MeanRevertingSimulator.h"
+#include "test/c++/tools/dp/OptimizeGasStorage.h"
+#ifdef BENCH_SDDP
+#include "libstoch/sddp/LocalLinearRegressionForSDDPGeners.h"
+#include "libstoch/sddp/SDDPFinalCut.h"
+#include "libstoch/sddp/backwardSDDP.h"
+#include "libstoch/sddp/backwardForwardSDDP.h"
+#include "test/c++/tools/simulators/SimulatorGaussianSDDP.h"
+#include "test/c++/tools/sddp/OptimizeReservoirWithInflowsSDDP.h"
+#endif
+#include "test/c++/bench/BenchReport.h"
+
+/** \file libstochBench.cpp
+ * \brief Micro benchmarks (interpolators, hierarchization, tree, KDTree, CDF, particle splitting)
+ *        and macro benchmarks (one DP transition step, one SDDP backward sweep, SDDP convergence with single or multi cuts) of the library.
+ *        Usage :
+ *        libstoch_bench [--kernel name|all] [--size N] [--dim D] [--level L] [--sample S]
+ *                       [--threads t1,t2,..] [--repeat R] [--format json|csv] [--output file]
+ *        Each kernel is run for each thread number, results are dumped on the standard output or in a file.
+ * \author Xavier Warin
+ */
+
+using namespace std;
+using namespace Eigen;
+using namespace libstoch;
+
+/// \brief  parameters of the benchmark
+struct BenchParam
+{
+    int m_size ; ///< size of the problem (number of points, simulations...)
+    int m_dim ; ///< dimension of the problem
+    int m_level ; ///< sparse grid level or number of steps per dimension for full grids
+    int m_sample ; ///< number of samples (tree nodes, SDDP samples)
+    int m_repeat ; ///< number of repetitions of each kernel
+    vector<int> m_threads ; ///< thread numbers tested
+};
+
+/// \brief parameters of a result of the benchmark
+/// \param p_param    parameters of the benchmark
+/// \param p_nbThread number of threads used
+map<string, double> resultParam(const BenchParam &p_param, const int &p_nbThread)
+{
+    map<string, double> param;
+    param["size"] = p_param.m_size;
+    param["dim"] = p_param.m_dim;
+    param["level"] = p_param.m_level;
+    param["sample"] = p_param.m_sample;
+    param["threads"] = p_nbThread;
+    return param;
+}
+
+/// \brief Run a kernel  p_repeat times, the first untimed run is used as a warm up
+/// \param p_report   report where the results are stored
+/// \param p_kernel   kernel name
+/// \param p_param    parameters of the benchmark
+/// \param p_nbThread number of threads used
+/// \param p_prepare  function called before each run (untimed)
+/// \param p_run      function to time
+void timeKernel(BenchReport &p_report, const string &p_kernel, const BenchParam &p_param, const int &p_nbThread,
+                const function<void()> &p_prepare, const function<void()> &p_run)
+{
+    vector<double> times(p_param.m_repeat);
+    p_prepare();
+    p_run();
+    for (int ir = 0; ir < p_param.m_repeat; ++ir)
+    {
+        p_prepare();
+        boost::timer::cpu_timer timer;
+        p_run();
+        timer.stop();
+        times[ir] = wallTime(timer);
+    }
+    p_report.add(p_kernel, resultParam(p_param, p_nbThread), times);
+}
+
+/// \brief uniform particles in \f$[0,1]^d \f$
+ArrayXXd uniformParticles(const int &p_dim, const int &p_nbSimul)
+{
+    boost::mt19937 generator;
+    boost::random::uniform_real_distribution<double> uniform(0., 1.);
+    ArrayXXd particles(p_dim, p_nbSimul);
+    for (int is = 0; is < p_nbSimul; ++is)
+        for (int id = 0; id < p_dim; ++id)
+            particles(id, is) = uniform(generator);
+    return particles;
+}
+
+/// \brief regular grid on \f$[0,1]^d \f$ with p_level steps per dimension
+void regularGridCharac(const int &p_dim, const int &p_level, ArrayXd &p_lowValues, ArrayXd &p_step, ArrayXi &p_nbStep)
+{
+    p_lowValues = ArrayXd::Zero(p_dim);
+    p_step = ArrayXd::Constant(p_dim, 1. / p_level);
+    p_nbStep = ArrayXi::Constant(p_dim, p_level);
+}
+
+/// \brief Interpolation of p_size functions at a point with LinearInterpolator::applyVec
+void benchLinearInterpolator(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread)
+{
+    ArrayXd lowValues, step;
+    ArrayXi nbStep;
+    regularGridCharac(p_param.m_dim, p_param.m_level, lowValues, step, nbStep);
+    RegularSpaceGrid grid(lowValues, step, nbStep);
+    ArrayXXd values = ArrayXXd::Random(p_param.m_size, grid.getNbPoints());
+    ArrayXXd points = uniformParticles(p_param.m_dim, 1000);
+    double sum = 0;
+    timeKernel(p_report, "linearInterpolatorApplyVec", p_param, p_nbThread, [] {}, [&]
+    {
+        for (int ip = 0; ip < points.cols(); ++ip)
+        {
+            LinearInterpolator interpolator(&grid, points.col(ip));
+            sum += interpolator.applyVec(values).sum();
+        }
+    });
+}
+
+/// \brief Construction and evaluation at p_size points of a LegendreInterpolatorSpectral
+void benchLegendreSpectral(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread)
+{
+    ArrayXd lowValues, step;
+    ArrayXi nbStep;
+    regularGridCharac(p_param.m_dim, p_param.m_level, lowValues, step, nbStep);
+    ArrayXi poly = ArrayXi::Constant(p_param.m_dim, 2);
+    RegularLegendreGrid grid(lowValues, step, nbStep, poly);
+    ArrayXd values = ArrayXd::Random(grid.getNbPoints());
+    shared_ptr<LegendreInterpolatorSpectral> interpolator;
+    timeKernel(p_report, "legendreSpectralConstruct", p_param, p_nbThread, [] {}, [&]
+    {
+        interpolator = make_shared<LegendreInterpolatorSpectral>(&grid, values);
+    });
+    ArrayXXd points = uniformParticles(p_param.m_dim, p_param.m_size);
+    double sum = 0;
+    timeKernel(p_report, "legendreSpectralApply", p_param, p_nbThread, [] {}, [&]
+    {
+        for (int ip = 0; ip < points.cols(); ++ip)
+            sum += interpolator->apply(points.col(ip));
+    });
+}
+
+/// \brief Hierarchization of one function (toHierarchize) and of p_size functions (toHierarchizeVec) on a sparse grid
+void benchSparseHierarchize(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread)
+{
+    ArrayXd lowValues = ArrayXd::Zero(p_param.m_dim);
+    ArrayXd sizeDomain = ArrayXd::Constant(p_param.m_dim, 1.);
+    ArrayXd weight = ArrayXd::Constant(p_param.m_dim, 1.);
+    SparseSpaceGridBound grid(lowValues, sizeDomain, p_param.m_level, weight, 1);
+    ArrayXd nodal = ArrayXd::Random(grid.getNbPoints());
+    ArrayXd hierar;
+    timeKernel(p_report, "sparseToHierarchize", p_param, p_nbThread, [&] { hierar = nodal; }, [&]
+    {
+        grid.toHierarchize(hierar);
+    });
+    ArrayXXd nodalVec = ArrayXXd::Random(p_param.m_size, grid.getNbPoints());
+    ArrayXXd hierarVec;
+    timeKernel(p_report, "sparseToHierarchizeVec", p_param, p_nbThread, [&] { hierarVec = nodalVec; }, [&]
+    {
+        grid.toHierarchizeVec(hierarVec);
+    });
+}
+
+/// \brief Conditional expectation of p_size functions on a tree with p_sample nodes at each date
+void benchTreeExpCond(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread)
+{
+    int nbNodes = p_param.m_sample;
+    // each node is connected to nbConnect consecutive nodes at next date
+    int nbConnect = min(p_param.m_dim + 1, nbNodes);
+    vector<double> proba(nbNodes * nbConnect, 1. / nbConnect);
+    vector< vector< array<int, 2> > > connected(nbNodes);
+    for (int in = 0; in < nbNodes; ++in)
+        for (int ic = 0; ic < nbConnect; ++ic)
+            connected[in].push_back({{(in + ic) % nbNodes, in * nbConnect + ic}});
+    Tree tree(proba, connected);
+    ArrayXXd values = ArrayXXd::Random(p_param.m_size, nbNodes);
+    double sum = 0;
+    timeKernel(p_report, "treeExpCondMultiple", p_param, p_nbThread, [] {}, [&]
+    {
+        sum += tree.expCondMultiple(values).sum();
+    });
+}
+
+/// \brief Nearest point search of p_size points in a KDTree of p_size points
+void benchKDTree(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread)
+{
+    ArrayXXd points = uniformParticles(p_param.m_dim, p_param.m_size);
+    KDTree tree(points);
+    ArrayXXd toSearch = uniformParticles(p_param.m_dim, p_param.m_size);
+    size_t sum = 0;
+    timeKernel(p_report, "kdTreeNearestIndex", p_param, p_nbThread, [] {}, [&]
+    {
+        for (int ip = 0; ip < toSearch.cols(); ++ip)
+            sum += tree.nearestIndex(toSearch.col(ip));
+    });
+}
+
+/// \brief Empirical CDF of p_size particles on a rectilinear grid with p_level points per dimension
+void benchFastCDF(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread)
+{
+    ArrayXXd particles = uniformParticles(p_param.m_dim, p_param.m_size);
+    vector< shared_ptr<ArrayXd> > z(p_param.m_dim);
+    for (int id = 0; id < p_param.m_dim; ++id)
+        z[id] = make_shared<ArrayXd>(ArrayXd::LinSpaced(p_param.m_level, 0., 1.));
+    ArrayXd y = ArrayXd::Constant(p_param.m_size, 1.);
+    double sum = 0;
+    timeKernel(p_report, "fastCDF", p_param, p_nbThread, [] {}, [&]
+    {
+        sum += fastCDF(particles, z, y).sum();
+    });
+}
+
+/// \brief Partition of p_size particles in p_level meshes per dimension
+void benchNodeParticleSplitting(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread)
+{
+    unique_ptr<ArrayXXd> particles(new ArrayXXd(uniformParticles(p_param.m_dim, p_param.m_size)));
+    ArrayXi nbMesh = ArrayXi::Constant(p_param.m_dim, p_param.m_level);
+    ArrayXi nCell(p_param.m_size);
+    Array< array<double, 2 >, Dynamic, Dynamic > meshCoord(p_param.m_dim, nbMesh.prod());
+    timeKernel(p_report, "nodeParticleSplitting", p_param, p_nbThread, [] {}, [&]
+    {
+        NodeParticleSplitting splitter(particles, nbMesh);
+        splitter.simToCell(nCell, meshCoord);
+    });
+}
+
+/// \brief One step of the resolution of a gas storage by regression with p_size simulations
+void benchTransitionStepRegressionDP(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread
+#ifdef USE_MPI
+                                     , const boost::mpi::communicator &p_world
+#endif
+                                    )
+{
+    typedef MeanRevertingSimulator< OneDimData<OneDimRegularSpaceGrid, double> > Simulator;
+    double maturity = 1.;
+    size_t nstep = 10;
+    shared_ptr<OneDimRegularSpaceGrid> timeGrid = make_shared<OneDimRegularSpaceGrid>(0., maturity / nstep, nstep);
+    shared_ptr<vector< double > > futValues = make_shared<vector<double> >(nstep + 1);
+    for (size_t i = 0; i < nstep + 1; ++i)
+        (*futValues)[i] = 50. + 20 * sin((M_PI * i * 52) / nstep);
+    shared_ptr<OneDimData<OneDimRegularSpaceGrid, double> > futureGrid = make_shared<OneDimData< OneDimRegularSpaceGrid, double> >(timeGrid, futValues);
+    VectorXd sigma = VectorXd::Constant(1, 0.94);
+    VectorXd mr = VectorXd::Constant(1, 0.29);
+    shared_ptr<Simulator> backSimulator = make_shared<Simulator>(futureGrid, sigma, mr, 0., maturity, nstep, p_param.m_size, false);
+    shared_ptr< OptimizeGasStorage< Simulator > > storage = make_shared< OptimizeGasStorage< Simulator > >(60000., 45000., 0.35, 0.35);
+    storage->setSimulator(backSimulator);
+    // storage grid
+    double maxLevelStorage  = 360000;
+    ArrayXd lowValues = ArrayXd::Constant(1, 0.);
+    ArrayXd step = ArrayXd::Constant(1, maxLevelStorage / (10 * p_param.m_level));
+    ArrayXi nbStep = ArrayXi::Constant(1, 10 * p_param.m_level);
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    // regressor
+    shared_ptr<BaseRegression> regressor = make_shared<LocalLinearRegression>(ArrayXi::Constant(1, 6));
+    vector< shared_ptr< ArrayXXd > > valuesNext = FinalStepDP(grid, storage->getNbRegime())([](const int &, const ArrayXd &, const ArrayXd &)
+    {
+        return 0.;
+    }, backSimulator->getParticles().array());
+    ArrayXXd asset = backSimulator->stepBackwardAndGetParticles();
+    regressor->updateSimulations(false, asset);
+    TransitionStepRegressionDP transStep(grid, grid, storage
+#ifdef USE_MPI
+                                         , p_world
+#endif
+                                        );
+    timeKernel(p_report, "transitionStepRegressionDP", p_param, p_nbThread, [] {}, [&]
+    {
+        transStep.oneStep(valuesNext, regressor);
+    });
+}
+
+#ifdef BENCH_SDDP
+/// \brief SDDP optimizer of a set of reservoirs with inflows on 40 dates (as in testReservoirWithInflowsSDDP)
+/// \param p_nbStorage     number of reservoirs
+/// \param p_nbSample      number of samples of uncertainties in backward
+/// \param p_nbSimul       number of forward simulations drawn again identically at each sweep
+///                        (0 : new simulations at each sweep, their number is set by backwardForwardSDDP)
+/// \param p_bMultiCut     true if one cut per sample is kept in backward
+/// \param p_dates         optimization dates
+/// \param p_initialState  initial levels of the reservoirs
+shared_ptr<OptimizerSDDPBase> reservoirSDDP(const int &p_nbStorage, const int &p_nbSample, const int &p_nbSimul, const bool &p_bMultiCut,
+        ArrayXd &p_dates, ArrayXd &p_initialState)
+{
+    double maturity = 40;
+    int nstep = 40;
+    shared_ptr<OneDimRegularSpaceGrid> timeGrid = make_shared<OneDimRegularSpaceGrid>(0., maturity / nstep, nstep);
+    shared_ptr<vector< double > > demandValues = make_shared<vector<double> >(nstep + 1);
+    shared_ptr<vector< double > > inflowValues = make_shared<vector<double> >(nstep + 1);
+    shared_ptr<vector< double > > spotValues = make_shared<vector<double> >(nstep + 1);
+    for (int i = 0; i < nstep + 1; ++i)
+    {
+        (*demandValues)[i] = (2. + 0.4 * cos((M_PI * i * 52) / nstep)) * p_nbStorage;
+        (*inflowValues)[i] = 1. + 0.2 * (cos((M_PI * i * 52) / nstep) + sin((M_PI * i * 52) / nstep));
+        (*spotValues)[i] = 50. + 20 * sin((M_PI * i * 52) / nstep);
+    }
+    shared_ptr<OneDimData<OneDimRegularSpaceGrid, double> > demand = make_shared<OneDimData< OneDimRegularSpaceGrid, double> >(timeGrid, demandValues);
+    shared_ptr<OneDimData<OneDimRegularSpaceGrid, double> > flowAver = make_shared<OneDimData< OneDimRegularSpaceGrid, double> >(timeGrid, inflowValues);
+    shared_ptr<OneDimData<OneDimRegularSpaceGrid, double> > spot = make_shared<OneDimData< OneDimRegularSpaceGrid, double> >(timeGrid, spotValues);
+    double initLevel = maturity / 10.;
+    p_initialState = ArrayXd::Constant(p_nbStorage, initLevel);
+    p_dates = ArrayXd::LinSpaced(nstep + 1, 0., maturity);
+    shared_ptr<SimulatorGaussianSDDP> backSimulator = make_shared<SimulatorGaussianSDDP>(1 + p_nbStorage, p_nbSample);
+    shared_ptr<SimulatorGaussianSDDP> forSimulator = ((p_nbSimul > 0) ? make_shared<SimulatorGaussianSDDP>(1 + p_nbStorage, p_nbSimul) : make_shared<SimulatorGaussianSDDP>(1 + p_nbStorage));
+    return make_shared<OptimizeReservoirWithInflowsSDDP<SimulatorGaussianSDDP> >(initLevel, 2., p_nbStorage, 0.6, flowAver, 0.8 * p_nbStorage,  demand, spot,
+            backSimulator, forSimulator, false, p_bMultiCut);
+}
+
+/// \brief One backward sweep of SDDP on a set of p_dim reservoirs with p_sample samples of uncertainties
+///        and p_size forward simulations. The visited states are generated by an untimed forward sweep.
+void benchSDDPBackward(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread
+#ifdef USE_MPI
+                       , const boost::mpi::communicator &p_world
+#endif
+                      )
+{
+    ArrayXd dates;
+    ArrayXd initialState;
+    shared_ptr<OptimizerSDDPBase> optimizer = reservoirSDDP(p_param.m_dim, p_param.m_sample, p_param.m_size, false, dates, initialState);
+    shared_ptr<SimulatorSDDPBase> backSimulator = optimizer->getSimulatorBackward();
+    shared_ptr<SimulatorSDDPBase> forSimulator = optimizer->getSimulatorForward();
+    SDDPFinalCut finCut(ArrayXXd::Zero(1 + p_param.m_dim, 1));
+    string nameRegressor = "RegressorBench";
+    string nameCut = "CutBench";
+    string nameVisitedStates = "VisitedStateBench";
+#ifdef USE_MPI
+    if (p_world.rank() == 0)
+#endif
+        createRegressorsAndInitialStates<LocalLinearRegressionForSDDP>(optimizer, initialState, dates, ArrayXi(), nameRegressor, nameVisitedStates);
+#ifdef USE_MPI
+    p_world.barrier();
+#endif
+    gs::BinaryFileArchive archiveRegressor(nameRegressor.c_str(), "r");
+    SDDPRegressorStore<LocalLinearRegressionForSDDP> regressors(archiveRegressor, dates.size() - 1);
+    // cuts of all the sweeps are accumulated in the same archive
+    shared_ptr<gs::BinaryFileArchive> archiveCut;
+#ifdef USE_MPI
+    if (p_world.rank() == 0)
+#endif
+        archiveCut = make_shared<gs::BinaryFileArchive>(nameCut.c_str(), "w+");
+    bool bFirstSweep = true;
+    timeKernel(p_report, "sddpBackwardSweep", p_param, p_nbThread, [&]
+    {
+        // visited states from a forward sweep with the current cuts
+        if (!bFirstSweep)
+        {
+            forSimulator->resetTime();
+            forwardSDDP<LocalLinearRegressionForSDDP>(optimizer, forSimulator, dates, initialState, finCut, true, regressors,
+                    archiveCut, nameVisitedStates
+#ifdef USE_MPI
+                    , p_world
+#endif
+                                                     );
+        }
+        bFirstSweep = false;
+        backSimulator->resetTime();
+#ifdef USE_MPI
+        p_world.barrier();
+#endif
+    }, [&]
+    {
+        backwardSDDP<LocalLinearRegressionForSDDP>(optimizer, backSimulator, dates, initialState, finCut, regressors,
+                nameVisitedStates, archiveCut
+#ifdef USE_MPI
+                , p_world
+#endif
+                                                  );
+    });
+}
+
+/// \brief Convergence of SDDP on a set of p_dim reservoirs with p_sample samples of uncertainties keeping one cut per date
+///        (single cut) or one cut per sample (multi cut). Each repetition is a full optimization : the gap between
+///        optimization and simulation with p_size simulations is checked every 5 iterations until it is below 1.5%.
+///        The number of iterations is reported with the time.
+void benchSDDPSingleVsMultiCut(BenchReport &p_report, const BenchParam &p_param, const int &p_nbThread
+#ifdef USE_MPI
+                               , const boost::mpi::communicator &p_world
+#endif
+                              )
+{
+    int iterMax = 200;
+    SDDPFinalCut finCut(ArrayXXd::Zero(1 + p_param.m_dim, 1));
+    for (int iMulti = 0; iMulti < 2; ++iMulti)
+    {
+        vector<double> times(p_param.m_repeat);
+        int nbIter = 0;
+        double value = 0.;
+        for (int ir = 0; ir < p_param.m_repeat; ++ir)
+        {
+            ArrayXd dates;
+            ArrayXd initialState;
+            shared_ptr<OptimizerSDDPBase> optimizer = reservoirSDDP(p_param.m_dim, p_param.m_sample, 0, (iMulti == 1), dates, initialState);
+            int iter = iterMax;
+            double accuracy = 0.015;
+            ostringstream stream;
+            boost::timer::cpu_timer timer;
+            pair<double, double> values = backwardForwardSDDP<LocalLinearRegressionForSDDP>(optimizer, p_param.m_size, initialState, finCut, dates, ArrayXi(),
+                                          "RegressorBench", "CutBench", "VisitedStateBench", iter, accuracy, 5, stream
+#ifdef USE_MPI
+                                          , p_world
+#endif
+                                          , false, false, (iMulti == 1));
+            timer.stop();
+            times[ir] = wallTime(timer);
+            nbIter = iter;
+            value = values.first;
+        }
+        map<string, double> param = resultParam(p_param, p_nbThread);
+        param["iterations"] = nbIter;
+        param["value"] = value;
+        p_report.add((iMulti == 0) ? "sddpSingleCut" : "sddpMultiCut", param, times);
+    }
+}
+#endif
+
+/// \brief split a comma separated list of integers
+vector<int> splitInt(const string &p_list)
+{
+    vector<int> ret;
+    stringstream stream(p_list);
+    string item;
+    while (getline(stream, item, ','))
+        ret.push_back(boost::lexical_cast<int>(item));
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef USE_MPI
+    boost::mpi::environment env(argc, argv);
+    boost::mpi::communicator world;
+#endif
+    BenchParam param;
+    param.m_size = 10000;
+    param.m_dim = 2;
+    param.m_level = 6;
+    param.m_sample = 20;
+    param.m_repeat = 5;
+#ifdef _OPENMP
+    param.m_threads.push_back(omp_get_max_threads());
+#else
+    param.m_threads.push_back(1);
+#endif
+    string kernel = "all";
+    string format = "json";
+    string output;
+    for (int iarg = 1; iarg < argc; ++iarg)
+    {
+        string arg(argv[iarg]);
+        if (iarg + 1 >= argc)
+        {
+            cerr << "Missing value for argument " << arg << endl;
+            return 1;
+        }
+        string value(argv[++iarg]);
+        if (arg == "--kernel")
+            kernel = value;
+        else if (arg == "--size")
+            param.m_size = boost::lexical_cast<int>(value);
+        else if (arg == "--dim")
+            param.m_dim = boost::lexical_cast<int>(value);
+        else if (arg == "--level")
+            param.m_level = boost::lexical_cast<int>(value);
+        else if (arg == "--sample")
+            param.m_sample = boost::lexical_cast<int>(value);
+        else if (arg == "--repeat")
+        {
+            param.m_repeat = boost::lexical_cast<int>(value);
+            if (param.m_repeat < 1)
+            {
+                cerr << "The number of repetitions must be at least 1" << endl;
+                return 1;
+            }
+        }
+        else if (arg == "--threads")
+            param.m_threads = splitInt(value);
+        else if (arg == "--format")
+            format = value;
+        else if (arg == "--output")
+            output = value;
+        else
+        {
+            cerr << "Unknown argument " << arg << endl;
+            return 1;
+        }
+    }
+
+    // all kernels
+    map< string, function<void(BenchReport &, const BenchParam &, const int &)> > kernels;
+    kernels["linearInterpolatorApplyVec"] = benchLinearInterpolator;
+    kernels["legendreSpectral"] = benchLegendreSpectral;
+    kernels["sparseHierarchize"] = benchSparseHierarchize;
+    kernels["treeExpCondMultiple"] = benchTreeExpCond;
+    kernels["kdTreeNearestIndex"] = benchKDTree;
+    kernels["fastCDF"] = benchFastCDF;
+    kernels["nodeParticleSplitting"] = benchNodeParticleSplitting;
+#ifdef USE_MPI
+    kernels["transitionStepRegressionDP"] = [&world](BenchReport & p_report, const BenchParam & p_param, const int &p_nbThread)
+    {
+        benchTransitionStepRegressionDP(p_report, p_param, p_nbThread, world);
+    };
+#ifdef BENCH_SDDP
+    kernels["sddpBackwardSweep"] = [&world](BenchReport & p_report, const BenchParam & p_param, const int &p_nbThread)
+    {
+        benchSDDPBackward(p_report, p_param, p_nbThread, world);
+    };
+    kernels["sddpSingleVsMultiCut"] = [&world](BenchReport & p_report, const BenchParam & p_param, const int &p_nbThread)
+    {
+        benchSDDPSingleVsMultiCut(p_report, p_param, p_nbThread, world);
+    };
+#endif
+#else
+    kernels["transitionStepRegressionDP"] = benchTransitionStepRegressionDP;
+#ifdef BENCH_SDDP
+    kernels["sddpBackwardSweep"] = benchSDDPBackward;
+    kernels["sddpSingleVsMultiCut"] = benchSDDPSingleVsMultiCut;
+#endif
+#endif
+    if ((kernel != "all") && (kernels.find(kernel) == kernels.end()))
+    {
+        cerr << "Unknown kernel " << kernel << ", available kernels :";
+        for (const auto &ker : kernels)
+            cerr << " " << ker.first;
+        cerr << endl;
+        return 1;
+    }
+
+    BenchReport report;
+#ifdef USE_MPI
+    report.setContext("mpiTasks", boost::lexical_cast<string>(world.size()));
+#endif
+    for (int nbThread : param.m_threads)
+    {
+#ifdef _OPENMP
+        omp_set_num_threads(nbThread);
+#endif
+        for (const auto &ker : kernels)
+            if ((kernel == "all") || (kernel == ker.first))
+                ker.second(report, param, nbThread);
+    }
+
+#ifdef USE_MPI
+    if (world.rank() == 0)
+#endif
+    {
+        ofstream file;
+        if (!output.empty())
+            file.open(output.c_str());
+        ostream &out = (output.empty() ? cout : file);
+        if (format == "csv")
+            report.dumpCSV(out);
+        else
+            report.dumpJSON(out);
+    }
+    return 0;
+}
@@ -0,0 +1,135 @@
+// Copyright (C) 2023 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#define BOOST_TEST_DYN_LINK
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <functional>
+#include <memory>
+#include <boost/test/unit_test.hpp>
+#include <boost/mpi.hpp>
+#include <Eigen/Dense>
+#include "libstoch/core/grids/OneDimRegularSpaceGrid.h"
+#include "libstoch/core/grids/OneDimData.h"
+#include "libstoch/core/grids/RegularSpaceGridGeners.h"
+#include "libstoch/regression/LocalLinearRegressionGeners.h"
+#include "test/c++/tools/simulators/MeanRevertingSimulatorMultiStage.h"
+#include "test/c++/tools/dp/DynamicProgrammingByRegressionMultiStage.h"
+#include "test/c++/tools/dp/OptimizeGasStorageMultiStage.h"
+
+using namespace std;
+using namespace Eigen ;
+using namespace libstoch;
+
+double accuracyEqual = 1e-7;
+
+/// For Clang < 3.7 (and above ?) to be compatible GCC 5.1 and above
+namespace boost
+{
+namespace unit_test
+{
+namespace ut_detail
+{
+std::string normalize_test_case_name(const_string name)
+{
+    return (name[0] == '&' ? std::string(name.begin() + 1, name.size() - 1) : std::string(name.begin(), name.size()));
+}
+}
+}
+}
+
+class ZeroFunction
+{
+public:
+    ZeroFunction() {}
+    double operator()(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &) const
+    {
+        return 0. ;
+    }
+};
+
+/// \brief Optimize a gas storage with a deterministic optimization by stages on each transition
+///        with values gathered at each stage and with values kept distributed between stages
+BOOST_AUTO_TEST_CASE(testGasStorageMultiStageDistributedStages)
+{
+    boost::mpi::communicator world;
+    // storage
+    /////////
+    double maxLevelStorage  = 90000;
+    double injectionRateStorage = 60000;
+    double withdrawalRateStorage = 45000;
+    double injectionCostStorage = 0.35;
+    double withdrawalCostStorage = 0.35;
+
+    double maturity = 1.;
+    size_t nstep = 10;
+    // deterministic stages in each transition
+    int nbPeriodInTransition = 4;
+    // define a time grid
+    shared_ptr<OneDimRegularSpaceGrid> timeGrid = make_shared<OneDimRegularSpaceGrid>(0., maturity / nstep, nstep);
+    // future values
+    shared_ptr<vector< double > > futValues = make_shared<vector<double> >(nstep + 1);
+    // periodicity factor
+    int iPeriod = 52;
+    for (size_t i = 0; i < nstep + 1; ++i)
+        (*futValues)[i] = 50. + 20 * sin((M_PI * i * iPeriod) / nstep);
+    // define the future curve
+    shared_ptr<OneDimData<OneDimRegularSpaceGrid, double> > futureGrid = make_shared<OneDimData< OneDimRegularSpaceGrid, double> >(timeGrid, futValues);
+    // one dimensional factors
+    VectorXd sigma = VectorXd::Constant(1, 0.94);
+    VectorXd mr = VectorXd::Constant(1, 0.29);
+    // number of simulations
+    size_t nbsimulOpt = 2000;
+    // no actualization
+    double r = 0. ;
+    // grid
+    //////
+    int nGrid = 40;
+    ArrayXd lowValues = ArrayXd::Constant(1, 0.);
+    ArrayXd step = ArrayXd::Constant(1, maxLevelStorage / nGrid);
+    ArrayXi nbStep = ArrayXi::Constant(1, nGrid);
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    // regressor
+    ///////////
+    shared_ptr< BaseRegression > regressor = make_shared<LocalLinearRegression>(ArrayXi::Constant(1, 4));
+    // final value
+    function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>  vFunction = ZeroFunction();
+    // initial values
+    ArrayXd initialStock = ArrayXd::Constant(1,  maxLevelStorage);
+    int initialRegime = 0; // only one regime
+
+    // values gathered at each stage, then kept distributed between stages
+    array<double, 2> valueOptim;
+    array<long, 2> nbBytesSaved;
+    for (int iCase = 0; iCase < 2; ++iCase)
+    {
+        // same simulations for the two cases
+        shared_ptr< MeanRevertingSimulatorMultiStage< OneDimData<OneDimRegularSpaceGrid, double> > > backSimulator =
+            make_shared<MeanRevertingSimulatorMultiStage< OneDimData<OneDimRegularSpaceGrid, double> > >(futureGrid, sigma, mr, r, maturity, nstep, nbsimulOpt, false, nbPeriodInTransition);
+        shared_ptr< OptimizeGasStorageMultiStage< MeanRevertingSimulatorMultiStage< OneDimData<OneDimRegularSpaceGrid, double> > > > storage =
+            make_shared< OptimizeGasStorageMultiStage< MeanRevertingSimulatorMultiStage< OneDimData<OneDimRegularSpaceGrid, double> > > >(injectionRateStorage, withdrawalRateStorage, injectionCostStorage, withdrawalCostStorage);
+        storage->setSimulator(backSimulator);
+        string fileToDump = "CondExpGasStorageMultiStageMpi" + to_string(iCase) + "_" + to_string(world.size()) + "_" + to_string(world.rank());
+        long nbBytesSavedLoc = 0;
+        valueOptim[iCase] = DynamicProgrammingByRegressionMultiStage(grid, storage, regressor, vFunction, initialStock, initialRegime, fileToDump, world,
+                            (iCase == 1), nbBytesSavedLoc);
+        nbBytesSaved[iCase] = boost::mpi::all_reduce(world, nbBytesSavedLoc, std::plus<long>());
+    }
+    if (world.rank() == 0)
+        cout << " Optim gathered " << valueOptim[0] << " distributed " << valueOptim[1] << " bytes saved " << nbBytesSaved[1] - nbBytesSaved[0] << endl ;
+    BOOST_CHECK_CLOSE(valueOptim[0], valueOptim[1], accuracyEqual);
+    if (world.size() > 1)
+        BOOST_CHECK(nbBytesSaved[1] > nbBytesSaved[0]);
+}
+
+// (empty) Initialization function. Can't use testing tools here.
+bool init_function()
+{
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    boost::mpi::environment env(argc, argv);
+    return ::boost::unit_test::unit_test_main(&init_function, argc, argv);
+}
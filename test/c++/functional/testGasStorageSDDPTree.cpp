@@ -0,0 +1,175 @@
+// Copyright (C) 2019 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#define BOOST_TEST_DYN_LINK
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <iostream>
+#include <sstream>
+#include <memory>
+#include <functional>
+#include <boost/test/unit_test.hpp>
+#include <boost/mpi.hpp>
+#include <Eigen/Dense>
+#include "libstoch/core/grids/OneDimRegularSpaceGrid.h"
+#include "libstoch/core/grids/OneDimData.h"
+#include "libstoch/core/grids/RegularSpaceGridGeners.h"
+#include "libstoch/tree/TreeGeners.h"
+#include "libstoch/sddp/SDDPFinalCutTree.h"
+#include "libstoch/sddp/backwardForwardSDDPTree.h"
+#include "test/c++/tools/simulators/TrinomialTreeOUSimulator.h"
+#include "test/c++/tools/simulators/MeanRevertingSimulatorTree.h"
+#include "test/c++/tools/sddp/OptimizeGasStorageSDDP.h"
+#include "test/c++/tools/dp/DynamicProgrammingByTree.h"
+#include "test/c++/tools/dp/OptimizeGasStorageTree.h"
+
+/** \file testGasStorageSDDPTree.cpp
+ *  Gas storage valued by SDDP with the uncertainty described by a tree.
+ *  The backward sweep treats the LPs by batches sharing the same arrival node :
+ *  the SDDP values are checked against the valuation by dynamic programming on the same tree.
+ * \author Xavier Warin
+ */
+
+using namespace std;
+using namespace Eigen ;
+using namespace libstoch;
+
+double accuracyClose = 1.5;
+
+/// For Clang < 3.7 (and above ?) to be compatible GCC 5.1 and above
+namespace boost
+{
+namespace unit_test
+{
+namespace ut_detail
+{
+string normalize_test_case_name(const_string name)
+{
+    return (name[0] == '&' ? string(name.begin() + 1, name.size() - 1) : string(name.begin(), name.size()));
+}
+}
+}
+}
+
+class ZeroFunction
+{
+public:
+    ZeroFunction() {}
+    double operator()(const int &, const ArrayXd &, const ArrayXd &) const
+    {
+        return 0. ;
+    }
+};
+
+/// \brief valorization of a gas storage with a tree by SDDP and by dynamic programming
+/// \param p_bMultiCut   true if one cut per arrival node is kept in the backward sweep
+void testGasStorageSDDPTree(const bool &p_bMultiCut)
+{
+    boost::mpi::communicator world;
+    // storage
+    /////////
+    double maxLevelStorage  = 90000;
+    double injectionRateStorage = 60000;
+    double withdrawalRateStorage = 45000;
+    double injectionCostStorage = 0.35;
+    double withdrawalCostStorage = 0.35;
+
+    double maturity = 1.;
+    size_t nstep = 20;
+    // define  a time grid
+    shared_ptr<OneDimRegularSpaceGrid> timeGrid = make_shared<OneDimRegularSpaceGrid>(0., maturity / nstep, nstep);
+    // future values
+    shared_ptr<vector< double > > futValues = make_shared<vector<double> >(nstep + 1);
+    // periodicity factor
+    int iPeriod = 10;
+    for (size_t i = 0; i < nstep + 1; ++i)
+        (*futValues)[i] = 50. + 20 * sin((M_PI * i * iPeriod) / nstep);
+    // define the future curve
+    shared_ptr<OneDimData<OneDimRegularSpaceGrid, double> > futureGrid = make_shared<OneDimData< OneDimRegularSpaceGrid, double> >(timeGrid, futValues);
+
+    // Create a tree to be used for the simulators
+    //********************************************
+    // number to sub-discretization steps
+    int nbStepTreePerStep = 2;
+    ArrayXd ddates =  ArrayXd::LinSpaced(nstep * nbStepTreePerStep + 1, 0., maturity);
+    double  sigma =  0.94;
+    double  mr =  0.29;
+    TrinomialTreeOUSimulator tree(mr, sigma, ddates);
+    // sub array for dates
+    ArrayXi indexT(nstep + 1);
+    for (size_t i = 0; i < nstep; ++i)
+        indexT(i) = i * nbStepTreePerStep;
+    indexT(nstep) = ddates.size() - 1;
+    // create archive
+    string nameTree = "TreeGasStorageSDDP" + to_string(world.size());
+    if (world.rank() == 0)
+        tree.dump(nameTree, indexT);
+    world.barrier();
+    shared_ptr<gs::BinaryFileArchive> binArxiv = make_shared<gs::BinaryFileArchive>(nameTree.c_str(), "r");
+
+    // initial stock
+    ArrayXd initialStock = ArrayXd::Constant(1, maxLevelStorage);
+
+    // valuation by dynamic programming on a grid
+    //*******************************************
+    int nGrid = 50;
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(ArrayXd::Constant(1, 0.), ArrayXd::Constant(1, maxLevelStorage / nGrid), ArrayXi::Constant(1, nGrid));
+    shared_ptr< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > > simulatorDP = make_shared<MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > >(binArxiv, futureGrid, sigma, mr);
+    shared_ptr< OptimizeGasStorageTree< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > > > storageDP = make_shared< OptimizeGasStorageTree< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > > >(injectionRateStorage, withdrawalRateStorage, injectionCostStorage, withdrawalCostStorage);
+    storageDP->setSimulator(simulatorDP);
+    function<double(const int &, const ArrayXd &, const ArrayXd &)>  vFunction = ZeroFunction();
+    string fileToDump = "CondTreeGasStorageSDDP" + to_string(world.size());
+    double valueDP =  DynamicProgrammingByTree(grid, storageDP,  vFunction, initialStock, 0, fileToDump, world);
+
+    // valuation by SDDP
+    //******************
+    ArrayXd dates = ArrayXd::LinSpaced(nstep + 1, 0., maturity);
+    // backward simulator
+    shared_ptr< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > > backSimulator = make_shared<MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > >(binArxiv, futureGrid, sigma, mr);
+    // forward simulator
+    int nbSimul = 100;
+    shared_ptr< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > > forSimulator = make_shared<MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > >(binArxiv, futureGrid, sigma, mr, nbSimul);
+    // optimizer
+    int nbStorage = 1;
+    shared_ptr<OptimizerSDDPBase> storageSDDP = make_shared< OptimizeGasStorageSDDP< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> > > >(maxLevelStorage, injectionRateStorage, withdrawalRateStorage, injectionCostStorage, withdrawalCostStorage, nbStorage, backSimulator, forSimulator);
+    // final cut : no value at maturity
+    SDDPFinalCutTree finalCut(ArrayXXd::Zero(nbStorage + 1, 1));
+    string nameCut = "CutGasStorageSDDPTree" + to_string(world.size());
+    string nameVisitedStates = "VisitedStateGasStorageSDDPTree" + to_string(world.size());
+    int nbSimulCheckForSimu = 10000;
+    int iter = 40;
+    double accuracy = 0.005;
+    int nStepConv = 2;
+    ostringstream stringStream;
+    pair<double, double> values = backwardForwardSDDPTree(storageSDDP, nbSimulCheckForSimu, initialStock, finalCut, dates,
+                                  nameCut, nameVisitedStates, iter, accuracy, nStepConv, stringStream, world, false, p_bMultiCut);
+    if (world.rank() == 0)
+    {
+        cout << " Value DP " << valueDP << " SDDP backward " << values.first << " forward " << values.second << " iterations " << iter << endl ;
+        BOOST_CHECK_CLOSE(values.first, valueDP, accuracyClose);
+        // forward value estimated by Monte Carlo
+        BOOST_CHECK_CLOSE(values.second, valueDP, 2 * accuracyClose);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testGasStorageSDDPTreeSingleCut)
+{
+    testGasStorageSDDPTree(false);
+}
+
+BOOST_AUTO_TEST_CASE(testGasStorageSDDPTreeMultiCut)
+{
+    testGasStorageSDDPTree(true);
+}
+
+// (empty) Initialization function. Can't use testing tools here.
+bool init_function()
+{
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    boost::mpi::environment env(argc, argv);
+    return ::boost::unit_test::unit_test_main(&init_function, argc, argv);
+}
@@ -51,7 +51,7 @@ public:
 #endif
 
 template< class Grid>
-void   testGasStorageTreeCut(shared_ptr< Grid > &p_grid, const double &p_maxLevelStorage)
+void   testGasStorageTreeCut(shared_ptr< Grid > &p_grid, const double &p_maxLevelStorage, const bool &p_bReuseLP = false)
 {
     // storage
     /////////
@@ -112,7 +112,7 @@ void   testGasStorageTreeCut(shared_ptr< Grid > &p_grid, const double &p_maxLeve
     // optimizer
     ///////////
     shared_ptr< OptimizeGasStorageTreeCut< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> >  > > storage =
-        make_shared<  OptimizeGasStorageTreeCut< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> >  > > (injectionRateStorage, withdrawalRateStorage, injectionCostStorage, withdrawalCostStorage);
+        make_shared<  OptimizeGasStorageTreeCut< MeanRevertingSimulatorTree< OneDimData<OneDimRegularSpaceGrid, double> >  > > (injectionRateStorage, withdrawalRateStorage, injectionCostStorage, withdrawalCostStorage, p_bReuseLP);
 
     // initial values
     ArrayXd initialStock = ArrayXd::Constant(1, p_maxLevelStorage);
@@ -145,6 +145,8 @@ void   testGasStorageTreeCut(shared_ptr< Grid > &p_grid, const double &p_maxLeve
 
     BOOST_CHECK_CLOSE(valueOptim, valSimu, accuracyClose);
     cout << " Optim " << valueOptim << " valSimu " << valSimu <<  endl ;
+    if (p_bReuseLP)
+        BOOST_CHECK(storage->getLPWorkspace()->getNbWarmSolve() > 0);
 
 }
 
@@ -165,6 +167,22 @@ BOOST_AUTO_TEST_CASE(testSimpleStorageTreeCut)
 
 }
 
+BOOST_AUTO_TEST_CASE(testSimpleStorageTreeCutReuseLP)
+{
+    // storage
+    /////////
+    double maxLevelStorage  = 40000;
+    // grid
+    //////
+    int nGrid = 40;
+    ArrayXd lowValues = ArrayXd::Constant(1, 0.);
+    ArrayXd step = ArrayXd::Constant(1, maxLevelStorage / nGrid);
+    ArrayXi nbStep = ArrayXi::Constant(1, nGrid);
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    // LP kept and warm started between resolutions
+    testGasStorageTreeCut(grid, maxLevelStorage, true);
+}
+
 
 
 #ifdef USE_MPI
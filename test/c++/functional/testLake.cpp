@@ -19,11 +19,14 @@
 #include "libstoch/core/grids/OneDimData.h"
 #include "libstoch/regression/LocalLinearRegression.h"
 #include "libstoch/core/grids/RegularLegendreGridGeners.h"
+#include "libstoch/core/grids/RegularSpaceGrid.h"
 #include "libstoch/regression/LocalLinearRegressionGeners.h"
 #include "test/c++/tools/simulators/AR1Simulator.h"
 #include "test/c++/tools/dp/DynamicProgrammingByRegression.h"
 #include "test/c++/tools/dp/SimulateRegression.h"
 #include "test/c++/tools/dp/SimulateRegressionControl.h"
+#include "test/c++/tools/dp/DynamicProgrammingByRegressionChunked.h"
+#include "test/c++/tools/dp/SimulateRegressionControlChunked.h"
 #include "test/c++/tools/dp/OptimizeLake.h"
 
 using namespace std;
@@ -53,6 +56,7 @@ string normalize_test_case_name(const_string name)
 }
 
 double accuracyClose =  1.5;
+double accuracyEqual = 1e-10;
 
 class ZeroFunction
 {
@@ -67,6 +71,38 @@ public:
 
 
 
+/// \brief simulate the lake and keep the final states and the costs of all the simulations
+/// \param p_simulator      forward simulator
+/// \param p_oneStep        simulate a step (step number in the archive, states and costs of the simulations)
+/// \param p_initialStock   initial stock
+/// \param p_nbFunc         number of functions followed in simulation
+/// \param p_states         final states of the simulations
+/// \param p_costFunction   costs of the simulations
+void simulateLakeStates(const shared_ptr< AR1Simulator> &p_simulator,
+                        const function<void(const int &, vector<StateWithStocks> &, ArrayXXd &)> &p_oneStep,
+                        const ArrayXd &p_initialStock, const int &p_nbFunc, vector<StateWithStocks> &p_states, ArrayXXd &p_costFunction)
+{
+    int nbStep = p_simulator->getNbStep();
+    p_states.assign(p_simulator->getNbSimul(), StateWithStocks(0, p_initialStock, ArrayXd::Zero(p_simulator->getDimension())));
+    p_costFunction = ArrayXXd::Zero(p_nbFunc, p_simulator->getNbSimul());
+    for (int istep = 0; istep < nbStep; ++istep)
+    {
+        p_oneStep(nbStep - 1 - istep, p_states, p_costFunction);
+        ArrayXXd particles =  p_simulator->stepForwardAndGetParticles();
+        for (int is = 0; is < p_simulator->getNbSimul(); ++is)
+            p_states[is].setStochasticRealization(particles.col(is));
+    }
+}
+
+/// \brief maximal difference between the stocks of two sets of simulations
+double maxDiffStocks(const vector<StateWithStocks> &p_states1, const vector<StateWithStocks> &p_states2)
+{
+    double diff = 0.;
+    for (size_t is = 0; is < p_states1.size(); ++is)
+        diff = max(diff, (p_states1[is].getPtStock() - p_states2[is].getPtStock()).abs().maxCoeff());
+    return diff;
+}
+
 /// \brief valorization of a given Lake on a  grid
 ///        Gain are proportional to what is withdrawn from the storage
 ///        Only inflows are stochastic
@@ -173,6 +209,44 @@ void testLake(shared_ptr< FullGrid> &p_grid, const double &p_maxLevelStorage, co
     cout << " valSimu2  " << valSimu2 << " valueOptim " << valueOptim << endl ;
     if (p_bCheckClose)
         BOOST_CHECK_CLOSE(valueOptim, valSimu2, accuracyClose);
+
+    // simulations sorted by mesh give the same states and costs as in their natural order (continuation values, then controls)
+    for (int iControl = 0; iControl < 2; ++iControl)
+    {
+        vector<StateWithStocks> states[2];
+        ArrayXXd costFunction[2];
+        for (int iSort = 0; iSort < 2; ++iSort)
+        {
+            shared_ptr< AR1Simulator> forSimulatorSort = make_shared<AR1Simulator> (D0, m, sig, mr, maturity, nstep, nbsimulSim, bForward);
+            storage->setSimulator(forSimulatorSort);
+            gs::BinaryFileArchive ar(fileToDump.c_str(), "r");
+            simulateLakeStates(forSimulatorSort, [&](const int &p_istep, vector<StateWithStocks> &p_states, ArrayXXd &p_costFunction)
+            {
+                if (iControl == 0)
+                {
+                    SimulateStepRegression step(ar, p_istep, "Continuation", p_grid, storage
+#ifdef USE_MPI
+                                                , world
+#endif
+                                               );
+                    step.setSortStates(iSort == 1);
+                    step.oneStep(p_states, p_costFunction);
+                }
+                else
+                {
+                    SimulateStepRegressionControl step(ar, p_istep, "Continuation", p_grid, storage
+#ifdef USE_MPI
+                                                       , world
+#endif
+                                                      );
+                    step.setSortStates(iSort == 1);
+                    step.oneStep(p_states, p_costFunction);
+                }
+            }, initialStock, storage->getSimuFuncSize(), states[iSort], costFunction[iSort]);
+        }
+        BOOST_CHECK_SMALL((costFunction[1] - costFunction[0]).abs().maxCoeff(), accuracyEqual);
+        BOOST_CHECK_SMALL(maxDiffStocks(states[1], states[0]), accuracyEqual);
+    }
 }
 
 // linear interpolation
@@ -229,6 +303,60 @@ BOOST_AUTO_TEST_CASE(testSimpleStorageAverageInflows)
     testLake(grid, maxLevelStorage, nbmesh, false);
 }
 
+// controls dumped by blocks of grid points and read around the simulated stocks
+BOOST_AUTO_TEST_CASE(testSimpleStorageChunkedControl)
+{
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+#endif
+    double maxLevelStorage  = 5000;
+    double withdrawalRateStorage = 1000;
+    double maturity = 1.;
+    size_t nstep = 10;
+    size_t nbsimul = 8000;
+    // inflow model
+    double D0 = 50. ; // initial inflow
+    double m = D0 ; // average inflow
+    double sig = 5. ; // volatility
+    double mr  = 5. ; // mean reverting
+    // grid
+    int nGrid = 10;
+    ArrayXd lowValues = ArrayXd::Constant(1, 0.);
+    ArrayXd step = ArrayXd::Constant(1, maxLevelStorage / nGrid);
+    ArrayXi nbStep = ArrayXi::Constant(1, nGrid);
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    // optimizer and regressor
+    shared_ptr< OptimizeLake<AR1Simulator> > storage =  make_shared< OptimizeLake<AR1Simulator> >(withdrawalRateStorage);
+    shared_ptr< LocalLinearRegression > regressor =  make_shared< LocalLinearRegression >(ArrayXi::Constant(1, 4));
+    function<double(const int &, const ArrayXd &, const ArrayXd &)>  vFunction = ZeroFunction();
+    ArrayXd initialStock = ArrayXd::Constant(1, maxLevelStorage);
+    int initialRegime = 0;
+#ifdef USE_MPI
+    string fileToDump = "CondExpLakeChunked" + to_string(world.size());
+#else
+    string fileToDump = "CondExpLakeChunked";
+#endif
+    // two meshes per block
+    ArrayXi chunkSize = ArrayXi::Constant(1, 2);
+    storage->setSimulator(make_shared<AR1Simulator> (D0, m, sig, mr, maturity, nstep, nbsimul, false));
+    double valueOptim =  DynamicProgrammingByRegressionChunked(grid, storage, regressor, vFunction, initialStock, initialRegime, fileToDump, chunkSize
+#ifdef USE_MPI
+                         , world
+#endif
+                                                              );
+    storage->setSimulator(make_shared<AR1Simulator> (D0, m, sig, mr, maturity, nstep, nbsimul, true));
+    int nbChunkRead = 0;
+    int nbChunk = 0;
+    double valSimu = SimulateRegressionControlChunked(grid, storage, vFunction, initialStock, initialRegime, fileToDump, nbChunkRead, nbChunk
+#ifdef USE_MPI
+                     , world
+#endif
+                                                     ) ;
+    cout << " valSimu  " << valSimu << " valueOptim " << valueOptim << " blocks read " << nbChunkRead << " on " << nbChunk << endl ;
+    BOOST_CHECK_CLOSE(valueOptim, valSimu, accuracyClose);
+    // first steps only reach the blocks around the initial full storage
+    BOOST_CHECK(nbChunkRead < nbChunk);
+}
 
 #ifdef USE_MPI
 // (empty) Initialization function. Can't use testing tools here.
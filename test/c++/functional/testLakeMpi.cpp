@@ -25,6 +25,7 @@ using namespace Eigen ;
 using namespace libstoch;
 
 double accuracyClose =  1.5;
+double accuracyEqual = 1e-10;
 
 
 /// For Clang 3.6 (and above ?) to be compatible GCC 5.1 and above
@@ -60,6 +61,38 @@ public:
 #define enable_abort_on_floating_point_exception() feenableexcept(FE_DIVBYZERO | FE_INVALID)
 #endif
 
+/// \brief simulate the lake and keep the final states and the costs of all the simulations
+/// \param p_simulator      forward simulator
+/// \param p_oneStep        simulate a step (step number in the archive, states and costs of the simulations)
+/// \param p_initialStock   initial stock
+/// \param p_nbFunc         number of functions followed in simulation
+/// \param p_states         final states of the simulations
+/// \param p_costFunction   costs of the simulations
+void simulateLakeStates(const shared_ptr< AR1Simulator> &p_simulator,
+                        const function<void(const int &, vector<StateWithStocks> &, ArrayXXd &)> &p_oneStep,
+                        const ArrayXd &p_initialStock, const int &p_nbFunc, vector<StateWithStocks> &p_states, ArrayXXd &p_costFunction)
+{
+    int nbStep = p_simulator->getNbStep();
+    p_states.assign(p_simulator->getNbSimul(), StateWithStocks(0, p_initialStock, ArrayXd::Zero(p_simulator->getDimension())));
+    p_costFunction = ArrayXXd::Zero(p_nbFunc, p_simulator->getNbSimul());
+    for (int istep = 0; istep < nbStep; ++istep)
+    {
+        p_oneStep(nbStep - 1 - istep, p_states, p_costFunction);
+        ArrayXXd particles =  p_simulator->stepForwardAndGetParticles();
+        for (int is = 0; is < p_simulator->getNbSimul(); ++is)
+            p_states[is].setStochasticRealization(particles.col(is));
+    }
+}
+
+/// \brief maximal difference between the stocks of two sets of simulations
+double maxDiffStocks(const vector<StateWithStocks> &p_states1, const vector<StateWithStocks> &p_states2)
+{
+    double diff = 0.;
+    for (size_t is = 0; is < p_states1.size(); ++is)
+        diff = max(diff, (p_states1[is].getPtStock() - p_states2[is].getPtStock()).abs().maxCoeff());
+    return diff;
+}
+
 /// \brief valorization of a given Lake on a  grid
 ///        Gain are proportional to what is withdrawn from the storage
 ///        Only inflows are stochastic
@@ -155,6 +188,39 @@ void testLake(shared_ptr< FullGrid> &p_grid, const double &p_maxLevelStorage, co
         if (p_bCheckClose)
             BOOST_CHECK_CLOSE(valueOptimDist, valSimuDist2, accuracyClose);
     }
+
+    // simulations sorted by mesh give the same states and costs as in their natural order (continuation values, then controls)
+    string toDump = fileToDump;
+    if (!p_bOneFile)
+        toDump +=  "_" + boost::lexical_cast<string>(world.rank());
+    for (int iControl = 0; iControl < 2; ++iControl)
+    {
+        vector<StateWithStocks> states[2];
+        ArrayXXd costFunction[2];
+        for (int iSort = 0; iSort < 2; ++iSort)
+        {
+            shared_ptr< AR1Simulator> forSimulatorSort = make_shared<AR1Simulator> (D0, m, sig, mr, maturity, nstep, nbsimulSim, bForward);
+            storage->setSimulator(forSimulatorSort);
+            gs::BinaryFileArchive ar(toDump.c_str(), "r");
+            simulateLakeStates(forSimulatorSort, [&](const int &p_istep, vector<StateWithStocks> &p_states, ArrayXXd &p_costFunction)
+            {
+                if (iControl == 0)
+                {
+                    SimulateStepRegressionDist step(ar, p_istep, "Continuation", p_grid, storage, p_bOneFile, world);
+                    step.setSortStates(iSort == 1);
+                    step.oneStep(p_states, p_costFunction);
+                }
+                else
+                {
+                    SimulateStepRegressionControlDist step(ar, p_istep, "Continuation", p_grid, p_grid, storage, p_bOneFile, world);
+                    step.setSortStates(iSort == 1);
+                    step.oneStep(p_states, p_costFunction);
+                }
+            }, initialStock, storage->getSimuFuncSize(), states[iSort], costFunction[iSort]);
+        }
+        BOOST_CHECK_SMALL((costFunction[1] - costFunction[0]).abs().maxCoeff(), accuracyEqual);
+        BOOST_CHECK_SMALL(maxDiffStocks(states[1], states[0]), accuracyEqual);
+    }
 }
 
 // linear interpolation
@@ -21,6 +21,7 @@
 #include "libstoch/sddp/SDDPFinalCut.h"
 #include "libstoch/sddp/SDDPLocalCut.h"
 #include "libstoch/sddp/backwardForwardSDDP.h"
+#include "libstoch/sddp/backwardForwardSDDPAsync.h"
 #include "test/c++/tools/simulators/SimulatorGaussianSDDP.h"
 #include "test/c++/tools/sddp/OptimizeReservoirWithInflowsSDDP.h"
 
@@ -38,9 +39,12 @@ using namespace libstoch;
 /// When demand not fulfilled by water, energy is bought on the market
 /// Inflows and demand are gaussian IID
 /// where $g$ is a centred unit Gaussian variable.
+/// Return the value obtained in optimization
 template< class LocalRegressionForSDDP >
-void testStorageDemandSDDP(const int &p_nbStorage, const int &p_iterMax,  const int &p_sample,  const int &p_sampleCheck, const double p_accuracyClose, const int &p_nstepIterations,
-                           const double &p_sigF,  const double &p_sigD)
+double testStorageDemandSDDP(const int &p_nbStorage, const int &p_iterMax,  const int &p_sample,  const int &p_sampleCheck, const double p_accuracyClose, const int &p_nstepIterations,
+                           const double &p_sigF,  const double &p_sigD, const bool &p_bReuseLP = false,
+                           const bool &p_bLocalStateBuffer = false, const int &p_staleness = -1, const bool &p_bMultiCut = false,
+                           const string &p_nameRegressorBacking = "", const shared_ptr<SDDPAdaptiveSchedule> &p_schedule = shared_ptr<SDDPAdaptiveSchedule>())
 {
 #ifdef USE_MPI
     boost::mpi::communicator world;
@@ -94,7 +98,7 @@ void testStorageDemandSDDP(const int &p_nbStorage, const int &p_iterMax,  const
     shared_ptr<SimulatorGaussianSDDP> forSimulator = make_shared<SimulatorGaussianSDDP>(nbUncertainties);
 
     // define the storage
-    shared_ptr<OptimizerSDDPBase >  optimizer = make_shared<OptimizeReservoirWithInflowsSDDP<SimulatorGaussianSDDP> >(initLevel, withdrawalRate, p_nbStorage, sigF,   flowAver, sigD,  demand, spot, backSimulator, forSimulator);
+    shared_ptr<OptimizerSDDPBase >  optimizer = make_shared<OptimizeReservoirWithInflowsSDDP<SimulatorGaussianSDDP> >(initLevel, withdrawalRate, p_nbStorage, sigF,   flowAver, sigD,  demand, spot, backSimulator, forSimulator, p_bReuseLP, p_bMultiCut);
 
     // optimisation dates
     ArrayXd dates = ArrayXd::LinSpaced(nstep + 1, 0., maturity);
@@ -107,13 +111,24 @@ void testStorageDemandSDDP(const int &p_nbStorage, const int &p_iterMax,  const
     double accuracy = p_accuracyClose / 100.;
     ostringstream stringStream; // store intermediate results
 
-    pair<double, double>  values = backwardForwardSDDP<LocalRegressionForSDDP>(optimizer,  p_sampleCheck, initialState,
-                                   finCut, dates,  nbMesh, nameRegressor, nameCut, nameVisitedStates, nIterMax,
-                                   accuracy,  p_nstepIterations, stringStream
+    pair<double, double>  values;
+    if (p_staleness < 0)
+        values = backwardForwardSDDP<LocalRegressionForSDDP>(optimizer,  p_sampleCheck, initialState,
+                 finCut, dates,  nbMesh, nameRegressor, nameCut, nameVisitedStates, nIterMax,
+                 accuracy,  p_nstepIterations, stringStream
 #ifdef USE_MPI
-                                   , world
+                 , world
 #endif
-                                                                              );
+                 , false, p_bLocalStateBuffer, p_bMultiCut, p_nameRegressorBacking, p_schedule);
+    else
+        // backward sweep with stale cuts
+        values = backwardForwardSDDPAsync<LocalRegressionForSDDP>(optimizer,  p_sampleCheck, initialState,
+                 finCut, dates,  nbMesh, nameRegressor, nameCut, nameVisitedStates, nIterMax,
+                 accuracy,  p_nstepIterations, p_staleness, stringStream
+#ifdef USE_MPI
+                 , world
+#endif
+                 , false, p_bLocalStateBuffer, p_bMultiCut, p_nameRegressorBacking);
 
 #ifdef USE_MPI
     if (world.rank() == 0)
@@ -123,7 +138,7 @@ void testStorageDemandSDDP(const int &p_nbStorage, const int &p_iterMax,  const
         cout << "Nb storage " << p_nbStorage << " Value Optim " <<  values.first << " and Simulation " << values.second << " Iteration " << nIterMax << endl ;
         BOOST_CHECK(accuracy <= (p_accuracyClose / 100.));
     }
-
+    return values.first;
 }
 
 
@@ -171,6 +186,123 @@ BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP5DDeterminist)
     testStorageDemandSDDP<LocalConstRegressionForSDDP>(dim,  iterMax, nbSample,  nbSampleCheck, error, nstep, sigF, sigD);
 }
 
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP2DDeterministReuseLP)
+{
+    int dim = 2; // number of storage
+    int iterMax = 100; /// maximal number of iteration forward/backward
+    int  nbSample = 1 ; // number of samples
+    int   nbSampleCheck = 1 ; // number of samples for checking convergence
+    double  error    = 0.1 ; // percentage between optimization and simulation allowed
+    int     nstep = 10 ; /// accuracy is checked every nstep iterations
+    double sigF = 0; /// vol for inflows
+    double  sigD = 0. ; /// vol for demand
+    // LP kept and warm started between resolutions
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(dim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, true);
+}
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP2DDeterministAsync)
+{
+    int dim = 2; // number of storage
+    int iterMax = 100; /// maximal number of iteration forward/backward
+    int  nbSample = 1 ; // number of samples
+    int   nbSampleCheck = 1 ; // number of samples for checking convergence
+    double  error    = 0.1 ; // percentage between optimization and simulation allowed
+    int     nstep = 10 ; /// accuracy is checked every nstep iterations
+    double sigF = 0; /// vol for inflows
+    double  sigD = 0. ; /// vol for demand
+    int staleness = 2; // dates treated together in backward with cuts of previous iteration
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(dim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, false, staleness);
+}
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP1DAsync)
+{
+    int ndim = 1; // number of storage
+    int iterMax = 200; /// maximal number of iteration forward/backward
+    int  nbSample = 200 ; // number of samples
+    int   nbSampleCheck = 4000; // number of samples for checking convergence
+    double  error    = 1.5 ; // percentage between optimization and simulation allowed
+    int     nstep = 5 ; /// accuracy is checked every nstep iterations
+    double sigF = 0.6; /// vol for inflows
+    double  sigD = 0.6; /// vol for demand
+    // classical backward sweep (one date per wave) against waves of 4 dates using cuts of the previous iteration
+    double valueSync = testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, false, 0);
+    double valueStale = testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, false, 3);
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+    if (world.rank() == 0)
+#endif
+        BOOST_CHECK_CLOSE(valueStale, valueSync, 2 * error);
+}
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP2DDeterministRegressorBacking)
+{
+    int dim = 2; // number of storage
+    int iterMax = 100; /// maximal number of iteration forward/backward
+    int  nbSample = 1 ; // number of samples
+    int   nbSampleCheck = 1 ; // number of samples for checking convergence
+    double  error    = 0.1 ; // percentage between optimization and simulation allowed
+    int     nstep = 10 ; /// accuracy is checked every nstep iterations
+    double sigF = 0; /// vol for inflows
+    double  sigD = 0. ; /// vol for demand
+    // regressors kept serialized in a backing file
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(dim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, false, -1, false, "RegressorReservoirBacking");
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(dim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, false, 2, false, "RegressorReservoirBacking");
+}
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP1DLocalStateBuffer)
+{
+    int ndim = 1; // number of storage
+    int iterMax = 200; /// maximal number of iteration forward/backward
+    int  nbSample = 200 ; // number of samples
+    int   nbSampleCheck = 4000; // number of samples for checking convergence
+    double  error    = 1.5 ; // percentage between optimization and simulation allowed
+    int     nstep = 5 ; /// accuracy is checked every nstep iterations
+    double sigF = 0.6; /// vol for inflows
+    double  sigD = 0.6; /// vol for demand
+    // visited states stored by thread during forward sweep
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, true);
+}
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP1DMultiCut)
+{
+    int ndim = 1; // number of storage
+    int iterMax = 200; /// maximal number of iteration forward/backward
+    int  nbSample = 20 ; // number of samples
+    int   nbSampleCheck = 4000; // number of samples for checking convergence
+    double  error    = 1.5 ; // percentage between optimization and simulation allowed
+    int     nstep = 5 ; /// accuracy is checked every nstep iterations
+    double sigF = 0.6; /// vol for inflows
+    double  sigD = 0.6; /// vol for demand
+    // one cut per sample kept in backward sweep
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, false, -1, true);
+}
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP1DMultiCutReuseLP)
+{
+    int ndim = 1; // number of storage
+    int iterMax = 200; /// maximal number of iteration forward/backward
+    int  nbSample = 20 ; // number of samples
+    int   nbSampleCheck = 4000; // number of samples for checking convergence
+    double  error    = 1.5 ; // percentage between optimization and simulation allowed
+    int     nstep = 5 ; /// accuracy is checked every nstep iterations
+    double sigF = 0.6; /// vol for inflows
+    double  sigD = 0.6; /// vol for demand
+    // one cut per sample and LP kept and warm started between resolutions
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, true, false, -1, true);
+}
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP1DAdaptiveSchedule)
+{
+    int ndim = 1; // number of storage
+    int iterMax = 200; /// maximal number of iteration forward/backward
+    int  nbSample = 200 ; // number of samples
+    double  error    = 1.5 ; // percentage between optimization and simulation allowed
+    double sigF = 0.6; /// vol for inflows
+    double  sigD = 0.6; /// vol for demand
+    // forward simulations from 100 to 8000 and gap tested at each iteration
+    shared_ptr<SDDPAdaptiveSchedule> schedule = make_shared<SDDPAdaptiveSchedule>(100, 8000);
+    testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, 0, error, 1, sigF, sigD, false, false, -1, false, "", schedule);
+}
 
 BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP1D)
 {
@@ -217,6 +349,26 @@ BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDP5D)
     testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample,  nbSampleCheck, error, nstep, sigF, sigD);
     testStorageDemandSDDP<LocalConstRegressionForSDDP>(ndim,  iterMax, nbSample,  nbSampleCheck, error, nstep, sigF, sigD);
 }
+
+BOOST_AUTO_TEST_CASE(testSimpleStorageWithInflowsSDDPSingleAgainstMultiCut)
+{
+    int  iterMax = 200; /// maximal number of iteration forward/backward
+    int   nbSampleCheck = 4000; // number of samples for checking convergence
+    double  error    = 1.5 ; // percentage between optimization and simulation allowed
+    int     nstep = 5 ; /// accuracy is checked every nstep iterations
+    double sigF = 0.6; /// vol for inflows
+    double  sigD = 0.6; /// vol for demand
+    // few samples per stage : single cut and multi cut converge to the same value
+    // (iterations and time are compared by the sddpSingleVsMultiCut kernel of the benchmark)
+    for (int ndim = 1; ndim <= 2; ++ndim)
+        for (int nbSample = 10; nbSample <= 40; nbSample *= 2)
+        {
+            double valueSingle = testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD);
+            double valueMulti = testStorageDemandSDDP<LocalLinearRegressionForSDDP>(ndim,  iterMax, nbSample, nbSampleCheck, error, nstep, sigF, sigD, false, false, -1, true);
+            // each value is within error percent of its simulation
+            BOOST_CHECK_CLOSE(valueMulti, valueSingle, 2 * error);
+        }
+}
 #endif
 
 #ifdef USE_MPI
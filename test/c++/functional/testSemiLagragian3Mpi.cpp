@@ -128,9 +128,12 @@ void  testCase3LinearInterpolation(const int &p_ndt,  const  shared_ptr<libstoch
     // following only the probability
     double probaResult = semiLagrangianSimuDist(p_grid, optimizer, finalFunctionValue, p_ndt, stateInit, initialRegime, nbSimul, fileToDump, p_bOneFile, world);
     double probaResult2 = semiLagrangianSimuControlDist(p_grid, optimizer, finalFunctionValue, p_ndt, stateInit, initialRegime, nbSimul, fileToDump, p_bOneFile, world);
+    // simulations kept by processors between steps
+    double probaResult3 = semiLagrangianSimuDist(p_grid, optimizer, finalFunctionValue, p_ndt, stateInit, initialRegime, nbSimul, fileToDump, p_bOneFile, world, true);
     if (world.rank() == 0)
     {
-        cout <<  " Proba obtained " << probaResult << " and " <<  probaResult2 << endl ;
+        cout <<  " Proba obtained " << probaResult << " and " <<  probaResult2 << " with persistent ownership " << probaResult3 << endl ;
+        BOOST_CHECK_CLOSE(probaResult, probaResult3, 1e-6);
         BOOST_CHECK(valAndError.second < 0.008);
         BOOST_CHECK(fabs(probaResult - p_proba) < 0.02);
         BOOST_CHECK(fabs(probaResult2 - p_proba) < 0.03);
@@ -18,6 +18,8 @@
 #include "test/c++/tools/dp/OptimizeFictitiousSwing.h"
 #include "test/c++/tools/dp/DynamicProgrammingByRegression.h"
 #include "test/c++/tools/dp/SimulateRegression.h"
+#include "test/c++/tools/dp/DynamicProgrammingByRegressionChunked.h"
+#include "test/c++/tools/dp/SimulateRegressionChunked.h"
 #include "test/c++/tools/BasketOptions.h"
 #include "test/c++/tools/simulators/BlackScholesSimulator.h"
 
@@ -122,6 +124,77 @@ BOOST_AUTO_TEST_CASE(testSwingOptionOptimNDSimu)
 
 }
 
+/// same test with continuation values dumped by blocks of one mesh in a compressed archive
+BOOST_AUTO_TEST_CASE(testSwingOptionOptimNDSimuChunked)
+{
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+#endif
+
+    int ndim = 2 ;
+    VectorXd initialValues = ArrayXd::Constant(1, 1.);
+    VectorXd sigma  = ArrayXd::Constant(1, 0.2);
+    VectorXd mu  = ArrayXd::Constant(1, 0.05);
+    MatrixXd corr = MatrixXd::Ones(1, 1);
+    // number of step
+    int nStep = 20;
+    // exercise date
+    double T = 1. ;
+    ArrayXd dates = ArrayXd::LinSpaced(nStep + 1, 0., T);
+    int N = 3 ; // 5 exercise dates
+    double strike = 1.;
+    int nbSimul = 80000;
+    int nMesh = 8;
+    // payoff
+    BasketCall  payoff(strike);
+    // mesh
+    ArrayXi nbMesh = ArrayXi::Constant(1, nMesh);
+
+    // simulator
+    shared_ptr<BlackScholesSimulator> simulatorBack(new BlackScholesSimulator(initialValues, sigma, mu, corr, dates(dates.size() - 1), dates.size() - 1, nbSimul, false));
+    // grid
+    ArrayXd lowValues = ArrayXd::Constant(ndim, 0.);
+    ArrayXd step = ArrayXd::Constant(ndim, 1.);
+    // the stock is discretized with values from 0 to N included
+    ArrayXi nbStep = ArrayXi::Constant(ndim, N);
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    // final value
+    function<double(const int &, const ArrayXd &, const ArrayXd &)>   vFunction = FinalValueFictitiousFunction<BasketCall>(payoff, N);
+    // optimizer
+    shared_ptr< OptimizeFictitiousSwing<BasketCall, BlackScholesSimulator> >optimizer = make_shared< OptimizeFictitiousSwing<BasketCall, BlackScholesSimulator> >(payoff, N, ndim);
+    // initial values
+    ArrayXd initialStock = ArrayXd::Constant(ndim, 0.);
+    int initialRegime = 0;
+    string fileToDump = "CondExpOptNDChunked";
+    // regressor
+    shared_ptr< LocalLinearRegression > regressor(new LocalLinearRegression(nbMesh));
+    // one mesh per block
+    ArrayXi chunkSize = ArrayXi::Constant(ndim, 1);
+    // link the simulations to the optimizer
+    optimizer->setSimulator(simulatorBack);
+    double valueOptim = DynamicProgrammingByRegressionChunked(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDump, chunkSize
+#ifdef USE_MPI
+                        , world
+#endif
+                                                             );
+    // simulation value
+    int nbSimulSim = 80000;
+    shared_ptr<BlackScholesSimulator>  simulatorForward(new BlackScholesSimulator(initialValues, sigma, mu, corr, dates(dates.size() - 1), dates.size() - 1, nbSimulSim, true));
+    optimizer->setSimulator(simulatorForward);
+    int nbChunkRead = 0;
+    int nbChunk = 0;
+    double valSimu = SimulateRegressionChunked(grid, optimizer, vFunction, initialStock, initialRegime, fileToDump, nbChunkRead, nbChunk
+#ifdef USE_MPI
+                     , world
+#endif
+                                              ) ;
+
+    BOOST_CHECK_CLOSE(valueOptim, valSimu, accuracyClose);
+    // stocks start from zero : blocks far from the origin are not read at the first steps
+    BOOST_CHECK(nbChunkRead < nbChunk);
+
+}
+
 #ifdef USE_MPI
 // (empty) Initialization function. Can't use testing tools here.
 bool init_function()
@@ -52,7 +52,8 @@ string normalize_test_case_name(const_string name)
 
 /// \param p_ndim        dimension of the swing
 /// \param p_bOneFile    Do we use one unique file for continuation values
-void testSwingND(const  int   &p_ndim, bool p_bOneFile)
+/// \param p_splitting   splitting of the grid between processors in optimization and simulation
+void testSwingND(const  int   &p_ndim, bool p_bOneFile, const SplittingFunction &p_splitting = paraOptimalSplitting)
 {
     boost::mpi::communicator world;
     VectorXd initialValues = ArrayXd::Constant(1, 1.);
@@ -93,12 +94,13 @@ void testSwingND(const  int   &p_ndim, bool p_bOneFile)
     shared_ptr< BaseRegression > regressor(new LocalLinearRegression(nbMesh));
     // link the simulations to the optimizer
     optimizer->setSimulator(simulator);
-    double valueOptimDist = DynamicProgrammingByRegressionDist(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDump, p_bOneFile, world);
+    double valueOptimDist = DynamicProgrammingByRegressionDist(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDump, p_bOneFile, world,
+                            "", 1, p_splitting);
     // simulation value
     shared_ptr<BlackScholesSimulator>  simulatorForward(new BlackScholesSimulator(initialValues, sigma, mu, corr, dates(dates.size() - 1), dates.size() - 1, nbSimul, true));
     optimizer->setSimulator(simulatorForward);
     double valSimuDist = SimulateRegressionDist(grid, optimizer, vFunction, initialStock, initialRegime,
-                         fileToDump, p_bOneFile, world) ;
+                         fileToDump, p_bOneFile, world, p_splitting) ;
     if (world.rank() == 0)
         BOOST_CHECK_CLOSE(valueOptimDist, valSimuDist, accuracyClose);
 
@@ -117,6 +119,13 @@ BOOST_AUTO_TEST_CASE(testSwingOptionOptim2DSimuDistMultipleFile)
     testSwingND(ndim, bOneFile);
 }
 
+// grid split taking into account the nodes of the processors : each processor dumps and reads back its own part of the values
+BOOST_AUTO_TEST_CASE(testSwingOptionOptim2DSimuDistMultipleFileTopologySplitting)
+{
+    int ndim = 2 ;
+    bool bOneFile = false ;
+    testSwingND(ndim, bOneFile, TopologySplitting(ArrayXi::Constant(ndim, 1)));
+}
 
 
 
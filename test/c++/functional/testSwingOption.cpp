@@ -12,10 +12,17 @@
 #endif
 #include <array>
 #include <memory>
+#include <cstdio>
+#include <fstream>
 #include <boost/test/unit_test.hpp>
 #include <boost/tuple/tuple.hpp>
 #include <Eigen/Dense>
+#include "geners/BinaryFileArchive.hh"
+#include "geners/Reference.hh"
+#include "geners/vectorIO.hh"
+#include "libstoch/core/utils/eigenGeners.h"
 #include "libstoch/regression/LocalLinearRegressionGeners.h"
+#include "libstoch/regression/GridAndRegressedValueGeners.h"
 #include "libstoch/core/utils/comparisonUtils.h"
 #include "libstoch/core/grids/GridIterator.h"
 #include "libstoch/core/grids/RegularSpaceGridGeners.h"
@@ -29,6 +36,7 @@
 #include "test/c++/tools/dp/OptimizeFictitiousSwing.h"
 #include "test/c++/tools/dp/FinalValueFunction.h"
 #include "test/c++/tools/dp/FinalValueFictitiousFunction.h"
+#include "libstoch/dp/CheckpointDP.h"
 #include "test/c++/tools/dp/DynamicProgrammingByRegression.h"
 #ifdef USE_MPI
 #include "test/c++/tools/dp/DynamicProgrammingByRegressionDist.h"
@@ -311,6 +319,253 @@ BOOST_AUTO_TEST_CASE(testSwingOptionInOptimization)
     BOOST_CHECK_EQUAL(valueSeq, value);
 #endif
 }
+BOOST_AUTO_TEST_CASE(testSwingOptionCheckpointRestart)
+{
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+    world.barrier();
+#endif
+    VectorXd initialValues = ArrayXd::Constant(1, 1.);
+    VectorXd sigma  = ArrayXd::Constant(1, 0.2);
+    VectorXd mu  = ArrayXd::Constant(1, 0.05);
+    MatrixXd corr = MatrixXd::Ones(1, 1);
+    // number of step
+    int nStep = 30;
+    // exercise date
+    double T = 1. ;
+    ArrayXd dates = ArrayXd::LinSpaced(nStep + 1, 0., T);
+    int N = 3 ; // 3  exercise dates
+    double strike = 1.;
+    int nbSimul = 20000;
+    int nMesh = 8;
+    // checkpoint every 7 steps : last checkpoint after step 27, so two steps are recomputed at restart
+    int checkpointFrequency = 7;
+    // payoff
+    BasketCall  payoff(strike);
+    ArrayXi nbMesh = ArrayXi::Constant(1, nMesh);
+    // grid
+    ArrayXd lowValues = ArrayXd::Constant(1, 0.);
+    ArrayXd step = ArrayXd::Constant(1, 1.);
+    ArrayXi nbStep = ArrayXi::Constant(1, N);
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    // final value
+    function<double(const int &, const ArrayXd &, const ArrayXd &)>  vFunction = FinalValueFunction<BasketCall>(payoff, N);
+    // initial values
+    ArrayXd initialStock = ArrayXd::Constant(1, 0.);
+    int initialRegime = 0;
+    string fileCheckpoint = "CheckpointSwing";
+#ifdef USE_MPI
+    fileCheckpoint = fileCheckpoint + to_string(world.size());
+    if (world.rank() == 0)
+        CheckpointDP::removeFiles(fileCheckpoint);
+    CheckpointDP::removeFiles(fileCheckpoint + "_" + to_string(world.rank()));
+    world.barrier();
+#else
+    CheckpointDP::removeFiles(fileCheckpoint);
+#endif
+    // first resolution writing checkpoints, second one restarting from the last checkpoint
+    array<double, 2> values;
+    for (int irun = 0; irun < 2; ++irun)
+    {
+        // the same simulations are replayed
+        shared_ptr<BlackScholesSimulator>  simulator(new BlackScholesSimulator(initialValues, sigma, mu, corr, dates(dates.size() - 1), dates.size() - 1, nbSimul, false)) ;
+        shared_ptr< OptimizeSwing<BasketCall, BlackScholesSimulator> >optimizer = make_shared< OptimizeSwing<BasketCall, BlackScholesSimulator> >(payoff, N);
+        optimizer->setSimulator(simulator);
+        shared_ptr<BaseRegression > regressor(new LocalLinearRegression(nbMesh));
+        string fileToDump = "CondExpCheckpoint" + to_string(irun);
+#ifdef USE_MPI
+        fileToDump = fileToDump + to_string(world.size());
+        values[irun] = DynamicProgrammingByRegressionDist(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDump, false, world,
+                       fileCheckpoint, checkpointFrequency);
+#else
+        values[irun] = DynamicProgrammingByRegression(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDump,
+                       fileCheckpoint, checkpointFrequency);
+#endif
+    }
+#ifdef USE_MPI
+    if (world.rank() == 0)
+#endif
+        BOOST_CHECK_EQUAL(values[0], values[1]);
+}
+
+/// \brief Black Scholes simulator stopping the resolution (exception) after a given number of backward steps
+class CrashingSimulator : public BlackScholesSimulator
+{
+    int m_nbStepBeforeCrash ; ///< number of backward steps before the crash
+public :
+    CrashingSimulator(const VectorXd &p_initialValues, const VectorXd &p_sigma, const VectorXd &p_mu, const MatrixXd &p_correl,
+                      const double &p_T, const size_t &p_nbStep, const size_t &p_nbSimul, const int &p_nbStepBeforeCrash):
+        BlackScholesSimulator(p_initialValues, p_sigma, p_mu, p_correl, p_T, p_nbStep, p_nbSimul, false), m_nbStepBeforeCrash(p_nbStepBeforeCrash) {}
+
+    MatrixXd stepBackwardAndGetParticles()
+    {
+        if (m_nbStepBeforeCrash-- == 0)
+            throw runtime_error("Resolution stopped");
+        return BlackScholesSimulator::stepBackwardAndGetParticles();
+    }
+};
+
+/// \brief A resolution is stopped after the last checkpoint : the restart appends the missing steps to the continuation archive
+BOOST_AUTO_TEST_CASE(testSwingOptionCheckpointRestartAppend)
+{
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+    world.barrier();
+#endif
+    VectorXd initialValues = ArrayXd::Constant(1, 1.);
+    VectorXd sigma  = ArrayXd::Constant(1, 0.2);
+    VectorXd mu  = ArrayXd::Constant(1, 0.05);
+    MatrixXd corr = MatrixXd::Ones(1, 1);
+    // number of step
+    int nStep = 30;
+    // exercise date
+    double T = 1. ;
+    int N = 3 ; // 3  exercise dates
+    double strike = 1.;
+    int nbSimul = 20000;
+    int nMesh = 8;
+    // checkpoints after steps 6, 13, 20 before the crash at step 24 : steps 21 to 23 are already dumped at restart
+    int checkpointFrequency = 7;
+    int nbStepBeforeCrash = 24;
+    // payoff
+    BasketCall  payoff(strike);
+    ArrayXi nbMesh = ArrayXi::Constant(1, nMesh);
+    // grid
+    ArrayXd lowValues = ArrayXd::Constant(1, 0.);
+    ArrayXd step = ArrayXd::Constant(1, 1.);
+    ArrayXi nbStep = ArrayXi::Constant(1, N);
+    shared_ptr<FullGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    // final value
+    function<double(const int &, const ArrayXd &, const ArrayXd &)>  vFunction = FinalValueFunction<BasketCall>(payoff, N);
+    // initial values
+    ArrayXd initialStock = ArrayXd::Constant(1, 0.);
+    int initialRegime = 0;
+    string fileCheckpoint = "CheckpointSwingAppend";
+    string fileToDump = "CondExpCheckpointAppend";
+#ifdef USE_MPI
+    fileCheckpoint = fileCheckpoint + to_string(world.size());
+    fileToDump = fileToDump + to_string(world.size());
+    CheckpointDP::removeFiles(fileCheckpoint + "_" + to_string(world.rank()));
+    world.barrier();
+#else
+    CheckpointDP::removeFiles(fileCheckpoint);
+#endif
+    // reference without checkpoint, stopped resolution, restarted resolution
+    array<double, 3> values;
+    for (int irun = 0; irun < 3; ++irun)
+    {
+        shared_ptr<BlackScholesSimulator>  simulator;
+        if (irun == 1)
+            simulator = make_shared<CrashingSimulator>(initialValues, sigma, mu, corr, T, nStep, nbSimul, nbStepBeforeCrash);
+        else
+            simulator = make_shared<BlackScholesSimulator>(initialValues, sigma, mu, corr, T, nStep, nbSimul, false);
+        shared_ptr< OptimizeSwing<BasketCall, BlackScholesSimulator> >optimizer = make_shared< OptimizeSwing<BasketCall, BlackScholesSimulator> >(payoff, N);
+        optimizer->setSimulator(simulator);
+        shared_ptr<BaseRegression > regressor(new LocalLinearRegression(nbMesh));
+        string fileCheckpointRun = (irun == 0) ? "" : fileCheckpoint;
+        string fileToDumpRun = (irun == 0) ? fileToDump + "Ref" : fileToDump;
+        try
+        {
+#ifdef USE_MPI
+            values[irun] = DynamicProgrammingByRegressionDist(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDumpRun, false, world,
+                           fileCheckpointRun, checkpointFrequency);
+#else
+            values[irun] = DynamicProgrammingByRegression(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDumpRun,
+                           fileCheckpointRun, checkpointFrequency);
+#endif
+            BOOST_CHECK(irun != 1);
+        }
+        catch (runtime_error &)
+        {
+            BOOST_CHECK_EQUAL(irun, 1);
+        }
+    }
+#ifdef USE_MPI
+    if (world.rank() == 0)
+#endif
+        BOOST_CHECK_EQUAL(values[0], values[2]);
+    // each step dumped once
+#ifdef USE_MPI
+    gs::BinaryFileArchive ar((fileToDump + "_" + to_string(world.rank())).c_str(), "r");
+    typedef vector< ArrayXXd > DumpedType;
+#else
+    gs::BinaryFileArchive ar(fileToDump.c_str(), "r");
+    typedef vector< GridAndRegressedValue > DumpedType;
+#endif
+    for (int iStep = 0; iStep < nStep; ++iStep)
+    {
+        BOOST_CHECK_EQUAL(gs::Reference< DumpedType >(ar, "ContinuationValues", to_string(iStep).c_str()).size(), 1u);
+        BOOST_CHECK_EQUAL(gs::Reference< DumpedType >(ar, "ContinuationControl", to_string(iStep).c_str()).size(), 1u);
+    }
+}
+
+/// copy the files of a geners archive
+void copyArchive(const string &p_from, const string &p_to)
+{
+    for (const string &suffix : {".gsbmf", ".0.gsbd"})
+    {
+        ifstream in((p_from + suffix).c_str(), ios::binary);
+        ofstream out((p_to + suffix).c_str(), ios::binary | ios::trunc);
+        out << in.rdbuf();
+    }
+}
+
+/// \brief Checkpoints left by a resolution stopped during the writing : only complete checkpoints referenced by the manifest are restored
+BOOST_AUTO_TEST_CASE(testCheckpointManifest)
+{
+    string fileCheckpoint = "CheckpointManifest";
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+    fileCheckpoint = fileCheckpoint + to_string(world.size());
+    string fileCheckpointProc = fileCheckpoint + "_" + to_string(world.rank());
+#else
+    string fileCheckpointProc = fileCheckpoint;
+#endif
+    CheckpointDP::removeFiles(fileCheckpointProc);
+    ArrayXXd particles = ArrayXXd::Random(1, 100);
+    shared_ptr<BaseRegression> regressor = make_shared<LocalLinearRegression>(ArrayXi::Constant(1, 2));
+    regressor->updateSimulations(false, particles);
+    // values of the steps 0 and 1
+    array< vector< shared_ptr< ArrayXXd > >, 2 > values;
+    for (int iStep = 0; iStep < 2; ++iStep)
+        values[iStep].push_back(make_shared<ArrayXXd>(ArrayXXd::Constant(100, 3, iStep + 1.)));
+    {
+#ifdef USE_MPI
+        CheckpointDP checkpoint(fileCheckpoint, 1, world, true);
+#else
+        CheckpointDP checkpoint(fileCheckpoint, 1);
+#endif
+        checkpoint.write(0, values[0], regressor);
+        checkpoint.write(1, values[1], regressor);
+        checkpoint.wait();
+    }
+    // stopped before the manifest of the step 2 is renamed : manifest being written ignored
+    {
+        ofstream manifestTemp((fileCheckpointProc + ".manifest.tmp").c_str());
+        manifestTemp << 2 ;
+    }
+    for (int itest = 0; itest < 2; ++itest)
+    {
+#ifdef USE_MPI
+        CheckpointDP checkpoint(fileCheckpoint, 1, world, true);
+#else
+        CheckpointDP checkpoint(fileCheckpoint, 1);
+#endif
+        vector< shared_ptr< ArrayXXd > > valuesRestored;
+        shared_ptr<BaseRegression> regressorRestored = make_shared<LocalLinearRegression>(ArrayXi::Constant(1, 2));
+        int iStep = checkpoint.restore(valuesRestored, regressorRestored);
+        // second test : the archive of the last checkpoint is replaced by the one of the step 0 (mixed files), the previous checkpoint is restored
+        int iStepExpected = 1 - itest;
+        BOOST_CHECK_EQUAL(iStep, iStepExpected);
+        BOOST_REQUIRE_EQUAL(valuesRestored.size(), 1u);
+        BOOST_CHECK((*valuesRestored[0] == *values[iStepExpected][0]).all());
+        BOOST_CHECK((regressorRestored->getParticles() == particles).all());
+        // first checkpoint in archive 0, second one in archive 1
+        copyArchive(fileCheckpointProc + ".0", fileCheckpointProc + ".1");
+    }
+    CheckpointDP::removeFiles(fileCheckpointProc);
+}
+
 // only if 64 bits
 #if UINTPTR_MAX == 0xffffffffffffffff
 BOOST_AUTO_TEST_CASE(testSwingOptionInOptimizationKernel)
@@ -419,7 +674,9 @@ BOOST_AUTO_TEST_CASE(testSwingOptionInOptimizationKernel)
 
 #ifdef USE_MPI
 /// \brief function to test stock in dimension above 1
-void testMultiStock(const int p_ndim)
+/// \param p_ndim       dimension of the stock
+/// \param p_splitting  splitting of the grid between processors
+void testMultiStock(const int p_ndim, const SplittingFunction &p_splitting = paraOptimalSplitting)
 {
     boost::mpi::communicator world;
     world.barrier();
@@ -474,7 +731,8 @@ void testMultiStock(const int p_ndim)
     bool bOneFile = false;
     // link the simulations to the optimizer
     optimizer->setSimulator(simulator);
-    double  valueParal = DynamicProgrammingByRegressionDist(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDump, bOneFile, world);
+    double  valueParal = DynamicProgrammingByRegressionDist(grid, optimizer, regressor, vFunction, initialStock, initialRegime, fileToDump, bOneFile, world,
+                         "", 1, p_splitting);
     if (world.rank() == 0)
     {
         BOOST_CHECK_CLOSE(valueSeq * p_ndim, valueParal, accuracyNearlyEqual);
@@ -492,6 +750,12 @@ BOOST_AUTO_TEST_CASE(testSwingOption3D)
     testMultiStock(3);
 }
 
+// grid split taking into account the nodes of the processors : the stock moves by one mesh at most on a step
+BOOST_AUTO_TEST_CASE(testSwingOption2DTopologySplitting)
+{
+    testMultiStock(2, TopologySplitting(ArrayXi::Constant(2, 1)));
+}
+
 
 // (empty) Initialization function. Can't use testing tools here.
 bool init_function()
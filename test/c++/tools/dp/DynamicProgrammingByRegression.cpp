@@ -7,14 +7,24 @@
 #include <boost/lexical_cast.hpp>
 #include <Eigen/Dense>
 #include "geners/BinaryFileArchive.hh"
+#include "geners/Reference.hh"
+#include "geners/vectorIO.hh"
 #include "libstoch/regression/BaseRegression.h"
+#include "libstoch/regression/GridAndRegressedValueGeners.h"
 #include "libstoch/core/grids/FullGrid.h"
 #include "libstoch/dp/FinalStepDP.h"
+#include "libstoch/dp/CheckpointDP.h"
 #include "libstoch/dp/TransitionStepRegressionDP.h"
 #include "libstoch/dp/OptimizerDPBase.h"
 
 using namespace std;
 
+/// \brief test if the continuation values of a step are already in the archive (restart after the last checkpoint)
+static bool isStepDumped(const shared_ptr<gs::BinaryFileArchive> &p_ar, const string &p_name, const int &p_iStep)
+{
+    // control values are dumped last
+    return (gs::Reference< vector< libstoch::GridAndRegressedValue > >(*p_ar, (p_name + "Control").c_str(), boost::lexical_cast<string>(p_iStep).c_str()).size() > 0);
+}
 
 double  DynamicProgrammingByRegression(const shared_ptr<libstoch::FullGrid> &p_grid,
                                        const shared_ptr<libstoch::OptimizerDPBase > &p_optimize,
@@ -26,20 +36,42 @@ double  DynamicProgrammingByRegression(const shared_ptr<libstoch::FullGrid> &p_g
 #ifdef USE_MPI
                                        , const boost::mpi::communicator &p_world
 #endif
-
-                                      )
+                                       , const string &p_fileCheckpoint,
+                                       const int &p_checkpointFrequency)
 {
     // from the optimizer get back the simulator
     shared_ptr< libstoch::SimulatorDPBase> simulator = p_optimize->getSimulator();
+    // restart from a checkpoint if any
+    shared_ptr<libstoch::CheckpointDP> checkpoint;
+    vector< shared_ptr< Eigen::ArrayXXd > >  valuesNext;
+    int iStepStart = 0;
+    if (p_fileCheckpoint.size() > 0)
+    {
+        checkpoint = make_shared<libstoch::CheckpointDP>(p_fileCheckpoint, p_checkpointFrequency
+#ifdef USE_MPI
+                     , p_world, false
+#endif
+                                                        );
+        iStepStart = checkpoint->restore(valuesNext, p_regressor) + 1;
+    }
     // final values
-    vector< shared_ptr< Eigen::ArrayXXd > >  valuesNext = libstoch::FinalStepDP(p_grid, p_optimize->getNbRegime())(p_funcFinalValue, simulator->getParticles().array());
-    shared_ptr<gs::BinaryFileArchive> ar = make_shared<gs::BinaryFileArchive>(p_fileToDump.c_str(), "w");
+    if (iStepStart == 0)
+        valuesNext = libstoch::FinalStepDP(p_grid, p_optimize->getNbRegime())(p_funcFinalValue, simulator->getParticles().array());
+    // continuation values of the steps already done are kept : the archive is appended
+    shared_ptr<gs::BinaryFileArchive> ar = make_shared<gs::BinaryFileArchive>(p_fileToDump.c_str(), (iStepStart == 0) ? "w" : "a");
     // name for object in archive
     string nameAr = "Continuation";
+#ifdef USE_MPI
+    // gathering buffer shared by the processors of a node, kept between time steps
+    shared_ptr< libstoch::NodeSharedArray<double> > storeShared;
+#endif
     // iterate on time steps
     for (int iStep = 0; iStep < simulator->getNbStep(); ++iStep)
     {
         Eigen::ArrayXXd asset = simulator->stepBackwardAndGetParticles();
+        // step already done
+        if (iStep < iStepStart)
+            continue;
         // conditional expectation operator
         p_regressor->updateSimulations(((iStep == (simulator->getNbStep() - 1)) ? true : false), asset);
         // transition object
@@ -48,11 +80,21 @@ double  DynamicProgrammingByRegression(const shared_ptr<libstoch::FullGrid> &p_g
                 , p_world
 #endif
                                                    );
+#ifdef USE_MPI
+        transStep.setStoreShared(storeShared);
+#endif
 
         pair< vector< shared_ptr< Eigen::ArrayXXd > >, vector< shared_ptr< Eigen::ArrayXXd > > > valuesAndControl = transStep.oneStep(valuesNext, p_regressor);
-        // dump continuation values
-        transStep.dumpContinuationValues(ar, nameAr, iStep, valuesNext, valuesAndControl.second, p_regressor);
+#ifdef USE_MPI
+        storeShared = transStep.getStoreShared();
+#endif
+        // dump continuation values (steps done after the last checkpoint are already dumped)
+        if ((iStepStart == 0) || !isStepDumped(ar, nameAr, iStep))
+            transStep.dumpContinuationValues(ar, nameAr, iStep, valuesNext, valuesAndControl.second, p_regressor);
         valuesNext = valuesAndControl.first;
+        // checkpoint after the continuation values are dumped
+        if (checkpoint)
+            checkpoint->write(iStep, valuesNext, p_regressor);
     }
     // interpolate at the initial stock point and initial regime
     return (p_grid->createInterpolator(p_pointStock)->applyVec(*valuesNext[p_initialRegime])).mean();
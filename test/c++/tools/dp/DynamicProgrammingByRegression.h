@@ -28,6 +28,9 @@
 /// \param p_initialRegime     regime at initial date
 /// \param p_fileToDump        file to dump continuation values
 /// \param p_world             MPI communicator
+/// \param p_fileCheckpoint    file for checkpoints (no checkpoint if empty) : if a checkpoint exists, the resolution restarts after the last step checkpointed
+///                            and appends to p_fileToDump the steps not yet dumped
+/// \param p_checkpointFrequency  a checkpoint is written every p_checkpointFrequency steps
 ///
 double  DynamicProgrammingByRegression(const std::shared_ptr<libstoch::FullGrid> &p_grid,
                                        const std::shared_ptr<libstoch::OptimizerDPBase > &p_optimize,
@@ -39,6 +42,7 @@ double  DynamicProgrammingByRegression(const std::shared_ptr<libstoch::FullGrid>
 #ifdef USE_MPI
                                        , const boost::mpi::communicator &p_world
 #endif
-                                      );
+                                       , const std::string &p_fileCheckpoint = "",
+                                       const int &p_checkpointFrequency = 1);
 
 #endif /* DYNAMICPROGRAMMINGBYREGRESSION_H */
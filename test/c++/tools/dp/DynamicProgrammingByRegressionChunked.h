@@ -0,0 +1,46 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef DYNAMICPROGRAMMINGBYREGRESSIONCHUNKED_H
+#define DYNAMICPROGRAMMINGBYREGRESSIONCHUNKED_H
+#include <fstream>
+#include <memory>
+#include <functional>
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#include <Eigen/Dense>
+#include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/dp/OptimizerDPBase.h"
+
+/* \file DynamicProgrammingByRegressionChunked.h
+ * \brief Defines a simple  programm  showing how to optimize a problem by dynamic programming
+ *        A simple grid  is used, continuation values are dumped by blocks of grid points in a compressed archive
+ * \author Xavier Warin
+ */
+
+/// \brief Principal function to optimize  a problem
+/// \param p_grid             grid used for  deterministic state (stocks for example)
+/// \param p_optimize          optimizer defining the optimisation between two time steps
+/// \param p_regressor         regressor object
+/// \param p_funcFinalValue    function defining the final value
+/// \param p_pointStock        point stock used for interpolation at initial date
+/// \param p_initialRegime     regime at initial date
+/// \param p_fileToDump        file to dump continuation values
+/// \param p_chunkSize         number of meshes of a block of continuation values in each dimension
+/// \param p_world             MPI communicator
+///
+double  DynamicProgrammingByRegressionChunked(const std::shared_ptr<libstoch::FullGrid> &p_grid,
+                                              const std::shared_ptr<libstoch::OptimizerDPBase > &p_optimize,
+                                              const std::shared_ptr<libstoch::BaseRegression> &p_regressor,
+                                              const std::function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>   &p_funcFinalValue,
+                                              const Eigen::ArrayXd &p_pointStock,
+                                              const int &p_initialRegime,
+                                              const std::string   &p_fileToDump,
+                                              const Eigen::ArrayXi &p_chunkSize
+#ifdef USE_MPI
+                                              , const boost::mpi::communicator &p_world
+#endif
+                                             );
+
+#endif /* DYNAMICPROGRAMMINGBYREGRESSIONCHUNKED_H */
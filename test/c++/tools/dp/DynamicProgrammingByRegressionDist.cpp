@@ -9,9 +9,14 @@
 #include <boost/mpi.hpp>
 #include <Eigen/Dense>
 #include "geners/BinaryFileArchive.hh"
+#include "geners/Reference.hh"
+#include "geners/vectorIO.hh"
+#include "libstoch/core/utils/eigenGeners.h"
+#include "libstoch/regression/GridAndRegressedValueGeners.h"
 #include "libstoch/core/grids/FullGrid.h"
 #include "libstoch/regression/BaseRegression.h"
 #include "libstoch/dp/FinalStepDPDist.h"
+#include "libstoch/dp/CheckpointDP.h"
 #include "libstoch/dp/TransitionStepRegressionDPDist.h"
 #include "libstoch/core/parallelism/reconstructProc0Mpi.h"
 #include "libstoch/dp/OptimizerDPBase.h"
@@ -20,6 +25,29 @@
 
 using namespace std;
 
+/// \brief test if the continuation values of a step are already in the archive (restart after the last checkpoint)
+/// \param p_ar        archive (null on processors not writing)
+/// \param p_name      name of the continuation values
+/// \param p_iStep     step
+/// \param p_bOneFile  true if processor 0 dumps gathered values
+/// \param p_world     MPI communicator
+static bool isStepDumped(const shared_ptr<gs::BinaryFileArchive> &p_ar, const string &p_name, const int &p_iStep, const bool &p_bOneFile,
+                         const boost::mpi::communicator &p_world)
+{
+    string stepString = boost::lexical_cast<string>(p_iStep);
+    // control values are dumped last
+    int bDumped = 0;
+    if (p_bOneFile)
+    {
+        // the dump is collective : processor 0 decides
+        if (p_world.rank() == 0)
+            bDumped = (gs::Reference< vector< libstoch::GridAndRegressedValue > >(*p_ar, (p_name + "Control").c_str(), stepString.c_str()).size() > 0);
+        boost::mpi::broadcast(p_world, bDumped, 0);
+    }
+    else
+        bDumped = (gs::Reference< vector< Eigen::ArrayXXd > >(*p_ar, (p_name + "Control").c_str(), stepString.c_str()).size() > 0);
+    return bDumped;
+}
 double  DynamicProgrammingByRegressionDist(const shared_ptr<libstoch::FullGrid> &p_grid,
         const shared_ptr<libstoch::OptimizerDPBase > &p_optimize,
         shared_ptr<libstoch::BaseRegression> &p_regressor,
@@ -28,12 +56,25 @@ double  DynamicProgrammingByRegressionDist(const shared_ptr<libstoch::FullGrid>
         const int &p_initialRegime,
         const string   &p_fileToDump,
         const bool &p_bOneFile,
-        const boost::mpi::communicator &p_world)
+        const boost::mpi::communicator &p_world,
+        const string &p_fileCheckpoint,
+        const int &p_checkpointFrequency,
+        const libstoch::SplittingFunction &p_splitting)
 {
     // from the optimizer get back the simulator
     shared_ptr< libstoch::SimulatorDPBase> simulator = p_optimize->getSimulator();
+    // restart from a checkpoint if any (values are distributed)
+    shared_ptr<libstoch::CheckpointDP> checkpoint;
+    vector< shared_ptr< Eigen::ArrayXXd > >  valuesNext;
+    int iStepStart = 0;
+    if (p_fileCheckpoint.size() > 0)
+    {
+        checkpoint = make_shared<libstoch::CheckpointDP>(p_fileCheckpoint, p_checkpointFrequency, p_world, true);
+        iStepStart = checkpoint->restore(valuesNext, p_regressor) + 1;
+    }
     // final values
-    vector< shared_ptr< Eigen::ArrayXXd > >  valuesNext = libstoch::FinalStepDPDist(p_grid, p_optimize->getNbRegime(), p_optimize->getDimensionToSplit(), p_world)(p_funcFinalValue, simulator->getParticles().array());
+    if (iStepStart == 0)
+        valuesNext = libstoch::FinalStepDPDist(p_grid, p_optimize->getNbRegime(), p_optimize->getDimensionToSplit(), p_world, p_splitting)(p_funcFinalValue, simulator->getParticles().array());
     // dump
     string toDump = p_fileToDump ;
     // test if one file generated
@@ -41,22 +82,34 @@ double  DynamicProgrammingByRegressionDist(const shared_ptr<libstoch::FullGrid>
         toDump +=  "_" + boost::lexical_cast<string>(p_world.rank());
     shared_ptr<gs::BinaryFileArchive> ar;
     if ((!p_bOneFile) || (p_world.rank() == 0))
-        ar = make_shared<gs::BinaryFileArchive>(toDump.c_str(), "w");
+        ar = make_shared<gs::BinaryFileArchive>(toDump.c_str(), (iStepStart == 0) ? "w" : "a"); // steps already done are kept
     // name for object in archive
     string nameAr = "Continuation";
     for (int iStep = 0; iStep < simulator->getNbStep(); ++iStep)
     {
         Eigen::ArrayXXd asset = simulator->stepBackwardAndGetParticles();
+        // step already done
+        if (iStep < iStepStart)
+            continue;
         // conditional expectation operator
         p_regressor->updateSimulations(((iStep == (simulator->getNbStep() - 1)) ? true : false), asset);
         // transition object
-        libstoch::TransitionStepRegressionDPDist transStep(p_grid, p_grid, p_optimize, p_world);
+        libstoch::TransitionStepRegressionDPDist transStep(p_grid, p_grid, p_optimize, p_world, p_splitting);
         pair< vector< shared_ptr< Eigen::ArrayXXd > >, vector< shared_ptr< Eigen::ArrayXXd > > > valuesAndControl  = transStep.oneStep(valuesNext, p_regressor);
-        transStep.dumpContinuationValues(ar, nameAr, iStep, valuesNext, valuesAndControl.second, p_regressor, p_bOneFile);
+        // dump continuation values (steps done after the last checkpoint are already dumped)
+        if ((iStepStart == 0) || !isStepDumped(ar, nameAr, iStep, p_bOneFile, p_world))
+            transStep.dumpContinuationValues(ar, nameAr, iStep, valuesNext, valuesAndControl.second, p_regressor, p_bOneFile);
         valuesNext = valuesAndControl.first;
+        // checkpoint after the continuation values are dumped and flushed
+        if (checkpoint)
+        {
+            if (ar)
+                ar->flush();
+            checkpoint->write(iStep, valuesNext, p_regressor);
+        }
     }
     // reconstruct a small grid for interpolation
-    return libstoch::reconstructProc0Mpi(p_pointStock, p_grid, valuesNext[p_initialRegime], p_optimize->getDimensionToSplit(), p_world).mean();
+    return libstoch::reconstructProc0Mpi(p_pointStock, p_grid, valuesNext[p_initialRegime], p_optimize->getDimensionToSplit(), p_world, p_splitting).mean();
 
 }
 #endif
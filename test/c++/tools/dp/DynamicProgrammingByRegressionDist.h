@@ -9,6 +9,7 @@
 #include <boost/mpi.hpp>
 #include <Eigen/Dense>
 #include "libstoch/core/grids/SpaceGrid.h"
+#include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
 #include "libstoch/dp/OptimizerDPBase.h"
 
 /* \file DynamicProgrammingByRegressionDist.h
@@ -28,6 +29,10 @@
 /// \param p_fileToDump            file to dump continuation values
 /// \param p_bOneFile              do we store continuation values  in only one file
 /// \param p_world             MPI communicator
+/// \param p_fileCheckpoint    file for checkpoints (no checkpoint if empty) : if a checkpoint exists, the resolution restarts after the last step checkpointed
+///                            and appends to p_fileToDump the steps not yet dumped
+/// \param p_checkpointFrequency  a checkpoint is written every p_checkpointFrequency steps
+/// \param p_splitting         splitting of the grid between processors (for example libstoch::TopologySplitting)
 ///
 double  DynamicProgrammingByRegressionDist(const std::shared_ptr<libstoch::FullGrid> &p_grid,
         const std::shared_ptr<libstoch::OptimizerDPBase > &p_optimize,
@@ -37,6 +42,9 @@ double  DynamicProgrammingByRegressionDist(const std::shared_ptr<libstoch::FullG
         const int &p_initialRegime,
         const std::string   &p_fileToDump,
         const bool &p_bOneFile,
-        const boost::mpi::communicator &p_world);
+        const boost::mpi::communicator &p_world,
+        const std::string &p_fileCheckpoint = "",
+        const int &p_checkpointFrequency = 1,
+        const libstoch::SplittingFunction &p_splitting = libstoch::paraOptimalSplitting);
 
 #endif /* DYNAMICPROGRAMMINGBYREGRESSIONDIST_H */
@@ -30,9 +30,10 @@ double  DynamicProgrammingByRegressionMultiStage(const shared_ptr<libstoch::Full
 #ifdef USE_MPI
         , const boost::mpi::communicator &p_world
 #endif
-
-                                                )
+        , const bool &p_bDistributedStages,
+        long &p_nbBytesSaved)
 {
+    p_nbBytesSaved = 0;
     // from the optimizer get back the simulator
     shared_ptr< libstoch::SimulatorMultiStageDPBase> simulator = p_optimize->getSimulator();
     // final values
@@ -55,8 +56,11 @@ double  DynamicProgrammingByRegressionMultiStage(const shared_ptr<libstoch::Full
                 , p_world
 #endif
                                                              );
+        transStep.setDistributedStages(p_bDistributedStages);
 
-        vector< shared_ptr< Eigen::ArrayXXd > > values = transStep.oneStep(valuesNext, p_regressor);
+        long nbBytesSaved = 0;
+        vector< shared_ptr< Eigen::ArrayXXd > > values = transStep.oneStep(valuesNext, p_regressor, nbBytesSaved);
+        p_nbBytesSaved += nbBytesSaved;
         // dump continuation values stochastic only
         transStep.dumpContinuationValues(ar, nameAr, iStep, valuesNext,  p_regressor);
         valuesNext = values;
@@ -64,3 +68,23 @@ double  DynamicProgrammingByRegressionMultiStage(const shared_ptr<libstoch::Full
     // interpolate at the initial stock point and initial regime
     return (p_grid->createInterpolator(p_pointStock)->applyVec(*valuesNext[p_initialRegime])).mean();
 }
+
+double  DynamicProgrammingByRegressionMultiStage(const shared_ptr<libstoch::FullGrid> &p_grid,
+        const shared_ptr<libstoch::OptimizerMultiStageDPBase > &p_optimize,
+        const shared_ptr<libstoch::BaseRegression> &p_regressor,
+        const function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>  &p_funcFinalValue,
+        const Eigen::ArrayXd &p_pointStock,
+        const int &p_initialRegime,
+        const string   &p_fileToDump
+#ifdef USE_MPI
+        , const boost::mpi::communicator &p_world
+#endif
+        , const bool &p_bDistributedStages)
+{
+    long nbBytesSaved = 0;
+    return DynamicProgrammingByRegressionMultiStage(p_grid, p_optimize, p_regressor, p_funcFinalValue, p_pointStock, p_initialRegime, p_fileToDump
+#ifdef USE_MPI
+            , p_world
+#endif
+            , p_bDistributedStages, nbBytesSaved);
+}
@@ -29,6 +29,7 @@
 /// \param p_initialRegime     regime at initial date
 /// \param p_fileToDump        file to dump continuation values
 /// \param p_world             MPI communicator
+/// \param p_bDistributedStages if true, values stay distributed between the deterministic stages of a step
 ///
 double  DynamicProgrammingByRegressionMultiStage(const std::shared_ptr<libstoch::FullGrid> &p_grid,
         const std::shared_ptr<libstoch::OptimizerMultiStageDPBase > &p_optimize,
@@ -40,6 +41,21 @@ double  DynamicProgrammingByRegressionMultiStage(const std::shared_ptr<libstoch:
 #ifdef USE_MPI
         , const boost::mpi::communicator &p_world
 #endif
-                                                );
+        , const bool &p_bDistributedStages = false);
+
+/// \brief Same as previous function, returning the bytes saved by keeping values distributed between stages
+/// \param p_nbBytesSaved   bytes not received by the processor for all steps compared to a gathering of values at each stage
+double  DynamicProgrammingByRegressionMultiStage(const std::shared_ptr<libstoch::FullGrid> &p_grid,
+        const std::shared_ptr<libstoch::OptimizerMultiStageDPBase > &p_optimize,
+        const std::shared_ptr<libstoch::BaseRegression> &p_regressor,
+        const std::function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>   &p_funcFinalValue,
+        const Eigen::ArrayXd &p_pointStock,
+        const int &p_initialRegime,
+        const std::string   &p_fileToDump
+#ifdef USE_MPI
+        , const boost::mpi::communicator &p_world
+#endif
+        , const bool &p_bDistributedStages,
+        long &p_nbBytesSaved);
 
 #endif /* DYNAMICPROGRAMMINGBYREGRESSIONMULTISTAGE_H */
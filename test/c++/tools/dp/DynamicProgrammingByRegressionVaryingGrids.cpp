@@ -48,6 +48,10 @@ double  DynamicProgrammingByRegressionVaryingGrids(const vector<double>    &p_ti
     shared_ptr<gs::BinaryFileArchive> ar = make_shared<gs::BinaryFileArchive>(p_fileToDump.c_str(), "w");
     // name for object in archive
     string nameAr = "Continuation";
+#ifdef USE_MPI
+    // gathering buffer shared by the processors of a node, kept between time steps
+    shared_ptr< libstoch::NodeSharedArray<double> > storeShared;
+#endif
     // iterate on time steps
     for (int iStep = 0; iStep < simulator->getNbStep(); ++iStep)
     {
@@ -65,8 +69,14 @@ double  DynamicProgrammingByRegressionVaryingGrids(const vector<double>    &p_ti
                 , p_world
 #endif
                                                    );
+#ifdef USE_MPI
+        transStep.setStoreShared(storeShared);
+#endif
 
         pair< vector< shared_ptr< Eigen::ArrayXXd > >, vector< shared_ptr< Eigen::ArrayXXd > > > valuesAndControl =  transStep.oneStep(valuesNext, p_regressor);
+#ifdef USE_MPI
+        storeShared = transStep.getStoreShared();
+#endif
         // dump continuation values
         transStep.dumpContinuationValues(ar, nameAr, iStep, valuesNext, valuesAndControl.second, p_regressor);
         valuesNext =  valuesAndControl.first;
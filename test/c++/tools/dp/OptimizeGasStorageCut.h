@@ -45,9 +45,18 @@ public :
     /// \param  p_withdrawalRate    withdrawal rate between two time steps
     /// \param  p_injectionCost     injection cost
     /// \param  p_withdrawalCost    withdrawal cost
+    /// \param  p_bReuseLP          if true, LP are kept between resolutions and warm started
     OptimizeGasStorageCut(const double   &p_injectionRate, const double &p_withdrawalRate,
-                          const double &p_injectionCost, const double &p_withdrawalCost):
-        OptimizeGasStorageCutBase(p_injectionRate, p_withdrawalRate, p_injectionCost, p_withdrawalCost)  {}
+                          const double &p_injectionCost, const double &p_withdrawalCost,
+                          const bool &p_bReuseLP = false):
+        OptimizeGasStorageCutBase(p_injectionRate, p_withdrawalRate, p_injectionCost, p_withdrawalCost)
+    {
+        if (p_bReuseLP)
+        {
+            // Bellman variable in column 3, storage level in column 2, maximization : cuts are upper bounds
+            setLPWorkspace(std::make_shared<libstoch::LPWorkspace>(3, Eigen::ArrayXi::Constant(1, 2), false, false));
+        }
+    }
 
     /// \brief define the diffusion cone for parallelism (not needed if not parallelism required )
     /// \param  p_regionByProcessor         region (min max) treated by the processor for the different regimes treated
@@ -114,7 +123,7 @@ public :
                 cutsASim.row(ic) = cuts.row(is + ic * nbSimul);
 
             // Solve LP
-            createAndSolveLP(cutsASim, p_stock(0), p_grid, spotPrice(is), valueAndDerivatives, stateFollowing, gain);
+            createAndSolveLP(cutsASim, p_stock(0), p_grid, spotPrice(is), valueAndDerivatives, stateFollowing, gain, m_lpWorkspace);
 
             // copy
             for (int ic = 0; ic <  nbDimCut; ++ic)
@@ -172,7 +181,7 @@ public :
         Eigen::ArrayXd stateFollowing(p_grid->getDimension());
         double gain ;
         // Solve LP
-        createAndSolveLP(cuts, storageInit, p_grid, spotPrice, valueAndDerivatives, stateFollowing, gain);
+        createAndSolveLP(cuts, storageInit, p_grid, spotPrice, valueAndDerivatives, stateFollowing, gain, m_lpWorkspace);
 
         // for return
         p_state.setPtStock(stateFollowing);
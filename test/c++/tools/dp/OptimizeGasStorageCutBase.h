@@ -5,6 +5,7 @@
 #include <memory>
 #include <Eigen/Dense>
 #include "libstoch/core/grids/SpaceGrid.h"
+#include "libstoch/sddp/LPWorkspace.h"
 
 /** \file OptimizeGasStorageCutBase.h
  *  \brief  Simple example of a gas storage optimizer
@@ -52,13 +53,15 @@ public :
     ///  \param p_valueAndDerivatives  function value and derivative for current simulation
     ///  \param p_stateFollowing storage reached
     ///  \param p_gain           gain reached
+    ///  \param p_lpWorkspace    if not null, LP kept between resolutions (only bounds and cuts are updated)
     void   createAndSolveLP(const Eigen::ArrayXXd &p_cuts,
                             const double   &p_stock,
                             const   std::shared_ptr< libstoch::SpaceGrid> &p_grid,
                             const double &p_spot,
                             Eigen::ArrayXd &p_valueAndDerivatives,
                             Eigen::ArrayXd &p_stateFollowing,
-                            double &p_gain) const
+                            double &p_gain,
+                            const std::shared_ptr< libstoch::LPWorkspace > &p_lpWorkspace = std::shared_ptr< libstoch::LPWorkspace >()) const
     {
         // bound for storage
         std::vector <std::array< double, 2>  > extremVal = p_grid->getExtremeValues();
@@ -102,6 +105,28 @@ public :
         lowBoundConst(0) = p_stock;
         upperBoundConst(0) = p_stock;
 
+        if (p_lpWorkspace)
+        {
+            if (!p_lpWorkspace->isInitialized())
+                p_lpWorkspace->loadStructure(rows.head(3), columns.head(3), elements.head(3), lowBound.head(4), upperBound.head(4), objFunc,
+                                             lowBoundConst.head(1), upperBoundConst.head(1));
+            else
+                p_lpWorkspace->updateStructure(lowBound.head(4), upperBound.head(4), objFunc, lowBoundConst.head(1), upperBoundConst.head(1));
+            // only positive derivatives are kept
+            Eigen::ArrayXXd cutsPos(p_cuts);
+            if (cutsPos.cols() > 0)
+                cutsPos.row(1) = cutsPos.row(1).max(0.);
+            p_lpWorkspace->setCuts(cutsPos);
+            bool modelSolved = p_lpWorkspace->solve();
+            getSolution(p_lpWorkspace->getModel(), p_stock, p_spot, p_valueAndDerivatives, p_stateFollowing, p_gain);
+            if (!modelSolved)
+            {
+                std::cout << "[problemLP::solveModel] : Warning Linear program could not be solved optimally somehow\n";
+                abort();
+            }
+            return;
+        }
+
         // add cuts
         for (int icut = 0; icut < p_cuts.cols(); ++icut)
         {
@@ -135,27 +160,39 @@ public :
 
         bool modelSolved = model.isProvenOptimal();
 
+        getSolution(model, p_stock, p_spot, p_valueAndDerivatives, p_stateFollowing, p_gain);
 
+        if (!modelSolved)
+        {
+            std::cout << "[problemLP::solveModel] : Warning Linear program could not be solved optimally somehow\n";
+            abort();
+        }
+    }
+
+    ///  \brief get back LP solution
+    ///  \param p_model         solved LP
+    ///  \param p_stock         current stock level
+    ///  \param p_spot          spot price
+    ///  \param p_valueAndDerivatives  function value and derivative for current simulation
+    ///  \param p_stateFollowing storage reached
+    ///  \param p_gain           gain reached
+    void getSolution(const ClpSimplex &p_model, const double   &p_stock, const double &p_spot,
+                     Eigen::ArrayXd &p_valueAndDerivatives, Eigen::ArrayXd &p_stateFollowing, double &p_gain) const
+    {
         // optimal values
-        p_valueAndDerivatives(0) = model.objectiveValue();
+        p_valueAndDerivatives(0) = p_model.objectiveValue();
 
         // duals
-        double *dual = model.dualRowSolution();
+        const double *dual = p_model.dualRowSolution();
         p_valueAndDerivatives(1) = dual[0];
 
         // primal
-        double *columnPrimal = model.primalColumnSolution();
+        const double *columnPrimal = p_model.primalColumnSolution();
         // for each stock
         p_stateFollowing(0) = p_stock + columnPrimal[0] + columnPrimal[1];
 
         // gain
         p_gain =  - (p_spot + m_injectionCost) * columnPrimal[0] - (p_spot - m_withdrawalCost) * columnPrimal[1];
-
-        if (!modelSolved)
-        {
-            std::cout << "[problemLP::solveModel] : Warning Linear program could not be solved optimally somehow\n";
-            abort();
-        }
     }
 
 }
@@ -46,8 +46,17 @@ public :
     /// \param  p_withdrawalRate    withdrawal rate between two time steps
     /// \param  p_injectionCost     injection cost
     /// \param  p_withdrawalCost    withdrawal cost
+    /// \param  p_bReuseLP          if true, LP are kept between resolutions and warm started
     OptimizeGasStorageTreeCut(const double   &p_injectionRate, const double &p_withdrawalRate,
-                              const double &p_injectionCost, const double &p_withdrawalCost):    OptimizeGasStorageCutBase(p_injectionRate, p_withdrawalRate, p_injectionCost, p_withdrawalCost)  {}
+                              const double &p_injectionCost, const double &p_withdrawalCost,
+                              const bool &p_bReuseLP = false):    OptimizeGasStorageCutBase(p_injectionRate, p_withdrawalRate, p_injectionCost, p_withdrawalCost)
+    {
+        if (p_bReuseLP)
+        {
+            // Bellman variable in column 3, storage level in column 2, maximization : cuts are upper bounds
+            setLPWorkspace(std::make_shared<libstoch::LPWorkspace>(3, Eigen::ArrayXi::Constant(1, 2), false, false));
+        }
+    }
 
 
 
@@ -96,13 +105,13 @@ public :
         hyperCube(0, 0) = p_stock(0) - withdrawalMax;
         hyperCube(0, 1) =  p_stock(0) + injectionMax;
         // get back cuts for all simulatons  \f$ \hat a_0 + \sum_{i=1}^d a_i x_i\f$
-        Eigen::ArrayXXd  cuts = p_condEsp[0].getCutsAllNodes(hyperCube);
+        std::shared_ptr<const Eigen::ArrayXXd>  cuts = p_condEsp[0].getCutsAllNodes(hyperCube);
         // nb cuts
         int nbDimCut = p_grid->getDimension() + 1;
         // solution for return (only one regime)
         Eigen::ArrayXXd solution(nbDimCut * nbNodes, 1);
         // cuts for on simulation
-        Eigen::ArrayXXd cutsASim(nbDimCut, cuts.cols());
+        Eigen::ArrayXXd cutsASim(nbDimCut, cuts->cols());
         // to store vales and derivatives
         Eigen::ArrayXd valueAndDerivatives(nbDimCut);
         Eigen::ArrayXd stateFollowing(p_stock.size());
@@ -111,10 +120,10 @@ public :
         for (int is  = 0; is < nbNodes; ++is)
         {
             for (int ic = 0; ic <  nbDimCut; ++ic)
-                cutsASim.row(ic) = cuts.row(is + ic * nbNodes);
+                cutsASim.row(ic) = cuts->row(is + ic * nbNodes);
 
             // Solve LP
-            createAndSolveLP(cutsASim, p_stock(0), p_grid, spotPrice(is), valueAndDerivatives, stateFollowing, gain);
+            createAndSolveLP(cutsASim, p_stock(0), p_grid, spotPrice(is), valueAndDerivatives, stateFollowing, gain, m_lpWorkspace);
 
             // copy
             for (int ic = 0; ic <  nbDimCut; ++ic)
@@ -164,7 +173,7 @@ public :
         hyperCube(0, 0) = storageInit - withdrawalMax;
         hyperCube(0, 1) =  storageInit + injectionMax;
         // get back cuts for all simulatons  \f$ \hat a_0 + \sum_{i=1}^d a_i x_i\f$
-        Eigen::ArrayXXd  cuts = p_continuation[0].getCutsANode(hyperCube, p_state.getStochasticRealization());
+        std::shared_ptr<const Eigen::ArrayXXd>  cuts = p_continuation[0].getCutsANode(hyperCube, p_state.getStochasticRealization());
         // nb cuts
         int nbDimCut = p_grid->getDimension() + 1;
         // to store vales and derivatives
@@ -172,7 +181,7 @@ public :
         Eigen::ArrayXd stateFollowing(p_grid->getDimension());
         double gain ;
         // Solve LP
-        createAndSolveLP(cuts, storageInit, p_grid, spotPrice, valueAndDerivatives, stateFollowing, gain);
+        createAndSolveLP(*cuts, storageInit, p_grid, spotPrice, valueAndDerivatives, stateFollowing, gain, m_lpWorkspace);
 
         // for return
         p_state.setPtStock(stateFollowing);
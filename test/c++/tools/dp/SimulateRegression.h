@@ -14,6 +14,7 @@
 #include "libstoch/core/grids/SpaceGrid.h"
 #include "libstoch/regression/BaseRegression.h"
 #include "libstoch/dp/SimulateStepRegression.h"
+#include "libstoch/dp/SimulateStepPipeline.h"
 #include "libstoch/dp/OptimizerDPBase.h"
 #include "libstoch/dp/SimulatorDPBase.h"
 
@@ -55,14 +56,27 @@ double SimulateRegression(const std::shared_ptr<libstoch::SpaceGrid> &p_grid,
     std::string nameAr = "Continuation";
     // cost function
     Eigen::ArrayXXd costFunction = Eigen::ArrayXXd::Zero(p_optimize->getSimuFuncSize(), simulator->getNbSimul());
-    // iterate on time steps
-    for (int istep = 0; istep < nbStep; ++istep)
+    // continuation values of the following step are read while the current step is simulated
+    libstoch::SimulateStepPipeline< libstoch::SimulateStepRegression > pipeline([&](const int &p_istep
+#ifdef USE_MPI
+            , const boost::mpi::communicator &p_comm
+#endif
+                                                                                  )
     {
-        libstoch::SimulateStepRegression(ar, nbStep - 1 - istep, nameAr, p_grid, p_optimize
+        return std::make_shared<libstoch::SimulateStepRegression>(ar, nbStep - 1 - p_istep, nameAr, p_grid, p_optimize
 #ifdef USE_MPI
-                                      , p_world
+                , p_comm
 #endif
-                                     ).oneStep(states, costFunction);
+                                                                 );
+    }, nbStep
+#ifdef USE_MPI
+    , p_world
+#endif
+                                                                                );
+    // iterate on time steps
+    for (int istep = 0; istep < nbStep; ++istep)
+    {
+        pipeline.next()->oneStep(states, costFunction);
         // new stochastic state
         Eigen::ArrayXXd particles =  simulator->stepForwardAndGetParticles();
         for (int is = 0; is < simulator->getNbSimul(); ++is)
@@ -0,0 +1,86 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef SIMULATEREGRESSIONCONTROLCHUNKED_H
+#define SIMULATEREGRESSIONCONTROLCHUNKED_H
+#include <Eigen/Dense>
+#include <functional>
+#include <memory>
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#include "geners/BinaryFileArchive.hh"
+#include "libstoch/core/utils/StateWithStocks.h"
+#include "libstoch/core/grids/FullGrid.h"
+#include "libstoch/regression/BaseRegression.h"
+#include "libstoch/dp/SimulateStepRegressionControl.h"
+#include "libstoch/dp/OptimizerBaseInterp.h"
+#include "libstoch/dp/SimulatorDPBase.h"
+
+
+/** \file SimulateRegressionControlChunked.h
+ *  \brief Defines a simple program showing how to use simulations
+ *        A simple grid  is used, optimal controls are read by blocks around the simulated stocks
+ *  \author Xavier Warin
+ */
+
+/// \brief Simulate the optimal strategy , version using optimal controls dumped by blocks
+/// \param p_grid                   grid used for  deterministic state (stocks for example)
+/// \param p_optimize               optimizer defining the optimization between two time steps
+/// \param p_funcFinalValue         function defining the final value
+/// \param p_pointStock             initial point stock
+/// \param p_initialRegime          regime at initial date
+/// \param p_fileToDump             name of the file used to dump continuation values in optimization
+/// \param p_nbChunkRead            number of blocks read for all steps
+/// \param p_nbChunk                number of blocks dumped for all steps
+/// \param p_world                  MPI communicator
+double SimulateRegressionControlChunked(const std::shared_ptr<libstoch::FullGrid> &p_grid,
+                                        const std::shared_ptr<libstoch::OptimizerBaseInterp > &p_optimize,
+                                        const std::function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>   &p_funcFinalValue,
+                                        const Eigen::ArrayXd &p_pointStock,
+                                        const int &p_initialRegime,
+                                        const std::string   &p_fileToDump,
+                                        int &p_nbChunkRead,
+                                        int &p_nbChunk
+#ifdef USE_MPI
+                                        , const boost::mpi::communicator &p_world
+#endif
+                                       )
+{
+    // from the optimizer get back the simulator
+    std::shared_ptr< libstoch::SimulatorDPBase> simulator = p_optimize->getSimulator();
+    int nbStep = simulator->getNbStep();
+    std::vector< libstoch::StateWithStocks> states;
+    states.reserve(simulator->getNbSimul());
+    for (int is = 0; is < simulator->getNbSimul(); ++is)
+        states.push_back(libstoch::StateWithStocks(p_initialRegime, p_pointStock, Eigen::ArrayXd::Zero(simulator->getDimension())));
+    gs::BinaryFileArchive ar(p_fileToDump.c_str(), "r");
+    // name for continuation object in archive
+    std::string nameAr = "Continuation";
+    // cost function
+    Eigen::ArrayXXd costFunction = Eigen::ArrayXXd::Zero(p_optimize->getSimuFuncSize(), simulator->getNbSimul());
+    p_nbChunkRead = 0;
+    p_nbChunk = 0;
+    // iterate on time steps
+    for (int istep = 0; istep < nbStep; ++istep)
+    {
+        libstoch::SimulateStepRegressionControl simStep(ar, nbStep - 1 - istep, nameAr, p_grid, p_optimize, true
+#ifdef USE_MPI
+                , p_world
+#endif
+                                                       );
+        simStep.oneStep(states, costFunction);
+        p_nbChunkRead += simStep.getChunked()->getNbChunkRead();
+        p_nbChunk += simStep.getChunked()->getNbChunk();
+        // new stochastic state
+        Eigen::ArrayXXd particles =  simulator->stepForwardAndGetParticles();
+        for (int is = 0; is < simulator->getNbSimul(); ++is)
+            states[is].setStochasticRealization(particles.col(is));
+    }
+    // final : accept to exercise if not already done entirely (here suppose one function to follow)
+    for (int is = 0; is < simulator->getNbSimul(); ++is)
+        costFunction(0, is) += p_funcFinalValue(states[is].getRegime(), states[is].getPtStock(), states[is].getStochasticRealization()) * simulator->getActu();
+    // average gain/cost
+    return costFunction.mean();
+}
+#endif /* SIMULATEREGRESSIONCONTROLCHUNKED_H */
@@ -31,6 +31,7 @@
 /// \param p_fileToDump             name associated to dumped bellman values
 /// \param p_bOneFile               do we store continuation values  in only one file
 /// \param p_world                  MPI communicator
+/// \param p_splitting              splitting of the grid between processors (the same as the one used in optimization)
 double SimulateRegressionDist(const std::shared_ptr<libstoch::FullGrid> &p_grid,
                               const std::shared_ptr<libstoch::OptimizerDPBase > &p_optimize,
                               const std::function<double(const int &, const Eigen::ArrayXd &, const Eigen::ArrayXd &)>  &p_funcFinalValue,
@@ -38,7 +39,8 @@ double SimulateRegressionDist(const std::shared_ptr<libstoch::FullGrid> &p_grid,
                               const int &p_initialRegime,
                               const std::string   &p_fileToDump,
                               const bool &p_bOneFile,
-                              const boost::mpi::communicator &p_world)
+                              const boost::mpi::communicator &p_world,
+                              const libstoch::SplittingFunction &p_splitting = libstoch::paraOptimalSplitting)
 {
     // from the optimizer get back the simulator
     std::shared_ptr< libstoch::SimulatorDPBase> simulator = p_optimize->getSimulator();
@@ -58,7 +60,7 @@ double SimulateRegressionDist(const std::shared_ptr<libstoch::FullGrid> &p_grid,
     Eigen::ArrayXXd costFunction = Eigen::ArrayXXd::Zero(p_optimize->getSimuFuncSize(), simulator->getNbSimul());
     for (int istep = 0; istep < nbStep; ++istep)
     {
-        libstoch::SimulateStepRegressionDist(ar, nbStep - 1 - istep, nameAr, p_grid, p_optimize, p_bOneFile, p_world).oneStep(states, costFunction);
+        libstoch::SimulateStepRegressionDist(ar, nbStep - 1 - istep, nameAr, p_grid, p_optimize, p_bOneFile, p_world, p_splitting).oneStep(states, costFunction);
 
         // new stochastic state
         Eigen::ArrayXXd particles =  simulator->stepForwardAndGetParticles();
@@ -25,9 +25,11 @@ protected:
 
     /// \brief calculate cuts
     /// \param  p_linCut         cuts stored
-    virtual inline 	 Eigen::ArrayXXd calCuts(const libstoch::SDDPCutOptBase &p_linCut) const
+    /// \param  p_buffer         array used to store the cuts if they are calculated
+    /// \return cuts (p_buffer or cuts stored by p_linCut)
+    virtual inline const Eigen::ArrayXXd &calCuts(const libstoch::SDDPCutOptBase &p_linCut, Eigen::ArrayXXd &p_buffer) const
     {
-        return  Eigen::ArrayXXd() ;
+        return  p_buffer ;
     }
 
 public:
@@ -44,7 +46,8 @@ public:
                         Eigen::ArrayXd    &p_lowBoundConst,  Eigen::ArrayXd   &p_upperBoundConst) const
     {
         // get back cuts
-        Eigen::ArrayXXd  cuts = calCuts(p_linCut);
+        Eigen::ArrayXXd buffer;
+        const Eigen::ArrayXXd &cuts = calCuts(p_linCut, buffer);
         int iBellPos = p_nbStorage * 3;
         int idecToStock = 2 * p_nbStorage;
         int isizeInit = p_elements.size();
@@ -85,9 +88,10 @@ private:
 
     /// \brief calculate cuts
     /// \param  p_linCut         cuts stored
-    virtual inline 	 Eigen::ArrayXXd calCuts(const libstoch::SDDPCutOptBase &p_linCut) const
+    /// \param  p_buffer         array used to store the cuts if they are calculated
+    virtual inline const Eigen::ArrayXXd &calCuts(const libstoch::SDDPCutOptBase &p_linCut, Eigen::ArrayXXd &p_buffer) const
     {
-        return  p_linCut.getCutsAssociatedToTheParticle(m_isim);
+        return  p_linCut.getCutsAssociatedToTheParticleRef(m_isim, p_buffer);
     }
 
 public :
@@ -109,9 +113,11 @@ private:
 
     /// \brief calculate cuts
     /// \param  p_linCut         cuts stored
-    virtual inline 	 Eigen::ArrayXXd calCuts(const libstoch::SDDPCutOptBase &p_linCut) const
+    /// \param  p_buffer         array used to store the cuts
+    virtual inline const Eigen::ArrayXXd &calCuts(const libstoch::SDDPCutOptBase &p_linCut, Eigen::ArrayXXd &p_buffer) const
     {
-        return  p_linCut.getCutsAssociatedToAParticle(m_alea);
+        p_buffer = p_linCut.getCutsAssociatedToAParticle(m_alea);
+        return  p_buffer;
     }
 
 public :
@@ -7,6 +7,7 @@
 #include <boost/lexical_cast.hpp>
 #include "libstoch/sddp/SDDPCutOptBase.h"
 #include "libstoch/sddp/OptimizerSDDPBase.h"
+#include "libstoch/sddp/LPWorkspace.h"
 #include "libstoch/core/grids/OneDimRegularSpaceGrid.h"
 #include "libstoch/core/grids/OneDimData.h"
 #include "libstoch/core/utils/comparisonUtils.h"
@@ -24,6 +25,15 @@ class AddConstraintReservoir
 {
 
 public:
+    /// \brief get back cuts  used for the Bellman value
+    /// \param  p_linCut          cuts stored
+    Eigen::ArrayXXd getCuts(const libstoch::SDDPCutOptBase &p_linCut) const
+    {
+        // here we use particle 0 because cuts are independent of a particle number
+        Eigen::ArrayXd aParticle;
+        return p_linCut.getCutsAssociatedToAParticle(aParticle);
+    }
+
     /// \brief  add constraints to Bellman value
     /// \param  p_linCut          cuts stored
     /// \param  p_nbStorage       number of storage
@@ -36,9 +46,7 @@ public:
                         Eigen::ArrayXd    &p_lowBoundConst,  Eigen::ArrayXd   &p_upperBoundConst) const
     {
         // get back cuts
-        // here we use particle 0 because cuts are independent of a particle number
-        Eigen::ArrayXd aParticle;
-        Eigen::ArrayXXd  cuts =  p_linCut.getCutsAssociatedToAParticle(aParticle);
+        Eigen::ArrayXXd  cuts =  getCuts(p_linCut);
         int iBellPos = p_nbStorage * 2 + 1; // offset in variables
         int idecToStock = p_nbStorage; // p_nbStorage first values  used for withdrawal
         int isizeInit = p_elements.size();
@@ -67,6 +75,58 @@ public:
             p_upperBoundConst(ibound + icut) = libstoch::infty;
         }
     }
+
+    /// \brief get back cuts  for each sample (multi cut)
+    /// \param  p_linCut          cuts stored
+    std::vector< Eigen::ArrayXXd > getMultiCuts(const libstoch::SDDPCutOptBase &p_linCut) const
+    {
+        Eigen::ArrayXd aParticle;
+        return p_linCut.getMultiCutsAssociatedToAParticle(aParticle);
+    }
+
+    /// \brief  add constraints to Bellman values in the multi cut formulation : one Bellman variable per sample
+    /// \param  p_multiCuts       cuts for each sample
+    /// \param  p_nbStorage       number of storage
+    /// \param  p_rows           rows for matrix contraints
+    /// \param  p_columns        columns for matrix contraints
+    /// \param  p_elements       A matrix elements
+    /// \param  p_lowBoundConst  lower constraint \f$ lc\f$  on matrix \f$ lc \le A x \f$
+    /// \param  p_upperBoundConst upper constraint \f$ uc\f$  on matrix \f$ A x \le uc \f$
+    void addMultiConstraints(const std::vector< Eigen::ArrayXXd > &p_multiCuts, int p_nbStorage, Eigen::ArrayXi &p_rows,   Eigen::ArrayXi   &p_columns,  Eigen::ArrayXd   &p_elements,
+                             Eigen::ArrayXd    &p_lowBoundConst,  Eigen::ArrayXd   &p_upperBoundConst) const
+    {
+        int nbCuts = 0;
+        for (size_t ig = 0; ig < p_multiCuts.size(); ++ig)
+            nbCuts += p_multiCuts[ig].cols();
+        int idecToStock = p_nbStorage; // p_nbStorage first values  used for withdrawal
+        int isizeInit = p_elements.size();
+        p_rows.conservativeResize(isizeInit + (p_nbStorage + 1)*nbCuts);
+        p_columns.conservativeResize(isizeInit + (p_nbStorage + 1)*nbCuts);
+        p_elements.conservativeResize(isizeInit + (p_nbStorage + 1)*nbCuts);
+        int ibound = p_lowBoundConst.size();
+        p_lowBoundConst.conservativeResize(ibound + nbCuts);
+        p_upperBoundConst.conservativeResize(ibound + nbCuts);
+        int irow = ibound;
+        int ipos = isizeInit;
+        for (size_t ig = 0; ig < p_multiCuts.size(); ++ig)
+        {
+            int iBellPos = p_nbStorage * 2 + 1 + ig; // Bellman variable of the sample
+            for (int icut = 0 ; icut < p_multiCuts[ig].cols() ; ++icut)
+            {
+                p_rows(ipos) = irow;
+                p_columns(ipos) = iBellPos;
+                p_elements(ipos++) = 1;
+                for (int isto = 0 ; isto < p_nbStorage ; ++isto)
+                {
+                    p_rows(ipos) = irow;
+                    p_columns(ipos) = idecToStock + isto;
+                    p_elements(ipos++) = -p_multiCuts[ig](1 + isto, icut);
+                }
+                p_lowBoundConst(irow) = p_multiCuts[ig](0, icut);
+                p_upperBoundConst(irow++) = libstoch::infty;
+            }
+        }
+    }
 };
 
 
@@ -110,6 +170,8 @@ private :
     std::shared_ptr< Simulator> m_simulatorBackward ; // for backward simulations
     std::shared_ptr< Simulator> m_simulatorForward ; // for forward simulations
 
+    bool m_bMultiCut ; ///< if true, one Bellman variable per sample is used (multi cut)
+
     /// \brief LP creation
     /// \param p_linCut               cuts used for the PL   (Benders for the Bellman value at the end of the time step)
     /// \param p_stateLevel           Store the state  : storage levels, inflows levels,  demand level
@@ -183,8 +245,43 @@ private :
         }
         lowBoundConst(m_nbStorage) = p_demand;
         upperBoundConst(m_nbStorage) = p_demand;
-        //  add cuts for bellman value to constraints
-        p_constraints.addConstraints(p_linCut, m_nbStorage, rows, columns, elements, lowBoundConst, upperBoundConst);
+        std::vector< Eigen::ArrayXXd > multiCuts;
+        if (m_bMultiCut)
+        {
+            // one Bellman variable per sample :  the Bellman value is the sum of these variables
+            multiCuts = p_constraints.getMultiCuts(p_linCut);
+            int nbBellman = multiCuts.size();
+            lowBound.conservativeResize(2 * m_nbStorage + 1 + nbBellman);
+            upperBound.conservativeResize(2 * m_nbStorage + 1 + nbBellman);
+            objFunc.conservativeResize(2 * m_nbStorage + 1 + nbBellman);
+            lowBound.tail(nbBellman).setConstant(- libstoch::infty);
+            upperBound.tail(nbBellman).setConstant(libstoch::infty);
+            objFunc.tail(nbBellman).setConstant(1.);
+        }
+        if (m_lpWorkspace)
+        {
+            // LP kept between resolutions : only bounds and cuts are updated
+            // (the model is rebuilt if the number of Bellman variables changes in multi cut)
+            if (!m_lpWorkspace->isInitialized() || (m_lpWorkspace->getModel().getNumCols() != lowBound.size()))
+                m_lpWorkspace->loadStructure(rows, columns, elements, lowBound, upperBound, objFunc, lowBoundConst, upperBoundConst);
+            else
+                m_lpWorkspace->updateStructure(lowBound, upperBound, objFunc, lowBoundConst, upperBoundConst);
+            if (m_bMultiCut)
+                m_lpWorkspace->setMultiCuts(multiCuts);
+            else
+                m_lpWorkspace->setCuts(p_constraints.getCuts(p_linCut));
+            if (!m_lpWorkspace->solve())
+                std::cout << "[problemLP::solveModel] : Warning Linear program could not be solved optimally somehow\n";
+            getSolution(m_lpWorkspace->getModel(), p_spot, p_valueAndDerivatives, p_stateFollowing, p_cost);
+            return;
+        }
+        if (m_bMultiCut)
+            p_constraints.addMultiConstraints(multiCuts, m_nbStorage, rows, columns, elements, lowBoundConst, upperBoundConst);
+        else
+        {
+            //  add cuts for bellman value to constraints
+            p_constraints.addConstraints(p_linCut, m_nbStorage, rows, columns, elements, lowBoundConst, upperBoundConst);
+        }
 
         //  model
         ClpSimplex  model;
@@ -206,16 +303,28 @@ private :
         if (!modelSolved)
             std::cout << "[problemLP::solveModel] : Warning Linear program could not be solved optimally somehow\n";
 
+        getSolution(model, p_spot, p_valueAndDerivatives, p_stateFollowing, p_cost);
+    }
+
+    /// \brief get back LP solution
+    /// \param p_model                solved LP
+    /// \param p_spot                 spot price
+    /// \param p_valueAndDerivatives  optimal value of the function and derivatives
+    /// \param p_stateFollowing       state following
+    /// \param p_cost                 instantaneous cost
+    void getSolution(const ClpSimplex &p_model, const double &p_spot, Eigen::ArrayXd &p_valueAndDerivatives,
+                     Eigen::ArrayXd &p_stateFollowing, double &p_cost) const
+    {
         // optimal value
-        p_valueAndDerivatives(0) = model.objectiveValue();
+        p_valueAndDerivatives(0) = p_model.objectiveValue();
 
         // duals
-        double *dual = model.dualRowSolution();
+        const double *dual = p_model.dualRowSolution();
         for (int isto = 0; isto < m_nbStorage ; ++isto)
             p_valueAndDerivatives(1 + isto) = dual[isto];
 
         // primal
-        double *columnPrimal = model.primalColumnSolution();
+        const double *columnPrimal = p_model.primalColumnSolution();
         // for each stock
         for (int isto = 0 ; isto < m_nbStorage ; ++isto)
         {
@@ -239,17 +348,28 @@ public :
 /// \param   p_timeSpot            spot price
     /// \param   p_simulatorBackward   backward  simulator
     /// \param   p_simulatorForward    Forward simulator
+    /// \param   p_bReuseLP            if true, LP are kept between resolutions and warm started
+    /// \param   p_bMultiCut           if true, cuts are generated for each sample and the LP uses one Bellman variable per sample
     OptimizeReservoirWithInflowsSDDP(const double &p_initialLevel,
                                      const double &p_withdrawalRate,  const int &p_nbStorage,
                                      const double &p_sigF,  const std::shared_ptr<libstoch::OneDimData<libstoch::OneDimRegularSpaceGrid, double> >    &p_timeInflowAver,
                                      const  double   &p_sigD,  const std::shared_ptr<libstoch::OneDimData<libstoch::OneDimRegularSpaceGrid, double> > &p_timeDAverage,
                                      const  std::shared_ptr<libstoch::OneDimData<libstoch::OneDimRegularSpaceGrid, double> >   &p_timeSpot,
                                      const std::shared_ptr<Simulator> &p_simulatorBackward,
-                                     const std::shared_ptr<Simulator> &p_simulatorForward):
+                                     const std::shared_ptr<Simulator> &p_simulatorForward,
+                                     const bool &p_bReuseLP = false,
+                                     const bool &p_bMultiCut = false):
         m_initialLevel(p_initialLevel),  m_withdrawalRate(p_withdrawalRate),
         m_nbStorage(p_nbStorage), m_sigF(p_sigF),    m_timeInflowAver(p_timeInflowAver),  m_sigD(p_sigD), m_timeDAverage(p_timeDAverage), m_timeSpot(p_timeSpot),
-        m_simulatorBackward(p_simulatorBackward), m_simulatorForward(p_simulatorForward)
-    {}
+        m_simulatorBackward(p_simulatorBackward), m_simulatorForward(p_simulatorForward), m_bMultiCut(p_bMultiCut)
+    {
+        if (p_bReuseLP)
+        {
+            // Bellman variable is the last column (first of the Bellman variables in multi cut), storage levels  follow withdrawals
+            Eigen::ArrayXi stateColumns = Eigen::ArrayXi::LinSpaced(m_nbStorage, m_nbStorage, 2 * m_nbStorage - 1);
+            setLPWorkspace(std::make_shared<libstoch::LPWorkspace>(2 * m_nbStorage + 1, stateColumns));
+        }
+    }
 
 
 
@@ -9,6 +9,7 @@
 #include "geners/BinaryFileArchive.hh"
 #include "libstoch/semilagrangien/OptimizerSLBase.h"
 #include "libstoch/semilagrangien/SimulateStepSemilagrangDist.h"
+#include "libstoch/core/parallelism/DistributedParticles.h"
 
 using namespace std;
 
@@ -21,7 +22,8 @@ double semiLagrangianSimuDist(const shared_ptr<libstoch::FullGrid> &p_grid,
                               const int &p_nbSimul,
                               const string   &p_fileToDump,
                               const bool &p_bOneFile,
-                              const boost::mpi::communicator &p_world)
+                              const boost::mpi::communicator &p_world,
+                              const bool &p_bPersistentOwnership)
 {
     // store states in a regime
     Eigen::ArrayXXd states(p_stateInit.size(), p_nbSimul);
@@ -43,6 +45,10 @@ double semiLagrangianSimuDist(const shared_ptr<libstoch::FullGrid> &p_grid,
     boost::normal_distribution<double> normalDistrib;
     boost::variate_generator<boost::mt19937 &, boost::normal_distribution<double> > normalRand(generator, normalDistrib);
     Eigen::ArrayXXd gaussian(p_optimize->getBrownianNumber(), p_nbSimul);
+    // simulations owned by the processor
+    unique_ptr<libstoch::DistributedParticles> particles;
+    if (p_bPersistentOwnership)
+        particles.reset(new libstoch::DistributedParticles(states, regime, costFunction, p_world));
     // iterate on time steps
     for (int istep = 0; istep < p_nbStep; ++istep)
     {
@@ -50,8 +56,14 @@ double semiLagrangianSimuDist(const shared_ptr<libstoch::FullGrid> &p_grid,
             for (int id  = 0; id < gaussian.rows(); ++id)
                 gaussian(id, is) = normalRand();
 
-        libstoch::SimulateStepSemilagrangDist(ar, p_nbStep - 1 - istep, nameAr, p_grid, p_optimize, p_bOneFile, p_world).oneStep(gaussian, states, regime, costFunction);
+        if (p_bPersistentOwnership)
+            libstoch::SimulateStepSemilagrangDist(ar, p_nbStep - 1 - istep, nameAr, p_grid, p_optimize, p_bOneFile, p_world).oneStep(gaussian, *particles);
+        else
+            libstoch::SimulateStepSemilagrangDist(ar, p_nbStep - 1 - istep, nameAr, p_grid, p_optimize, p_bOneFile, p_world).oneStep(gaussian, states, regime, costFunction);
     }
+    // simulations gathered at the end
+    if (p_bPersistentOwnership)
+        particles->gather(states, regime, costFunction);
     // final cost to add
     for (int is = 0; is < p_nbSimul; ++is)
         costFunction(0, is) += p_funcFinalValue(regime(is), states.col(is));
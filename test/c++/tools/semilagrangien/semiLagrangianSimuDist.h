@@ -27,6 +27,7 @@
 /// \param p_fileToDump            name of the file used to dump continuation values in optimization
 /// \param p_bOneFile               do we store continuation values  in only one file
 /// \param p_world                  MPI communicator
+/// \param p_bPersistentOwnership   if true each processor keeps its simulations from one step to the other and only migrates the ones leaving its region
 double semiLagrangianSimuDist(const std::shared_ptr<libstoch::FullGrid> &p_grid,
                               const std::shared_ptr<libstoch::OptimizerSLBase > &p_optimize,
                               const std::function<double(const int &, const Eigen::ArrayXd &)>   &p_funcFinalValue,
@@ -36,6 +37,7 @@ double semiLagrangianSimuDist(const std::shared_ptr<libstoch::FullGrid> &p_grid,
                               const int &p_nbSimul,
                               const std::string   &p_fileToDump,
                               const bool &p_bOneFile,
-                              const boost::mpi::communicator &p_world) ;
+                              const boost::mpi::communicator &p_world,
+                              const bool &p_bPersistentOwnership = false) ;
 
 #endif /* SEMILAGRANGIANSIMUDIST_H */
@@ -20,6 +20,7 @@
 #include "libstoch/core/utils/StateWithStocks.h"
 #include "libstoch/dp/TransitionStepRegressionDP.h"
 #include "libstoch/dp/FinalStepDP.h"
+#include "libstoch/dp/FinalStepDPCut.h"
 #include "libstoch/dp/SimulateStepRegression.h"
 #include "test/c++/tools/BasketOptions.h"
 #include "test/c++/tools/dp/OptimizeSwing.h"
@@ -157,6 +158,49 @@ BOOST_AUTO_TEST_CASE(testGlocalCalc)
 }
 
 
+/// test final values calculated for all particles at once
+BOOST_AUTO_TEST_CASE(testFinalStepVectorized)
+{
+    ArrayXd lowValues = ArrayXd::Constant(2, 0.);
+    ArrayXd step = ArrayXd::Constant(2, 0.5);
+    ArrayXi nbStep(2);
+    nbStep << 7, 4;
+    shared_ptr<RegularSpaceGrid> regular = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    ArrayXXd particles = ArrayXXd::Random(3, 50);
+    int nbRegime = 2;
+    // value for one particle
+    auto fValue = [](const int &p_iReg, const ArrayXd & p_stock, const ArrayXd & p_particle)
+    {
+        return (p_iReg + 1) * p_stock.sum() + p_particle.prod();
+    };
+    // value for all particles
+    auto fValueVec = [](const int &p_iReg, const ArrayXd & p_stock, const ArrayXXd & p_particles) -> ArrayXd
+    {
+        return (p_iReg + 1) * p_stock.sum() + p_particles.colwise().prod().transpose();
+    };
+    vector< shared_ptr< ArrayXXd > > values = FinalStepDP(regular, nbRegime)(fValue, particles);
+    vector< shared_ptr< ArrayXXd > > valuesVec = FinalStepDP(regular, nbRegime).applyVec(fValueVec, particles);
+    for (int iReg = 0; iReg < nbRegime; ++iReg)
+        BOOST_CHECK_SMALL(((*values[iReg]) - (*valuesVec[iReg])).abs().maxCoeff(), accuracyEqual);
+    // cuts : value and derivatives with respect to stocks
+    auto fCut = [&fValue](const int &p_iReg, const ArrayXd & p_stock, const ArrayXd & p_particle)
+    {
+        ArrayXd cuts = ArrayXd::Constant(p_stock.size() + 1, p_iReg + 1.);
+        cuts(0) = fValue(p_iReg, p_stock, p_particle);
+        return cuts;
+    };
+    auto fCutVec = [&fValueVec](const int &p_iReg, const ArrayXd & p_stock, const ArrayXXd & p_particles)
+    {
+        ArrayXXd cuts = ArrayXXd::Constant(p_particles.cols(), p_stock.size() + 1, p_iReg + 1.);
+        cuts.col(0) = fValueVec(p_iReg, p_stock, p_particles);
+        return cuts;
+    };
+    vector< shared_ptr< ArrayXXd > > cuts = FinalStepDPCut(regular, nbRegime)(fCut, particles);
+    vector< shared_ptr< ArrayXXd > > cutsVec = FinalStepDPCut(regular, nbRegime).applyVec(fCutVec, particles);
+    for (int iReg = 0; iReg < nbRegime; ++iReg)
+        BOOST_CHECK_SMALL(((*cuts[iReg]) - (*cutsVec[iReg])).abs().maxCoeff(), accuracyEqual);
+}
+
 #ifdef USE_MPI
 // (empty) Initialization function. Can't use testing tools here.
 bool init_function()
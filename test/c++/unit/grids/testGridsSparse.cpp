@@ -4,11 +4,15 @@
 #define BOOST_TEST_MODULE testSparseGrid
 #define BOOST_TEST_DYN_LINK
 #include <memory>
+#include <vector>
 #include <fstream>
 #include <boost/test/unit_test.hpp>
 #include <boost/lexical_cast.hpp>
 #include <Eigen/Dense>
 #include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 #include "geners/BinaryFileArchive.hh"
 #include "geners/Record.hh"
 #include "geners/Reference.hh"
@@ -290,3 +294,141 @@ BOOST_AUTO_TEST_CASE(testSparseNoBoundPlot)
     testSparseGridNoBoundPlot(5, weight3D);
 
 }
+
+/// \brief error on a level : maximum of the hierarchical values
+double errorOneLevel(const SparseSet::const_iterator &p_iterLevel, const ArrayXd &p_hierarValues)
+{
+    double smax = 0.;
+    for (const auto &position : p_iterLevel->second)
+        smax = max(smax, fabs(p_hierarValues(position.second)));
+    return smax;
+}
+
+/// \brief error on all levels : maximum of the errors
+double errorLevels(const vector<double> &p_errors)
+{
+    double smax = 0.;
+    for (const auto &err : p_errors)
+        smax = max(smax, err);
+    return smax;
+}
+
+/// \brief Refine and coarsen a sparse grid in serial and in parallel : same grids, values, and sons updated as by a full calculation
+template< class SparseGrid>
+void testSparseGridAdapt(const int &p_level, const Eigen::ArrayXd &p_weight, const size_t &p_degree)
+{
+    ArrayXd lowValues = ArrayXd::Constant(p_weight.size(), -1.);
+    ArrayXd sizeDomain = ArrayXd::Constant(p_weight.size(), 2.);
+    // function with a peak
+    function<double(const ArrayXd &)> fInterpol = [](const ArrayXd & p_x)
+    {
+        return exp(-10 * (p_x - 0.3).square().sum());
+    };
+    function< double(const SparseSet::const_iterator &, const ArrayXd &)> fErrorOneLevel = errorOneLevel;
+    function< double(const vector< double> &)> fErrorLevels = errorLevels;
+    SparseGrid gridSerial(lowValues, sizeDomain, p_level, p_weight, p_degree);
+    SparseGrid gridParallel(lowValues, sizeDomain, p_level, p_weight, p_degree);
+    ArrayXd valuesFunction(gridSerial.getNbPoints());
+    shared_ptr<GridIterator > iterGrid = gridSerial.getGridIterator();
+    while (iterGrid->isValid())
+    {
+        valuesFunction(iterGrid->getCount()) = fInterpol(iterGrid->getCoordinate());
+        iterGrid->next();
+    }
+    ArrayXd hierarValues = valuesFunction;
+    gridSerial.toHierarchize(hierarValues);
+    size_t nbPointsInit = gridSerial.getNbPoints();
+    ArrayXd valuesFunctionPar = valuesFunction;
+    ArrayXd hierarValuesPar = hierarValues;
+    double precision = 1e-3;
+    gridSerial.refine(precision, fInterpol, fErrorOneLevel, fErrorLevels, valuesFunction, hierarValues);
+    gridParallel.refine(precision, fInterpol, fErrorOneLevel, fErrorLevels, valuesFunctionPar, hierarValuesPar, true);
+    BOOST_CHECK(gridParallel.getNbPoints() > nbPointsInit);
+    BOOST_CHECK_EQUAL(gridSerial.getNbPoints(), gridParallel.getNbPoints());
+    BOOST_CHECK_SMALL((valuesFunction - valuesFunctionPar).abs().maxCoeff(), accuracyEqual);
+    BOOST_CHECK_SMALL((hierarValues - hierarValuesPar).abs().maxCoeff(), accuracyEqual);
+    // sons updated only on the levels added : same as a full calculation
+    Array< array<int, 2 >, Dynamic, Dynamic > sonUpdated = *gridParallel.getSon();
+    int iBaseUpdated = gridParallel.getIBase();
+    gridParallel.recalculateSon();
+    BOOST_CHECK_EQUAL(iBaseUpdated, gridParallel.getIBase());
+    const Array< array<int, 2 >, Dynamic, Dynamic > &son = *gridParallel.getSon();
+    BOOST_CHECK_EQUAL(sonUpdated.rows(), son.rows());
+    for (int i = 0; i < son.rows(); ++i)
+        for (int id = 0; id < son.cols(); ++id)
+        {
+            BOOST_CHECK_EQUAL(sonUpdated(i, id)[0], son(i, id)[0]);
+            BOOST_CHECK_EQUAL(sonUpdated(i, id)[1], son(i, id)[1]);
+        }
+    // coarsening
+    double precisionCoarsen = 1e-2;
+    gridSerial.coarsen(precisionCoarsen, fErrorOneLevel, valuesFunction, hierarValues);
+    gridParallel.coarsen(precisionCoarsen, fErrorOneLevel, valuesFunctionPar, hierarValuesPar, true);
+    BOOST_CHECK_EQUAL(gridSerial.getNbPoints(), gridParallel.getNbPoints());
+    BOOST_CHECK_SMALL((hierarValues - hierarValuesPar).abs().maxCoeff(), accuracyEqual);
+    // interpolation on the adapted grids
+    ArrayXd point = ArrayXd::Constant(p_weight.size(), 0.25);
+    shared_ptr<Interpolator> interpSerial = gridSerial.createInterpolator(point);
+    shared_ptr<Interpolator> interpParallel = gridParallel.createInterpolator(point);
+    BOOST_CHECK_SMALL(fabs(interpSerial->apply(hierarValues) - interpParallel->apply(hierarValuesPar)), accuracyEqual);
+}
+
+BOOST_AUTO_TEST_CASE(testSparseGridAdaptParallel)
+{
+    ArrayXd  weight3D = ArrayXd::Constant(3, 1.);
+    for (size_t degree = 1; degree <= 3; ++degree)
+    {
+        testSparseGridAdapt<SparseSpaceGridBound>(2, weight3D, degree);
+        testSparseGridAdapt<SparseSpaceGridNoBound>(2, weight3D, degree);
+    }
+}
+
+/// \brief Hierarchization of a set of functions by blocks of functions treated by threads
+///        compared to the hierarchization of each function
+/// \param p_level  maximal sparse grid level
+/// \param p_weight weights associated to sparse grids
+/// \param p_degree degree of the interpolation
+template< class SparseGrid>
+void testSparseGridHierarchizeByBlock(int p_level, const Eigen::ArrayXd &p_weight, const size_t &p_degree)
+{
+    SparseGrid sparseGrid(ArrayXd::Zero(p_weight.size()), ArrayXd::Constant(p_weight.size(), 1.), p_level, p_weight, p_degree);
+    // numbers of functions around the maximal block size
+    vector<int> nbFunctions = {1, 3, 63, 64, 65, 200};
+    for (int nbFunction : nbFunctions)
+    {
+        ArrayXXd values = ArrayXXd::Random(nbFunction, sparseGrid.getNbPoints());
+        // function by function
+        ArrayXXd hierarValues(values.rows(), values.cols());
+        for (int iFunc = 0; iFunc < nbFunction; ++iFunc)
+        {
+            ArrayXd hierarFunc = values.row(iFunc).transpose();
+            sparseGrid.toHierarchize(hierarFunc);
+            hierarValues.row(iFunc) = hierarFunc.transpose();
+        }
+        // by blocks
+        ArrayXXd hierarValuesBlock(values);
+        sparseGrid.toHierarchizeVecByBlock(hierarValuesBlock);
+        BOOST_CHECK_SMALL((hierarValues - hierarValuesBlock).abs().maxCoeff(), accuracyEqual);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSparseGridHierarchizeByBlockParallel)
+{
+    ArrayXd  weight3D = ArrayXd::Constant(3, 1.);
+#ifdef _OPENMP
+    int nbThreads = omp_get_max_threads();
+    // one thread and several threads give different block sizes
+    for (int nbThreadsTest : {1, 3})
+    {
+        omp_set_num_threads(nbThreadsTest);
+#endif
+        for (size_t degree = 1; degree <= 3; ++degree)
+        {
+            testSparseGridHierarchizeByBlock<SparseSpaceGridBound>(4, weight3D, degree);
+            testSparseGridHierarchizeByBlock<SparseSpaceGridNoBound>(4, weight3D, degree);
+        }
+#ifdef _OPENMP
+    }
+    omp_set_num_threads(nbThreads);
+#endif
+}
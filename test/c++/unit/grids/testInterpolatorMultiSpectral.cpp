@@ -0,0 +1,174 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#define BOOST_TEST_MODULE testInterpolatorMultiSpectral
+#define BOOST_TEST_DYN_LINK
+#include <memory>
+#include <vector>
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+#include <boost/random.hpp>
+#include <Eigen/Dense>
+#include "libstoch/core/grids/SpaceGrid.h"
+#include "libstoch/core/grids/GridIterator.h"
+#include "libstoch/core/grids/RegularSpaceGrid.h"
+#include "libstoch/core/grids/RegularLegendreGrid.h"
+#include "libstoch/core/grids/SparseSpaceGridBound.h"
+#include "libstoch/core/grids/RegularLegendreGridGeners.h"
+#include "libstoch/tree/GridTreeValue.h"
+#include "libstoch/tree/GridTreeValueGeners.h"
+
+using namespace std;
+using namespace Eigen;
+using namespace libstoch;
+
+double accuracyEqual = 1e-10;
+
+#if defined   __linux
+#include <fenv.h>
+#define enable_abort_on_floating_point_exception() feenableexcept(FE_DIVBYZERO | FE_INVALID)
+#endif
+
+/// For Clang < 3.7 (and above ?) to be compatible GCC 5.1 and above
+namespace boost
+{
+namespace unit_test
+{
+namespace ut_detail
+{
+std::string normalize_test_case_name(const_string name)
+{
+    return (name[0] == '&' ? std::string(name.begin() + 1, name.size() - 1) : std::string(name.begin(), name.size()));
+}
+}
+}
+}
+
+/// values of a set of functions on the grid points
+/// \param p_grid     grid
+/// \param p_nbFunc   number of functions
+ArrayXXd gridValues(const shared_ptr<SpaceGrid> &p_grid, const int &p_nbFunc)
+{
+    ArrayXXd values(p_nbFunc, p_grid->getNbPoints());
+    shared_ptr<GridIterator> iterGrid = p_grid->getGridIterator();
+    while (iterGrid->isValid())
+    {
+        ArrayXd pointCoord = iterGrid->getCoordinate();
+        for (int ifunc = 0; ifunc < p_nbFunc; ++ifunc)
+            values(ifunc, iterGrid->getCount()) = sin(pointCoord.sum() * (1. + 0.1 * ifunc)) + ifunc * pointCoord.prod();
+        iterGrid->next();
+    }
+    return values;
+}
+
+/// compare the interpolation of a set of functions with the interpolation of each function
+/// \param p_grid     grid
+/// \param p_nbFunc   number of functions
+/// \param p_bGridInterpolator  true if the functions can be interpolated with an interpolator of the grid kept for all the functions
+void testMultiAgainstSingle(const shared_ptr<SpaceGrid> &p_grid, const int &p_nbFunc, const bool &p_bGridInterpolator = true)
+{
+#if defined   __linux
+    enable_abort_on_floating_point_exception();
+#endif
+    // functions on the grid
+    ArrayXXd values = gridValues(p_grid, p_nbFunc);
+    shared_ptr<InterpolatorMultiSpectral> multiInterp = p_grid->createInterpolatorMultiSpectral(values);
+    BOOST_CHECK_EQUAL(multiInterp->getNbFunctions(), p_nbFunc);
+    vector< shared_ptr<InterpolatorSpectral> > interp(p_nbFunc);
+    for (int ifunc = 0; ifunc < p_nbFunc; ++ifunc)
+        interp[ifunc] = p_grid->createInterpolatorSpectral(values.row(ifunc).transpose());
+    // random points in the domain
+    vector< array<double, 2> > extremes = p_grid->getExtremeValues();
+    boost::mt19937 generator;
+    boost::random::uniform_01<double> uniform;
+    ArrayXd point(extremes.size());
+    for (int ip = 0; ip < 100; ++ip)
+    {
+        for (size_t id = 0; id < extremes.size(); ++id)
+            point(id) = extremes[id][0] + (extremes[id][1] - extremes[id][0]) * uniform(generator);
+        ArrayXd multiValues = multiInterp->apply(point);
+        shared_ptr<Interpolator> gridInterp = p_grid->createInterpolator(point);
+        for (int ifunc = 0; ifunc < p_nbFunc; ++ifunc)
+        {
+            double singleValue = interp[ifunc]->apply(point);
+            BOOST_CHECK_SMALL(multiValues(ifunc) - singleValue, accuracyEqual);
+            BOOST_CHECK_SMALL(multiInterp->applyOne(point, ifunc) - singleValue, accuracyEqual);
+            if (p_bGridInterpolator)
+                BOOST_CHECK_SMALL(multiInterp->applyOne(*gridInterp, ifunc) - singleValue, accuracyEqual);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMultiSpectralLinear)
+{
+    ArrayXd lowValues = ArrayXd::Constant(2, 1.);
+    ArrayXd step = ArrayXd::Constant(2, 0.5);
+    ArrayXi nbStep(2);
+    nbStep << 5, 7;
+    testMultiAgainstSingle(make_shared<RegularSpaceGrid>(lowValues, step, nbStep), 7);
+}
+
+BOOST_AUTO_TEST_CASE(testMultiSpectralLegendre)
+{
+    ArrayXd lowValues = ArrayXd::Constant(2, 1.);
+    ArrayXd step = ArrayXd::Constant(2, 0.5);
+    ArrayXi nbStep(2);
+    nbStep << 4, 3;
+    ArrayXi poly(2);
+    poly << 2, 3;
+    testMultiAgainstSingle(make_shared<RegularLegendreGrid>(lowValues, step, nbStep, poly), 7, false);
+}
+
+BOOST_AUTO_TEST_CASE(testMultiSpectralSparse)
+{
+    ArrayXd lowValues = ArrayXd::Constant(2, 1.);
+    ArrayXd sizeDomain = ArrayXd::Constant(2, 2.);
+    ArrayXd weight = ArrayXd::Constant(2, 1.);
+    for (size_t degree = 1; degree <= 3; ++degree)
+        testMultiAgainstSingle(make_shared<SparseSpaceGridBound>(lowValues, sizeDomain, 4, weight, degree), 7);
+}
+
+/// read a GridTreeValue serialized with version 1 (one spectral interpolator per node)
+/// and compare it to the spectral interpolators of each node
+/// \param p_grid     grid
+/// \param p_nbNode   number of nodes
+void testGridTreeValueVersion1(const shared_ptr<SpaceGrid> &p_grid, const int &p_nbNode)
+{
+    ArrayXXd values = gridValues(p_grid, p_nbNode);
+    vector< shared_ptr<InterpolatorSpectral> > interp(p_nbNode);
+    for (int inode = 0; inode < p_nbNode; ++inode)
+        interp[inode] = p_grid->createInterpolatorSpectral(values.row(inode).transpose());
+    // version 1 format
+    stringstream stream;
+    gs::ClassId(gs::ClassId::makeId<GridTreeValue>().name(), 1).write(stream);
+    bool bSharedPtr = true;
+    gs::write_pod(stream, bSharedPtr);
+    gs::write_item(stream, p_grid);
+    gs::write_item(stream, interp);
+    CPP11_auto_ptr<GridTreeValue> treeValue = gs::read_item<GridTreeValue>(stream);
+    BOOST_CHECK_EQUAL(treeValue->getInterpolator()->getNbFunctions(), p_nbNode);
+    vector< array<double, 2> > extremes = p_grid->getExtremeValues();
+    boost::mt19937 generator;
+    boost::random::uniform_01<double> uniform;
+    ArrayXd point(extremes.size());
+    for (int ip = 0; ip < 100; ++ip)
+    {
+        for (size_t id = 0; id < extremes.size(); ++id)
+            point(id) = extremes[id][0] + (extremes[id][1] - extremes[id][0]) * uniform(generator);
+        ArrayXd treeValues = treeValue->getValues(point);
+        for (int inode = 0; inode < p_nbNode; ++inode)
+            BOOST_CHECK_SMALL(treeValues(inode) - interp[inode]->apply(point), accuracyEqual);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testGridTreeValueReadVersion1)
+{
+    ArrayXd lowValues = ArrayXd::Constant(2, 1.);
+    ArrayXd step = ArrayXd::Constant(2, 0.5);
+    ArrayXi nbStep(2);
+    nbStep << 4, 3;
+    testGridTreeValueVersion1(make_shared<RegularSpaceGrid>(lowValues, step, nbStep), 5);
+    ArrayXi poly(2);
+    poly << 2, 3;
+    testGridTreeValueVersion1(make_shared<RegularLegendreGrid>(lowValues, step, nbStep, poly), 5);
+}
@@ -631,3 +631,70 @@ BOOST_AUTO_TEST_CASE(testLegendreInterpolatorArnaudBug)
     double result = interp.apply(data);
     BOOST_CHECK_CLOSE(result, 100.0, accuracyEqual);
 }
+
+/// \brief spectral representation calculated directly on each mesh (nested loops on collocation points and basis functions)
+void testLegendreSpectralDirect(ArrayXi &nPol)
+{
+    int nDim = nPol.size();
+    ArrayXd lowValues = ArrayXd::Constant(nDim, 1.);
+    ArrayXd step = ArrayXd::Constant(nDim, 0.7);
+    ArrayXi  nbStep(nDim);
+    for (int i = 0; i < nDim; ++i)
+        nbStep(i) = 2 + i;
+    RegularLegendreGrid regGrid(lowValues, step, nbStep, nPol);
+    ArrayXd data(regGrid.getNbPoints());
+    shared_ptr<GridIterator> iterRegGrid  =  regGrid.getGridIterator();
+    while (iterRegGrid->isValid())
+    {
+        ArrayXd pointCoord = iterRegGrid->getCoordinate();
+        data(iterRegGrid->getCount()) = sin(pointCoord.sum()) + pointCoord.prod();
+        iterRegGrid->next();
+    }
+    LegendreInterpolatorSpectral interpolator(&regGrid, data);
+    const ArrayXXi &funcBaseExp = interpolator.getFuncBaseExp();
+    shared_ptr< vector< ArrayXXd >  >  fInterpol = regGrid.getFInterpol();
+    ArrayXXd spectral = ArrayXXd::Zero(funcBaseExp.cols(), regGrid.getNbMeshes());
+    ArrayXd vMin = ArrayXd::Constant(regGrid.getNbMeshes(), infty);
+    ArrayXd vMax = ArrayXd::Constant(regGrid.getNbMeshes(), -infty);
+    for (int imesh = 0 ; imesh < regGrid.getNbMeshes(); ++imesh)
+    {
+        ArrayXi coordMesh(nDim);
+        int imeshLoc = imesh;
+        for (int id = 0; id < nDim; ++id)
+        {
+            coordMesh(id) = (imeshLoc % nbStep(id)) * nPol(id);
+            imeshLoc /= nbStep(id);
+        }
+        for (int ibb = 0 ; ibb < funcBaseExp.cols(); ++ibb)
+        {
+            ArrayXi coordPoint = coordMesh + funcBaseExp.col(ibb);
+            int ipoint = regGrid.intCoordPerDimToGlobal(coordPoint);
+            for (int ib = 0 ; ib < funcBaseExp.cols(); ++ib)
+            {
+                double dfunc = 1 ;
+                for (int id = 0 ; id < nDim ; ++id)
+                    dfunc *= (*fInterpol)[id](funcBaseExp(id, ib), funcBaseExp(id, ibb));
+                spectral(ib, imesh) += data(ipoint) * dfunc;
+            }
+            vMin(imesh) = min(vMin(imesh), data(ipoint));
+            vMax(imesh) = max(vMax(imesh), data(ipoint));
+        }
+    }
+    // same representation bit to bit
+    BOOST_CHECK((interpolator.getSpectral() == spectral).all());
+    BOOST_CHECK((interpolator.getMin() == vMin).all());
+    BOOST_CHECK((interpolator.getMax() == vMax).all());
+}
+
+BOOST_AUTO_TEST_CASE(testLegendreSpectralDirect2DPol3)
+{
+    ArrayXi nPol = ArrayXi::Constant(2, 3);
+    testLegendreSpectralDirect(nPol);
+}
+
+BOOST_AUTO_TEST_CASE(testLegendreSpectralDirect3DPol1and2)
+{
+    ArrayXi nPol(3);
+    nPol << 1, 2, 2;
+    testLegendreSpectralDirect(nPol);
+}
@@ -9,6 +9,9 @@
 #include <boost/test/unit_test.hpp>
 #include <Eigen/Dense>
 #include "libstoch/core/parallelism/ParallelComputeGridSplitting.h"
+#include "libstoch/core/parallelism/NodeSharedArray.h"
+#include "libstoch/core/parallelism/SharedTaskQueue.h"
+#include "libstoch/core/parallelism/DistributedParticles.h"
 #include "libstoch/core/utils/primeNumber.h"
 
 using namespace std;
@@ -923,6 +926,451 @@ BOOST_AUTO_TEST_CASE(testParallelismWithConeAndVaryingMesh4D)
 
 }
 
+// array shared on a node : filled by one processor or gathered from all processors
+BOOST_AUTO_TEST_CASE(testNodeSharedArray)
+{
+    boost::mpi::communicator world;
+    int nbProc = world.size();
+    int rank = world.rank();
+    // processors of a node, one node per processor, groups of two processors
+    for (int nbRankPerGroup = 0; nbRankPerGroup < 3; ++nbRankPerGroup)
+    {
+        // rank + 1 values per processor
+        int nbTotal = (nbProc * (nbProc + 1)) / 2;
+        NodeSharedArray<double> shared(world, nbTotal, nbRankPerGroup);
+        if (nbRankPerGroup > 0)
+            BOOST_CHECK(shared.getNbRankSharing() <= nbRankPerGroup);
+        for (int iter = 0; iter < 2; ++iter)
+        {
+            ArrayXd local(rank + 1);
+            for (int i = 0; i <= rank; ++i)
+                local(i) = 100 * rank + i + iter;
+            shared.allGatherv(local.data(), local.size());
+            int ipos = 0;
+            for (int ir = 0; ir < nbProc; ++ir)
+                for (int i = 0; i <= ir; ++i)
+                    BOOST_CHECK_EQUAL(shared.data()[ipos++], 100 * ir + i + iter);
+        }
+        // array reused for less values : rank values per processor
+        ArrayXd localLess = ArrayXd::Constant(rank, rank);
+        shared.allGatherv(localLess.data(), localLess.size());
+        int iposLess = 0;
+        for (int ir = 0; ir < nbProc; ++ir)
+            for (int i = 0; i < ir; ++i)
+                BOOST_CHECK_EQUAL(shared.data()[iposLess++], ir);
+        // array too small : rank + 2 values per processor
+        ArrayXd localMore = ArrayXd::Constant(rank + 2, rank);
+        BOOST_CHECK_THROW(shared.allGatherv(localMore.data(), localMore.size()), std::length_error);
+        shared.fill([](double * p_data, const size_t &p_size)
+        {
+            for (size_t i = 0; i < p_size; ++i)
+                p_data[i] = 2. * i;
+        });
+        for (int i = 0; i < nbTotal; ++i)
+            BOOST_CHECK_EQUAL(shared.data()[i], 2. * i);
+    }
+}
+
+// each task of the queue is given to exactly one processor, the queue being filled several times
+BOOST_AUTO_TEST_CASE(testSharedTaskQueue)
+{
+    boost::mpi::communicator world;
+    SharedTaskQueue queue(world);
+    BOOST_CHECK_EQUAL(queue.getTask(), -1);
+    for (int nbTask = 0; nbTask < 50; nbTask += 7)
+    {
+        queue.reset(nbTask);
+        vector<int> taskDone;
+        int itask;
+        while ((itask = queue.getTask()) >= 0)
+        {
+            // tasks are given in increasing order to a processor
+            if (taskDone.size() > 0)
+                BOOST_CHECK(itask > taskDone.back());
+            taskDone.push_back(itask);
+        }
+        vector< vector<int> > taskDoneByProc;
+        boost::mpi::all_gather(world, taskDone, taskDoneByProc);
+        vector<int> nbGiven(nbTask, 0);
+        for (const auto &tasks : taskDoneByProc)
+            for (int task : tasks)
+                nbGiven[task] += 1;
+        for (int task = 0; task < nbTask; ++task)
+            BOOST_CHECK_EQUAL(nbGiven[task], 1);
+    }
+}
+
+// exchanges split in small messages give the same extended and reconstructed arrays
+BOOST_AUTO_TEST_CASE(testParallelismSmallMessages)
+{
+    boost::mpi::communicator world;
+    ArrayXi initialDimension(3);
+    initialDimension << 30, 20, 16;
+    function<  Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 >(const Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 > &) > fMesh = MeshExtension(initialDimension);
+    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, Array<bool, Dynamic, 1>::Constant(3, true), world);
+    ParallelComputeGridSplitting paral(initialDimension, fMesh, splittingRatio, world);
+    Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 > gridLocal = paral.getCurrentCalculationGrid();
+    ArrayXXd data;
+    if (gridLocal.size() > 0)
+    {
+        int iSizeLoc1 = (gridLocal(0)[1] - gridLocal(0)[0]);
+        int iSizeLoc2 = (gridLocal(1)[1] - gridLocal(1)[0]);
+        int iSizeLoc3 = (gridLocal(2)[1] - gridLocal(2)[0]);
+        data.resize(2, iSizeLoc1 * iSizeLoc2 * iSizeLoc3);
+        for (int k = 0; k < iSizeLoc3; ++k)
+            for (int j = 0; j < iSizeLoc2; ++j)
+                for (int i = 0; i < iSizeLoc1; ++i)
+                {
+                    data(0, i + iSizeLoc1 * (j + iSizeLoc2 * k)) = gridLocal(0)[0] + i + 100. * (gridLocal(1)[0] + j) + 10000. * (gridLocal(2)[0] + k);
+                    data(1, i + iSizeLoc1 * (j + iSizeLoc2 * k)) = -data(0, i + iSizeLoc1 * (j + iSizeLoc2 * k));
+                }
+    }
+    else
+        data.resize(2, 0);
+    ArrayXXd dataExtended = paral.runOneStep(data);
+    Eigen::Array< array<int, 2>, Eigen::Dynamic, 1 > globalGrid(3);
+    for (int id = 0; id < 3; ++id)
+        globalGrid(id) = {{0, initialDimension(id)}};
+    ArrayXXd dataRecons = paral.reconstruct(data, globalGrid, 0);
+    // one or a few hyperplanes per message, buffers reused
+    for (size_t messageSize : {static_cast<size_t>(8), static_cast<size_t>(2000)})
+    {
+        paral.setMessageSize(messageSize);
+        for (int iter = 0; iter < 2; ++iter)
+        {
+            ArrayXXd dataExtendedSmall = paral.runOneStep(data);
+            BOOST_CHECK_EQUAL(dataExtendedSmall.cols(), dataExtended.cols());
+            if (dataExtended.size() > 0)
+                BOOST_CHECK_EQUAL((dataExtendedSmall - dataExtended).abs().maxCoeff(), 0.);
+            ArrayXXd dataReconsSmall = paral.reconstruct(data, globalGrid, 0);
+            if (world.rank() == 0)
+            {
+                BOOST_CHECK_EQUAL((dataReconsSmall - dataRecons).abs().maxCoeff(), 0.);
+                for (int ipoint = 0; ipoint < initialDimension.prod(); ++ipoint)
+                {
+                    int i = ipoint % initialDimension(0);
+                    int j = (ipoint / initialDimension(0)) % initialDimension(1);
+                    int k = ipoint / (initialDimension(0) * initialDimension(1));
+                    BOOST_CHECK_EQUAL(dataReconsSmall(0, ipoint), i + 100. * j + 10000. * k);
+                }
+            }
+        }
+    }
+}
+
+// arrays without data (first dimension 0) are extended and reconstructed without exchange
+BOOST_AUTO_TEST_CASE(testParallelismNoData)
+{
+    boost::mpi::communicator world;
+    ArrayXi initialDimension(2);
+    initialDimension << 30, 20;
+    function<  Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 >(const Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 > &) > fMesh = MeshExtension(initialDimension);
+    ArrayXi splittingRatio = paraOptimalSplitting(initialDimension, Array<bool, Dynamic, 1>::Constant(2, true), world);
+    ParallelComputeGridSplitting paral(initialDimension, fMesh, splittingRatio, world);
+    Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 > gridLocal = paral.getCurrentCalculationGrid();
+    ArrayXXd data(0, (gridLocal.size() > 0) ? (gridLocal(0)[1] - gridLocal(0)[0]) * (gridLocal(1)[1] - gridLocal(1)[0]) : 0);
+    ArrayXXd dataExtended = paral.runOneStep(data);
+    BOOST_CHECK_EQUAL(dataExtended.rows(), 0);
+    Eigen::Array< array<int, 2>, Eigen::Dynamic, 1 > globalGrid(2);
+    for (int id = 0; id < 2; ++id)
+        globalGrid(id) = {{0, initialDimension(id)}};
+    ArrayXXd dataRecons = paral.reconstruct(data, globalGrid, 0);
+    if (world.rank() == 0)
+    {
+        BOOST_CHECK_EQUAL(dataRecons.rows(), 0);
+        BOOST_CHECK_EQUAL(dataRecons.cols(), initialDimension.prod());
+    }
+}
+
+// two levels split (nodes then processors of a node) and its communication volume
+BOOST_AUTO_TEST_CASE(testTopologySplitting)
+{
+    boost::mpi::communicator world;
+    ArrayXi initialDimension(3);
+    initialDimension << 60, 40, 30;
+    Array<bool, Dynamic, 1> bdimToSplit = Array<bool, Dynamic, 1>::Constant(3, true);
+    function<  Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 >(const Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 > &) > fMesh = MeshExtension(initialDimension);
+    // 4 nodes of 4 processors
+    int nbNode = 4;
+    int nbRankPerNode = 4;
+    ArrayXi splittingRatio = paraTwoLevelSplitting(initialDimension, initialDimension, bdimToSplit, fMesh, nbNode, nbRankPerNode);
+    BOOST_CHECK_EQUAL(splittingRatio.size(), 6);
+    BOOST_CHECK_EQUAL(splittingRatio.head(3).prod(), nbNode);
+    BOOST_CHECK_EQUAL(splittingRatio.tail(3).prod(), nbRankPerNode);
+    // grids of the processors pave the grid
+    ArrayXi nbOwner = ArrayXi::Zero(initialDimension.prod());
+    vector< Array<  array<int, 2 >, Dynamic, 1 > > gridProc(nbNode * nbRankPerNode);
+    for (int iproc = 0; iproc < nbNode * nbRankPerNode; ++iproc)
+    {
+        gridProc[iproc] = paraSplitComputationGridsProc(initialDimension, splittingRatio, iproc);
+        for (int k = gridProc[iproc](2)[0]; k < gridProc[iproc](2)[1]; ++k)
+            for (int j = gridProc[iproc](1)[0]; j < gridProc[iproc](1)[1]; ++j)
+                for (int i = gridProc[iproc](0)[0]; i < gridProc[iproc](0)[1]; ++i)
+                    nbOwner(i + initialDimension(0) * (j + initialDimension(1) * k)) += 1;
+    }
+    BOOST_CHECK_EQUAL(nbOwner.minCoeff(), 1);
+    BOOST_CHECK_EQUAL(nbOwner.maxCoeff(), 1);
+    // volume compared to the volume calculated processor by processor
+    array<long, 2> volumeRef = {{0, 0}};
+    for (int iproc = 0; iproc < nbNode * nbRankPerNode; ++iproc)
+    {
+        Array<  array<int, 2 >, Dynamic, 1 > gridExt = fMesh(gridProc[iproc]);
+        for (int jproc = 0; jproc < nbNode * nbRankPerNode; ++jproc)
+        {
+            if (jproc == iproc)
+                continue;
+            long nbPoints = 1;
+            for (int id = 0; id < 3; ++id)
+                nbPoints *= max(min(gridExt(id)[1], gridProc[jproc](id)[1]) - max(gridExt(id)[0], gridProc[jproc](id)[0]), 0);
+            volumeRef[(iproc / nbRankPerNode == jproc / nbRankPerNode) ? 1 : 0] += nbPoints;
+        }
+    }
+    array<long, 2> volume = paraSplittingCommunicationVolume(initialDimension, initialDimension, fMesh, splittingRatio, nbRankPerNode);
+    BOOST_CHECK_EQUAL(volume[0], volumeRef[0]);
+    BOOST_CHECK_EQUAL(volume[1], volumeRef[1]);
+    // the flat split with the same ratios gets more data from other nodes
+    ArrayXi flatRatio = splittingRatio.head(3) * splittingRatio.tail(3);
+    array<long, 2> volumeFlat = paraSplittingCommunicationVolume(initialDimension, initialDimension, fMesh, flatRatio, nbRankPerNode);
+    BOOST_CHECK_EQUAL(volumeFlat[0] + volumeFlat[1], volume[0] + volume[1]);
+    BOOST_CHECK(volume[0] <= volumeFlat[0]);
+
+    // split of the processors of the communicator used for an exchange
+    ArrayXi topoRatio = paraTopologySplitting(initialDimension, initialDimension, bdimToSplit, fMesh, world);
+    BOOST_CHECK(topoRatio.prod() <= world.size());
+    ParallelComputeGridSplitting paral(initialDimension, fMesh, topoRatio, world);
+    Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 > gridLocal = paral.getCurrentCalculationGrid();
+    if (gridLocal.size() == 0)
+        return;
+    int iSizeLoc1 = (gridLocal(0)[1] - gridLocal(0)[0]);
+    int iSizeLoc2 = (gridLocal(1)[1] - gridLocal(1)[0]);
+    int iSizeLoc3 = (gridLocal(2)[1] - gridLocal(2)[0]);
+    ArrayXd data(iSizeLoc1 * iSizeLoc2 * iSizeLoc3);
+    for (int k = 0; k < iSizeLoc3; ++k)
+        for (int j = 0; j < iSizeLoc2; ++j)
+            for (int i = 0; i < iSizeLoc1; ++i)
+                data(i + iSizeLoc1 * (j + iSizeLoc2 * k)) = gridLocal(0)[0] + i + 100. * (gridLocal(1)[0] + j) + 10000. * (gridLocal(2)[0] + k);
+    ArrayXd dataRecons = paral.runOneStep(data);
+    Eigen::Array<  array<int, 2 >, Eigen::Dynamic, 1 > gridExtended = paral.getExtendedGridProcOldGrid();
+    int iLoc1 = gridExtended(0)[1] - gridExtended(0)[0];
+    int iLoc2 = gridExtended(1)[1] - gridExtended(1)[0];
+    int iLoc3 = gridExtended(2)[1] - gridExtended(2)[0];
+    BOOST_CHECK_EQUAL(dataRecons.size(), iLoc1 * iLoc2 * iLoc3);
+    for (int k = 0; k < iLoc3; ++k)
+        for (int j = 0; j < iLoc2; ++j)
+            for (int i = 0; i < iLoc1; ++i)
+                BOOST_CHECK_EQUAL(dataRecons(i + iLoc1 * (j + iLoc2 * k)), gridExtended(0)[0] + i + 100. * (gridExtended(1)[0] + j) + 10000. * (gridExtended(2)[0] + k));
+}
+
+// splitting function for all the steps of a resolution : the grids of the processors pave the grid
+BOOST_AUTO_TEST_CASE(testTopologySplittingFunction)
+{
+    boost::mpi::communicator world;
+    ArrayXi initialDimension(2);
+    initialDimension << 40, 30;
+    Array<bool, Dynamic, 1> bdimToSplit = Array<bool, Dynamic, 1>::Constant(2, true);
+    SplittingFunction splitting = TopologySplitting(ArrayXi::Constant(2, 2));
+    ArrayXi splittingRatio = splitting(initialDimension, bdimToSplit, world);
+    BOOST_CHECK((splittingRatio.size() == 2) || (splittingRatio.size() == 4));
+    BOOST_CHECK(splittingRatio.prod() <= world.size());
+    // same split on all processors
+    BOOST_CHECK(boost::mpi::all_reduce(world, splittingRatio.prod(), boost::mpi::maximum<int>()) == splittingRatio.prod());
+    ParallelComputeGridSplitting paral(initialDimension, splittingRatio, world);
+    Array<  array<int, 2 >, Dynamic, 1 > gridLocal = paral.getCurrentCalculationGrid();
+    ArrayXd data;
+    if (world.rank() < paral.getNbProcessorUsed())
+    {
+        data.resize((gridLocal(0)[1] - gridLocal(0)[0]) * (gridLocal(1)[1] - gridLocal(1)[0]));
+        for (int j = gridLocal(1)[0]; j < gridLocal(1)[1]; ++j)
+            for (int i = gridLocal(0)[0]; i < gridLocal(0)[1]; ++i)
+                data(i - gridLocal(0)[0] + (gridLocal(0)[1] - gridLocal(0)[0]) * (j - gridLocal(1)[0])) = i + 100. * j;
+    }
+    // whole grid on processor 0
+    Array<  array<int, 2 >, Dynamic, 1 > gridAll(2);
+    for (int id = 0; id < 2; ++id)
+    {
+        gridAll(id)[0] = 0;
+        gridAll(id)[1] = initialDimension(id);
+    }
+    ArrayXd dataAll;
+    if (world.rank() < paral.getNbProcessorUsed())
+        dataAll = paral.reconstruct(data, gridAll);
+    if (world.rank() == 0)
+    {
+        BOOST_CHECK_EQUAL(dataAll.size(), initialDimension.prod());
+        for (int j = 0; j < initialDimension(1); ++j)
+            for (int i = 0; i < initialDimension(0); ++i)
+                BOOST_CHECK_EQUAL(dataAll(i + initialDimension(0) * j), i + 100. * j);
+    }
+}
+
+/// check that the simulations owned by the processors are all the simulations
+/// \param p_particles   distributed simulations
+/// \param p_states      expected states of all the simulations
+/// \param p_world       MPI communicator
+void checkDistributedParticles(const DistributedParticles &p_particles, const ArrayXXd &p_states, const boost::mpi::communicator &p_world)
+{
+    ArrayXXd states;
+    ArrayXi iReg;
+    ArrayXXd phi;
+    p_particles.gather(states, iReg, phi);
+    BOOST_CHECK_EQUAL(boost::mpi::all_reduce(p_world, static_cast<int>(p_particles.getSimNumbers().size()), std::plus<int>()), p_states.cols());
+    for (int is = 0; is < p_states.cols(); ++is)
+    {
+        BOOST_CHECK_SMALL((states.col(is) - p_states.col(is)).abs().maxCoeff(), accuracyEqual);
+        BOOST_CHECK_EQUAL(iReg(is), is % 2);
+        BOOST_CHECK_EQUAL(phi(0, is), static_cast<double>(is));
+    }
+}
+
+/// \brief move the simulations owned by the processor : the state of a simulation is a function of its number
+/// \param p_particles   distributed simulations
+/// \param p_states      states of all the simulations
+void moveParticles(DistributedParticles &p_particles, const ArrayXXd &p_states)
+{
+    for (int is = 0; is < p_particles.getSimNumbers().size(); ++is)
+        p_particles.getStates().col(is) = p_states.col(p_particles.getSimNumbers()(is));
+}
+
+// simulations spread in the space migrate to the processor owning their new region
+BOOST_AUTO_TEST_CASE(testDistributedParticlesMigration)
+{
+    boost::mpi::communicator world;
+    int nbSimul = 2000;
+    ArrayXXd states = 0.5 * (ArrayXXd::Random(2, nbSimul) + 1.);
+    ArrayXi iReg(nbSimul);
+    ArrayXXd phi(1, nbSimul);
+    for (int is = 0; is < nbSimul; ++is)
+    {
+        iReg(is) = is % 2;
+        phi(0, is) = is;
+    }
+    DistributedParticles particles(states, iReg, phi, world);
+    BOOST_CHECK(!particles.isDegenerate());
+    BOOST_CHECK_EQUAL(particles.getNbSplit(), 1);
+    checkDistributedParticles(particles, states, world);
+    // translation of a part of the domain : without imbalance the regions are kept
+    ArrayXXd statesMoved = states;
+    statesMoved.row(0) = (states.row(0) + 0.25).unaryExpr([](const double & x)
+    {
+        return (x > 1.) ? x - 1. : x;
+    });
+    moveParticles(particles, statesMoved);
+    particles.migrate();
+    int nbMigrated = boost::mpi::all_reduce(world, particles.getNbMigrated(), std::plus<int>());
+    if (world.size() > 1)
+        BOOST_CHECK(nbMigrated > 0);
+    BOOST_CHECK_EQUAL(particles.getNbSplit(), 1);
+    checkDistributedParticles(particles, statesMoved, world);
+}
+
+// all the simulations start from the same state, then spread
+BOOST_AUTO_TEST_CASE(testDistributedParticlesSameInitialState)
+{
+    boost::mpi::communicator world;
+    int nbSimul = 2000;
+    ArrayXXd states = ArrayXXd::Constant(2, nbSimul, 0.5);
+    ArrayXi iReg(nbSimul);
+    ArrayXXd phi(1, nbSimul);
+    for (int is = 0; is < nbSimul; ++is)
+    {
+        iReg(is) = is % 2;
+        phi(0, is) = is;
+    }
+    DistributedParticles particles(states, iReg, phi, world);
+    BOOST_CHECK_EQUAL(particles.isDegenerate(), world.size() > 1);
+    checkDistributedParticles(particles, states, world);
+    // states still the same : the regions are not recalculated
+    for (int istep = 0; istep < 2; ++istep)
+    {
+        particles.migrate();
+        BOOST_CHECK_EQUAL(particles.getNbSplit(), 1);
+        BOOST_CHECK_EQUAL(particles.getNbMigrated(), 0);
+        BOOST_CHECK_EQUAL(particles.isDegenerate(), world.size() > 1);
+    }
+    checkDistributedParticles(particles, states, world);
+    // the regions are calculated from the spread states
+    ArrayXXd statesSpread = 0.5 * (ArrayXXd::Random(2, nbSimul) + 1.);
+    moveParticles(particles, statesSpread);
+    particles.migrate();
+    BOOST_CHECK(!particles.isDegenerate());
+    int nbMigrated = boost::mpi::all_reduce(world, particles.getNbMigrated(), std::plus<int>());
+    if (world.size() > 1)
+    {
+        BOOST_CHECK_EQUAL(particles.getNbSplit(), 2);
+        BOOST_CHECK(nbMigrated > 0);
+    }
+    checkDistributedParticles(particles, statesSpread, world);
+    // the bounding boxes of the processors are disjoint
+    vector< array< double, 2> > box = particles.getBoundingBox();
+    vector< array< double, 2> > boxPrev = box;
+    if (world.rank() > 0)
+        world.recv(world.rank() - 1, 0, boxPrev);
+    if (world.rank() < world.size() - 1)
+        world.send(world.rank() + 1, 0, box);
+    if (world.rank() > 0)
+    {
+        bool bDisjoint = false;
+        for (size_t id = 0; id < box.size(); ++id)
+            bDisjoint = bDisjoint || (box[id][0] > boxPrev[id][1]) || (box[id][1] < boxPrev[id][0]);
+        BOOST_CHECK(bDisjoint);
+    }
+}
+
+// the states are spread in the first dimension only : the split is done in this dimension
+BOOST_AUTO_TEST_CASE(testDistributedParticlesOneDimensionSpread)
+{
+    boost::mpi::communicator world;
+    int nbSimul = 2000;
+    ArrayXXd states = ArrayXXd::Constant(2, nbSimul, 0.5);
+    states.row(0) = 0.5 * (ArrayXXd::Random(1, nbSimul) + 1.);
+    ArrayXi iReg(nbSimul);
+    ArrayXXd phi(1, nbSimul);
+    for (int is = 0; is < nbSimul; ++is)
+    {
+        iReg(is) = is % 2;
+        phi(0, is) = is;
+    }
+    DistributedParticles particles(states, iReg, phi, world);
+    BOOST_CHECK(!particles.isDegenerate());
+    checkDistributedParticles(particles, states, world);
+    // balanced
+    int nbMaxLoc = boost::mpi::all_reduce(world, static_cast<int>(particles.getSimNumbers().size()), boost::mpi::maximum<int>());
+    BOOST_CHECK(nbMaxLoc <= 1.5 * nbSimul / world.size());
+    particles.migrate();
+    BOOST_CHECK_EQUAL(particles.getNbSplit(), 1);
+    BOOST_CHECK_EQUAL(particles.getNbMigrated(), 0);
+    checkDistributedParticles(particles, states, world);
+}
+
+// all the simulations move to the region of a processor : the regions are recalculated
+BOOST_AUTO_TEST_CASE(testDistributedParticlesImbalance)
+{
+    boost::mpi::communicator world;
+    int nbSimul = 2000;
+    ArrayXXd states = 0.5 * (ArrayXXd::Random(2, nbSimul) + 1.);
+    ArrayXi iReg(nbSimul);
+    ArrayXXd phi(1, nbSimul);
+    for (int is = 0; is < nbSimul; ++is)
+    {
+        iReg(is) = is % 2;
+        phi(0, is) = is;
+    }
+    DistributedParticles particles(states, iReg, phi, world, 1.5);
+    // concentrate the simulations in the lower corner
+    ArrayXXd statesConcentrated = 0.01 * states;
+    moveParticles(particles, statesConcentrated);
+    particles.migrate();
+    if (world.size() > 1)
+    {
+        BOOST_CHECK(particles.getNbSplit() > 1);
+        BOOST_CHECK(boost::mpi::all_reduce(world, particles.getNbMigrated(), std::plus<int>()) > 0);
+    }
+    // balanced again
+    int nbMaxLoc = boost::mpi::all_reduce(world, static_cast<int>(particles.getSimNumbers().size()), boost::mpi::maximum<int>());
+    BOOST_CHECK(nbMaxLoc <= 1.5 * nbSimul / world.size());
+    checkDistributedParticles(particles, statesConcentrated, world);
+}
+
 // (empty) Initialization function. Can't use testing tools here.
 bool init_function()
 {
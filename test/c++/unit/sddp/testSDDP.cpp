@@ -6,6 +6,8 @@
 #endif
 #define BOOST_TEST_DYN_LINK
 #include <tuple>
+#include <array>
+#include <cmath>
 #ifdef USE_MPI
 #include <boost/mpi.hpp>
 #endif
@@ -23,6 +25,7 @@
 #include "libstoch/sddp/SDDPVisitedStates.h"
 #include "libstoch/sddp/SDDPVisitedStatesGeners.h"
 #include "libstoch/sddp/SDDPLocalCut.h"
+#include "libstoch/sddp/SDDPAdaptiveSchedule.h"
 
 using namespace std;
 using namespace Eigen;
@@ -321,6 +324,124 @@ BOOST_AUTO_TEST_CASE(testSDDPConditional)
 
 
 
+/// \brief check that the states stored in some buffers and merged
+///        give exactly the same visited states as a sequential insertion
+/// \param p_sizeState  size of the states (0 for empty states)
+void testMergeBuffers(const int &p_sizeState)
+{
+    // conditional regressor with two meshes
+    int nbSimul = 10;
+    ArrayXXd particles(1, nbSimul);
+    for (int i = 0; i < nbSimul; ++i)
+        particles(0, i) = i * (1. / nbSimul);
+    ArrayXi mesh = ArrayXi::Constant(1, 2);
+    shared_ptr< LocalLinearRegressionForSDDP > regressor = make_shared<LocalLinearRegressionForSDDP>(false, particles, mesh);
+    regressor->evaluateSimulBelongingToCell();
+    // fixed set of states and particles with some doubles
+    int nState = 40;
+    vector< shared_ptr<ArrayXd> > stateToAdd(nState);
+    vector< ArrayXd > particleToAdd(nState, ArrayXd(1));
+    for (int i = 0; i < nState; ++i)
+    {
+        stateToAdd[i] = make_shared<ArrayXd>(p_sizeState);
+        for (int id = 0; id < p_sizeState; ++id)
+            (*stateToAdd[i])(id) = (i % 7) + 0.5 * id;
+        particleToAdd[i](0) = (i % 3) * 0.4;
+    }
+    // sequential insertion
+    SDDPVisitedStates states(regressor->getNbMeshTotal());
+    for (int i = 0; i < nState; ++i)
+        states.addVisitedState(stateToAdd[i], particleToAdd[i], *regressor);
+    // insertion in buffers filled by contiguous blocks of states then merged
+    int nbBuffer = 3;
+    vector< shared_ptr< SDDPVisitedStatesBase > > buffers(nbBuffer);
+    for (int ib = 0; ib < nbBuffer; ++ib)
+    {
+        shared_ptr<SDDPVisitedStates> buffer = make_shared<SDDPVisitedStates>(regressor->getNbMeshTotal());
+        for (int i = (ib * nState) / nbBuffer; i < ((ib + 1) * nState) / nbBuffer; ++i)
+            buffer->addVisitedStateLocal(stateToAdd[i], particleToAdd[i], *regressor);
+        buffers[ib] = buffer;
+    }
+    SDDPVisitedStates statesMerged(regressor->getNbMeshTotal());
+    statesMerged.mergeBuffers(buffers);
+    // compare
+    BOOST_CHECK_EQUAL(statesMerged.getStateSize(), states.getStateSize());
+    BOOST_CHECK(statesMerged.getAssociatedMesh() == states.getAssociatedMesh());
+    BOOST_CHECK(statesMerged.getMeshToState() == states.getMeshToState());
+    for (int i = 0; i < std::min(states.getStateSize(), statesMerged.getStateSize()); ++i)
+    {
+        BOOST_CHECK_EQUAL(statesMerged.getAState(i)->size(), states.getAState(i)->size());
+        BOOST_CHECK((*statesMerged.getAState(i) == *states.getAState(i)).all());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testSDDPVisitedStatesMergeBuffers)
+{
+    testMergeBuffers(2);
+    // empty states
+    testMergeBuffers(0);
+}
+
+BOOST_AUTO_TEST_CASE(testSDDPAdaptiveSchedule)
+{
+    // quantile 2 for round half widths
+    SDDPAdaptiveSchedule schedule(100, 1000, 2., 2.);
+    BOOST_CHECK_EQUAL(schedule.getNbSimul(), 100);
+    double accuracy = 0.01;
+    // mean 100, variance 400 : 1600 simulations needed for a half width of 1
+    schedule.update(100., 400., accuracy);
+    // half width 2 * sqrt(400 / 100)
+    std::array<double, 2> interval = schedule.getConfidenceInterval();
+    BOOST_CHECK_CLOSE(interval[0], 96., accuracyEqual);
+    BOOST_CHECK_CLOSE(interval[1], 104., accuracyEqual);
+    // growth limited by the factor
+    BOOST_CHECK_EQUAL(schedule.getNbSimul(), 200);
+    // gap below the accuracy but interval too wide : no stop
+    BOOST_CHECK_CLOSE(schedule.getAccuracy(100.5), 0.04, accuracyEqual);
+    BOOST_CHECK(schedule.getAccuracy(100.5) > accuracy);
+    schedule.update(100., 400., accuracy);
+    BOOST_CHECK_EQUAL(schedule.getNbSimul(), 400);
+    schedule.update(100., 400., accuracy);
+    BOOST_CHECK_EQUAL(schedule.getNbSimul(), 800);
+    // capped by the maximal number of simulations
+    schedule.update(100., 400., accuracy);
+    BOOST_CHECK_EQUAL(schedule.getNbSimul(), 1000);
+    schedule.update(100., 400., accuracy);
+    BOOST_CHECK_EQUAL(schedule.getNbSimul(), 1000);
+    // maximal number of simulations reached but half width 2 * sqrt(400 / 1000) still above 1 : no stop
+    BOOST_CHECK(schedule.getAccuracy(100.) > accuracy);
+    // smaller variance : the number of simulations never decreases
+    schedule.update(100., 100., accuracy);
+    BOOST_CHECK_EQUAL(schedule.getNbSimul(), 1000);
+    // half width 2 * sqrt(100 / 1000) below 1 : stop if the gap is small
+    BOOST_CHECK_CLOSE(schedule.getAccuracy(100.5), 0.02 * sqrt(0.1), accuracyEqual);
+    BOOST_CHECK(schedule.getAccuracy(100.5) <= accuracy);
+    // gap above the accuracy : no stop
+    BOOST_CHECK_CLOSE(schedule.getAccuracy(102.), 0.02, accuracyEqual);
+    BOOST_CHECK(schedule.getAccuracy(102.) > accuracy);
+
+    // accuracy reached at the first iteration : the number of simulations stays the same
+    SDDPAdaptiveSchedule scheduleSmallVar(100, 1000, 2., 2.);
+    scheduleSmallVar.update(100., 4., accuracy);
+    BOOST_CHECK_EQUAL(scheduleSmallVar.getNbSimul(), 100);
+    BOOST_CHECK_CLOSE(scheduleSmallVar.getAccuracy(100.2), 0.004, accuracyEqual);
+    BOOST_CHECK(scheduleSmallVar.getAccuracy(100.2) <= accuracy);
+
+    // null forward value : absolute accuracy and number of simulations growing to the maximum
+    SDDPAdaptiveSchedule scheduleZero(100, 150, 2., 2.);
+    scheduleZero.update(0., 1., accuracy);
+    BOOST_CHECK_EQUAL(scheduleZero.getNbSimul(), 150);
+    BOOST_CHECK_CLOSE(scheduleZero.getAccuracy(0.5), 0.5, accuracyEqual);
+
+    // bounds corrected : at least two simulations, maximum above the minimum
+    SDDPAdaptiveSchedule scheduleBounds(1, 0);
+    BOOST_CHECK_EQUAL(scheduleBounds.getNbSimul(), 2);
+    scheduleBounds.update(1., 1., accuracy);
+    BOOST_CHECK_EQUAL(scheduleBounds.getNbSimul(), 2);
+}
+
+
+
 #ifdef USE_MPI
 
 // (empty) Initialization function. Can't use testing tools here.
@@ -15,6 +15,7 @@
 #include "libstoch/core/grids/OneDimRegularSpaceGrid.h"
 #include "libstoch/core/grids/OneDimData.h"
 #include "libstoch/sddp/SimulatorSDDPBaseTree.h"
+#include "libstoch/sddp/SDDPCutNodeBatch.h"
 #include "test/c++/tools/simulators/TrinomialTreeOUSimulator.h"
 #include "test/c++/tools/simulators/MeanRevertingSimulatorTree.h"
 
@@ -314,3 +315,75 @@ BOOST_AUTO_TEST_CASE(testMeanRevertingSDDPForward)
 
 }
 
+// cuts depending on the node : counts the number of cut matrices built
+class SDDPCutOptTest : public SDDPCutOptBase
+{
+public :
+    mutable int m_nbBuilt ;
+
+    SDDPCutOptTest(): m_nbBuilt(0) {}
+
+    Eigen::ArrayXXd  getCutsAssociatedToTheParticle(int p_isim) const
+    {
+        m_nbBuilt += 1;
+        return Eigen::ArrayXXd::Constant(2, 3, p_isim);
+    }
+    Eigen::ArrayXXd  getCutsAssociatedToAParticle(const Eigen::ArrayXd &) const
+    {
+        return Eigen::ArrayXXd();
+    }
+};
+
+// LPs grouped by arrival node
+BOOST_AUTO_TEST_CASE(testSDDPNodeBatches)
+{
+    int nbSample = 3;
+    int nbNode = 5;
+    // states unevenly spread on arrival nodes
+    vector< tuple< shared_ptr<ArrayXd>, int, int > > vecState;
+    for (int ist = 0; ist < 40; ++ist)
+        vecState.push_back(make_tuple(make_shared<ArrayXd>(ArrayXd::Constant(1, ist)), (ist * ist) % nbNode, 0));
+    int nbLP = vecState.size() * nbSample;
+    for (int nbThreads = 1; nbThreads < 5; ++nbThreads)
+    {
+        int iLPFirst = 7;
+        int iLPLast = nbLP - 5;
+        vector< pair< int, vector<int> > > batches = createNodeBatches(vecState, nbSample, iLPFirst, iLPLast, nbThreads);
+        // each LP once in a batch of its node
+        vector<int> nbTreated(iLPLast - iLPFirst, 0);
+        for (size_t ib = 0; ib < batches.size(); ++ib)
+        {
+            if (ib > 0)
+                BOOST_CHECK(batches[ib].second.size() <= batches[ib - 1].second.size());
+            for (int ism : batches[ib].second)
+            {
+                nbTreated[ism] += 1;
+                BOOST_CHECK_EQUAL(get<1>(vecState[(ism + iLPFirst) / nbSample]), batches[ib].first);
+            }
+        }
+        for (size_t ism = 0; ism < nbTreated.size(); ++ism)
+            BOOST_CHECK_EQUAL(nbTreated[ism], 1);
+        if (nbThreads > 1)
+            BOOST_CHECK(static_cast<int>(batches.size()) > nbNode);
+    }
+    // cuts of the node built once for a batch
+    SDDPCutOptTest cuts;
+    SDDPCutNodeCache cutsNode(cuts, 2);
+    for (int ilp = 0; ilp < 10; ++ilp)
+        BOOST_CHECK_EQUAL(cutsNode.getCutsAssociatedToTheParticle(2)(1, 1), 2.);
+    BOOST_CHECK_EQUAL(cuts.m_nbBuilt, 1);
+    // cuts of the node given by reference to the cache
+    ArrayXXd buffer;
+    const ArrayXXd &cutsRef = cutsNode.getCutsAssociatedToTheParticleRef(2, buffer);
+    BOOST_CHECK_EQUAL(&cutsRef, &cutsNode.getCutsAssociatedToTheParticleRef(2, buffer));
+    BOOST_CHECK(&cutsRef != &buffer);
+    BOOST_CHECK_EQUAL(cutsRef(1, 1), 2.);
+    BOOST_CHECK_EQUAL(cuts.m_nbBuilt, 1);
+    BOOST_CHECK_EQUAL(cutsNode.getCutsAssociatedToTheParticle(4)(0, 0), 4.);
+    BOOST_CHECK_EQUAL(cuts.m_nbBuilt, 2);
+    // other nodes are calculated in the buffer
+    BOOST_CHECK_EQUAL(&cutsNode.getCutsAssociatedToTheParticleRef(4, buffer), &buffer);
+    BOOST_CHECK_EQUAL(buffer(0, 0), 4.);
+    BOOST_CHECK_EQUAL(cuts.m_nbBuilt, 3);
+    BOOST_CHECK_EQUAL(cutsNode.getMultiCutsAssociatedToTheParticle(2)[0](0, 2), 2.);
+}
@@ -0,0 +1,143 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#define BOOST_TEST_MODULE testContinuationCutsTree
+#define BOOST_TEST_DYN_LINK
+#include <memory>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <boost/random.hpp>
+#include <Eigen/Dense>
+#include "libstoch/core/utils/comparisonUtils.h"
+#include "libstoch/core/grids/RegularSpaceGrid.h"
+#include "libstoch/core/grids/GeneralSpaceGrid.h"
+#include "libstoch/tree/ContinuationCutsTree.h"
+
+using namespace std;
+using namespace Eigen;
+using namespace libstoch;
+
+#if defined   __linux
+#include <fenv.h>
+#define enable_abort_on_floating_point_exception() feenableexcept(FE_DIVBYZERO | FE_INVALID)
+#endif
+
+/// reference extraction : test every point of the grid
+ArrayXXd cutsByIterator(const shared_ptr<SpaceGrid> &p_grid, const vector< ArrayXXd > &p_cuts, const ArrayXXd &p_hypStock, const int &p_node)
+{
+    int nbCutsCoeff = p_cuts.size();
+    int nbNodes = p_cuts[0].rows();
+    int nbRows = (p_node < 0 ? nbCutsCoeff * nbNodes : nbCutsCoeff);
+    ArrayXXd cuts(nbRows, p_grid->getNbPoints());
+    int iPointCut = 0;
+    shared_ptr<GridIterator> iterGrid = p_grid->getGridIterator();
+    while (iterGrid->isValid())
+    {
+        ArrayXd pointCoord = iterGrid->getCoordinate();
+        bool bInside = true;
+        for (int id = 0 ; id < pointCoord.size(); ++id)
+            if (isStrictlyLesser(pointCoord(id), p_hypStock(id, 0)) || (isStrictlyMore(pointCoord(id), p_hypStock(id, 1))))
+                bInside = false;
+        if (bInside)
+        {
+            int ipoint = iterGrid->getCount();
+            for (int jc = 0; jc < nbCutsCoeff; ++jc)
+            {
+                if (p_node < 0)
+                    cuts.col(iPointCut).segment(jc * nbNodes, nbNodes) = p_cuts[jc].col(ipoint);
+                else
+                    cuts(jc, iPointCut) = p_cuts[jc](p_node, ipoint);
+            }
+            iPointCut += 1;
+        }
+        iterGrid->next();
+    }
+    cuts.conservativeResize(nbRows, iPointCut);
+    return cuts;
+}
+
+/// compare extraction by sub grid with point by point extraction
+void testCutsExtraction(const shared_ptr<SpaceGrid> &p_grid, const int &p_nbNodes, const int &p_nbTest)
+{
+    boost::mt19937 generator;
+    boost::uniform_real<double> uniformDistrib;
+    boost::variate_generator<boost::mt19937 &, boost::uniform_real<double> > uniformRand(generator, uniformDistrib);
+
+    int nDim = p_grid->getDimension();
+    vector< ArrayXXd > cutCoeff(nDim + 1);
+    for (int jc = 0; jc < nDim + 1; ++jc)
+        cutCoeff[jc] = ArrayXXd::Random(p_nbNodes, p_grid->getNbPoints());
+    ContinuationCutsTree contCuts;
+    contCuts.loadForSimulation(p_grid, cutCoeff);
+    // small cache : most cuts are not cached
+    ContinuationCutsTree contCutsSmallCache;
+    contCutsSmallCache.loadForSimulation(p_grid, cutCoeff);
+    contCutsSmallCache.setCacheSize(4 * (nDim + 1));
+
+    vector <array< double, 2>  > extremes = p_grid->getExtremeValues();
+    for (int it = 0; it < p_nbTest; ++it)
+    {
+        // hypercube partially outside the domain
+        ArrayXXd hypStock(nDim, 2);
+        for (int id = 0; id < nDim; ++id)
+        {
+            double width = extremes[id][1] - extremes[id][0];
+            double x1 = extremes[id][0] - 0.2 * width + 1.4 * width * uniformRand();
+            double x2 = extremes[id][0] - 0.2 * width + 1.4 * width * uniformRand();
+            hypStock(id, 0) = min(x1, x2);
+            hypStock(id, 1) = max(x1, x2);
+        }
+        for (int inode = -1; inode < p_nbNodes; ++inode)
+        {
+            ArrayXXd cutsRef = cutsByIterator(p_grid, cutCoeff, hypStock, inode);
+            // twice to go through the cache
+            for (int ic = 0; ic < 2; ++ic)
+            {
+                shared_ptr<const ArrayXXd> cutsPtr = ((inode < 0) ? contCuts.getCutsAllNodes(hypStock) : contCuts.getCutsANode(hypStock, inode));
+                const ArrayXXd &cuts = *cutsPtr;
+                BOOST_REQUIRE_EQUAL(cuts.rows(), cutsRef.rows());
+                BOOST_REQUIRE_EQUAL(cuts.cols(), cutsRef.cols());
+                if (cuts.size() > 0)
+                    BOOST_CHECK_EQUAL((cuts - cutsRef).abs().maxCoeff(), 0.);
+                shared_ptr<const ArrayXXd> cutsSmallPtr = ((inode < 0) ? contCutsSmallCache.getCutsAllNodes(hypStock) : contCutsSmallCache.getCutsANode(hypStock, inode));
+                const ArrayXXd &cutsSmall = *cutsSmallPtr;
+                BOOST_REQUIRE_EQUAL(cutsSmall.cols(), cutsRef.cols());
+                if (cutsSmall.size() > 0)
+                    BOOST_CHECK_EQUAL((cutsSmall - cutsRef).abs().maxCoeff(), 0.);
+            }
+            // cuts returned stay valid once the cache is cleared
+            shared_ptr<const ArrayXXd> cutsKept = ((inode < 0) ? contCuts.getCutsAllNodes(hypStock) : contCuts.getCutsANode(hypStock, inode));
+            contCuts.clearCache();
+            if (cutsKept->size() > 0)
+                BOOST_CHECK_EQUAL((*cutsKept - cutsRef).abs().maxCoeff(), 0.);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testCutsTreeRegularGrid)
+{
+#if defined   __linux
+    enable_abort_on_floating_point_exception();
+#endif
+    ArrayXd lowValues = ArrayXd::Constant(3, 1.);
+    ArrayXd step(3);
+    step << 0.5, 1., 2.;
+    ArrayXi nbStep(3);
+    nbStep << 6, 5, 3;
+    shared_ptr<SpaceGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    testCutsExtraction(grid, 4, 200);
+}
+
+BOOST_AUTO_TEST_CASE(testCutsTreeGeneralGrid)
+{
+#if defined   __linux
+    enable_abort_on_floating_point_exception();
+#endif
+    vector<shared_ptr<ArrayXd> > meshPerDimension(2);
+    meshPerDimension[0] = make_shared<ArrayXd>(7);
+    *meshPerDimension[0] << 0., 0.1, 0.5, 0.7, 1.5, 2., 4.;
+    meshPerDimension[1] = make_shared<ArrayXd>(4);
+    *meshPerDimension[1] << -1., 0., 3., 3.5;
+    shared_ptr<SpaceGrid> grid = make_shared<GeneralSpaceGrid>(meshPerDimension);
+    testCutsExtraction(grid, 3, 200);
+}
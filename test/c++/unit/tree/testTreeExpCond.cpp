@@ -0,0 +1,73 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#define BOOST_TEST_MODULE testTreeExpCond
+#define BOOST_TEST_DYN_LINK
+#include <vector>
+#include <array>
+#include <boost/test/unit_test.hpp>
+#include <Eigen/Dense>
+#include "libstoch/tree/Tree.h"
+
+using namespace std;
+using namespace Eigen;
+using namespace libstoch;
+
+/// trinomial recombining tree between a date with p_nbNodes nodes and the next one
+Tree createTrinomialTree(const int &p_nbNodes)
+{
+    vector<double> proba = {1. / 6., 2. / 3., 1. / 6.};
+    vector< vector< array<int, 2> > > connected(p_nbNodes);
+    for (int i = 0; i < p_nbNodes; ++i)
+        for (int j = 0; j < 3; ++j)
+            connected[i].push_back({{i + j, j}});
+    return Tree(proba, connected);
+}
+
+/// layout with one node per row gives the transposition of the layout with one node per column
+BOOST_AUTO_TEST_CASE(testTreeExpCondNodesInRows)
+{
+    int nbNodes = 7;
+    int nbFunc = 5;
+    Tree tree = createTrinomialTree(nbNodes);
+    BOOST_CHECK_EQUAL(tree.getNbNodesNextDate(), nbNodes + 2);
+    ArrayXXd values = ArrayXXd::Random(tree.getNbNodesNextDate(), nbFunc);
+    ArrayXXd reference = tree.expCondMultiple(values.transpose()).transpose();
+    ArrayXXd expValues(nbNodes, nbFunc);
+    tree.expCondMultipleNodesInRows(values, expValues);
+    BOOST_CHECK_SMALL((expValues - reference).abs().maxCoeff(), 1e-14);
+    // one function compared with expCond
+    ArrayXd expOne = tree.expCond(values.col(2));
+    BOOST_CHECK_SMALL((expOne - expValues.col(2)).abs().maxCoeff(), 1e-14);
+}
+
+/// values and results as blocks of larger arrays
+BOOST_AUTO_TEST_CASE(testTreeExpCondBlocks)
+{
+    int nbNodes = 6;
+    int nbFunc = 4;
+    int nbBlock = 3;
+    Tree tree = createTrinomialTree(nbNodes);
+    int nbNodesNext = tree.getNbNodesNextDate();
+    // blocks of rows as for cuts
+    ArrayXXd values = ArrayXXd::Random(nbBlock * nbNodesNext, nbFunc);
+    ArrayXXd expValues = ArrayXXd::Constant(nbBlock * nbNodes + 1, nbFunc + 2, -1.);
+    for (int ib = 0; ib < nbBlock; ++ib)
+    {
+        tree.expCondMultipleNodesInRows(values.block(ib * nbNodesNext, 0, nbNodesNext, nbFunc), expValues.block(1 + ib * nbNodes, 1, nbNodes, nbFunc));
+        ArrayXXd valBlock = values.block(ib * nbNodesNext, 0, nbNodesNext, nbFunc);
+        ArrayXXd reference = tree.expCondMultiple(valBlock.transpose()).transpose();
+        BOOST_CHECK_SMALL((expValues.block(1 + ib * nbNodes, 1, nbNodes, nbFunc) - reference).abs().maxCoeff(), 1e-14);
+    }
+    // outside blocks untouched
+    BOOST_CHECK_EQUAL(expValues.row(0).maxCoeff(), -1.);
+    BOOST_CHECK_EQUAL(expValues.col(0).maxCoeff(), -1.);
+    BOOST_CHECK_EQUAL(expValues.col(nbFunc + 1).maxCoeff(), -1.);
+    // layout with one node per column in a block
+    ArrayXXd valuesCol = ArrayXXd::Random(nbFunc + 1, nbNodesNext);
+    ArrayXXd expValuesCol = ArrayXXd::Zero(nbFunc + 1, nbNodes);
+    tree.expCondMultiple(valuesCol.topRows(nbFunc), expValuesCol.topRows(nbFunc));
+    ArrayXXd reference = tree.expCondMultiple(ArrayXXd(valuesCol.topRows(nbFunc)));
+    BOOST_CHECK_SMALL((expValuesCol.topRows(nbFunc) - reference).abs().maxCoeff(), 1e-14);
+    BOOST_CHECK_EQUAL(expValuesCol.row(nbFunc).abs().maxCoeff(), 0.);
+}
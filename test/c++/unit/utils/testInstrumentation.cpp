@@ -0,0 +1,111 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#define BOOST_TEST_MODULE testInstrumentation
+#define BOOST_TEST_DYN_LINK
+#include <sstream>
+#include <boost/test/unit_test.hpp>
+#include "libstoch/core/utils/Instrumentation.h"
+
+using namespace std;
+using namespace libstoch;
+
+/// test of the records stored directly by the Instrumentation object
+BOOST_AUTO_TEST_CASE(testInstrumentationRecords)
+{
+    Instrumentation &inst = Instrumentation::instance();
+    inst.clear();
+    // time read before the step is attributed to the step
+    inst.addTime(instIO, 1., true);
+    inst.startStep("step");
+    inst.addTime(instOptimize, 2.);
+    inst.addOptimizeCalls(10);
+    inst.addBytes(100);
+    inst.addThreadBusy(1, 3.);
+    inst.endStep(5.);
+    // dump after the step is given to the last step
+    inst.addTime(instIO, 0.5);
+    inst.startStep("step");
+    inst.endStep(1.);
+
+    vector< InstrumentationRecord > records = inst.getRecords();
+    BOOST_REQUIRE_EQUAL(records.size(), 2);
+    BOOST_CHECK_EQUAL(records[0].m_name, "step");
+    BOOST_CHECK_EQUAL(records[0].m_step, 0);
+    BOOST_CHECK_EQUAL(records[1].m_step, 1);
+    BOOST_CHECK_CLOSE(records[0].m_wallTime, 5., 1e-10);
+    BOOST_CHECK_CLOSE(records[0].m_categoryTime[instIO], 1.5, 1e-10);
+    BOOST_CHECK_CLOSE(records[0].m_categoryTime[instOptimize], 2., 1e-10);
+    BOOST_CHECK_EQUAL(records[0].m_nbOptimize, 10);
+    BOOST_CHECK_EQUAL(records[0].m_nbBytes, 100);
+    BOOST_REQUIRE_EQUAL(records[0].m_threadBusy.size(), 2);
+    BOOST_CHECK_CLOSE(records[0].m_threadBusy[1], 3., 1e-10);
+    BOOST_CHECK_EQUAL(records[1].m_categoryTime[instIO], 0.);
+
+    stringstream json;
+    inst.dumpJSON(json);
+    BOOST_CHECK(json.str().find("\"nbOptimize\": 10") != string::npos);
+    BOOST_CHECK(json.str().find("\"steps\": [") != string::npos);
+    inst.clear();
+    BOOST_CHECK_EQUAL(inst.getRecords().size(), 0);
+}
+
+/// test of the scoped helpers : only active with USE_INSTRUMENTATION
+BOOST_AUTO_TEST_CASE(testInstrumentationHelpers)
+{
+    Instrumentation &inst = Instrumentation::instance();
+    inst.clear();
+    {
+        InstrumentationStep instStep("helper");
+        InstrumentationTimer timerOptimize(instOptimize);
+        {
+            InstrumentationThread instThread;
+            instThread.countOptimize();
+            instThread.countOptimize();
+        }
+        timerOptimize.stop();
+        instrumentBytes(8);
+    }
+    vector< InstrumentationRecord > records = inst.getRecords();
+    if (Instrumentation::isEnabled())
+    {
+        BOOST_REQUIRE_EQUAL(records.size(), 1);
+        BOOST_CHECK_EQUAL(records[0].m_name, "helper");
+        BOOST_CHECK_EQUAL(records[0].m_nbOptimize, 2);
+        BOOST_CHECK_EQUAL(records[0].m_nbBytes, 8);
+        BOOST_CHECK(records[0].m_categoryTime[instOptimize] <= records[0].m_wallTime);
+        BOOST_CHECK(records[0].m_threadBusy.size() > 0);
+    }
+    else
+        BOOST_CHECK_EQUAL(records.size(), 0);
+    inst.clear();
+}
+
+/// test that steps started by threads of a parallel region are ignored
+BOOST_AUTO_TEST_CASE(testInstrumentationParallelRegion)
+{
+    Instrumentation &inst = Instrumentation::instance();
+    inst.clear();
+    inst.startStep("outer");
+    int nbStarted = 0;
+    #pragma omp parallel reduction(+:nbStarted)
+    {
+        if (inst.startStep("inner"))
+        {
+            nbStarted += 1;
+            inst.endStep(1.);
+        }
+        inst.addOptimizeCalls(1);
+    }
+    inst.endStep(2.);
+    vector< InstrumentationRecord > records = inst.getRecords();
+#ifdef _OPENMP
+    BOOST_CHECK_EQUAL(nbStarted, (omp_get_max_threads() > 1 ? 0 : 1));
+#else
+    BOOST_CHECK_EQUAL(nbStarted, 1);
+#endif
+    BOOST_REQUIRE_EQUAL(records.size(), 1 + nbStarted);
+    BOOST_CHECK_EQUAL(records[0].m_name, "outer");
+    BOOST_CHECK_CLOSE(records[0].m_wallTime, 2., 1e-10);
+    inst.clear();
+}
@@ -0,0 +1,130 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#ifndef USE_MPI
+#define BOOST_TEST_MODULE testSimulateStepPipeline
+#endif
+#define BOOST_TEST_DYN_LINK
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#ifdef USE_MPI
+#include <boost/mpi.hpp>
+#endif
+#include <boost/test/unit_test.hpp>
+#include "libstoch/dp/SimulateStepPipeline.h"
+
+using namespace std;
+using namespace libstoch;
+
+/// number of fake steps alive
+static atomic<int> nbAlive(0);
+/// maximal number of fake steps alive
+static atomic<int> nbMaxAlive(0);
+
+/// \class FakeStep
+/// Step whose creation is slow (as an archive reading)
+class FakeStep
+{
+    int m_step ; ///< step number
+public :
+    explicit FakeStep(const int &p_step): m_step(p_step)
+    {
+        this_thread::sleep_for(chrono::milliseconds(5));
+        int nb = ++nbAlive;
+        int nbMax = nbMaxAlive;
+        while ((nb > nbMax) && !nbMaxAlive.compare_exchange_weak(nbMax, nb)) {}
+    }
+    ~FakeStep()
+    {
+        --nbAlive;
+    }
+    void oneStep(vector<int> &p_visited) const
+    {
+        this_thread::sleep_for(chrono::milliseconds(5));
+        p_visited.push_back(m_step);
+    }
+};
+
+/// run the pipeline and check that steps are given in order with at most two steps in memory
+void runPipeline(const bool &p_bAsync)
+{
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+#endif
+    int nbStep = 10;
+    nbAlive = 0;
+    nbMaxAlive = 0;
+    vector<int> visited;
+    {
+        SimulateStepPipeline< FakeStep > pipeline([](const int &p_iStep
+#ifdef USE_MPI
+                                                    , const boost::mpi::communicator &
+#endif
+                                                   )
+        {
+            return make_shared<FakeStep>(p_iStep);
+        }, nbStep
+#ifdef USE_MPI
+        , world
+#endif
+        , p_bAsync);
+        while (pipeline.hasNext())
+            pipeline.next()->oneStep(visited);
+    }
+    BOOST_REQUIRE_EQUAL(visited.size(), nbStep);
+    for (int istep = 0; istep < nbStep; ++istep)
+        BOOST_CHECK_EQUAL(visited[istep], istep);
+    BOOST_CHECK(nbMaxAlive <= 2);
+    BOOST_CHECK_EQUAL(nbAlive, 0);
+}
+
+BOOST_AUTO_TEST_CASE(testSimulateStepPipelineAsync)
+{
+    runPipeline(true);
+}
+
+BOOST_AUTO_TEST_CASE(testSimulateStepPipelineSync)
+{
+    runPipeline(false);
+    // no step created in advance
+    BOOST_CHECK_EQUAL(nbMaxAlive, 1);
+}
+
+BOOST_AUTO_TEST_CASE(testSimulateStepPipelineException)
+{
+#ifdef USE_MPI
+    boost::mpi::communicator world;
+#endif
+    SimulateStepPipeline< FakeStep > pipeline([](const int &p_iStep
+#ifdef USE_MPI
+                                                , const boost::mpi::communicator &
+#endif
+                                               ) -> shared_ptr<FakeStep>
+    {
+        if (p_iStep == 1)
+            throw runtime_error("step not found");
+        return make_shared<FakeStep>(p_iStep);
+    }, 3
+#ifdef USE_MPI
+    , world
+#endif
+                                             );
+    BOOST_CHECK(pipeline.next() != nullptr);
+    BOOST_CHECK_THROW(pipeline.next(), runtime_error);
+}
+
+#ifdef USE_MPI
+// (empty) Initialization function. Can't use testing tools here.
+bool init_function()
+{
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    boost::mpi::environment env(argc, argv, boost::mpi::threading::multiple);
+    return ::boost::unit_test::unit_test_main(&init_function, argc, argv);
+}
+#endif
@@ -0,0 +1,56 @@
+// Copyright (C) 2016 EDF
+// All Rights Reserved
+// This code is published under the GNU Lesser General Public License (GNU LGPL)
+#define BOOST_TEST_MODULE testSortStatesByCell
+#define BOOST_TEST_DYN_LINK
+#include <algorithm>
+#include <boost/test/unit_test.hpp>
+#include <boost/random.hpp>
+#include "libstoch/core/grids/RegularSpaceGrid.h"
+#include "libstoch/core/utils/sortStatesByCell.h"
+
+using namespace std;
+using namespace Eigen;
+using namespace libstoch;
+
+/// simulations sorted by mesh : the permutation is kept and the meshes are not decreasing
+BOOST_AUTO_TEST_CASE(testSortStatesByCell)
+{
+    boost::mt19937 generator;
+    boost::random::uniform_real_distribution<double> alea(0., 4.);
+    int nbSimul = 1000;
+    ArrayXd lowValues = ArrayXd::Zero(2);
+    ArrayXd step = ArrayXd::Constant(2, 1.);
+    ArrayXi nbStep = ArrayXi::Constant(2, 4);
+    shared_ptr<SpaceGrid> grid = make_shared<RegularSpaceGrid>(lowValues, step, nbStep);
+    vector<StateWithStocks> states;
+    for (int is = 0; is < nbSimul; ++is)
+    {
+        ArrayXd stock(2);
+        stock << alea(generator), alea(generator);
+        states.push_back(StateWithStocks(0, stock, ArrayXd::Constant(1, alea(generator))));
+    }
+    // natural order
+    vector<int> simNat = simulationOrder(states, grid, 10, nbSimul, false);
+    BOOST_REQUIRE_EQUAL(simNat.size(), nbSimul - 10);
+    for (size_t is = 0; is < simNat.size(); ++is)
+        BOOST_CHECK_EQUAL(simNat[is], static_cast<int>(is) + 10);
+    // sorted order
+    vector<int> sim = simulationOrder(states, grid, 10, nbSimul, true);
+    vector<int> simSorted(sim);
+    sort(simSorted.begin(), simSorted.end());
+    BOOST_CHECK(simSorted == simNat);
+    int cellPrev = -1;
+    double uncertaintyPrev = -1.;
+    for (size_t is = 0; is < sim.size(); ++is)
+    {
+        const ArrayXd &stock = states[sim[is]].getPtStock();
+        int cell = min(static_cast<int>(stock(0)), 3) + 4 * min(static_cast<int>(stock(1)), 3);
+        BOOST_CHECK(cell >= cellPrev);
+        double uncertainty = states[sim[is]].getStochasticRealization()(0);
+        if (cell == cellPrev)
+            BOOST_CHECK(uncertainty >= uncertaintyPrev);
+        cellPrev = cell;
+        uncertaintyPrev = uncertainty;
+    }
+}